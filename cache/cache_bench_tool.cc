@@ -25,8 +25,11 @@
 #include "rocksdb/secondary_cache.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table_properties.h"
+#include "rocksdb/trace_reader_writer.h"
+#include "rocksdb/trace_record.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/cachable_entry.h"
+#include "trace_replay/block_cache_tracer.h"
 #include "util/coding.h"
 #include "util/distributed_mutex.h"
 #include "util/gflags_compat.h"
@@ -87,6 +90,23 @@ static class std::shared_ptr<ROCKSDB_NAMESPACE::SecondaryCache> secondary_cache;
 
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
+// ## BEGIN trace replay sub-tool options ##
+// See CacheBench::RunTraceReplay below.
+DEFINE_string(block_cache_trace_file, "",
+              "If non-empty, replay the block cache accesses recorded in this "
+              "trace file (captured with DB::StartBlockCacheTrace) against "
+              "the configured cache, instead of the synthetic workload.");
+DEFINE_double(trace_replay_fast_forward, 0.0,
+              "(-block_cache_trace_file) Speed of the replay relative to the "
+              "recorded timestamps: 1 is timing-faithful, k > 1 replays k "
+              "times faster, and 0 (the default) replays as fast as "
+              "possible.");
+DEFINE_uint64(trace_report_interval_secs, 10,
+              "(-block_cache_trace_file) Interval, in seconds of trace time, "
+              "between progress report lines (hit rate, insert bytes and "
+              "per-role occupancy).");
+// ## END trace replay sub-tool options ##
+
 // ## BEGIN stress_cache_key sub-tool options ##
 // See class StressCacheKey below.
 DEFINE_bool(stress_cache_key, false,
@@ -260,6 +280,19 @@ void deleter3(const Slice& /*key*/, void* value) {
 Cache::CacheItemHelper helper1(SizeFn, SaveToFn, deleter1);
 Cache::CacheItemHelper helper2(SizeFn, SaveToFn, deleter2);
 Cache::CacheItemHelper helper3(SizeFn, SaveToFn, deleter3);
+
+// Bookkeeping value inserted for each replayed block, so that evictions are
+// reflected in the per-role occupancy report of the trace replay mode.
+struct ReplayBlock {
+  size_t charge;
+  std::atomic<uint64_t>* occupancy;
+};
+
+void ReplayDeleter(const Slice& /*key*/, void* value) {
+  ReplayBlock* block = static_cast<ReplayBlock*>(value);
+  block->occupancy->fetch_sub(block->charge, std::memory_order_relaxed);
+  delete block;
+}
 }  // namespace
 
 class CacheBench {
@@ -412,6 +445,147 @@ class CacheBench {
     return true;
   }
 
+  // Replay a block cache access trace captured with
+  // DB::StartBlockCacheTrace against the configured cache, so that
+  // admission and eviction changes can be evaluated against real traffic
+  // rather than the synthetic skewed-random workload. Each trace record is
+  // looked up by its recorded block key; on a miss, a dummy value of the
+  // recorded block size is inserted unless the original access was
+  // no-insert. Pacing follows -trace_replay_fast_forward, and a report of
+  // hit rate, insert bytes and per-role occupancy is printed every
+  // -trace_report_interval_secs of trace time.
+  bool RunTraceReplay() {
+    const auto clock = SystemClock::Default().get();
+    std::unique_ptr<TraceReader> trace_reader;
+    Status s = NewFileTraceReader(Env::Default(), EnvOptions(),
+                                  FLAGS_block_cache_trace_file, &trace_reader);
+    if (!s.ok()) {
+      fprintf(stderr, "Cannot open trace file: %s\n", s.ToString().c_str());
+      return false;
+    }
+    BlockCacheTraceReader reader(std::move(trace_reader));
+    BlockCacheTraceHeader header;
+    s = reader.ReadHeader(&header);
+    if (!s.ok()) {
+      fprintf(stderr, "Cannot read trace header: %s\n", s.ToString().c_str());
+      return false;
+    }
+    printf("Trace file          : %s\n", FLAGS_block_cache_trace_file.c_str());
+    printf("Trace from version  : %u.%u\n", header.rocksdb_major_version,
+           header.rocksdb_minor_version);
+    printf("Replay speed        : %s\n",
+           FLAGS_trace_replay_fast_forward > 0
+               ? std::to_string(FLAGS_trace_replay_fast_forward).c_str()
+               : "as fast as possible");
+    printf("----------------------------\n");
+
+    // Occupancy by role: data, index, filter, and everything else.
+    std::atomic<uint64_t> occupancy[4];
+    for (auto& o : occupancy) {
+      o.store(0, std::memory_order_relaxed);
+    }
+    auto role_of = [](TraceType type) {
+      switch (type) {
+        case TraceType::kBlockTraceDataBlock:
+          return 0;
+        case TraceType::kBlockTraceIndexBlock:
+          return 1;
+        case TraceType::kBlockTraceFilterBlock:
+          return 2;
+        default:
+          return 3;
+      }
+    };
+
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    uint64_t insert_bytes = 0;
+    uint64_t last_lookups = 0;
+    uint64_t last_hits = 0;
+    uint64_t first_ts = 0;
+    uint64_t next_report_ts = 0;
+    const uint64_t report_interval_us =
+        FLAGS_trace_report_interval_secs * 1000000U;
+    const uint64_t replay_start_us = clock->NowMicros();
+
+    printf("%10s %12s %8s %12s %12s %12s %12s %12s\n", "trace_sec", "lookups",
+           "hit%", "insert_mb", "data_mb", "index_mb", "filter_mb", "other_mb");
+    BlockCacheTraceRecord record;
+    while (reader.ReadAccess(&record).ok()) {
+      if (first_ts == 0) {
+        first_ts = record.access_timestamp;
+        next_report_ts = first_ts + report_interval_us;
+      }
+      if (FLAGS_trace_replay_fast_forward > 0) {
+        uint64_t target_us = static_cast<uint64_t>(
+            static_cast<double>(record.access_timestamp - first_ts) /
+            FLAGS_trace_replay_fast_forward);
+        uint64_t elapsed_us = clock->NowMicros() - replay_start_us;
+        if (elapsed_us < target_us) {
+          clock->SleepForMicroseconds(static_cast<int>(target_us - elapsed_us));
+        }
+      }
+      while (next_report_ts > 0 && record.access_timestamp >= next_report_ts) {
+        printf("%10" PRIu64 " %12" PRIu64 " %7.2f%% %12.1f %12.1f %12.1f "
+               "%12.1f %12.1f\n",
+               (next_report_ts - first_ts) / 1000000U, lookups - last_lookups,
+               lookups > last_lookups
+                   ? 100.0 * (hits - last_hits) / (lookups - last_lookups)
+                   : 0.0,
+               insert_bytes / (1.0 * MiB),
+               occupancy[0].load(std::memory_order_relaxed) / (1.0 * MiB),
+               occupancy[1].load(std::memory_order_relaxed) / (1.0 * MiB),
+               occupancy[2].load(std::memory_order_relaxed) / (1.0 * MiB),
+               occupancy[3].load(std::memory_order_relaxed) / (1.0 * MiB));
+        last_lookups = lookups;
+        last_hits = hits;
+        next_report_ts += report_interval_us;
+      }
+
+      Slice key(record.block_key);
+      lookups++;
+      Cache::Handle* handle = cache_->Lookup(key);
+      if (handle) {
+        hits++;
+        cache_->Release(handle);
+      } else if (record.no_insert == Boolean::kFalse) {
+        std::atomic<uint64_t>* occ = &occupancy[role_of(record.block_type)];
+        size_t charge = static_cast<size_t>(std::max(record.block_size,
+                                                     uint64_t{1}));
+        ReplayBlock* block = new ReplayBlock{charge, occ};
+        occ->fetch_add(charge, std::memory_order_relaxed);
+        // Index and filter blocks are inserted with high priority, as the
+        // block-based table does by default.
+        Cache::Priority priority =
+            (record.block_type == TraceType::kBlockTraceIndexBlock ||
+             record.block_type == TraceType::kBlockTraceFilterBlock)
+                ? Cache::Priority::HIGH
+                : Cache::Priority::LOW;
+        // On failure the deleter reverses the occupancy accounting.
+        cache_->Insert(key, block, charge, ReplayDeleter, nullptr, priority)
+            .PermitUncheckedError();
+        insert_bytes += charge;
+      }
+    }
+    if (lookups == 0) {
+      fprintf(stderr, "Trace file contains no block cache accesses\n");
+      return false;
+    }
+
+    uint64_t replay_us = clock->NowMicros() - replay_start_us;
+    printf("----------------------------\n");
+    printf("Accesses            : %" PRIu64 "\n", lookups);
+    printf("Hit rate            : %.2f%%\n", 100.0 * hits / lookups);
+    printf("Insert bytes        : %s\n",
+           BytesToHumanString(insert_bytes).c_str());
+    printf("Trace duration      : %.3f s\n",
+           (record.access_timestamp - first_ts) * 1e-6);
+    printf("Replay time         : %.3f s\n", replay_us * 1e-6);
+    printf("Replay ops/sec      : %u\n",
+           static_cast<uint32_t>(1.0 * lookups / (replay_us * 1e-6)));
+    return true;
+  }
+
  private:
   std::shared_ptr<Cache> cache_;
   const uint64_t max_key_;
@@ -953,6 +1127,12 @@ int cache_bench_tool(int argc, char** argv) {
     return 0;
   }
 
+  if (!FLAGS_block_cache_trace_file.empty()) {
+    // Alternate tool
+    ROCKSDB_NAMESPACE::CacheBench replay_bench;
+    return replay_bench.RunTraceReplay() ? 0 : 1;
+  }
+
   if (FLAGS_threads <= 0) {
     fprintf(stderr, "threads number <= 0\n");
     exit(1);
@@ -478,6 +478,24 @@ Status ClockCacheShard::Insert(const Slice& key, uint32_t hash, void* value,
   // Use a local copy to minimize cache synchronization.
   size_t detached_usage = detached_usage_;
 
+  // Before evicting to make room, ask the admission policy (if any) whether
+  // the incoming entry is hot enough to cache. Clock eviction has no single
+  // victim to compare against, so the policy only sees the incoming hash. A
+  // rejected entry with no pending handle is dropped as if immediately
+  // evicted; with a handle it becomes a detached entry, charged and freed on
+  // release, so a one-time scan cannot displace the table residents.
+  if (admission_policy_ != nullptr &&
+      table_.GetUsage() + detached_usage + tmp.total_charge >
+          table_.GetCapacity() &&
+      !admission_policy_->Admit(hash)) {
+    if (handle == nullptr) {
+      tmp.FreeData();
+    } else {
+      *handle = reinterpret_cast<Cache::Handle*>(DetachedInsert(&tmp));
+    }
+    return s;
+  }
+
   // Free space with the clock policy until enough space is freed or there are
   // no evictable elements.
   table_.ClockRun(tmp.total_charge + detached_usage);
@@ -5,9 +5,11 @@
 
 #include "cache/compressed_secondary_cache.h"
 
+#include <atomic>
 #include <memory>
 
 #include "memory/memory_allocator.h"
+#include "port/port.h"
 #include "util/compression.h"
 #include "util/string_util.h"
 
@@ -15,23 +17,53 @@ namespace ROCKSDB_NAMESPACE {
 
 namespace {
 
+// An entry in the underlying LRUCache: the (possibly compressed) contents
+// plus the number of times the entry has been looked up, which drives the
+// promotion hysteresis in CompressedSecondaryCache::Lookup().
+struct CacheValue {
+  CacheAllocationPtr ptr;
+  std::atomic<uint32_t> num_lookups{0};
+
+  explicit CacheValue(CacheAllocationPtr&& _ptr) : ptr(std::move(_ptr)) {}
+};
+
 void DeletionCallback(const Slice& /*key*/, void* obj) {
-  delete reinterpret_cast<CacheAllocationPtr*>(obj);
+  delete reinterpret_cast<CacheValue*>(obj);
   obj = nullptr;
 }
 
+// Maximum number of helper threads WaitAll() may spawn to overlap the
+// deferred decompressions across a batch of pending lookups.
+constexpr size_t kMaxWaitAllWorkers = 3;
+
 }  // namespace
 
+CompressedSecondaryCacheResultHandle::~CompressedSecondaryCacheResultHandle() {
+  if (lru_handle_ != nullptr) {
+    // The handle is released without ever being waited for; drop the
+    // reference on the compressed entry.
+    sec_cache_->cache_->Release(lru_handle_,
+                                /*erase_if_last_ref=*/erase_on_complete_);
+  }
+}
+
+void CompressedSecondaryCacheResultHandle::Wait() {
+  if (!is_ready_) {
+    sec_cache_->CompleteLookup(this);
+  }
+}
+
 CompressedSecondaryCache::CompressedSecondaryCache(
     size_t capacity, int num_shard_bits, bool strict_capacity_limit,
     double high_pri_pool_ratio,
     std::shared_ptr<MemoryAllocator> memory_allocator, bool use_adaptive_mutex,
     CacheMetadataChargePolicy metadata_charge_policy,
-    CompressionType compression_type, uint32_t compress_format_version)
+    CompressionType compression_type, uint32_t compress_format_version,
+    uint32_t promotion_lookup_threshold)
     : cache_options_(capacity, num_shard_bits, strict_capacity_limit,
                      high_pri_pool_ratio, memory_allocator, use_adaptive_mutex,
                      metadata_charge_policy, compression_type,
-                     compress_format_version) {
+                     compress_format_version, promotion_lookup_threshold) {
   cache_ = NewLRUCache(capacity, num_shard_bits, strict_capacity_limit,
                        high_pri_pool_ratio, memory_allocator,
                        use_adaptive_mutex, metadata_charge_policy);
@@ -40,7 +72,7 @@ CompressedSecondaryCache::CompressedSecondaryCache(
 CompressedSecondaryCache::~CompressedSecondaryCache() { cache_.reset(); }
 
 std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
-    const Slice& key, const Cache::CreateCallback& create_cb, bool /*wait*/,
+    const Slice& key, const Cache::CreateCallback& create_cb, bool wait,
     bool& is_in_sec_cache) {
   std::unique_ptr<SecondaryCacheResultHandle> handle;
   is_in_sec_cache = false;
@@ -49,14 +81,50 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     return handle;
   }
 
+  // Promotion hysteresis: an entry graduates to the uncompressed tier (and
+  // is erased here) only once it has been looked up often enough. Before
+  // that the value is still returned, but the compressed copy is retained
+  // and the caller's copy is marked as also present here, so single-hit
+  // entries age out of the uncompressed tier without being recompressed.
+  CacheValue* cache_value =
+      reinterpret_cast<CacheValue*>(cache_->Value(lru_handle));
+  uint32_t num_lookups =
+      cache_value->num_lookups.fetch_add(1, std::memory_order_relaxed) + 1;
+  bool erase_on_complete =
+      num_lookups >= cache_options_.promotion_lookup_threshold;
+  is_in_sec_cache = !erase_on_complete;
+
+  handle.reset(new CompressedSecondaryCacheResultHandle(
+      this, lru_handle, create_cb, erase_on_complete));
+  if (!wait) {
+    // Return a pending handle; the decompression and object creation happen
+    // in Wait()/WaitAll(), overlapped across the caller's batch.
+    return handle;
+  }
+
+  CompleteLookup(
+      static_cast<CompressedSecondaryCacheResultHandle*>(handle.get()));
+  if (handle->Value() == nullptr) {
+    handle.reset();
+  }
+  return handle;
+}
+
+void CompressedSecondaryCache::CompleteLookup(
+    CompressedSecondaryCacheResultHandle* handle) {
+  assert(!handle->is_ready_);
+  Cache::Handle* lru_handle = handle->lru_handle_;
+  assert(lru_handle != nullptr);
+
   CacheAllocationPtr* ptr =
-      reinterpret_cast<CacheAllocationPtr*>(cache_->Value(lru_handle));
+      &reinterpret_cast<CacheValue*>(cache_->Value(lru_handle))->ptr;
   void* value = nullptr;
   size_t charge = 0;
   Status s;
 
   if (cache_options_.compression_type == kNoCompression) {
-    s = create_cb(ptr->get(), cache_->GetCharge(lru_handle), &value, &charge);
+    s = handle->create_cb_(ptr->get(), cache_->GetCharge(lru_handle), &value,
+                           &charge);
   } else {
     UncompressionContext uncompression_context(cache_options_.compression_type);
     UncompressionInfo uncompression_info(uncompression_context,
@@ -71,21 +139,61 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
         cache_options_.memory_allocator.get());
 
     if (!uncompressed) {
-      cache_->Release(lru_handle, /* erase_if_last_ref */ true);
-      return handle;
+      s = Status::Corruption("Error uncompressing value.");
+    } else {
+      s = handle->create_cb_(uncompressed.get(), uncompressed_size, &value,
+                             &charge);
     }
-    s = create_cb(uncompressed.get(), uncompressed_size, &value, &charge);
   }
 
-  if (!s.ok()) {
-    cache_->Release(lru_handle, /* erase_if_last_ref */ true);
-    return handle;
+  if (s.ok()) {
+    handle->value_ = value;
+    handle->size_ = charge;
   }
+  cache_->Release(lru_handle,
+                  /* erase_if_last_ref */ handle->erase_on_complete_);
+  handle->lru_handle_ = nullptr;
+  handle->is_ready_ = true;
+}
 
-  cache_->Release(lru_handle, /* erase_if_last_ref */ true);
-  handle.reset(new CompressedSecondaryCacheResultHandle(value, charge));
+void CompressedSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  std::vector<CompressedSecondaryCacheResultHandle*> pending;
+  pending.reserve(handles.size());
+  for (SecondaryCacheResultHandle* handle : handles) {
+    CompressedSecondaryCacheResultHandle* sec_handle =
+        static_cast<CompressedSecondaryCacheResultHandle*>(handle);
+    if (!sec_handle->IsReady()) {
+      pending.push_back(sec_handle);
+    }
+  }
+  if (pending.empty()) {
+    return;
+  }
 
-  return handle;
+  // Farm the deferred decompressions out to a few helper threads and have
+  // the calling thread work through the list alongside them, so the batch
+  // completes in roughly the time of its largest entry. A batch of one is
+  // completed inline, where a thread launch would cost more than it saves.
+  std::atomic<size_t> next(0);
+  auto complete_pending = [this, &next, &pending]() {
+    while (true) {
+      size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= pending.size()) {
+        break;
+      }
+      CompleteLookup(pending[i]);
+    }
+  };
+  std::vector<port::Thread> workers;
+  while (workers.size() + 1 < pending.size() &&
+         workers.size() < kMaxWaitAllWorkers) {
+    workers.emplace_back(complete_pending);
+  }
+  complete_pending();
+  for (port::Thread& worker : workers) {
+    worker.join();
+  }
 }
 
 Status CompressedSecondaryCache::Insert(const Slice& key, void* value,
@@ -123,7 +231,7 @@ Status CompressedSecondaryCache::Insert(const Slice& key, void* value,
     memcpy(ptr.get(), compressed_val.data(), size);
   }
 
-  CacheAllocationPtr* buf = new CacheAllocationPtr(std::move(ptr));
+  CacheValue* buf = new CacheValue(std::move(ptr));
 
   return cache_->Insert(key, buf, size, DeletionCallback);
 }
@@ -150,11 +258,12 @@ std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
     double high_pri_pool_ratio,
     std::shared_ptr<MemoryAllocator> memory_allocator, bool use_adaptive_mutex,
     CacheMetadataChargePolicy metadata_charge_policy,
-    CompressionType compression_type, uint32_t compress_format_version) {
+    CompressionType compression_type, uint32_t compress_format_version,
+    uint32_t promotion_lookup_threshold) {
   return std::make_shared<CompressedSecondaryCache>(
       capacity, num_shard_bits, strict_capacity_limit, high_pri_pool_ratio,
       memory_allocator, use_adaptive_mutex, metadata_charge_policy,
-      compression_type, compress_format_version);
+      compression_type, compress_format_version, promotion_lookup_threshold);
 }
 
 std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
@@ -165,7 +274,7 @@ std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
       opts.capacity, opts.num_shard_bits, opts.strict_capacity_limit,
       opts.high_pri_pool_ratio, opts.memory_allocator, opts.use_adaptive_mutex,
       opts.metadata_charge_policy, opts.compression_type,
-      opts.compress_format_version);
+      opts.compress_format_version, opts.promotion_lookup_threshold);
 }
 
 }  // namespace ROCKSDB_NAMESPACE
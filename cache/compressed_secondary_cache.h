@@ -16,28 +16,55 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class CompressedSecondaryCache;
+
+// A handle for a lookup result. When the lookup is issued with wait=false,
+// the handle starts out pending: the compressed entry stays referenced in
+// the underlying cache and the decompression and object creation are
+// deferred until Wait()/WaitAll(), so callers looking up a whole batch can
+// overlap that work instead of serializing it inside each miss.
 class CompressedSecondaryCacheResultHandle : public SecondaryCacheResultHandle {
  public:
-  CompressedSecondaryCacheResultHandle(void* value, size_t size)
-      : value_(value), size_(size) {}
-  virtual ~CompressedSecondaryCacheResultHandle() override = default;
+  CompressedSecondaryCacheResultHandle(CompressedSecondaryCache* sec_cache,
+                                       Cache::Handle* lru_handle,
+                                       const Cache::CreateCallback& create_cb,
+                                       bool erase_on_complete)
+      : sec_cache_(sec_cache),
+        lru_handle_(lru_handle),
+        create_cb_(create_cb),
+        erase_on_complete_(erase_on_complete),
+        value_(nullptr),
+        size_(0),
+        is_ready_(false) {}
+  virtual ~CompressedSecondaryCacheResultHandle() override;
 
   CompressedSecondaryCacheResultHandle(
       const CompressedSecondaryCacheResultHandle&) = delete;
   CompressedSecondaryCacheResultHandle& operator=(
       const CompressedSecondaryCacheResultHandle&) = delete;
 
-  bool IsReady() override { return true; }
+  bool IsReady() override { return is_ready_; }
 
-  void Wait() override {}
+  void Wait() override;
 
   void* Value() override { return value_; }
 
   size_t Size() override { return size_; }
 
  private:
+  friend class CompressedSecondaryCache;
+
+  CompressedSecondaryCache* sec_cache_;
+  // Holds a reference on the compressed entry until the lookup completes.
+  Cache::Handle* lru_handle_;
+  Cache::CreateCallback create_cb_;
+  // Whether releasing the compressed entry erases it (a full promotion to
+  // the uncompressed tier) or keeps it resident, per the promotion
+  // hysteresis in Lookup().
+  bool erase_on_complete_;
   void* value_;
   size_t size_;
+  bool is_ready_;
 };
 
 // The CompressedSecondaryCache is a concrete implementation of
@@ -60,7 +87,8 @@ class CompressedSecondaryCache : public SecondaryCache {
       CacheMetadataChargePolicy metadata_charge_policy =
           kDontChargeCacheMetadata,
       CompressionType compression_type = CompressionType::kLZ4Compression,
-      uint32_t compress_format_version = 2);
+      uint32_t compress_format_version = 2,
+      uint32_t promotion_lookup_threshold = 1);
   virtual ~CompressedSecondaryCache() override;
 
   const char* Name() const override { return "CompressedSecondaryCache"; }
@@ -74,11 +102,17 @@ class CompressedSecondaryCache : public SecondaryCache {
 
   void Erase(const Slice& key) override;
 
-  void WaitAll(std::vector<SecondaryCacheResultHandle*> /*handles*/) override {}
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
 
   std::string GetPrintableOptions() const override;
 
  private:
+  friend class CompressedSecondaryCacheResultHandle;
+
+  // Perform the deferred decompression and object creation for a pending
+  // handle and mark it ready. On failure the handle's value stays nullptr.
+  void CompleteLookup(CompressedSecondaryCacheResultHandle* handle);
+
   std::shared_ptr<Cache> cache_;
   CompressedSecondaryCacheOptions cache_options_;
 };
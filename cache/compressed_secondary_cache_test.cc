@@ -221,6 +221,138 @@ class CompressedSecondaryCacheTest : public testing::Test {
     sec_cache.reset();
   }
 
+  void DeferredLookupTest(bool sec_cache_is_compressed) {
+    CompressedSecondaryCacheOptions secondary_cache_opts;
+    if (sec_cache_is_compressed) {
+      if (!LZ4_Supported()) {
+        ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+        secondary_cache_opts.compression_type = CompressionType::kNoCompression;
+      }
+    } else {
+      secondary_cache_opts.compression_type = CompressionType::kNoCompression;
+    }
+
+    secondary_cache_opts.capacity = 8192;
+    secondary_cache_opts.num_shard_bits = 0;
+    secondary_cache_opts.metadata_charge_policy = kDontChargeCacheMetadata;
+    std::shared_ptr<SecondaryCache> sec_cache =
+        NewCompressedSecondaryCache(secondary_cache_opts);
+
+    // Insert a batch of items, then look them all up with wait=false so
+    // the decompressions are deferred and performed by WaitAll().
+    Random rnd(301);
+    constexpr size_t kNumItems = 6;
+    std::vector<std::string> strs;
+    std::vector<std::unique_ptr<TestItem>> items;
+    for (size_t i = 0; i < kNumItems; ++i) {
+      std::string str;
+      test::CompressibleString(&rnd, 0.25, 1000, &str);
+      strs.push_back(str);
+      items.emplace_back(new TestItem(str.data(), str.length()));
+      ASSERT_OK(sec_cache->Insert("k" + std::to_string(i), items[i].get(),
+                                  &CompressedSecondaryCacheTest::helper_));
+    }
+
+    bool is_in_sec_cache{false};
+    std::vector<std::unique_ptr<SecondaryCacheResultHandle>> handles;
+    for (size_t i = 0; i < kNumItems; ++i) {
+      handles.push_back(sec_cache->Lookup("k" + std::to_string(i),
+                                          test_item_creator, false,
+                                          is_in_sec_cache));
+      ASSERT_NE(handles[i], nullptr);
+      ASSERT_FALSE(handles[i]->IsReady());
+    }
+
+    std::vector<SecondaryCacheResultHandle*> raw_handles;
+    for (auto& handle : handles) {
+      raw_handles.push_back(handle.get());
+    }
+    sec_cache->WaitAll(raw_handles);
+
+    for (size_t i = 0; i < kNumItems; ++i) {
+      ASSERT_TRUE(handles[i]->IsReady());
+      std::unique_ptr<TestItem> val(
+          static_cast<TestItem*>(handles[i]->Value()));
+      ASSERT_NE(val, nullptr);
+      ASSERT_EQ(memcmp(val->Buf(), items[i]->Buf(), items[i]->Size()), 0);
+    }
+
+    // A pending handle may also be completed individually via Wait(), or
+    // released without ever being waited for.
+    ASSERT_OK(sec_cache->Insert("kw", items[0].get(),
+                                &CompressedSecondaryCacheTest::helper_));
+    std::unique_ptr<SecondaryCacheResultHandle> handle_w =
+        sec_cache->Lookup("kw", test_item_creator, false, is_in_sec_cache);
+    ASSERT_NE(handle_w, nullptr);
+    handle_w->Wait();
+    ASSERT_TRUE(handle_w->IsReady());
+    std::unique_ptr<TestItem> val_w(
+        static_cast<TestItem*>(handle_w->Value()));
+    ASSERT_NE(val_w, nullptr);
+
+    ASSERT_OK(sec_cache->Insert("ka", items[0].get(),
+                                &CompressedSecondaryCacheTest::helper_));
+    std::unique_ptr<SecondaryCacheResultHandle> handle_a =
+        sec_cache->Lookup("ka", test_item_creator, false, is_in_sec_cache);
+    ASSERT_NE(handle_a, nullptr);
+    handle_a.reset();
+
+    sec_cache.reset();
+  }
+
+  void PromotionHysteresisTest(bool sec_cache_is_compressed) {
+    CompressedSecondaryCacheOptions secondary_cache_opts;
+    if (sec_cache_is_compressed) {
+      if (!LZ4_Supported()) {
+        ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+        secondary_cache_opts.compression_type = CompressionType::kNoCompression;
+      }
+    } else {
+      secondary_cache_opts.compression_type = CompressionType::kNoCompression;
+    }
+
+    secondary_cache_opts.capacity = 8192;
+    secondary_cache_opts.num_shard_bits = 0;
+    secondary_cache_opts.metadata_charge_policy = kDontChargeCacheMetadata;
+    secondary_cache_opts.promotion_lookup_threshold = 2;
+    std::shared_ptr<SecondaryCache> sec_cache =
+        NewCompressedSecondaryCache(secondary_cache_opts);
+
+    Random rnd(301);
+    std::string str1;
+    test::CompressibleString(&rnd, 0.25, 1000, &str1);
+    TestItem item1(str1.data(), str1.length());
+    ASSERT_OK(sec_cache->Insert("k1", &item1,
+                                &CompressedSecondaryCacheTest::helper_));
+
+    // The first lookup returns the value but keeps the compressed copy
+    // resident, reporting it as still in the secondary cache.
+    bool is_in_sec_cache{false};
+    std::unique_ptr<SecondaryCacheResultHandle> handle1 =
+        sec_cache->Lookup("k1", test_item_creator, true, is_in_sec_cache);
+    ASSERT_NE(handle1, nullptr);
+    ASSERT_TRUE(is_in_sec_cache);
+    std::unique_ptr<TestItem> val1(static_cast<TestItem*>(handle1->Value()));
+    ASSERT_NE(val1, nullptr);
+    ASSERT_EQ(memcmp(val1->Buf(), item1.Buf(), item1.Size()), 0);
+
+    // The second lookup crosses the threshold: the entry is promoted and
+    // erased from the compressed tier.
+    std::unique_ptr<SecondaryCacheResultHandle> handle2 =
+        sec_cache->Lookup("k1", test_item_creator, true, is_in_sec_cache);
+    ASSERT_NE(handle2, nullptr);
+    ASSERT_FALSE(is_in_sec_cache);
+    std::unique_ptr<TestItem> val2(static_cast<TestItem*>(handle2->Value()));
+    ASSERT_NE(val2, nullptr);
+    ASSERT_EQ(memcmp(val2->Buf(), item1.Buf(), item1.Size()), 0);
+
+    std::unique_ptr<SecondaryCacheResultHandle> handle3 =
+        sec_cache->Lookup("k1", test_item_creator, true, is_in_sec_cache);
+    ASSERT_EQ(handle3, nullptr);
+
+    sec_cache.reset();
+  }
+
   void BasicIntegrationTest(bool sec_cache_is_compressed) {
     CompressedSecondaryCacheOptions secondary_cache_opts;
 
@@ -595,6 +727,22 @@ TEST_F(CompressedSecondaryCacheTest, FailsTestWithCompression) {
   FailsTest(true);
 }
 
+TEST_F(CompressedSecondaryCacheTest, DeferredLookupTestWithNoCompression) {
+  DeferredLookupTest(false);
+}
+
+TEST_F(CompressedSecondaryCacheTest, DeferredLookupTestWithCompression) {
+  DeferredLookupTest(true);
+}
+
+TEST_F(CompressedSecondaryCacheTest, PromotionHysteresisTestWithNoCompression) {
+  PromotionHysteresisTest(false);
+}
+
+TEST_F(CompressedSecondaryCacheTest, PromotionHysteresisTestWithCompression) {
+  PromotionHysteresisTest(true);
+}
+
 TEST_F(CompressedSecondaryCacheTest, BasicIntegrationTestWithNoCompression) {
   BasicIntegrationTest(false);
 }
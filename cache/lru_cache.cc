@@ -17,6 +17,7 @@
 #include "monitoring/statistics.h"
 #include "port/lang.h"
 #include "util/distributed_mutex.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace lru_cache {
@@ -111,13 +112,15 @@ void LRUHandleTable::Resize() {
 
 LRUCacheShard::LRUCacheShard(
     size_t capacity, bool strict_capacity_limit, double high_pri_pool_ratio,
-    bool use_adaptive_mutex, CacheMetadataChargePolicy metadata_charge_policy,
-    int max_upper_hash_bits,
+    double low_watermark_ratio, bool use_adaptive_mutex,
+    CacheMetadataChargePolicy metadata_charge_policy, int max_upper_hash_bits,
     const std::shared_ptr<SecondaryCache>& secondary_cache)
     : capacity_(0),
+      low_watermark_(0),
       high_pri_pool_usage_(0),
       strict_capacity_limit_(strict_capacity_limit),
       high_pri_pool_ratio_(high_pri_pool_ratio),
+      low_watermark_ratio_(low_watermark_ratio),
       high_pri_pool_capacity_(0),
       table_(max_upper_hash_bits),
       usage_(0),
@@ -269,7 +272,11 @@ void LRUCacheShard::MaintainPoolSize() {
 
 void LRUCacheShard::EvictFromLRU(size_t charge,
                                  autovector<LRUHandle*>* deleted) {
-  while ((usage_ + charge) > capacity_ && lru_.next != &lru_) {
+  // Only once capacity is exceeded does the pass extend down to the low
+  // watermark, so a zero low_watermark_ratio_ (where low_watermark_ ==
+  // capacity_) behaves exactly like strict per-insert eviction.
+  size_t limit = (usage_ + charge) > capacity_ ? low_watermark_ : capacity_;
+  while ((usage_ + charge) > limit && lru_.next != &lru_) {
     LRUHandle* old = lru_.next;
     // LRU list contains only elements which can be evicted.
     assert(old->InCache() && !old->HasRefs());
@@ -288,6 +295,8 @@ void LRUCacheShard::SetCapacity(size_t capacity) {
     DMutexLock l(mutex_);
     capacity_ = capacity;
     high_pri_pool_capacity_ = capacity_ * high_pri_pool_ratio_;
+    low_watermark_ =
+        static_cast<size_t>(capacity_ * (1.0 - low_watermark_ratio_));
     EvictFromLRU(0, &last_reference_list);
   }
 
@@ -308,57 +317,117 @@ void LRUCacheShard::SetStrictCapacityLimit(bool strict_capacity_limit) {
   strict_capacity_limit_ = strict_capacity_limit;
 }
 
+void LRUCacheShard::TrimToLowWatermark() {
+  autovector<LRUHandle*> last_reference_list;
+  {
+    DMutexLock l(mutex_);
+    if (usage_ <= capacity_) {
+      return;
+    }
+    EvictFromLRU(0, &last_reference_list);
+  }
+
+  // Try to insert the evicted entries into tiered cache.
+  // Free the entries outside of mutex for performance reasons.
+  for (auto entry : last_reference_list) {
+    if (secondary_cache_ && entry->IsSecondaryCacheCompatible() &&
+        !entry->IsInSecondaryCache()) {
+      secondary_cache_->Insert(entry->key(), entry->value, entry->info_.helper)
+          .PermitUncheckedError();
+    }
+    entry->Free();
+  }
+}
+
+void LRUCacheShard::EnableBackgroundTrim(LRUCache* cache) {
+  DMutexLock l(mutex_);
+  trim_owner_ = cache;
+}
+
 Status LRUCacheShard::InsertItem(LRUHandle* e, Cache::Handle** handle,
                                  bool free_handle_on_fail) {
   Status s = Status::OK();
   autovector<LRUHandle*> last_reference_list;
+  LRUCache* cache_to_trim = nullptr;
 
   {
     DMutexLock l(mutex_);
 
-    // Free the space following strict LRU policy until enough space
-    // is freed or the lru list is empty.
-    EvictFromLRU(e->total_charge, &last_reference_list);
-
-    if ((usage_ + e->total_charge) > capacity_ &&
-        (strict_capacity_limit_ || handle == nullptr)) {
+    // With a background trimmer (and no strict limit), inserts skip inline
+    // eviction entirely; usage may transiently exceed capacity until the
+    // trimmer brings it back down to the low watermark.
+    const bool deferred_eviction =
+        trim_owner_ != nullptr && !strict_capacity_limit_;
+
+    // Before evicting to make room, ask the admission policy (if any)
+    // whether the incoming entry is hotter than the LRU eviction candidate.
+    // A rejected entry is never linked into the table: with no pending
+    // handle it is dropped as if immediately evicted, and with a handle it
+    // stays charged and pinned until released, so a one-time scan cannot
+    // displace the resident working set.
+    if (admission_policy_ != nullptr &&
+        (usage_ + e->total_charge) > capacity_ && lru_.next != &lru_ &&
+        !admission_policy_->Admit(e->hash, lru_.next->hash)) {
       e->SetInCache(false);
       if (handle == nullptr) {
-        // Don't insert the entry but still return ok, as if the entry inserted
-        // into cache and get evicted immediately.
         last_reference_list.push_back(e);
       } else {
-        if (free_handle_on_fail) {
-          delete[] reinterpret_cast<char*>(e);
-          *handle = nullptr;
+        usage_ += e->total_charge;
+        if (!e->HasRefs()) {
+          e->Ref();
         }
-        s = Status::MemoryLimit("Insert failed due to LRU cache being full.");
+        *handle = reinterpret_cast<Cache::Handle*>(e);
       }
     } else {
-      // Insert into the cache. Note that the cache might get larger than its
-      // capacity if not enough space was freed up.
-      LRUHandle* old = table_.Insert(e);
-      usage_ += e->total_charge;
-      if (old != nullptr) {
-        s = Status::OkOverwritten();
-        assert(old->InCache());
-        old->SetInCache(false);
-        if (!old->HasRefs()) {
-          // old is on LRU because it's in cache and its reference count is 0.
-          LRU_Remove(old);
-          assert(usage_ >= old->total_charge);
-          usage_ -= old->total_charge;
-          last_reference_list.push_back(old);
-        }
+      if (!deferred_eviction) {
+        // Free the space following strict LRU policy until enough space
+        // is freed or the lru list is empty.
+        EvictFromLRU(e->total_charge, &last_reference_list);
       }
-      if (handle == nullptr) {
-        LRU_Insert(e);
+
+      if (!deferred_eviction && (usage_ + e->total_charge) > capacity_ &&
+          (strict_capacity_limit_ || handle == nullptr)) {
+        e->SetInCache(false);
+        if (handle == nullptr) {
+          // Don't insert the entry but still return ok, as if the entry
+          // inserted into cache and get evicted immediately.
+          last_reference_list.push_back(e);
+        } else {
+          if (free_handle_on_fail) {
+            delete[] reinterpret_cast<char*>(e);
+            *handle = nullptr;
+          }
+          s = Status::MemoryLimit("Insert failed due to LRU cache being full.");
+        }
       } else {
-        // If caller already holds a ref, no need to take one here.
-        if (!e->HasRefs()) {
-          e->Ref();
+        // Insert into the cache. Note that the cache might get larger than its
+        // capacity if not enough space was freed up.
+        LRUHandle* old = table_.Insert(e);
+        usage_ += e->total_charge;
+        if (old != nullptr) {
+          s = Status::OkOverwritten();
+          assert(old->InCache());
+          old->SetInCache(false);
+          if (!old->HasRefs()) {
+            // old is on LRU because it's in cache and its reference count is 0.
+            LRU_Remove(old);
+            assert(usage_ >= old->total_charge);
+            usage_ -= old->total_charge;
+            last_reference_list.push_back(old);
+          }
+        }
+        if (handle == nullptr) {
+          LRU_Insert(e);
+        } else {
+          // If caller already holds a ref, no need to take one here.
+          if (!e->HasRefs()) {
+            e->Ref();
+          }
+          *handle = reinterpret_cast<Cache::Handle*>(e);
+        }
+        if (deferred_eviction && usage_ > capacity_) {
+          cache_to_trim = trim_owner_;
         }
-        *handle = reinterpret_cast<Cache::Handle*>(e);
       }
     }
   }
@@ -374,6 +443,10 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, Cache::Handle** handle,
     entry->Free();
   }
 
+  if (cache_to_trim != nullptr) {
+    cache_to_trim->ScheduleTrim();
+  }
+
   return s;
 }
 
@@ -452,6 +525,7 @@ Cache::Handle* LRUCacheShard::Lookup(
       e->info_.helper = helper;
       e->key_length = key.size();
       e->hash = hash;
+      e->numa_node = numa_node_;
       e->refs = 0;
       e->next = e->prev = nullptr;
       e->SetPriority(priority);
@@ -569,6 +643,7 @@ Status LRUCacheShard::Insert(const Slice& key, uint32_t hash, void* value,
   }
   e->key_length = key.size();
   e->hash = hash;
+  e->numa_node = numa_node_;
   e->refs = 0;
   e->next = e->prev = nullptr;
   e->SetInCache(true);
@@ -644,9 +719,12 @@ LRUCache::LRUCache(size_t capacity, int num_shard_bits,
                    std::shared_ptr<MemoryAllocator> allocator,
                    bool use_adaptive_mutex,
                    CacheMetadataChargePolicy metadata_charge_policy,
-                   const std::shared_ptr<SecondaryCache>& secondary_cache)
+                   const std::shared_ptr<SecondaryCache>& secondary_cache,
+                   double low_watermark_ratio, bool use_background_trimmer,
+                   bool numa_aware)
     : ShardedCache(capacity, num_shard_bits, strict_capacity_limit,
-                   std::move(allocator)) {
+                   std::move(allocator), numa_aware),
+      trimmer_signal_(&trimmer_mutex_) {
   num_shards_ = 1 << num_shard_bits;
   shards_ = reinterpret_cast<LRUCacheShard*>(
       port::cacheline_aligned_alloc(sizeof(LRUCacheShard) * num_shards_));
@@ -654,13 +732,29 @@ LRUCache::LRUCache(size_t capacity, int num_shard_bits,
   for (int i = 0; i < num_shards_; i++) {
     new (&shards_[i]) LRUCacheShard(
         per_shard, strict_capacity_limit, high_pri_pool_ratio,
-        use_adaptive_mutex, metadata_charge_policy,
+        low_watermark_ratio, use_adaptive_mutex, metadata_charge_policy,
         /* max_upper_hash_bits */ 32 - num_shard_bits, secondary_cache);
+    shards_[i].SetNumaNode(
+        static_cast<uint8_t>(GetNumaNodeOfShard(static_cast<uint32_t>(i))));
   }
   secondary_cache_ = secondary_cache;
+  if (use_background_trimmer && !strict_capacity_limit) {
+    for (int i = 0; i < num_shards_; i++) {
+      shards_[i].EnableBackgroundTrim(this);
+    }
+    trimmer_.reset(new port::Thread(&LRUCache::BackgroundTrimmer, this));
+  }
 }
 
 LRUCache::~LRUCache() {
+  if (trimmer_) {
+    {
+      MutexLock l(&trimmer_mutex_);
+      trimmer_stop_ = true;
+      trimmer_signal_.SignalAll();
+    }
+    trimmer_->join();
+  }
   if (shards_ != nullptr) {
     assert(num_shards_ > 0);
     for (int i = 0; i < num_shards_; i++) {
@@ -670,6 +764,33 @@ LRUCache::~LRUCache() {
   }
 }
 
+void LRUCache::ScheduleTrim() {
+  MutexLock l(&trimmer_mutex_);
+  trimmer_pending_ = true;
+  trimmer_signal_.Signal();
+}
+
+void LRUCache::BackgroundTrimmer() {
+  MutexLock l(&trimmer_mutex_);
+  while (!trimmer_stop_) {
+    while (!trimmer_pending_ && !trimmer_stop_) {
+      trimmer_signal_.Wait();
+    }
+    if (trimmer_stop_) {
+      break;
+    }
+    trimmer_pending_ = false;
+    // Trim outside of trimmer_mutex_ so ScheduleTrim() never blocks on a
+    // shard mutex held here; a signal arriving meanwhile is picked up by
+    // the next iteration.
+    trimmer_mutex_.Unlock();
+    for (int i = 0; i < num_shards_; i++) {
+      shards_[i].TrimToLowWatermark();
+    }
+    trimmer_mutex_.Lock();
+  }
+}
+
 CacheShard* LRUCache::GetShard(uint32_t shard) {
   return reinterpret_cast<CacheShard*>(&shards_[shard]);
 }
@@ -704,6 +825,11 @@ uint32_t LRUCache::GetHash(Handle* handle) const {
   return reinterpret_cast<const LRUHandle*>(handle)->hash;
 }
 
+uint32_t LRUCache::ShardOfHandle(Handle* handle) const {
+  const LRUHandle* h = reinterpret_cast<const LRUHandle*>(handle);
+  return NumaShard(h->numa_node, h->hash);
+}
+
 void LRUCache::DisownData() {
   // Leak data only if that won't generate an ASAN/valgrind warning.
   if (!kMustFreeHeapAllocations) {
@@ -751,8 +877,8 @@ void LRUCache::WaitAll(std::vector<Handle*>& handles) {
       if (!lru_handle->IsPending()) {
         continue;
       }
-      uint32_t hash = GetHash(handle);
-      LRUCacheShard* shard = static_cast<LRUCacheShard*>(GetShard(Shard(hash)));
+      LRUCacheShard* shard =
+          static_cast<LRUCacheShard*>(GetShard(ShardOfHandle(handle)));
       shard->Promote(lru_handle);
     }
   }
@@ -776,7 +902,9 @@ std::shared_ptr<Cache> NewLRUCache(
     double high_pri_pool_ratio,
     std::shared_ptr<MemoryAllocator> memory_allocator, bool use_adaptive_mutex,
     CacheMetadataChargePolicy metadata_charge_policy,
-    const std::shared_ptr<SecondaryCache>& secondary_cache) {
+    const std::shared_ptr<SecondaryCache>& secondary_cache,
+    double low_watermark_ratio = 0.0, bool use_background_trimmer = false,
+    bool numa_aware = false) {
   if (num_shard_bits >= 20) {
     return nullptr;  // The cache cannot be sharded into too many fine pieces.
   }
@@ -784,13 +912,18 @@ std::shared_ptr<Cache> NewLRUCache(
     // Invalid high_pri_pool_ratio
     return nullptr;
   }
+  if (low_watermark_ratio < 0.0 || low_watermark_ratio > 1.0) {
+    // Invalid low_watermark_ratio
+    return nullptr;
+  }
   if (num_shard_bits < 0) {
     num_shard_bits = GetDefaultCacheShardBits(capacity);
   }
   return std::make_shared<LRUCache>(
       capacity, num_shard_bits, strict_capacity_limit, high_pri_pool_ratio,
       std::move(memory_allocator), use_adaptive_mutex, metadata_charge_policy,
-      secondary_cache);
+      secondary_cache, low_watermark_ratio, use_background_trimmer,
+      numa_aware);
 }
 
 std::shared_ptr<Cache> NewLRUCache(const LRUCacheOptions& cache_opts) {
@@ -798,7 +931,9 @@ std::shared_ptr<Cache> NewLRUCache(const LRUCacheOptions& cache_opts) {
       cache_opts.capacity, cache_opts.num_shard_bits,
       cache_opts.strict_capacity_limit, cache_opts.high_pri_pool_ratio,
       cache_opts.memory_allocator, cache_opts.use_adaptive_mutex,
-      cache_opts.metadata_charge_policy, cache_opts.secondary_cache);
+      cache_opts.metadata_charge_policy, cache_opts.secondary_cache,
+      cache_opts.low_watermark_ratio, cache_opts.use_background_trimmer,
+      cache_opts.numa_aware);
 }
 
 std::shared_ptr<Cache> NewLRUCache(
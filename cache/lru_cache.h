@@ -93,6 +93,11 @@ struct LRUHandle {
 
   uint8_t flags;
 
+  // The NUMA node group of the shard holding this entry, so that handle
+  // operations can be routed to the owning shard when NUMA-aware shard
+  // selection is enabled. Always 0 otherwise.
+  uint8_t numa_node;
+
 #ifdef __SANITIZE_THREAD__
   // TSAN can report a false data race on flags, where one thread is writing
   // to one of the mutable bits and another thread is reading this immutable
@@ -294,11 +299,14 @@ class LRUHandleTable {
   const int max_length_bits_;
 };
 
+class LRUCache;
+
 // A single shard of sharded cache.
 class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
  public:
   LRUCacheShard(size_t capacity, bool strict_capacity_limit,
-                double high_pri_pool_ratio, bool use_adaptive_mutex,
+                double high_pri_pool_ratio, double low_watermark_ratio,
+                bool use_adaptive_mutex,
                 CacheMetadataChargePolicy metadata_charge_policy,
                 int max_upper_hash_bits,
                 const std::shared_ptr<SecondaryCache>& secondary_cache);
@@ -375,6 +383,21 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   //  Retrieves high pri pool ratio
   double GetHighPriPoolRatio();
 
+  // Evict entries in one batched pass until usage is at or below the low
+  // watermark, releasing them outside the mutex. No-op while usage is at or
+  // below capacity. Called by the owning cache's background trimmer.
+  void TrimToLowWatermark();
+
+  // Route eviction work for this shard to the given cache's background
+  // trimmer instead of performing it inline during inserts. Must be called
+  // before the shard is used. Has no effect under strict_capacity_limit.
+  void EnableBackgroundTrim(LRUCache* cache);
+
+  // Set the NUMA node group this shard belongs to, recorded in each handle
+  // the shard creates so the owning cache can route handle operations back
+  // here. Must be called before the shard is used.
+  void SetNumaNode(uint8_t numa_node) { numa_node_ = numa_node; }
+
  private:
   friend class LRUCache;
   // Insert an item into the hash table and, if handle is null, insert into
@@ -403,7 +426,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   void MaintainPoolSize();
 
   // Free some space following strict LRU policy until enough space
-  // to hold (usage_ + charge) is freed or the lru list is empty
+  // to hold (usage_ + charge) is freed or the lru list is empty. When a low
+  // watermark is configured and capacity is exceeded, keeps evicting in the
+  // same pass until usage drops to the watermark.
   // This function is not thread safe - it needs to be executed while
   // holding the mutex_.
   void EvictFromLRU(size_t charge, autovector<LRUHandle*>* deleted);
@@ -411,6 +436,11 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   // Initialized before use.
   size_t capacity_;
 
+  // Usage level that batched eviction passes drop to once capacity is
+  // exceeded. Equals capacity_ * (1 - low_watermark_ratio_); with a zero
+  // ratio it equals capacity_ and eviction is strictly per-insert.
+  size_t low_watermark_;
+
   // Memory size for entries in high-pri pool.
   size_t high_pri_pool_usage_;
 
@@ -420,6 +450,16 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   // Ratio of capacity reserved for high priority cache entries.
   double high_pri_pool_ratio_;
 
+  // Fraction of capacity freed beyond the minimum when eviction runs.
+  double low_watermark_ratio_;
+
+  // Owning cache whose background trimmer performs eviction for this shard,
+  // or nullptr if eviction is inline. See EnableBackgroundTrim().
+  LRUCache* trim_owner_ = nullptr;
+
+  // NUMA node group of this shard, stamped on every handle it creates.
+  uint8_t numa_node_ = 0;
+
   // High-pri pool size, equals to capacity * high_pri_pool_ratio.
   // Remember the value to avoid recomputing each time.
   double high_pri_pool_capacity_;
@@ -471,7 +511,9 @@ class LRUCache
            bool use_adaptive_mutex = kDefaultToAdaptiveMutex,
            CacheMetadataChargePolicy metadata_charge_policy =
                kDontChargeCacheMetadata,
-           const std::shared_ptr<SecondaryCache>& secondary_cache = nullptr);
+           const std::shared_ptr<SecondaryCache>& secondary_cache = nullptr,
+           double low_watermark_ratio = 0.0,
+           bool use_background_trimmer = false, bool numa_aware = false);
   virtual ~LRUCache();
   virtual const char* Name() const override { return "LRUCache"; }
   virtual CacheShard* GetShard(uint32_t shard) override;
@@ -489,10 +531,31 @@ class LRUCache
   // Retrieves high pri pool ratio.
   double GetHighPriPoolRatio();
 
+  // Wake the background trimmer so it trims all shards back to their low
+  // watermark. Called by shards, outside of their mutex, when an insert
+  // pushes usage above capacity. No-op without a background trimmer.
+  void ScheduleTrim();
+
+ protected:
+  // Routes handle operations to the owning shard using the NUMA node group
+  // recorded in the handle at insertion time.
+  uint32_t ShardOfHandle(Handle* handle) const override;
+
  private:
+  // Main loop of the background trimmer thread.
+  void BackgroundTrimmer();
+
   LRUCacheShard* shards_ = nullptr;
   int num_shards_ = 0;
   std::shared_ptr<SecondaryCache> secondary_cache_;
+
+  // State for the optional background trimmer thread, which performs batched
+  // eviction on behalf of the shards. trimmer_mutex_ protects the two flags.
+  port::Mutex trimmer_mutex_;
+  port::CondVar trimmer_signal_;
+  bool trimmer_pending_ = false;
+  bool trimmer_stop_ = false;
+  std::unique_ptr<port::Thread> trimmer_;
 };
 
 }  // namespace lru_cache
@@ -41,13 +41,14 @@ class LRUCacheTest : public testing::Test {
   }
 
   void NewCache(size_t capacity, double high_pri_pool_ratio = 0.0,
-                bool use_adaptive_mutex = kDefaultToAdaptiveMutex) {
+                bool use_adaptive_mutex = kDefaultToAdaptiveMutex,
+                double low_watermark_ratio = 0.0) {
     DeleteCache();
     cache_ = reinterpret_cast<LRUCacheShard*>(
         port::cacheline_aligned_alloc(sizeof(LRUCacheShard)));
     new (cache_) LRUCacheShard(
         capacity, false /*strict_capcity_limit*/, high_pri_pool_ratio,
-        use_adaptive_mutex, kDontChargeCacheMetadata,
+        low_watermark_ratio, use_adaptive_mutex, kDontChargeCacheMetadata,
         24 /*max_upper_hash_bits*/, nullptr /*secondary_cache*/);
   }
 
@@ -210,6 +211,96 @@ TEST_F(LRUCacheTest, EntriesWithPriority) {
 // TODO: FastLRUCache and ClockCache use the same tests. We can probably remove
 // them from FastLRUCache after ClockCache becomes productive, and we don't plan
 // to use or maintain FastLRUCache any more.
+TEST_F(LRUCacheTest, LowWatermarkBatchedEviction) {
+  NewCache(10, 0.0 /*high_pri_pool_ratio*/, kDefaultToAdaptiveMutex,
+           0.5 /*low_watermark_ratio*/);
+  for (char ch = 'a'; ch <= 'j'; ch++) {
+    Insert(ch);
+  }
+  ValidateLRUList({"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"});
+
+  // Crossing capacity evicts in one batched pass down to the low watermark
+  // (5), not just enough to fit the new entry.
+  Insert('k');
+  ValidateLRUList({"g", "h", "i", "j", "k"});
+
+  // While usage stays at or below capacity, inserts evict nothing.
+  Insert('l');
+  Insert('m');
+  ValidateLRUList({"g", "h", "i", "j", "k", "l", "m"});
+}
+
+TEST_F(LRUCacheTest, BackgroundTrimmer) {
+  LRUCacheOptions opts(10 /*capacity*/, 0 /*num_shard_bits*/,
+                       false /*strict_capacity_limit*/,
+                       0.0 /*high_pri_pool_ratio*/,
+                       nullptr /*memory_allocator*/, kDefaultToAdaptiveMutex,
+                       kDontChargeCacheMetadata);
+  opts.low_watermark_ratio = 0.5;
+  opts.use_background_trimmer = true;
+  std::shared_ptr<Cache> cache = NewLRUCache(opts);
+
+  // Inserts don't evict inline, so usage can exceed capacity. Keep inserting
+  // until usage is observed above capacity; the insert that left it there is
+  // guaranteed to have signaled the trimmer after the observation.
+  int i = 0;
+  while (cache->GetUsage() <= 10) {
+    ASSERT_OK(cache->Insert(std::to_string(i++), nullptr /*value*/,
+                            1 /*charge*/, nullptr /*deleter*/));
+    ASSERT_LT(i, 100000);
+  }
+
+  // The background trimmer brings usage back down to the low watermark.
+  for (int j = 0; j < 10000 && cache->GetUsage() > 5; j++) {
+    Env::Default()->SleepForMicroseconds(1000);
+  }
+  ASSERT_LE(cache->GetUsage(), 5U);
+}
+
+TEST_F(LRUCacheTest, TinyLFUAdmissionPolicy) {
+  std::shared_ptr<Cache> cache = NewLRUCache(
+      10 /*capacity*/, 0 /*num_shard_bits*/, false /*strict_capacity_limit*/,
+      0.0 /*high_pri_pool_ratio*/, nullptr /*memory_allocator*/,
+      kDefaultToAdaptiveMutex, kDontChargeCacheMetadata);
+  static_cast<ShardedCache*>(cache.get())
+      ->SetAdmissionPolicy(NewTinyLFUAdmissionPolicy(4096));
+
+  // Fill the cache with a hot working set and access it a few times.
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(cache->Insert("hot" + std::to_string(i), nullptr /*value*/,
+                            1 /*charge*/, nullptr /*deleter*/));
+  }
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 10; i++) {
+      Cache::Handle* handle = cache->Lookup("hot" + std::to_string(i));
+      ASSERT_NE(handle, nullptr);
+      cache->Release(handle);
+    }
+  }
+
+  // A scan of one-time accesses must not displace the hot working set.
+  for (int i = 0; i < 100; i++) {
+    ASSERT_OK(cache->Insert("scan" + std::to_string(i), nullptr /*value*/,
+                            1 /*charge*/, nullptr /*deleter*/));
+  }
+  for (int i = 0; i < 10; i++) {
+    Cache::Handle* handle = cache->Lookup("hot" + std::to_string(i));
+    ASSERT_NE(handle, nullptr);
+    cache->Release(handle);
+  }
+
+  // A new key that keeps being requested becomes at least as hot as the
+  // eviction candidate and does get admitted.
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(cache->Lookup("fresh"), nullptr);
+  }
+  ASSERT_OK(
+      cache->Insert("fresh", nullptr /*value*/, 1 /*charge*/, nullptr));
+  Cache::Handle* handle = cache->Lookup("fresh");
+  ASSERT_NE(handle, nullptr);
+  cache->Release(handle);
+}
+
 namespace fast_lru_cache {
 
 // TODO(guido) Replicate LRU policy tests from LRUCache here.
@@ -1699,6 +1790,147 @@ TEST_F(DBSecondaryCacheTest, LRUCacheDumpLoadBasic) {
   Destroy(options);
 }
 
+TEST_F(DBSecondaryCacheTest, LRUCacheDumpLoadParallel) {
+  LRUCacheOptions cache_opts(1024 * 1024, 0, false, 0.5, nullptr,
+                             kDefaultToAdaptiveMutex, kDontChargeCacheMetadata);
+  LRUCacheWithStat* tmp_cache = new LRUCacheWithStat(
+      cache_opts.capacity, cache_opts.num_shard_bits,
+      cache_opts.strict_capacity_limit, cache_opts.high_pri_pool_ratio,
+      cache_opts.memory_allocator, cache_opts.use_adaptive_mutex,
+      cache_opts.metadata_charge_policy, cache_opts.secondary_cache);
+  std::shared_ptr<Cache> cache(tmp_cache);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = cache;
+  table_options.block_size = 4 * 1024;
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.env = fault_env_.get();
+  DestroyAndReopen(options);
+  fault_fs_->SetFailGetUniqueId(true);
+
+  const int N = 256;
+  std::vector<std::string> value;
+  char buf[1000];
+  memset(buf, 'a', 1000);
+  value.resize(N);
+  for (int i = 0; i < N; i++) {
+    std::string p_v(buf, 1000);
+    value[i] = p_v;
+    ASSERT_OK(Put(Key(i), p_v));
+  }
+  ASSERT_OK(Flush());
+  Compact("a", "z");
+
+  // Read all the key value pairs so all the blocks are in cache.
+  std::string v;
+  for (int i = 0; i < N; i++) {
+    v = Get(Key(i));
+    ASSERT_EQ(v, value[i]);
+  }
+
+  // Dump with 4 worker threads. The stream is the same format as the
+  // single-threaded one, only produced in a different order.
+  CacheDumpOptions cd_options;
+  cd_options.clock = fault_env_->GetSystemClock().get();
+  cd_options.worker_threads = 4;
+  std::string dump_path = db_->GetName() + "/cache_dump";
+  std::unique_ptr<CacheDumpWriter> dump_writer;
+  Status s = NewToFileCacheDumpWriter(fault_fs_, FileOptions(), dump_path,
+                                      &dump_writer);
+  ASSERT_OK(s);
+  std::unique_ptr<CacheDumper> cache_dumper;
+  s = NewDefaultCacheDumper(cd_options, cache, std::move(dump_writer),
+                            &cache_dumper);
+  ASSERT_OK(s);
+  std::vector<DB*> db_list;
+  db_list.push_back(db_);
+  s = cache_dumper->SetDumpFilter(db_list);
+  ASSERT_OK(s);
+  s = cache_dumper->DumpCacheEntriesToWriter();
+  ASSERT_OK(s);
+  std::set<std::string> dumped_keys = cache_dumper->GetDumpedKeys();
+  ASSERT_EQ(64, static_cast<int>(dumped_keys.size()));
+  cache_dumper.reset();
+
+  // An incremental dump that excludes everything the first dump wrote
+  // should contain no blocks, since the cache content did not change.
+  std::string incr_dump_path = db_->GetName() + "/cache_dump_incr";
+  std::unique_ptr<CacheDumpWriter> incr_writer;
+  s = NewToFileCacheDumpWriter(fault_fs_, FileOptions(), incr_dump_path,
+                               &incr_writer);
+  ASSERT_OK(s);
+  std::unique_ptr<CacheDumper> incr_dumper;
+  s = NewDefaultCacheDumper(cd_options, cache, std::move(incr_writer),
+                            &incr_dumper);
+  ASSERT_OK(s);
+  s = incr_dumper->SetDumpFilter(db_list);
+  ASSERT_OK(s);
+  s = incr_dumper->SetAlreadyDumpedKeys(dumped_keys);
+  ASSERT_OK(s);
+  s = incr_dumper->DumpCacheEntriesToWriter();
+  ASSERT_OK(s);
+  ASSERT_EQ(0, static_cast<int>(incr_dumper->GetDumpedKeys().size()));
+  incr_dumper.reset();
+
+  // Load the full dump with 4 worker threads into a fresh secondary cache.
+  std::shared_ptr<TestSecondaryCache> secondary_cache =
+      std::make_shared<TestSecondaryCache>(2048 * 1024);
+  cache_opts.secondary_cache = secondary_cache;
+  tmp_cache = new LRUCacheWithStat(
+      cache_opts.capacity, cache_opts.num_shard_bits,
+      cache_opts.strict_capacity_limit, cache_opts.high_pri_pool_ratio,
+      cache_opts.memory_allocator, cache_opts.use_adaptive_mutex,
+      cache_opts.metadata_charge_policy, cache_opts.secondary_cache);
+  std::shared_ptr<Cache> cache_new(tmp_cache);
+  table_options.block_cache = cache_new;
+  table_options.block_size = 4 * 1024;
+  options.create_if_missing = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.env = fault_env_.get();
+
+  std::unique_ptr<CacheDumpReader> dump_reader;
+  s = NewFromFileCacheDumpReader(fault_fs_, FileOptions(), dump_path,
+                                 &dump_reader);
+  ASSERT_OK(s);
+  std::unique_ptr<CacheDumpedLoader> cache_loader;
+  s = NewDefaultCacheDumpedLoader(cd_options, table_options, secondary_cache,
+                                  std::move(dump_reader), &cache_loader);
+  ASSERT_OK(s);
+  s = cache_loader->RestoreCacheEntriesToSecondaryCache();
+  ASSERT_OK(s);
+  ASSERT_EQ(64, static_cast<int>(secondary_cache->num_inserts()));
+
+  // Loading the (empty) incremental dump on top is a no-op.
+  std::unique_ptr<CacheDumpReader> incr_reader;
+  s = NewFromFileCacheDumpReader(fault_fs_, FileOptions(), incr_dump_path,
+                                 &incr_reader);
+  ASSERT_OK(s);
+  std::unique_ptr<CacheDumpedLoader> incr_loader;
+  s = NewDefaultCacheDumpedLoader(cd_options, table_options, secondary_cache,
+                                  std::move(incr_reader), &incr_loader);
+  ASSERT_OK(s);
+  s = incr_loader->RestoreCacheEntriesToSecondaryCache();
+  ASSERT_OK(s);
+  ASSERT_EQ(64, static_cast<int>(secondary_cache->num_inserts()));
+
+  Reopen(options);
+
+  // After the load, all the reads are served without inserting to the
+  // secondary cache again.
+  uint32_t start_lookup = secondary_cache->num_lookups();
+  for (int i = 0; i < N; i++) {
+    v = Get(Key(i));
+    ASSERT_EQ(v, value[i]);
+  }
+  ASSERT_EQ(64, static_cast<int>(secondary_cache->num_inserts()));
+  ASSERT_EQ(64,
+            static_cast<int>(secondary_cache->num_lookups() - start_lookup));
+
+  fault_fs_->SetFailGetUniqueId(false);
+  Destroy(options);
+}
+
 TEST_F(DBSecondaryCacheTest, LRUCacheDumpLoadWithFilter) {
   LRUCacheOptions cache_opts(1024 * 1024, 0, false, 0.5, nullptr,
                              kDefaultToAdaptiveMutex, kDontChargeCacheMetadata);
@@ -1869,6 +2101,86 @@ TEST_F(DBSecondaryCacheTest, LRUCacheDumpLoadWithFilter) {
   ASSERT_OK(DestroyDB(dbname2, options));
 }
 
+TEST_F(DBSecondaryCacheTest, CacheWarmthShipping) {
+  LRUCacheOptions cache_opts(1024 * 1024, 0, false, 0.5, nullptr,
+                             kDefaultToAdaptiveMutex, kDontChargeCacheMetadata);
+  std::shared_ptr<Cache> cache = NewLRUCache(cache_opts);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = cache;
+  table_options.block_size = 4 * 1024;
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.env = fault_env_.get();
+  DestroyAndReopen(options);
+  fault_fs_->SetFailGetUniqueId(true);
+
+  Random rnd(301);
+  const int N = 256;
+  std::vector<std::string> value;
+  char buf[1000];
+  memset(buf, 'a', 1000);
+  value.resize(N);
+  for (int i = 0; i < N; i++) {
+    std::string p_v(buf, 1000);
+    value[i] = p_v;
+    ASSERT_OK(Put(Key(i), p_v));
+  }
+  ASSERT_OK(Flush());
+  Compact("a", "z");
+
+  // Read all the key value pairs so the blocks are in the block cache and
+  // there is warmth to ship.
+  std::string v;
+  for (int i = 0; i < N; i++) {
+    v = Get(Key(i));
+    ASSERT_EQ(v, value[i]);
+  }
+
+  CacheWarmthShippingOptions warmth_options;
+  warmth_options.env = fault_env_.get();
+  warmth_options.warmth_file = db_->GetName() + "/cache_warmth";
+  // Long enough that the test only observes the immediate first run.
+  warmth_options.shipping_interval_seconds = 1000;
+
+  // Misconfiguration is rejected up front.
+  std::unique_ptr<CacheWarmthExporter> exporter;
+  CacheWarmthShippingOptions bad_options = warmth_options;
+  bad_options.warmth_file = "";
+  ASSERT_NOK(NewCacheWarmthExporter(bad_options, db_, cache, &exporter));
+  ASSERT_NOK(NewCacheWarmthExporter(warmth_options, nullptr, cache, &exporter));
+
+  ASSERT_OK(NewCacheWarmthExporter(warmth_options, db_, cache, &exporter));
+  ASSERT_OK(exporter->Start());
+  // The first export is taken immediately; wait for it to be published.
+  while (!fault_env_->FileExists(warmth_options.warmth_file).ok()) {
+    fault_env_->SleepForMicroseconds(10 * 1000);
+  }
+  ASSERT_OK(exporter->Stop());
+  ASSERT_OK(exporter->LastStatus());
+
+  // A secondary imports the shipped warmth into its secondary cache.
+  std::shared_ptr<TestSecondaryCache> secondary_cache =
+      std::make_shared<TestSecondaryCache>(2048 * 1024);
+  std::unique_ptr<CacheWarmthImporter> importer;
+  ASSERT_NOK(NewCacheWarmthImporter(warmth_options, table_options, nullptr,
+                                    &importer));
+  ASSERT_OK(NewCacheWarmthImporter(warmth_options, table_options,
+                                   secondary_cache, &importer));
+  ASSERT_OK(importer->Start());
+  // The first poll is taken immediately; wait for the load to finish.
+  while (secondary_cache->num_inserts() == 0) {
+    fault_env_->SleepForMicroseconds(10 * 1000);
+  }
+  ASSERT_OK(importer->Stop());
+  ASSERT_OK(importer->LastStatus());
+  // All the data blocks of the dump should have been inserted.
+  ASSERT_EQ(64, static_cast<int>(secondary_cache->num_inserts()));
+
+  fault_fs_->SetFailGetUniqueId(false);
+  Destroy(options);
+}
+
 // Test the option not to use the secondary cache in a certain DB.
 TEST_F(DBSecondaryCacheTest, TestSecondaryCacheOptionBasic) {
   LRUCacheOptions opts(4 * 1024, 0, false, 0.5, nullptr,
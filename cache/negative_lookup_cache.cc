@@ -0,0 +1,110 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/negative_lookup_cache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "util/coding.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+const size_t kNumShards = 64;
+// Rough accounting for the unordered_map node, the std::string header and
+// allocator overhead, on top of the key bytes themselves.
+const size_t kEntryOverhead = 64;
+
+std::string MakeCacheKey(uint32_t column_family_id, const Slice& user_key) {
+  std::string cache_key;
+  cache_key.reserve(sizeof(uint32_t) + user_key.size());
+  PutFixed32(&cache_key, column_family_id);
+  cache_key.append(user_key.data(), user_key.size());
+  return cache_key;
+}
+
+}  // namespace
+
+struct NegativeLookupCache::Shard {
+  mutable std::mutex mu;
+  // Maps cache key to the superversion number the miss was observed under.
+  std::unordered_map<std::string, uint64_t> entries;
+  size_t charge = 0;
+};
+
+NegativeLookupCache::NegativeLookupCache(size_t capacity_bytes)
+    : shards_(new Shard[kNumShards]),
+      per_shard_capacity_(
+          std::max(capacity_bytes / kNumShards, size_t{1} << 10)) {}
+
+NegativeLookupCache::~NegativeLookupCache() {}
+
+NegativeLookupCache::Shard& NegativeLookupCache::GetShard(
+    const Slice& cache_key) const {
+  return shards_[GetSliceNPHash64(cache_key) & (kNumShards - 1)];
+}
+
+bool NegativeLookupCache::KnownNotFound(uint32_t column_family_id,
+                                        const Slice& user_key,
+                                        uint64_t version_number) const {
+  std::string cache_key = MakeCacheKey(column_family_id, user_key);
+  Shard& shard = GetShard(cache_key);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto it = shard.entries.find(cache_key);
+  if (it == shard.entries.end()) {
+    return false;
+  }
+  if (it->second != version_number) {
+    // Recorded under a different superversion; the table files may have
+    // changed since, so the entry is useless. Reclaim it eagerly.
+    shard.charge -= std::min(shard.charge, it->first.size() + kEntryOverhead);
+    shard.entries.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void NegativeLookupCache::Insert(uint32_t column_family_id,
+                                 const Slice& user_key,
+                                 uint64_t version_number) {
+  std::string cache_key = MakeCacheKey(column_family_id, user_key);
+  Shard& shard = GetShard(cache_key);
+  size_t entry_charge = cache_key.size() + kEntryOverhead;
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto res = shard.entries.emplace(std::move(cache_key), version_number);
+  if (res.second) {
+    shard.charge += entry_charge;
+  } else {
+    res.first->second = version_number;
+  }
+  // Evict in (arbitrary) hash order until under budget. The entries are all
+  // equally cheap to recreate, so no LRU bookkeeping is warranted.
+  while (shard.charge > per_shard_capacity_ && !shard.entries.empty()) {
+    auto victim = shard.entries.begin();
+    shard.charge -=
+        std::min(shard.charge, victim->first.size() + kEntryOverhead);
+    shard.entries.erase(victim);
+  }
+}
+
+void NegativeLookupCache::Clear() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    std::lock_guard<std::mutex> lock(shards_[i].mu);
+    shards_[i].entries.clear();
+    shards_[i].charge = 0;
+  }
+}
+
+std::shared_ptr<NegativeLookupCache> NewNegativeLookupCache(
+    size_t capacity_bytes) {
+  return std::make_shared<NegativeLookupCache>(capacity_bytes);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,116 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/row_lookup_cache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+#include "util/coding.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+const size_t kNumShards = 64;
+// Rough accounting for the unordered_map node, the std::string headers and
+// allocator overhead, on top of the key and value bytes themselves.
+const size_t kEntryOverhead = 96;
+
+std::string MakeCacheKey(uint32_t column_family_id, const Slice& user_key) {
+  std::string cache_key;
+  cache_key.reserve(sizeof(uint32_t) + user_key.size());
+  PutFixed32(&cache_key, column_family_id);
+  cache_key.append(user_key.data(), user_key.size());
+  return cache_key;
+}
+
+}  // namespace
+
+struct RowLookupCache::Shard {
+  struct Entry {
+    uint64_t epoch = 0;
+    std::string value;
+  };
+  static size_t EntryCharge(const std::string& cache_key, const Entry& entry) {
+    return cache_key.size() + entry.value.size() + kEntryOverhead;
+  }
+  mutable std::mutex mu;
+  std::unordered_map<std::string, Entry> entries;
+  size_t charge = 0;
+};
+
+RowLookupCache::RowLookupCache(size_t capacity_bytes)
+    : shards_(new Shard[kNumShards]),
+      per_shard_capacity_(
+          std::max(capacity_bytes / kNumShards, size_t{1} << 10)) {}
+
+RowLookupCache::~RowLookupCache() {}
+
+RowLookupCache::Shard& RowLookupCache::GetShard(const Slice& cache_key) const {
+  return shards_[GetSliceNPHash64(cache_key) & (kNumShards - 1)];
+}
+
+bool RowLookupCache::Lookup(uint32_t column_family_id, const Slice& user_key,
+                            uint64_t epoch, std::string* value) const {
+  std::string cache_key = MakeCacheKey(column_family_id, user_key);
+  Shard& shard = GetShard(cache_key);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto it = shard.entries.find(cache_key);
+  if (it == shard.entries.end()) {
+    return false;
+  }
+  if (it->second.epoch != epoch) {
+    // Recorded under a different new data epoch; the file set has gained
+    // data since (or the entry raced with an install), so the cached value
+    // may be out of date. Reclaim it eagerly.
+    shard.charge -=
+        std::min(shard.charge, Shard::EntryCharge(it->first, it->second));
+    shard.entries.erase(it);
+    return false;
+  }
+  value->assign(it->second.value);
+  return true;
+}
+
+void RowLookupCache::Insert(uint32_t column_family_id, const Slice& user_key,
+                            uint64_t epoch, const Slice& value) {
+  std::string cache_key = MakeCacheKey(column_family_id, user_key);
+  Shard& shard = GetShard(cache_key);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto res = shard.entries.emplace(std::move(cache_key), Shard::Entry());
+  Shard::Entry& entry = res.first->second;
+  if (!res.second) {
+    shard.charge -=
+        std::min(shard.charge, Shard::EntryCharge(res.first->first, entry));
+  }
+  entry.epoch = epoch;
+  entry.value.assign(value.data(), value.size());
+  shard.charge += Shard::EntryCharge(res.first->first, entry);
+  // Evict in (arbitrary) hash order until under budget. The entries are all
+  // equally cheap to recreate, so no LRU bookkeeping is warranted.
+  while (shard.charge > per_shard_capacity_ && !shard.entries.empty()) {
+    auto victim = shard.entries.begin();
+    shard.charge -= std::min(
+        shard.charge, Shard::EntryCharge(victim->first, victim->second));
+    shard.entries.erase(victim);
+  }
+}
+
+void RowLookupCache::Clear() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    std::lock_guard<std::mutex> lock(shards_[i].mu);
+    shards_[i].entries.clear();
+    shards_[i].charge = 0;
+  }
+}
+
+std::shared_ptr<RowLookupCache> NewRowLookupCache(size_t capacity_bytes) {
+  return std::make_shared<RowLookupCache>(capacity_bytes);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -12,6 +12,11 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+#ifdef NUMA
+#include <numa.h>
+#endif
 
 #include "util/hash.h"
 #include "util/math.h"
@@ -25,16 +30,145 @@ inline uint32_t HashSlice(const Slice& s) {
   return Lower32of64(GetSliceNPHash64(s));
 }
 
+// TinyLFU admission: estimate how often a key hash has been accessed
+// recently using a count-min sketch of saturating counters, and admit a new
+// entry only if it is at least as hot as the eviction candidate it would
+// displace. Once the number of recorded accesses reaches a multiple of the
+// sketch size, all counters are halved, so the estimates decay toward the
+// recent access distribution.
+class TinyLFUAdmissionPolicy : public CacheAdmissionPolicy {
+ public:
+  explicit TinyLFUAdmissionPolicy(size_t num_counters)
+      : mask_(static_cast<uint32_t>(num_counters - 1)),
+        counters_(num_counters),
+        accesses_(0) {
+    assert(num_counters > 0 && (num_counters & (num_counters - 1)) == 0);
+  }
+
+  void RecordAccess(uint32_t hash) override {
+    for (uint32_t i = 0; i < kNumProbes; i++) {
+      std::atomic<uint8_t>& counter = counters_[Slot(hash, i)];
+      uint8_t c = counter.load(std::memory_order_relaxed);
+      if (c < kMaxFrequency) {
+        // A racing increment may be lost, which only makes the estimate
+        // more conservative.
+        counter.store(static_cast<uint8_t>(c + 1), std::memory_order_relaxed);
+      }
+    }
+    if (accesses_.fetch_add(1, std::memory_order_relaxed) + 1 >= SampleSize()) {
+      Age();
+    }
+  }
+
+  bool Admit(uint32_t insert_hash, uint32_t victim_hash) override {
+    return EstimateFrequency(insert_hash) >= EstimateFrequency(victim_hash);
+  }
+
+  bool Admit(uint32_t insert_hash) override {
+    // Without a known victim, admit only keys seen more than once recently.
+    // The access that triggered this insert has already been recorded.
+    return EstimateFrequency(insert_hash) > 1;
+  }
+
+ private:
+  static constexpr uint32_t kNumProbes = 4;
+  static constexpr uint8_t kMaxFrequency = 15;
+  static constexpr size_t kSamplesPerCounter = 8;
+
+  size_t SampleSize() const { return kSamplesPerCounter * (mask_ + 1); }
+
+  size_t Slot(uint32_t hash, uint32_t i) const {
+    // Derive kNumProbes roughly independent slots from one 32-bit hash.
+    return static_cast<size_t>(
+               ((uint64_t{hash} + i) * uint64_t{0x9e3779b97f4a7c13}) >> 32) &
+           mask_;
+  }
+
+  uint8_t EstimateFrequency(uint32_t hash) const {
+    uint8_t freq = kMaxFrequency;
+    for (uint32_t i = 0; i < kNumProbes; i++) {
+      freq = std::min(
+          freq, counters_[Slot(hash, i)].load(std::memory_order_relaxed));
+    }
+    return freq;
+  }
+
+  void Age() {
+    // Elect a single aging thread by resetting the access count; updates
+    // racing with the sweep are tolerable noise.
+    size_t expected = accesses_.load(std::memory_order_relaxed);
+    if (expected < SampleSize() ||
+        !accesses_.compare_exchange_strong(expected, 0,
+                                           std::memory_order_relaxed)) {
+      return;
+    }
+    for (std::atomic<uint8_t>& counter : counters_) {
+      counter.store(
+          static_cast<uint8_t>(counter.load(std::memory_order_relaxed) / 2),
+          std::memory_order_relaxed);
+    }
+  }
+
+  const uint32_t mask_;
+  std::vector<std::atomic<uint8_t>> counters_;
+  std::atomic<size_t> accesses_;
+};
+
 }  // namespace
 
+std::shared_ptr<CacheAdmissionPolicy> NewTinyLFUAdmissionPolicy(
+    size_t num_counters) {
+  size_t n = 1;
+  while (n < num_counters) {
+    n <<= 1;
+  }
+  return std::make_shared<TinyLFUAdmissionPolicy>(n);
+}
+
 ShardedCache::ShardedCache(size_t capacity, int num_shard_bits,
                            bool strict_capacity_limit,
-                           std::shared_ptr<MemoryAllocator> allocator)
+                           std::shared_ptr<MemoryAllocator> allocator,
+                           bool numa_aware)
     : Cache(std::move(allocator)),
       shard_mask_((uint32_t{1} << num_shard_bits) - 1),
       capacity_(capacity),
       strict_capacity_limit_(strict_capacity_limit),
-      last_id_(1) {}
+      last_id_(1) {
+  uint32_t num_nodes = 1;
+#ifdef NUMA
+  if (numa_aware && numa_available() >= 0) {
+    // Use a power-of-two number of node groups, and never more groups than
+    // shards, so each group gets the same number of whole shards.
+    uint32_t configured =
+        static_cast<uint32_t>(std::max(1, numa_num_configured_nodes()));
+    uint32_t num_shards = shard_mask_ + 1;
+    while (num_nodes * 2 <= configured && num_nodes * 2 <= num_shards) {
+      num_nodes *= 2;
+    }
+  }
+#else
+  (void)numa_aware;
+#endif
+  num_numa_nodes_ = num_nodes;
+  numa_group_mask_ = (shard_mask_ + 1) / num_nodes - 1;
+}
+
+uint32_t ShardedCache::LocalNumaNode() const {
+#ifdef NUMA
+  if (num_numa_nodes_ > 1) {
+    int cpu = port::PhysicalCoreID();
+    if (cpu >= 0) {
+      int node = numa_node_of_cpu(cpu);
+      if (node >= 0) {
+        // Folding with a mask keeps nodes >= num_numa_nodes_ (possible when
+        // the node count is not a power of two) spread over the groups.
+        return static_cast<uint32_t>(node) & (num_numa_nodes_ - 1);
+      }
+    }
+  }
+#endif
+  return 0;
+}
 
 void ShardedCache::SetCapacity(size_t capacity) {
   uint32_t num_shards = GetNumShards();
@@ -55,11 +189,23 @@ void ShardedCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
   strict_capacity_limit_ = strict_capacity_limit;
 }
 
+void ShardedCache::SetAdmissionPolicy(
+    std::shared_ptr<CacheAdmissionPolicy> policy) {
+  uint32_t num_shards = GetNumShards();
+  for (uint32_t s = 0; s < num_shards; s++) {
+    GetShard(s)->set_admission_policy(policy.get());
+  }
+  admission_policy_ = std::move(policy);
+}
+
 Status ShardedCache::Insert(const Slice& key, void* value, size_t charge,
                             DeleterFn deleter, Handle** handle,
                             Priority priority) {
   uint32_t hash = HashSlice(key);
-  return GetShard(Shard(hash))
+  if (admission_policy_) {
+    admission_policy_->RecordAccess(hash);
+  }
+  return GetShard(NumaShard(LocalNumaNode(), hash))
       ->Insert(key, hash, value, charge, deleter, handle, priority);
 }
 
@@ -70,13 +216,27 @@ Status ShardedCache::Insert(const Slice& key, void* value,
   if (!helper) {
     return Status::InvalidArgument();
   }
-  return GetShard(Shard(hash))
+  if (admission_policy_) {
+    admission_policy_->RecordAccess(hash);
+  }
+  return GetShard(NumaShard(LocalNumaNode(), hash))
       ->Insert(key, hash, value, helper, charge, handle, priority);
 }
 
 Cache::Handle* ShardedCache::Lookup(const Slice& key, Statistics* /*stats*/) {
   uint32_t hash = HashSlice(key);
-  return GetShard(Shard(hash))->Lookup(key, hash);
+  if (admission_policy_) {
+    admission_policy_->RecordAccess(hash);
+  }
+  uint32_t node = LocalNumaNode();
+  Handle* handle = GetShard(NumaShard(node, hash))->Lookup(key, hash);
+  // With NUMA routing, the entry may have been inserted from a thread on
+  // another node; fall back to the other node groups' shards.
+  for (uint32_t i = 1; handle == nullptr && i < num_numa_nodes_; i++) {
+    handle = GetShard(NumaShard((node + i) & (num_numa_nodes_ - 1), hash))
+                 ->Lookup(key, hash);
+  }
+  return handle;
 }
 
 Cache::Handle* ShardedCache::Lookup(const Slice& key,
@@ -85,39 +245,56 @@ Cache::Handle* ShardedCache::Lookup(const Slice& key,
                                     Priority priority, bool wait,
                                     Statistics* stats) {
   uint32_t hash = HashSlice(key);
-  return GetShard(Shard(hash))
+  if (admission_policy_) {
+    admission_policy_->RecordAccess(hash);
+  }
+  uint32_t node = LocalNumaNode();
+  if (num_numa_nodes_ > 1) {
+    // Check for a resident copy in every node group (local first) before
+    // letting the local shard go to the secondary cache, which is far more
+    // expensive than probing a few remote shards.
+    for (uint32_t i = 0; i < num_numa_nodes_; i++) {
+      Handle* handle =
+          GetShard(NumaShard((node + i) & (num_numa_nodes_ - 1), hash))
+              ->Lookup(key, hash);
+      if (handle != nullptr) {
+        return handle;
+      }
+    }
+  }
+  return GetShard(NumaShard(node, hash))
       ->Lookup(key, hash, helper, create_cb, priority, wait, stats);
 }
 
 bool ShardedCache::IsReady(Handle* handle) {
-  uint32_t hash = GetHash(handle);
-  return GetShard(Shard(hash))->IsReady(handle);
+  return GetShard(ShardOfHandle(handle))->IsReady(handle);
 }
 
 void ShardedCache::Wait(Handle* handle) {
-  uint32_t hash = GetHash(handle);
-  GetShard(Shard(hash))->Wait(handle);
+  GetShard(ShardOfHandle(handle))->Wait(handle);
 }
 
 bool ShardedCache::Ref(Handle* handle) {
-  uint32_t hash = GetHash(handle);
-  return GetShard(Shard(hash))->Ref(handle);
+  return GetShard(ShardOfHandle(handle))->Ref(handle);
 }
 
 bool ShardedCache::Release(Handle* handle, bool erase_if_last_ref) {
-  uint32_t hash = GetHash(handle);
-  return GetShard(Shard(hash))->Release(handle, erase_if_last_ref);
+  return GetShard(ShardOfHandle(handle))->Release(handle, erase_if_last_ref);
 }
 
 bool ShardedCache::Release(Handle* handle, bool useful,
                            bool erase_if_last_ref) {
-  uint32_t hash = GetHash(handle);
-  return GetShard(Shard(hash))->Release(handle, useful, erase_if_last_ref);
+  return GetShard(ShardOfHandle(handle))
+      ->Release(handle, useful, erase_if_last_ref);
 }
 
 void ShardedCache::Erase(const Slice& key) {
   uint32_t hash = HashSlice(key);
-  GetShard(Shard(hash))->Erase(key, hash);
+  // With NUMA routing a key may be resident in any (or several) of the node
+  // groups' shards; erase it from all of them.
+  for (uint32_t node = 0; node < num_numa_nodes_; node++) {
+    GetShard(NumaShard(node, hash))->Erase(key, hash);
+  }
 }
 
 uint64_t ShardedCache::NewId() {
@@ -206,6 +383,9 @@ std::string ShardedCache::GetPrintableOptions() const {
     snprintf(buffer, kBufferSize, "    strict_capacity_limit : %d\n",
              strict_capacity_limit_);
     ret.append(buffer);
+    snprintf(buffer, kBufferSize, "    numa_node_groups : %u\n",
+             num_numa_nodes_);
+    ret.append(buffer);
   }
   snprintf(buffer, kBufferSize, "    memory_allocator : %s\n",
            memory_allocator() ? memory_allocator()->Name() : "None");
@@ -17,6 +17,41 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// Pluggable admission policy for sharded caches. When set, shards consult
+// the policy before evicting resident entries to make room for a new one,
+// so that a burst of one-time accesses (e.g. a table scan) cannot displace
+// a hot working set of index, filter and data blocks.
+//
+// Implementations must be thread-safe: all methods may be called
+// concurrently from multiple shards without external synchronization.
+class CacheAdmissionPolicy {
+ public:
+  virtual ~CacheAdmissionPolicy() = default;
+
+  // Called with the hash of the key on every cache access (lookups and
+  // inserts), to maintain whatever recent-access state the policy needs.
+  virtual void RecordAccess(uint32_t hash) = 0;
+
+  // Whether a new entry with hash `insert_hash` should be admitted at the
+  // cost of evicting the candidate with hash `victim_hash`.
+  virtual bool Admit(uint32_t insert_hash, uint32_t victim_hash) = 0;
+
+  // Whether a new entry with hash `insert_hash` should be admitted when the
+  // cache is full but no single eviction candidate is known up front (e.g.
+  // clock eviction, where the victim depends on the sweep).
+  virtual bool Admit(uint32_t insert_hash) = 0;
+};
+
+// Creates a TinyLFU-style admission policy: a count-min sketch of saturating
+// counters over the hashes of recently accessed keys, periodically halved so
+// the estimates track the recent access distribution rather than all of
+// history. A new entry is admitted only if its estimated access frequency is
+// at least that of the eviction candidate it would displace. `num_counters`
+// is rounded up to a power of two; for accurate estimates it should be in
+// the ballpark of the number of entries the cache can hold.
+extern std::shared_ptr<CacheAdmissionPolicy> NewTinyLFUAdmissionPolicy(
+    size_t num_counters);
+
 // Single cache shard interface.
 class CacheShard {
  public:
@@ -61,18 +96,31 @@ class CacheShard {
       CacheMetadataChargePolicy metadata_charge_policy) {
     metadata_charge_policy_ = metadata_charge_policy;
   }
+  void set_admission_policy(CacheAdmissionPolicy* admission_policy) {
+    admission_policy_ = admission_policy;
+  }
 
  protected:
   CacheMetadataChargePolicy metadata_charge_policy_ = kDontChargeCacheMetadata;
+  CacheAdmissionPolicy* admission_policy_ = nullptr;
 };
 
 // Generic cache interface which shards cache by hash of keys. 2^num_shard_bits
 // shards will be created, with capacity split evenly to each of the shards.
 // Keys are sharded by the highest num_shard_bits bits of hash value.
+//
+// With `numa_aware` set (and RocksDB built with NUMA support), the shards
+// are instead partitioned into one group per NUMA node: inserts pick a shard
+// in the inserting thread's node group, so entries land in DRAM local to the
+// threads that access them, and lookups probe the local group first and fall
+// back to the other groups, so entries inserted from any node stay visible
+// everywhere. The same key may transiently be resident in several groups;
+// Erase removes it from all of them.
 class ShardedCache : public Cache {
  public:
   ShardedCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit,
-               std::shared_ptr<MemoryAllocator> memory_allocator = nullptr);
+               std::shared_ptr<MemoryAllocator> memory_allocator = nullptr,
+               bool numa_aware = false);
   virtual ~ShardedCache() = default;
   virtual CacheShard* GetShard(uint32_t shard) = 0;
   virtual const CacheShard* GetShard(uint32_t shard) const = 0;
@@ -116,15 +164,46 @@ class ShardedCache : public Cache {
   int GetNumShardBits() const;
   uint32_t GetNumShards() const;
 
+  // Sets the admission policy consulted by all shards before they evict to
+  // make room for a new entry, and fed with the hash of every access. May
+  // not be called concurrently with other operations on the cache.
+  void SetAdmissionPolicy(std::shared_ptr<CacheAdmissionPolicy> policy);
+
  protected:
-  inline uint32_t Shard(uint32_t hash) { return hash & shard_mask_; }
+  inline uint32_t Shard(uint32_t hash) const { return hash & shard_mask_; }
+
+  // The shard for `hash` in the given NUMA node's group. With a single node
+  // group this is equivalent to Shard(hash).
+  inline uint32_t NumaShard(uint32_t node, uint32_t hash) const {
+    return node * (numa_group_mask_ + 1) + (hash & numa_group_mask_);
+  }
+  // The NUMA node group of the calling thread, or 0 when NUMA routing is
+  // disabled or unavailable.
+  uint32_t LocalNumaNode() const;
+  uint32_t GetNumNumaNodes() const { return num_numa_nodes_; }
+  uint32_t GetNumaNodeOfShard(uint32_t shard) const {
+    return shard / (numa_group_mask_ + 1);
+  }
+
+  // The shard holding `handle`. Subclasses that record the insertion-time
+  // NUMA node in their handles must override this so that handle operations
+  // reach the owning shard when NUMA routing is in effect.
+  virtual uint32_t ShardOfHandle(Handle* handle) const {
+    return Shard(GetHash(handle));
+  }
 
  private:
   const uint32_t shard_mask_;
+  // Number of NUMA node groups the shards are partitioned into (a power of
+  // two; 1 when NUMA routing is disabled) and the mask selecting a shard
+  // within one group.
+  uint32_t num_numa_nodes_;
+  uint32_t numa_group_mask_;
   mutable port::Mutex capacity_mutex_;
   size_t capacity_;
   bool strict_capacity_limit_;
   std::atomic<uint64_t> last_id_;
+  std::shared_ptr<CacheAdmissionPolicy> admission_policy_;
 };
 
 extern int GetDefaultCacheShardBits(size_t capacity);
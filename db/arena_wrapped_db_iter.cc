@@ -14,6 +14,7 @@
 #include "rocksdb/options.h"
 #include "table/internal_iterator.h"
 #include "table/iterator_wrapper.h"
+#include "table/merging_iterator.h"
 #include "util/user_comparator_wrapper.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -43,10 +44,20 @@ void ArenaWrappedDBIter::Init(
                        sequence, true, max_sequential_skip_in_iteration,
                        read_callback, db_impl, cfd, expose_blob_index);
   sv_number_ = version_number;
+  version_ = version;
+  merging_internal_iter_ = nullptr;
+  mutable_mem_ = nullptr;
   read_options_ = read_options;
   allow_refresh_ = allow_refresh;
 }
 
+namespace {
+void CleanupSuperVersionHandle(void* arg1, void* arg2) {
+  static_cast<DBImpl*>(arg1)->CleanupSuperVersion(
+      static_cast<SuperVersion*>(arg2));
+}
+}  // namespace
+
 Status ArenaWrappedDBIter::Refresh() {
   if (cfd_ == nullptr || db_impl_ == nullptr || !allow_refresh_) {
     return Status::NotSupported("Creating renew iterator is not allowed.");
@@ -60,16 +71,63 @@ Status ArenaWrappedDBIter::Refresh() {
   TEST_SYNC_POINT("ArenaWrappedDBIter::Refresh:2");
   while (true) {
     if (sv_number_ != cur_sv_number) {
-      Env* env = db_iter_->env();
-      db_iter_->~DBIter();
-      arena_.~Arena();
-      new (&arena_) Arena();
-
       SuperVersion* sv = cfd_->GetReferencedSuperVersion(db_impl_);
       SequenceNumber latest_seq = db_impl_->GetLatestSequenceNumber();
       if (read_callback_) {
         read_callback_->Refresh(latest_seq);
       }
+      if (sv->current == version_ && merging_internal_iter_ != nullptr &&
+          mutable_mem_ != nullptr) {
+        // Only the memtables changed (e.g. memtable switches or a mutable
+        // options change): every table iterator in the existing tree is
+        // still valid, together with its cached index/data block handles.
+        // Keep the tree and only merge in iterators for the memtables it
+        // does not contain yet instead of rebuilding the whole stack.
+        //
+        // The tree holds mutable_mem_ and everything older. Since the
+        // Version is unchanged, no flush has retired a memtable, so every
+        // newer memtable is still in sv->imm (next to the new sv->mem).
+        // When sv->mem is unchanged (e.g. the super version bump came from
+        // SetOptions()), there is nothing to add; adding an iterator for a
+        // memtable already in the tree would surface every entry twice.
+        autovector<MemTable*> new_mems;
+        if (sv->mem != mutable_mem_) {
+          new_mems.push_back(sv->mem);
+          sv->imm->GetMemTablesNewerThan(mutable_mem_, &new_mems);
+        }
+        for (MemTable* m : new_mems) {
+          AddToMergingIterator(merging_internal_iter_,
+                               m->NewIterator(read_options_, &arena_));
+        }
+        if (!read_options_.ignore_range_deletions) {
+          // Also refresh the tombstones of the previously mutable memtable:
+          // range deletions written to it after the tree was built are not
+          // in the aggregator, whose fragmented iterator for that memtable
+          // was cut at the old read sequence.
+          new_mems.push_back(mutable_mem_);
+          for (MemTable* m : new_mems) {
+            std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
+                m->NewRangeTombstoneIterator(read_options_, latest_seq));
+            db_iter_->GetRangeDelAggregator()->AddTombstones(
+                std::move(range_del_iter));
+          }
+        }
+        mutable_mem_ = sv->mem;
+        // Keep the new super version referenced for as long as the iterator
+        // tree lives. Cleanups registered on an iterator chain, so the
+        // reference taken when the tree was built is still released as well.
+        merging_internal_iter_->RegisterCleanup(CleanupSuperVersionHandle,
+                                                db_impl_, sv);
+        sv_number_ = cur_sv_number;
+        db_iter_->set_sequence(latest_seq);
+        db_iter_->set_valid(false);
+        break;
+      }
+      Env* env = db_iter_->env();
+      db_iter_->~DBIter();
+      arena_.~Arena();
+      new (&arena_) Arena();
+
       Init(env, read_options_, *(cfd_->ioptions()), sv->mutable_cf_options,
            sv->current, latest_seq,
            sv->mutable_cf_options.max_sequential_skip_in_iterations,
@@ -78,8 +136,10 @@ Status ArenaWrappedDBIter::Refresh() {
 
       InternalIterator* internal_iter = db_impl_->NewInternalIterator(
           read_options_, cfd_, sv, &arena_, db_iter_->GetRangeDelAggregator(),
-          latest_seq, /* allow_unprepared_value */ true);
+          latest_seq, /* allow_unprepared_value */ true,
+          &merging_internal_iter_);
       SetIterUnderDBIter(internal_iter);
+      mutable_mem_ = sv->mem;
       break;
     } else {
       SequenceNumber latest_seq = db_impl_->GetLatestSequenceNumber();
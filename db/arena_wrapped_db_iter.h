@@ -55,6 +55,18 @@ class ArenaWrappedDBIter : public Iterator {
     db_iter_->SetIter(iter);
   }
 
+  // Remember the merging iterator underlying the internal iterator, as
+  // reported by DBImpl::NewInternalIterator() (nullptr if there is none),
+  // together with the memtable that was mutable when the tree was built,
+  // so that Refresh() can append iterators for the memtables the tree does
+  // not contain yet instead of rebuilding the whole iterator stack when
+  // the current Version is unchanged.
+  void SetMergingIterator(InternalIterator* merging_iter,
+                          MemTable* mutable_mem) {
+    merging_internal_iter_ = merging_iter;
+    mutable_mem_ = mutable_mem;
+  }
+
   bool Valid() const override { return db_iter_->Valid(); }
   void SeekToFirst() override { db_iter_->SeekToFirst(); }
   void SeekToLast() override { db_iter_->SeekToLast(); }
@@ -98,6 +110,15 @@ class ArenaWrappedDBIter : public Iterator {
   DBIter* db_iter_ = nullptr;
   Arena arena_;
   uint64_t sv_number_;
+  // The Version the iterator tree was built from, and the merging iterator
+  // inside that tree. They let Refresh() tell whether the table iterators
+  // in the existing tree are still valid.
+  const Version* version_ = nullptr;
+  InternalIterator* merging_internal_iter_ = nullptr;
+  // The memtable that was mutable when the tree was built (or last
+  // refreshed). The tree contains iterators for it and for every older
+  // memtable, so anything newer in a refreshed super version is missing.
+  MemTable* mutable_mem_ = nullptr;
   ColumnFamilyData* cfd_ = nullptr;
   DBImpl* db_impl_ = nullptr;
   ReadOptions read_options_;
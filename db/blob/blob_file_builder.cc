@@ -65,6 +65,10 @@ BlobFileBuilder::BlobFileBuilder(
       min_blob_size_(mutable_cf_options->min_blob_size),
       blob_file_size_(mutable_cf_options->blob_file_size),
       blob_compression_type_(mutable_cf_options->blob_compression_type),
+      blob_compression_max_dict_bytes_(
+          mutable_cf_options->blob_compression_max_dict_bytes),
+      blob_compression_zstd_max_train_bytes_(
+          mutable_cf_options->blob_compression_zstd_max_train_bytes),
       prepopulate_blob_cache_(mutable_cf_options->prepopulate_blob_cache),
       file_options_(file_options),
       db_id_(std::move(db_id)),
@@ -80,7 +84,12 @@ BlobFileBuilder::BlobFileBuilder(
       blob_file_paths_(blob_file_paths),
       blob_file_additions_(blob_file_additions),
       blob_count_(0),
-      blob_bytes_(0) {
+      blob_bytes_(0),
+      blob_compression_dict_enabled_(
+          blob_compression_max_dict_bytes_ > 0 &&
+          DictCompressionTypeSupported(blob_compression_type_)),
+      compression_dict_done_(false),
+      compression_dict_offset_(0) {
   assert(file_number_generator_);
   assert(fs_);
   assert(immutable_options_);
@@ -109,6 +118,13 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
     }
   }
 
+  {
+    const Status s = TrainCompressionDictIfNeeded(value);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
   Slice blob = value;
   std::string compressed_blob;
 
@@ -228,6 +244,11 @@ Status BlobFileBuilder::OpenBlobFileIfNeeded() {
   BlobLogHeader header(column_family_id_, blob_compression_type_, has_ttl,
                        expiration_range);
 
+  if (blob_compression_dict_enabled_) {
+    header.version = kVersion2;
+    header.has_compression_dictionary = true;
+  }
+
   {
     Status s = blob_log_writer->WriteHeader(header);
 
@@ -246,6 +267,66 @@ Status BlobFileBuilder::OpenBlobFileIfNeeded() {
   return Status::OK();
 }
 
+Status BlobFileBuilder::TrainCompressionDictIfNeeded(const Slice& value) {
+  if (!blob_compression_dict_enabled_ || compression_dict_done_) {
+    return Status::OK();
+  }
+
+  assert(IsBlobFileOpen());
+  assert(!compression_dict_);
+
+  compression_dict_samples_.append(value.data(), value.size());
+  compression_dict_sample_lens_.push_back(value.size());
+
+  const bool use_zstd_trainer = blob_compression_zstd_max_train_bytes_ > 0 &&
+                                ZSTD_TrainDictionarySupported();
+  const uint64_t sample_budget = use_zstd_trainer
+                                     ? blob_compression_zstd_max_train_bytes_
+                                     : blob_compression_max_dict_bytes_;
+  if (compression_dict_samples_.size() < sample_budget) {
+    return Status::OK();
+  }
+
+  compression_dict_done_ = true;
+
+  std::string dict;
+  if (use_zstd_trainer) {
+    dict = ZSTD_TrainDictionary(compression_dict_samples_,
+                                compression_dict_sample_lens_,
+                                blob_compression_max_dict_bytes_);
+  } else {
+    dict =
+        compression_dict_samples_.substr(0, blob_compression_max_dict_bytes_);
+  }
+
+  compression_dict_samples_.clear();
+  compression_dict_sample_lens_.clear();
+
+  if (dict.empty()) {
+    // Training can fail, for example when the samples are too uniform; in
+    // that case, the rest of the file is simply written without a dictionary.
+    return Status::OK();
+  }
+
+  {
+    Status s =
+        writer_->AddCompressionDictRecord(dict, &compression_dict_offset_);
+
+    TEST_SYNC_POINT_CALLBACK(
+        "BlobFileBuilder::TrainCompressionDictIfNeeded:AddRecord", &s);
+
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  CompressionOptions opts;
+  compression_dict_.reset(
+      new CompressionDict(std::move(dict), blob_compression_type_, opts.level));
+
+  return Status::OK();
+}
+
 Status BlobFileBuilder::CompressBlobIfNeeded(
     Slice* blob, std::string* compressed_blob) const {
   assert(blob);
@@ -261,7 +342,9 @@ Status BlobFileBuilder::CompressBlobIfNeeded(
   CompressionContext context(blob_compression_type_);
   constexpr uint64_t sample_for_compression = 0;
 
-  CompressionInfo info(opts, context, CompressionDict::GetEmptyDict(),
+  CompressionInfo info(opts, context,
+                       compression_dict_ ? *compression_dict_
+                                         : CompressionDict::GetEmptyDict(),
                        blob_compression_type_, sample_for_compression);
 
   constexpr uint32_t compression_format_version = 2;
@@ -314,6 +397,10 @@ Status BlobFileBuilder::CloseBlobFile() {
 
   BlobLogFooter footer;
   footer.blob_count = blob_count_;
+  if (blob_compression_dict_enabled_) {
+    footer.has_compression_dictionary = true;
+    footer.compression_dict_offset = compression_dict_offset_;
+  }
 
   std::string checksum_method;
   std::string checksum_value;
@@ -350,6 +437,11 @@ Status BlobFileBuilder::CloseBlobFile() {
   writer_.reset();
   blob_count_ = 0;
   blob_bytes_ = 0;
+  compression_dict_done_ = false;
+  compression_dict_samples_.clear();
+  compression_dict_sample_lens_.clear();
+  compression_dict_.reset();
+  compression_dict_offset_ = 0;
 
   return s;
 }
@@ -385,6 +477,11 @@ void BlobFileBuilder::Abandon(const Status& s) {
   writer_.reset();
   blob_count_ = 0;
   blob_bytes_ = 0;
+  compression_dict_done_ = false;
+  compression_dict_samples_.clear();
+  compression_dict_sample_lens_.clear();
+  compression_dict_.reset();
+  compression_dict_offset_ = 0;
 }
 
 Status BlobFileBuilder::PutBlobIntoCacheIfNeeded(const Slice& blob,
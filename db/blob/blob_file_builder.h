@@ -30,6 +30,7 @@ class Slice;
 class BlobLogWriter;
 class IOTracer;
 class BlobFileCompletionCallback;
+struct CompressionDict;
 
 class BlobFileBuilder {
  public:
@@ -75,6 +76,7 @@ class BlobFileBuilder {
  private:
   bool IsBlobFileOpen() const;
   Status OpenBlobFileIfNeeded();
+  Status TrainCompressionDictIfNeeded(const Slice& value);
   Status CompressBlobIfNeeded(Slice* blob, std::string* compressed_blob) const;
   Status WriteBlobToFile(const Slice& key, const Slice& blob,
                          uint64_t* blob_file_number, uint64_t* blob_offset);
@@ -90,6 +92,8 @@ class BlobFileBuilder {
   uint64_t min_blob_size_;
   uint64_t blob_file_size_;
   CompressionType blob_compression_type_;
+  uint32_t blob_compression_max_dict_bytes_;
+  uint32_t blob_compression_zstd_max_train_bytes_;
   PrepopulateBlobCache prepopulate_blob_cache_;
   const FileOptions* file_options_;
   const std::string db_id_;
@@ -107,6 +111,13 @@ class BlobFileBuilder {
   std::unique_ptr<BlobLogWriter> writer_;
   uint64_t blob_count_;
   uint64_t blob_bytes_;
+  // Per-file compression dictionary state; see TrainCompressionDictIfNeeded.
+  bool blob_compression_dict_enabled_;
+  bool compression_dict_done_;
+  std::string compression_dict_samples_;
+  std::vector<size_t> compression_dict_sample_lens_;
+  std::unique_ptr<CompressionDict> compression_dict_;
+  uint64_t compression_dict_offset_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
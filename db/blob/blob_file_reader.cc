@@ -49,17 +49,35 @@ Status BlobFileReader::Create(
   Statistics* const statistics = immutable_options.stats;
 
   CompressionType compression_type = kNoCompression;
+  bool has_compression_dictionary = false;
 
   {
     const Status s = ReadHeader(file_reader.get(), column_family_id, statistics,
-                                &compression_type);
+                                &compression_type,
+                                &has_compression_dictionary);
     if (!s.ok()) {
       return s;
     }
   }
 
+  uint64_t compression_dict_offset = 0;
+
   {
-    const Status s = ReadFooter(file_reader.get(), file_size, statistics);
+    const Status s =
+        ReadFooter(file_reader.get(), file_size, has_compression_dictionary,
+                   statistics, &compression_dict_offset);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  std::unique_ptr<UncompressionDict> uncompression_dict;
+
+  if (compression_dict_offset) {
+    const Status s = ReadCompressionDict(file_reader.get(),
+                                         compression_dict_offset, file_size,
+                                         compression_type, statistics,
+                                         &uncompression_dict);
     if (!s.ok()) {
       return s;
     }
@@ -67,6 +85,8 @@ Status BlobFileReader::Create(
 
   blob_file_reader->reset(
       new BlobFileReader(std::move(file_reader), file_size, compression_type,
+                         compression_dict_offset,
+                         std::move(uncompression_dict),
                          immutable_options.clock, statistics));
 
   return Status::OK();
@@ -135,9 +155,11 @@ Status BlobFileReader::OpenFile(
 Status BlobFileReader::ReadHeader(const RandomAccessFileReader* file_reader,
                                   uint32_t column_family_id,
                                   Statistics* statistics,
-                                  CompressionType* compression_type) {
+                                  CompressionType* compression_type,
+                                  bool* has_compression_dictionary) {
   assert(file_reader);
   assert(compression_type);
+  assert(has_compression_dictionary);
 
   Slice header_slice;
   Buffer buf;
@@ -181,14 +203,26 @@ Status BlobFileReader::ReadHeader(const RandomAccessFileReader* file_reader,
   }
 
   *compression_type = header.compression;
+  *has_compression_dictionary = header.has_compression_dictionary;
 
   return Status::OK();
 }
 
 Status BlobFileReader::ReadFooter(const RandomAccessFileReader* file_reader,
-                                  uint64_t file_size, Statistics* statistics) {
+                                  uint64_t file_size,
+                                  bool has_compression_dictionary,
+                                  Statistics* statistics,
+                                  uint64_t* compression_dict_offset) {
   assert(file_size >= BlobLogHeader::kSize + BlobLogFooter::kSize);
   assert(file_reader);
+  assert(compression_dict_offset);
+
+  const size_t footer_size = has_compression_dictionary
+                                 ? BlobLogFooter::kSizeWithCompressionDict
+                                 : BlobLogFooter::kSize;
+  if (file_size < BlobLogHeader::kSize + footer_size) {
+    return Status::Corruption("Malformed blob file");
+  }
 
   Slice footer_slice;
   Buffer buf;
@@ -197,8 +231,8 @@ Status BlobFileReader::ReadFooter(const RandomAccessFileReader* file_reader,
   {
     TEST_SYNC_POINT("BlobFileReader::ReadFooter:ReadFromFile");
 
-    const uint64_t read_offset = file_size - BlobLogFooter::kSize;
-    constexpr size_t read_size = BlobLogFooter::kSize;
+    const uint64_t read_offset = file_size - footer_size;
+    const size_t read_size = footer_size;
 
     // TODO: rate limit reading footers from blob files.
     const Status s = ReadFromFile(file_reader, read_offset, read_size,
@@ -227,6 +261,87 @@ Status BlobFileReader::ReadFooter(const RandomAccessFileReader* file_reader,
     return Status::Corruption("Unexpected TTL blob file");
   }
 
+  *compression_dict_offset = footer.compression_dict_offset;
+
+  return Status::OK();
+}
+
+Status BlobFileReader::ReadCompressionDict(
+    const RandomAccessFileReader* file_reader, uint64_t offset,
+    uint64_t file_size, CompressionType compression_type,
+    Statistics* statistics,
+    std::unique_ptr<UncompressionDict>* uncompression_dict) {
+  assert(file_reader);
+  assert(uncompression_dict);
+  assert(!*uncompression_dict);
+
+  if (offset < BlobLogHeader::kSize ||
+      offset + BlobLogCompressionDictRecord::kHeaderSize +
+              BlobLogFooter::kSizeWithCompressionDict >
+          file_size) {
+    return Status::Corruption("Invalid compression dictionary offset");
+  }
+
+  BlobLogCompressionDictRecord record;
+
+  {
+    Slice header_slice;
+    Buffer buf;
+    AlignedBuf aligned_buf;
+
+    TEST_SYNC_POINT("BlobFileReader::ReadCompressionDict:ReadFromFile");
+
+    const Status s =
+        ReadFromFile(file_reader, offset,
+                     BlobLogCompressionDictRecord::kHeaderSize, statistics,
+                     &header_slice, &buf, &aligned_buf,
+                     Env::IO_TOTAL /* rate_limiter_priority */);
+    if (!s.ok()) {
+      return s;
+    }
+
+    const Status decode_status = record.DecodeHeaderFrom(header_slice);
+    if (!decode_status.ok()) {
+      return decode_status;
+    }
+  }
+
+  if (offset + BlobLogCompressionDictRecord::kHeaderSize + record.dict_size +
+          BlobLogFooter::kSizeWithCompressionDict >
+      file_size) {
+    return Status::Corruption("Invalid compression dictionary size");
+  }
+
+  std::string dict;
+
+  {
+    Slice dict_slice;
+    Buffer buf;
+    AlignedBuf aligned_buf;
+
+    const Status s = ReadFromFile(
+        file_reader, offset + BlobLogCompressionDictRecord::kHeaderSize,
+        record.dict_size, statistics, &dict_slice, &buf, &aligned_buf,
+        Env::IO_TOTAL /* rate_limiter_priority */);
+    if (!s.ok()) {
+      return s;
+    }
+
+    record.dict = dict_slice;
+
+    const Status crc_status = record.CheckDictCRC();
+    if (!crc_status.ok()) {
+      return crc_status;
+    }
+
+    dict.assign(dict_slice.data(), dict_slice.size());
+  }
+
+  const bool using_zstd = compression_type == kZSTD ||
+                          compression_type == kZSTDNotFinalCompression;
+
+  uncompression_dict->reset(new UncompressionDict(std::move(dict), using_zstd));
+
   return Status::OK();
 }
 
@@ -271,11 +386,14 @@ Status BlobFileReader::ReadFromFile(const RandomAccessFileReader* file_reader,
 
 BlobFileReader::BlobFileReader(
     std::unique_ptr<RandomAccessFileReader>&& file_reader, uint64_t file_size,
-    CompressionType compression_type, SystemClock* clock,
-    Statistics* statistics)
+    CompressionType compression_type, uint64_t compression_dict_offset,
+    std::unique_ptr<UncompressionDict>&& uncompression_dict,
+    SystemClock* clock, Statistics* statistics)
     : file_reader_(std::move(file_reader)),
       file_size_(file_size),
       compression_type_(compression_type),
+      compression_dict_offset_(compression_dict_offset),
+      uncompression_dict_(std::move(uncompression_dict)),
       clock_(clock),
       statistics_(statistics) {
   assert(file_reader_);
@@ -361,8 +479,10 @@ Status BlobFileReader::GetBlob(const ReadOptions& read_options,
   const Slice value_slice(record_slice.data() + adjustment, value_size);
 
   {
-    const Status s = UncompressBlobIfNeeded(value_slice, compression_type,
-                                            clock_, statistics_, value);
+    const Status s =
+        UncompressBlobIfNeeded(value_slice, compression_type,
+                               GetUncompressionDict(offset), clock_,
+                               statistics_, value);
     if (!s.ok()) {
       return s;
     }
@@ -492,9 +612,10 @@ void BlobFileReader::MultiGetBlob(const ReadOptions& read_options,
 
     // Uncompress blob if needed
     Slice value_slice(record_slice.data() + adjustments[i], blob_reqs[i]->len);
-    *blob_reqs[i]->status =
-        UncompressBlobIfNeeded(value_slice, compression_type_, clock_,
-                               statistics_, blob_reqs[i]->result);
+    *blob_reqs[i]->status = UncompressBlobIfNeeded(
+        value_slice, compression_type_,
+        GetUncompressionDict(blob_reqs[i]->offset), clock_, statistics_,
+        blob_reqs[i]->result);
     if (blob_reqs[i]->status->ok()) {
       total_bytes += record_slice.size();
     }
@@ -549,11 +670,10 @@ Status BlobFileReader::VerifyBlob(const Slice& record_slice,
   return Status::OK();
 }
 
-Status BlobFileReader::UncompressBlobIfNeeded(const Slice& value_slice,
-                                              CompressionType compression_type,
-                                              SystemClock* clock,
-                                              Statistics* statistics,
-                                              PinnableSlice* value) {
+Status BlobFileReader::UncompressBlobIfNeeded(
+    const Slice& value_slice, CompressionType compression_type,
+    const UncompressionDict& uncompression_dict, SystemClock* clock,
+    Statistics* statistics, PinnableSlice* value) {
   assert(value);
 
   if (compression_type == kNoCompression) {
@@ -563,8 +683,7 @@ Status BlobFileReader::UncompressBlobIfNeeded(const Slice& value_slice,
   }
 
   UncompressionContext context(compression_type);
-  UncompressionInfo info(context, UncompressionDict::GetEmptyDict(),
-                         compression_type);
+  UncompressionInfo info(context, uncompression_dict, compression_type);
 
   size_t uncompressed_size = 0;
   constexpr uint32_t compression_format_version = 2;
@@ -592,6 +711,15 @@ Status BlobFileReader::UncompressBlobIfNeeded(const Slice& value_slice,
   return Status::OK();
 }
 
+const UncompressionDict& BlobFileReader::GetUncompressionDict(
+    uint64_t offset) const {
+  if (uncompression_dict_ && offset > compression_dict_offset_) {
+    return *uncompression_dict_;
+  }
+
+  return UncompressionDict::GetEmptyDict();
+}
+
 void BlobFileReader::SaveValue(const Slice& src, PinnableSlice* dst) {
   assert(dst);
 
@@ -25,6 +25,7 @@ class Slice;
 class FilePrefetchBuffer;
 class PinnableSlice;
 class Statistics;
+struct UncompressionDict;
 
 class BlobFileReader {
  public:
@@ -59,6 +60,8 @@ class BlobFileReader {
  private:
   BlobFileReader(std::unique_ptr<RandomAccessFileReader>&& file_reader,
                  uint64_t file_size, CompressionType compression_type,
+                 uint64_t compression_dict_offset,
+                 std::unique_ptr<UncompressionDict>&& uncompression_dict,
                  SystemClock* clock, Statistics* statistics);
 
   static Status OpenFile(const ImmutableOptions& immutable_options,
@@ -71,10 +74,19 @@ class BlobFileReader {
 
   static Status ReadHeader(const RandomAccessFileReader* file_reader,
                            uint32_t column_family_id, Statistics* statistics,
-                           CompressionType* compression_type);
+                           CompressionType* compression_type,
+                           bool* has_compression_dictionary);
 
   static Status ReadFooter(const RandomAccessFileReader* file_reader,
-                           uint64_t file_size, Statistics* statistics);
+                           uint64_t file_size, bool has_compression_dictionary,
+                           Statistics* statistics,
+                           uint64_t* compression_dict_offset);
+
+  static Status ReadCompressionDict(
+      const RandomAccessFileReader* file_reader, uint64_t offset,
+      uint64_t file_size, CompressionType compression_type,
+      Statistics* statistics,
+      std::unique_ptr<UncompressionDict>* uncompression_dict);
 
   using Buffer = std::unique_ptr<char[]>;
 
@@ -87,17 +99,24 @@ class BlobFileReader {
   static Status VerifyBlob(const Slice& record_slice, const Slice& user_key,
                            uint64_t value_size);
 
-  static Status UncompressBlobIfNeeded(const Slice& value_slice,
-                                       CompressionType compression_type,
-                                       SystemClock* clock,
-                                       Statistics* statistics,
-                                       PinnableSlice* value);
+  static Status UncompressBlobIfNeeded(
+      const Slice& value_slice, CompressionType compression_type,
+      const UncompressionDict& uncompression_dict, SystemClock* clock,
+      Statistics* statistics, PinnableSlice* value);
+
+  // Returns the dictionary to use for a blob stored at the given offset:
+  // blobs located after the dictionary chunk were compressed using it, while
+  // the ones preceding the chunk (which the dictionary was trained on) were
+  // compressed without it.
+  const UncompressionDict& GetUncompressionDict(uint64_t offset) const;
 
   static void SaveValue(const Slice& src, PinnableSlice* dst);
 
   std::unique_ptr<RandomAccessFileReader> file_reader_;
   uint64_t file_size_;
   CompressionType compression_type_;
+  uint64_t compression_dict_offset_;
+  std::unique_ptr<UncompressionDict> uncompression_dict_;
   SystemClock* clock_;
   Statistics* statistics_;
 };
@@ -13,9 +13,11 @@ namespace ROCKSDB_NAMESPACE {
 
 Status BlobGarbageMeter::ProcessInFlow(const Slice& key, const Slice& value) {
   uint64_t blob_file_number = kInvalidBlobFileNumber;
+  uint64_t offset = 0;
+  uint64_t size = 0;
   uint64_t bytes = 0;
 
-  const Status s = Parse(key, value, &blob_file_number, &bytes);
+  const Status s = Parse(key, value, &blob_file_number, &offset, &size, &bytes);
   if (!s.ok()) {
     return s;
   }
@@ -24,16 +26,22 @@ Status BlobGarbageMeter::ProcessInFlow(const Slice& key, const Slice& value) {
     return Status::OK();
   }
 
-  flows_[blob_file_number].AddInFlow(bytes);
+  BlobInOutFlow& flow = flows_[blob_file_number];
+  flow.AddInFlow(bytes);
+  if (track_extents_) {
+    flow.AddExtent(offset, size);
+  }
 
   return Status::OK();
 }
 
 Status BlobGarbageMeter::ProcessOutFlow(const Slice& key, const Slice& value) {
   uint64_t blob_file_number = kInvalidBlobFileNumber;
+  uint64_t offset = 0;
+  uint64_t size = 0;
   uint64_t bytes = 0;
 
-  const Status s = Parse(key, value, &blob_file_number, &bytes);
+  const Status s = Parse(key, value, &blob_file_number, &offset, &size, &bytes);
   if (!s.ok()) {
     return s;
   }
@@ -51,14 +59,22 @@ Status BlobGarbageMeter::ProcessOutFlow(const Slice& key, const Slice& value) {
   }
 
   it->second.AddOutFlow(bytes);
+  if (track_extents_) {
+    it->second.RemoveExtent(offset);
+  }
 
   return Status::OK();
 }
 
 Status BlobGarbageMeter::Parse(const Slice& key, const Slice& value,
-                               uint64_t* blob_file_number, uint64_t* bytes) {
+                               uint64_t* blob_file_number, uint64_t* offset,
+                               uint64_t* size, uint64_t* bytes) {
   assert(blob_file_number);
   assert(*blob_file_number == kInvalidBlobFileNumber);
+  assert(offset);
+  assert(*offset == 0);
+  assert(size);
+  assert(*size == 0);
   assert(bytes);
   assert(*bytes == 0);
 
@@ -90,6 +106,8 @@ Status BlobGarbageMeter::Parse(const Slice& key, const Slice& value,
   }
 
   *blob_file_number = blob_index.file_number();
+  *offset = blob_index.offset();
+  *size = blob_index.size();
   *bytes =
       blob_index.size() +
       BlobLogRecord::CalculateAdjustmentForRecordHeader(ikey.user_key.size());
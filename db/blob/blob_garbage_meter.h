@@ -7,6 +7,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <map>
 #include <unordered_map>
 
 #include "db/blob/blob_constants.h"
@@ -61,6 +62,19 @@ class BlobGarbageMeter {
     const BlobStats& GetInFlow() const { return in_flow_; }
     const BlobStats& GetOutFlow() const { return out_flow_; }
 
+    void AddExtent(uint64_t offset, uint64_t length) {
+      garbage_extents_[offset] = length;
+    }
+    void RemoveExtent(uint64_t offset) { garbage_extents_.erase(offset); }
+
+    // The value regions of the blobs that appeared in the inflow but not in
+    // the outflow, keyed by offset. Once the entire input of the compaction
+    // has been processed, these are the extents of the garbage blobs.
+    // Only populated when the meter tracks extents.
+    const std::map<uint64_t, uint64_t>& GetGarbageExtents() const {
+      return garbage_extents_;
+    }
+
     bool IsValid() const {
       return in_flow_.GetCount() >= out_flow_.GetCount() &&
              in_flow_.GetBytes() >= out_flow_.GetBytes();
@@ -83,8 +97,17 @@ class BlobGarbageMeter {
    private:
     BlobStats in_flow_;
     BlobStats out_flow_;
+    std::map<uint64_t, uint64_t> garbage_extents_;
   };
 
+  // When track_extents is true, the meter also keeps track of the offset and
+  // length of each blob seen in the inflow/outflow, so that the value
+  // regions of garbage blobs can be located afterwards (e.g. for hole
+  // punching). This requires memory proportional to the number of blob
+  // references in the compaction input.
+  explicit BlobGarbageMeter(bool track_extents = false)
+      : track_extents_(track_extents) {}
+
   Status ProcessInFlow(const Slice& key, const Slice& value);
   Status ProcessOutFlow(const Slice& key, const Slice& value);
 
@@ -94,9 +117,11 @@ class BlobGarbageMeter {
 
  private:
   static Status Parse(const Slice& key, const Slice& value,
-                      uint64_t* blob_file_number, uint64_t* bytes);
+                      uint64_t* blob_file_number, uint64_t* offset,
+                      uint64_t* size, uint64_t* bytes);
 
   std::unordered_map<uint64_t, BlobInOutFlow> flows_;
+  bool track_extents_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
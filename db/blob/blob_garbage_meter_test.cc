@@ -121,6 +121,67 @@ TEST(BlobGarbageMeterTest, MeasureGarbage) {
   }
 }
 
+TEST(BlobGarbageMeterTest, GarbageExtents) {
+  constexpr bool track_extents = true;
+  BlobGarbageMeter blob_garbage_meter(track_extents);
+
+  struct BlobDescriptor {
+    std::string user_key;
+    uint64_t blob_file_number;
+    uint64_t offset;
+    uint64_t size;
+    bool has_out_flow;
+  };
+
+  // The blobs of "bar_key" and "baz_key" do not reappear in the outflow, so
+  // their value regions constitute the garbage extents of blob file 5.
+  std::vector<BlobDescriptor> blobs{{"key", 4, 1234, 555, true},
+                                    {"yet_another_key", 5, 22222, 3456, true},
+                                    {"bar_key", 5, 999999, 1212, false},
+                                    {"baz_key", 5, 1234567, 890, false}};
+
+  for (const auto& blob : blobs) {
+    constexpr SequenceNumber seq = 123;
+    const InternalKey key(blob.user_key, seq, kTypeBlobIndex);
+    const Slice key_slice = key.Encode();
+
+    std::string value;
+    BlobIndex::EncodeBlob(&value, blob.blob_file_number, blob.offset, blob.size,
+                          kLZ4Compression);
+    const Slice value_slice(value);
+
+    ASSERT_OK(blob_garbage_meter.ProcessInFlow(key_slice, value_slice));
+    if (blob.has_out_flow) {
+      ASSERT_OK(blob_garbage_meter.ProcessOutFlow(key_slice, value_slice));
+    }
+  }
+
+  const auto& flows = blob_garbage_meter.flows();
+  ASSERT_EQ(flows.size(), 2);
+
+  {
+    const auto it = flows.find(4);
+    ASSERT_NE(it, flows.end());
+    ASSERT_TRUE(it->second.GetGarbageExtents().empty());
+  }
+
+  {
+    const auto it = flows.find(5);
+    ASSERT_NE(it, flows.end());
+
+    const auto& extents = it->second.GetGarbageExtents();
+    ASSERT_EQ(extents.size(), 2);
+
+    const auto bar_it = extents.find(blobs[2].offset);
+    ASSERT_NE(bar_it, extents.end());
+    ASSERT_EQ(bar_it->second, blobs[2].size);
+
+    const auto baz_it = extents.find(blobs[3].offset);
+    ASSERT_NE(baz_it, extents.end());
+    ASSERT_EQ(baz_it->second, blobs[3].size);
+  }
+}
+
 TEST(BlobGarbageMeterTest, PlainValue) {
   constexpr char user_key[] = "user_key";
   constexpr SequenceNumber seq = 123;
@@ -18,7 +18,8 @@ void BlobLogHeader::EncodeTo(std::string* dst) {
   PutFixed32(dst, kMagicNumber);
   PutFixed32(dst, version);
   PutFixed32(dst, column_family_id);
-  unsigned char flags = (has_ttl ? 1 : 0);
+  unsigned char flags =
+      (has_ttl ? 1 : 0) | (has_compression_dictionary ? 2 : 0);
   dst->push_back(flags);
   dst->push_back(compression);
   PutFixed64(dst, expiration_range.first);
@@ -43,12 +44,18 @@ Status BlobLogHeader::DecodeFrom(Slice src) {
   if (magic_number != kMagicNumber) {
     return Status::Corruption(kErrorMessage, "Magic number mismatch");
   }
-  if (version != kVersion1) {
+  if (version != kVersion1 && version != kVersion2) {
     return Status::Corruption(kErrorMessage, "Unknown header version");
   }
   flags = src.data()[0];
   compression = static_cast<CompressionType>(src.data()[1]);
   has_ttl = (flags & 1) == 1;
+  has_compression_dictionary = (flags & 2) == 2;
+  if (has_compression_dictionary && version < kVersion2) {
+    return Status::Corruption(kErrorMessage,
+                              "Compression dictionary flag set in a version 1 "
+                              "blob file header");
+  }
   src.remove_prefix(2);
   if (!GetFixed64(&src, &expiration_range.first) ||
       !GetFixed64(&src, &expiration_range.second)) {
@@ -60,11 +67,16 @@ Status BlobLogHeader::DecodeFrom(Slice src) {
 void BlobLogFooter::EncodeTo(std::string* dst) {
   assert(dst != nullptr);
   dst->clear();
-  dst->reserve(BlobLogFooter::kSize);
+  dst->reserve(has_compression_dictionary
+                   ? BlobLogFooter::kSizeWithCompressionDict
+                   : BlobLogFooter::kSize);
   PutFixed32(dst, kMagicNumber);
   PutFixed64(dst, blob_count);
   PutFixed64(dst, expiration_range.first);
   PutFixed64(dst, expiration_range.second);
+  if (has_compression_dictionary) {
+    PutFixed64(dst, compression_dict_offset);
+  }
   crc = crc32c::Value(dst->c_str(), dst->size());
   crc = crc32c::Mask(crc);
   PutFixed32(dst, crc);
@@ -73,17 +85,28 @@ void BlobLogFooter::EncodeTo(std::string* dst) {
 Status BlobLogFooter::DecodeFrom(Slice src) {
   static const std::string kErrorMessage =
       "Error while decoding blob log footer";
-  if (src.size() != BlobLogFooter::kSize) {
+  if (src.size() != BlobLogFooter::kSize &&
+      src.size() != BlobLogFooter::kSizeWithCompressionDict) {
     return Status::Corruption(kErrorMessage,
                               "Unexpected blob file footer size");
   }
+  has_compression_dictionary =
+      src.size() == BlobLogFooter::kSizeWithCompressionDict;
   uint32_t src_crc = 0;
-  src_crc = crc32c::Value(src.data(), BlobLogFooter::kSize - sizeof(uint32_t));
+  src_crc = crc32c::Value(src.data(), src.size() - sizeof(uint32_t));
   src_crc = crc32c::Mask(src_crc);
   uint32_t magic_number = 0;
   if (!GetFixed32(&src, &magic_number) || !GetFixed64(&src, &blob_count) ||
       !GetFixed64(&src, &expiration_range.first) ||
-      !GetFixed64(&src, &expiration_range.second) || !GetFixed32(&src, &crc)) {
+      !GetFixed64(&src, &expiration_range.second)) {
+    return Status::Corruption(kErrorMessage, "Error decoding content");
+  }
+  if (has_compression_dictionary &&
+      !GetFixed64(&src, &compression_dict_offset)) {
+    return Status::Corruption(kErrorMessage,
+                              "Error decoding compression dictionary offset");
+  }
+  if (!GetFixed32(&src, &crc)) {
     return Status::Corruption(kErrorMessage, "Error decoding content");
   }
   if (magic_number != kMagicNumber) {
@@ -95,6 +118,40 @@ Status BlobLogFooter::DecodeFrom(Slice src) {
   return Status::OK();
 }
 
+void BlobLogCompressionDictRecord::EncodeHeaderTo(std::string* dst) {
+  assert(dst != nullptr);
+  dst->clear();
+  dst->reserve(BlobLogCompressionDictRecord::kHeaderSize + dict.size());
+  dict_size = static_cast<uint32_t>(dict.size());
+  PutFixed32(dst, dict_size);
+  dict_crc = crc32c::Value(dict.data(), dict.size());
+  dict_crc = crc32c::Mask(dict_crc);
+  PutFixed32(dst, dict_crc);
+}
+
+Status BlobLogCompressionDictRecord::DecodeHeaderFrom(Slice src) {
+  static const std::string kErrorMessage =
+      "Error while decoding compression dictionary chunk";
+  if (src.size() != BlobLogCompressionDictRecord::kHeaderSize) {
+    return Status::Corruption(kErrorMessage,
+                              "Unexpected dictionary chunk header size");
+  }
+  if (!GetFixed32(&src, &dict_size) || !GetFixed32(&src, &dict_crc)) {
+    return Status::Corruption(kErrorMessage, "Error decoding content");
+  }
+  return Status::OK();
+}
+
+Status BlobLogCompressionDictRecord::CheckDictCRC() const {
+  uint32_t expected_crc = 0;
+  expected_crc = crc32c::Value(dict.data(), dict.size());
+  expected_crc = crc32c::Mask(expected_crc);
+  if (expected_crc != dict_crc) {
+    return Status::Corruption("Compression dictionary CRC mismatch");
+  }
+  return Status::OK();
+}
+
 void BlobLogRecord::EncodeHeaderTo(std::string* dst) {
   assert(dst != nullptr);
   dst->clear();
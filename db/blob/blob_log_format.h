@@ -19,6 +19,9 @@ namespace ROCKSDB_NAMESPACE {
 
 constexpr uint32_t kMagicNumber = 2395959;  // 0x00248f37
 constexpr uint32_t kVersion1 = 1;
+// Version 2 adds support for per-file compression dictionaries; see the
+// has_compression_dictionary flag below.
+constexpr uint32_t kVersion2 = 2;
 
 using ExpirationRange = std::pair<uint64_t, uint64_t>;
 
@@ -32,6 +35,9 @@ using ExpirationRange = std::pair<uint64_t, uint64_t>;
 //
 // List of flags:
 //   has_ttl: Whether the file contain TTL data.
+//   has_compression_dictionary: Whether the file may contain a compression
+//     dictionary chunk (version 2 files only). When set, the footer uses the
+//     extended format that records the chunk's offset.
 //
 // Expiration range in the header is a rough range based on
 // blob_db_options.ttl_range_secs.
@@ -50,6 +56,7 @@ struct BlobLogHeader {
   uint32_t column_family_id = 0;
   CompressionType compression = kNoCompression;
   bool has_ttl = false;
+  bool has_compression_dictionary = false;
   ExpirationRange expiration_range;
 
   void EncodeTo(std::string* dst);
@@ -69,11 +76,19 @@ struct BlobLogHeader {
 //
 // Unlike the same field in file header, expiration range in the footer is the
 // range of smallest and largest expiration of the data in this file.
+//
+// When the header has the has_compression_dictionary flag set, the footer
+// uses an extended format (40 bytes) with an additional Fixed64 between the
+// expiration range and the CRC that contains the offset of the compression
+// dictionary chunk (or zero if no dictionary was written to the file).
 struct BlobLogFooter {
   static constexpr size_t kSize = 32;
+  static constexpr size_t kSizeWithCompressionDict = kSize + sizeof(uint64_t);
 
   uint64_t blob_count = 0;
   ExpirationRange expiration_range = std::make_pair(0, 0);
+  bool has_compression_dictionary = false;
+  uint64_t compression_dict_offset = 0;
   uint32_t crc = 0;
 
   void EncodeTo(std::string* dst);
@@ -81,6 +96,33 @@ struct BlobLogFooter {
   Status DecodeFrom(Slice slice);
 };
 
+// Compression dictionary chunk format (8 bytes header + dictionary):
+//
+//    +-----------+----------+------------+
+//    | dict size | dict CRC | dictionary |
+//    +-----------+----------+------------+
+//    |  Fixed32  | Fixed32  | dict size  |
+//    +-----------+----------+------------+
+//
+// The chunk can only be present in files whose header has the
+// has_compression_dictionary flag set; its offset is recorded in the footer.
+// Records at offsets larger than the chunk's offset are compressed using the
+// dictionary, while records preceding it (the ones the dictionary was
+// trained on) are compressed without it.
+struct BlobLogCompressionDictRecord {
+  static constexpr size_t kHeaderSize = 8;
+
+  uint32_t dict_size = 0;
+  uint32_t dict_crc = 0;
+  Slice dict;
+
+  void EncodeHeaderTo(std::string* dst);
+
+  Status DecodeHeaderFrom(Slice src);
+
+  Status CheckDictCRC() const;
+};
+
 // Blob record format (32 bytes header + key + value):
 //
 //    +------------+--------------+------------+------------+----------+---------+-----------+
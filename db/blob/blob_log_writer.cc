@@ -135,6 +135,35 @@ Status BlobLogWriter::AddRecord(const Slice& key, const Slice& val,
   return s;
 }
 
+Status BlobLogWriter::AddCompressionDictRecord(const Slice& dict,
+                                               uint64_t* dict_offset) {
+  assert(block_offset_ != 0);
+  assert(last_elem_type_ == kEtFileHdr || last_elem_type_ == kEtRecord);
+  assert(dict_offset != nullptr);
+
+  BlobLogCompressionDictRecord record;
+  record.dict = dict;
+
+  std::string buf;
+  record.EncodeHeaderTo(&buf);
+
+  StopWatch write_sw(clock_, statistics_, BLOB_DB_BLOB_FILE_WRITE_MICROS);
+  Status s = dest_->Append(Slice(buf));
+  if (s.ok()) {
+    s = dest_->Append(dict);
+  }
+  if (do_flush_ && s.ok()) {
+    s = dest_->Flush();
+  }
+
+  *dict_offset = block_offset_;
+  block_offset_ += buf.size() + dict.size();
+  last_elem_type_ = kEtRecord;
+  RecordTick(statistics_, BLOB_DB_BLOB_FILE_BYTES_WRITTEN,
+             buf.size() + dict.size());
+  return s;
+}
+
 void BlobLogWriter::ConstructBlobHeader(std::string* buf, const Slice& key,
                                         const Slice& val, uint64_t expiration) {
   BlobLogRecord record;
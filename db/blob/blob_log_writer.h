@@ -49,6 +49,12 @@ class BlobLogWriter {
   Status AddRecord(const Slice& key, const Slice& val, uint64_t expiration,
                    uint64_t* key_offset, uint64_t* blob_offset);
 
+  // Writes a compression dictionary chunk at the current position and returns
+  // its offset. May only be used in files whose header has the
+  // has_compression_dictionary flag set; the returned offset is expected to
+  // be recorded in the footer.
+  Status AddCompressionDictRecord(const Slice& dict, uint64_t* dict_offset);
+
   Status EmitPhysicalRecord(const std::string& headerbuf, const Slice& key,
                             const Slice& val, uint64_t* key_offset,
                             uint64_t* blob_offset);
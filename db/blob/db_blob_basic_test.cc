@@ -12,6 +12,7 @@
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
 #include "test_util/sync_point.h"
+#include "util/compression.h"
 #include "utilities/fault_injection_env.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -220,6 +221,96 @@ TEST_F(DBBlobBasicTest, IterateBlobsFromCache) {
   }
 }
 
+TEST_F(DBBlobBasicTest, IterateBlobsWithReadahead) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+
+  Reopen(options);
+
+  constexpr int num_blobs = 5;
+  std::vector<std::string> keys;
+  std::vector<std::string> blobs;
+
+  for (int i = 0; i < num_blobs; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    blobs.push_back("blob" + std::to_string(i));
+    ASSERT_OK(Put(keys[i], blobs[i]));
+  }
+  ASSERT_OK(Flush());
+
+  ReadOptions read_options;
+  read_options.readahead_size = 1 << 20;
+
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+
+    int i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+      ++i;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, num_blobs);
+  }
+
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+
+    // Backward scans should work with readahead enabled as well.
+    int i = num_blobs;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      ASSERT_OK(iter->status());
+      --i;
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, 0);
+  }
+}
+
+TEST_F(DBBlobBasicTest, CompressionDictionary) {
+  if (!ZSTD_Supported()) {
+    return;
+  }
+
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  options.blob_compression_type = kZSTD;
+  options.blob_compression_max_dict_bytes = 4 << 10;
+
+  Reopen(options);
+
+  // Write enough similarly structured blobs that the per-file compression
+  // dictionary gets trained and the later blobs are compressed using it.
+  constexpr int num_blobs = 100;
+  std::vector<std::string> keys;
+  std::vector<std::string> blobs;
+
+  for (int i = 0; i < num_blobs; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    blobs.push_back("blob" + std::to_string(i) + std::string(200, 'x'));
+    ASSERT_OK(Put(keys[i], blobs[i]));
+  }
+  ASSERT_OK(Flush());
+
+  for (int i = 0; i < num_blobs; ++i) {
+    ASSERT_EQ(Get(keys[i]), blobs[i]);
+  }
+
+  // Make sure the dictionary can be read back from the file after the blob
+  // file reader is reconstructed.
+  Reopen(options);
+
+  for (int i = 0; i < num_blobs; ++i) {
+    ASSERT_EQ(Get(keys[i]), blobs[i]);
+  }
+}
+
 TEST_F(DBBlobBasicTest, MultiGetBlobs) {
   constexpr size_t min_blob_size = 6;
 
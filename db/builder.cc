@@ -10,6 +10,7 @@
 #include "db/builder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "monitoring/iostats_context_imp.h"
 #include "monitoring/thread_status_util.h"
 #include "options/options_helper.h"
+#include "port/port.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
 #include "rocksdb/iterator.h"
@@ -39,12 +41,138 @@
 #include "table/internal_iterator.h"
 #include "table/unique_id_impl.h"
 #include "test_util/sync_point.h"
+#include "util/coding.h"
+#include "util/mutexlock.h"
 #include "util/stop_watch.h"
 
 namespace ROCKSDB_NAMESPACE {
 
 class TableFactory;
 
+namespace {
+
+// A batch of entries drained from the input iterator of a pipelined flush.
+// Keys and values are copied into a flat, length-prefixed buffer because
+// CompactionIterator invalidates the current entry on Next().
+struct FlushKVBatch {
+  std::string buf;
+  size_t num_entries = 0;
+
+  void Add(const Slice& key, const Slice& value) {
+    PutLengthPrefixedSlice(&buf, key);
+    PutLengthPrefixedSlice(&buf, value);
+    ++num_entries;
+  }
+};
+
+// State shared between the iteration (producer) stage and the table building
+// (consumer) stage of a pipelined flush. Except where noted, all fields are
+// protected by mu.
+struct FlushPipelineState {
+  explicit FlushPipelineState() : cv(&mu) {}
+
+  port::Mutex mu;
+  port::CondVar cv;
+  std::deque<std::unique_ptr<FlushKVBatch>> queue;
+  bool producer_done = false;
+  Status consumer_status;
+
+  // Running count of bytes the consumer has written, published after each
+  // batch so the producer can report flush progress from the flush thread
+  // (ThreadStatus only knows about the flush thread). Not protected by mu.
+  std::atomic<uint64_t> consumer_bytes_written{0};
+  // Snapshot of the consumer thread's IO statistics, taken right before the
+  // consumer exits and read by the producer after joining it. IOStats live in
+  // thread locals, so whatever the consumer accumulates is invisible to the
+  // flush thread until it is folded back in (see AddConsumerIOStats()).
+  IOStatsContext consumer_iostats;
+};
+
+// Adds the IO statistics the consumer thread accumulated to the calling
+// (flush) thread's counters.
+void AddConsumerIOStats(const IOStatsContext& src) {
+  (void)src;  // all adds compile away under NIOSTATS_CONTEXT
+  IOSTATS_ADD(bytes_written, src.bytes_written);
+  IOSTATS_ADD(bytes_read, src.bytes_read);
+  IOSTATS_ADD(open_nanos, src.open_nanos);
+  IOSTATS_ADD(allocate_nanos, src.allocate_nanos);
+  IOSTATS_ADD(write_nanos, src.write_nanos);
+  IOSTATS_ADD(read_nanos, src.read_nanos);
+  IOSTATS_ADD(range_sync_nanos, src.range_sync_nanos);
+  IOSTATS_ADD(fsync_nanos, src.fsync_nanos);
+  IOSTATS_ADD(prepare_write_nanos, src.prepare_write_nanos);
+  IOSTATS_ADD(logger_nanos, src.logger_nanos);
+  IOSTATS_ADD(cpu_write_nanos, src.cpu_write_nanos);
+  IOSTATS_ADD(cpu_read_nanos, src.cpu_read_nanos);
+}
+
+// Consumer stage of a pipelined flush: pops batches off the queue in order
+// and feeds them through the output validator and the table builder. Runs
+// until the producer is done or either stage fails.
+void FlushPipelineConsumerLoop(FlushPipelineState* state, TableBuilder* builder,
+                               OutputValidator* output_validator,
+                               FileMetaData* meta) {
+  for (;;) {
+    std::unique_ptr<FlushKVBatch> batch;
+    {
+      MutexLock l(&state->mu);
+      while (state->queue.empty() && !state->producer_done) {
+        state->cv.Wait();
+      }
+      if (state->queue.empty()) {
+        return;
+      }
+      batch = std::move(state->queue.front());
+      state->queue.pop_front();
+      state->cv.SignalAll();
+    }
+    Status s;
+    Slice input(batch->buf);
+    for (size_t i = 0; i < batch->num_entries && s.ok(); ++i) {
+      Slice key;
+      Slice value;
+      if (!GetLengthPrefixedSlice(&input, &key) ||
+          !GetLengthPrefixedSlice(&input, &value)) {
+        s = Status::Corruption("Malformed pipelined flush batch");
+        break;
+      }
+      s = output_validator->Add(key, value);
+      if (!s.ok()) {
+        break;
+      }
+      builder->Add(key, value);
+      uint64_t seqno;
+      ValueType type;
+      UnPackSequenceAndType(ExtractInternalKeyFooter(key), &seqno, &type);
+      s = meta->UpdateBoundaries(key, value, seqno, type);
+    }
+    TEST_SYNC_POINT_CALLBACK("FlushPipelineConsumer:ProcessedBatch", &s);
+    if (!s.ok()) {
+      MutexLock l(&state->mu);
+      state->consumer_status = s;
+      state->cv.SignalAll();
+      return;
+    }
+    state->consumer_bytes_written.store(IOSTATS(bytes_written),
+                                        std::memory_order_relaxed);
+  }
+}
+
+// Entry point of the consumer thread. The loop is wrapped so that the IO
+// statistics this thread accumulates are snapshotted on every exit path; the
+// flush thread folds them into its own counters after the join.
+void FlushPipelineConsumer(FlushPipelineState* state, TableBuilder* builder,
+                           OutputValidator* output_validator,
+                           FileMetaData* meta) {
+  // The thread is freshly spawned, but make the baseline explicit so the
+  // snapshot below is a pure delta of this flush's table writes.
+  IOSTATS_RESET_ALL();
+  FlushPipelineConsumerLoop(state, builder, output_validator, meta);
+  state->consumer_iostats = *get_iostats_context();
+}
+
+}  // namespace
+
 TableBuilder* NewTableBuilder(const TableBuilderOptions& tboptions,
                               WritableFileWriter* file) {
   assert((tboptions.column_family_id ==
@@ -208,30 +336,95 @@ Status BuildTable(
         /*shutting_down=*/nullptr, db_options.info_log, full_history_ts_low);
 
     c_iter.SeekToFirst();
-    for (; c_iter.Valid(); c_iter.Next()) {
-      const Slice& key = c_iter.key();
-      const Slice& value = c_iter.value();
-      const ParsedInternalKey& ikey = c_iter.ikey();
-      // Generate a rolling 64-bit hash of the key and values
-      // Note :
-      // Here "key" integrates 'sequence_number'+'kType'+'user key'.
-      s = output_validator.Add(key, value);
-      if (!s.ok()) {
-        break;
+    if (db_options.enable_pipelined_flush) {
+      // Two-stage pipeline: this thread keeps draining the input iterator
+      // (compaction filter, merge and blob handling included) into batches
+      // while a second thread builds, compresses and writes the table file.
+      // The queue depth is bounded so a slow consumer applies backpressure
+      // instead of buffering the whole memtable.
+      const size_t kFlushBatchBytes = 1 << 20;
+      const size_t kMaxQueuedBatches = 2;
+      FlushPipelineState state;
+      port::Thread consumer(FlushPipelineConsumer, &state, builder,
+                            &output_validator, meta);
+      std::unique_ptr<FlushKVBatch> batch(new FlushKVBatch());
+      bool consumer_failed = false;
+      for (; c_iter.Valid() && !consumer_failed; c_iter.Next()) {
+        batch->Add(c_iter.key(), c_iter.value());
+        if (batch->buf.size() >= kFlushBatchBytes) {
+          {
+            MutexLock l(&state.mu);
+            while (state.queue.size() >= kMaxQueuedBatches &&
+                   state.consumer_status.ok()) {
+              state.cv.Wait();
+            }
+            if (!state.consumer_status.ok()) {
+              consumer_failed = true;
+              break;
+            }
+            state.queue.push_back(std::move(batch));
+            state.cv.SignalAll();
+            batch.reset(new FlushKVBatch());
+          }
+          // Progress reporting has to happen on this thread: ThreadStatus is
+          // thread local and only the flush thread is registered as running
+          // a flush. The consumer publishes its byte count after each batch.
+          if (io_priority == Env::IO_HIGH) {
+            uint64_t table_bytes = state.consumer_bytes_written.load(
+                std::memory_order_relaxed);
+            if (table_bytes >= kReportFlushIOStatsEvery) {
+              ThreadStatusUtil::SetThreadOperationProperty(
+                  ThreadStatus::FLUSH_BYTES_WRITTEN,
+                  IOSTATS(bytes_written) + table_bytes);
+            }
+          }
+        }
       }
-      builder->Add(key, value);
-
-      s = meta->UpdateBoundaries(key, value, ikey.sequence, ikey.type);
-      if (!s.ok()) {
-        break;
+      {
+        MutexLock l(&state.mu);
+        if (batch->num_entries > 0 && state.consumer_status.ok()) {
+          state.queue.push_back(std::move(batch));
+        }
+        state.producer_done = true;
+        state.cv.SignalAll();
       }
-
-      // TODO(noetzli): Update stats after flush, too.
-      if (io_priority == Env::IO_HIGH &&
-          IOSTATS(bytes_written) >= kReportFlushIOStatsEvery) {
+      consumer.join();
+      // No lock needed after the join.
+      s = state.consumer_status;
+      // The consumer wrote the table file on its own thread; fold its IO
+      // statistics back into this thread so flush-level accounting (IOSTATS
+      // and ThreadStatus::FLUSH_BYTES_WRITTEN) still covers the table writes.
+      AddConsumerIOStats(state.consumer_iostats);
+      if (io_priority == Env::IO_HIGH) {
         ThreadStatusUtil::SetThreadOperationProperty(
             ThreadStatus::FLUSH_BYTES_WRITTEN, IOSTATS(bytes_written));
       }
+    } else {
+      for (; c_iter.Valid(); c_iter.Next()) {
+        const Slice& key = c_iter.key();
+        const Slice& value = c_iter.value();
+        const ParsedInternalKey& ikey = c_iter.ikey();
+        // Generate a rolling 64-bit hash of the key and values
+        // Note :
+        // Here "key" integrates 'sequence_number'+'kType'+'user key'.
+        s = output_validator.Add(key, value);
+        if (!s.ok()) {
+          break;
+        }
+        builder->Add(key, value);
+
+        s = meta->UpdateBoundaries(key, value, ikey.sequence, ikey.type);
+        if (!s.ok()) {
+          break;
+        }
+
+        // TODO(noetzli): Update stats after flush, too.
+        if (io_priority == Env::IO_HIGH &&
+            IOSTATS(bytes_written) >= kReportFlushIOStatsEvery) {
+          ThreadStatusUtil::SetThreadOperationProperty(
+              ThreadStatus::FLUSH_BYTES_WRITTEN, IOSTATS(bytes_written));
+        }
+      }
     }
     if (!s.ok()) {
       c_iter.status().PermitUncheckedError();
@@ -282,6 +475,12 @@ Status BuildTable(
       meta->marked_for_compaction = builder->NeedCompact();
       assert(meta->fd.GetFileSize() > 0);
       tp = builder->GetTableProperties(); // refresh now that builder is finished
+      if (tp.data_size < file_size) {
+        // Everything after the data blocks (index, filter, other meta blocks
+        // and the footer). Persisted so that a future open of this file can
+        // prefetch exactly the tail in one read.
+        meta->fd.tail_size = file_size - tp.data_size;
+      }
       if (memtable_payload_bytes != nullptr &&
           memtable_garbage_bytes != nullptr) {
         const CompactionIterationStats& ci_stats = c_iter.iter_stats();
@@ -29,17 +29,21 @@
 #include "db/table_properties_collector.h"
 #include "db/version_set.h"
 #include "db/write_controller.h"
+#include "file/filename.h"
 #include "file/sst_file_manager_impl.h"
 #include "logging/logging.h"
+#include "monitoring/statistics.h"
 #include "monitoring/thread_status_util.h"
 #include "options/options_helper.h"
 #include "port/port.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/table.h"
 #include "table/merging_iterator.h"
+#include "test_util/sync_point.h"
 #include "util/autovector.h"
 #include "util/cast_util.h"
 #include "util/compression.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -511,6 +515,24 @@ std::vector<std::string> ColumnFamilyData::GetDbPaths() const {
 const uint32_t ColumnFamilyData::kDummyColumnFamilyDataId =
     std::numeric_limits<uint32_t>::max();
 
+namespace {
+
+// Builds the column family's ImmutableOptions, pointing its `stats` at the
+// per-CF child statistics object when one could be created. The CF's updates
+// then go to the child, which the DB-wide statistics object includes in its
+// totals by aggregating lazily on read.
+ImmutableOptions MakeImmutableOptions(const ImmutableDBOptions& db_options,
+                                      const ColumnFamilyOptions& cf_options,
+                                      Statistics* cf_stats) {
+  ImmutableOptions ioptions(db_options, cf_options);
+  if (cf_stats != nullptr) {
+    ioptions.stats = cf_stats;
+  }
+  return ioptions;
+}
+
+}  // anonymous namespace
+
 ColumnFamilyData::ColumnFamilyData(
     uint32_t id, const std::string& name, Version* _dummy_versions,
     Cache* _table_cache, WriteBufferManager* write_buffer_manager,
@@ -528,7 +550,13 @@ ColumnFamilyData::ColumnFamilyData(
       dropped_(false),
       internal_comparator_(cf_options.comparator),
       initial_cf_options_(SanitizeOptions(db_options, cf_options)),
-      ioptions_(db_options, initial_cf_options_),
+      cf_stats_(id == kDummyColumnFamilyDataId
+                    ? nullptr
+                    : StatisticsImpl::CreateChildStatistics(
+                          db_options.statistics)),
+      ioptions_(
+          MakeImmutableOptions(db_options, initial_cf_options_,
+                               cf_stats_.get())),
       mutable_cf_options_(initial_cf_options_),
       is_delete_range_supported_(
           cf_options.table_factory->IsDeleteRangeSupported()),
@@ -538,7 +566,9 @@ ColumnFamilyData::ColumnFamilyData(
            ioptions_.max_write_buffer_number_to_maintain,
            ioptions_.max_write_buffer_size_to_maintain),
       super_version_(nullptr),
+      sv_epoch_slots_(new ThreadLocalPtr()),
       super_version_number_(0),
+      new_data_epoch_(0),
       local_sv_(new ThreadLocalPtr(&SuperVersionUnrefHandle)),
       next_(nullptr),
       prev_(nullptr),
@@ -548,6 +578,9 @@ ColumnFamilyData::ColumnFamilyData(
       queued_for_flush_(false),
       queued_for_compaction_(false),
       prev_compaction_needed_bytes_(0),
+      prev_recalc_time_micros_(0),
+      write_stall_cause_(WriteStallCause::kNone),
+      predicted_stall_duration_ms_(0),
       allow_2pc_(db_options.allow_2pc),
       last_memtable_id_(0),
       db_paths_registered_(false),
@@ -670,6 +703,7 @@ ColumnFamilyData::~ColumnFamilyData() {
   assert(!queued_for_flush_);
   assert(!queued_for_compaction_);
   assert(super_version_ == nullptr);
+  assert(retired_super_versions_.empty());
 
   if (dummy_versions_ != nullptr) {
     // List must be empty
@@ -720,18 +754,47 @@ bool ColumnFamilyData::UnrefAndTryDelete() {
 
   if (old_refs == 1) {
     assert(super_version_ == nullptr);
+    assert(retired_super_versions_.empty());
     delete this;
     return true;
   }
 
-  if (old_refs == 2 && super_version_ != nullptr) {
-    // Only the super_version_ holds me
+  size_t num_retired;
+  {
+    MutexLock l(&super_version_mutex_);
+    num_retired = retired_super_versions_.size();
+  }
+  if (super_version_ != nullptr &&
+      old_refs == 2 + static_cast<int>(num_retired)) {
+    // Only super_version_ and the retired super versions hold me. There
+    // can be no reader inside RefPublishedSuperVersion() either, since
+    // readers reach it through a handle that references this
+    // ColumnFamilyData.
     SuperVersion* sv = super_version_;
     super_version_ = nullptr;
+    published_super_version_.store(nullptr, std::memory_order_release);
 
     // Release SuperVersion references kept in ThreadLocalPtr.
     local_sv_.reset();
 
+    // Drop the publication references of retired super versions without
+    // waiting for a grace period; each Cleanup() re-enters
+    // UnrefAndTryDelete(), which is why super_version_ was detached above.
+    std::deque<std::pair<uint64_t, SuperVersion*>> retired;
+    {
+      MutexLock l(&super_version_mutex_);
+      retired.swap(retired_super_versions_);
+    }
+    TEST_SYNC_POINT_CALLBACK("ColumnFamilyData::UnrefAndTryDelete:DrainRetired",
+                             &retired);
+    for (auto& epoch_and_sv : retired) {
+      SuperVersion* retired_sv = epoch_and_sv.second;
+      if (retired_sv->Unref()) {
+        retired_sv->Cleanup();
+        delete retired_sv;
+      }
+    }
+
     if (sv->Unref()) {
       // Note: sv will delete this ColumnFamilyData during Cleanup()
       assert(sv->cfd == this);
@@ -780,14 +843,18 @@ const double kIncSlowdownRatio = 0.8;
 const double kDecSlowdownRatio = 1 / kIncSlowdownRatio;
 const double kNearStopSlowdownRatio = 0.6;
 const double kDelayRecoverSlowdownRatio = 1.4;
+// In predictive mode, start shaping the write rate once the compaction debt
+// is projected to reach the soft limit within this horizon.
+const uint64_t kPredictiveHorizonMicros = 30 * 1000000u;
 
 namespace {
+const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
+
 // If penalize_stop is true, we further reduce slowdown rate.
 std::unique_ptr<WriteControllerToken> SetupDelay(
     WriteController* write_controller, uint64_t compaction_needed_bytes,
     uint64_t prev_compaction_need_bytes, bool penalize_stop,
     bool auto_compactions_disabled) {
-  const uint64_t kMinWriteRate = 16 * 1024u;  // Minimum write rate 16KB/s.
 
   uint64_t max_write_rate = write_controller->max_delayed_write_rate();
   uint64_t write_rate = write_controller->delayed_write_rate();
@@ -879,7 +946,7 @@ int GetL0ThresholdSpeedupCompaction(int level0_file_num_compaction_trigger,
 }
 }  // namespace
 
-std::pair<WriteStallCondition, ColumnFamilyData::WriteStallCause>
+std::pair<WriteStallCondition, WriteStallCause>
 ColumnFamilyData::GetWriteStallConditionAndCause(
     int num_unflushed_memtables, int num_l0_files,
     uint64_t num_compaction_needed_bytes,
@@ -936,6 +1003,27 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
     bool was_stopped = write_controller->IsStopped();
     bool needed_delay = write_controller->NeedsDelay();
 
+    const uint64_t now_micros = ioptions_.clock->NowMicros();
+    // Best-effort prediction of how long an ongoing pending-compaction
+    // slowdown will last: if the debt has been draining, extrapolate when
+    // it falls back below the soft limit. 0 means no prediction.
+    predicted_stall_duration_ms_ = 0;
+    if (write_stall_cause == WriteStallCause::kPendingCompactionBytes &&
+        prev_recalc_time_micros_ > 0 && now_micros > prev_recalc_time_micros_ &&
+        prev_compaction_needed_bytes_ > compaction_needed_bytes &&
+        compaction_needed_bytes >
+            mutable_cf_options.soft_pending_compaction_bytes_limit) {
+      const double drain_bytes_per_micro =
+          static_cast<double>(prev_compaction_needed_bytes_ -
+                              compaction_needed_bytes) /
+          static_cast<double>(now_micros - prev_recalc_time_micros_);
+      predicted_stall_duration_ms_ = static_cast<uint64_t>(
+          static_cast<double>(
+              compaction_needed_bytes -
+              mutable_cf_options.soft_pending_compaction_bytes_limit) /
+          drain_bytes_per_micro / 1000.0);
+    }
+
     if (write_stall_condition == WriteStallCondition::kStopped &&
         write_stall_cause == WriteStallCause::kMemtableLimit) {
       write_controller_token_ = write_controller->GetStopToken();
@@ -1029,7 +1117,52 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
           write_controller->delayed_write_rate());
     } else {
       assert(write_stall_condition == WriteStallCondition::kNormal);
-      if (vstorage->l0_delay_trigger_count() >=
+      // In predictive mode, start shaping the write rate before the soft
+      // limit is hit: project when the compaction debt would reach it at
+      // its recent growth rate, and once that is within
+      // kPredictiveHorizonMicros throttle proportionally to the remaining
+      // headroom, so throughput degrades gradually instead of dropping off
+      // a cliff when the limit is crossed.
+      uint64_t predicted_micros_to_limit =
+          std::numeric_limits<uint64_t>::max();
+      if (ioptions_.predictive_write_throttling &&
+          !mutable_cf_options.disable_auto_compactions &&
+          mutable_cf_options.soft_pending_compaction_bytes_limit > 0 &&
+          prev_recalc_time_micros_ > 0 &&
+          now_micros > prev_recalc_time_micros_ &&
+          compaction_needed_bytes > prev_compaction_needed_bytes_) {
+        const double growth_bytes_per_micro =
+            static_cast<double>(compaction_needed_bytes -
+                                prev_compaction_needed_bytes_) /
+            static_cast<double>(now_micros - prev_recalc_time_micros_);
+        // kNormal implies the debt is still below the soft limit.
+        assert(compaction_needed_bytes <
+               mutable_cf_options.soft_pending_compaction_bytes_limit);
+        predicted_micros_to_limit = static_cast<uint64_t>(
+            static_cast<double>(
+                mutable_cf_options.soft_pending_compaction_bytes_limit -
+                compaction_needed_bytes) /
+            growth_bytes_per_micro);
+      }
+      if (predicted_micros_to_limit < kPredictiveHorizonMicros) {
+        uint64_t write_rate = static_cast<uint64_t>(
+            static_cast<double>(write_controller->max_delayed_write_rate()) *
+            static_cast<double>(predicted_micros_to_limit) /
+            static_cast<double>(kPredictiveHorizonMicros));
+        write_rate = std::max(write_rate, kMinWriteRate);
+        write_controller_token_ = write_controller->GetDelayToken(write_rate);
+        write_stall_cause = WriteStallCause::kPredictiveCompactionDebt;
+        predicted_stall_duration_ms_ = predicted_micros_to_limit / 1000;
+        ROCKS_LOG_INFO(
+            ioptions_.logger,
+            "[%s] Preemptively stalling writes because estimated pending "
+            "compaction bytes %" PRIu64
+            " is predicted to reach the soft limit in %" PRIu64
+            " ms, rate %" PRIu64,
+            name_.c_str(), compaction_needed_bytes,
+            predicted_stall_duration_ms_,
+            write_controller->delayed_write_rate());
+      } else if (vstorage->l0_delay_trigger_count() >=
           GetL0ThresholdSpeedupCompaction(
               mutable_cf_options.level0_file_num_compaction_trigger,
               mutable_cf_options.level0_slowdown_writes_trigger)) {
@@ -1061,8 +1194,10 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       }
       // If the DB recovers from delay conditions, we reward with reducing
       // double the slowdown ratio. This is to balance the long term slowdown
-      // increase signal.
-      if (needed_delay) {
+      // increase signal. Skipped while a predictive slowdown is active,
+      // since the shaped rate set above must not be scaled back up.
+      if (needed_delay &&
+          write_stall_cause != WriteStallCause::kPredictiveCompactionDebt) {
         uint64_t write_rate = write_controller->delayed_write_rate();
         write_controller->set_delayed_write_rate(static_cast<uint64_t>(
             static_cast<double>(write_rate) * kDelayRecoverSlowdownRatio));
@@ -1074,7 +1209,9 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
                                                                     4);
       }
     }
+    write_stall_cause_ = write_stall_cause;
     prev_compaction_needed_bytes_ = compaction_needed_bytes;
+    prev_recalc_time_micros_ = now_micros;
   }
   return write_stall_condition;
 }
@@ -1220,6 +1357,31 @@ Compaction* ColumnFamilyData::CompactRange(
   return result;
 }
 
+void ColumnFamilyData::TakePunchableBlobFiles(
+    std::vector<BlobFilePunchHoleJob>* jobs) {
+  assert(jobs);
+  if (pending_blob_punch_hole_jobs_.empty()) {
+    return;
+  }
+  // The oldest live Version is at the head of the circular list; if there
+  // are no live Versions at all, every queued job is safe to execute.
+  uint64_t oldest_version_number = std::numeric_limits<uint64_t>::max();
+  if (dummy_versions_->Next() != dummy_versions_) {
+    oldest_version_number = dummy_versions_->Next()->GetVersionNumber();
+  }
+  auto it = pending_blob_punch_hole_jobs_.begin();
+  while (it != pending_blob_punch_hole_jobs_.end()) {
+    if (oldest_version_number >= it->version_number) {
+      it->blob_file_path =
+          BlobFileName(ioptions_.cf_paths.front().path, it->blob_file_number);
+      jobs->push_back(std::move(*it));
+      it = pending_blob_punch_hole_jobs_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 SuperVersion* ColumnFamilyData::GetReferencedSuperVersion(DBImpl* db) {
   SuperVersion* sv = GetThreadLocalSuperVersion(db);
   sv->Ref();
@@ -1270,11 +1432,12 @@ SuperVersion* ColumnFamilyData::GetThreadLocalSuperVersion(DBImpl* db) {
       } else {
         sv_to_delete = sv;
       }
-    } else {
-      db->mutex()->Lock();
+      db->mutex()->Unlock();
     }
-    sv = super_version_->Ref();
-    db->mutex()->Unlock();
+    // Acquiring the current super version needs neither the DB mutex nor
+    // super_version_mutex_: the published pointer is read under epoch
+    // protection, which keeps installers from reclaiming it concurrently.
+    sv = RefPublishedSuperVersion();
 
     delete sv_to_delete;
   }
@@ -1282,6 +1445,110 @@ SuperVersion* ColumnFamilyData::GetThreadLocalSuperVersion(DBImpl* db) {
   return sv;
 }
 
+void ColumnFamilyData::PublishReadaheadInfo(const ReadaheadFileInfo& info) {
+  if (info.data_block_readahead_info.readahead_size > 0) {
+    learned_data_readahead_size_.store(
+        info.data_block_readahead_info.readahead_size,
+        std::memory_order_relaxed);
+    learned_data_num_file_reads_.store(
+        info.data_block_readahead_info.num_file_reads,
+        std::memory_order_relaxed);
+  }
+  if (info.index_block_readahead_info.readahead_size > 0) {
+    learned_index_readahead_size_.store(
+        info.index_block_readahead_info.readahead_size,
+        std::memory_order_relaxed);
+    learned_index_num_file_reads_.store(
+        info.index_block_readahead_info.num_file_reads,
+        std::memory_order_relaxed);
+  }
+}
+
+bool ColumnFamilyData::SeedReadaheadInfo(ReadaheadFileInfo* info) const {
+  bool learned = false;
+  size_t data_readahead =
+      learned_data_readahead_size_.load(std::memory_order_relaxed);
+  if (data_readahead > 0) {
+    info->data_block_readahead_info.readahead_size = data_readahead;
+    info->data_block_readahead_info.num_file_reads =
+        learned_data_num_file_reads_.load(std::memory_order_relaxed);
+    learned = true;
+  }
+  size_t index_readahead =
+      learned_index_readahead_size_.load(std::memory_order_relaxed);
+  if (index_readahead > 0) {
+    info->index_block_readahead_info.readahead_size = index_readahead;
+    info->index_block_readahead_info.num_file_reads =
+        learned_index_num_file_reads_.load(std::memory_order_relaxed);
+    learned = true;
+  }
+  return learned;
+}
+
+SuperVersion* ColumnFamilyData::RefPublishedSuperVersion() {
+  // Announce the epoch this acquisition runs under before loading the
+  // published pointer. InstallSuperVersion() keeps the reference a retired
+  // SuperVersion was published with until every announcement has advanced
+  // past its retirement epoch, so between the load and the Ref() below the
+  // SuperVersion's reference count cannot reach zero. The announcement may
+  // be stale by the time it lands (the epoch can advance concurrently);
+  // that only delays reclamation, it never permits it early.
+  uint64_t epoch = sv_epoch_.load(std::memory_order_acquire);
+  sv_epoch_slots_->Reset(
+      reinterpret_cast<void*>(static_cast<uintptr_t>(epoch)));
+  // The announcement must become visible before the pointer is loaded;
+  // pairs with the fence in ReapRetiredSuperVersions().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  SuperVersion* sv = published_super_version_.load(std::memory_order_acquire);
+  assert(sv != nullptr);
+  // The window between the load above and the Ref() below is where a
+  // concurrent InstallSuperVersion() can retire sv; the announced epoch is
+  // all that keeps it alive.
+  TEST_SYNC_POINT("ColumnFamilyData::RefPublishedSuperVersion:BeforeRef");
+  sv->Ref();
+  // Leave the critical section; a zero slot means quiescent.
+  sv_epoch_slots_->Reset(nullptr);
+  return sv;
+}
+
+void ColumnFamilyData::ReapRetiredSuperVersions(
+    SuperVersionContext* sv_context) {
+  autovector<SuperVersion*> past_grace;
+  {
+    MutexLock l(&super_version_mutex_);
+    if (retired_super_versions_.empty()) {
+      return;
+    }
+    // Pairs with the fence in RefPublishedSuperVersion(): a reader whose
+    // announcement is not visible here ordered its pointer load after this
+    // point, when these super versions were already unpublished, so it
+    // cannot be holding one of them.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t min_announced = std::numeric_limits<uint64_t>::max();
+    sv_epoch_slots_->Fold(
+        [](void* entry, void* res) {
+          uint64_t announced =
+              static_cast<uint64_t>(reinterpret_cast<uintptr_t>(entry));
+          uint64_t* min_epoch = static_cast<uint64_t*>(res);
+          if (announced < *min_epoch) {
+            *min_epoch = announced;
+          }
+        },
+        &min_announced);
+    while (!retired_super_versions_.empty() &&
+           retired_super_versions_.front().first < min_announced) {
+      past_grace.push_back(retired_super_versions_.front().second);
+      retired_super_versions_.pop_front();
+    }
+  }
+  for (SuperVersion* sv : past_grace) {
+    if (sv->Unref()) {
+      sv->Cleanup();
+      sv_context->superversions_to_free.push_back(sv);
+    }
+  }
+}
+
 bool ColumnFamilyData::ReturnThreadLocalSuperVersion(SuperVersion* sv) {
   assert(sv != nullptr);
   // Put the SuperVersion back
@@ -1313,9 +1580,20 @@ void ColumnFamilyData::InstallSuperVersion(
   new_superversion->mutable_cf_options = mutable_cf_options;
   new_superversion->Init(this, mem_, imm_.current(), current_);
   SuperVersion* old_superversion = super_version_;
-  super_version_ = new_superversion;
-  ++super_version_number_;
-  super_version_->version_number = super_version_number_;
+  uint64_t retired_epoch = 0;
+  {
+    // Publish the new super version to readers that ref it without the DB
+    // mutex (RefPublishedSuperVersion()).
+    MutexLock l(&super_version_mutex_);
+    super_version_ = new_superversion;
+    published_super_version_.store(new_superversion,
+                                   std::memory_order_release);
+    ++super_version_number_;
+    super_version_->version_number = super_version_number_;
+    // A reader that loaded old_superversion announced an epoch no newer
+    // than the pre-increment value captured here.
+    retired_epoch = sv_epoch_.fetch_add(1, std::memory_order_acq_rel);
+  }
   if (old_superversion == nullptr || old_superversion->current != current() ||
       old_superversion->mem != mem_ ||
       old_superversion->imm != imm_.current()) {
@@ -1324,9 +1602,11 @@ void ColumnFamilyData::InstallSuperVersion(
     // down is needed.
     super_version_->write_stall_condition =
         RecalculateWriteStallConditions(mutable_cf_options);
+    super_version_->write_stall_cause = write_stall_cause_;
   } else {
     super_version_->write_stall_condition =
         old_superversion->write_stall_condition;
+    super_version_->write_stall_cause = old_superversion->write_stall_cause;
   }
   if (old_superversion != nullptr) {
     // Reset SuperVersions cached in thread local storage.
@@ -1340,16 +1620,28 @@ void ColumnFamilyData::InstallSuperVersion(
       mem_->UpdateWriteBufferSize(mutable_cf_options.write_buffer_size);
     }
     if (old_superversion->write_stall_condition !=
-        new_superversion->write_stall_condition) {
+            new_superversion->write_stall_condition ||
+        old_superversion->write_stall_cause !=
+            new_superversion->write_stall_cause) {
+      const WriteController* write_controller =
+          column_family_set_->write_controller_;
       sv_context->PushWriteStallNotification(
           old_superversion->write_stall_condition,
-          new_superversion->write_stall_condition, GetName(), ioptions());
+          new_superversion->write_stall_condition,
+          new_superversion->write_stall_cause,
+          write_controller->NeedsDelay()
+              ? write_controller->delayed_write_rate()
+              : 0,
+          predicted_stall_duration_ms_, GetName(), ioptions());
     }
-    if (old_superversion->Unref()) {
-      old_superversion->Cleanup();
-      sv_context->superversions_to_free.push_back(old_superversion);
-    }
-  }
+    // Keep the publication reference on old_superversion until every
+    // reader has moved past the epoch at which it was retired. Dropping
+    // it here could let a lock-free reader Ref() a SuperVersion that is
+    // already being cleaned up.
+    MutexLock l(&super_version_mutex_);
+    retired_super_versions_.emplace_back(retired_epoch, old_superversion);
+  }
+  ReapRetiredSuperVersions(sv_context);
 }
 
 void ColumnFamilyData::ResetThreadLocalSuperVersions() {
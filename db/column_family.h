@@ -10,6 +10,8 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,7 +22,9 @@
 #include "db/table_properties_collector.h"
 #include "db/write_batch_internal.h"
 #include "db/write_controller.h"
+#include "file/readahead_file_info.h"
 #include "options/cf_options.h"
+#include "port/port.h"
 #include "rocksdb/compaction_job_stats.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
@@ -210,6 +214,7 @@ struct SuperVersion {
   // Version number of the current SuperVersion
   uint64_t version_number;
   WriteStallCondition write_stall_condition;
+  WriteStallCause write_stall_cause = WriteStallCause::kNone;
 
   // should be called outside the mutex
   SuperVersion() = default;
@@ -263,6 +268,22 @@ extern void GetIntTblPropCollectorFactory(
 
 class ColumnFamilySet;
 
+// The extents of the blobs in a blob file that became garbage during a
+// compaction. The regions can be deallocated by punching holes (see
+// ColumnFamilyOptions::blob_garbage_collection_punch_holes) once every
+// Version older than the one installed by the recording compaction is gone,
+// since from that point on no reader can reach the garbage blobs anymore.
+struct BlobFilePunchHoleJob {
+  uint64_t blob_file_number = 0;
+  // Version number of the Version installed by the recording compaction.
+  uint64_t version_number = 0;
+  // Path of the blob file; filled in when the job is handed over for
+  // execution.
+  std::string blob_file_path;
+  // Offset -> length of the garbage blob value regions.
+  std::map<uint64_t, uint64_t> extents;
+};
+
 // This class keeps all the data that a column family needs.
 // Most methods require DB mutex held, unless otherwise noted
 class ColumnFamilyData {
@@ -316,6 +337,11 @@ class ColumnFamilyData {
   // thread-safe
   const FileOptions* soptions() const;
   const ImmutableOptions* ioptions() const { return &ioptions_; }
+  // Statistics covering only this column family, or nullptr if per-CF
+  // statistics are not available (e.g. statistics are disabled altogether,
+  // or a custom Statistics implementation is in use). The data recorded here
+  // is included in the totals of the DB-wide statistics object.
+  Statistics* GetStatistics() const { return cf_stats_.get(); }
   // REQUIRES: DB mutex held
   // This returns the MutableCFOptions used by current SuperVersion
   // You should use this API to reference MutableCFOptions most of the time.
@@ -419,6 +445,17 @@ class ColumnFamilyData {
                            uint64_t max_file_num_to_ignore,
                            const std::string& trim_ts);
 
+  // Queue garbage blob extents recorded by a compaction for hole punching.
+  // REQUIRES: DB mutex held
+  void AddBlobPunchHoleJob(BlobFilePunchHoleJob&& job) {
+    pending_blob_punch_hole_jobs_.push_back(std::move(job));
+  }
+
+  // Move the queued punch hole jobs that are safe to execute (i.e. every
+  // Version older than the one that recorded them is gone) into *jobs.
+  // REQUIRES: DB mutex held
+  void TakePunchableBlobFiles(std::vector<BlobFilePunchHoleJob>* jobs);
+
   CompactionPicker* compaction_picker() { return compaction_picker_.get(); }
   // thread-safe
   const Comparator* user_comparator() const {
@@ -445,10 +482,41 @@ class ColumnFamilyData {
   // success and false on failure. It fails when the thread local storage
   // contains anything other than SuperVersion::kSVInUse flag.
   bool ReturnThreadLocalSuperVersion(SuperVersion* sv);
+  // Ref and return the latest installed SuperVersion without taking any
+  // lock: the caller's thread announces an epoch, loads the published
+  // pointer and refs it. InstallSuperVersion() retires the replaced
+  // SuperVersion with its publication reference still held and only drops
+  // that reference once every announcement has advanced past the
+  // retirement epoch (ReapRetiredSuperVersions()), so the ref taken here
+  // cannot race with the replaced SuperVersion being cleaned up.
+  // thread-safe
+  SuperVersion* RefPublishedSuperVersion();
   // thread-safe
   uint64_t GetSuperVersionNumber() const {
     return super_version_number_.load();
   }
+  // Ordinal of the newest data in this column family's table files; advanced
+  // whenever the file set gains data it did not logically contain before
+  // (flush, ingestion), but not when a compaction merely rewrites it. Used to
+  // validate RowLookupCache entries. thread-safe
+  uint64_t GetNewDataEpoch() const {
+    return new_data_epoch_.load(std::memory_order_acquire);
+  }
+  // REQUIRES: DB mutex held, called before the corresponding new
+  // SuperVersion is published so readers cannot see the new files under the
+  // old epoch.
+  void BumpNewDataEpoch() {
+    new_data_epoch_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Record the automatic readahead state a scan over this column family
+  // ramped up to, so later scans can start from it. Entries with a zero
+  // readahead size are ignored. thread-safe
+  void PublishReadaheadInfo(const ReadaheadFileInfo& info);
+  // Fill `info` with the readahead state published by previous scans.
+  // Returns true if anything was learned, false if `info` is untouched.
+  // thread-safe
+  bool SeedReadaheadInfo(ReadaheadFileInfo* info) const;
   // will return a pointer to SuperVersion* if previous SuperVersion
   // if its reference count is zero and needs deletion or nullptr if not
   // As argument takes a pointer to allocated SuperVersion to enable
@@ -467,12 +535,6 @@ class ColumnFamilyData {
   bool queued_for_flush() { return queued_for_flush_; }
   bool queued_for_compaction() { return queued_for_compaction_; }
 
-  enum class WriteStallCause {
-    kNone,
-    kMemtableLimit,
-    kL0FileCountLimit,
-    kPendingCompactionBytes,
-  };
   static std::pair<WriteStallCondition, WriteStallCause>
   GetWriteStallConditionAndCause(
       int num_unflushed_memtables, int num_l0_files,
@@ -547,6 +609,12 @@ class ColumnFamilyData {
 
   std::vector<std::string> GetDbPaths() const;
 
+  // Drop the publication reference of retired super versions once every
+  // announcement has advanced past their retirement epoch, handing the
+  // ones that reach a zero reference count to sv_context for deletion.
+  // REQUIRES: DB mutex held (needed by SuperVersion::Cleanup()).
+  void ReapRetiredSuperVersions(SuperVersionContext* sv_context);
+
   uint32_t id_;
   const std::string name_;
   Version* dummy_versions_;  // Head of circular doubly-linked list of versions.
@@ -560,6 +628,11 @@ class ColumnFamilyData {
   IntTblPropCollectorFactories int_tbl_prop_collector_factories_;
 
   const ColumnFamilyOptions initial_cf_options_;
+  // Per-CF statistics rolled up into the DB-wide statistics object, or
+  // nullptr if that object does not support children; see
+  // StatisticsImpl::CreateChildStatistics(). Declared before `ioptions_`,
+  // whose `stats` member points here when set.
+  const std::shared_ptr<Statistics> cf_stats_;
   const ImmutableOptions ioptions_;
   MutableCFOptions mutable_cf_options_;
 
@@ -577,11 +650,45 @@ class ColumnFamilyData {
   MemTableList imm_;
   SuperVersion* super_version_;
 
+  // Serializes publication of super_version_ between installers and
+  // guards retired_super_versions_. Lock-free readers
+  // (RefPublishedSuperVersion()) do not take it. Always acquired after
+  // the DB mutex when both are held.
+  mutable port::Mutex super_version_mutex_;
+
+  // Epoch-based protection for readers that ref the published
+  // SuperVersion without any lock (RefPublishedSuperVersion()). A reader
+  // announces the epoch it observed in its sv_epoch_slots_ entry (zero or
+  // absent entry means quiescent), then loads published_super_version_
+  // and refs it. A replaced SuperVersion keeps the reference it was
+  // published with on retired_super_versions_ until every announcement
+  // has advanced past its retirement epoch, so the reader's Ref() always
+  // acts on a SuperVersion whose reference count is still positive.
+  std::atomic<SuperVersion*> published_super_version_{nullptr};
+  std::atomic<uint64_t> sv_epoch_{1};
+  std::unique_ptr<ThreadLocalPtr> sv_epoch_slots_;
+
+  // (retirement epoch, SuperVersion) pairs, oldest first, still holding
+  // their publication reference. Guarded by super_version_mutex_.
+  std::deque<std::pair<uint64_t, SuperVersion*>> retired_super_versions_;
+
+  // Automatic readahead state observed at the end of recent scans
+  // (PublishReadaheadInfo()); new scans are seeded from it so they do not
+  // ramp up from the initial readahead size again. The values are hints
+  // stored with relaxed ordering, not a synchronization point.
+  std::atomic<size_t> learned_data_readahead_size_{0};
+  std::atomic<int64_t> learned_data_num_file_reads_{0};
+  std::atomic<size_t> learned_index_readahead_size_{0};
+  std::atomic<int64_t> learned_index_num_file_reads_{0};
+
   // An ordinal representing the current SuperVersion. Updated by
   // InstallSuperVersion(), i.e. incremented every time super_version_
   // changes.
   std::atomic<uint64_t> super_version_number_;
 
+  // See GetNewDataEpoch().
+  std::atomic<uint64_t> new_data_epoch_;
+
   // Thread's local copy of SuperVersion pointer
   // This needs to be destructed before mutex_
   std::unique_ptr<ThreadLocalPtr> local_sv_;
@@ -616,6 +723,18 @@ class ColumnFamilyData {
 
   uint64_t prev_compaction_needed_bytes_;
 
+  // Time of the last RecalculateWriteStallConditions() call; together with
+  // prev_compaction_needed_bytes_ this gives the recent compaction debt
+  // growth rate for predictive write throttling.
+  uint64_t prev_recalc_time_micros_;
+
+  // Cause of the stall condition computed by the last
+  // RecalculateWriteStallConditions() call, and a best-effort prediction
+  // of how long the slowdown will last (0 if unknown). Protected by the
+  // DB mutex.
+  WriteStallCause write_stall_cause_;
+  uint64_t predicted_stall_duration_ms_;
+
   // if the database was opened with 2pc enabled
   bool allow_2pc_;
 
@@ -633,6 +752,11 @@ class ColumnFamilyData {
   // a Version associated with this CFD
   std::shared_ptr<CacheReservationManager> file_metadata_cache_res_mgr_;
   bool mempurge_used_;
+
+  // Garbage blob extents recorded by compactions, waiting until it is safe
+  // to punch holes for them (see TakePunchableBlobFiles()). Protected by the
+  // DB mutex.
+  std::vector<BlobFilePunchHoleJob> pending_blob_punch_hole_jobs_;
 };
 
 // ColumnFamilySet has interesting thread-safety requirements
@@ -609,6 +609,99 @@ TEST_P(ColumnFamilyTest, CreateCFRaceWithGetAggProperty) {
 }
 #endif  // !ROCKSDB_LITE
 
+TEST_P(ColumnFamilyTest, LockFreeSuperVersionAcquireDuringInstall) {
+  Open();
+  ASSERT_OK(Put(0, "foo", "v1"));
+  ASSERT_OK(Flush(0));
+
+  // Install a new SuperVersion in the window between a lock-free reader
+  // loading the published pointer and taking its reference. The epoch
+  // scheme must keep the loaded (now retired) SuperVersion alive until the
+  // reader's Ref() lands.
+  std::atomic<bool> installed{false};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "ColumnFamilyData::RefPublishedSuperVersion:BeforeRef",
+      [&](void* /*arg*/) {
+        if (!installed.exchange(true)) {
+          // RefPublishedSuperVersion() holds no locks here, so the install
+          // can run inline on the reader's thread.
+          ASSERT_OK(Put(0, "foo", "v2"));
+          ASSERT_OK(Flush(0));
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // A fresh thread has no cached thread-local SuperVersion, so its first
+  // read goes through RefPublishedSuperVersion().
+  std::string value;
+  ROCKSDB_NAMESPACE::port::Thread reader([&] { value = Get(0, "foo"); });
+  reader.join();
+
+  ASSERT_TRUE(installed.load());
+  // The reader picked its read sequence after acquiring the SuperVersion,
+  // so it must observe the concurrently installed write.
+  ASSERT_EQ("v2", value);
+  ASSERT_EQ("v2", Get(0, "foo"));
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
+TEST_P(ColumnFamilyTest, LockFreeSuperVersionDrainOnClose) {
+  Open();
+  ASSERT_OK(Put(0, "foo", "v1"));
+  ASSERT_OK(Flush(0));
+
+  // Park a reader inside RefPublishedSuperVersion() with its epoch
+  // announced, then retire the SuperVersion it loaded. The announced epoch
+  // keeps the retired SuperVersion from being reaped while the reader is
+  // parked, so it is still pending when the DB closes.
+  std::atomic<bool> reader_parked{false};
+  std::atomic<bool> release_reader{false};
+  std::atomic<bool> parked_once{false};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "ColumnFamilyData::RefPublishedSuperVersion:BeforeRef",
+      [&](void* /*arg*/) {
+        if (!parked_once.exchange(true)) {
+          reader_parked.store(true);
+          while (!release_reader.load()) {
+            env_->SleepForMicroseconds(100);
+          }
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  std::string value;
+  ROCKSDB_NAMESPACE::port::Thread reader([&] { value = Get(0, "foo"); });
+  while (!reader_parked.load()) {
+    env_->SleepForMicroseconds(100);
+  }
+
+  ASSERT_OK(Put(0, "foo", "v2"));
+  ASSERT_OK(Flush(0));
+
+  release_reader.store(true);
+  reader.join();
+  ASSERT_EQ("v2", value);
+
+  // No further install runs before shutdown, so UnrefAndTryDelete() must
+  // drop the pending retired SuperVersion itself instead of waiting for a
+  // grace period that would never elapse.
+  size_t drained = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "ColumnFamilyData::UnrefAndTryDelete:DrainRetired", [&](void* arg) {
+        auto* retired =
+            static_cast<std::deque<std::pair<uint64_t, SuperVersion*>>*>(arg);
+        drained += retired->size();
+      });
+  Close();
+  ASSERT_EQ(1U, drained);
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 class FlushEmptyCFTestWithParam
     : public ColumnFamilyTestBase,
       virtual public testing::WithParamInterface<std::tuple<uint32_t, bool>> {
@@ -2735,6 +2828,54 @@ TEST_P(ColumnFamilyTest, WriteStallSingleColumnFamily) {
   ASSERT_EQ(kBaseRate / 1.25, GetDbDelayedWriteRate());
 }
 
+TEST_P(ColumnFamilyTest, PredictiveWriteThrottling) {
+  const uint64_t kBaseRate = 800000u;
+  db_options_.delayed_write_rate = kBaseRate;
+  db_options_.predictive_write_throttling = true;
+
+  Open({"default"});
+  ColumnFamilyData* cfd =
+      static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())->cfd();
+
+  VersionStorageInfo* vstorage = cfd->current()->storage_info();
+
+  MutableCFOptions mutable_cf_options(column_family_options_);
+
+  mutable_cf_options.level0_slowdown_writes_trigger = 20;
+  mutable_cf_options.level0_stop_writes_trigger = 10000;
+  mutable_cf_options.soft_pending_compaction_bytes_limit = 1ull << 30;
+  mutable_cf_options.hard_pending_compaction_bytes_limit = 1ull << 31;
+  mutable_cf_options.disable_auto_compactions = false;
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1000);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+
+  // The debt is growing, but slowly enough that the soft limit is more
+  // than the predictive horizon away: no shaping yet.
+  env_->SleepForMicroseconds(2000);
+  vstorage->TEST_set_estimated_compaction_needed_bytes(2000);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+
+  // The debt is now predicted to reach the soft limit almost immediately:
+  // writes get shaped although no limit has actually been crossed. The
+  // tiny remaining headroom maps to the minimum write rate.
+  env_->SleepForMicroseconds(2000);
+  vstorage->TEST_set_estimated_compaction_needed_bytes((1ull << 30) - 1000);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_EQ(16 * 1024u, GetDbDelayedWriteRate());
+
+  // Once the debt drains, shaping stops and full speed resumes.
+  env_->SleepForMicroseconds(2000);
+  vstorage->TEST_set_estimated_compaction_needed_bytes(1000);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+}
+
 TEST_P(ColumnFamilyTest, CompactionSpeedupSingleColumnFamily) {
   db_options_.max_background_compactions = 6;
   Open({"default"});
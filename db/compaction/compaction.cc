@@ -378,6 +378,15 @@ bool Compaction::IsTrivialMove() const {
   // a very expensive merge later on.
   // If start_level_== output_level_, the purpose is to force compaction
   // filter to be applied to that level, and thus cannot be a trivial move.
+  //
+  // Note that trivial moves are all-or-nothing per file: a file whose range
+  // overlaps the output level only at its edge is fully rewritten even
+  // though most of its data could conceptually be relinked. Re-cutting an
+  // SST by metadata (multiple virtual spans over one physical file) would
+  // need manifest support for span boundaries plus truncation of every read
+  // path (iterators, point lookups, file boundary invariants) at the span
+  // edges; with the current metadata a key outside the span would still be
+  // visible and could shadow a newer version in an upper level.
 
   // Check if start level have files with overlapping ranges
   if (start_level_ == 0 && input_vstorage_->level0_non_overlapping() == false &&
@@ -671,7 +680,11 @@ bool Compaction::ShouldFormSubcompactions() const {
     return output_level_ > 0;
   }
 
-  if (max_subcompactions_ <= 1) {
+  // With auto_tune_subcompactions, spare background threads may raise the
+  // effective limit above max_subcompactions while the backlog is high, so
+  // boundary generation is attempted even when max_subcompactions is 1.
+  if (max_subcompactions_ <= 1 &&
+      !cfd_->ioptions()->auto_tune_subcompactions) {
     return false;
   }
 
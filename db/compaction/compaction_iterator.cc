@@ -5,6 +5,7 @@
 
 #include "db/compaction/compaction_iterator.h"
 
+#include <array>
 #include <iterator>
 #include <limits>
 
@@ -280,6 +281,14 @@ bool CompactionIterator::InvokeFilterIfNeeded(bool* need_skip,
         value_type = CompactionFilter::ValueType::kValue;
       }
     }
+    if (CompactionFilter::Decision::kUndetermined == filter &&
+        ikey_.type == kTypeValue && compaction_filter_->CanFilterBatches()) {
+      filter = InvokeBatchedFilter();
+      if (!status_.ok()) {
+        valid_ = false;
+        return false;
+      }
+    }
     if (CompactionFilter::Decision::kUndetermined == filter) {
       filter = compaction_filter_->FilterV2(
           level_, filter_key, value_type,
@@ -365,6 +374,101 @@ bool CompactionIterator::InvokeFilterIfNeeded(bool* need_skip,
   return !error;
 }
 
+CompactionFilter::Decision CompactionIterator::InvokeBatchedFilter() {
+  assert(compaction_filter_ != nullptr);
+  assert(ikey_.type == kTypeValue);
+  // Consume the memoized decision for this entry if a previous batch
+  // covered it. Decisions are memoized in input order and the iterator only
+  // moves forward, so non-matching entries at the front belong to input
+  // entries that were resolved without consulting the filter and can be
+  // discarded.
+  while (!batched_filter_decisions_.empty()) {
+    BatchedFilterDecision& front = batched_filter_decisions_.front();
+    if (front.sequence == ikey_.sequence &&
+        cmp_->Equal(Slice(front.user_key), ikey_.user_key)) {
+      CompactionFilter::Decision decision = front.decision;
+      if (decision == CompactionFilter::Decision::kChangeValue) {
+        compaction_filter_value_ = std::move(front.new_value);
+      }
+      batched_filter_decisions_.pop_front();
+      return decision;
+    }
+    batched_filter_decisions_.pop_front();
+  }
+
+  // No memoized decision: collect a fresh batch starting from the current
+  // entry. Only the first version of each user key is included, since that
+  // is the version the filter is applied to; later versions as well as
+  // non-value entries take the per-key path.
+  std::array<Slice, kFilterBatchSize> keys;
+  std::array<Slice, kFilterBatchSize> values;
+  std::array<SequenceNumber, kFilterBatchSize> seqs;
+  std::array<std::string, kFilterBatchSize> new_values;
+  std::array<CompactionFilter::Decision, kFilterBatchSize> decisions;
+  keys[0] = ikey_.user_key;
+  values[0] = value_;
+  seqs[0] = ikey_.sequence;
+  size_t num_entries = 1;
+  size_t buffered_bytes = 0;
+  Slice prev_user_key = ikey_.user_key;
+  for (size_t ahead = 1; num_entries < kFilterBatchSize &&
+                         buffered_bytes < kFilterBatchMaxBytes;
+       ++ahead) {
+    Slice next_key;
+    Slice next_value;
+    if (!input_.LookAhead(ahead, &next_key, &next_value)) {
+      break;
+    }
+    buffered_bytes += next_key.size() + next_value.size();
+    ParsedInternalKey next_ikey;
+    if (!ParseInternalKey(next_key, &next_ikey, allow_data_in_errors_).ok()) {
+      // Let the regular read path surface the corruption
+      break;
+    }
+    if (next_ikey.type != kTypeValue) {
+      break;
+    }
+    if (cmp_->Equal(next_ikey.user_key, prev_user_key)) {
+      continue;
+    }
+    prev_user_key = next_ikey.user_key;
+    keys[num_entries] = next_ikey.user_key;
+    values[num_entries] = next_value;
+    seqs[num_entries] = next_ikey.sequence;
+    num_entries++;
+  }
+
+  compaction_filter_->FilterBatchV2(level_, num_entries, keys.data(),
+                                    values.data(), new_values.data(),
+                                    decisions.data());
+
+  for (size_t i = 0; i < num_entries; ++i) {
+    switch (decisions[i]) {
+      case CompactionFilter::Decision::kKeep:
+      case CompactionFilter::Decision::kRemove:
+      case CompactionFilter::Decision::kPurge:
+      case CompactionFilter::Decision::kChangeValue:
+      case CompactionFilter::Decision::kUndetermined:
+        break;
+      default:
+        status_ = Status::NotSupported(
+            "FilterBatchV2() may only return kKeep, kRemove, kPurge, "
+            "kChangeValue or kUndetermined");
+        return CompactionFilter::Decision::kUndetermined;
+    }
+  }
+
+  for (size_t i = 1; i < num_entries; ++i) {
+    batched_filter_decisions_.push_back(
+        BatchedFilterDecision{keys[i].ToString(), seqs[i], decisions[i],
+                              std::move(new_values[i])});
+  }
+  if (decisions[0] == CompactionFilter::Decision::kChangeValue) {
+    compaction_filter_value_ = std::move(new_values[0]);
+  }
+  return decisions[0];
+}
+
 void CompactionIterator::NextFromInput() {
   at_next_ = false;
   valid_ = false;
@@ -1198,9 +1302,22 @@ inline SequenceNumber CompactionIterator::findEarliestVisibleSnapshot(
     ROCKS_LOG_FATAL(info_log_,
                     "No snapshot left in findEarliestVisibleSnapshot");
   }
+  assert(prev_snapshot != nullptr);
+  if (snapshot_checker_ == nullptr && !snapshots_->empty()) {
+    // Constant-time resolution for the common cases where the sequence
+    // number falls outside the range covered by the snapshot list, which
+    // avoids the per-key binary search when the list is long.
+    if (in > snapshots_->back()) {
+      *prev_snapshot = snapshots_->back();
+      return kMaxSequenceNumber;
+    }
+    if (in <= snapshots_->front()) {
+      *prev_snapshot = 0;
+      return snapshots_->front();
+    }
+  }
   auto snapshots_iter = std::lower_bound(
       snapshots_->begin(), snapshots_->end(), in);
-  assert(prev_snapshot != nullptr);
   if (snapshots_iter == snapshots_->begin()) {
     *prev_snapshot = 0;
   } else {
@@ -35,13 +35,31 @@ class SequenceIterWrapper : public InternalIterator {
       : icmp_(cmp),
         inner_iter_(iter),
         need_count_entries_(need_count_entries) {}
-  bool Valid() const override { return inner_iter_->Valid(); }
+  bool Valid() const override {
+    return !lookahead_.empty() || inner_iter_->Valid();
+  }
   Status status() const override { return inner_iter_->status(); }
   void Next() override {
     num_itered_++;
-    inner_iter_->Next();
+    if (!lookahead_.empty()) {
+      // Slices handed out for the entry being left behind may still be
+      // referenced until the stream advances again, so park it instead of
+      // destroying it right away.
+      consumed_.push_back(std::move(lookahead_.front()));
+      lookahead_.pop_front();
+    } else {
+      consumed_.clear();
+      inner_iter_->Next();
+    }
   }
   void Seek(const Slice& target) override {
+    while (!lookahead_.empty() &&
+           icmp_.Compare(Slice(lookahead_.front().key), target) < 0) {
+      Next();
+    }
+    if (!lookahead_.empty()) {
+      return;
+    }
     if (!need_count_entries_) {
       inner_iter_->Seek(target);
     } else {
@@ -53,8 +71,41 @@ class SequenceIterWrapper : public InternalIterator {
       }
     }
   }
-  Slice key() const override { return inner_iter_->key(); }
-  Slice value() const override { return inner_iter_->value(); }
+  Slice key() const override {
+    return lookahead_.empty() ? inner_iter_->key()
+                              : Slice(lookahead_.front().key);
+  }
+  Slice value() const override {
+    return lookahead_.empty() ? inner_iter_->value()
+                              : Slice(lookahead_.front().value);
+  }
+
+  // Peeks idx entries ahead of the current position without disturbing the
+  // stream: idx 0 is the current entry. Returns false once the input is
+  // exhausted. Looked-ahead entries are copied into a buffer and served
+  // back by key()/value()/Next() in order.
+  bool LookAhead(size_t idx, Slice* key, Slice* value) {
+    if (idx == 0) {
+      if (!Valid()) {
+        return false;
+      }
+      *key = this->key();
+      *value = this->value();
+      return true;
+    }
+    // Entry 0 must be buffered before the inner iterator moves off of it.
+    if (lookahead_.empty() && !BufferInnerEntry()) {
+      return false;
+    }
+    while (lookahead_.size() <= idx) {
+      if (!BufferInnerEntry()) {
+        return false;
+      }
+    }
+    *key = Slice(lookahead_[idx].key);
+    *value = Slice(lookahead_[idx].value);
+    return true;
+  }
 
   // Unused InternalIterator methods
   void SeekToFirst() override { assert(false); }
@@ -65,8 +116,27 @@ class SequenceIterWrapper : public InternalIterator {
   uint64_t num_itered() const { return num_itered_; }
 
  private:
+  struct BufferedEntry {
+    std::string key;
+    std::string value;
+  };
+
+  bool BufferInnerEntry() {
+    if (!inner_iter_->Valid()) {
+      return false;
+    }
+    lookahead_.push_back(BufferedEntry{inner_iter_->key().ToString(),
+                                       inner_iter_->value().ToString()});
+    inner_iter_->Next();
+    return true;
+  }
+
   InternalKeyComparator icmp_;
   InternalIterator* inner_iter_;  // not owned
+  // Entries read ahead of the current position by LookAhead(), and entries
+  // already consumed but kept alive for slices still referencing them.
+  std::deque<BufferedEntry> lookahead_;
+  std::deque<BufferedEntry> consumed_;
   uint64_t num_itered_ = 0;
   bool need_count_entries_;
 };
@@ -282,6 +352,14 @@ class CompactionIterator {
   // Return true on success, false on failures (e.g.: kIOError).
   bool InvokeFilterIfNeeded(bool* need_skip, Slice* skip_until);
 
+  // Invoke the compaction filter in batches (see
+  // CompactionFilter::FilterBatchV2): consume the memoized decision for the
+  // current entry if a previous batch covered it, otherwise look ahead in
+  // the input, hand a batch of plain-value entries to the filter and
+  // memoize the decisions. Sets status_ and returns kUndetermined if the
+  // filter returned a decision the batch API does not allow.
+  CompactionFilter::Decision InvokeBatchedFilter();
+
   // Given a sequence number, return the sequence number of the
   // earliest snapshot that this sequence number is visible in.
   // The snapshots themselves are arranged in ascending order of
@@ -417,6 +495,24 @@ class CompactionIterator {
   PinnableSlice blob_value_;
   std::string compaction_filter_value_;
   InternalKey compaction_filter_skip_until_;
+
+  // Max number of entries handed to CompactionFilter::FilterBatchV2() in
+  // one call, and a bound on the bytes buffered while looking ahead for
+  // them.
+  static constexpr size_t kFilterBatchSize = 32;
+  static constexpr size_t kFilterBatchMaxBytes = 1 << 20;
+
+  // Decisions memoized by InvokeBatchedFilter() for upcoming entries, in
+  // input order. Keyed by user key and sequence number so that entries
+  // resolved without consulting the filter (e.g. shadowed versions) can be
+  // skipped over.
+  struct BatchedFilterDecision {
+    std::string user_key;
+    SequenceNumber sequence;
+    CompactionFilter::Decision decision;
+    std::string new_value;
+  };
+  std::deque<BatchedFilterDecision> batched_filter_decisions_;
   // "level_ptrs" holds indices that remember which file of an associated
   // level we were last checking during the last call to compaction->
   // KeyNotExistsBeyondOutputLevel(). This allows future calls to the function
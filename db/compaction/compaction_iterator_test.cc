@@ -539,6 +539,73 @@ TEST_P(CompactionIteratorTest, CompactionFilterSkipUntil) {
   ASSERT_EQ(expected_actions, iter_->log);
 }
 
+TEST_P(CompactionIteratorTest, BatchedCompactionFilter) {
+  class Filter : public CompactionFilter {
+   public:
+    bool CanFilterBatches() const override { return true; }
+
+    void FilterBatchV2(int /*level*/, size_t num_entries, const Slice* keys,
+                       const Slice* values, std::string* new_values,
+                       Decision* decisions) const override {
+      batch_sizes.push_back(num_entries);
+      for (size_t i = 0; i < num_entries; ++i) {
+        batched_keys.push_back(keys[i].ToString());
+        std::string v = values[i].ToString();
+        if (v.rfind("del", 0) == 0) {
+          decisions[i] = Decision::kRemove;
+        } else if (v.rfind("chg", 0) == 0) {
+          new_values[i] = "c-new";
+          decisions[i] = Decision::kChangeValue;
+        } else if (keys[i] == Slice("d")) {
+          // Defer this entry to the per-key FilterV2() path
+          decisions[i] = Decision::kUndetermined;
+        } else {
+          decisions[i] = Decision::kKeep;
+        }
+      }
+    }
+
+    Decision FilterV2(int /*level*/, const Slice& key, ValueType t,
+                      const Slice& /*existing_value*/,
+                      std::string* /*new_value*/,
+                      std::string* /*skip_until*/) const override {
+      EXPECT_EQ(ValueType::kValue, t);
+      per_key_keys.push_back(key.ToString());
+      return Decision::kKeep;
+    }
+
+    const char* Name() const override {
+      return "CompactionIteratorTest.BatchedCompactionFilter::Filter";
+    }
+
+    mutable std::vector<size_t> batch_sizes;
+    mutable std::vector<std::string> batched_keys;
+    mutable std::vector<std::string> per_key_keys;
+  };
+
+  Filter filter;
+  RunTest(
+      {test::KeyStr("a", 50, kTypeValue),  // keep
+       test::KeyStr("b", 60, kTypeValue),  // remove
+       test::KeyStr("b", 40, kTypeValue),  // shadowed, not filtered
+       test::KeyStr("c", 35, kTypeValue),  // value changed
+       test::KeyStr("d", 70, kTypeValue),  // batch defers to FilterV2
+       test::KeyStr("e", 99, kTypeValue)},  // remove
+      {"av", "del-b", "bv40", "chg-c", "dv", "del-e"},
+      {test::KeyStr("a", 50, kTypeValue), test::KeyStr("b", 60, kTypeDeletion),
+       test::KeyStr("c", 35, kTypeValue), test::KeyStr("d", 70, kTypeValue),
+       test::KeyStr("e", 99, kTypeDeletion)},
+      {"av", "", "c-new", "dv", ""}, kMaxSequenceNumber /*last_committed_seq*/,
+      nullptr /*merge_operator*/, &filter);
+
+  // One batch covering the five distinct user keys; the shadowed b@40 never
+  // reaches the filter, and only "d" falls back to the per-key path.
+  ASSERT_EQ(std::vector<size_t>({5}), filter.batch_sizes);
+  ASSERT_EQ(std::vector<std::string>({"a", "b", "c", "d", "e"}),
+            filter.batched_keys);
+  ASSERT_EQ(std::vector<std::string>({"d"}), filter.per_key_keys);
+}
+
 TEST_P(CompactionIteratorTest, ShuttingDownInFilter) {
   NoMergingMergeOp merge_op;
   StallingFilter filter;
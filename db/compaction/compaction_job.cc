@@ -97,6 +97,8 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "ChangeTemperature";
     case CompactionReason::kForcedBlobGC:
       return "ForcedBlobGC";
+    case CompactionReason::kTtlFileDeletion:
+      return "TtlFileDeletion";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -381,8 +383,8 @@ void CompactionJob::ReleaseSubcompactionResources() {
     return;
   }
   // The number of reserved threads becomes larger than 0 only if the
-  // compaction prioity is round robin and there is no sufficient
-  // sub-compactions available
+  // compaction priority is round robin or auto_tune_subcompactions claimed
+  // spare threads, and there is no sufficient sub-compactions available
 
   // The scheduled compaction must be no less than 1 + extra number
   // subcompactions using acquired resources since this compaction job has not
@@ -432,7 +434,8 @@ void CompactionJob::GenSubcompactionBoundaries() {
   auto* c = compact_->compaction;
   if (c->max_subcompactions() <= 1 &&
       !(c->immutable_options()->compaction_pri == kRoundRobin &&
-        c->immutable_options()->compaction_style == kCompactionStyleLevel)) {
+        c->immutable_options()->compaction_style == kCompactionStyleLevel) &&
+      !c->immutable_options()->auto_tune_subcompactions) {
     return;
   }
   auto* cfd = c->column_family_data();
@@ -488,15 +491,26 @@ void CompactionJob::GenSubcompactionBoundaries() {
                                                        b.user_key, true) < 0;
       });
 
-  // Remove duplicated entries from boundaries.
-  all_anchors.erase(
-      std::unique(all_anchors.begin(), all_anchors.end(),
-                  [cfd_comparator](TableReader::Anchor& a,
-                                   TableReader::Anchor& b) -> bool {
-                    return cfd_comparator->CompareWithoutTimestamp(
-                               a.user_key, true, b.user_key, true) == 0;
-                  }),
-      all_anchors.end());
+  // Remove duplicated entries from boundaries. Anchors with the same user
+  // key describe the same partition point, so merge their range sizes into
+  // a single entry. Simply dropping the duplicates would lose their sizes
+  // from the cumulative walk below, which starves wholly-overlapping input
+  // runs (e.g. universal L0 runs holding updates of the same keys) of
+  // subcompactions.
+  size_t num_unique = 0;
+  for (size_t i = 0; i < all_anchors.size(); i++) {
+    if (num_unique > 0 && cfd_comparator->CompareWithoutTimestamp(
+                              all_anchors[num_unique - 1].user_key, true,
+                              all_anchors[i].user_key, true) == 0) {
+      all_anchors[num_unique - 1].range_size += all_anchors[i].range_size;
+    } else {
+      if (num_unique != i) {
+        all_anchors[num_unique] = std::move(all_anchors[i]);
+      }
+      num_unique++;
+    }
+  }
+  all_anchors.erase(all_anchors.begin() + num_unique, all_anchors.end());
 
   // Get the number of planned subcompactions, may update reserve threads
   // and update extra_num_subcompaction_threads_reserved_ for round-robin
@@ -529,6 +543,36 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   } else {
     num_planned_subcompactions = GetSubcompactionsLimit();
+    if (db_options_.auto_tune_subcompactions &&
+        bg_compaction_scheduled_ != nullptr &&
+        bg_bottom_compaction_scheduled_ != nullptr) {
+      // Feedback scheduling: while this column family's compaction backlog
+      // is above the soft pending-bytes setpoint, claim idle background
+      // compaction threads as extra subcompactions. Extra threads are given
+      // back by ShrinkSubcompactionResources() below when fewer ranges
+      // materialize and by ReleaseSubcompactionResources() when the job
+      // finishes, so the parallelism follows the backlog.
+      const uint64_t pending_bytes =
+          v->storage_info()->estimated_compaction_needed_bytes();
+      const uint64_t setpoint =
+          c->mutable_cf_options()->soft_pending_compaction_bytes_limit;
+      if (setpoint > 0 && pending_bytes > setpoint) {
+        uint64_t max_output_size = c->max_output_file_size();
+        if (max_output_size == 0) {
+          max_output_size = 1;
+        }
+        // The number of expected output files bounds how many balanced
+        // ranges the anchor partitioning below can produce.
+        const uint64_t num_expected_outputs =
+            c->CalculateTotalInputSize() / max_output_size + 1;
+        if (num_expected_outputs > num_planned_subcompactions) {
+          AcquireSubcompactionResources(
+              (int)(num_expected_outputs - num_planned_subcompactions));
+          num_planned_subcompactions =
+              std::min(num_expected_outputs, GetSubcompactionsLimit());
+        }
+      }
+    }
   }
 
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:0",
@@ -569,6 +613,104 @@ void CompactionJob::GenSubcompactionBoundaries() {
                extra_num_subcompaction_threads_reserved_));
 }
 
+void CompactionJob::PrepopulateOutputBlockCache() {
+  Compaction* c = compact_->compaction;
+  ColumnFamilyData* cfd = c->column_family_data();
+  const Comparator* ucmp = cfd->user_comparator();
+  ReadOptions read_options;
+
+  // Collect the key ranges whose data blocks are still resident in the
+  // block cache, across all input files. An empty start key means the range
+  // starts at the beginning of its file, so substitute the file's smallest
+  // user key to make the ranges comparable across files.
+  std::vector<TableReader::CachedKeyRange> hot_ranges;
+  for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
+    const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      FileMetaData* f = flevel->files[i].file_metadata;
+      size_t old_size = hot_ranges.size();
+      Status s = cfd->table_cache()->ApproximateCachedKeyRanges(
+          read_options, cfd->internal_comparator(), f->fd, hot_ranges);
+      if (!s.ok()) {
+        ROCKS_LOG_WARN(db_options_.info_log,
+                       "[%s] [JOB %d] Failed to probe cached key ranges of "
+                       "table #%" PRIu64 ": %s",
+                       cfd->GetName().c_str(), job_id_, f->fd.GetNumber(),
+                       s.ToString().c_str());
+        continue;
+      }
+      for (size_t r = old_size; r < hot_ranges.size(); r++) {
+        if (hot_ranges[r].start_user_key.empty()) {
+          hot_ranges[r].start_user_key = f->smallest.user_key().ToString();
+        }
+      }
+    }
+  }
+  if (hot_ranges.empty()) {
+    return;
+  }
+
+  // Sort by start key and merge overlapping ranges so each output block is
+  // inserted at most once.
+  std::sort(hot_ranges.begin(), hot_ranges.end(),
+            [ucmp](const TableReader::CachedKeyRange& a,
+                   const TableReader::CachedKeyRange& b) {
+              return ucmp->Compare(a.start_user_key, b.start_user_key) < 0;
+            });
+  std::vector<TableReader::CachedKeyRange> merged;
+  for (auto& range : hot_ranges) {
+    if (!merged.empty() && ucmp->Compare(range.start_user_key,
+                                         merged.back().end_user_key) <= 0) {
+      if (ucmp->Compare(range.end_user_key, merged.back().end_user_key) > 0) {
+        merged.back().end_user_key = std::move(range.end_user_key);
+      }
+    } else {
+      merged.push_back(std::move(range));
+    }
+  }
+
+  // Load the blocks of each output file that overlap a hot range into the
+  // block cache. All of this is best effort: a failure only means the range
+  // warms up through user reads as it would without this pass.
+  for (const auto& state : compact_->sub_compact_states) {
+    for (const auto& output : state.GetOutputs()) {
+      const FileMetaData& meta = output.meta;
+      Cache::Handle* handle = nullptr;
+      TableReader* reader = meta.fd.table_reader;
+      if (reader == nullptr) {
+        Status s = cfd->table_cache()->FindTable(
+            read_options, file_options_, cfd->internal_comparator(), meta.fd,
+            &handle, c->mutable_cf_options()->prefix_extractor);
+        if (!s.ok()) {
+          continue;
+        }
+        reader = cfd->table_cache()->GetTableReaderFromHandle(handle);
+      }
+      for (const auto& range : merged) {
+        if (ucmp->Compare(range.end_user_key, meta.smallest.user_key()) < 0) {
+          continue;
+        }
+        if (ucmp->Compare(range.start_user_key, meta.largest.user_key()) > 0) {
+          // Ranges are sorted, so nothing later can overlap this file.
+          break;
+        }
+        InternalKey begin(range.start_user_key, kMaxSequenceNumber,
+                          kValueTypeForSeek);
+        InternalKey end(range.end_user_key, 0, static_cast<ValueType>(0));
+        Slice begin_slice = begin.Encode();
+        Slice end_slice = end.Encode();
+        Status s = reader->Prefetch(&begin_slice, &end_slice);
+        if (!s.ok()) {
+          break;
+        }
+      }
+      if (handle != nullptr) {
+        cfd->table_cache()->ReleaseHandle(handle);
+      }
+    }
+  }
+}
+
 Status CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -738,6 +880,21 @@ Status CompactionJob::Run() {
     }
   }
 
+  if (status.ok()) {
+    const auto* bbto =
+        compact_->compaction->immutable_options()
+            ->table_factory->GetOptions<BlockBasedTableOptions>();
+    if (bbto != nullptr &&
+        bbto->prepopulate_block_cache ==
+            BlockBasedTableOptions::PrepopulateBlockCache::
+                kFlushAndCompaction &&
+        bbto->block_cache != nullptr) {
+      // Warm the block cache with the output blocks covering key ranges
+      // whose input blocks were cached, before the inputs go away.
+      PrepopulateOutputBlockCache();
+    }
+  }
+
   ReleaseSubcompactionResources();
   TEST_SYNC_POINT("CompactionJob::ReleaseSubcompactionResources:0");
   TEST_SYNC_POINT("CompactionJob::ReleaseSubcompactionResources:1");
@@ -1047,6 +1204,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   read_options.verify_checksums = true;
   read_options.fill_cache = false;
   read_options.rate_limiter_priority = GetRateLimiterPriority();
+  // Keep compaction input readahead reads in flight ahead of the merge
+  // thread instead of issuing them synchronously per exhausted buffer.
+  read_options.async_io = db_options_.use_async_io_for_compaction;
   // Compaction iterators shouldn't be confined to a single prefix.
   // Compactions use Seek() for
   // (a) concurrent compactions,
@@ -1104,7 +1264,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   std::unique_ptr<InternalIterator> blob_counter;
 
   if (sub_compact->compaction->DoesInputReferenceBlobFiles()) {
-    BlobGarbageMeter* meter = sub_compact->Current().CreateBlobGarbageMeter();
+    BlobGarbageMeter* meter = sub_compact->Current().CreateBlobGarbageMeter(
+        sub_compact->compaction->mutable_cf_options()
+            ->blob_garbage_collection_punch_holes);
     blob_counter = std::make_unique<BlobCountingIterator>(input, meter);
     input = blob_counter.get();
   }
@@ -1666,9 +1828,43 @@ Status CompactionJob::InstallCompactionResults(
     }
   }
 
-  return versions_->LogAndApply(compaction->column_family_data(),
-                                mutable_cf_options, edit, db_mutex_,
-                                db_directory_);
+  const Status s = versions_->LogAndApply(compaction->column_family_data(),
+                                          mutable_cf_options, edit, db_mutex_,
+                                          db_directory_);
+
+  if (s.ok() && mutable_cf_options.blob_garbage_collection_punch_holes) {
+    // Queue the extents of the garbage blobs for hole punching. They become
+    // eligible once every Version older than the one just installed is gone,
+    // at which point no reader can reach them anymore.
+    ColumnFamilyData* cfd = compaction->column_family_data();
+    const uint64_t version_number = cfd->current()->GetVersionNumber();
+
+    std::unordered_map<uint64_t, std::map<uint64_t, uint64_t>> garbage_extents;
+
+    for (const auto& sub_compact : compact_->sub_compact_states) {
+      const BlobGarbageMeter* meter =
+          sub_compact.Current().GetBlobGarbageMeter();
+      if (!meter) {
+        continue;
+      }
+      for (const auto& pair : meter->flows()) {
+        const auto& extents = pair.second.GetGarbageExtents();
+        if (!extents.empty()) {
+          garbage_extents[pair.first].insert(extents.begin(), extents.end());
+        }
+      }
+    }
+
+    for (auto& pair : garbage_extents) {
+      BlobFilePunchHoleJob job;
+      job.blob_file_number = pair.first;
+      job.version_number = version_number;
+      job.extents = std::move(pair.second);
+      cfd->AddBlobPunchHoleJob(std::move(job));
+    }
+  }
+
+  return s;
 }
 
 void CompactionJob::RecordCompactionIOStats() {
@@ -1825,6 +2021,16 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
       0 /* oldest_key_time */, current_time, db_id_, db_session_id_,
       sub_compact->compaction->max_output_file_size(), file_number);
 
+  if (tboptions.compression_opts.share_compaction_dict &&
+      tboptions.compression_opts.max_dict_bytes > 0) {
+    // Share one trained dictionary across the output files of this
+    // sub-compaction; the first output trains it, later outputs reuse it.
+    if (sub_compact->compression_dict_cache == nullptr) {
+      sub_compact->compression_dict_cache = std::make_shared<std::string>();
+    }
+    tboptions.compression_dict_cache = sub_compact->compression_dict_cache;
+  }
+
   outputs.NewBuilder(tboptions);
 
   LogFlush(db_options_.info_log);
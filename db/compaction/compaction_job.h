@@ -60,6 +60,7 @@ class VersionEdit;
 class VersionSet;
 
 class SubcompactionState;
+struct CompactionServiceOutputFile;
 
 // CompactionJob is responsible for executing the compaction. Each (manual or
 // automated) compaction corresponds to a CompactionJob object, and usually
@@ -227,6 +228,13 @@ class CompactionJob {
   // consecutive groups such that each group has a similar size.
   void GenSubcompactionBoundaries();
 
+  // Best-effort warming of the block cache for compaction outputs. Probes
+  // which key ranges of the input files still have data blocks resident in
+  // the block cache and inserts the output blocks covering those ranges, so
+  // hot ranges stay warm across the compaction. Only used when
+  // prepopulate_block_cache is kFlushAndCompaction.
+  void PrepopulateOutputBlockCache();
+
   // Get the number of planned subcompactions based on max_subcompactions and
   // extra reserved resources
   uint64_t GetSubcompactionsLimit();
@@ -250,6 +258,13 @@ class CompactionJob {
   CompactionServiceJobStatus ProcessKeyValueCompactionWithCompactionService(
       SubcompactionState* sub_compact);
 
+  // Move one remote compaction output file from `src_file` to its table file
+  // location in the output level and register its metadata as an output of
+  // `sub_compact`.
+  Status InstallRemoteCompactionOutputFile(
+      SubcompactionState* sub_compact, const CompactionServiceOutputFile& file,
+      const std::string& src_file);
+
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
 
@@ -420,6 +435,11 @@ struct CompactionServiceOutputFile {
         paranoid_hash(_paranoid_hash),
         marked_for_compaction(_marked_for_compaction),
         unique_id(std::move(_unique_id)) {}
+
+  // serialization interface to read and write the object
+  static Status Read(const std::string& data_str,
+                     CompactionServiceOutputFile* obj);
+  Status Write(std::string* output);
 };
 
 // CompactionServiceResult contains the compaction result from a different db
@@ -44,6 +44,12 @@ Status CompactionOutputs::Finish(const Status& intput_status,
   if (s.ok()) {
     meta->fd.file_size = current_bytes;
     meta->marked_for_compaction = builder_->NeedCompact();
+    const TableProperties tp = builder_->GetTableProperties();
+    if (tp.data_size < current_bytes) {
+      // Size of the meta blocks and footer, used to size the tail prefetch
+      // when the file is opened later.
+      meta->fd.tail_size = current_bytes - tp.data_size;
+    }
   }
   current_output().finished = true;
   stats_.bytes_written += current_bytes;
@@ -87,9 +87,9 @@ class CompactionOutputs {
 
   bool HasBlobFileAdditions() const { return !blob_file_additions_.empty(); }
 
-  BlobGarbageMeter* CreateBlobGarbageMeter() {
+  BlobGarbageMeter* CreateBlobGarbageMeter(bool track_extents) {
     assert(!is_penultimate_level_);
-    blob_garbage_meter_ = std::make_unique<BlobGarbageMeter>();
+    blob_garbage_meter_ = std::make_unique<BlobGarbageMeter>(track_extents);
     return blob_garbage_meter_.get();
   }
 
@@ -15,6 +15,7 @@
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "logging/logging.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -24,9 +25,15 @@ bool LevelCompactionPicker::NeedsCompaction(
   if (!vstorage->ExpiredTtlFiles().empty()) {
     return true;
   }
+  if (!vstorage->BottommostExpiredTtlFiles().empty()) {
+    return true;
+  }
   if (!vstorage->FilesMarkedForPeriodicCompaction().empty()) {
     return true;
   }
+  if (!vstorage->FilesMarkedForTemperatureChange().empty()) {
+    return true;
+  }
   if (!vstorage->BottommostFilesMarkedForCompaction().empty()) {
     return true;
   }
@@ -273,6 +280,14 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     compaction_reason_ = CompactionReason::kForcedBlobGC;
     return;
   }
+
+  // Temperature change: rewrite cooled files in place so the file system
+  // can move them to the appropriate tier.
+  PickFileToCompact(vstorage_->FilesMarkedForTemperatureChange(), false);
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kChangeTemperature;
+    return;
+  }
 }
 
 bool LevelCompactionBuilder::SetupOtherL0FilesIfNeeded() {
@@ -489,7 +504,9 @@ Compaction* LevelCompactionBuilder::GetCompaction() {
       GetCompressionType(vstorage_, mutable_cf_options_, output_level_,
                          vstorage_->base_level()),
       GetCompressionOptions(mutable_cf_options_, vstorage_, output_level_),
-      Temperature::kUnknown,
+      compaction_reason_ == CompactionReason::kChangeTemperature
+          ? mutable_cf_options_.cold_file_temperature
+          : Temperature::kUnknown,
       /* max_subcompactions */ 0, std::move(grandparents_), is_manual_,
       /* trim_ts */ "", start_level_score_, false /* deletion_compaction */,
       /* l0_files_might_overlap */ start_level_ == 0 && !is_l0_trivial_move_,
@@ -799,10 +816,60 @@ bool LevelCompactionBuilder::PickIntraL0Compaction() {
 }
 }  // namespace
 
+Compaction* LevelCompactionPicker::PickExpiredFilesDeletion(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  assert(mutable_cf_options.ttl > 0);
+  assert(mutable_cf_options.ttl_delete_expired_files);
+
+  const int last_level = vstorage->num_levels() - 1;
+  std::vector<CompactionInputFiles> inputs;
+  inputs.emplace_back();
+  inputs[0].level = last_level;
+
+  for (const auto& level_file : vstorage->BottommostExpiredTtlFiles()) {
+    FileMetaData* f = level_file.second;
+    assert(level_file.first == last_level);
+    if (f->being_compacted) {
+      continue;
+    }
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] Level TTL: dropping expired file %" PRIu64
+                     ", creation time %" PRIu64,
+                     cf_name.c_str(), f->fd.GetNumber(),
+                     f->TryGetFileCreationTime());
+    inputs[0].files.push_back(f);
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+
+  Compaction* c = new Compaction(
+      vstorage, ioptions_, mutable_cf_options, mutable_db_options,
+      std::move(inputs), last_level, 0 /* target_file_size */,
+      0 /* max_compaction_bytes */, 0 /* output_path_id */, kNoCompression,
+      mutable_cf_options.compression_opts, Temperature::kUnknown,
+      /* max_subcompactions */ 0, {}, /* is manual */ false, /* trim_ts */ "",
+      vstorage->CompactionScore(0), /* is deletion compaction */ true,
+      /* l0_files_might_overlap */ false,
+      CompactionReason::kTtlFileDeletion);
+  RegisterCompaction(c);
+  vstorage->ComputeCompactionScore(ioptions_, mutable_cf_options);
+  return c;
+}
+
 Compaction* LevelCompactionPicker::PickCompaction(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
     LogBuffer* log_buffer, SequenceNumber earliest_mem_seqno) {
+  if (!vstorage->BottommostExpiredTtlFiles().empty()) {
+    Compaction* c = PickExpiredFilesDeletion(
+        cf_name, mutable_cf_options, mutable_db_options, vstorage, log_buffer);
+    if (c != nullptr) {
+      return c;
+    }
+  }
   LevelCompactionBuilder builder(cf_name, vstorage, earliest_mem_seqno, this,
                                  log_buffer, mutable_cf_options, ioptions_,
                                  mutable_db_options);
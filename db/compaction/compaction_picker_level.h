@@ -28,6 +28,16 @@ class LevelCompactionPicker : public CompactionPicker {
 
   virtual bool NeedsCompaction(
       const VersionStorageInfo* vstorage) const override;
+
+ private:
+  // Drop bottommost files whose entries have all outlived the TTL without
+  // rewriting them (see
+  // AdvancedColumnFamilyOptions::ttl_delete_expired_files). Returns a
+  // deletion compaction, or nullptr if there is nothing to drop.
+  Compaction* PickExpiredFilesDeletion(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer);
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -102,7 +102,8 @@ class CompactionPickerTest : public testing::Test {
            SequenceNumber smallest_seq = 100, SequenceNumber largest_seq = 100,
            size_t compensated_file_size = 0, bool marked_for_compact = false,
            Temperature temperature = Temperature::kUnknown,
-           uint64_t oldest_ancestor_time = kUnknownOldestAncesterTime) {
+           uint64_t oldest_ancestor_time = kUnknownOldestAncesterTime,
+           uint64_t file_creation_time = kUnknownFileCreationTime) {
     VersionStorageInfo* vstorage;
     if (temp_vstorage_) {
       vstorage = temp_vstorage_.get();
@@ -120,6 +121,7 @@ class CompactionPickerTest : public testing::Test {
     f->compensated_file_size =
         (compensated_file_size != 0) ? compensated_file_size : file_size;
     f->oldest_ancester_time = oldest_ancestor_time;
+    f->file_creation_time = file_creation_time;
     vstorage->AddFile(level, f);
     files_.emplace_back(f);
     file_map_.insert({file_number, {f, level}});
@@ -540,6 +542,68 @@ TEST_F(CompactionPickerTest, AllowsTrivialMoveUniversal) {
   ASSERT_TRUE(compaction->is_trivial_move());
 }
 
+TEST_F(CompactionPickerTest, UniversalLazyLevelingExcludesLastLevel) {
+  // With lazy_leveling, size ratio compaction merges the tiered runs with
+  // each other but must not include the last level, which is kept as a
+  // single fully sorted run.
+  const uint64_t kFileSize = 100000;
+
+  mutable_cf_options_.compaction_options_universal.lazy_leveling = true;
+  // Keep size amplification within limits so that the size ratio logic runs.
+  mutable_cf_options_.compaction_options_universal
+      .max_size_amplification_percent = 400;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  Add(0, 4U, "260", "300", kFileSize, 0, 260, 300);
+  Add(4, 3U, "100", "350", kFileSize, 0, 101, 150);
+
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(3U, compaction->num_input_files(0));
+  // The last level is excluded, so the output goes to the level above it.
+  ASSERT_EQ(3, compaction->output_level());
+}
+
+TEST_F(CompactionPickerTest, UniversalLazyLevelingSizeAmp) {
+  // With lazy_leveling, the last level is still rewritten when size
+  // amplification exceeds the configured limit.
+  const uint64_t kFileSize = 100000;
+
+  mutable_cf_options_.compaction_options_universal.lazy_leveling = true;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  Add(0, 4U, "260", "300", kFileSize, 0, 260, 300);
+  Add(4, 3U, "100", "350", kFileSize, 0, 101, 150);
+
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeAmplification,
+            compaction->compaction_reason());
+  ASSERT_EQ(4, compaction->output_level());
+  ASSERT_EQ(1U, compaction->num_input_files(4));
+}
+
 TEST_F(CompactionPickerTest, UniversalPeriodicCompaction1) {
   // The case where universal periodic compaction can be picked
   // with some newer files being compacted.
@@ -923,6 +987,72 @@ TEST_F(CompactionPickerTest, UniversalIncrementalSpace5) {
   ASSERT_EQ(13, compaction->num_input_files(1));
 }
 
+TEST_F(CompactionPickerTest, LevelTtlFileDeletion) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  const uint64_t kFileSize = 100000;
+  const uint64_t kTtl = 2000;
+
+  mutable_cf_options_.ttl = kTtl;
+  mutable_cf_options_.ttl_delete_expired_files = true;
+  LevelCompactionPicker local_picker(ioptions_, &icmp_);
+
+  int64_t current_time = 0;
+  ASSERT_OK(Env::Default()->GetCurrentTime(&current_time));
+  uint64_t threshold_time = static_cast<uint64_t>(current_time) - kTtl;
+  // An expired file on a non-bottommost level must not be dropped: older
+  // versions of its keys may live below it.
+  Add(3, 2U, "200", "300", kFileSize, 0, 200, 300, 0, false,
+      Temperature::kUnknown, threshold_time - 3000, threshold_time - 3000);
+  // Two expired bottommost files and one that is still within the TTL.
+  Add(5, 3U, "100", "200", kFileSize, 0, 100, 200, 0, false,
+      Temperature::kUnknown, threshold_time - 4000, threshold_time - 4000);
+  Add(5, 4U, "250", "350", kFileSize, 0, 300, 400, 0, false,
+      Temperature::kUnknown, threshold_time - 2000, threshold_time - 2000);
+  Add(5, 5U, "400", "500", kFileSize, 0, 500, 600, 0, false,
+      Temperature::kUnknown, threshold_time + 1000, threshold_time + 1000);
+  UpdateVersionStorageInfo();
+
+  ASSERT_EQ(local_picker.NeedsCompaction(vstorage_.get()), true);
+  std::unique_ptr<Compaction> compaction(local_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_TRUE(compaction->deletion_compaction());
+  ASSERT_EQ(CompactionReason::kTtlFileDeletion,
+            compaction->compaction_reason());
+  ASSERT_EQ(5, compaction->level());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(3U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(4U, compaction->input(0, 1)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, LevelTtlFileDeletionDisabled) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  const uint64_t kFileSize = 100000;
+  const uint64_t kTtl = 2000;
+
+  mutable_cf_options_.ttl = kTtl;
+  LevelCompactionPicker local_picker(ioptions_, &icmp_);
+
+  int64_t current_time = 0;
+  ASSERT_OK(Env::Default()->GetCurrentTime(&current_time));
+  uint64_t threshold_time = static_cast<uint64_t>(current_time) - kTtl;
+  Add(5, 3U, "100", "200", kFileSize, 0, 100, 200, 0, false,
+      Temperature::kUnknown, threshold_time - 4000, threshold_time - 4000);
+  UpdateVersionStorageInfo();
+
+  // Without ttl_delete_expired_files, an expired bottommost file does not
+  // produce a deletion compaction.
+  ASSERT_TRUE(vstorage_->BottommostExpiredTtlFiles().empty());
+  std::unique_ptr<Compaction> compaction(local_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  if (compaction) {
+    ASSERT_NE(CompactionReason::kTtlFileDeletion,
+              compaction->compaction_reason());
+  }
+}
+
 TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
   NewVersionStorage(1, kCompactionStyleFIFO);
   const int kFileCount =
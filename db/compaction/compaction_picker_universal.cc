@@ -571,13 +571,25 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
   // dealing with unsigned types.
   assert(sorted_runs_.size() > 0);
 
+  // In lazy-leveling mode the last level is kept as a single fully sorted
+  // run and is only rewritten by size-amplification (or delete/periodic)
+  // compactions, so exclude it from the tiered candidate set here.
+  size_t num_candidate_runs = sorted_runs_.size();
+  if (mutable_cf_options_.compaction_options_universal.lazy_leveling &&
+      sorted_runs_.back().level == vstorage_->num_levels() - 1) {
+    --num_candidate_runs;
+    if (num_candidate_runs == 0) {
+      return nullptr;
+    }
+  }
+
   // Considers a candidate file only if it is smaller than the
   // total size accumulated so far.
-  for (size_t loop = 0; loop < sorted_runs_.size(); loop++) {
+  for (size_t loop = 0; loop < num_candidate_runs; loop++) {
     candidate_count = 0;
 
     // Skip files that are already being compacted
-    for (sr = nullptr; loop < sorted_runs_.size(); loop++) {
+    for (sr = nullptr; loop < num_candidate_runs; loop++) {
       sr = &sorted_runs_[loop];
 
       if (!sr->being_compacted) {
@@ -607,7 +619,7 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
 
     // Check if the succeeding files need compaction.
     for (size_t i = loop + 1;
-         candidate_count < max_files_to_compact && i < sorted_runs_.size();
+         candidate_count < max_files_to_compact && i < num_candidate_runs;
          i++) {
       const SortedRun* succeeding_sr = &sorted_runs_[i];
       if (succeeding_sr->being_compacted) {
@@ -8,6 +8,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <unordered_set>
+
 #include "db/compaction/compaction_job.h"
 #include "db/compaction/compaction_state.h"
 #include "logging/logging.h"
@@ -15,6 +17,7 @@
 #include "monitoring/thread_status_util.h"
 #include "options/options_helper.h"
 #include "rocksdb/utilities/options_type.h"
+#include "util/compression.h"
 
 #ifndef ROCKSDB_LITE
 namespace ROCKSDB_NAMESPACE {
@@ -98,6 +101,57 @@ CompactionJob::ProcessKeyValueCompactionWithCompactionService(
       break;
   }
 
+  // While waiting for the remote compaction, install the output files it has
+  // already finished, so moving them to the output level is overlapped with
+  // the remote work instead of being serialized behind it.
+  std::unordered_set<std::string> streamed_file_names;
+  if (db_options_.compaction_service->SupportsOutputFileStreaming()) {
+    for (;;) {
+      std::string serialized_output_file;
+      CompactionServiceJobStatus stream_status =
+          db_options_.compaction_service->WaitForNextOutputFile(
+              info, &serialized_output_file);
+      if (stream_status != CompactionServiceJobStatus::kSuccess) {
+        // Streaming is best effort, the files which were not streamed are
+        // installed from the WaitForCompleteV2() result below.
+        ROCKS_LOG_WARN(db_options_.info_log,
+                       "[%s] [JOB %d] Remote compaction output file streaming "
+                       "stopped early.",
+                       compaction_input.column_family.name.c_str(), job_id_);
+        break;
+      }
+      if (serialized_output_file.empty()) {
+        // All the output files have been delivered.
+        break;
+      }
+      CompactionServiceOutputFile streamed_file;
+      s = CompactionServiceOutputFile::Read(serialized_output_file,
+                                            &streamed_file);
+      if (!s.ok()) {
+        ROCKS_LOG_WARN(db_options_.info_log,
+                       "[%s] [JOB %d] Failed to parse streamed remote "
+                       "compaction output file: %s",
+                       compaction_input.column_family.name.c_str(), job_id_,
+                       s.ToString().c_str());
+        break;
+      }
+      // `file_name` of a streamed output file is its full path.
+      s = InstallRemoteCompactionOutputFile(sub_compact, streamed_file,
+                                            streamed_file.file_name);
+      if (!s.ok()) {
+        sub_compact->status = s;
+        return CompactionServiceJobStatus::kFailure;
+      }
+      streamed_file_names.insert(streamed_file.file_name.substr(
+          streamed_file.file_name.find_last_of('/') + 1));
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "[%s] [JOB %d] Installed streamed remote compaction "
+                     "output file %s",
+                     compaction_input.column_family.name.c_str(), job_id_,
+                     streamed_file.file_name.c_str());
+    }
+  }
+
   ROCKS_LOG_INFO(db_options_.info_log,
                  "[%s] [JOB %d] Waiting for remote compaction...",
                  compaction_input.column_family.name.c_str(), job_id_);
@@ -167,36 +221,16 @@ CompactionJob::ProcessKeyValueCompactionWithCompactionService(
   }
 
   for (const auto& file : compaction_result.output_files) {
-    uint64_t file_num = versions_->NewFileNumber();
-    auto src_file = compaction_result.output_path + "/" + file.file_name;
-    auto tgt_file = TableFileName(compaction->immutable_options()->cf_paths,
-                                  file_num, compaction->output_path_id());
-    s = fs_->RenameFile(src_file, tgt_file, IOOptions(), nullptr);
-    if (!s.ok()) {
-      sub_compact->status = s;
-      return CompactionServiceJobStatus::kFailure;
+    if (streamed_file_names.count(file.file_name) > 0) {
+      // Already installed while the remote compaction was running.
+      continue;
     }
-
-    FileMetaData meta;
-    uint64_t file_size;
-    s = fs_->GetFileSize(tgt_file, IOOptions(), &file_size, nullptr);
+    auto src_file = compaction_result.output_path + "/" + file.file_name;
+    s = InstallRemoteCompactionOutputFile(sub_compact, file, src_file);
     if (!s.ok()) {
       sub_compact->status = s;
       return CompactionServiceJobStatus::kFailure;
     }
-    meta.fd = FileDescriptor(file_num, compaction->output_path_id(), file_size,
-                             file.smallest_seqno, file.largest_seqno);
-    meta.smallest.DecodeFrom(file.smallest_internal_key);
-    meta.largest.DecodeFrom(file.largest_internal_key);
-    meta.oldest_ancester_time = file.oldest_ancester_time;
-    meta.file_creation_time = file.file_creation_time;
-    meta.marked_for_compaction = file.marked_for_compaction;
-    meta.unique_id = file.unique_id;
-
-    auto cfd = compaction->column_family_data();
-    sub_compact->Current().AddOutput(std::move(meta),
-                                     cfd->internal_comparator(), false, false,
-                                     true, file.paranoid_hash);
   }
   sub_compact->compaction_job_stats = compaction_result.stats;
   sub_compact->Current().SetNumOutputRecords(
@@ -208,6 +242,39 @@ CompactionJob::ProcessKeyValueCompactionWithCompactionService(
   return CompactionServiceJobStatus::kSuccess;
 }
 
+Status CompactionJob::InstallRemoteCompactionOutputFile(
+    SubcompactionState* sub_compact, const CompactionServiceOutputFile& file,
+    const std::string& src_file) {
+  const Compaction* compaction = sub_compact->compaction;
+  uint64_t file_num = versions_->NewFileNumber();
+  auto tgt_file = TableFileName(compaction->immutable_options()->cf_paths,
+                                file_num, compaction->output_path_id());
+  Status s = fs_->RenameFile(src_file, tgt_file, IOOptions(), nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+
+  FileMetaData meta;
+  uint64_t file_size;
+  s = fs_->GetFileSize(tgt_file, IOOptions(), &file_size, nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+  meta.fd = FileDescriptor(file_num, compaction->output_path_id(), file_size,
+                           file.smallest_seqno, file.largest_seqno);
+  meta.smallest.DecodeFrom(file.smallest_internal_key);
+  meta.largest.DecodeFrom(file.largest_internal_key);
+  meta.oldest_ancester_time = file.oldest_ancester_time;
+  meta.file_creation_time = file.file_creation_time;
+  meta.marked_for_compaction = file.marked_for_compaction;
+  meta.unique_id = file.unique_id;
+
+  auto cfd = compaction->column_family_data();
+  sub_compact->Current().AddOutput(std::move(meta), cfd->internal_comparator(),
+                                   false, false, true, file.paranoid_hash);
+  return Status::OK();
+}
+
 std::string CompactionServiceCompactionJob::GetTableFileName(
     uint64_t file_number) {
   return MakeTableFileName(output_path_, file_number);
@@ -352,6 +419,10 @@ void CompactionServiceCompactionJob::CleanupCompaction() {
 // Internal binary format for the input and result data
 enum BinaryFormatVersion : uint32_t {
   kOptionsString = 1,  // Use string format similar to Option string format
+  // kOptionsString payload compressed with zstd. Writers fall back to
+  // kOptionsString when zstd is not available in the build, and readers
+  // accept both versions, so hosts with and without zstd can be mixed.
+  kZstdCompressedOptionsString = 2,
 };
 
 static std::unordered_map<std::string, OptionTypeInfo> cfd_type_info = {
@@ -739,62 +810,149 @@ static std::unordered_map<std::string, OptionTypeInfo> cs_result_type_info = {
                   OptionVerificationType::kNormal, OptionTypeFlags::kNone)},
 };
 
-Status CompactionServiceInput::Read(const std::string& data_str,
-                                    CompactionServiceInput* obj) {
+// Frame the serialized options string for transport. The options-string
+// format spells out every field name and mostly identical
+// DBOptions/CFOptions strings in every job, so zstd typically shrinks the
+// payload (and the bytes shipped to remote compaction workers) by an order
+// of magnitude. Hosts built without zstd fall back to the uncompressed
+// format, which every reader accepts.
+static void EncodeBinaryPayload(const std::string& serialized,
+                                std::string* output) {
+  char buf[sizeof(BinaryFormatVersion)];
+  if (ZSTD_Supported()) {
+    CompressionOptions opts;
+    CompressionContext context(kZSTD);
+    CompressionInfo info(opts, context, CompressionDict::GetEmptyDict(), kZSTD,
+                         0 /* sample_for_compression */);
+    std::string compressed;
+    if (ZSTD_Compress(info, serialized.data(), serialized.size(),
+                      &compressed)) {
+      EncodeFixed32(buf, kZstdCompressedOptionsString);
+      output->append(buf, sizeof(BinaryFormatVersion));
+      output->append(compressed);
+      return;
+    }
+  }
+  EncodeFixed32(buf, kOptionsString);
+  output->append(buf, sizeof(BinaryFormatVersion));
+  output->append(serialized);
+}
+
+// Reverse of EncodeBinaryPayload: check the format version and recover the
+// serialized options string. `name` is only used in error messages.
+static Status DecodeBinaryPayload(const std::string& data_str,
+                                  const std::string& name,
+                                  std::string* serialized) {
   if (data_str.size() <= sizeof(BinaryFormatVersion)) {
-    return Status::InvalidArgument("Invalid CompactionServiceInput string");
+    return Status::InvalidArgument("Invalid " + name + " string");
   }
   auto format_version = DecodeFixed32(data_str.data());
   if (format_version == kOptionsString) {
-    ConfigOptions cf;
-    cf.invoke_prepare_options = false;
-    cf.ignore_unknown_options = true;
-    return OptionTypeInfo::ParseType(
-        cf, data_str.substr(sizeof(BinaryFormatVersion)), cs_input_type_info,
-        obj);
+    serialized->assign(data_str.data() + sizeof(BinaryFormatVersion),
+                       data_str.size() - sizeof(BinaryFormatVersion));
+    return Status::OK();
+  } else if (format_version == kZstdCompressedOptionsString) {
+    if (!ZSTD_Supported()) {
+      return Status::NotSupported(
+          name + " is zstd compressed, which is not supported in this build");
+    }
+    UncompressionContext context(kZSTD);
+    UncompressionInfo info(context, UncompressionDict::GetEmptyDict(), kZSTD);
+    size_t uncompressed_size = 0;
+    CacheAllocationPtr uncompressed = ZSTD_Uncompress(
+        info, data_str.data() + sizeof(BinaryFormatVersion),
+        data_str.size() - sizeof(BinaryFormatVersion), &uncompressed_size);
+    if (uncompressed == nullptr) {
+      return Status::Corruption("Failed to uncompress " + name + " string");
+    }
+    serialized->assign(uncompressed.get(), uncompressed_size);
+    return Status::OK();
   } else {
-    return Status::NotSupported(
-        "Compaction Service Input data version not supported: " +
-        std::to_string(format_version));
+    return Status::NotSupported(name + " data version not supported: " +
+                                std::to_string(format_version));
   }
 }
 
+Status CompactionServiceInput::Read(const std::string& data_str,
+                                    CompactionServiceInput* obj) {
+  std::string serialized;
+  Status s =
+      DecodeBinaryPayload(data_str, "CompactionServiceInput", &serialized);
+  if (!s.ok()) {
+    return s;
+  }
+  ConfigOptions cf;
+  cf.invoke_prepare_options = false;
+  cf.ignore_unknown_options = true;
+  return OptionTypeInfo::ParseType(cf, serialized, cs_input_type_info, obj);
+}
+
 Status CompactionServiceInput::Write(std::string* output) {
-  char buf[sizeof(BinaryFormatVersion)];
-  EncodeFixed32(buf, kOptionsString);
-  output->append(buf, sizeof(BinaryFormatVersion));
   ConfigOptions cf;
   cf.invoke_prepare_options = false;
-  return OptionTypeInfo::SerializeType(cf, cs_input_type_info, this, output);
+  std::string serialized;
+  Status s =
+      OptionTypeInfo::SerializeType(cf, cs_input_type_info, this, &serialized);
+  if (!s.ok()) {
+    return s;
+  }
+  EncodeBinaryPayload(serialized, output);
+  return Status::OK();
+}
+
+Status CompactionServiceOutputFile::Read(const std::string& data_str,
+                                         CompactionServiceOutputFile* obj) {
+  std::string serialized;
+  Status s = DecodeBinaryPayload(data_str, "CompactionServiceOutputFile",
+                                 &serialized);
+  if (!s.ok()) {
+    return s;
+  }
+  ConfigOptions cf;
+  cf.invoke_prepare_options = false;
+  cf.ignore_unknown_options = true;
+  return OptionTypeInfo::ParseType(cf, serialized, cs_output_file_type_info,
+                                   obj);
+}
+
+Status CompactionServiceOutputFile::Write(std::string* output) {
+  ConfigOptions cf;
+  cf.invoke_prepare_options = false;
+  std::string serialized;
+  Status s = OptionTypeInfo::SerializeType(cf, cs_output_file_type_info, this,
+                                           &serialized);
+  if (!s.ok()) {
+    return s;
+  }
+  EncodeBinaryPayload(serialized, output);
+  return Status::OK();
 }
 
 Status CompactionServiceResult::Read(const std::string& data_str,
                                      CompactionServiceResult* obj) {
-  if (data_str.size() <= sizeof(BinaryFormatVersion)) {
-    return Status::InvalidArgument("Invalid CompactionServiceResult string");
-  }
-  auto format_version = DecodeFixed32(data_str.data());
-  if (format_version == kOptionsString) {
-    ConfigOptions cf;
-    cf.invoke_prepare_options = false;
-    cf.ignore_unknown_options = true;
-    return OptionTypeInfo::ParseType(
-        cf, data_str.substr(sizeof(BinaryFormatVersion)), cs_result_type_info,
-        obj);
-  } else {
-    return Status::NotSupported(
-        "Compaction Service Result data version not supported: " +
-        std::to_string(format_version));
+  std::string serialized;
+  Status s =
+      DecodeBinaryPayload(data_str, "CompactionServiceResult", &serialized);
+  if (!s.ok()) {
+    return s;
   }
+  ConfigOptions cf;
+  cf.invoke_prepare_options = false;
+  cf.ignore_unknown_options = true;
+  return OptionTypeInfo::ParseType(cf, serialized, cs_result_type_info, obj);
 }
 
 Status CompactionServiceResult::Write(std::string* output) {
-  char buf[sizeof(BinaryFormatVersion)];
-  EncodeFixed32(buf, kOptionsString);
-  output->append(buf, sizeof(BinaryFormatVersion));
   ConfigOptions cf;
   cf.invoke_prepare_options = false;
-  return OptionTypeInfo::SerializeType(cf, cs_result_type_info, this, output);
+  std::string serialized;
+  Status s =
+      OptionTypeInfo::SerializeType(cf, cs_result_type_info, this, &serialized);
+  if (!s.ok()) {
+    return s;
+  }
+  EncodeBinaryPayload(serialized, output);
+  return Status::OK();
 }
 
 #ifndef NDEBUG
@@ -89,4 +89,54 @@ class FileTtlBooster {
   uint64_t boost_age_start_;
   uint64_t boost_step_;
 };
+
+// Estimates how many deeper-level bytes the range tombstones of a file
+// could reclaim, so DeleteRange-heavy files get prioritized by the bytes
+// they free up rather than by their own (often tiny) size. The spans of
+// the individual tombstones are not available from file metadata, so the
+// overlap of the file's whole key range with the deeper level is scaled
+// by the file's range-tombstone entry fraction: a file that is mostly
+// DeleteRanges is credited with most of the data under it, while an
+// occasional tombstone in a large file contributes little.
+class FileReclaimedBytesEstimator {
+ public:
+  explicit FileReclaimedBytesEstimator(const InternalKeyComparator* icmp)
+      : icmp_(icmp) {}
+
+  // Total size of the files in `deeper_files` whose key range overlaps
+  // the key range of `file`. `deeper_files` must be sorted by key and
+  // non-overlapping (any level other than L0).
+  uint64_t OverlappingBytes(
+      const FileMetaData& file,
+      const std::vector<FileMetaData*>& deeper_files) const {
+    auto it = std::lower_bound(
+        deeper_files.begin(), deeper_files.end(), file.smallest,
+        [this](const FileMetaData* f, const InternalKey& key) {
+          return icmp_->Compare(f->largest, key) < 0;
+        });
+    uint64_t bytes = 0;
+    for (; it != deeper_files.end() &&
+           icmp_->Compare((*it)->smallest, file.largest) <= 0;
+         ++it) {
+      bytes += (*it)->fd.GetFileSize();
+    }
+    return bytes;
+  }
+
+  // Scales the overlapping bytes by the range-tombstone density of the
+  // file. Returns the estimated reclaimable bytes.
+  static uint64_t ScaleByTombstoneDensity(const FileMetaData& file,
+                                          uint64_t overlapping_bytes) {
+    if (file.num_range_deletions == 0 || file.num_entries == 0) {
+      return 0;
+    }
+    assert(file.num_range_deletions <= file.num_entries);
+    return static_cast<uint64_t>(
+        overlapping_bytes * (static_cast<double>(file.num_range_deletions) /
+                             file.num_entries));
+  }
+
+ private:
+  const InternalKeyComparator* icmp_;
+};
 }  // namespace ROCKSDB_NAMESPACE
@@ -73,6 +73,11 @@ class SubcompactionState {
   // within the same compaction job.
   const uint32_t sub_job_id;
 
+  // Lazily created cache holding the raw compression dictionary trained by
+  // the first output file of this sub-compaction, reused by later output
+  // files when CompressionOptions::share_compaction_dict is set.
+  std::shared_ptr<std::string> compression_dict_cache;
+
   Slice SmallestUserKey() const;
 
   Slice LargestUserKey() const;
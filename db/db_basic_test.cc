@@ -1140,6 +1140,48 @@ class TestEnv : public EnvWrapper {
   int close_count;
 };
 
+TEST_F(DBBasicTest, LazyOpenTableFiles) {
+  Options options = CurrentOptions();
+  options.max_open_files = -1;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  DestroyAndReopen(options);
+  const int kNumFiles = 3;
+  for (int i = 0; i < kNumFiles; i++) {
+    ASSERT_OK(Put(Key(i), "value" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+
+  // Hold back the background warmer until the lazy behavior has been
+  // verified.
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBBasicTest::LazyOpenTableFiles:Checked",
+        "DBImpl::BGWorkTablePreload"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  options.lazy_open_table_files = true;
+  TestGetAndResetTickerCount(options, NO_FILE_OPENS);
+  Reopen(options);
+  // Open() must not have touched the table files.
+  ASSERT_EQ(0, TestGetTickerCount(options, NO_FILE_OPENS));
+  // The first read materializes the table reader.
+  ASSERT_EQ("value1", Get(Key(1)));
+  ASSERT_GE(TestGetTickerCount(options, NO_FILE_OPENS), 1);
+  TEST_SYNC_POINT("DBBasicTest::LazyOpenTableFiles:Checked");
+
+  // The background warmer opens the remaining files.
+  for (int retry = 0;
+       retry < 1000 && TestGetTickerCount(options, NO_FILE_OPENS) < kNumFiles;
+       retry++) {
+    env_->SleepForMicroseconds(10 * 1000);
+  }
+  ASSERT_EQ(kNumFiles, TestGetTickerCount(options, NO_FILE_OPENS));
+  for (int i = 0; i < kNumFiles; i++) {
+    ASSERT_EQ("value" + std::to_string(i), Get(Key(i)));
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBBasicTest, DBClose) {
   Options options = GetDefaultOptions();
   std::string dbname = test::PerThreadDBPath("db_close_test");
@@ -4212,6 +4254,26 @@ TEST_F(DBBasicTest, VerifyFileChecksums) {
   ASSERT_TRUE(db_->VerifyFileChecksums(ReadOptions()).IsInvalidArgument());
 }
 
+TEST_F(DBBasicTest, VerifyChecksumParallel) {
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.env = env_;
+  options.max_verify_checksum_threads = 4;
+  DestroyAndReopen(options);
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_OK(Put("key" + std::to_string(i), "value" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->VerifyChecksum());
+  // Progress is persisted so a later verification, including one after a
+  // restart, schedules files that have not been verified yet first.
+  ASSERT_OK(env_->FileExists(VerifyChecksumProgressFileName(dbname_)));
+  Reopen(options);
+  ASSERT_OK(Put("unverified", "value"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->VerifyChecksum());
+}
+
 // TODO: re-enable after we provide finer-grained control for WAL tracking to
 // meet the needs of different use cases, durability levels and recovery modes.
 TEST_F(DBBasicTest, DISABLED_ManualWalSync) {
@@ -663,6 +663,129 @@ TEST_F(DBBlockCacheTest, WarmCacheWithDataBlocksDuringFlush) {
             options.statistics->getTickerCount(BLOCK_CACHE_DATA_ADD));
 }
 
+TEST_F(DBBlockCacheTest, WarmCacheWithHotBlocksDuringCompaction) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1 << 25, 0, false);
+  table_options.cache_index_and_filter_blocks = false;
+  table_options.prepopulate_block_cache =
+      BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  std::string value(kValueSize, 'a');
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_OK(Put(std::to_string(i), value));
+    ASSERT_OK(Flush());
+  }
+  // All input blocks were inserted during flush, so the whole key space is
+  // hot and the compaction output should be warmed as well.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), /*begin=*/nullptr,
+                              /*end=*/nullptr));
+  uint64_t misses = options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS);
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(std::to_string(i)));
+  }
+  // Reads of the compacted file are served from the warmed cache.
+  ASSERT_EQ(misses,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS));
+}
+
+TEST_F(DBBlockCacheTest, BlockCacheHeatmapProperty) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1 << 25, 0, false);
+  table_options.cache_index_and_filter_blocks = false;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  std::string value(kValueSize, 'a');
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_OK(Put(std::to_string(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  // First read misses and inserts, second read hits.
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(std::to_string(i)));
+  }
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(std::to_string(i)));
+  }
+
+  std::map<std::string, std::string> heatmap;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheHeatmap, &heatmap));
+  ASSERT_GT(std::stoull(heatmap["L0.data.miss"]), 0U);
+  ASSERT_GT(std::stoull(heatmap["L0.data.insert"]), 0U);
+  ASSERT_GT(std::stoull(heatmap["L0.data.hit"]), 0U);
+
+  // The string form of the property renders the same keys.
+  std::string heatmap_str;
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kBlockCacheHeatmap, &heatmap_str));
+  ASSERT_NE(heatmap_str.find("L0.data.hit"), std::string::npos);
+}
+
+TEST_F(DBBlockCacheTest, AdaptiveMetadataPinning) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+
+  std::shared_ptr<Cache> cache = NewLRUCache(1 << 19, 0, false);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = cache;
+  table_options.block_size = 1024;
+  table_options.metadata_block_size = 1024;
+  table_options.index_type = BlockBasedTableOptions::kTwoLevelIndexSearch;
+  table_options.partition_filters = true;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10, false));
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.metadata_cache_options.top_level_index_pinning =
+      PinningTier::kNone;
+  table_options.metadata_cache_options.partition_pinning = PinningTier::kNone;
+  table_options.metadata_cache_options.unpartitioned_pinning =
+      PinningTier::kNone;
+  table_options.metadata_cache_options.adaptive_pinning_min_accesses = 1;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  std::string value(kValueSize, 'a');
+  for (size_t i = 1; i <= 1000; i++) {
+    ASSERT_OK(Put(std::to_string(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  // Touch the filter and index partitions of the file.
+  for (size_t i = 1; i <= kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(std::to_string(i)));
+  }
+
+  // The cache is far from capacity, so the accessed partitions get pinned.
+  size_t pinned_cold = cache->GetPinnedUsage();
+  dbfull()->MaintainAdaptiveMetadataPinning();
+  size_t pinned_hot = cache->GetPinnedUsage();
+  ASSERT_GT(pinned_hot, pinned_cold);
+
+  // Push the cache over the pressure threshold; with no accesses since the
+  // last pass, the next pass unpins the partitions again.
+  int filler = 0;
+  while (cache->GetUsage() <
+         cache->GetCapacity() - cache->GetCapacity() / 10) {
+    ASSERT_OK(cache->Insert("filler" + std::to_string(filler++), nullptr,
+                            4096, nullptr));
+  }
+  dbfull()->MaintainAdaptiveMetadataPinning();
+  ASSERT_LT(cache->GetPinnedUsage(), pinned_hot);
+}
+
 // This test cache data, index and filter blocks during flush.
 class DBBlockCacheTest1 : public DBTestBase,
                           public ::testing::WithParamInterface<uint32_t> {
@@ -1856,6 +1856,60 @@ TEST_F(DBBloomFilterTest, PrefixExtractorWithFilter2) {
   delete iter;
 }
 
+TEST_F(DBBloomFilterTest, RangeSegmentFilterPrefixSeek) {
+  BlockBasedTableOptions bbto;
+  bbto.filter_policy.reset(NewExperimentalRangeFilterPolicy(8));
+  bbto.whole_key_filtering = false;
+
+  Options options = CurrentOptions();
+  options.prefix_extractor.reset(NewFixedPrefixTransform(4));
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("abcd1111", "val1"));
+  ASSERT_OK(Put("abcd2222", "val2"));
+  ASSERT_OK(Put("wxyz1111", "val3"));
+  ASSERT_OK(Flush());
+
+  ReadOptions ro;
+  ro.prefix_same_as_start = true;
+
+  {
+    // Seek into a populated prefix range finds its keys
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro));
+    iter->Seek("abcd");
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), "abcd1111");
+    iter->Next();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), "abcd2222");
+  }
+  {
+    // Seek into an empty prefix range terminates at the filter, without
+    // touching index or data blocks
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro));
+    iter->Seek("lmno");
+    ASSERT_OK(iter->status());
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_EQ(TestGetTickerCount(options, BLOOM_FILTER_PREFIX_USEFUL), 1);
+  }
+  {
+    // Same for an empty prefix range that sorts between the stored keys
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro));
+    iter->Seek("bcde");
+    ASSERT_OK(iter->status());
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_EQ(TestGetTickerCount(options, BLOOM_FILTER_PREFIX_USEFUL), 2);
+  }
+
+  // No false negatives for point reads either, even though only prefixes
+  // were added to the filter
+  ASSERT_EQ(Get("abcd1111"), "val1");
+  ASSERT_EQ(Get("wxyz1111"), "val3");
+}
+
 TEST_F(DBBloomFilterTest, MemtableWholeKeyBloomFilter) {
   // regression test for #2743. the range delete tombstones in memtable should
   // be added even when Get() skips searching due to its prefix bloom filter
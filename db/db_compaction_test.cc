@@ -5580,6 +5580,48 @@ TEST_P(DBCompactionTestWithParam, RoundRobinWithoutAdditionalResources) {
   SyncPoint::GetInstance()->ClearAllCallBacks();
 }
 
+TEST_F(DBCompactionTest, AutoTuneSubcompactions) {
+  const int kKeysPerFile = 100;
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  options.auto_tune_subcompactions = true;
+  options.max_subcompactions = 1;
+  options.max_background_jobs = 8;
+  options.target_file_size_base = 4 * 1024;
+  options.level0_file_num_compaction_trigger = 4;
+  // A tiny setpoint so the accumulated L0 backlog is always above it.
+  options.soft_pending_compaction_bytes_limit = 1024;
+  DestroyAndReopen(options);
+  env_->SetBackgroundThreads(4, Env::LOW);
+
+  Random rnd(301);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < kKeysPerFile; j++) {
+      ASSERT_OK(Put(Key(j), rnd.RandomString(1024)));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  bool num_planned_subcompactions_verified = false;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:0", [&](void* arg) {
+        uint64_t num_planned_subcompactions = *(static_cast<uint64_t*>(arg));
+        // The backlog is above the setpoint and spare compaction threads
+        // are available, so more than one subcompaction is planned even
+        // though max_subcompactions is 1.
+        ASSERT_GT(num_planned_subcompactions, 1);
+        num_planned_subcompactions_verified = true;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), /*begin=*/nullptr,
+                              /*end=*/nullptr));
+  ASSERT_TRUE(num_planned_subcompactions_verified);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBCompactionTest, RoundRobinCutOutputAtCompactCursor) {
   Options options = CurrentOptions();
   options.num_levels = 3;
@@ -5637,6 +5679,41 @@ TEST_F(DBCompactionTest, RoundRobinCutOutputAtCompactCursor) {
   }
 }
 
+TEST_F(DBCompactionTest, UniversalOverlappingL0RunsSubcompactions) {
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 4;
+  options.target_file_size_base = 16 * 1024;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  // 8 wholly-overlapping L0 runs holding updates of the same keys. Their
+  // anchor keys collide across runs, so boundary generation has to merge
+  // the duplicated anchors' range sizes (rather than drop them) to split
+  // this merge into balanced subcompactions.
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 100; j++) {
+      ASSERT_OK(Put(Key(j), rnd.RandomString(1024)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(8, NumTableFilesAtLevel(0));
+
+  uint64_t num_actual_subcompactions = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:1", [&](void* arg) {
+        num_actual_subcompactions = *(static_cast<uint64_t*>(arg));
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GT(num_actual_subcompactions, 1U);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 class NoopMergeOperator : public MergeOperator {
  public:
   NoopMergeOperator() {}
@@ -7467,6 +7544,60 @@ TEST_F(DBCompactionTest, FIFOWarm) {
   Destroy(options);
 }
 
+TEST_F(DBCompactionTest, ColdFileTemperatureMigration) {
+  Options options = CurrentOptions();
+  options.level0_file_num_compaction_trigger = 10;
+  options.cold_file_age_seconds = 1000;
+  options.cold_file_temperature = Temperature::kWarm;
+  env_->SetMockSleep();
+  Reopen(options);
+
+  int total_warm = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "NewWritableFile::FileOptions.temperature", [&](void* arg) {
+        Temperature temperature = *(static_cast<Temperature*>(arg));
+        if (temperature == Temperature::kWarm) {
+          total_warm++;
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // Two files with disjoint key ranges. Installing them starts their
+  // cooldown clocks.
+  ASSERT_OK(Put(Key(0), "value1"));
+  ASSERT_OK(Put(Key(1), "value2"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put(Key(10), "value1"));
+  ASSERT_OK(Put(Key(11), "value2"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  // Let the two files cool down, then install another version so they are
+  // re-scanned, found unread for a full period and marked for migration.
+  env_->MockSleepForSeconds(1200);
+  ASSERT_OK(Put(Key(20), "value1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+
+  ColumnFamilyMetaData metadata;
+  db_->GetColumnFamilyMetaData(&metadata);
+  ASSERT_EQ(3, metadata.file_count);
+  ASSERT_EQ(2, total_warm);
+  int warm_files = 0;
+  for (const auto& level_meta : metadata.levels) {
+    for (const auto& file_meta : level_meta.files) {
+      if (file_meta.temperature == Temperature::kWarm) {
+        warm_files++;
+      }
+    }
+  }
+  ASSERT_EQ(2, warm_files);
+
+  Destroy(options);
+}
+
 TEST_F(DBCompactionTest, DisableMultiManualCompaction) {
   const int kNumL0Files = 10;
 
@@ -22,9 +22,14 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#if USE_COROUTINES && !defined(USE_STD_COROUTINES)
+#include "folly/experimental/coro/BlockingWait.h"
+#include "folly/experimental/coro/Collect.h"
+#endif  // USE_COROUTINES && !defined(USE_STD_COROUTINES)
 #include "db/arena_wrapped_db_iter.h"
 #include "db/builder.h"
 #include "db/compaction/compaction_job.h"
@@ -45,6 +50,7 @@
 #include "db/memtable_list.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
+#include "db/merge_operands_iterator_impl.h"
 #include "db/periodic_work_scheduler.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "db/table_cache.h"
@@ -65,6 +71,8 @@
 #include "monitoring/instrumented_mutex.h"
 #include "monitoring/iostats_context_imp.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/perf_sampler.h"
+#include "monitoring/request_perf_context.h"
 #include "monitoring/persistent_stats_history.h"
 #include "monitoring/thread_status_updater.h"
 #include "monitoring/thread_status_util.h"
@@ -78,6 +86,9 @@
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
 #include "rocksdb/merge_operator.h"
+#include "rocksdb/negative_lookup_cache.h"
+#include "rocksdb/row_lookup_cache.h"
+#include "rocksdb/slo_tracker.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/stats_history.h"
 #include "rocksdb/status.h"
@@ -165,6 +176,10 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       fs_(immutable_db_options_.fs, io_tracer_),
       mutable_db_options_(initial_db_options_),
       stats_(immutable_db_options_.stats),
+      perf_sampler_(immutable_db_options_.perf_sample_frequency > 0
+                        ? new PerfSampler(
+                              immutable_db_options_.perf_sample_frequency)
+                        : nullptr),
       mutex_(stats_, immutable_db_options_.clock, DB_MUTEX_WAIT_MICROS,
              immutable_db_options_.use_adaptive_mutex),
       default_cf_handle_(nullptr),
@@ -193,14 +208,13 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       nonmem_write_thread_(immutable_db_options_),
       write_controller_(mutable_db_options_.delayed_write_rate),
       last_batch_group_size_(0),
-      unscheduled_flushes_(0),
-      unscheduled_compactions_(0),
       bg_bottom_compaction_scheduled_(0),
       bg_compaction_scheduled_(0),
       num_running_compactions_(0),
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
       bg_purge_scheduled_(0),
+      bg_table_preload_scheduled_(0),
       disable_delete_obsolete_files_(0),
       pending_purge_obsolete_files_(0),
       delete_obsolete_files_last_run_(immutable_db_options_.clock->NowMicros()),
@@ -568,7 +582,7 @@ Status DBImpl::CloseHelper() {
   // Wait for background work to finish
   while (bg_bottom_compaction_scheduled_ || bg_compaction_scheduled_ ||
          bg_flush_scheduled_ || bg_purge_scheduled_ ||
-         pending_purge_obsolete_files_ ||
+         bg_table_preload_scheduled_ || pending_purge_obsolete_files_ ||
          error_handler_.IsRecoveryInProgress()) {
     TEST_SYNC_POINT("DBImpl::~DBImpl:WaitJob");
     bg_cv_.Wait();
@@ -579,14 +593,14 @@ Status DBImpl::CloseHelper() {
   flush_scheduler_.Clear();
   trim_history_scheduler_.Clear();
 
-  while (!flush_queue_.empty()) {
+  while (bg_work_queues_.HasPendingFlush()) {
     const FlushRequest& flush_req = PopFirstFromFlushQueue();
     for (const auto& iter : flush_req) {
       iter.first->UnrefAndTryDelete();
     }
   }
 
-  while (!compaction_queue_.empty()) {
+  while (bg_work_queues_.HasPendingCompaction()) {
     auto cfd = PopFirstFromCompactionQueue();
     cfd->UnrefAndTryDelete();
   }
@@ -1095,6 +1109,36 @@ void DBImpl::FlushInfoLog() {
   LogFlush(immutable_db_options_.info_log);
 }
 
+void DBImpl::MaintainAdaptiveMetadataPinning() {
+  if (shutdown_initiated_) {
+    return;
+  }
+  TEST_SYNC_POINT("DBImpl::MaintainAdaptiveMetadataPinning:StartRunning");
+  InstrumentedMutexLock l(&mutex_);
+  for (auto cfd : versions_->GetRefedColumnFamilySet()) {
+    if (!cfd->initialized()) {
+      continue;
+    }
+    Version* version = cfd->current();
+    version->Ref();
+    const VersionStorageInfo* vstorage = version->storage_info();
+    {
+      // Readers stay alive through the version reference; release the DB
+      // mutex since maintenance may pin partitions, which does IO.
+      InstrumentedMutexUnlock u(&mutex_);
+      for (int level = 0; level < vstorage->num_levels(); ++level) {
+        for (const auto& file : vstorage->LevelFiles(level)) {
+          TableReader* reader = file->fd.table_reader;
+          if (reader != nullptr) {
+            reader->MaintainAdaptivePinning();
+          }
+        }
+      }
+    }
+    version->Unref();
+  }
+}
+
 Status DBImpl::TablesRangeTombstoneSummary(ColumnFamilyHandle* column_family,
                                            int max_entries_to_print,
                                            std::string* out_str) {
@@ -1393,11 +1437,11 @@ Status DBImpl::FlushWAL(bool sync) {
       // future writes
       IOStatusCheck(io_s);
       // whether sync or not, we should abort the rest of function upon error
-      return std::move(io_s);
+      return io_s;
     }
     if (!sync) {
       ROCKS_LOG_DEBUG(immutable_db_options_.info_log, "FlushWAL sync=false");
-      return std::move(io_s);
+      return io_s;
     }
   }
   if (!sync) {
@@ -1514,7 +1558,7 @@ Status DBImpl::LockWAL() {
     // future writes
     WriteStatusCheck(status);
   }
-  return std::move(status);
+  return status;
 }
 
 Status DBImpl::UnlockWAL() {
@@ -1621,6 +1665,65 @@ void DBImpl::SchedulePurge() {
   env_->Schedule(&DBImpl::BGWorkPurge, this, Env::Priority::HIGH, nullptr);
 }
 
+void DBImpl::ScheduleTableFilePreload() {
+  mutex_.AssertHeld();
+  assert(opened_successfully_);
+
+  bg_table_preload_scheduled_++;
+  env_->Schedule(&DBImpl::BGWorkTablePreload, this, Env::Priority::LOW,
+                 nullptr);
+}
+
+void DBImpl::BGWorkTablePreload(void* db) {
+  IOSTATS_SET_THREAD_POOL_ID(Env::Priority::LOW);
+  TEST_SYNC_POINT("DBImpl::BGWorkTablePreload");
+  reinterpret_cast<DBImpl*>(db)->BackgroundCallTablePreload();
+}
+
+void DBImpl::BackgroundCallTablePreload() {
+  // Take a reference on the current version of every column family, then
+  // warm the table cache outside the mutex, hottest (lowest) levels first.
+  autovector<Version*> versions;
+  int max_levels = 0;
+  mutex_.Lock();
+  for (auto cfd : *versions_->GetColumnFamilySet()) {
+    if (cfd->IsDropped() || !cfd->initialized()) {
+      continue;
+    }
+    Version* version = cfd->current();
+    version->Ref();
+    versions.push_back(version);
+    max_levels =
+        std::max(max_levels, version->storage_info()->num_levels());
+  }
+  mutex_.Unlock();
+
+  for (int level = 0; level < max_levels; ++level) {
+    if (shutting_down_.load(std::memory_order_acquire)) {
+      break;
+    }
+    for (Version* version : versions) {
+      if (level < version->storage_info()->num_levels()) {
+        version->WarmTableCacheAtLevel(level, shutting_down_);
+      }
+    }
+  }
+
+  mutex_.Lock();
+  for (Version* version : versions) {
+    version->Unref();
+  }
+  assert(bg_table_preload_scheduled_ > 0);
+  bg_table_preload_scheduled_--;
+
+  bg_cv_.SignalAll();
+  // IMPORTANT:there should be no code after calling SignalAll. This call may
+  // signal the DB destructor that it's OK to proceed with destruction. In
+  // that case, all DB variables will be dealloacated and referencing them
+  // will cause trouble.
+  mutex_.Unlock();
+}
+
 void DBImpl::BackgroundCallPurge() {
   mutex_.Lock();
 
@@ -1719,16 +1822,17 @@ static void CleanupIteratorState(void* arg1, void* /*arg2*/) {
 }
 }  // namespace
 
-InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
-                                              ColumnFamilyData* cfd,
-                                              SuperVersion* super_version,
-                                              Arena* arena,
-                                              RangeDelAggregator* range_del_agg,
-                                              SequenceNumber sequence,
-                                              bool allow_unprepared_value) {
+InternalIterator* DBImpl::NewInternalIterator(
+    const ReadOptions& read_options, ColumnFamilyData* cfd,
+    SuperVersion* super_version, Arena* arena,
+    RangeDelAggregator* range_del_agg, SequenceNumber sequence,
+    bool allow_unprepared_value, InternalIterator** merging_iter_out) {
   InternalIterator* internal_iter;
   assert(arena != nullptr);
   assert(range_del_agg != nullptr);
+  if (merging_iter_out != nullptr) {
+    *merging_iter_out = nullptr;
+  }
   // Need to create internal iterator from the arena.
   MergeIteratorBuilder merge_iter_builder(
       &cfd->internal_comparator(), arena,
@@ -1760,7 +1864,7 @@ InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
                                            &merge_iter_builder, range_del_agg,
                                            allow_unprepared_value);
     }
-    internal_iter = merge_iter_builder.Finish();
+    internal_iter = merge_iter_builder.Finish(merging_iter_out);
     IterState* cleanup =
         new IterState(this, &mutex_, super_version,
                       read_options.background_purge_on_iterator_cleanup ||
@@ -1801,13 +1905,39 @@ Status DBImpl::Get(const ReadOptions& read_options,
   return s;
 }
 
+void DBImpl::GetAsync(const ReadOptions& read_options,
+                      ColumnFamilyHandle* column_family, const Slice& key,
+                      PinnableSlice* value,
+                      std::function<void(Status)> callback) {
+  assert(value != nullptr);
+  if (read_options.async_io) {
+    // The batched MultiGet path is the only one wired up to the
+    // coroutine-based async table reads (ReadAsync + poll), so route the
+    // single-key lookup through it as a batch of one. Without coroutine
+    // support, or with async_io off, this degenerates to a plain Get().
+    Status s;
+    MultiGet(read_options, column_family, /*num_keys=*/1, &key, value, &s,
+             /*sorted_input=*/true);
+    callback(s);
+  } else {
+    callback(Get(read_options, column_family, key, value));
+  }
+}
+
 Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
                        GetImplOptions& get_impl_options) {
   assert(get_impl_options.value != nullptr ||
-         get_impl_options.merge_operands != nullptr);
+         get_impl_options.merge_operands != nullptr ||
+         get_impl_options.merge_operands_iter != nullptr);
 
   assert(get_impl_options.column_family);
 
+  PerfSampler::ScopedSample perf_sample(perf_sampler_.get(),
+                                        PerfSampler::kGet);
+  SLOTracker::ScopedTimer slo_timer(immutable_db_options_.slo_tracker.get(),
+                                    SLOTracker::kGet);
+  ScopedRequestPerfContext request_perf(read_options.request_perf_context);
+
   if (read_options.timestamp) {
     const Status s = FailIfTsMismatchCf(get_impl_options.column_family,
                                         *(read_options.timestamp),
@@ -1848,6 +1978,15 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     }
   }
 
+  RowLookupCache* row_lookup_cache =
+      immutable_db_options_.row_lookup_cache.get();
+  // The epoch used to tag row cache insertions must be read before the
+  // superversion is acquired: if a flush installs in between, the entry is
+  // tagged with the pre-flush epoch and can never validate against the
+  // post-flush file set it did not search.
+  const uint64_t row_cache_insert_epoch =
+      row_lookup_cache != nullptr ? cfd->GetNewDataEpoch() : 0;
+
   // Acquire SuperVersion
   SuperVersion* sv = GetAndRefSuperVersion(cfd);
 
@@ -1963,18 +2102,74 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   }
   TEST_SYNC_POINT("DBImpl::GetImpl:PostMemTableGet:0");
   TEST_SYNC_POINT("DBImpl::GetImpl:PostMemTableGet:1");
-  PinnedIteratorsManager pinned_iters_mgr;
+  // When the operands are handed over to a lazy iterator, the pins backing
+  // them must live in the iterator rather than on this stack frame.
+  PinnedIteratorsManager pinned_iters_mgr_storage;
+  PinnedIteratorsManager* pinned_iters_mgr =
+      get_impl_options.merge_operands_iter != nullptr
+          ? get_impl_options.merge_operands_iter->pinned_iters_mgr()
+          : &pinned_iters_mgr_storage;
   if (!done) {
     PERF_TIMER_GUARD(get_from_output_files_time);
-    sv->current->Get(
-        read_options, lkey, get_impl_options.value, timestamp, &s,
-        &merge_context, &max_covering_tombstone_seq, &pinned_iters_mgr,
-        get_impl_options.get_value ? get_impl_options.value_found : nullptr,
-        nullptr, nullptr,
-        get_impl_options.get_value ? get_impl_options.callback : nullptr,
-        get_impl_options.get_value ? get_impl_options.is_blob_index : nullptr,
-        get_impl_options.get_value);
-    RecordTick(stats_, MEMTABLE_MISS);
+    // The negative lookup cache records misses against a specific
+    // superversion, so it is only sound for reads at the latest sequence
+    // with no read callback: for those, everything in this superversion's
+    // table files was already visible when the miss was recorded, making
+    // the miss independent of the reader's snapshot. Entries recorded
+    // under an older superversion never match and get reclaimed lazily.
+    NegativeLookupCache* neg_cache =
+        immutable_db_options_.negative_lookup_cache.get();
+    // The same restrictions make the row lookup cache sound: everything in
+    // this superversion's table files was already visible when the row was
+    // recorded, so the cached value is what any latest-sequence read would
+    // get from the files, and anything newer lives in the memtables probed
+    // above.
+    // A range tombstone found by the memtable pass makes both caches
+    // unsound: it hides whatever the files hold without advancing the new
+    // data epoch, so a cached row would resurrect deleted data and a
+    // cached miss could outlive the tombstone.
+    const bool lookup_cache_eligible =
+        get_impl_options.get_value && get_impl_options.callback == nullptr &&
+        get_impl_options.value_found == nullptr &&
+        get_impl_options.is_blob_index == nullptr &&
+        read_options.snapshot == nullptr && ucmp->timestamp_size() == 0 &&
+        !s.IsMergeInProgress() && max_covering_tombstone_seq == 0;
+    const bool neg_cache_eligible =
+        neg_cache != nullptr && lookup_cache_eligible;
+    const bool row_cache_eligible =
+        row_lookup_cache != nullptr && lookup_cache_eligible;
+    if (neg_cache_eligible &&
+        neg_cache->KnownNotFound(cfd->GetID(), key, sv->version_number)) {
+      s = Status::NotFound();
+      RecordTick(stats_, MEMTABLE_MISS);
+    } else if (row_cache_eligible &&
+               row_lookup_cache->Lookup(cfd->GetID(), key,
+                                        cfd->GetNewDataEpoch(),
+                                        get_impl_options.value->GetSelf())) {
+      get_impl_options.value->PinSelf();
+      RecordTick(stats_, ROW_CACHE_HIT);
+      RecordTick(stats_, MEMTABLE_MISS);
+    } else {
+      if (row_cache_eligible) {
+        RecordTick(stats_, ROW_CACHE_MISS);
+      }
+      sv->current->Get(
+          read_options, lkey, get_impl_options.value, timestamp, &s,
+          &merge_context, &max_covering_tombstone_seq, pinned_iters_mgr,
+          get_impl_options.get_value ? get_impl_options.value_found : nullptr,
+          nullptr, nullptr,
+          get_impl_options.get_value ? get_impl_options.callback : nullptr,
+          get_impl_options.get_value ? get_impl_options.is_blob_index : nullptr,
+          get_impl_options.get_value);
+      RecordTick(stats_, MEMTABLE_MISS);
+      if (neg_cache_eligible && s.IsNotFound()) {
+        neg_cache->Insert(cfd->GetID(), key, sv->version_number);
+      }
+      if (row_cache_eligible && s.ok()) {
+        row_lookup_cache->Insert(cfd->GetID(), key, row_cache_insert_epoch,
+                                 *get_impl_options.value);
+      }
+    }
   }
 
   {
@@ -1985,6 +2180,14 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     if (s.ok()) {
       if (get_impl_options.get_value) {
         size = get_impl_options.value->size();
+      } else if (get_impl_options.merge_operands_iter != nullptr) {
+        // Hand all merge operands for get_impl_options.key over to the lazy
+        // iterator without copying them
+        for (const Slice& sl : merge_context.GetOperands()) {
+          size += sl.size();
+        }
+        get_impl_options.merge_operands_iter->SetOperands(
+            std::move(merge_context));
       } else {
         // Return all merge operands for get_impl_options.key
         *get_impl_options.number_of_operands =
@@ -2007,7 +2210,31 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     }
     RecordInHistogram(stats_, BYTES_PER_READ, size);
 
-    ReturnAndCleanupSuperVersion(cfd, sv);
+    if (get_impl_options.merge_operands_iter != nullptr && s.ok()) {
+      // The iterator's operand slices point into the superversion's
+      // memtables and pinned blocks, so the reference is handed over
+      // instead of being released here
+      get_impl_options.merge_operands_iter->TakeSuperVersion(this, cfd, sv);
+    } else {
+      ReturnAndCleanupSuperVersion(cfd, sv);
+    }
+  }
+  return s;
+}
+
+Status DBImpl::GetMergeOperandsIterator(
+    const ReadOptions& read_options, ColumnFamilyHandle* column_family,
+    const Slice& key, std::unique_ptr<MergeOperandsIterator>* iterator) {
+  assert(iterator != nullptr);
+  iterator->reset();
+  auto impl = std::make_unique<MergeOperandsIteratorImpl>();
+  GetImplOptions get_impl_options;
+  get_impl_options.column_family = column_family;
+  get_impl_options.get_value = false;
+  get_impl_options.merge_operands_iter = impl.get();
+  Status s = GetImpl(read_options, key, get_impl_options);
+  if (s.ok()) {
+    *iterator = std::move(impl);
   }
   return s;
 }
@@ -2025,6 +2252,11 @@ std::vector<Status> DBImpl::MultiGet(
     const std::vector<ColumnFamilyHandle*>& column_family,
     const std::vector<Slice>& keys, std::vector<std::string>* values,
     std::vector<std::string>* timestamps) {
+  PerfSampler::ScopedSample perf_sample(perf_sampler_.get(),
+                                        PerfSampler::kMultiGet);
+  SLOTracker::ScopedTimer slo_timer(immutable_db_options_.slo_tracker.get(),
+                                    SLOTracker::kMultiGet);
+  ScopedRequestPerfContext request_perf(read_options.request_perf_context);
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
   StopWatch sw(immutable_db_options_.clock, stats_, DB_MULTIGET);
   PERF_TIMER_GUARD(get_snapshot_time);
@@ -2449,21 +2681,60 @@ void DBImpl::MultiGet(const ReadOptions& read_options, const size_t num_keys,
   }
 
   Status s;
-  auto cf_iter = multiget_cf_data.begin();
-  for (; cf_iter != multiget_cf_data.end(); ++cf_iter) {
-    s = MultiGetImpl(read_options, cf_iter->start, cf_iter->num_keys,
-                     &sorted_keys, cf_iter->super_version, consistent_seqnum,
-                     read_callback);
-    if (!s.ok()) {
-      break;
+#if USE_COROUTINES
+  if (read_options.async_io && using_coroutines() &&
+      multiget_cf_data.size() > 1) {
+    // Process the column families concurrently. The superversions were all
+    // acquired above, so every CF's filter/index probes and data block
+    // reads can be issued together and waited for at a single completion
+    // point. The reader is shared so one wait loop drives the IO of all
+    // the per-CF tasks.
+    AsyncFileReader reader(GetFileSystem(), stats_);
+    SingleThreadExecutor executor(reader);
+    std::vector<ROCKSDB_CORO_TASK<Status>> cf_tasks;
+    cf_tasks.reserve(multiget_cf_data.size());
+    for (const auto& mgd : multiget_cf_data) {
+      cf_tasks.emplace_back(MultiGetImplCoroutine(
+          read_options, mgd.start, mgd.num_keys, &sorted_keys,
+          mgd.super_version, consistent_seqnum, read_callback, &reader));
+    }
+    // Not named `statuses`: that would shadow the output parameter.
+#if defined(USE_STD_COROUTINES)
+    std::vector<Status> cf_statuses =
+        executor.BlockingCollectAll(std::move(cf_tasks));
+#else
+    std::vector<Status> cf_statuses = folly::coro::blockingWait(
+        folly::coro::collectAllRange(std::move(cf_tasks))
+            .scheduleOn(&executor));
+#endif
+    for (const Status& stat : cf_statuses) {
+      if (!stat.ok()) {
+        // Each CF's MultiGetImpl has already set the statuses of its own
+        // keys, so there is nothing left to propagate here.
+        assert(stat.IsTimedOut() || stat.IsAborted());
+        s = stat;
+        break;
+      }
     }
-  }
-  if (!s.ok()) {
-    assert(s.IsTimedOut() || s.IsAborted());
-    for (++cf_iter; cf_iter != multiget_cf_data.end(); ++cf_iter) {
-      for (size_t i = cf_iter->start; i < cf_iter->start + cf_iter->num_keys;
-           ++i) {
-        *sorted_keys[i]->s = s;
+  } else
+#endif  // USE_COROUTINES
+  {
+    auto cf_iter = multiget_cf_data.begin();
+    for (; cf_iter != multiget_cf_data.end(); ++cf_iter) {
+      s = MultiGetImpl(read_options, cf_iter->start, cf_iter->num_keys,
+                       &sorted_keys, cf_iter->super_version, consistent_seqnum,
+                       read_callback, /*shared_reader=*/nullptr);
+      if (!s.ok()) {
+        break;
+      }
+    }
+    if (!s.ok()) {
+      assert(s.IsTimedOut() || s.IsAborted());
+      for (++cf_iter; cf_iter != multiget_cf_data.end(); ++cf_iter) {
+        for (size_t i = cf_iter->start; i < cf_iter->start + cf_iter->num_keys;
+             ++i) {
+          *sorted_keys[i]->s = s;
+        }
       }
     }
   }
@@ -2613,126 +2884,28 @@ void DBImpl::MultiGetWithCallback(
 
   Status s = MultiGetImpl(read_options, 0, num_keys, sorted_keys,
                           multiget_cf_data[0].super_version, consistent_seqnum,
-                          read_callback);
+                          read_callback, /*shared_reader=*/nullptr);
   assert(s.ok() || s.IsTimedOut() || s.IsAborted());
   ReturnAndCleanupSuperVersion(multiget_cf_data[0].cfd,
                                multiget_cf_data[0].super_version);
 }
 
-// The actual implementation of batched MultiGet. Parameters -
-// start_key - Index in the sorted_keys vector to start processing from
-// num_keys - Number of keys to lookup, starting with sorted_keys[start_key]
-// sorted_keys - The entire batch of sorted keys for this CF
-//
-// The per key status is returned in the KeyContext structures pointed to by
-// sorted_keys. An overall Status is also returned, with the only possible
-// values being Status::OK() and Status::TimedOut(). The latter indicates
-// that the call exceeded read_options.deadline
-Status DBImpl::MultiGetImpl(
-    const ReadOptions& read_options, size_t start_key, size_t num_keys,
-    autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
-    SuperVersion* super_version, SequenceNumber snapshot,
-    ReadCallback* callback) {
-  PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
-  StopWatch sw(immutable_db_options_.clock, stats_, DB_MULTIGET);
-
-  assert(sorted_keys);
-  // Clear the timestamps for returning results so that we can distinguish
-  // between tombstone or key that has never been written
-  for (auto* kctx : *sorted_keys) {
-    assert(kctx);
-    if (kctx->timestamp) {
-      kctx->timestamp->clear();
-    }
-  }
-
-  // For each of the given keys, apply the entire "get" process as follows:
-  // First look in the memtable, then in the immutable memtable (if any).
-  // s is both in/out. When in, s could either be OK or MergeInProgress.
-  // merge_operands will contain the sequence of merges in the latter case.
-  size_t keys_left = num_keys;
-  Status s;
-  uint64_t curr_value_size = 0;
-  while (keys_left) {
-    if (read_options.deadline.count() &&
-        immutable_db_options_.clock->NowMicros() >
-            static_cast<uint64_t>(read_options.deadline.count())) {
-      s = Status::TimedOut();
-      break;
-    }
-
-    size_t batch_size = (keys_left > MultiGetContext::MAX_BATCH_SIZE)
-                            ? MultiGetContext::MAX_BATCH_SIZE
-                            : keys_left;
-    MultiGetContext ctx(sorted_keys, start_key + num_keys - keys_left,
-                        batch_size, snapshot, read_options, GetFileSystem(),
-                        stats_);
-    MultiGetRange range = ctx.GetMultiGetRange();
-    range.AddValueSize(curr_value_size);
-    bool lookup_current = false;
-
-    keys_left -= batch_size;
-    for (auto mget_iter = range.begin(); mget_iter != range.end();
-         ++mget_iter) {
-      mget_iter->merge_context.Clear();
-      *mget_iter->s = Status::OK();
-    }
-
-    bool skip_memtable =
-        (read_options.read_tier == kPersistedTier &&
-         has_unpersisted_data_.load(std::memory_order_relaxed));
-    if (!skip_memtable) {
-      super_version->mem->MultiGet(read_options, &range, callback);
-      if (!range.empty()) {
-        super_version->imm->MultiGet(read_options, &range, callback);
-      }
-      if (!range.empty()) {
-        lookup_current = true;
-        uint64_t left = range.KeysLeft();
-        RecordTick(stats_, MEMTABLE_MISS, left);
-      }
-    }
-    if (lookup_current) {
-      PERF_TIMER_GUARD(get_from_output_files_time);
-      super_version->current->MultiGet(read_options, &range, callback);
-    }
-    curr_value_size = range.GetValueSize();
-    if (curr_value_size > read_options.value_size_soft_limit) {
-      s = Status::Aborted();
-      break;
-    }
-  }
-
-  // Post processing (decrement reference counts and record statistics)
-  PERF_TIMER_GUARD(get_post_process_time);
-  size_t num_found = 0;
-  uint64_t bytes_read = 0;
-  for (size_t i = start_key; i < start_key + num_keys - keys_left; ++i) {
-    KeyContext* key = (*sorted_keys)[i];
-    if (key->s->ok()) {
-      bytes_read += key->value->size();
-      num_found++;
-    }
-  }
-  if (keys_left) {
-    assert(s.IsTimedOut() || s.IsAborted());
-    for (size_t i = start_key + num_keys - keys_left; i < start_key + num_keys;
-         ++i) {
-      KeyContext* key = (*sorted_keys)[i];
-      *key->s = s;
-    }
-  }
+}  // namespace ROCKSDB_NAMESPACE
 
-  RecordTick(stats_, NUMBER_MULTIGET_CALLS);
-  RecordTick(stats_, NUMBER_MULTIGET_KEYS_READ, num_keys);
-  RecordTick(stats_, NUMBER_MULTIGET_KEYS_FOUND, num_found);
-  RecordTick(stats_, NUMBER_MULTIGET_BYTES_READ, bytes_read);
-  RecordInHistogram(stats_, BYTES_PER_MULTIGET, bytes_read);
-  PERF_COUNTER_ADD(multiget_read_bytes, bytes_read);
-  PERF_TIMER_STOP(get_post_process_time);
+// Generate the regular and coroutine versions of some methods by
+// including db_impl_sync_and_async.h twice
+// Macros in the header will expand differently based on whether
+// WITH_COROUTINES or WITHOUT_COROUTINES is defined
+// clang-format off
+#define WITHOUT_COROUTINES
+#include "db/db_impl/db_impl_sync_and_async.h"
+#undef WITHOUT_COROUTINES
+#define WITH_COROUTINES
+#include "db/db_impl/db_impl_sync_and_async.h"
+#undef WITH_COROUTINES
+// clang-format on
 
-  return s;
-}
+namespace ROCKSDB_NAMESPACE {
 
 Status DBImpl::CreateColumnFamily(const ColumnFamilyOptions& cf_options,
                                   const std::string& column_family,
@@ -3157,11 +3330,13 @@ ArenaWrappedDBIter* DBImpl::NewIteratorImpl(const ReadOptions& read_options,
       sv->version_number, read_callback, this, cfd, expose_blob_index,
       read_options.snapshot != nullptr ? false : allow_refresh);
 
+  InternalIterator* merging_iter = nullptr;
   InternalIterator* internal_iter = NewInternalIterator(
       db_iter->GetReadOptions(), cfd, sv, db_iter->GetArena(),
       db_iter->GetRangeDelAggregator(), snapshot,
-      /* allow_unprepared_value */ true);
+      /* allow_unprepared_value */ true, &merging_iter);
   db_iter->SetIterUnderDBIter(internal_iter);
+  db_iter->SetMergingIterator(merging_iter, sv->mem);
 
   return db_iter;
 }
@@ -3244,6 +3419,11 @@ const Snapshot* DBImpl::GetSnapshotForWriteConflictBoundary() {
 }
 #endif  // ROCKSDB_LITE
 
+const Snapshot* DBImpl::GetSnapshotWithLease(uint64_t lease_seconds) {
+  return GetSnapshotImpl(false /* is_write_conflict_boundary */,
+                         true /* lock */, lease_seconds);
+}
+
 std::pair<Status, std::shared_ptr<const Snapshot>>
 DBImpl::CreateTimestampedSnapshot(SequenceNumber snapshot_seq, uint64_t ts) {
   assert(ts != std::numeric_limits<uint64_t>::max());
@@ -3287,10 +3467,14 @@ Status DBImpl::GetTimestampedSnapshots(
 }
 
 SnapshotImpl* DBImpl::GetSnapshotImpl(bool is_write_conflict_boundary,
-                                      bool lock) {
+                                      bool lock, uint64_t lease_seconds) {
   int64_t unix_time = 0;
   immutable_db_options_.clock->GetCurrentTime(&unix_time)
       .PermitUncheckedError();  // Ignore error
+  int64_t expiry_unix_time = 0;
+  if (lease_seconds > 0) {
+    expiry_unix_time = unix_time + static_cast<int64_t>(lease_seconds);
+  }
   SnapshotImpl* s = new SnapshotImpl;
 
   if (lock) {
@@ -3308,7 +3492,8 @@ SnapshotImpl* DBImpl::GetSnapshotImpl(bool is_write_conflict_boundary,
   }
   auto snapshot_seq = GetLastPublishedSequence();
   SnapshotImpl* snapshot =
-      snapshots_.New(s, snapshot_seq, unix_time, is_write_conflict_boundary);
+      snapshots_.New(s, snapshot_seq, unix_time, is_write_conflict_boundary,
+                     std::numeric_limits<uint64_t>::max(), expiry_unix_time);
   if (lock) {
     mutex_.Unlock();
   }
@@ -3635,6 +3820,8 @@ bool DBImpl::GetMapProperty(ColumnFamilyHandle* column_family,
       return cfd->internal_stats()->GetMapProperty(*property_info, property,
                                                    value);
     }
+  } else if (property_info->handle_map_dbimpl) {
+    return (this->*(property_info->handle_map_dbimpl))(value);
   }
   // If we reach this point it means that handle_map is not provided for the
   // requested property
@@ -3693,6 +3880,77 @@ bool DBImpl::GetPropertyHandleOptionsStatistics(std::string* value) {
   return true;
 }
 
+bool DBImpl::GetPropertyHandlePerfSampleStats(
+    std::map<std::string, std::string>* stats) {
+  assert(stats != nullptr);
+  if (!perf_sampler_) {
+    return false;
+  }
+  perf_sampler_->GetStats(stats);
+  return true;
+}
+
+bool DBImpl::GetPropertyHandleSLOStats(
+    std::map<std::string, std::string>* stats) {
+  assert(stats != nullptr);
+  SLOTracker* tracker = immutable_db_options_.slo_tracker.get();
+  if (tracker == nullptr) {
+    return false;
+  }
+  static const std::string op_names[SLOTracker::kNumOpTypes] = {
+      "get", "multiget", "seek", "next", "write"};
+  for (uint32_t op = 0; op < SLOTracker::kNumOpTypes; ++op) {
+    const auto op_type = static_cast<SLOTracker::OpType>(op);
+    HistogramData data;
+    tracker->GetHistogramData(op_type, &data);
+    (*stats)[op_names[op] + ".count"] = std::to_string(data.count);
+    (*stats)[op_names[op] + ".p50"] = std::to_string(data.median);
+    (*stats)[op_names[op] + ".p95"] = std::to_string(data.percentile95);
+    (*stats)[op_names[op] + ".p99"] = std::to_string(data.percentile99);
+    (*stats)[op_names[op] + ".p999"] =
+        std::to_string(tracker->GetPercentile(op_type, 99.9));
+  }
+  return true;
+}
+
+bool DBImpl::GetPropertyHandleDBMutexContentionStats(std::string* value) {
+  assert(value != nullptr);
+  std::vector<MutexCallSiteContention> sites;
+  mutex_.GetCallSiteContention(&sites);
+  // Worst offenders first.
+  std::sort(sites.begin(), sites.end(),
+            [](const MutexCallSiteContention& a,
+               const MutexCallSiteContention& b) {
+              return a.wait_time_nanos > b.wait_time_nanos;
+            });
+  std::string result =
+      "site                                     locked     waited "
+      "wait_micros hold_micros max_waiters\n";
+  char buf[200];
+  for (const auto& site : sites) {
+    const char* file = site.file != nullptr ? site.file : "(unknown)";
+    // Print the path relative to the last directory separator.
+    const char* base = strrchr(file, '/');
+    if (base != nullptr) {
+      file = base + 1;
+    }
+    snprintf(buf, sizeof(buf), "%s:%d", file, site.line);
+    std::string line(buf);
+    if (line.size() < 36) {
+      line.append(36 - line.size(), ' ');
+    }
+    snprintf(buf, sizeof(buf),
+             " %10" PRIu64 " %10" PRIu64 " %11" PRIu64 " %11" PRIu64
+             " %11" PRIu64 "\n",
+             site.lock_count, site.wait_count, site.wait_time_nanos / 1000,
+             site.hold_time_nanos / 1000, site.max_waiter_depth);
+    line.append(buf);
+    result.append(line);
+  }
+  *value = std::move(result);
+  return true;
+}
+
 #ifndef ROCKSDB_LITE
 Status DBImpl::ResetStats() {
   InstrumentedMutexLock l(&mutex_);
@@ -4980,6 +5238,20 @@ Status DBImpl::IngestExternalFiles(
     return status;
   }
 
+  // Ingest-behind bulk loads do not need to stop the write threads: the
+  // files are placed at the bottommost level with zeroed sequence numbers,
+  // below every live key, so concurrent foreground writes can never be
+  // shadowed by them and no sequence numbers are consumed. We only fall
+  // back to stopping writes when an ingested range overlaps the memtable
+  // and a flush is required.
+  bool stall_free_ingest = true;
+  for (const auto& arg : args) {
+    if (!arg.options.ingest_behind) {
+      stall_free_ingest = false;
+      break;
+    }
+  }
+
   std::vector<SuperVersionContext> sv_ctxs;
   for (size_t i = 0; i != num_cfs; ++i) {
     sv_ctxs.emplace_back(true /* create_superversion */);
@@ -4991,20 +5263,28 @@ Status DBImpl::IngestExternalFiles(
     InstrumentedMutexLock l(&mutex_);
     TEST_SYNC_POINT("DBImpl::AddFile:MutexLock");
 
-    // Stop writes to the DB by entering both write threads
     WriteThread::Writer w;
-    write_thread_.EnterUnbatched(&w, &mutex_);
     WriteThread::Writer nonmem_w;
-    if (two_write_queues_) {
-      nonmem_write_thread_.EnterUnbatched(&nonmem_w, &mutex_);
-    }
+    bool writes_stopped = false;
+    auto stop_writes = [&]() {
+      // Stop writes to the DB by entering both write threads
+      write_thread_.EnterUnbatched(&w, &mutex_);
+      if (two_write_queues_) {
+        nonmem_write_thread_.EnterUnbatched(&nonmem_w, &mutex_);
+      }
 
-    // When unordered_write is enabled, the keys are writing to memtable in an
-    // unordered way. If the ingestion job checks memtable key range before the
-    // key landing in memtable, the ingestion job may skip the necessary
-    // memtable flush.
-    // So wait here to ensure there is no pending write to memtable.
-    WaitForPendingWrites();
+      // When unordered_write is enabled, the keys are writing to memtable in
+      // an unordered way. If the ingestion job checks memtable key range
+      // before the key landing in memtable, the ingestion job may skip the
+      // necessary memtable flush.
+      // So wait here to ensure there is no pending write to memtable.
+      WaitForPendingWrites();
+      writes_stopped = true;
+      TEST_SYNC_POINT("DBImpl::IngestExternalFiles:StopWrites");
+    };
+    if (!stall_free_ingest) {
+      stop_writes();
+    }
 
     num_running_ingest_file_ += static_cast<int>(num_cfs);
     TEST_SYNC_POINT("DBImpl::IngestExternalFile:AfterIncIngestFileCounter");
@@ -5033,6 +5313,11 @@ Status DBImpl::IngestExternalFiles(
                              &at_least_one_cf_need_flush);
 
     if (status.ok() && at_least_one_cf_need_flush) {
+      // An ingested range overlapping the memtable forces the
+      // write-stopping path even for ingest-behind.
+      if (!writes_stopped) {
+        stop_writes();
+      }
       FlushOptions flush_opts;
       flush_opts.allow_write_stall = true;
       if (immutable_db_options_.atomic_flush) {
@@ -5152,10 +5437,12 @@ Status DBImpl::IngestExternalFiles(
     }
 
     // Resume writes to the DB
-    if (two_write_queues_) {
-      nonmem_write_thread_.ExitUnbatched(&nonmem_w);
+    if (writes_stopped) {
+      if (two_write_queues_) {
+        nonmem_write_thread_.ExitUnbatched(&nonmem_w);
+      }
+      write_thread_.ExitUnbatched(&w);
     }
-    write_thread_.ExitUnbatched(&w);
 
     if (status.ok()) {
       for (auto& job : ingestion_jobs) {
@@ -5327,11 +5614,6 @@ Status DBImpl::VerifyChecksum(const ReadOptions& read_options) {
 
 Status DBImpl::VerifyChecksumInternal(const ReadOptions& read_options,
                                       bool use_file_checksum) {
-  // `bytes_read` stat is enabled based on compile-time support and cannot
-  // be dynamically toggled. So we do not need to worry about `PerfLevel`
-  // here, unlike many other `IOStatsContext` / `PerfContext` stats.
-  uint64_t prev_bytes_read = IOSTATS(bytes_read);
-
   Status s;
 
   if (use_file_checksum) {
@@ -5345,6 +5627,11 @@ Status DBImpl::VerifyChecksumInternal(const ReadOptions& read_options,
     }
   }
 
+  // Verification reads the whole DB once; don't let it displace the
+  // working set from the block cache.
+  ReadOptions verify_read_options = read_options;
+  verify_read_options.fill_cache = false;
+
   // TODO: simplify using GetRefedColumnFamilySet?
   std::vector<ColumnFamilyData*> cfd_list;
   {
@@ -5361,62 +5648,166 @@ Status DBImpl::VerifyChecksumInternal(const ReadOptions& read_options,
     sv_list.push_back(cfd->GetReferencedSuperVersion(this));
   }
 
-  for (auto& sv : sv_list) {
+  // Flatten the live files of all column families into one work list so
+  // they can be verified concurrently and scheduled by priority.
+  struct VerifyWorkItem {
+    uint64_t file_number;
+    bool is_blob;
+    std::string fname;
+    size_t cf_index;  // index into cf_opts
+    uint64_t largest_seqno;
+    std::string expected_checksum;
+    std::string checksum_func_name;
+  };
+  std::vector<VerifyWorkItem> work;
+  std::vector<Options> cf_opts(sv_list.size());
+  for (size_t cf = 0; cf < sv_list.size(); ++cf) {
+    SuperVersion* sv = sv_list[cf];
     VersionStorageInfo* vstorage = sv->current->storage_info();
     ColumnFamilyData* cfd = sv->current->cfd();
-    Options opts;
     if (!use_file_checksum) {
       InstrumentedMutexLock l(&mutex_);
-      opts = Options(BuildDBOptions(immutable_db_options_, mutable_db_options_),
-                     cfd->GetLatestCFOptions());
+      cf_opts[cf] =
+          Options(BuildDBOptions(immutable_db_options_, mutable_db_options_),
+                  cfd->GetLatestCFOptions());
     }
-    for (int i = 0; i < vstorage->num_non_empty_levels() && s.ok(); i++) {
-      for (size_t j = 0; j < vstorage->LevelFilesBrief(i).num_files && s.ok();
-           j++) {
+    for (int i = 0; i < vstorage->num_non_empty_levels(); i++) {
+      for (size_t j = 0; j < vstorage->LevelFilesBrief(i).num_files; j++) {
         const auto& fd_with_krange = vstorage->LevelFilesBrief(i).files[j];
         const auto& fd = fd_with_krange.fd;
         const FileMetaData* fmeta = fd_with_krange.file_metadata;
         assert(fmeta);
         std::string fname = TableFileName(cfd->ioptions()->cf_paths,
                                           fd.GetNumber(), fd.GetPathId());
-        if (use_file_checksum) {
-          s = VerifyFullFileChecksum(fmeta->file_checksum,
-                                     fmeta->file_checksum_func_name, fname,
-                                     read_options);
-        } else {
-          s = ROCKSDB_NAMESPACE::VerifySstFileChecksum(
-              opts, file_options_, read_options, fname, fd.largest_seqno);
-        }
-        RecordTick(stats_, VERIFY_CHECKSUM_READ_BYTES,
-                   IOSTATS(bytes_read) - prev_bytes_read);
-        prev_bytes_read = IOSTATS(bytes_read);
+        work.push_back(VerifyWorkItem{
+            fd.GetNumber(), /*is_blob=*/false, std::move(fname), cf,
+            fd.largest_seqno, fmeta->file_checksum,
+            fmeta->file_checksum_func_name});
       }
     }
 
-    if (s.ok() && use_file_checksum) {
+    if (use_file_checksum) {
       const auto& blob_files = vstorage->GetBlobFiles();
       for (const auto& meta : blob_files) {
         assert(meta);
 
         const uint64_t blob_file_number = meta->GetBlobFileNumber();
 
-        const std::string blob_file_name = BlobFileName(
+        std::string blob_file_name = BlobFileName(
             cfd->ioptions()->cf_paths.front().path, blob_file_number);
-        s = VerifyFullFileChecksum(meta->GetChecksumValue(),
-                                   meta->GetChecksumMethod(), blob_file_name,
-                                   read_options);
-        RecordTick(stats_, VERIFY_CHECKSUM_READ_BYTES,
-                   IOSTATS(bytes_read) - prev_bytes_read);
-        prev_bytes_read = IOSTATS(bytes_read);
-        if (!s.ok()) {
-          break;
+        work.push_back(VerifyWorkItem{
+            blob_file_number, /*is_blob=*/true, std::move(blob_file_name), cf,
+            0, meta->GetChecksumValue(), meta->GetChecksumMethod()});
+      }
+    }
+  }
+
+  // Verify files that have never been verified first, newest (highest
+  // file number, i.e. most recently written) ahead of older ones; after
+  // that, files whose last successful verification is the oldest. Since
+  // progress is persisted as files complete, a verification that gets
+  // interrupted - even by a restart - picks up where it left off.
+  std::unordered_map<uint64_t, uint64_t> progress =
+      LoadChecksumVerificationProgress();
+  std::stable_sort(work.begin(), work.end(),
+                   [&progress](const VerifyWorkItem& a,
+                               const VerifyWorkItem& b) {
+                     auto ita = progress.find(a.file_number);
+                     auto itb = progress.find(b.file_number);
+                     const bool a_new = ita == progress.end();
+                     const bool b_new = itb == progress.end();
+                     if (a_new != b_new) {
+                       return a_new;
+                     }
+                     if (a_new) {
+                       return a.file_number > b.file_number;
+                     }
+                     return ita->second < itb->second;
+                   });
+  // Forget files that are no longer live so the progress file can't grow
+  // without bound.
+  {
+    std::unordered_set<uint64_t> live;
+    for (const auto& item : work) {
+      live.insert(item.file_number);
+    }
+    for (auto it = progress.begin(); it != progress.end();) {
+      if (live.find(it->first) == live.end()) {
+        it = progress.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Checkpoint the progress file every this many verified files.
+  const size_t kProgressCheckpointInterval = 32;
+
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+  port::Mutex result_mutex;  // guards s, progress and the counter below
+  size_t verified_since_checkpoint = 0;
+
+  auto worker = [&]() {
+    // `bytes_read` stat is enabled based on compile-time support and cannot
+    // be dynamically toggled. So we do not need to worry about `PerfLevel`
+    // here, unlike many other `IOStatsContext` / `PerfContext` stats.
+    // IOStatsContext is thread local, so each worker tracks its own delta.
+    uint64_t prev_bytes_read = IOSTATS(bytes_read);
+    size_t i;
+    while (!failed.load(std::memory_order_relaxed) &&
+           (i = next_file.fetch_add(1)) < work.size()) {
+      const VerifyWorkItem& item = work[i];
+      Status item_s;
+      if (use_file_checksum || item.is_blob) {
+        item_s =
+            VerifyFullFileChecksum(item.expected_checksum,
+                                   item.checksum_func_name, item.fname,
+                                   verify_read_options);
+      } else {
+        item_s = ROCKSDB_NAMESPACE::VerifySstFileChecksum(
+            cf_opts[item.cf_index], file_options_, verify_read_options,
+            item.fname, item.largest_seqno);
+      }
+      RecordTick(stats_, VERIFY_CHECKSUM_READ_BYTES,
+                 IOSTATS(bytes_read) - prev_bytes_read);
+      prev_bytes_read = IOSTATS(bytes_read);
+
+      MutexLock l(&result_mutex);
+      if (!item_s.ok()) {
+        if (s.ok()) {
+          s = item_s;
         }
+        failed.store(true, std::memory_order_relaxed);
+        break;
+      }
+      progress[item.file_number] = immutable_db_options_.clock->NowMicros();
+      if (++verified_since_checkpoint >= kProgressCheckpointInterval) {
+        verified_since_checkpoint = 0;
+        SaveChecksumVerificationProgress(progress);
       }
     }
-    if (!s.ok()) {
-      break;
+  };
+
+  const int num_threads = static_cast<int>(std::min(
+      work.size(),
+      static_cast<size_t>(
+          std::max(1, immutable_db_options_.max_verify_checksum_threads))));
+  if (num_threads <= 1) {
+    worker();
+  } else {
+    std::vector<port::Thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+      thread.join();
     }
   }
+  if (!work.empty()) {
+    SaveChecksumVerificationProgress(progress);
+  }
 
   bool defer_purge =
           immutable_db_options().avoid_unnecessary_blocking_io;
@@ -5439,11 +5830,49 @@ Status DBImpl::VerifyChecksumInternal(const ReadOptions& read_options,
       cfd->UnrefAndTryDelete();
     }
   }
-  RecordTick(stats_, VERIFY_CHECKSUM_READ_BYTES,
-             IOSTATS(bytes_read) - prev_bytes_read);
   return s;
 }
 
+std::unordered_map<uint64_t, uint64_t>
+DBImpl::LoadChecksumVerificationProgress() {
+  std::unordered_map<uint64_t, uint64_t> progress;
+  std::string contents;
+  Status s = ReadFileToString(
+      fs_.get(), VerifyChecksumProgressFileName(dbname_), &contents);
+  if (!s.ok()) {
+    // Missing on a DB that has never been verified; nothing to resume.
+    s.PermitUncheckedError();
+    return progress;
+  }
+  // One "<file number> <last verified micros>" pair per line. Malformed
+  // content (e.g. a write cut short by a crash) is simply ignored.
+  std::istringstream iss(contents);
+  uint64_t file_number;
+  uint64_t verified_micros;
+  while (iss >> file_number >> verified_micros) {
+    progress[file_number] = verified_micros;
+  }
+  return progress;
+}
+
+void DBImpl::SaveChecksumVerificationProgress(
+    const std::unordered_map<uint64_t, uint64_t>& progress) {
+  std::string contents;
+  for (const auto& entry : progress) {
+    contents.append(std::to_string(entry.first));
+    contents.push_back(' ');
+    contents.append(std::to_string(entry.second));
+    contents.push_back('\n');
+  }
+  // Best effort: a failed or torn write only costs re-verifying some
+  // files on the next run.
+  IOStatus io_s =
+      WriteStringToFile(fs_.get(), contents,
+                        VerifyChecksumProgressFileName(dbname_),
+                        /*should_sync=*/true);
+  io_s.PermitUncheckedError();
+}
+
 Status DBImpl::VerifyFullFileChecksum(const std::string& file_checksum_expected,
                                       const std::string& func_name_expected,
                                       const std::string& fname,
@@ -16,6 +16,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -63,6 +64,7 @@
 #include "table/merging_iterator.h"
 #include "table/scoped_arena_iterator.h"
 #include "util/autovector.h"
+#include "util/coro_utils.h"
 #include "util/hash.h"
 #include "util/repeatable_thread.h"
 #include "util/stop_watch.h"
@@ -72,9 +74,12 @@ namespace ROCKSDB_NAMESPACE {
 
 class Arena;
 class ArenaWrappedDBIter;
+class AsyncFileReader;
 class InMemoryStatsHistoryIterator;
 class MemTable;
+class MergeOperandsIteratorImpl;
 class PersistentStatsHistoryIterator;
+class PerfSampler;
 class PeriodicWorkScheduler;
 #ifndef NDEBUG
 class PeriodicWorkTestScheduler;
@@ -257,6 +262,12 @@ class DBImpl : public DB {
                      ColumnFamilyHandle* column_family, const Slice& key,
                      PinnableSlice* value, std::string* timestamp) override;
 
+  using DB::GetAsync;
+  virtual void GetAsync(const ReadOptions& options,
+                        ColumnFamilyHandle* column_family, const Slice& key,
+                        PinnableSlice* value,
+                        std::function<void(Status)> callback) override;
+
   using DB::GetMergeOperands;
   Status GetMergeOperands(const ReadOptions& options,
                           ColumnFamilyHandle* column_family, const Slice& key,
@@ -272,6 +283,12 @@ class DBImpl : public DB {
     return GetImpl(options, key, get_impl_options);
   }
 
+  using DB::GetMergeOperandsIterator;
+  Status GetMergeOperandsIterator(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      const Slice& key,
+      std::unique_ptr<MergeOperandsIterator>* iterator) override;
+
   using DB::MultiGet;
   virtual std::vector<Status> MultiGet(
       const ReadOptions& options,
@@ -496,6 +513,10 @@ class DBImpl : public DB {
       SequenceNumber seq_number, std::unique_ptr<TransactionLogIterator>* iter,
       const TransactionLogIterator::ReadOptions& read_options =
           TransactionLogIterator::ReadOptions()) override;
+  virtual Status RegisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& sink) override;
+  virtual Status UnregisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& sink) override;
   virtual Status DeleteFile(std::string name) override;
   Status DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                              const RangePtr* ranges, size_t n,
@@ -525,6 +546,12 @@ class DBImpl : public DB {
   Status PromoteL0(ColumnFamilyHandle* column_family,
                    int target_level) override;
 
+  Status GetScanPartitionBoundaries(ColumnFamilyHandle* column_family,
+                                    const Slice* begin, const Slice* end,
+                                    size_t max_partitions,
+                                    std::vector<std::string>* boundaries)
+      override;
+
   using DB::IngestExternalFile;
   virtual Status IngestExternalFile(
       ColumnFamilyHandle* column_family,
@@ -566,6 +593,18 @@ class DBImpl : public DB {
                                 const std::string& fpath,
                                 const ReadOptions& read_options);
 
+  // Best-effort persistence of checksum verification progress: a map from
+  // file number to the microsecond wall-clock time of the file's last
+  // successful verification, stored in a plain text file in the db dir.
+  // VerifyChecksumInternal uses it to schedule never-verified files first
+  // and to resume where an interrupted verification left off after a
+  // restart. Load returns an empty map if the file is missing or
+  // unreadable; Save failures are ignored (they only cost redundant
+  // re-verification later).
+  std::unordered_map<uint64_t, uint64_t> LoadChecksumVerificationProgress();
+  void SaveChecksumVerificationProgress(
+      const std::unordered_map<uint64_t, uint64_t>& progress);
+
   using DB::StartTrace;
   virtual Status StartTrace(
       const TraceOptions& options,
@@ -624,6 +663,12 @@ class DBImpl : public DB {
     PinnableSlice* merge_operands = nullptr;
     GetMergeOperandsOptions* get_merge_operands_options = nullptr;
     int* number_of_operands = nullptr;
+    // Only used when get_value is false. If set, the collected merge
+    // operands are handed over to this iterator as zero-copy slices instead
+    // of being copied into `merge_operands`, together with the block pins
+    // and the superversion reference that keep them alive. See
+    // DBImpl::GetMergeOperandsIterator().
+    MergeOperandsIteratorImpl* merge_operands_iter = nullptr;
   };
 
   // Function that Get and KeyMayExist call with no_io true or false
@@ -733,6 +778,16 @@ class DBImpl : public DB {
   // being detected.
   const Snapshot* GetSnapshotForWriteConflictBoundary();
 
+  // EXPERIMENTAL: similar to GetSnapshot(), but the snapshot is leased for
+  // `lease_seconds`. Until the lease expires the snapshot behaves like a
+  // regular one. After expiry, flushes and compactions stop keeping data
+  // visible to it alive, so reads through an expired snapshot may no longer
+  // find the versions it originally pinned. This keeps the snapshot list
+  // seen by compactions short when callers take many snapshots but only
+  // need consistency for a bounded amount of time. The caller still owns
+  // the handle and must release it with ReleaseSnapshot().
+  const Snapshot* GetSnapshotWithLease(uint64_t lease_seconds);
+
   // checks if all live files exist on file system and that their file sizes
   // match to our in-memory records
   virtual Status CheckConsistency();
@@ -809,9 +864,19 @@ class DBImpl : public DB {
   void PurgeObsoleteFiles(JobContext& background_contet,
                           bool schedule_only = false);
 
+  // Deallocate the garbage blob extents collected in `job` by punching holes
+  // in the blob file. Failures are logged and otherwise ignored; the space
+  // is reclaimed later when the file gets garbage collected or deleted.
+  // It is not necessary to hold the mutex when invoking this method.
+  void PunchBlobFileHoles(const BlobFilePunchHoleJob& job);
+
   // Schedule a background job to actually delete obsolete files.
   void SchedulePurge();
 
+  // Schedule a background job that warms the table cache level by level
+  // when lazy_open_table_files is set. REQUIRES: mutex held
+  void ScheduleTableFilePreload();
+
   const SnapshotList& snapshots() const { return snapshots_; }
 
   // load list of snapshots to `snap_vector` that is no newer than `max_seq`
@@ -885,13 +950,15 @@ class DBImpl : public DB {
   const WriteController& write_controller() { return write_controller_; }
 
   // @param read_options Must outlive the returned iterator.
-  InternalIterator* NewInternalIterator(const ReadOptions& read_options,
-                                        ColumnFamilyData* cfd,
-                                        SuperVersion* super_version,
-                                        Arena* arena,
-                                        RangeDelAggregator* range_del_agg,
-                                        SequenceNumber sequence,
-                                        bool allow_unprepared_value);
+  // If `merging_iter_out` is non-null, it is set to the merging iterator
+  // underlying the returned iterator (nullptr if there is only a single
+  // child iterator). See MergeIteratorBuilder::Finish().
+  InternalIterator* NewInternalIterator(
+      const ReadOptions& read_options, ColumnFamilyData* cfd,
+      SuperVersion* super_version, Arena* arena,
+      RangeDelAggregator* range_del_agg, SequenceNumber sequence,
+      bool allow_unprepared_value,
+      InternalIterator** merging_iter_out = nullptr);
 
   // hollow transactions shell used for recovery.
   // these will then be passed to TransactionDB so that
@@ -1189,6 +1256,11 @@ class DBImpl : public DB {
   // flush LOG out of application buffer
   void FlushInfoLog();
 
+  // periodically re-evaluate adaptive pinning of metadata partitions for
+  // all live table readers; see
+  // MetadataCacheOptions::adaptive_pinning_min_accesses
+  void MaintainAdaptiveMetadataPinning();
+
   // record current sequence number to time mapping
   void RecordSeqnoToTimeMapping();
 
@@ -1267,6 +1339,9 @@ class DBImpl : public DB {
   FileSystemPtr fs_;
   MutableDBOptions mutable_db_options_;
   Statistics* stats_;
+  // Samples perf-context timing for a fraction of read operations; non-null
+  // iff DBOptions::perf_sample_frequency is non-zero
+  std::unique_ptr<PerfSampler> perf_sampler_;
   std::unordered_map<std::string, RecoveredTransaction*>
       recovered_transactions_;
   std::unique_ptr<Tracer> tracer_;
@@ -1842,6 +1917,16 @@ class DBImpl : public DB {
                          bool* corrupted_log_found,
                          RecoveryContext* recovery_ctx);
 
+  // Applies a recovered WAL batch to the memtables with `num_threads`
+  // workers, each owning a disjoint partition of the column families.
+  // Equivalent to the single-threaded WriteBatchInternal::InsertInto() call
+  // in RecoverLogFiles(); see max_wal_recovery_threads.
+  // REQUIRES: called during recovery, before the DB serves writes
+  Status ApplyWALBatchParallel(WriteBatch* batch, int num_threads,
+                               uint64_t wal_number,
+                               SequenceNumber* next_sequence,
+                               bool* has_valid_writes);
+
   // The following two methods are used to flush a memtable to
   // storage. The first one is used at database RecoveryTime (when the
   // database is opened) and is heavyweight because it holds the mutex
@@ -1999,6 +2084,14 @@ class DBImpl : public DB {
                                 uint64_t* log_used,
                                 SequenceNumber* last_sequence, size_t seq_inc);
 
+#ifndef ROCKSDB_LITE
+  // Deliver a WAL record that was just appended to the log to all
+  // registered WAL stream sinks, detaching sinks that report backpressure.
+  // Called from WriteToWAL, so delivery is in WAL order; see the delivery
+  // contract in rocksdb/wal_stream.h.
+  void NotifyWalStreamSinks(SequenceNumber sequence, const Slice& payload);
+#endif  // ROCKSDB_LITE
+
   // Used by WriteImpl to update bg_error_ if paranoid check is enabled.
   // Caller must hold mutex_.
   void WriteStatusCheckOnLocked(const Status& status);
@@ -2057,12 +2150,14 @@ class DBImpl : public DB {
   static void BGWorkBottomCompaction(void* arg);
   static void BGWorkFlush(void* arg);
   static void BGWorkPurge(void* arg);
+  static void BGWorkTablePreload(void* arg);
   static void UnscheduleCompactionCallback(void* arg);
   static void UnscheduleFlushCallback(void* arg);
   void BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
                                 Env::Priority thread_pri);
   void BackgroundCallFlush(Env::Priority thread_pri);
   void BackgroundCallPurge();
+  void BackgroundCallTablePreload();
   Status BackgroundCompaction(bool* madeProgress, JobContext* job_context,
                               LogBuffer* log_buffer,
                               PrepickedCompaction* prepicked_compaction,
@@ -2117,7 +2212,7 @@ class DBImpl : public DB {
   void MarkLogsNotSynced(uint64_t up_to);
 
   SnapshotImpl* GetSnapshotImpl(bool is_write_conflict_boundary,
-                                bool lock = true);
+                                bool lock = true, uint64_t lease_seconds = 0);
 
   // If snapshot_seq != kMaxSequenceNumber, then this function can only be
   // called from the write thread that publishes sequence numbers to readers.
@@ -2148,14 +2243,25 @@ class DBImpl : public DB {
   // All ColumnFamily state changes go through this function. Here we analyze
   // the new state and we schedule background work if we detect that the new
   // state needs flush or compaction.
+  // `files_rearranged_only` should be set by callers installing the result
+  // of an operation that only rewrites data the file set already logically
+  // contained (a compaction without a compaction filter); it keeps the
+  // column family's new data epoch -- and thus RowLookupCache entries --
+  // valid across the install. When in doubt leave it false; a spurious
+  // epoch bump only costs cache entries, never correctness.
   void InstallSuperVersionAndScheduleWork(
       ColumnFamilyData* cfd, SuperVersionContext* sv_context,
-      const MutableCFOptions& mutable_cf_options);
+      const MutableCFOptions& mutable_cf_options,
+      bool files_rearranged_only = false);
 
   bool GetIntPropertyInternal(ColumnFamilyData* cfd,
                               const DBPropertyInfo& property_info,
                               bool is_locked, uint64_t* value);
   bool GetPropertyHandleOptionsStatistics(std::string* value);
+  bool GetPropertyHandlePerfSampleStats(
+      std::map<std::string, std::string>* stats);
+  bool GetPropertyHandleSLOStats(std::map<std::string, std::string>* stats);
+  bool GetPropertyHandleDBMutexContentionStats(std::string* value);
 
   bool HasPendingManualCompaction();
   bool HasExclusiveManualCompaction();
@@ -2269,10 +2375,15 @@ class DBImpl : public DB {
   // to have acquired the SuperVersion and pass in a snapshot sequence number
   // in order to construct the LookupKeys. The start_key and num_keys specify
   // the range of keys in the sorted_keys vector for a single column family.
-  Status MultiGetImpl(
-      const ReadOptions& read_options, size_t start_key, size_t num_keys,
+  // `shared_reader`, if non-nullptr, is used in place of the per-batch
+  // readers so async IO from multiple concurrent invocations (one per
+  // column family) can be completed by a single wait loop.
+  DECLARE_SYNC_AND_ASYNC(
+      Status, MultiGetImpl, const ReadOptions& read_options, size_t start_key,
+      size_t num_keys,
       autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
-      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback);
+      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback,
+      AsyncFileReader* shared_reader);
 
   Status DisableFileDeletionsWithLock();
 
@@ -2330,6 +2441,18 @@ class DBImpl : public DB {
   // expensive mutex_ lock during WAL write, which update log_empty_.
   bool log_empty_;
 
+#ifndef ROCKSDB_LITE
+  // Protects wal_stream_sinks_. Locked on the WAL write path only when
+  // has_wal_stream_sinks_ is true, so the common case with no registered
+  // sinks pays a single atomic load.
+  port::Mutex wal_stream_mutex_;
+  // Sinks receiving each WAL record at commit time. See
+  // rocksdb/wal_stream.h.
+  std::vector<std::shared_ptr<WalStreamSink>> wal_stream_sinks_;
+  // Mirrors !wal_stream_sinks_.empty(); updated under wal_stream_mutex_.
+  std::atomic<bool> has_wal_stream_sinks_{false};
+#endif  // ROCKSDB_LITE
+
   ColumnFamilyHandleImpl* persist_stats_cf_handle_;
 
   bool persistent_stats_cfd_exists_ = true;
@@ -2483,30 +2606,75 @@ class DBImpl : public DB {
   // State is protected with db mutex.
   std::list<uint64_t> pending_outputs_;
 
-  // flush_queue_ and compaction_queue_ hold column families that we need to
+  // The pending background work, sharded off the DB mutex: the flush and
+  // compaction queues and the unscheduled-job counters carry their own
+  // synchronization, so enqueueing work and claiming it do not have to
+  // extend a DB-mutex critical section. The column-family bookkeeping done
+  // around the queue operations (queued_for_* flags, references) and the
+  // bg_*_scheduled_ counters still belong to the DB mutex, which all
+  // current call sites keep holding; the queues themselves no longer
+  // depend on it.
+  //
+  // The flush and compaction queues hold column families that we need to
   // flush and compact, respectively.
-  // A column family is inserted into flush_queue_ when it satisfies condition
-  // cfd->imm()->IsFlushPending()
-  // A column family is inserted into compaction_queue_ when it satisfied
-  // condition cfd->NeedsCompaction()
-  // Column families in this list are all Ref()-erenced
-  // TODO(icanadi) Provide some kind of ReferencedColumnFamily class that will
-  // do RAII on ColumnFamilyData
-  // Column families are in this queue when they need to be flushed or
-  // compacted. Consumers of these queues are flush and compaction threads. When
-  // column family is put on this queue, we increase unscheduled_flushes_ and
-  // unscheduled_compactions_. When these variables are bigger than zero, that
-  // means we need to schedule background threads for flush and compaction.
-  // Once the background threads are scheduled, we decrease unscheduled_flushes_
-  // and unscheduled_compactions_. That way we keep track of number of
-  // compaction and flush threads we need to schedule. This scheduling is done
-  // in MaybeScheduleFlushOrCompaction()
-  // invariant(column family present in flush_queue_ <==>
-  // ColumnFamilyData::pending_flush_ == true)
-  std::deque<FlushRequest> flush_queue_;
-  // invariant(column family present in compaction_queue_ <==>
-  // ColumnFamilyData::pending_compaction_ == true)
-  std::deque<ColumnFamilyData*> compaction_queue_;
+  // A column family is inserted into the flush queue when it satisfies
+  // condition cfd->imm()->IsFlushPending()
+  // A column family is inserted into the compaction queue when it
+  // satisfies condition cfd->NeedsCompaction()
+  // Column families in these queues are all Ref()-erenced
+  // TODO(icanadi) Provide some kind of ReferencedColumnFamily class that
+  // will do RAII on ColumnFamilyData
+  // When a column family is put on a queue, we increase its unscheduled
+  // counter. When these counters are bigger than zero, that means we need
+  // to schedule background threads for flush and compaction. Once the
+  // background threads are scheduled, we decrease the counters. That way
+  // we keep track of number of compaction and flush threads we need to
+  // schedule. This scheduling is done in MaybeScheduleFlushOrCompaction()
+  // invariant(column family present in flush queue <==>
+  // ColumnFamilyData::queued_for_flush_ == true), maintained under the DB
+  // mutex by the helpers around EnqueueFlush()/PopFirstFlush()
+  // invariant(column family present in compaction queue <==>
+  // ColumnFamilyData::queued_for_compaction_ == true), likewise
+  class BackgroundWorkQueues {
+   public:
+    void EnqueueFlush(const FlushRequest& flush_req);
+    // REQUIRES: HasPendingFlush()
+    FlushRequest PopFirstFlush();
+    bool HasPendingFlush() const;
+
+    void EnqueueCompaction(ColumnFamilyData* cfd);
+    // REQUIRES: HasPendingCompaction()
+    ColumnFamilyData* PopFirstCompaction();
+    // Put a candidate back at the front of the compaction queue after
+    // compaction picking backed off of it.
+    void RequeueCompactionFront(ColumnFamilyData* cfd);
+    bool HasPendingCompaction() const;
+
+    // Number of queued jobs for which no thread-pool slot has been
+    // claimed yet. Raised when work is enqueued or a claimed job is
+    // handed back, lowered (with a negative argument) when a background
+    // thread is scheduled for it.
+    void AddUnscheduledFlushes(int n) {
+      unscheduled_flushes_.fetch_add(n, std::memory_order_relaxed);
+    }
+    void AddUnscheduledCompactions(int n) {
+      unscheduled_compactions_.fetch_add(n, std::memory_order_relaxed);
+    }
+    int unscheduled_flushes() const {
+      return unscheduled_flushes_.load(std::memory_order_relaxed);
+    }
+    int unscheduled_compactions() const {
+      return unscheduled_compactions_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    mutable port::Mutex mu_;
+    std::deque<FlushRequest> flush_queue_;
+    std::deque<ColumnFamilyData*> compaction_queue_;
+    std::atomic<int> unscheduled_flushes_{0};
+    std::atomic<int> unscheduled_compactions_{0};
+  };
+  BackgroundWorkQueues bg_work_queues_;
 
   // A map to store file numbers and filenames of the files to be purged
   std::unordered_map<uint64_t, PurgeFileInfo> purge_files_;
@@ -2520,10 +2688,6 @@ class DBImpl : public DB {
 
   std::deque<SuperVersion*> superversions_to_free_queue_;
 
-  int unscheduled_flushes_;
-
-  int unscheduled_compactions_;
-
   // count how many background compactions are running or have been scheduled in
   // the BOTTOM pool
   int bg_bottom_compaction_scheduled_;
@@ -2543,6 +2707,10 @@ class DBImpl : public DB {
   // number of background obsolete file purge jobs, submitted to the HIGH pool
   int bg_purge_scheduled_;
 
+  // number of background table cache warming jobs, submitted to the LOW pool
+  // when lazy_open_table_files is set
+  int bg_table_preload_scheduled_;
+
   std::deque<ManualCompactionState*> manual_compaction_dequeue_;
 
   // shall we disable deletion of obsolete files
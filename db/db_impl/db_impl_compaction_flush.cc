@@ -22,6 +22,7 @@
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
 #include "util/concurrent_task_limiter_impl.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -1432,9 +1433,15 @@ Status DBImpl::CompactFilesImpl(
   Status status = compaction_job.Install(*c->mutable_cf_options());
   if (status.ok()) {
     assert(compaction_job.io_status().ok());
+    // Without a compaction filter the output holds exactly the data the file
+    // set already contained.
+    const bool files_rearranged_only =
+        c->immutable_options()->compaction_filter == nullptr &&
+        c->immutable_options()->compaction_filter_factory == nullptr;
     InstallSuperVersionAndScheduleWork(c->column_family_data(),
                                        &job_context->superversion_contexts[0],
-                                       *c->mutable_cf_options());
+                                       *c->mutable_cf_options(),
+                                       files_rearranged_only);
   }
   // status above captures any error during compaction_job.Install, so its ok
   // not check compaction_job.io_status() explicitly if we're not calling
@@ -1695,7 +1702,8 @@ Status DBImpl::ReFitLevel(ColumnFamilyData* cfd, int level, int target_level) {
     Status status = versions_->LogAndApply(cfd, mutable_cf_options, &edit,
                                            &mutex_, directories_.GetDbDir());
 
-    InstallSuperVersionAndScheduleWork(cfd, &sv_context, mutable_cf_options);
+    InstallSuperVersionAndScheduleWork(cfd, &sv_context, mutable_cf_options,
+                                       /*files_rearranged_only=*/true);
 
     ROCKS_LOG_DEBUG(immutable_db_options_.info_log, "[%s] LogAndApply: %s\n",
                     cfd->GetName().c_str(), status.ToString().data());
@@ -2465,7 +2473,7 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
   auto bg_job_limits = GetBGJobLimits();
   bool is_flush_pool_empty =
       env_->GetBackgroundThreads(Env::Priority::HIGH) == 0;
-  while (!is_flush_pool_empty && unscheduled_flushes_ > 0 &&
+  while (!is_flush_pool_empty && bg_work_queues_.unscheduled_flushes() > 0 &&
          bg_flush_scheduled_ < bg_job_limits.max_flushes) {
     bg_flush_scheduled_++;
     FlushThreadArg* fta = new FlushThreadArg;
@@ -2473,16 +2481,19 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
     fta->thread_pri_ = Env::Priority::HIGH;
     env_->Schedule(&DBImpl::BGWorkFlush, fta, Env::Priority::HIGH, this,
                    &DBImpl::UnscheduleFlushCallback);
-    --unscheduled_flushes_;
+    bg_work_queues_.AddUnscheduledFlushes(-1);
+#ifndef NDEBUG
+    int unscheduled_flushes = bg_work_queues_.unscheduled_flushes();
     TEST_SYNC_POINT_CALLBACK(
         "DBImpl::MaybeScheduleFlushOrCompaction:AfterSchedule:0",
-        &unscheduled_flushes_);
+        &unscheduled_flushes);
+#endif  // NDEBUG
   }
 
   // special case -- if high-pri (flush) thread pool is empty, then schedule
   // flushes in low-pri (compaction) thread pool.
   if (is_flush_pool_empty) {
-    while (unscheduled_flushes_ > 0 &&
+    while (bg_work_queues_.unscheduled_flushes() > 0 &&
            bg_flush_scheduled_ + bg_compaction_scheduled_ <
                bg_job_limits.max_flushes) {
       bg_flush_scheduled_++;
@@ -2491,7 +2502,7 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
       fta->thread_pri_ = Env::Priority::LOW;
       env_->Schedule(&DBImpl::BGWorkFlush, fta, Env::Priority::LOW, this,
                      &DBImpl::UnscheduleFlushCallback);
-      --unscheduled_flushes_;
+      bg_work_queues_.AddUnscheduledFlushes(-1);
     }
   }
 
@@ -2515,13 +2526,13 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
 
   while (bg_compaction_scheduled_ + bg_bottom_compaction_scheduled_ <
              bg_job_limits.max_compactions &&
-         unscheduled_compactions_ > 0) {
+         bg_work_queues_.unscheduled_compactions() > 0) {
     CompactionArg* ca = new CompactionArg;
     ca->db = this;
     ca->compaction_pri_ = Env::Priority::LOW;
     ca->prepicked_compaction = nullptr;
     bg_compaction_scheduled_++;
-    unscheduled_compactions_--;
+    bg_work_queues_.AddUnscheduledCompactions(-1);
     env_->Schedule(&DBImpl::BGWorkCompaction, ca, Env::Priority::LOW, this,
                    &DBImpl::UnscheduleCompactionCallback);
   }
@@ -2558,26 +2569,65 @@ DBImpl::BGJobLimits DBImpl::GetBGJobLimits(int max_background_flushes,
   return res;
 }
 
+void DBImpl::BackgroundWorkQueues::EnqueueFlush(
+    const FlushRequest& flush_req) {
+  MutexLock l(&mu_);
+  flush_queue_.push_back(flush_req);
+}
+
+DBImpl::FlushRequest DBImpl::BackgroundWorkQueues::PopFirstFlush() {
+  MutexLock l(&mu_);
+  assert(!flush_queue_.empty());
+  FlushRequest flush_req = std::move(flush_queue_.front());
+  flush_queue_.pop_front();
+  return flush_req;
+}
+
+bool DBImpl::BackgroundWorkQueues::HasPendingFlush() const {
+  MutexLock l(&mu_);
+  return !flush_queue_.empty();
+}
+
+void DBImpl::BackgroundWorkQueues::EnqueueCompaction(ColumnFamilyData* cfd) {
+  MutexLock l(&mu_);
+  compaction_queue_.push_back(cfd);
+}
+
+ColumnFamilyData* DBImpl::BackgroundWorkQueues::PopFirstCompaction() {
+  MutexLock l(&mu_);
+  assert(!compaction_queue_.empty());
+  ColumnFamilyData* cfd = compaction_queue_.front();
+  compaction_queue_.pop_front();
+  return cfd;
+}
+
+void DBImpl::BackgroundWorkQueues::RequeueCompactionFront(
+    ColumnFamilyData* cfd) {
+  MutexLock l(&mu_);
+  compaction_queue_.push_front(cfd);
+}
+
+bool DBImpl::BackgroundWorkQueues::HasPendingCompaction() const {
+  MutexLock l(&mu_);
+  return !compaction_queue_.empty();
+}
+
 void DBImpl::AddToCompactionQueue(ColumnFamilyData* cfd) {
   assert(!cfd->queued_for_compaction());
   cfd->Ref();
-  compaction_queue_.push_back(cfd);
+  bg_work_queues_.EnqueueCompaction(cfd);
   cfd->set_queued_for_compaction(true);
 }
 
 ColumnFamilyData* DBImpl::PopFirstFromCompactionQueue() {
-  assert(!compaction_queue_.empty());
-  auto cfd = *compaction_queue_.begin();
-  compaction_queue_.pop_front();
+  auto cfd = bg_work_queues_.PopFirstCompaction();
   assert(cfd->queued_for_compaction());
   cfd->set_queued_for_compaction(false);
   return cfd;
 }
 
 DBImpl::FlushRequest DBImpl::PopFirstFromFlushQueue() {
-  assert(!flush_queue_.empty());
-  FlushRequest flush_req = flush_queue_.front();
-  flush_queue_.pop_front();
+  FlushRequest flush_req = bg_work_queues_.PopFirstFlush();
   if (!immutable_db_options_.atomic_flush) {
     assert(flush_req.size() == 1);
   }
@@ -2595,13 +2645,12 @@ DBImpl::FlushRequest DBImpl::PopFirstFromFlushQueue() {
 
 ColumnFamilyData* DBImpl::PickCompactionFromQueue(
     std::unique_ptr<TaskLimiterToken>* token, LogBuffer* log_buffer) {
-  assert(!compaction_queue_.empty());
+  assert(bg_work_queues_.HasPendingCompaction());
   assert(*token == nullptr);
   autovector<ColumnFamilyData*> throttled_candidates;
   ColumnFamilyData* cfd = nullptr;
-  while (!compaction_queue_.empty()) {
-    auto first_cfd = *compaction_queue_.begin();
-    compaction_queue_.pop_front();
+  while (bg_work_queues_.HasPendingCompaction()) {
+    auto first_cfd = bg_work_queues_.PopFirstCompaction();
     assert(first_cfd->queued_for_compaction());
     if (!RequestCompactionToken(first_cfd, false, token, log_buffer)) {
       throttled_candidates.push_back(first_cfd);
@@ -2614,7 +2663,7 @@ ColumnFamilyData* DBImpl::PickCompactionFromQueue(
   // Add throttled compaction candidates back to queue in the original order.
   for (auto iter = throttled_candidates.rbegin();
        iter != throttled_candidates.rend(); ++iter) {
-    compaction_queue_.push_front(*iter);
+    bg_work_queues_.RequeueCompactionFront(*iter);
   }
   return cfd;
 }
@@ -2636,8 +2685,8 @@ void DBImpl::SchedulePendingFlush(const FlushRequest& flush_req,
       cfd->Ref();
       cfd->set_queued_for_flush(true);
       cfd->SetFlushReason(flush_reason);
-      ++unscheduled_flushes_;
-      flush_queue_.push_back(flush_req);
+      bg_work_queues_.AddUnscheduledFlushes(1);
+      bg_work_queues_.EnqueueFlush(flush_req);
     }
   } else {
     for (auto& iter : flush_req) {
@@ -2645,8 +2694,8 @@ void DBImpl::SchedulePendingFlush(const FlushRequest& flush_req,
       cfd->Ref();
       cfd->SetFlushReason(flush_reason);
     }
-    ++unscheduled_flushes_;
-    flush_queue_.push_back(flush_req);
+    bg_work_queues_.AddUnscheduledFlushes(1);
+    bg_work_queues_.EnqueueFlush(flush_req);
   }
 }
 
@@ -2654,7 +2703,7 @@ void DBImpl::SchedulePendingCompaction(ColumnFamilyData* cfd) {
   mutex_.AssertHeld();
   if (!cfd->queued_for_compaction() && cfd->NeedsCompaction()) {
     AddToCompactionQueue(cfd);
-    ++unscheduled_compactions_;
+    bg_work_queues_.AddUnscheduledCompactions(1);
   }
 }
 
@@ -2772,7 +2821,7 @@ Status DBImpl::BackgroundFlush(bool* made_progress, JobContext* job_context,
   std::vector<SuperVersionContext>& superversion_contexts =
       job_context->superversion_contexts;
   autovector<ColumnFamilyData*> column_families_not_to_flush;
-  while (!flush_queue_.empty()) {
+  while (bg_work_queues_.HasPendingFlush()) {
     // This cfd is already referenced
     const FlushRequest& flush_req = PopFirstFromFlushQueue();
     superversion_contexts.clear();
@@ -3027,7 +3076,8 @@ void DBImpl::BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
     if (made_progress ||
         (bg_compaction_scheduled_ == 0 &&
          bg_bottom_compaction_scheduled_ == 0) ||
-        HasPendingManualCompaction() || unscheduled_compactions_ == 0) {
+        HasPendingManualCompaction() ||
+        bg_work_queues_.unscheduled_compactions() == 0) {
       // signal if
       // * made_progress -- need to wakeup DelayWrite
       // * bg_{bottom,}_compaction_scheduled_ == 0 -- need to wakeup ~DBImpl
@@ -3082,8 +3132,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     // If we get here, it means a hard error happened after this compaction
     // was scheduled by MaybeScheduleFlushOrCompaction(), but before it got
     // a chance to execute. Since we didn't pop a cfd from the compaction
-    // queue, increment unscheduled_compactions_
-    unscheduled_compactions_++;
+    // queue, hand the unscheduled-compaction claim back
+    bg_work_queues_.AddUnscheduledCompactions(1);
   }
 
   if (!status.ok()) {
@@ -3150,13 +3200,13 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                  : m->manual_end->DebugString(true).c_str()));
       }
     }
-  } else if (!is_prepicked && !compaction_queue_.empty()) {
+  } else if (!is_prepicked && bg_work_queues_.HasPendingCompaction()) {
     if (HasExclusiveManualCompaction()) {
       // Can't compact right now, but try again later
       TEST_SYNC_POINT("DBImpl::BackgroundCompaction()::Conflict");
 
       // Stay in the compaction queue.
-      unscheduled_compactions_++;
+      bg_work_queues_.AddUnscheduledCompactions(1);
 
       return Status::OK();
     }
@@ -3165,7 +3215,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     if (cfd == nullptr) {
       // Can't find any executable task from the compaction queue.
       // All tasks have been throttled by compaction thread limiter.
-      ++unscheduled_compactions_;
+      bg_work_queues_.AddUnscheduledCompactions(1);
       return Status::Busy();
     }
 
@@ -3208,7 +3258,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
               ->ComputeCompactionScore(*(c->immutable_options()),
                                        *(c->mutable_cf_options()));
           AddToCompactionQueue(cfd);
-          ++unscheduled_compactions_;
+          bg_work_queues_.AddUnscheduledCompactions(1);
 
           c.reset();
           // Don't need to sleep here, because BackgroundCallCompaction
@@ -3237,7 +3287,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
           if (cfd->NeedsCompaction()) {
             // Yes, we need more compactions!
             AddToCompactionQueue(cfd);
-            ++unscheduled_compactions_;
+            bg_work_queues_.AddUnscheduledCompactions(1);
             MaybeScheduleFlushOrCompaction();
           }
         }
@@ -3255,9 +3305,11 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     TEST_SYNC_POINT_CALLBACK("DBImpl::BackgroundCompaction:BeforeCompaction",
                              c->column_family_data());
     assert(c->num_input_files(1) == 0);
-    assert(c->level() == 0);
+    assert(c->level() == 0 ||
+           c->compaction_reason() == CompactionReason::kTtlFileDeletion);
     assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+               kCompactionStyleFIFO ||
+           c->compaction_reason() == CompactionReason::kTtlFileDeletion);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -3340,7 +3392,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     // Use latest MutableCFOptions
     InstallSuperVersionAndScheduleWork(c->column_family_data(),
                                        &job_context->superversion_contexts[0],
-                                       *c->mutable_cf_options());
+                                       *c->mutable_cf_options(),
+                                       /*files_rearranged_only=*/true);
 
     VersionStorageInfo::LevelSummaryStorage tmp;
     c->column_family_data()->internal_stats()->IncBytesMoved(c->output_level(),
@@ -3432,9 +3485,15 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     status = compaction_job.Install(*c->mutable_cf_options());
     io_s = compaction_job.io_status();
     if (status.ok()) {
+      // Without a compaction filter the output holds exactly the data the
+      // file set already contained.
+      const bool files_rearranged_only =
+          c->immutable_options()->compaction_filter == nullptr &&
+          c->immutable_options()->compaction_filter_factory == nullptr;
       InstallSuperVersionAndScheduleWork(c->column_family_data(),
                                          &job_context->superversion_contexts[0],
-                                         *c->mutable_cf_options());
+                                         *c->mutable_cf_options(),
+                                         files_rearranged_only);
     }
     *made_progress = true;
     TEST_SYNC_POINT_CALLBACK("DBImpl::BackgroundCompaction:AfterCompaction",
@@ -3499,7 +3558,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                                    *(c->mutable_cf_options()));
       if (!cfd->queued_for_compaction()) {
         AddToCompactionQueue(cfd);
-        ++unscheduled_compactions_;
+        bg_work_queues_.AddUnscheduledCompactions(1);
       }
     }
   }
@@ -3725,9 +3784,15 @@ void DBImpl::BuildCompactionJobInfo(
 
 void DBImpl::InstallSuperVersionAndScheduleWork(
     ColumnFamilyData* cfd, SuperVersionContext* sv_context,
-    const MutableCFOptions& mutable_cf_options) {
+    const MutableCFOptions& mutable_cf_options, bool files_rearranged_only) {
   mutex_.AssertHeld();
 
+  if (!files_rearranged_only) {
+    // Advance the epoch before the new SuperVersion is published below so
+    // that no reader can pair the new file set with the old epoch.
+    cfd->BumpNewDataEpoch();
+  }
+
   // Update max_total_in_memory_state_
   size_t old_memtable_size = 0;
   auto* old_sv = cfd->GetSuperVersion();
@@ -3814,7 +3879,13 @@ void DBImpl::GetSnapshotContext(
         GetSnapshotImpl(false /*write_conflict_boundary*/, false /*lock*/);
     job_context->job_snapshot.reset(new ManagedSnapshot(this, job_snapshot));
   }
-  *snapshot_seqs = snapshots_.GetAll(earliest_write_conflict_snapshot);
+  // Drop expired leased snapshots from the job's snapshot list so that
+  // compactions can collect the obsolete data they used to pin.
+  int64_t now = 0;
+  immutable_db_options_.clock->GetCurrentTime(&now)
+      .PermitUncheckedError();  // Ignore error
+  *snapshot_seqs = snapshots_.GetAll(earliest_write_conflict_snapshot,
+                                     kMaxSequenceNumber, now);
 }
 
 Status DBImpl::WaitForCompact(bool wait_unscheduled) {
@@ -3822,7 +3893,7 @@ Status DBImpl::WaitForCompact(bool wait_unscheduled) {
   InstrumentedMutexLock l(&mutex_);
   while ((bg_bottom_compaction_scheduled_ || bg_compaction_scheduled_ ||
           bg_flush_scheduled_ ||
-          (wait_unscheduled && unscheduled_compactions_)) &&
+          (wait_unscheduled && bg_work_queues_.unscheduled_compactions())) &&
          (error_handler_.GetBGError().ok())) {
     bg_cv_.Wait();
   }
@@ -153,6 +153,94 @@ Status DBImpl::PromoteL0(ColumnFamilyHandle* column_family, int target_level) {
 
   return status;
 }
+
+Status DBImpl::GetScanPartitionBoundaries(
+    ColumnFamilyHandle* column_family, const Slice* begin, const Slice* end,
+    size_t max_partitions, std::vector<std::string>* boundaries) {
+  assert(column_family);
+  assert(boundaries != nullptr);
+  boundaries->clear();
+  if (max_partitions <= 1) {
+    return Status::OK();
+  }
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
+  auto cfd = cfh->cfd();
+  const Comparator* ucmp = cfd->user_comparator();
+  if (ucmp->timestamp_size() > 0) {
+    return Status::NotSupported(
+        "GetScanPartitionBoundaries() does not support user-defined "
+        "timestamps");
+  }
+  if (begin != nullptr && end != nullptr &&
+      ucmp->Compare(*begin, *end) >= 0) {
+    return Status::InvalidArgument("begin must be smaller than end");
+  }
+
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  const auto* vstorage = sv->current->storage_info();
+
+  // Use the largest user key of every file overlapping [begin, end) as a
+  // candidate boundary, weighted by the file's size, the same way
+  // CompactionJob::GenSubcompactionBoundaries carves up its input. Files in
+  // overlapping L0 runs contribute overlapping ranges, so the sizes are an
+  // approximation; with level-style LSMs the bulk of the data is in sorted
+  // levels and the skew stays small.
+  uint64_t total_size = 0;
+  std::vector<std::pair<Slice, uint64_t>> anchors;
+  for (int level = 0; level < vstorage->num_non_empty_levels(); ++level) {
+    for (const auto& f : vstorage->LevelFiles(level)) {
+      const Slice file_smallest = f->smallest.user_key();
+      const Slice file_largest = f->largest.user_key();
+      if (end != nullptr && ucmp->Compare(file_smallest, *end) >= 0) {
+        continue;
+      }
+      if (begin != nullptr && ucmp->Compare(file_largest, *begin) < 0) {
+        continue;
+      }
+      anchors.emplace_back(file_largest, f->fd.GetFileSize());
+      total_size += f->fd.GetFileSize();
+    }
+  }
+
+  std::sort(anchors.begin(), anchors.end(),
+            [ucmp](const std::pair<Slice, uint64_t>& a,
+                   const std::pair<Slice, uint64_t>& b) {
+              return ucmp->Compare(a.first, b.first) < 0;
+            });
+
+  if (!anchors.empty() && total_size > 0) {
+    const uint64_t target_range_size = total_size / max_partitions;
+    uint64_t next_threshold = target_range_size;
+    uint64_t cumulative_size = 0;
+    for (size_t i = 0; i + 1 < anchors.size(); ++i) {
+      cumulative_size += anchors[i].second;
+      if (cumulative_size <= next_threshold) {
+        continue;
+      }
+      const Slice& key = anchors[i].first;
+      // Skip duplicates and keys on or outside the requested range; either
+      // would produce an empty partition.
+      if (!boundaries->empty() &&
+          ucmp->Compare(Slice(boundaries->back()), key) >= 0) {
+        continue;
+      }
+      if (begin != nullptr && ucmp->Compare(key, *begin) <= 0) {
+        continue;
+      }
+      if (end != nullptr && ucmp->Compare(key, *end) >= 0) {
+        break;
+      }
+      boundaries->push_back(key.ToString());
+      if (boundaries->size() + 1 >= max_partitions) {
+        break;
+      }
+      next_threshold += target_range_size;
+    }
+  }
+
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  return Status::OK();
+}
 #endif  // ROCKSDB_LITE
 
 }  // namespace ROCKSDB_NAMESPACE
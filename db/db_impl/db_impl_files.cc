@@ -160,6 +160,11 @@ void DBImpl::FindObsoleteFiles(JobContext* job_context, bool force,
     MarkAsGrabbedForPurge(blob_file.GetBlobFileNumber());
   }
 
+  // Collect garbage blob extents that have become safe to punch holes for.
+  for (auto cfd : *versions_->GetColumnFamilySet()) {
+    cfd->TakePunchableBlobFiles(&job_context->blob_punch_hole_jobs);
+  }
+
   // store the current filenum, lognum, etc
   job_context->manifest_file_number = versions_->manifest_file_number();
   job_context->pending_manifest_file_number =
@@ -660,6 +665,11 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
       }
     }
   }
+  // Punch holes for garbage blob extents that have become unreachable.
+  for (const auto& punch_job : state.blob_punch_hole_jobs) {
+    PunchBlobFileHoles(punch_job);
+  }
+
 #ifndef ROCKSDB_LITE
   wal_manager_.PurgeObsoleteWALFiles();
 #endif  // ROCKSDB_LITE
@@ -678,6 +688,44 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
   TEST_SYNC_POINT("DBImpl::PurgeObsoleteFiles:End");
 }
 
+void DBImpl::PunchBlobFileHoles(const BlobFilePunchHoleJob& job) {
+  std::unique_ptr<FSRandomRWFile> file;
+  const IOStatus io_s = fs_->NewRandomRWFile(job.blob_file_path, FileOptions(),
+                                             &file, nullptr /* dbg */);
+  if (!io_s.ok()) {
+    // The blob file may have become entirely obsolete and been deleted in
+    // the meantime, in which case there is nothing left to reclaim.
+    return;
+  }
+
+  uint64_t punched_bytes = 0;
+  for (const auto& extent : job.extents) {
+    const IOStatus s = file->PunchHole(extent.first, extent.second, IOOptions(),
+                                       nullptr /* dbg */);
+    if (s.IsNotSupported()) {
+      // File system cannot punch holes; the space will be reclaimed when the
+      // blob file eventually gets garbage collected or becomes obsolete.
+      return;
+    }
+    if (!s.ok()) {
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "Failed to punch hole in blob file %s: %s",
+                     job.blob_file_path.c_str(), s.ToString().c_str());
+      return;
+    }
+    punched_bytes += extent.second;
+  }
+
+  ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                 "Punched %" PRIu64 " hole(s) totaling %" PRIu64
+                 " bytes in blob file %s",
+                 static_cast<uint64_t>(job.extents.size()), punched_bytes,
+                 job.blob_file_path.c_str());
+  TEST_SYNC_POINT("DBImpl::PunchBlobFileHoles:Punched");
+
+  file->Close(IOOptions(), nullptr /* dbg */).PermitUncheckedError();
+}
+
 void DBImpl::DeleteObsoleteFiles() {
   mutex_.AssertHeld();
   JobContext job_context(next_job_id_.fetch_add(1));
@@ -983,6 +983,91 @@ bool DBImpl::InvokeWalFilterIfNeededOnWalRecord(uint64_t wal_number,
 #endif  // ROCKSDB_LITE
 }
 
+namespace {
+// A ColumnFamilyMemTables implementation for parallel WAL recovery that
+// exposes only the column families assigned to one worker thread. Updates
+// for other column families look to MemTableInserter like updates for
+// dropped column families, which are skipped while the sequence number
+// still advances, so every worker computes identical sequence bookkeeping
+// while inserting a disjoint subset of the batch.
+class ColumnFamilyMemTablesPartition : public ColumnFamilyMemTablesImpl {
+ public:
+  ColumnFamilyMemTablesPartition(ColumnFamilySet* column_family_set,
+                                 uint32_t partition, uint32_t num_partitions)
+      : ColumnFamilyMemTablesImpl(column_family_set),
+        partition_(partition),
+        num_partitions_(num_partitions) {}
+
+  bool Seek(uint32_t column_family_id) override {
+    if (column_family_id % num_partitions_ != partition_) {
+      return false;
+    }
+    return ColumnFamilyMemTablesImpl::Seek(column_family_id);
+  }
+
+ private:
+  const uint32_t partition_;
+  const uint32_t num_partitions_;
+};
+
+// Batches smaller than this are applied single-threaded during recovery;
+// for small batches spawning workers costs more than it saves.
+const uint64_t kMinWalBatchBytesForParallelApply = 64 * 1024;
+}  // namespace
+
+Status DBImpl::ApplyWALBatchParallel(WriteBatch* batch, int num_threads,
+                                     uint64_t wal_number,
+                                     SequenceNumber* next_sequence,
+                                     bool* has_valid_writes) {
+  // Extra workers beyond the number of column families would have nothing
+  // to insert.
+  num_threads =
+      std::min(num_threads,
+               static_cast<int>(
+                   versions_->GetColumnFamilySet()->NumberOfColumnFamilies()));
+  struct WorkerState {
+    Status status;
+    SequenceNumber next_sequence = 0;
+    bool has_valid_writes = false;
+  };
+  std::vector<WorkerState> states(num_threads);
+  std::vector<port::Thread> workers;
+  workers.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    workers.emplace_back([this, batch, num_threads, wal_number, i, &states] {
+      WorkerState* state = &states[i];
+      ColumnFamilyMemTablesPartition cf_mems(
+          versions_->GetColumnFamilySet(), static_cast<uint32_t>(i),
+          static_cast<uint32_t>(num_threads));
+      // Each memtable is written by exactly one worker, so the
+      // non-concurrent insert path is safe here.
+      state->status = WriteBatchInternal::InsertInto(
+          batch, &cf_mems, &flush_scheduler_, &trim_history_scheduler_,
+          true /* ignore_missing_column_families */, wal_number, this,
+          false /* concurrent_memtable_writes */, &state->next_sequence,
+          &state->has_valid_writes, seq_per_batch_, batch_per_txn_);
+    });
+  }
+  Status status;
+  SequenceNumber max_next_sequence = 0;
+  for (int i = 0; i < num_threads; i++) {
+    workers[i].join();
+    if (status.ok() && !states[i].status.ok()) {
+      status = states[i].status;
+    }
+    if (states[i].has_valid_writes) {
+      *has_valid_writes = true;
+    }
+    // On success every worker advances the sequence number over the same
+    // set of ops; on failure report how far replay got, like the
+    // single-threaded path does.
+    assert(!status.ok() || states[i].next_sequence == states[0].next_sequence);
+    max_next_sequence = std::max(max_next_sequence, states[i].next_sequence);
+  }
+  *next_sequence = max_next_sequence;
+  return status;
+}
+
 // REQUIRES: wal_numbers are sorted in ascending order
 Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
                                SequenceNumber* next_sequence, bool read_only,
@@ -1038,6 +1123,13 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     min_wal_number =
         std::max(min_wal_number, versions_->MinLogNumberWithUnflushedData());
   }
+  // 2PC and seq_per_batch recovery rebuild transactions through the DB
+  // pointer inside MemTableInserter, which is not safe to run from multiple
+  // threads, so those modes always replay single-threaded.
+  const int wal_apply_threads =
+      (!seq_per_batch_ && !allow_2pc())
+          ? std::max(1, immutable_db_options_.max_wal_recovery_threads)
+          : 1;
   for (auto wal_number : wal_numbers) {
     if (wal_number < min_wal_number) {
       ROCKS_LOG_INFO(immutable_db_options_.info_log,
@@ -1109,6 +1201,8 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     // large sequence numbers).
     log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
                        &reporter, true /*checksum*/, wal_number);
+    reader.SetCompressionDictionary(
+        immutable_db_options_.wal_compression_dict);
 
     // Determine if we should tolerate incomplete records at the tail end of the
     // Read all the records and add to a memtable
@@ -1179,11 +1273,18 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       // we just ignore the update.
       // That's why we set ignore missing column families to true
       bool has_valid_writes = false;
-      status = WriteBatchInternal::InsertInto(
-          &batch, column_family_memtables_.get(), &flush_scheduler_,
-          &trim_history_scheduler_, true, wal_number, this,
-          false /* concurrent_memtable_writes */, next_sequence,
-          &has_valid_writes, seq_per_batch_, batch_per_txn_);
+      if (wal_apply_threads > 1 &&
+          WriteBatchInternal::ByteSize(&batch) >=
+              kMinWalBatchBytesForParallelApply) {
+        status = ApplyWALBatchParallel(&batch, wal_apply_threads, wal_number,
+                                       next_sequence, &has_valid_writes);
+      } else {
+        status = WriteBatchInternal::InsertInto(
+            &batch, column_family_memtables_.get(), &flush_scheduler_,
+            &trim_history_scheduler_, true, wal_number, this,
+            false /* concurrent_memtable_writes */, next_sequence,
+            &has_valid_writes, seq_per_batch_, batch_per_txn_);
+      }
       MaybeIgnoreError(&status);
       if (!status.ok()) {
         // We are treating this as a failure while reading since we read valid
@@ -1773,7 +1874,8 @@ IOStatus DBImpl::CreateWAL(uint64_t log_file_num, uint64_t recycle_log_number,
     *new_log = new log::Writer(std::move(file_writer), log_file_num,
                                immutable_db_options_.recycle_log_file_num > 0,
                                immutable_db_options_.manual_wal_flush,
-                               immutable_db_options_.wal_compression);
+                               immutable_db_options_.wal_compression,
+                               immutable_db_options_.wal_compression_dict);
     io_s = (*new_log)->AddCompressionTypeRecord();
   }
   return io_s;
@@ -1995,6 +2097,9 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
     impl->DeleteObsoleteFiles();
     TEST_SYNC_POINT("DBImpl::Open:AfterDeleteFiles");
     impl->MaybeScheduleFlushOrCompaction();
+    if (impl->immutable_db_options_.lazy_open_table_files) {
+      impl->ScheduleTableFilePreload();
+    }
   } else {
     persist_options_status.PermitUncheckedError();
   }
@@ -168,6 +168,8 @@ Status DBImplSecondary::MaybeInitLogReader(
     LogReaderContainer* log_reader_container = new LogReaderContainer(
         env_, immutable_db_options_.info_log, std::move(fname),
         std::move(file_reader), log_number);
+    log_reader_container->reader_->SetCompressionDictionary(
+        immutable_db_options_.wal_compression_dict);
     log_readers_.insert(std::make_pair(
         log_number, std::unique_ptr<LogReaderContainer>(log_reader_container)));
   }
@@ -604,8 +606,11 @@ Status DBImplSecondary::TryCatchUpWithPrimary() {
             ->ReadAndApply(&mutex_, &manifest_reader_,
                            manifest_reader_status_.get(), &cfds_changed);
 
-    ROCKS_LOG_INFO(immutable_db_options_.info_log, "Last sequence is %" PRIu64,
-                   static_cast<uint64_t>(versions_->LastSequence()));
+    // Tailing secondaries call this at high frequency; keep the per-call
+    // logging at debug level like the level summaries below.
+    ROCKS_LOG_DEBUG(immutable_db_options_.info_log,
+                    "Last sequence is %" PRIu64,
+                    static_cast<uint64_t>(versions_->LastSequence()));
     for (ColumnFamilyData* cfd : cfds_changed) {
       if (cfd->IsDropped()) {
         ROCKS_LOG_DEBUG(immutable_db_options_.info_log, "[%s] is dropped\n",
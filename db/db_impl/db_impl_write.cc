@@ -13,9 +13,13 @@
 #include "db/event_helpers.h"
 #include "logging/logging.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/request_perf_context.h"
 #include "options/options_helper.h"
+#include "rocksdb/slo_tracker.h"
+#include "rocksdb/wal_stream.h"
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 // Convenience methods
@@ -117,6 +121,7 @@ void DBImpl::SetRecoverableStatePreReleaseCallback(
 }
 
 Status DBImpl::Write(const WriteOptions& write_options, WriteBatch* my_batch) {
+  ScopedRequestPerfContext request_perf(write_options.request_perf_context);
   Status s;
   if (write_options.protection_bytes_per_key > 0) {
     s = WriteBatchInternal::UpdateProtectionInfo(
@@ -160,6 +165,8 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
          write_options.protection_bytes_per_key == 0 ||
          write_options.protection_bytes_per_key ==
              my_batch->GetProtectionBytesPerKey());
+  SLOTracker::ScopedTimer slo_timer(immutable_db_options_.slo_tracker.get(),
+                                    SLOTracker::kWrite);
   if (my_batch == nullptr) {
     return Status::InvalidArgument("Batch is nullptr!");
   } else if (!disable_memtable &&
@@ -1295,6 +1302,15 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   if (UNLIKELY(needs_locking)) {
     log_write_mutex_.Unlock();
   }
+#ifndef ROCKSDB_LITE
+  // Callers of this function are serialized (see the comment above it), so
+  // sinks observe records in WAL order.
+  if (io_s.ok() &&
+      UNLIKELY(has_wal_stream_sinks_.load(std::memory_order_acquire))) {
+    NotifyWalStreamSinks(WriteBatchInternal::Sequence(&merged_batch),
+                         log_entry);
+  }
+#endif  // ROCKSDB_LITE
   if (log_used != nullptr) {
     *log_used = logfile_number_;
   }
@@ -1304,6 +1320,63 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   return io_s;
 }
 
+#ifndef ROCKSDB_LITE
+Status DBImpl::RegisterWalStreamSink(
+    const std::shared_ptr<WalStreamSink>& sink) {
+  if (sink == nullptr) {
+    return Status::InvalidArgument("WalStreamSink is nullptr");
+  }
+  MutexLock l(&wal_stream_mutex_);
+  for (const auto& registered : wal_stream_sinks_) {
+    if (registered == sink) {
+      return Status::InvalidArgument("WalStreamSink is already registered");
+    }
+  }
+  wal_stream_sinks_.push_back(sink);
+  has_wal_stream_sinks_.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+Status DBImpl::UnregisterWalStreamSink(
+    const std::shared_ptr<WalStreamSink>& sink) {
+  MutexLock l(&wal_stream_mutex_);
+  for (auto it = wal_stream_sinks_.begin(); it != wal_stream_sinks_.end();
+       ++it) {
+    if (*it == sink) {
+      wal_stream_sinks_.erase(it);
+      if (wal_stream_sinks_.empty()) {
+        has_wal_stream_sinks_.store(false, std::memory_order_release);
+      }
+      return Status::OK();
+    }
+  }
+  return Status::NotFound("WalStreamSink is not registered");
+}
+
+void DBImpl::NotifyWalStreamSinks(SequenceNumber sequence,
+                                  const Slice& payload) {
+  MutexLock l(&wal_stream_mutex_);
+  for (auto it = wal_stream_sinks_.begin(); it != wal_stream_sinks_.end();) {
+    Status s = (*it)->OnWalWrite(sequence, payload);
+    if (s.ok()) {
+      ++it;
+    } else {
+      // The sink cannot keep up. Detach it; it can catch up from the WAL
+      // on disk via GetUpdatesSince(sequence) and then re-register.
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "Detaching WAL stream sink %s at sequence %" PRIu64
+                     ": %s",
+                     (*it)->Name(), sequence, s.ToString().c_str());
+      (*it)->OnStreamStalled(sequence, s);
+      it = wal_stream_sinks_.erase(it);
+    }
+  }
+  if (wal_stream_sinks_.empty()) {
+    has_wal_stream_sinks_.store(false, std::memory_order_release);
+  }
+}
+#endif  // ROCKSDB_LITE
+
 IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
                             log::Writer* log_writer, uint64_t* log_used,
                             bool need_log_sync, bool need_log_dir_sync,
@@ -1647,8 +1720,9 @@ Status DBImpl::HandleWriteBufferManagerFlush(WriteContext* write_context) {
   // suboptimal but still correct.
   ROCKS_LOG_INFO(
       immutable_db_options_.info_log,
-      "Flushing column family with oldest memtable entry. Write buffers are "
-      "using %" ROCKSDB_PRIszt " bytes out of a total of %" ROCKSDB_PRIszt ".",
+      "Flushing column family with fastest-filling memtable. Write buffers "
+      "are using %" ROCKSDB_PRIszt " bytes out of a total of %" ROCKSDB_PRIszt
+      ".",
       write_buffer_manager_->memory_usage(),
       write_buffer_manager_->buffer_size());
   // no need to refcount because drop is happening in write thread, so can't
@@ -1657,8 +1731,13 @@ Status DBImpl::HandleWriteBufferManagerFlush(WriteContext* write_context) {
   if (immutable_db_options_.atomic_flush) {
     SelectColumnFamiliesForAtomicFlush(&cfds);
   } else {
+    // Pick the column family whose active memtable is filling fastest.
+    // Flushing it buys the most headroom before the write buffer manager
+    // starts stalling writers; a hot CF no longer drags the other CFs into
+    // repeated flushes of their mostly-empty memtables.
     ColumnFamilyData* cfd_picked = nullptr;
-    SequenceNumber seq_num_for_cf_picked = kMaxSequenceNumber;
+    double max_fill_rate = -1.0;
+    const uint64_t now_micros = immutable_db_options_.clock->NowMicros();
 
     for (auto cfd : *versions_->GetColumnFamilySet()) {
       if (cfd->IsDropped()) {
@@ -1667,10 +1746,16 @@ Status DBImpl::HandleWriteBufferManagerFlush(WriteContext* write_context) {
       if (!cfd->mem()->IsEmpty()) {
         // We only consider active mem table, hoping immutable memtable is
         // already in the process of flushing.
-        uint64_t seq = cfd->mem()->GetCreationSeq();
-        if (cfd_picked == nullptr || seq < seq_num_for_cf_picked) {
+        uint64_t age_micros =
+            now_micros > cfd->mem()->GetCreationClockMicros()
+                ? now_micros - cfd->mem()->GetCreationClockMicros()
+                : 1;
+        double fill_rate =
+            static_cast<double>(cfd->mem()->ApproximateMemoryUsageFast()) /
+            static_cast<double>(age_micros);
+        if (cfd_picked == nullptr || fill_rate > max_fill_rate) {
           cfd_picked = cfd;
-          seq_num_for_cf_picked = seq;
+          max_fill_rate = fill_rate;
         }
       }
     }
@@ -13,6 +13,7 @@
 #include <limits>
 #include <string>
 
+#include "db/blob/blob_index.h"
 #include "db/dbformat.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
@@ -53,7 +54,12 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       version_(version),
       read_callback_(read_callback),
       sequence_(s),
+      blob_prefetch_buffers_(
+          version && !expose_blob_index && read_options.readahead_size > 0
+              ? new PrefetchBufferCollection(read_options.readahead_size)
+              : nullptr),
       statistics_(ioptions.stats),
+      slo_tracker_(ioptions.slo_tracker.get()),
       max_skip_(max_sequential_skip_in_iterations),
       max_skippable_internal_keys_(read_options.max_skippable_internal_keys),
       num_internal_keys_skipped_(0),
@@ -128,6 +134,7 @@ void DBIter::Next() {
   assert(valid_);
   assert(status_.ok());
 
+  SLOTracker::ScopedTimer slo_timer(slo_tracker_, SLOTracker::kNext);
   PERF_CPU_TIMER_GUARD(iter_next_cpu_nanos, clock_);
   // Release temporarily pinned blocks from last operation
   ReleaseTempPinnedData();
@@ -191,11 +198,27 @@ bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
   read_options.read_tier = read_tier_;
   read_options.verify_checksums = verify_checksums_;
 
-  constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
   constexpr uint64_t* bytes_read = nullptr;
 
-  const Status s = version_->GetBlob(read_options, user_key, blob_index,
-                                     prefetch_buffer, &blob_value_, bytes_read);
+  Status s;
+  if (blob_prefetch_buffers_) {
+    // Readahead is enabled for this scan: route the read through a per-file
+    // prefetch buffer so that consecutive blobs from the same file are
+    // fetched using large batched reads instead of one small read per entry.
+    BlobIndex decoded_blob_index;
+    s = decoded_blob_index.DecodeFrom(blob_index);
+    if (s.ok()) {
+      FilePrefetchBuffer* prefetch_buffer =
+          blob_prefetch_buffers_->GetOrCreatePrefetchBuffer(
+              decoded_blob_index.file_number());
+      s = version_->GetBlob(read_options, user_key, decoded_blob_index,
+                            prefetch_buffer, &blob_value_, bytes_read);
+    }
+  } else {
+    constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
+    s = version_->GetBlob(read_options, user_key, blob_index, prefetch_buffer,
+                          &blob_value_, bytes_read);
+  }
 
   if (!s.ok()) {
     status_ = s;
@@ -1415,6 +1438,7 @@ void DBIter::SetSavedKeyToSeekForPrevTarget(const Slice& target) {
 }
 
 void DBIter::Seek(const Slice& target) {
+  SLOTracker::ScopedTimer slo_timer(slo_tracker_, SLOTracker::kSeek);
   PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, clock_);
   StopWatch sw(clock_, statistics_, DB_SEEK);
 
@@ -11,12 +11,14 @@
 #include <cstdint>
 #include <string>
 
+#include "db/blob/prefetch_buffer_collection.h"
 #include "db/db_impl/db_impl.h"
 #include "db/range_del_aggregator.h"
 #include "memory/arena.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
 #include "rocksdb/iterator.h"
+#include "rocksdb/slo_tracker.h"
 #include "table/iterator_wrapper.h"
 #include "util/autovector.h"
 
@@ -326,7 +328,11 @@ class DBIter final : public Iterator {
   Slice pinned_value_;
   // for prefix seek mode to support prev()
   PinnableSlice blob_value_;
+  // Readahead buffers (one per blob file) used when resolving blob references
+  // during large scans; see ReadOptions::readahead_size.
+  std::unique_ptr<PrefetchBufferCollection> blob_prefetch_buffers_;
   Statistics* statistics_;
+  SLOTracker* slo_tracker_;
   uint64_t max_skip_;
   uint64_t max_skippable_internal_keys_;
   uint64_t num_internal_keys_skipped_;
@@ -2376,6 +2376,98 @@ TEST_P(DBIteratorTest, Refresh) {
   iter.reset();
 }
 
+TEST_P(DBIteratorTest, RefreshAfterDoubleMemtableSwitch) {
+  // Keep the switched-out memtables unflushed so the refresh keeps the
+  // existing iterator tree (the Version does not change) and has to merge
+  // in an iterator for every memtable switched in since it was built.
+  Options options = CurrentOptions();
+  options.min_write_buffer_number_to_merge = 3;
+  options.max_write_buffer_number = 6;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "va"));
+  std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+  ASSERT_OK(iter->status());
+
+  ASSERT_OK(Put("b", "vb"));
+  ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+  ASSERT_OK(Put("c", "vc"));
+  ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+  ASSERT_OK(Put("d", "vd"));
+
+  ASSERT_OK(iter->Refresh());
+  iter->SeekToFirst();
+  // "b" lives in the intermediate memtable that was both switched in and
+  // switched out between the refreshes; it must not be skipped.
+  std::vector<std::string> keys;
+  for (; iter->Valid(); iter->Next()) {
+    keys.push_back(iter->key().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(std::vector<std::string>({"a", "b", "c", "d"}), keys);
+  iter.reset();
+}
+
+TEST_P(DBIteratorTest, RefreshAfterOptionsOnlySuperVersionBump) {
+  Options options = CurrentOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(db_->Merge(WriteOptions(), "k", "a"));
+  std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+  ASSERT_OK(iter->status());
+
+  ASSERT_OK(db_->Merge(WriteOptions(), "k", "b"));
+  // Install a new super version that keeps the same mutable memtable. The
+  // refresh must not add a second iterator over it, which would feed every
+  // merge operand to the operator twice.
+  ASSERT_OK(db_->SetOptions({{"max_sequential_skip_in_iterations", "16"}}));
+
+  ASSERT_OK(iter->Refresh());
+  iter->SeekToFirst();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("k", iter->key().ToString());
+  ASSERT_EQ("a,b", iter->value().ToString());
+  iter->Next();
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_OK(iter->status());
+  iter.reset();
+}
+
+TEST_P(DBIteratorTest, RefreshSeesDeleteRangeBeforeMemtableSwitch) {
+  Options options = CurrentOptions();
+  options.min_write_buffer_number_to_merge = 3;
+  options.max_write_buffer_number = 6;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "va"));
+  ASSERT_OK(Put("b", "vb"));
+  ASSERT_OK(Put("d", "vd"));
+  std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+  ASSERT_OK(iter->status());
+
+  // The tombstone lands in the memtable the iterator tree already
+  // contains, after the tree (and its fragmented tombstone iterator) was
+  // built; the switch then retires that memtable without flushing it.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "a",
+                             "c"));
+  ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+  // And one more tombstone in the newly switched-in memtable.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "d",
+                             "e"));
+  ASSERT_OK(Put("e", "ve"));
+
+  ASSERT_OK(iter->Refresh());
+  iter->SeekToFirst();
+  std::vector<std::string> keys;
+  for (; iter->Valid(); iter->Next()) {
+    keys.push_back(iter->key().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(std::vector<std::string>({"e"}), keys);
+  iter.reset();
+}
+
 TEST_P(DBIteratorTest, RefreshWithSnapshot) {
   ASSERT_OK(Put("x", "y"));
   const Snapshot* snapshot = db_->GetSnapshot();
@@ -2521,6 +2613,39 @@ TEST_P(DBIteratorTest, TableFilter) {
   }
 }
 
+TEST_P(DBIteratorTest, TableFilterWithLevelIterator) {
+  Options options = CurrentOptions();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("c", "3"));
+  ASSERT_OK(Put("d", "4"));
+  ASSERT_OK(Flush());
+  // The files do not overlap, so they move to L1 without merging and
+  // iteration goes through LevelIterator.
+  MoveFilesToLevel(1);
+  ASSERT_EQ(NumTableFilesAtLevel(1), 2);
+
+  ReadOptions opts;
+  opts.table_filter = [](const TableProperties& props) {
+    return props.num_entries != 2;
+  };
+  // Iterate twice: the second pass runs with both tables resident in the
+  // table cache, so the rejected file is pruned without being touched.
+  for (int i = 0; i < 2; i++) {
+    std::unique_ptr<Iterator> iter(NewIterator(opts));
+    iter->SeekToFirst();
+    ASSERT_EQ(IterStatus(iter.get()), "a->1");
+    iter->Next();
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+    iter->Seek("c");
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+}
+
 TEST_P(DBIteratorTest, UpperBoundWithPrevReseek) {
   Options options = CurrentOptions();
   options.max_sequential_skip_in_iterations = 3;
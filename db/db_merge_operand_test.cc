@@ -310,6 +310,65 @@ TEST_F(DBMergeOperandTest, GetMergeOperandsBasic) {
   ASSERT_EQ(values[2], "am");
 }
 
+TEST_F(DBMergeOperandTest, GetMergeOperandsIterator) {
+  Options options;
+  options.create_if_missing = true;
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  options.env = env_;
+  DestroyAndReopen(options);
+
+  // No entry for the key
+  std::unique_ptr<MergeOperandsIterator> iter;
+  ASSERT_TRUE(db_->GetMergeOperandsIterator(ReadOptions(),
+                                            db_->DefaultColumnFamily(), "k1",
+                                            &iter)
+                  .IsNotFound());
+  ASSERT_EQ(iter, nullptr);
+
+  // Operands spread over table files and memtables, with no a-priori bound
+  // on the operand count
+  const int kNumOperands = 100;
+  std::vector<std::string> expected;
+  for (int i = 0; i < kNumOperands; i++) {
+    std::string operand = "v" + std::to_string(i);
+    ASSERT_OK(Merge("k1", operand));
+    expected.push_back(operand);
+    if (i % 10 == 9) {
+      ASSERT_OK(Flush());
+    }
+  }
+
+  ASSERT_OK(db_->GetMergeOperandsIterator(ReadOptions(),
+                                          db_->DefaultColumnFamily(), "k1",
+                                          &iter));
+  ASSERT_NE(iter, nullptr);
+  std::vector<std::string> operands;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    operands.emplace_back(iter->operand().ToString());
+  }
+  ASSERT_EQ(operands, expected);
+
+  // The iterator's slices must stay valid while newer writes and flushes
+  // install new superversions.
+  ASSERT_OK(Merge("k1", "after"));
+  ASSERT_OK(Flush());
+  iter->SeekToFirst();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(iter->operand(), "v0");
+  iter.reset();
+
+  // A plain value is exposed as a single operand, matching
+  // GetMergeOperands()
+  ASSERT_OK(Put("k2", "v2"));
+  ASSERT_OK(db_->GetMergeOperandsIterator(ReadOptions(),
+                                          db_->DefaultColumnFamily(), "k2",
+                                          &iter));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(iter->operand(), "v2");
+  iter->Next();
+  ASSERT_FALSE(iter->Valid());
+}
+
 TEST_F(DBMergeOperandTest, BlobDBGetMergeOperandsBasic) {
   Options options;
   options.create_if_missing = true;
@@ -19,6 +19,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/perf_context.h"
 #include "rocksdb/perf_level.h"
+#include "rocksdb/slo_tracker.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block.h"
 #include "table/format.h"
@@ -2005,6 +2006,158 @@ TEST_F(DBPropertiesTest, BlockCacheProperties) {
   ASSERT_EQ(0, value);
 }
 
+TEST_F(DBPropertiesTest, CFStatistics) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  ASSERT_OK(Put(0, "foo", "v1"));
+  ASSERT_OK(Flush(0));
+  ASSERT_EQ("v1", Get(0, "foo"));
+
+  std::string default_cf_stats;
+  ASSERT_TRUE(db_->GetProperty(handles_[0], DB::Properties::kCFStatistics,
+                               &default_cf_stats));
+  std::string pikachu_stats;
+  ASSERT_TRUE(db_->GetProperty(handles_[1], DB::Properties::kCFStatistics,
+                               &pikachu_stats));
+
+  const auto get_ticker = [](const std::string& stats_str,
+                             const std::string& name) -> uint64_t {
+    const std::string pattern = name + " COUNT : ";
+    const size_t pos = stats_str.find(pattern);
+    EXPECT_NE(pos, std::string::npos);
+    if (pos == std::string::npos) {
+      return 0;
+    }
+    return std::stoull(stats_str.substr(pos + pattern.size()));
+  };
+
+  // Only the default column family has been read from
+  const uint64_t default_cf_misses =
+      get_ticker(default_cf_stats, "rocksdb.block.cache.miss");
+  ASSERT_GT(default_cf_misses, 0U);
+  ASSERT_EQ(get_ticker(pikachu_stats, "rocksdb.block.cache.miss"), 0U);
+
+  // The DB-wide statistics include the per-CF data
+  ASSERT_GE(options.statistics->getTickerCount(BLOCK_CACHE_MISS),
+            default_cf_misses);
+
+  // The property is not supported without a statistics object
+  Options no_stats_options = CurrentOptions();
+  DestroyAndReopen(no_stats_options);
+
+  std::string value;
+  ASSERT_FALSE(db_->GetProperty(DB::Properties::kCFStatistics, &value));
+}
+
+TEST_F(DBPropertiesTest, PerfSampleStats) {
+  Options options = CurrentOptions();
+  options.perf_sample_frequency = 1;  // sample every operation
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+
+  const PerfLevel perf_level_before = GetPerfLevel();
+  ASSERT_EQ("v1", Get("foo"));
+
+  // Sampling must not leave the caller's perf level changed
+  ASSERT_EQ(GetPerfLevel(), perf_level_before);
+
+  std::map<std::string, std::string> sample_stats;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kPerfSampleStats, &sample_stats));
+
+  ASSERT_GE(std::stoull(sample_stats["get.samples"]), 1U);
+  ASSERT_NE(sample_stats.find("get.memtable.p99"), sample_stats.end());
+  ASSERT_NE(sample_stats.find("get.output-files.p50"), sample_stats.end());
+  ASSERT_NE(sample_stats.find("multiget.block-read.p95"), sample_stats.end());
+
+  // The property is not supported when sampling is disabled
+  Options no_sampling_options = CurrentOptions();
+  DestroyAndReopen(no_sampling_options);
+
+  std::map<std::string, std::string> value;
+  ASSERT_FALSE(db_->GetMapProperty(DB::Properties::kPerfSampleStats, &value));
+}
+
+TEST_F(DBPropertiesTest, SLOStats) {
+  // Threshold callbacks fire when the tracked percentile exceeds the
+  // threshold, at most once per window
+  auto tracker = NewSLOTracker(/* window_micros */ 60 * 1000000ULL);
+  std::atomic<int> breaches{0};
+  tracker->RegisterThresholdCallback(
+      SLOTracker::kGet, /* percentile */ 99.0, /* threshold_micros */ 100,
+      [&](SLOTracker::OpType op_type, double percentile,
+          uint64_t threshold_micros, double observed_micros) {
+        ASSERT_EQ(op_type, SLOTracker::kGet);
+        ASSERT_EQ(percentile, 99.0);
+        ASSERT_EQ(threshold_micros, 100U);
+        ASSERT_GT(observed_micros, 100.0);
+        breaches.fetch_add(1);
+      });
+  // Thresholds are only evaluated periodically; record enough operations
+  // to cover several evaluations and check the once-per-window limit
+  for (int i = 0; i < 256; ++i) {
+    tracker->Record(SLOTracker::kGet, 10000);
+  }
+  ASSERT_EQ(breaches.load(), 1);
+  ASSERT_GT(tracker->GetPercentile(SLOTracker::kGet, 99.9), 100.0);
+
+  Options options = CurrentOptions();
+  options.slo_tracker = NewSLOTracker();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ("v1", Get("foo"));
+
+  std::map<std::string, std::string> slo_stats;
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kSLOStats, &slo_stats));
+
+  ASSERT_GE(std::stoull(slo_stats["get.count"]), 1U);
+  ASSERT_GE(std::stoull(slo_stats["write.count"]), 1U);
+  ASSERT_NE(slo_stats.find("get.p99"), slo_stats.end());
+  ASSERT_NE(slo_stats.find("seek.p50"), slo_stats.end());
+  ASSERT_NE(slo_stats.find("next.p999"), slo_stats.end());
+  ASSERT_NE(slo_stats.find("multiget.p95"), slo_stats.end());
+
+  // The property is not supported without a tracker
+  Options no_tracker_options = CurrentOptions();
+  DestroyAndReopen(no_tracker_options);
+
+  std::map<std::string, std::string> value;
+  ASSERT_FALSE(db_->GetMapProperty(DB::Properties::kSLOStats, &value));
+}
+
+TEST_F(DBPropertiesTest, DBMutexContentionStats) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  // Mutex accounting is only on at a stats level that times mutexes
+  options.statistics->set_stats_level(StatsLevel::kAll);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ("v1", Get("foo"));
+
+  std::string value;
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kDBMutexContentionStats, &value));
+  // Header line plus at least one recorded call site (the flush and the
+  // property query itself both took the DB mutex)
+  ASSERT_GT(std::count(value.begin(), value.end(), '\n'), 1);
+
+  // Without mutex timing enabled only the header is returned
+  Options no_stats_options = CurrentOptions();
+  DestroyAndReopen(no_stats_options);
+
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kDBMutexContentionStats, &value));
+  ASSERT_EQ(std::count(value.begin(), value.end(), '\n'), 1);
+}
+
 TEST_F(DBPropertiesTest, GetMapPropertyDbStats) {
   auto mock_clock = std::make_shared<MockSystemClock>(env_->GetSystemClock());
   CompositeEnvWrapper env(env_, mock_clock);
@@ -1659,6 +1659,54 @@ TEST_F(DBTest, ApproximateSizesFilesWithErrorMargin) {
   }
 }
 
+TEST_F(DBTest, ApproximateSizesFromSketch) {
+  Options options = CurrentOptions();
+  options.write_buffer_size = 24 * 1024;
+  options.compression = kNoCompression;
+  options.create_if_missing = true;
+  options.target_file_size_base = 24 * 1024;
+  DestroyAndReopen(options);
+  const auto default_cf = db_->DefaultColumnFamily();
+
+  const int N = 16000;
+  Random rnd(301);
+  for (int i = 0; i < N; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(24)));
+  }
+  ASSERT_OK(Flush());
+  // Spread the keys over many files in the next level
+  ASSERT_OK(
+      db_->CompactRange(CompactRangeOptions(), default_cf, nullptr, nullptr));
+
+  SizeApproximationOptions size_approx_options;
+  size_approx_options.include_memtables = false;
+  size_approx_options.include_files = true;
+
+  // A range covering many whole files: the sketch answer must stay close
+  // to the precise one, since only the two files straddling the range
+  // boundaries are guessed at.
+  const std::string start = Key(100);
+  const std::string end = Key(N - 100);
+  const Range r(start, end);
+  uint64_t precise_size;
+  ASSERT_OK(db_->GetApproximateSizes(size_approx_options, default_cf, &r, 1,
+                                     &precise_size));
+  ASSERT_NE(precise_size, 0);
+
+  uint64_t sketch_size;
+  size_approx_options.use_size_sketch = true;
+  ASSERT_OK(db_->GetApproximateSizes(size_approx_options, default_cf, &r, 1,
+                                     &sketch_size));
+  ASSERT_LT(sketch_size, precise_size * 1.2);
+  ASSERT_GT(sketch_size, precise_size * 0.8);
+
+  // An empty range resolves to zero.
+  const Range empty_r(start, start);
+  ASSERT_OK(db_->GetApproximateSizes(size_approx_options, default_cf, &empty_r,
+                                     1, &sketch_size));
+  ASSERT_EQ(sketch_size, 0);
+}
+
 TEST_F(DBTest, GetApproximateMemTableStats) {
   Options options = CurrentOptions();
   options.write_buffer_size = 100000000;
@@ -20,6 +20,7 @@
 #include "rocksdb/experimental.h"
 #include "rocksdb/iostats_context.h"
 #include "rocksdb/persistent_cache.h"
+#include "rocksdb/row_lookup_cache.h"
 #include "rocksdb/trace_record.h"
 #include "rocksdb/trace_record_result.h"
 #include "rocksdb/utilities/replayer.h"
@@ -1693,6 +1694,114 @@ TEST_P(PresetCompressionDictTest, CompactBottommost) {
   }
 }
 
+TEST_P(PresetCompressionDictTest, ShareCompactionDict) {
+  // Verifies that with `CompressionOptions::share_compaction_dict` a
+  // multi-output compaction still produces readable files: the first output
+  // trains the dictionary and the later outputs adopt it without buffering
+  // and training their own.
+  const size_t kValueLen = 256;
+  const size_t kKeysPerFile = 1 << 10;
+  const size_t kDictLen = 16 << 10;
+  const size_t kBlockLen = 4 << 10;
+  const int kNumFiles = 4;
+
+  Options options = CurrentOptions();
+  if (bottommost_) {
+    options.bottommost_compression = compression_type_;
+    options.bottommost_compression_opts.enabled = true;
+    options.bottommost_compression_opts.max_dict_bytes = kDictLen;
+    options.bottommost_compression_opts.share_compaction_dict = true;
+  } else {
+    options.compression = compression_type_;
+    options.compression_opts.max_dict_bytes = kDictLen;
+    options.compression_opts.share_compaction_dict = true;
+  }
+  options.disable_auto_compactions = true;
+  // Force the compaction to cut several output files so later outputs
+  // exercise the dictionary-adoption path.
+  options.target_file_size_base = kKeysPerFile * kValueLen / 4;
+  BlockBasedTableOptions bbto;
+  bbto.block_size = kBlockLen;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  Reopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < kNumFiles; ++i) {
+    for (size_t j = 0; j < kKeysPerFile; ++j) {
+      std::string key = Key(static_cast<int>(i * kKeysPerFile + j));
+      std::string value = rnd.RandomString(kValueLen);
+      expected[key] = value;
+      ASSERT_OK(Put(key, value));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+#ifndef ROCKSDB_LITE
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_GT(metadata.size(), 1U);
+#endif  // ROCKSDB_LITE
+
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+}
+
+TEST_F(DBTest2, MaxCompressEntropySkipsBlocks) {
+  // Verifies that `CompressionOptions::max_compress_entropy` skips
+  // compression based on the entropy estimate alone, before the
+  // compressor runs. An artificially low threshold is used with values
+  // that snappy compresses fine, so any compressed block in the second
+  // flush means the compressor ran when it should not have.
+  if (!Snappy_Supported()) {
+    return;
+  }
+  const size_t kValueLen = 1024;
+  const int kNumKeys = 1 << 10;
+
+  Options options = CurrentOptions();
+  options.compression = kSnappyCompression;
+  options.compression_opts.max_compress_entropy = 0.5;
+  options.statistics = CreateDBStatistics();
+  Reopen(options);
+
+  // Single-byte runs have an entropy estimate near zero, below the
+  // threshold, so these blocks still get compressed.
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(kValueLen, 'a')));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_GT(TestGetTickerCount(options, NUMBER_BLOCK_COMPRESSED), 0);
+
+  // A random two-symbol alphabet estimates at about one bit per byte,
+  // above the threshold, even though snappy would compress it well.
+  uint64_t prev_compressed =
+      TestGetTickerCount(options, NUMBER_BLOCK_COMPRESSED);
+  uint64_t prev_not_compressed =
+      TestGetTickerCount(options, NUMBER_BLOCK_NOT_COMPRESSED);
+  Random rnd(301);
+  for (int i = 0; i < kNumKeys; ++i) {
+    std::string value(kValueLen, 'a');
+    for (size_t j = 0; j < kValueLen; ++j) {
+      value[j] = rnd.OneIn(2) ? 'a' : 'b';
+    }
+    ASSERT_OK(Put(Key(kNumKeys + i), value));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_GT(TestGetTickerCount(options, NUMBER_BLOCK_NOT_COMPRESSED),
+            prev_not_compressed);
+  // Index and other metadata blocks are not subject to the entropy check,
+  // so allow a small number of compressed blocks beyond the data blocks.
+  ASSERT_LE(TestGetTickerCount(options, NUMBER_BLOCK_COMPRESSED),
+            prev_compressed + 5);
+
+  for (int i = 0; i < 2 * kNumKeys; ++i) {
+    ASSERT_EQ(Get(Key(i)).size(), kValueLen);
+  }
+}
+
 class CompactionCompressionListener : public EventListener {
  public:
   explicit CompactionCompressionListener(Options* db_options)
@@ -2092,6 +2201,39 @@ TEST_F(DBTest2, DuplicateSnapshot) {
 }
 #endif  // ROCKSDB_LITE
 
+TEST_F(DBTest2, LeasedSnapshot) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  Reopen(options);
+  DBImpl* dbi = static_cast_with_check<DBImpl>(db_);
+
+  ASSERT_OK(Put("foo", "v1"));
+  const Snapshot* snapshot = dbi->GetSnapshotWithLease(100 /* seconds */);
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_OK(Flush());
+
+  // While the lease is active the snapshot pins the old version.
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ(AllEntriesFor("foo"), "[ v2, v1 ]");
+  ReadOptions read_options;
+  read_options.snapshot = snapshot;
+  std::string value;
+  ASSERT_OK(db_->Get(read_options, "foo", &value));
+  ASSERT_EQ(value, "v1");
+
+  // Once the lease expires, compactions stop honoring the snapshot and drop
+  // the version it pinned. Reads through the expired snapshot may then no
+  // longer find it.
+  env_->MockSleepForSeconds(200);
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ(AllEntriesFor("foo"), "[ v2 ]");
+  ASSERT_TRUE(db_->Get(read_options, "foo", &value).IsNotFound());
+
+  db_->ReleaseSnapshot(snapshot);
+}
+
 class PinL0IndexAndFilterBlocksTest
     : public DBTestBase,
       public testing::WithParamInterface<std::tuple<bool, bool>> {
@@ -4558,6 +4700,24 @@ TEST_F(DBTest2, TraceAndReplay) {
   ASSERT_EQ(res_handler.GetNumMultiGets(), 0);
   res_handler.Reset();
 
+  // Re-replay using 2 threads, 2x speed, preserving per-key ordering.
+  ReplayOptions ordered_opts(2, 2.0);
+  ordered_opts.preserve_key_order = true;
+  ASSERT_OK(replayer->Prepare());
+  ASSERT_OK(replayer->Replay(ordered_opts, res_cb));
+  ASSERT_GT(res_handler.GetAvgLatency(), 0.0);
+  ASSERT_EQ(res_handler.GetNumWrites(), 8);
+  ASSERT_EQ(res_handler.GetNumGets(), 3);
+  ASSERT_EQ(res_handler.GetNumIterSeeks(), 2);
+  ASSERT_EQ(res_handler.GetNumMultiGets(), 0);
+  res_handler.Reset();
+
+  // The replayed data still verifies after the ordered replay.
+  ASSERT_OK(db2->Get(ro, handles[0], "a", &value));
+  ASSERT_EQ("1", value);
+  ASSERT_OK(db2->Get(ro, handles[0], "g", &value));
+  ASSERT_EQ("12", value);
+
   replayer.reset();
 
   for (auto handle : handles) {
@@ -5059,6 +5219,45 @@ TEST_F(DBTest2, TraceWithSampling) {
   ASSERT_OK(DestroyDB(dbname2, options));
 }
 
+TEST_F(DBTest2, TraceWithTypeSamplingAndKeyScope) {
+  Options options = CurrentOptions();
+  TraceOptions trace_opts;
+  EnvOptions env_opts;
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  // Sample writes at one per two while keeping every Get, and only trace
+  // read ops whose key falls in ["b", "e").
+  trace_opts.type_sampling_frequency[TraceFilterType::kTraceFilterWrite] = 2;
+  trace_opts.trace_key_lower_bound = "b";
+  trace_opts.trace_key_upper_bound = "e";
+  std::string trace_filename = dbname_ + "/rocksdb.trace_stratified";
+  std::unique_ptr<TraceWriter> trace_writer;
+  ASSERT_OK(NewFileTraceWriter(env_, env_opts, trace_filename, &trace_writer));
+  ASSERT_OK(db_->StartTrace(trace_opts, std::move(trace_writer)));
+
+  ASSERT_OK(Put(0, "b", "1"));
+  ASSERT_OK(Put(0, "b", "2"));
+  ASSERT_OK(Put(0, "b", "3"));
+  ASSERT_OK(Put(0, "b", "4"));
+  // "b" and "c" are in scope, "a" and "e" are not.
+  ASSERT_EQ(Get(0, "b"), "4");
+  ASSERT_EQ(Get(0, "a"), "NOT_FOUND");
+  ASSERT_EQ(Get(0, "c"), "NOT_FOUND");
+  ASSERT_EQ(Get(0, "e"), "NOT_FOUND");
+  ASSERT_OK(db_->EndTrace());
+
+  // Count the number of records in the trace file.
+  std::unique_ptr<TraceReader> trace_reader;
+  ASSERT_OK(NewFileTraceReader(env_, env_opts, trace_filename, &trace_reader));
+  int count = 0;
+  std::string data;
+  while (trace_reader->Read(&data).ok()) {
+    count += 1;
+  }
+  // 2 sampled WRITE + 2 in-scope GET + HEADER + FOOTER = 6
+  ASSERT_EQ(count, 6);
+}
+
 TEST_F(DBTest2, TraceWithFilter) {
   Options options = CurrentOptions();
   options.merge_operator = MergeOperators::CreatePutOperator();
@@ -5812,6 +6011,37 @@ TEST_F(DBTest2, RowCacheSnapshot) {
   db_->ReleaseSnapshot(s2);
   db_->ReleaseSnapshot(s3);
 }
+
+TEST_F(DBTest2, RowLookupCacheDeleteRange) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.row_lookup_cache = NewRowLookupCache(8 * 8192);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "bar"));
+  ASSERT_OK(Put("foo2", "bar2"));
+  ASSERT_OK(Flush());
+
+  // Warm the cache from the table files.
+  ASSERT_EQ(Get("foo"), "bar");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_MISS), 1);
+  ASSERT_EQ(Get("foo"), "bar");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 1);
+
+  // A range tombstone in the mutable memtable hides the cached row without
+  // advancing the new data epoch. The cached row must not be served, and
+  // the deleted key must not be re-inserted from the files.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "foo",
+                             "foo2"));
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 1);
+
+  // Keys outside the tombstone's range still use the cache.
+  ASSERT_EQ(Get("foo2"), "bar2");
+  ASSERT_EQ(Get("foo2"), "bar2");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 2);
+}
 #endif  // ROCKSDB_LITE
 
 // When DB is reopened with multiple column families, the manifest file
@@ -647,6 +647,71 @@ TEST_F(DBBasicTestWithTimestamp, GetTimestampTableProperties) {
 }
 #endif  // !ROCKSDB_LITE
 
+TEST_F(DBBasicTestWithTimestamp, TimestampRangePruning) {
+  Options options = CurrentOptions();
+  options.env = env_;
+  const size_t kTimestampSize = Timestamp(0, 0).size();
+  TestComparator test_cmp(kTimestampSize);
+  options.comparator = &test_cmp;
+  DestroyAndReopen(options);
+
+  // A file with only new data (ts=5) below a file with only old data
+  // (ts=1), so that reads at ts=3 can skip the newer file based on its
+  // persisted timestamp range.
+  ASSERT_OK(db_->Put(WriteOptions(), "k2", Timestamp(5, 0), "v2new"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_OK(db_->Put(WriteOptions(), "k1", Timestamp(1, 0), "v1old"));
+  ASSERT_OK(Flush());
+
+  int pruned = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "TableCache::PruneForReadTimestamp:Pruned",
+      [&](void* /*arg*/) { ++pruned; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // "k2" only exists at ts=5; a lookup at ts=3 skips its file without
+  // searching it.
+  std::string read_ts = Timestamp(3, 0);
+  Slice read_ts_slice = read_ts;
+  ReadOptions read_opts;
+  read_opts.timestamp = &read_ts_slice;
+  std::string value;
+  ASSERT_TRUE(db_->Get(read_opts, "k2", &value).IsNotFound());
+  ASSERT_GT(pruned, 0);
+
+  // A scan at ts=3 only sees "k1"; the newer file is pruned when the
+  // iterator opens it.
+  pruned = 0;
+  {
+    std::unique_ptr<Iterator> it(db_->NewIterator(read_opts));
+    it->SeekToFirst();
+    ASSERT_TRUE(it->Valid());
+    ASSERT_EQ("k1", it->key().ToString());
+    ASSERT_EQ("v1old", it->value().ToString());
+    it->Next();
+    ASSERT_FALSE(it->Valid());
+    ASSERT_OK(it->status());
+  }
+  ASSERT_GT(pruned, 0);
+
+  // Unflushed entries are skipped via the memtable's timestamp range too.
+  ASSERT_OK(db_->Put(WriteOptions(), "k3", Timestamp(5, 0), "v3new"));
+  ASSERT_TRUE(db_->Get(read_opts, "k3", &value).IsNotFound());
+
+  // At ts=6 everything is visible again.
+  read_ts = Timestamp(6, 0);
+  read_ts_slice = read_ts;
+  ASSERT_OK(db_->Get(read_opts, "k2", &value));
+  ASSERT_EQ("v2new", value);
+  ASSERT_OK(db_->Get(read_opts, "k3", &value));
+  ASSERT_EQ("v3new", value);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
 class DBBasicTestWithTimestampTableOptions
     : public DBBasicTestWithTimestampBase,
       public testing::WithParamInterface<BlockBasedTableOptions::IndexType> {
@@ -486,6 +486,53 @@ TEST_P(DBWriteTest, ConcurrentlyDisabledWAL) {
     ASSERT_LE(bytes_num, 1024 * 100);
 }
 
+TEST_P(DBWriteTest, AdaptiveWriteBatchGroupSizeController) {
+  Options options = GetOptions();
+  options.max_write_batch_group_size_bytes = 1 << 20;
+  options.adaptive_write_batch_group_size = true;
+  ImmutableDBOptions db_options(options);
+  WriteThread write_thread(db_options);
+
+  const uint64_t configured = options.max_write_batch_group_size_bytes;
+  ASSERT_EQ(write_thread.GetMaxWriteBatchGroupSizeBytes(), configured);
+
+  // When larger groups keep lowering per-byte latency, the controller should
+  // probe up until it reaches the 8x upper bound, and never leave the
+  // 1/8x..8x range on the way.
+  for (int epoch = 0; epoch < 100; epoch++) {
+    uint64_t limit = write_thread.GetMaxWriteBatchGroupSizeBytes();
+    for (uint32_t i = 0; i < WriteThread::kAdaptiveEpochGroups; i++) {
+      // Fixed cost per group, so per-byte latency improves with size
+      write_thread.UpdateAdaptiveGroupSize(limit, 1000 * 1000);
+    }
+    uint64_t new_limit = write_thread.GetMaxWriteBatchGroupSizeBytes();
+    ASSERT_GE(new_limit, configured / 8);
+    ASSERT_LE(new_limit, configured * 8);
+  }
+  ASSERT_EQ(write_thread.GetMaxWriteBatchGroupSizeBytes(), configured * 8);
+
+  // When latency per byte keeps regressing, the controller should back off
+  // from the bound rather than stay pinned there.
+  uint64_t cost = 1000 * 1000;
+  for (int epoch = 0; epoch < 10; epoch++) {
+    uint64_t limit = write_thread.GetMaxWriteBatchGroupSizeBytes();
+    cost *= 2;
+    for (uint32_t i = 0; i < WriteThread::kAdaptiveEpochGroups; i++) {
+      write_thread.UpdateAdaptiveGroupSize(limit, cost);
+    }
+  }
+  ASSERT_LT(write_thread.GetMaxWriteBatchGroupSizeBytes(), configured * 8);
+
+  // End to end: writes through a DB with adaptive sizing enabled still work.
+  Reopen(options);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_OK(Put("key" + std::to_string(i), DummyString(100)));
+  }
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(Get("key" + std::to_string(i)), DummyString(100));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(DBWriteTestInstance, DBWriteTest,
                         testing::Values(DBTestBase::kDefault,
                                         DBTestBase::kConcurrentWALWrites,
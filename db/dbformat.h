@@ -269,6 +269,14 @@ class InternalKeyComparator
     return user_comparator_.user_comparator();
   }
 
+  // Returns the wrapped user comparator. Unlike user_comparator(), whose
+  // Compare() always dispatches through the vtable, the wrapper serves the
+  // built-in bytewise comparators inline, so hot loops should compare
+  // through it.
+  const UserComparatorWrapper& user_comparator_wrapper() const {
+    return user_comparator_;
+  }
+
   int Compare(const InternalKey& a, const InternalKey& b) const;
   int Compare(const ParsedInternalKey& a, const ParsedInternalKey& b) const;
   // In this `Compare()` overload, the sequence numbers provided in
@@ -5,9 +5,14 @@
 
 #include "rocksdb/experimental.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "db/db_impl/db_impl.h"
 #include "db/version_util.h"
 #include "logging/logging.h"
+#include "port/port.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace experimental {
@@ -30,6 +35,288 @@ Status PromoteL0(DB* db, ColumnFamilyHandle* column_family, int target_level) {
   return db->PromoteL0(column_family, target_level);
 }
 
+namespace {
+
+// Iterator over [begin, end) that scans partitions of the range on a pool of
+// threads and merges the results by concatenation: the partitions tile the
+// range in key order, so streaming the chunks of partition i before those of
+// partition i + 1 yields a fully ordered scan. Workers claim partitions in
+// order and at most two chunks are buffered per claimed partition; a worker
+// that gets ahead of the consumer blocks, which bounds buffered memory to
+// roughly 2 * parallelism * chunk_bytes.
+class ParallelScanIterator : public Iterator {
+ public:
+  ParallelScanIterator(DB* db, const ReadOptions& read_options,
+                       ColumnFamilyHandle* column_family, const Slice* begin,
+                       const Slice* end, const ParallelScanOptions& options,
+                       std::vector<std::string> boundaries)
+      : db_(db),
+        read_options_(read_options),
+        column_family_(column_family),
+        chunk_bytes_(std::max(options.chunk_bytes, size_t{1})) {
+    if (read_options_.snapshot == nullptr) {
+      own_snapshot_ = db_->GetSnapshot();
+      read_options_.snapshot = own_snapshot_;
+    }
+
+    partitions_.resize(boundaries.size() + 1);
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      Partition& part = partitions_[i];
+      if (i > 0) {
+        part.has_lower = true;
+        part.lower = std::move(boundaries[i - 1]);
+      } else if (begin != nullptr) {
+        part.has_lower = true;
+        part.lower = begin->ToString();
+      }
+      if (i + 1 < partitions_.size()) {
+        part.has_upper = true;
+        // Copied, not moved: the same key seeds the next partition's lower
+        // bound above.
+        part.upper = boundaries[i];
+      } else if (end != nullptr) {
+        part.has_upper = true;
+        part.upper = end->ToString();
+      }
+    }
+
+    const size_t num_threads =
+        std::min(std::max(options.parallelism, size_t{1}), partitions_.size());
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads_.emplace_back(&ParallelScanIterator::WorkerLoop, this);
+    }
+  }
+
+  // No copying allowed
+  ParallelScanIterator(const ParallelScanIterator&) = delete;
+  ParallelScanIterator& operator=(const ParallelScanIterator&) = delete;
+
+  ~ParallelScanIterator() override {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      aborted_ = true;
+    }
+    worker_cv_.notify_all();
+    for (auto& t : threads_) {
+      t.join();
+    }
+    if (own_snapshot_ != nullptr) {
+      db_->ReleaseSnapshot(own_snapshot_);
+    }
+  }
+
+  bool Valid() const override { return valid_; }
+
+  void SeekToFirst() override {
+    if (started_) {
+      MarkNotSupported("ParallelScanIterator is single-pass");
+      return;
+    }
+    started_ = true;
+    FetchNextChunk();
+  }
+
+  void Next() override {
+    assert(Valid());
+    ++cur_entry_;
+    if (cur_entry_ >= cur_chunk_.size()) {
+      FetchNextChunk();
+    }
+  }
+
+  void SeekToLast() override {
+    MarkNotSupported("SeekToLast() is not supported");
+  }
+  void Seek(const Slice& /*target*/) override {
+    MarkNotSupported("Seek() is not supported");
+  }
+  void SeekForPrev(const Slice& /*target*/) override {
+    MarkNotSupported("SeekForPrev() is not supported");
+  }
+  void Prev() override { MarkNotSupported("Prev() is not supported"); }
+
+  Slice key() const override {
+    assert(Valid());
+    return cur_chunk_[cur_entry_].first;
+  }
+
+  Slice value() const override {
+    assert(Valid());
+    return cur_chunk_[cur_entry_].second;
+  }
+
+  Status status() const override { return status_; }
+
+ private:
+  using Chunk = std::vector<std::pair<std::string, std::string>>;
+
+  struct Partition {
+    bool has_lower = false;
+    bool has_upper = false;
+    std::string lower;
+    std::string upper;
+    // Chunks ready for the consumer, in key order. Capped at
+    // kMaxBufferedChunks; the scanning thread blocks when it is full.
+    std::deque<Chunk> buffered;
+    bool done = false;
+    Status status;
+  };
+
+  static constexpr size_t kMaxBufferedChunks = 2;
+
+  void MarkNotSupported(const char* msg) {
+    valid_ = false;
+    status_ = Status::NotSupported(msg);
+  }
+
+  void WorkerLoop() {
+    while (true) {
+      size_t idx;
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (aborted_ || next_partition_ >= partitions_.size()) {
+          return;
+        }
+        idx = next_partition_++;
+      }
+      ScanPartition(idx);
+    }
+  }
+
+  void ScanPartition(size_t idx) {
+    Partition& part = partitions_[idx];
+    ReadOptions ro = read_options_;
+    Slice upper_bound;
+    if (part.has_upper) {
+      upper_bound = part.upper;
+      ro.iterate_upper_bound = &upper_bound;
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro, column_family_));
+    if (part.has_lower) {
+      iter->Seek(part.lower);
+    } else {
+      iter->SeekToFirst();
+    }
+
+    Chunk chunk;
+    size_t chunk_size = 0;
+    for (; iter->Valid(); iter->Next()) {
+      chunk.emplace_back(iter->key().ToString(), iter->value().ToString());
+      chunk_size += iter->key().size() + iter->value().size();
+      if (chunk_size >= chunk_bytes_) {
+        if (!EmitChunk(&part, std::move(chunk))) {
+          return;  // aborted
+        }
+        chunk = Chunk();
+        chunk_size = 0;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    part.status = iter->status();
+    if (part.status.ok() && !chunk.empty()) {
+      part.buffered.push_back(std::move(chunk));
+    }
+    part.done = true;
+    consumer_cv_.notify_all();
+  }
+
+  // Hands a chunk to the consumer, blocking while the partition's buffer is
+  // full. Returns false if the scan was aborted.
+  bool EmitChunk(Partition* part, Chunk&& chunk) {
+    std::unique_lock<std::mutex> lock(mu_);
+    worker_cv_.wait(lock, [&] {
+      return aborted_ || part->buffered.size() < kMaxBufferedChunks;
+    });
+    if (aborted_) {
+      return false;
+    }
+    part->buffered.push_back(std::move(chunk));
+    consumer_cv_.notify_all();
+    return true;
+  }
+
+  void FetchNextChunk() {
+    cur_chunk_.clear();
+    cur_entry_ = 0;
+    std::unique_lock<std::mutex> lock(mu_);
+    while (cur_partition_ < partitions_.size()) {
+      Partition& part = partitions_[cur_partition_];
+      consumer_cv_.wait(lock,
+                        [&] { return !part.buffered.empty() || part.done; });
+      if (!part.buffered.empty()) {
+        cur_chunk_ = std::move(part.buffered.front());
+        part.buffered.pop_front();
+        worker_cv_.notify_all();
+        valid_ = true;
+        return;
+      }
+      if (!part.status.ok()) {
+        status_ = part.status;
+        valid_ = false;
+        return;
+      }
+      ++cur_partition_;
+    }
+    valid_ = false;  // range exhausted
+  }
+
+  DB* const db_;
+  ReadOptions read_options_;
+  ColumnFamilyHandle* const column_family_;
+  const size_t chunk_bytes_;
+  const Snapshot* own_snapshot_ = nullptr;
+
+  std::mutex mu_;
+  std::condition_variable consumer_cv_;
+  std::condition_variable worker_cv_;
+  std::vector<Partition> partitions_;
+  size_t next_partition_ = 0;  // next partition a worker will claim
+  bool aborted_ = false;
+  std::vector<port::Thread> threads_;
+
+  // Consumer-only state, accessed without the mutex.
+  bool started_ = false;
+  bool valid_ = false;
+  Status status_;
+  Chunk cur_chunk_;
+  size_t cur_entry_ = 0;
+  size_t cur_partition_ = 0;
+};
+
+}  // namespace
+
+Iterator* NewParallelIterator(DB* db, const ReadOptions& read_options,
+                              ColumnFamilyHandle* column_family,
+                              const Slice* begin, const Slice* end,
+                              const ParallelScanOptions& options) {
+  if (db == nullptr) {
+    return NewErrorIterator(Status::InvalidArgument("DB is empty"));
+  }
+  if (column_family == nullptr) {
+    column_family = db->DefaultColumnFamily();
+  }
+  if (read_options.tailing || read_options.iterate_lower_bound != nullptr ||
+      read_options.iterate_upper_bound != nullptr) {
+    return NewErrorIterator(
+        Status::NotSupported("NewParallelIterator() does not support tailing "
+                             "or explicit iterate bounds"));
+  }
+  const size_t max_partitions = options.max_partitions != 0
+                                    ? options.max_partitions
+                                    : 4 * std::max(options.parallelism,
+                                                   size_t{1});
+  std::vector<std::string> boundaries;
+  Status s = db->GetScanPartitionBoundaries(column_family, begin, end,
+                                            max_partitions, &boundaries);
+  if (!s.ok()) {
+    return NewErrorIterator(s);
+  }
+  return new ParallelScanIterator(db, read_options, column_family, begin, end,
+                                  options, std::move(boundaries));
+}
+
 #else  // ROCKSDB_LITE
 
 Status SuggestCompactRange(DB* /*db*/, ColumnFamilyHandle* /*column_family*/,
@@ -42,6 +329,14 @@ Status PromoteL0(DB* /*db*/, ColumnFamilyHandle* /*column_family*/,
   return Status::NotSupported("Not supported in RocksDB LITE");
 }
 
+Iterator* NewParallelIterator(DB* /*db*/, const ReadOptions& /*read_options*/,
+                              ColumnFamilyHandle* /*column_family*/,
+                              const Slice* /*begin*/, const Slice* /*end*/,
+                              const ParallelScanOptions& /*options*/) {
+  return NewErrorIterator(
+      Status::NotSupported("Not supported in RocksDB LITE"));
+}
+
 #endif  // ROCKSDB_LITE
 
 Status SuggestCompactRange(DB* db, const Slice* begin, const Slice* end) {
@@ -287,6 +287,57 @@ class ChecksumVerifyHelper {
   }
 };
 
+TEST_F(ExternalSSTFileBasicTest, PipelinedBuild) {
+  Options options = CurrentOptions();
+  options.compression_opts.parallel_threads = 2;
+
+  SstFileWriter sst_file_writer(EnvOptions(), options,
+                                nullptr /* column_family */,
+                                true /* invalidate_page_cache */,
+                                Env::IOPriority::IO_TOTAL,
+                                false /* skip_filters */,
+                                true /* pipelined_build */);
+
+  // file1.sst (0 => 4999), with a range deletion in the middle
+  std::string file1 = sst_files_dir_ + "file1.sst";
+  ASSERT_OK(sst_file_writer.Open(file1));
+  for (int k = 0; k < 5000; k++) {
+    ASSERT_OK(sst_file_writer.Put(Key(k), Key(k) + "_val"));
+  }
+  ASSERT_OK(sst_file_writer.DeleteRange(Key(5000), Key(5100)));
+  ExternalSstFileInfo file1_info;
+  Status s = sst_file_writer.Finish(&file1_info);
+  ASSERT_OK(s) << s.ToString();
+
+  ASSERT_GT(sst_file_writer.FileSize(), 0);
+  ASSERT_EQ(file1_info.file_path, file1);
+  ASSERT_EQ(file1_info.num_entries, 5000);
+  ASSERT_EQ(file1_info.smallest_key, Key(0));
+  ASSERT_EQ(file1_info.largest_key, Key(4999));
+  ASSERT_EQ(file1_info.num_range_del_entries, 1);
+
+  DestroyAndReopen(options);
+  s = DeprecatedAddFile({file1});
+  ASSERT_OK(s) << s.ToString();
+  for (int k = 0; k < 5000; k++) {
+    ASSERT_EQ(Get(Key(k)), Key(k) + "_val");
+  }
+
+  // An abandoned pipelined writer must shut its builder thread down cleanly.
+  {
+    SstFileWriter abandoned_writer(EnvOptions(), options,
+                                   nullptr /* column_family */,
+                                   true /* invalidate_page_cache */,
+                                   Env::IOPriority::IO_TOTAL,
+                                   false /* skip_filters */,
+                                   true /* pipelined_build */);
+    ASSERT_OK(abandoned_writer.Open(sst_files_dir_ + "file2.sst"));
+    ASSERT_OK(abandoned_writer.Put(Key(0), "val"));
+  }
+
+  DestroyAndRecreateExternalSSTFilesDir();
+}
+
 TEST_F(ExternalSSTFileBasicTest, BasicWithFileChecksumCrc32c) {
   Options options = CurrentOptions();
   options.file_checksum_gen_factory = GetFileChecksumGenCrc32cFactory();
@@ -8,6 +8,7 @@
 #include "db/external_sst_file_ingestion_job.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <string>
 #include <unordered_set>
@@ -18,6 +19,7 @@
 #include "file/file_util.h"
 #include "file/random_access_file_reader.h"
 #include "logging/logging.h"
+#include "port/port.h"
 #include "table/merging_iterator.h"
 #include "table/scoped_arena_iterator.h"
 #include "table/sst_file_writer_collectors.h"
@@ -36,15 +38,21 @@ Status ExternalSstFileIngestionJob::Prepare(
     SuperVersion* sv) {
   Status status;
 
-  // Read the information of files we are ingesting
-  for (const std::string& file_path : external_files_paths) {
-    IngestedFileInfo file_to_ingest;
-    status =
-        GetIngestedFileInfo(file_path, next_file_number++, &file_to_ingest, sv);
-    if (!status.ok()) {
-      return status;
-    }
+  // Read the information of files we are ingesting. Each file is
+  // self-contained, and opening it, reading its properties and (optionally)
+  // verifying its checksum are all I/O bound, so a pool of threads keeps
+  // several files in flight for large batches.
+  files_to_ingest_.resize(external_files_paths.size());
+  status = RunForEachFile(external_files_paths.size(), [&](size_t i) {
+    return GetIngestedFileInfo(external_files_paths[i], next_file_number + i,
+                               &files_to_ingest_[i], sv);
+  });
+  if (!status.ok()) {
+    files_to_ingest_.clear();
+    return status;
+  }
 
+  for (const IngestedFileInfo& file_to_ingest : files_to_ingest_) {
     if (file_to_ingest.cf_id !=
             TablePropertiesCollectorFactory::Context::kUnknownColumnFamily &&
         file_to_ingest.cf_id != cfd_->GetID()) {
@@ -61,8 +69,6 @@ Status ExternalSstFileIngestionJob::Prepare(
         !file_to_ingest.largest_internal_key.Valid()) {
       return Status::Corruption("Generated table have corrupted keys");
     }
-
-    files_to_ingest_.emplace_back(std::move(file_to_ingest));
   }
 
   const Comparator* ucmp = cfd_->internal_comparator().user_comparator();
@@ -101,73 +107,40 @@ Status ExternalSstFileIngestionJob::Prepare(
     return Status::NotSupported("Files have overlapping ranges");
   }
 
-  // Copy/Move external files into DB
-  std::unordered_set<size_t> ingestion_path_ids;
-  for (IngestedFileInfo& f : files_to_ingest_) {
-    f.copy_file = false;
-    const std::string path_outside_db = f.external_file_path;
-    const std::string path_inside_db =
-        TableFileName(cfd_->ioptions()->cf_paths, f.fd.GetNumber(),
-                      f.fd.GetPathId());
-    if (ingestion_options_.move_files) {
-      status =
-          fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
-      if (status.ok()) {
-        // It is unsafe to assume application had sync the file and file
-        // directory before ingest the file. For integrity of RocksDB we need
-        // to sync the file.
-        std::unique_ptr<FSWritableFile> file_to_sync;
-        Status s = fs_->ReopenWritableFile(path_inside_db, env_options_,
-                                           &file_to_sync, nullptr);
-        TEST_SYNC_POINT_CALLBACK("ExternalSstFileIngestionJob::Prepare:Reopen",
-                                 &s);
-        // Some file systems (especially remote/distributed) don't support
-        // reopening a file for writing and don't require reopening and
-        // syncing the file. Ignore the NotSupported error in that case.
-        if (!s.IsNotSupported()) {
-          status = s;
-          if (status.ok()) {
-            TEST_SYNC_POINT(
-                "ExternalSstFileIngestionJob::BeforeSyncIngestedFile");
-            status = SyncIngestedFile(file_to_sync.get());
-            TEST_SYNC_POINT(
-                "ExternalSstFileIngestionJob::AfterSyncIngestedFile");
-            if (!status.ok()) {
-              ROCKS_LOG_WARN(db_options_.info_log,
-                             "Failed to sync ingested file %s: %s",
-                             path_inside_db.c_str(), status.ToString().c_str());
-            }
-          }
-        }
-      } else if (status.IsNotSupported() &&
-                 ingestion_options_.failed_move_fall_back_to_copy) {
-        // Original file is on a different FS, use copy instead of hard linking.
-        f.copy_file = true;
-        ROCKS_LOG_INFO(db_options_.info_log,
-                       "Triy to link file %s but it's not supported : %s",
-                       path_outside_db.c_str(), status.ToString().c_str());
-      }
+  // Decide up front whether file checksums need to be generated, so that
+  // generation can be overlapped with the copies below: while one thread is
+  // copying a file, another can be reading a copied file back to compute its
+  // checksum.
+  bool generate_checksum_during_copy = false;
+  if (db_options_.file_checksum_gen_factory != nullptr) {
+    if (ingestion_options_.verify_file_checksum == false &&
+        files_checksums.size() == files_to_ingest_.size() &&
+        files_checksum_func_names.size() == files_to_ingest_.size()) {
+      // Only when verify_file_checksum == false and the checksum for ingested
+      // files are provided, DB will use the provided checksum and does not
+      // generate the checksum for ingested files.
+      need_generate_file_checksum_ = false;
     } else {
-      f.copy_file = true;
+      need_generate_file_checksum_ = true;
+      generate_checksum_during_copy = true;
     }
+  }
+  std::vector<std::string> generated_checksums(files_to_ingest_.size());
+  std::vector<std::string> generated_checksum_func_names(
+      files_to_ingest_.size());
 
-    if (f.copy_file) {
-      TEST_SYNC_POINT_CALLBACK("ExternalSstFileIngestionJob::Prepare:CopyFile",
-                               nullptr);
-      // CopyFile also sync the new file.
-      status =
-          CopyFile(fs_.get(), path_outside_db, path_inside_db, 0,
-                   db_options_.use_fsync, io_tracer_, Temperature::kUnknown);
-    }
-    TEST_SYNC_POINT("ExternalSstFileIngestionJob::Prepare:FileAdded");
-    if (!status.ok()) {
-      break;
+  // Copy/Move external files into DB
+  status = RunForEachFile(files_to_ingest_.size(), [&](size_t i) {
+    return PrepareOneFile(&files_to_ingest_[i], generate_checksum_during_copy,
+                          &generated_checksums[i],
+                          &generated_checksum_func_names[i]);
+  });
+
+  std::unordered_set<size_t> ingestion_path_ids;
+  if (status.ok()) {
+    for (IngestedFileInfo& f : files_to_ingest_) {
+      ingestion_path_ids.insert(f.fd.GetPathId());
     }
-    f.internal_file_path = path_inside_db;
-    // Initialize the checksum information of ingested files.
-    f.file_checksum = kUnknownFileChecksum;
-    f.file_checksum_func_name = kUnknownFileChecksumFuncName;
-    ingestion_path_ids.insert(f.fd.GetPathId());
   }
 
   TEST_SYNC_POINT("ExternalSstFileIngestionJob::BeforeSyncDir");
@@ -187,7 +160,8 @@ Status ExternalSstFileIngestionJob::Prepare(
   }
   TEST_SYNC_POINT("ExternalSstFileIngestionJob::AfterSyncDir");
 
-  // Generate and check the sst file checksum. Note that, if
+  // Check the sst file checksums. The checksums themselves were generated
+  // while the files were copied above. Note that, if
   // IngestExternalFileOptions::write_global_seqno is true, we will not update
   // the checksum information in the files_to_ingests_ here, since the file is
   // upadted with the new global_seqno. After global_seqno is updated, DB will
@@ -195,124 +169,75 @@ Status ExternalSstFileIngestionJob::Prepare(
   // if ingestion_options_.write_global_seqno == true and
   // verify_file_checksum is false, we only check the checksum function name.
   if (status.ok() && db_options_.file_checksum_gen_factory != nullptr) {
-    if (ingestion_options_.verify_file_checksum == false &&
-        files_checksums.size() == files_to_ingest_.size() &&
-        files_checksum_func_names.size() == files_to_ingest_.size()) {
-      // Only when verify_file_checksum == false and the checksum for ingested
-      // files are provided, DB will use the provided checksum and does not
-      // generate the checksum for ingested files.
-      need_generate_file_checksum_ = false;
-    } else {
-      need_generate_file_checksum_ = true;
-    }
     FileChecksumGenContext gen_context;
     std::unique_ptr<FileChecksumGenerator> file_checksum_gen =
         db_options_.file_checksum_gen_factory->CreateFileChecksumGenerator(
             gen_context);
-    std::vector<std::string> generated_checksums;
-    std::vector<std::string> generated_checksum_func_names;
-    // Step 1: generate the checksum for ingested sst file.
-    if (need_generate_file_checksum_) {
-      for (size_t i = 0; i < files_to_ingest_.size(); i++) {
-        std::string generated_checksum;
-        std::string generated_checksum_func_name;
-        std::string requested_checksum_func_name;
-        // TODO: rate limit file reads for checksum calculation during file
-        // ingestion.
-        IOStatus io_s = GenerateOneFileChecksum(
-            fs_.get(), files_to_ingest_[i].internal_file_path,
-            db_options_.file_checksum_gen_factory.get(),
-            requested_checksum_func_name, &generated_checksum,
-            &generated_checksum_func_name,
-            ingestion_options_.verify_checksums_readahead_size,
-            db_options_.allow_mmap_reads, io_tracer_,
-            db_options_.rate_limiter.get(),
-            Env::IO_TOTAL /* rate_limiter_priority */);
-        if (!io_s.ok()) {
-          status = io_s;
-          ROCKS_LOG_WARN(db_options_.info_log,
-                         "Sst file checksum generation of file: %s failed: %s",
-                         files_to_ingest_[i].internal_file_path.c_str(),
-                         status.ToString().c_str());
-          break;
-        }
-        if (ingestion_options_.write_global_seqno == false) {
-          files_to_ingest_[i].file_checksum = generated_checksum;
-          files_to_ingest_[i].file_checksum_func_name =
-              generated_checksum_func_name;
-        }
-        generated_checksums.push_back(generated_checksum);
-        generated_checksum_func_names.push_back(generated_checksum_func_name);
-      }
-    }
-
-    // Step 2: based on the verify_file_checksum and ingested checksum
-    // information, do the verification.
-    if (status.ok()) {
-      if (files_checksums.size() == files_to_ingest_.size() &&
-          files_checksum_func_names.size() == files_to_ingest_.size()) {
-        // Verify the checksum and checksum function name.
-        if (ingestion_options_.verify_file_checksum) {
-          for (size_t i = 0; i < files_to_ingest_.size(); i++) {
-            if (files_checksum_func_names[i] !=
-                generated_checksum_func_names[i]) {
-              status = Status::InvalidArgument(
-                  "Checksum function name does not match with the checksum "
-                  "function name of this DB");
-              ROCKS_LOG_WARN(
-                  db_options_.info_log,
-                  "Sst file checksum verification of file: %s failed: %s",
-                  external_files_paths[i].c_str(), status.ToString().c_str());
-              break;
-            }
-            if (files_checksums[i] != generated_checksums[i]) {
-              status = Status::Corruption(
-                  "Ingested checksum does not match with the generated "
-                  "checksum");
-              ROCKS_LOG_WARN(
-                  db_options_.info_log,
-                  "Sst file checksum verification of file: %s failed: %s",
-                  files_to_ingest_[i].internal_file_path.c_str(),
-                  status.ToString().c_str());
-              break;
-            }
+    // Based on the verify_file_checksum and ingested checksum information,
+    // do the verification.
+    if (files_checksums.size() == files_to_ingest_.size() &&
+        files_checksum_func_names.size() == files_to_ingest_.size()) {
+      // Verify the checksum and checksum function name.
+      if (ingestion_options_.verify_file_checksum) {
+        for (size_t i = 0; i < files_to_ingest_.size(); i++) {
+          if (files_checksum_func_names[i] !=
+              generated_checksum_func_names[i]) {
+            status = Status::InvalidArgument(
+                "Checksum function name does not match with the checksum "
+                "function name of this DB");
+            ROCKS_LOG_WARN(
+                db_options_.info_log,
+                "Sst file checksum verification of file: %s failed: %s",
+                external_files_paths[i].c_str(), status.ToString().c_str());
+            break;
           }
-        } else {
-          // If verify_file_checksum is not enabled, we only verify the
-          // checksum function name. If it does not match, fail the ingestion.
-          // If matches, we trust the ingested checksum information and store
-          // in the Manifest.
-          for (size_t i = 0; i < files_to_ingest_.size(); i++) {
-            if (files_checksum_func_names[i] != file_checksum_gen->Name()) {
-              status = Status::InvalidArgument(
-                  "Checksum function name does not match with the checksum "
-                  "function name of this DB");
-              ROCKS_LOG_WARN(
-                  db_options_.info_log,
-                  "Sst file checksum verification of file: %s failed: %s",
-                  external_files_paths[i].c_str(), status.ToString().c_str());
-              break;
-            }
-            files_to_ingest_[i].file_checksum = files_checksums[i];
-            files_to_ingest_[i].file_checksum_func_name =
-                files_checksum_func_names[i];
+          if (files_checksums[i] != generated_checksums[i]) {
+            status = Status::Corruption(
+                "Ingested checksum does not match with the generated "
+                "checksum");
+            ROCKS_LOG_WARN(
+                db_options_.info_log,
+                "Sst file checksum verification of file: %s failed: %s",
+                files_to_ingest_[i].internal_file_path.c_str(),
+                status.ToString().c_str());
+            break;
           }
         }
-      } else if (files_checksums.size() != files_checksum_func_names.size() ||
-                 (files_checksums.size() == files_checksum_func_names.size() &&
-                  files_checksums.size() != 0)) {
-        // The checksum or checksum function name vector are not both empty
-        // and they are incomplete.
-        status = Status::InvalidArgument(
-            "The checksum information of ingested sst files are nonempty and "
-            "the size of checksums or the size of the checksum function "
-            "names "
-            "does not match with the number of ingested sst files");
-        ROCKS_LOG_WARN(
-            db_options_.info_log,
-            "The ingested sst files checksum information is incomplete: %s",
-            status.ToString().c_str());
+      } else {
+        // If verify_file_checksum is not enabled, we only verify the
+        // checksum function name. If it does not match, fail the ingestion.
+        // If matches, we trust the ingested checksum information and store
+        // in the Manifest.
+        for (size_t i = 0; i < files_to_ingest_.size(); i++) {
+          if (files_checksum_func_names[i] != file_checksum_gen->Name()) {
+            status = Status::InvalidArgument(
+                "Checksum function name does not match with the checksum "
+                "function name of this DB");
+            ROCKS_LOG_WARN(
+                db_options_.info_log,
+                "Sst file checksum verification of file: %s failed: %s",
+                external_files_paths[i].c_str(), status.ToString().c_str());
+            break;
+          }
+          files_to_ingest_[i].file_checksum = files_checksums[i];
+          files_to_ingest_[i].file_checksum_func_name =
+              files_checksum_func_names[i];
+        }
       }
+    } else if (files_checksums.size() != files_checksum_func_names.size() ||
+               (files_checksums.size() == files_checksum_func_names.size() &&
+                files_checksums.size() != 0)) {
+      // The checksum or checksum function name vector are not both empty
+      // and they are incomplete.
+      status = Status::InvalidArgument(
+          "The checksum information of ingested sst files are nonempty and "
+          "the size of checksums or the size of the checksum function "
+          "names "
+          "does not match with the number of ingested sst files");
+      ROCKS_LOG_WARN(
+          db_options_.info_log,
+          "The ingested sst files checksum information is incomplete: %s",
+          status.ToString().c_str());
     }
   }
 
@@ -336,6 +261,138 @@ Status ExternalSstFileIngestionJob::Prepare(
   return status;
 }
 
+Status ExternalSstFileIngestionJob::RunForEachFile(
+    size_t n, const std::function<Status(size_t)>& func) {
+  std::vector<Status> statuses(n);
+  std::atomic<size_t> next_file_idx(0);
+  std::atomic<bool> failed(false);
+  std::function<void()> work_func([&]() {
+    while (!failed.load(std::memory_order_relaxed)) {
+      size_t i = next_file_idx.fetch_add(1);
+      if (i >= n) {
+        break;
+      }
+      statuses[i] = func(i);
+      if (!statuses[i].ok()) {
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  size_t max_threads =
+      static_cast<size_t>(std::max(1, db_options_.max_file_opening_threads));
+  max_threads = std::min(max_threads, n);
+  std::vector<port::Thread> threads;
+  for (size_t t = 1; t < max_threads; t++) {
+    threads.emplace_back(work_func);
+  }
+  work_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (const Status& s : statuses) {
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  return Status::OK();
+}
+
+Status ExternalSstFileIngestionJob::PrepareOneFile(
+    IngestedFileInfo* file_to_ingest, bool generate_checksum,
+    std::string* generated_checksum,
+    std::string* generated_checksum_func_name) {
+  Status status;
+  IngestedFileInfo& f = *file_to_ingest;
+  f.copy_file = false;
+  const std::string path_outside_db = f.external_file_path;
+  const std::string path_inside_db = TableFileName(
+      cfd_->ioptions()->cf_paths, f.fd.GetNumber(), f.fd.GetPathId());
+  if (ingestion_options_.move_files) {
+    status =
+        fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
+    if (status.ok()) {
+      // It is unsafe to assume application had sync the file and file
+      // directory before ingest the file. For integrity of RocksDB we need
+      // to sync the file.
+      std::unique_ptr<FSWritableFile> file_to_sync;
+      Status s = fs_->ReopenWritableFile(path_inside_db, env_options_,
+                                         &file_to_sync, nullptr);
+      TEST_SYNC_POINT_CALLBACK("ExternalSstFileIngestionJob::Prepare:Reopen",
+                               &s);
+      // Some file systems (especially remote/distributed) don't support
+      // reopening a file for writing and don't require reopening and
+      // syncing the file. Ignore the NotSupported error in that case.
+      if (!s.IsNotSupported()) {
+        status = s;
+        if (status.ok()) {
+          TEST_SYNC_POINT(
+              "ExternalSstFileIngestionJob::BeforeSyncIngestedFile");
+          status = SyncIngestedFile(file_to_sync.get());
+          TEST_SYNC_POINT("ExternalSstFileIngestionJob::AfterSyncIngestedFile");
+          if (!status.ok()) {
+            ROCKS_LOG_WARN(db_options_.info_log,
+                           "Failed to sync ingested file %s: %s",
+                           path_inside_db.c_str(), status.ToString().c_str());
+          }
+        }
+      }
+    } else if (status.IsNotSupported() &&
+               ingestion_options_.failed_move_fall_back_to_copy) {
+      // Original file is on a different FS, use copy instead of hard linking.
+      f.copy_file = true;
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "Triy to link file %s but it's not supported : %s",
+                     path_outside_db.c_str(), status.ToString().c_str());
+    }
+  } else {
+    f.copy_file = true;
+  }
+
+  if (f.copy_file) {
+    TEST_SYNC_POINT_CALLBACK("ExternalSstFileIngestionJob::Prepare:CopyFile",
+                             nullptr);
+    // CopyFile also sync the new file.
+    status = CopyFile(fs_.get(), path_outside_db, path_inside_db, 0,
+                      db_options_.use_fsync, io_tracer_, Temperature::kUnknown);
+  }
+  TEST_SYNC_POINT("ExternalSstFileIngestionJob::Prepare:FileAdded");
+  if (!status.ok()) {
+    return status;
+  }
+  f.internal_file_path = path_inside_db;
+  // Initialize the checksum information of ingested files.
+  f.file_checksum = kUnknownFileChecksum;
+  f.file_checksum_func_name = kUnknownFileChecksumFuncName;
+
+  if (generate_checksum) {
+    std::string requested_checksum_func_name;
+    // TODO: rate limit file reads for checksum calculation during file
+    // ingestion.
+    IOStatus io_s = GenerateOneFileChecksum(
+        fs_.get(), f.internal_file_path,
+        db_options_.file_checksum_gen_factory.get(),
+        requested_checksum_func_name, generated_checksum,
+        generated_checksum_func_name,
+        ingestion_options_.verify_checksums_readahead_size,
+        db_options_.allow_mmap_reads, io_tracer_,
+        db_options_.rate_limiter.get(),
+        Env::IO_TOTAL /* rate_limiter_priority */);
+    if (!io_s.ok()) {
+      ROCKS_LOG_WARN(db_options_.info_log,
+                     "Sst file checksum generation of file: %s failed: %s",
+                     f.internal_file_path.c_str(), io_s.ToString().c_str());
+      return io_s;
+    }
+    if (ingestion_options_.write_global_seqno == false) {
+      f.file_checksum = *generated_checksum;
+      f.file_checksum_func_name = *generated_checksum_func_name;
+    }
+  }
+  return status;
+}
+
 Status ExternalSstFileIngestionJob::NeedsFlush(bool* flush_needed,
                                                SuperVersion* super_version) {
   autovector<Range> ranges;
@@ -353,22 +410,27 @@ Status ExternalSstFileIngestionJob::NeedsFlush(bool* flush_needed,
 }
 
 // REQUIRES: we have become the only writer by entering both write_thread_ and
-// nonmem_write_thread_
+// nonmem_write_thread_, unless this is an ingest-behind job. Ingest-behind
+// places the files at the bottommost level with zeroed sequence numbers, so
+// they sit below every live key and may be installed while foreground writes
+// proceed.
 Status ExternalSstFileIngestionJob::Run() {
   Status status;
   SuperVersion* super_version = cfd_->GetSuperVersion();
 #ifndef NDEBUG
-  // We should never run the job with a memtable that is overlapping
-  // with the files we are ingesting
-  bool need_flush = false;
-  status = NeedsFlush(&need_flush, super_version);
-  if (!status.ok()) {
-    return status;
-  }
-  if (need_flush) {
-    return Status::TryAgain();
+  if (!ingestion_options_.ingest_behind) {
+    // We should never run the job with a memtable that is overlapping
+    // with the files we are ingesting
+    bool need_flush = false;
+    status = NeedsFlush(&need_flush, super_version);
+    if (!status.ok()) {
+      return status;
+    }
+    if (need_flush) {
+      return Status::TryAgain();
+    }
+    assert(status.ok() && need_flush == false);
   }
-  assert(status.ok() && need_flush == false);
 #endif
 
   bool force_global_seqno = false;
@@ -4,6 +4,7 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #pragma once
+#include <functional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -137,6 +138,12 @@ class ExternalSstFileIngestionJob {
   int ConsumedSequenceNumbersCount() const { return consumed_seqno_count_; }
 
  private:
+  // Run `func(i)` for every file index in [0, n) on a pool of up to
+  // db_options_.max_file_opening_threads threads, including the calling one.
+  // Stops handing out new files once a call fails and returns the first
+  // non-OK status in file order.
+  Status RunForEachFile(size_t n, const std::function<Status(size_t)>& func);
+
   // Open the external file and populate `file_to_ingest` with all the
   // external information we need to ingest this file.
   Status GetIngestedFileInfo(const std::string& external_file,
@@ -144,6 +151,13 @@ class ExternalSstFileIngestionJob {
                              IngestedFileInfo* file_to_ingest,
                              SuperVersion* sv);
 
+  // Link or copy one external file into the DB directory, sync it, and when
+  // `generate_checksum` is set also compute its checksum. Called for each
+  // file from Prepare(), possibly from several threads at once.
+  Status PrepareOneFile(IngestedFileInfo* file_to_ingest,
+                        bool generate_checksum, std::string* generated_checksum,
+                        std::string* generated_checksum_func_name);
+
   // Assign `file_to_ingest` the appropriate sequence number and the lowest
   // possible level that it can be ingested to according to compaction_style.
   // REQUIRES: Mutex held
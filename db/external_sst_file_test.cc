@@ -2310,6 +2310,64 @@ TEST_P(ExternalSSTFileTest, IngestBehind) {
   VerifyDBFromMap(true_data, &kcnt, false);
 }
 
+TEST_P(ExternalSSTFileTest, IngestBehindStallFree) {
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.allow_ingest_behind = true;
+  options.num_levels = 3;
+  DestroyAndReopen(options);
+
+  bool allow_global_seqno = true;
+  bool write_global_seqno = std::get<0>(GetParam());
+  bool verify_checksums_before_ingest = std::get<1>(GetParam());
+  std::map<std::string, std::string> true_data;
+
+  // Data in the memtable that does not overlap the ingested range.
+  for (int i = 100; i <= 200; i++) {
+    ASSERT_OK(Put(Key(i), "memtable"));
+    true_data[Key(i)] = "memtable";
+  }
+
+  std::atomic<int> write_stops{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::IngestExternalFiles:StopWrites",
+      [&](void* /*arg*/) { write_stops++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<std::pair<std::string, std::string>> file_data;
+  for (int i = 0; i <= 20; i++) {
+    file_data.emplace_back(Key(i), "ingest_behind");
+  }
+  ASSERT_OK(GenerateAndAddExternalFile(
+      options, file_data, -1, allow_global_seqno, write_global_seqno,
+      verify_checksums_before_ingest, true /*ingest_behind*/,
+      false /*sort_data*/, &true_data));
+  // No overlap with the memtable: the file went to the bottommost level
+  // without stopping the write threads or flushing.
+  ASSERT_EQ(0, write_stops.load());
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_EQ(1, NumTableFilesAtLevel(2));
+
+  // An ingested range that overlaps the memtable falls back to the
+  // write-stopping path and flushes.
+  file_data.clear();
+  for (int i = 150; i <= 159; i++) {
+    file_data.emplace_back(Key(i) + "b", "ingest_behind");
+  }
+  ASSERT_OK(GenerateAndAddExternalFile(
+      options, file_data, -1, allow_global_seqno, write_global_seqno,
+      verify_checksums_before_ingest, true /*ingest_behind*/,
+      false /*sort_data*/, &true_data));
+  ASSERT_GT(write_stops.load(), 0);
+  ASSERT_EQ(2, NumTableFilesAtLevel(2));
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  size_t kcnt = 0;
+  VerifyDBFromMap(true_data, &kcnt, false);
+}
+
 TEST_F(ExternalSSTFileTest, SkipBloomFilter) {
   Options options = CurrentOptions();
 
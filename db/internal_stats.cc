@@ -247,6 +247,7 @@ static const std::string cf_file_histogram = "cf-file-histogram";
 static const std::string dbstats = "dbstats";
 static const std::string levelstats = "levelstats";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
+static const std::string block_cache_heatmap = "block-cache-heatmap";
 static const std::string num_immutable_mem_table = "num-immutable-mem-table";
 static const std::string num_immutable_mem_table_flushed =
     "num-immutable-mem-table-flushed";
@@ -301,6 +302,11 @@ static const std::string block_cache_capacity = "block-cache-capacity";
 static const std::string block_cache_usage = "block-cache-usage";
 static const std::string block_cache_pinned_usage = "block-cache-pinned-usage";
 static const std::string options_statistics = "options-statistics";
+static const std::string cf_statistics = "cf-statistics";
+static const std::string perf_sample_stats = "perf-sample-stats";
+static const std::string slo_stats = "slo-stats";
+static const std::string db_mutex_contention_stats =
+    "db-mutex-contention-stats";
 static const std::string num_blob_files = "num-blob-files";
 static const std::string blob_stats = "blob-stats";
 static const std::string total_blob_file_size = "total-blob-file-size";
@@ -326,6 +332,8 @@ const std::string DB::Properties::kDBStats = rocksdb_prefix + dbstats;
 const std::string DB::Properties::kLevelStats = rocksdb_prefix + levelstats;
 const std::string DB::Properties::kBlockCacheEntryStats =
     rocksdb_prefix + block_cache_entry_stats;
+const std::string DB::Properties::kBlockCacheHeatmap =
+    rocksdb_prefix + block_cache_heatmap;
 const std::string DB::Properties::kNumImmutableMemTable =
     rocksdb_prefix + num_immutable_mem_table;
 const std::string DB::Properties::kNumImmutableMemTableFlushed =
@@ -401,6 +409,13 @@ const std::string DB::Properties::kBlockCachePinnedUsage =
     rocksdb_prefix + block_cache_pinned_usage;
 const std::string DB::Properties::kOptionsStatistics =
     rocksdb_prefix + options_statistics;
+const std::string DB::Properties::kCFStatistics =
+    rocksdb_prefix + cf_statistics;
+const std::string DB::Properties::kPerfSampleStats =
+    rocksdb_prefix + perf_sample_stats;
+const std::string DB::Properties::kSLOStats = rocksdb_prefix + slo_stats;
+const std::string DB::Properties::kDBMutexContentionStats =
+    rocksdb_prefix + db_mutex_contention_stats;
 const std::string DB::Properties::kLiveSstFilesSizeAtTemperature =
     rocksdb_prefix + live_sst_files_size_at_temperature;
 const std::string DB::Properties::kNumBlobFiles =
@@ -446,6 +461,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kBlockCacheEntryStats,
          {true, &InternalStats::HandleBlockCacheEntryStats, nullptr,
           &InternalStats::HandleBlockCacheEntryStatsMap, nullptr}},
+        {DB::Properties::kBlockCacheHeatmap,
+         {false, &InternalStats::HandleBlockCacheHeatmap, nullptr,
+          &InternalStats::HandleBlockCacheHeatmapMap, nullptr}},
         {DB::Properties::kSSTables,
          {false, &InternalStats::HandleSsTables, nullptr, nullptr, nullptr}},
         {DB::Properties::kAggregatedTableProperties,
@@ -565,6 +583,18 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kOptionsStatistics,
          {true, nullptr, nullptr, nullptr,
           &DBImpl::GetPropertyHandleOptionsStatistics}},
+        {DB::Properties::kCFStatistics,
+         {false, &InternalStats::HandleCFStatistics, nullptr, nullptr,
+          nullptr}},
+        {DB::Properties::kPerfSampleStats,
+         {false, nullptr, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandlePerfSampleStats}},
+        {DB::Properties::kSLOStats,
+         {false, nullptr, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandleSLOStats}},
+        {DB::Properties::kDBMutexContentionStats,
+         {true, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandleDBMutexContentionStats}},
         {DB::Properties::kNumBlobFiles,
          {false, nullptr, &InternalStats::HandleNumBlobFiles, nullptr,
           nullptr}},
@@ -758,6 +788,43 @@ bool InternalStats::HandleBlockCacheEntryStatsMap(
   return true;
 }
 
+bool InternalStats::HandleBlockCacheHeatmap(std::string* value, Slice suffix) {
+  std::map<std::string, std::string> heatmap;
+  if (!HandleBlockCacheHeatmapMap(&heatmap, suffix)) {
+    return false;
+  }
+  for (const auto& entry : heatmap) {
+    value->append(entry.first + ": " + entry.second + "\n");
+  }
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheHeatmapMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  assert(values != nullptr);
+  values->clear();
+  const auto* vstorage = cfd_->current()->storage_info();
+  for (int level = 0; level < vstorage->num_levels(); level++) {
+    std::map<std::string, TableReader::CacheHeatEntry> heat;
+    for (const auto& file_meta : vstorage->LevelFiles(level)) {
+      // Only tables with an open reader can have interacted with the block
+      // cache; closed tables are simply skipped.
+      TableReader* const reader = file_meta->fd.table_reader;
+      if (reader != nullptr) {
+        reader->GetBlockCacheHeat(&heat);
+      }
+    }
+    for (const auto& entry : heat) {
+      const std::string prefix =
+          "L" + std::to_string(level) + "." + entry.first + ".";
+      (*values)[prefix + "hit"] = std::to_string(entry.second.hits);
+      (*values)[prefix + "miss"] = std::to_string(entry.second.misses);
+      (*values)[prefix + "insert"] = std::to_string(entry.second.inserts);
+    }
+  }
+  return true;
+}
+
 bool InternalStats::HandleLiveSstFilesSizeAtTemperature(std::string* value,
                                                         Slice suffix) {
   uint64_t temperature;
@@ -1009,6 +1076,15 @@ bool InternalStats::HandleCFStats(std::string* value, Slice /*suffix*/) {
   return true;
 }
 
+bool InternalStats::HandleCFStatistics(std::string* value, Slice /*suffix*/) {
+  Statistics* const stats = cfd_->GetStatistics();
+  if (stats == nullptr) {
+    return false;
+  }
+  value->append(stats->ToString());
+  return true;
+}
+
 bool InternalStats::HandleCFStatsNoFileHistogram(std::string* value,
                                                  Slice /*suffix*/) {
   DumpCFStatsNoFileHistogram(value);
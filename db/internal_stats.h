@@ -56,6 +56,10 @@ struct DBPropertyInfo {
   // handle the string type properties rely on DBImpl methods
   // @param value Value-result argument for storing the property's string value
   bool (DBImpl::*handle_string_dbimpl)(std::string* value);
+
+  // handle the map type properties rely on DBImpl methods
+  // @param stats Map of general properties to populate
+  bool (DBImpl::*handle_map_dbimpl)(std::map<std::string, std::string>* stats);
 };
 
 extern const DBPropertyInfo* GetPropertyInfo(const Slice& property);
@@ -724,6 +728,7 @@ class InternalStats {
   bool HandleCFMapStats(std::map<std::string, std::string>* compaction_stats,
                         Slice suffix);
   bool HandleCFStats(std::string* value, Slice suffix);
+  bool HandleCFStatistics(std::string* value, Slice suffix);
   bool HandleCFStatsNoFileHistogram(std::string* value, Slice suffix);
   bool HandleCFFileHistogram(std::string* value, Slice suffix);
   bool HandleDBMapStats(std::map<std::string, std::string>* compaction_stats,
@@ -790,6 +795,9 @@ class InternalStats {
   bool HandleBlockCacheUsage(uint64_t* value, DBImpl* db, Version* version);
   bool HandleBlockCachePinnedUsage(uint64_t* value, DBImpl* db,
                                    Version* version);
+  bool HandleBlockCacheHeatmap(std::string* value, Slice suffix);
+  bool HandleBlockCacheHeatmapMap(std::map<std::string, std::string>* values,
+                                  Slice suffix);
   bool HandleBlockCacheEntryStats(std::string* value, Slice suffix);
   bool HandleBlockCacheEntryStatsMap(std::map<std::string, std::string>* values,
                                      Slice suffix);
@@ -63,6 +63,9 @@ struct SuperVersionContext {
 
   void PushWriteStallNotification(WriteStallCondition old_cond,
                                   WriteStallCondition new_cond,
+                                  WriteStallCause cause,
+                                  uint64_t delayed_write_rate,
+                                  uint64_t predicted_duration_ms,
                                   const std::string& name,
                                   const ImmutableOptions* ioptions) {
 #if !defined(ROCKSDB_LITE) && !defined(ROCKSDB_DISABLE_STALL_NOTIFICATION)
@@ -70,11 +73,17 @@ struct SuperVersionContext {
     notif.write_stall_info.cf_name = name;
     notif.write_stall_info.condition.prev = old_cond;
     notif.write_stall_info.condition.cur = new_cond;
+    notif.write_stall_info.cause = cause;
+    notif.write_stall_info.delayed_write_rate = delayed_write_rate;
+    notif.write_stall_info.predicted_duration_ms = predicted_duration_ms;
     notif.immutable_options = ioptions;
     write_stall_notifications.push_back(notif);
 #else
     (void)old_cond;
     (void)new_cond;
+    (void)cause;
+    (void)delayed_write_rate;
+    (void)predicted_duration_ms;
     (void)name;
     (void)ioptions;
 #endif  // !defined(ROCKSDB_LITE) && !defined(ROCKSDB_DISABLE_STALL_NOTIFICATION)
@@ -109,7 +118,7 @@ struct JobContext {
   inline bool HaveSomethingToDelete() const {
     return !(full_scan_candidate_files.empty() && sst_delete_files.empty() &&
              blob_delete_files.empty() && log_delete_files.empty() &&
-             manifest_delete_files.empty());
+             manifest_delete_files.empty() && blob_punch_hole_jobs.empty());
   }
 
   inline bool HaveSomethingToClean() const {
@@ -175,6 +184,9 @@ struct JobContext {
   // a list of manifest files that we need to delete
   std::vector<std::string> manifest_delete_files;
 
+  // garbage blob extents that are now safe to punch holes for
+  std::vector<BlobFilePunchHoleJob> blob_punch_hole_jobs;
+
   // a list of memtables to be free
   autovector<MemTable*> memtables_to_free;
 
@@ -35,8 +35,14 @@ enum RecordType {
 
   // Compression Type
   kSetCompressionType = 9,
+
+  // Logical end of a recycled log file. Written by log::Writer when a
+  // recycled log is closed cleanly; everything after it is stale content
+  // from a previous life of the file, so readers stop here instead of
+  // scanning until an old log number turns up.
+  kRecyclableEofType = 10,
 };
-static const int kMaxRecordType = kSetCompressionType;
+static const int kMaxRecordType = kRecyclableEofType;
 
 static const unsigned int kBlockSize = 32768;
 
@@ -195,6 +195,17 @@ bool Reader::ReadRecord(Slice* record, std::string* scratch,
         }
         return false;
 
+      case kRecyclableEofType:
+        // Logical end of a recycled log, written when the log was closed
+        // cleanly. Everything after it is stale content from a previous
+        // life of the file.
+        if (in_fragmented_record) {
+          ReportCorruption(scratch->size(),
+                           "partial record before logical EOF");
+          scratch->clear();
+        }
+        return false;
+
       case kOldRecord:
         if (wal_recovery_mode != WALRecoveryMode::kSkipAnyCorruptedRecords) {
           // Treat a record from a previous instance of the log as EOF.
@@ -448,7 +459,8 @@ unsigned int Reader::ReadPhysicalRecord(Slice* result, size_t* drop_size,
     const unsigned int type = header[6];
     const uint32_t length = a | (b << 8);
     int header_size = kHeaderSize;
-    if (type >= kRecyclableFullType && type <= kRecyclableLastType) {
+    if ((type >= kRecyclableFullType && type <= kRecyclableLastType) ||
+        type == kRecyclableEofType) {
       if (end_of_buffer_offset_ - buffer_.size() == 0) {
         recycled_ = true;
       }
@@ -504,7 +516,8 @@ unsigned int Reader::ReadPhysicalRecord(Slice* result, size_t* drop_size,
 
     buffer_.remove_prefix(header_size + length);
 
-    if (!uncompress_ || type == kSetCompressionType) {
+    if (!uncompress_ || type == kSetCompressionType ||
+        type == kRecyclableEofType) {
       *result = Slice(header + header_size, length);
       return type;
     } else {
@@ -566,6 +579,9 @@ void Reader::InitCompression(const CompressionTypeRecord& compression_record) {
   uncompress_ = StreamingUncompress::Create(
       compression_type_, compression_format_version, kBlockSize);
   assert(uncompress_ != nullptr);
+  if (!compression_dict_.empty()) {
+    uncompress_->LoadDictionary(compression_dict_);
+  }
   uncompressed_buffer_ = std::unique_ptr<char[]>(new char[kBlockSize]);
   assert(uncompressed_buffer_);
 }
@@ -649,6 +665,17 @@ bool FragmentBufferedReader::ReadRecord(Slice* record, std::string* scratch,
         }
         break;
 
+      case kRecyclableEofType:
+        // Logical end of a recycled log; everything after it is stale
+        // content from a previous life of the file.
+        if (in_fragmented_record_) {
+          ReportCorruption(fragments_.size(),
+                           "partial record before logical EOF");
+          in_fragmented_record_ = false;
+          fragments_.clear();
+        }
+        return false;
+
       case kBadRecordChecksum:
         if (recycled_) {
           fragments_.clear();
@@ -773,7 +800,8 @@ bool FragmentBufferedReader::TryReadFragment(
   const unsigned int type = header[6];
   const uint32_t length = a | (b << 8);
   int header_size = kHeaderSize;
-  if (type >= kRecyclableFullType && type <= kRecyclableLastType) {
+  if ((type >= kRecyclableFullType && type <= kRecyclableLastType) ||
+      type == kRecyclableEofType) {
     if (end_of_buffer_offset_ - buffer_.size() == 0) {
       recycled_ = true;
     }
@@ -825,7 +853,8 @@ bool FragmentBufferedReader::TryReadFragment(
 
   buffer_.remove_prefix(header_size + length);
 
-  if (!uncompress_ || type == kSetCompressionType) {
+  if (!uncompress_ || type == kSetCompressionType ||
+      type == kRecyclableEofType) {
     *fragment = Slice(header + header_size, length);
     *fragment_type_or_err = type;
     return true;
@@ -192,6 +192,17 @@ class Reader {
   void ReportDrop(size_t bytes, const Status& reason);
 
   void InitCompression(const CompressionTypeRecord& compression_record);
+
+ public:
+  // Configure the pre-trained dictionary that compressed records were
+  // written with (see DBOptions::wal_compression_dict). Must be called
+  // before the first compressed record is read.
+  void SetCompressionDictionary(const std::string& dict) {
+    compression_dict_ = dict;
+  }
+
+ protected:
+  std::string compression_dict_;
 };
 
 class FragmentBufferedReader : public Reader {
@@ -21,14 +21,16 @@ namespace log {
 
 Writer::Writer(std::unique_ptr<WritableFileWriter>&& dest, uint64_t log_number,
                bool recycle_log_files, bool manual_flush,
-               CompressionType compression_type)
+               CompressionType compression_type,
+               const std::string& compression_dict)
     : dest_(std::move(dest)),
       block_offset_(0),
       log_number_(log_number),
       recycle_log_files_(recycle_log_files),
       manual_flush_(manual_flush),
       compression_type_(compression_type),
-      compress_(nullptr) {
+      compress_(nullptr),
+      compression_dict_(compression_dict) {
   for (int i = 0; i <= kMaxRecordType; i++) {
     char t = static_cast<char>(i);
     type_crc_[i] = crc32c::Value(&t, 1);
@@ -49,12 +51,47 @@ IOStatus Writer::WriteBuffer() { return dest_->Flush(); }
 IOStatus Writer::Close() {
   IOStatus s;
   if (dest_) {
-    s = dest_->Close();
+    if (recycle_log_files_) {
+      // Mark the logical end of the log so that recovery can stop right
+      // here instead of scanning through whatever the previous life of
+      // this file left behind. Best effort: if the marker is lost or torn,
+      // recovery falls back to the old-log-number scan.
+      s = AddEofRecord();
+    }
+    IOStatus close_status = dest_->Close();
+    if (s.ok()) {
+      s = close_status;
+    } else {
+      close_status.PermitUncheckedError();
+    }
     dest_.reset();
   }
   return s;
 }
 
+IOStatus Writer::AddEofRecord() {
+  assert(recycle_log_files_);
+  const int64_t leftover = kBlockSize - block_offset_;
+  assert(leftover >= 0);
+  IOStatus s;
+  if (leftover < kRecyclableHeaderSize) {
+    // Switch to a new block
+    if (leftover > 0) {
+      // Fill the trailer (literal below relies on kRecyclableHeaderSize
+      // being <= 11)
+      assert(kRecyclableHeaderSize <= 11);
+      s = dest_->Append(Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                              static_cast<size_t>(leftover)),
+                        0 /* crc32c_checksum */);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    block_offset_ = 0;
+  }
+  return EmitPhysicalRecord(kRecyclableEofType, "", 0);
+}
+
 IOStatus Writer::AddRecord(const Slice& slice,
                            Env::IOPriority rate_limiter_priority) {
   const char* ptr = slice.data();
@@ -178,6 +215,9 @@ IOStatus Writer::AddCompressionTypeRecord() {
                                           compression_format_version,
                                           max_output_buffer_len);
     assert(compress_ != nullptr);
+    if (!compression_dict_.empty()) {
+      compress_->LoadDictionary(compression_dict_);
+    }
     compressed_buffer_ =
         std::unique_ptr<char[]>(new char[max_output_buffer_len]);
     assert(compressed_buffer_);
@@ -76,7 +76,8 @@ class Writer {
   explicit Writer(std::unique_ptr<WritableFileWriter>&& dest,
                   uint64_t log_number, bool recycle_log_files,
                   bool manual_flush = false,
-                  CompressionType compressionType = kNoCompression);
+                  CompressionType compressionType = kNoCompression,
+                  const std::string& compression_dict = "");
   // No copying allowed
   Writer(const Writer&) = delete;
   void operator=(const Writer&) = delete;
@@ -87,6 +88,11 @@ class Writer {
                      Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
   IOStatus AddCompressionTypeRecord();
 
+  // Writes a kRecyclableEofType record marking the logical end of a
+  // recycled log. Called by Close(); readers stop at the marker instead of
+  // parsing the stale remainder of the recycled file.
+  IOStatus AddEofRecord();
+
   WritableFileWriter* file() { return dest_.get(); }
   const WritableFileWriter* file() const { return dest_.get(); }
 
@@ -120,6 +126,9 @@ class Writer {
   // Compression Type
   CompressionType compression_type_;
   StreamingCompress* compress_;
+  // Optional pre-trained dictionary loaded into compress_; readers must be
+  // configured with the same dictionary.
+  const std::string compression_dict_;
   // Reusable compressed output buffer
   std::unique_ptr<char[]> compressed_buffer_;
 };
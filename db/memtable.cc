@@ -14,6 +14,10 @@
 #include <limits>
 #include <memory>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "db/dbformat.h"
 #include "db/kv_checksum.h"
 #include "db/merge_context.h"
@@ -40,6 +44,7 @@
 #include "table/merging_iterator.h"
 #include "util/autovector.h"
 #include "util/coding.h"
+#include "util/math.h"
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -99,6 +104,8 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
       first_seqno_(0),
       earliest_seqno_(latest_seq),
       creation_seq_(latest_seq),
+      creation_clock_micros_(ioptions.clock ? ioptions.clock->NowMicros()
+                                            : 0),
       mem_next_logfile_number_(0),
       min_prep_log_referenced_(0),
       locks_(moptions_.inplace_update_support
@@ -236,11 +243,76 @@ void MemTable::UpdateOldestKeyTime() {
   }
 }
 
+namespace {
+
+// Compares the user-key portions of two internal keys as raw bytes, then
+// (on equality) their sequence numbers in decreasing order, i.e. the same
+// ordering as InternalKeyComparator::CompareKeySeq with the built-in
+// bytewise comparator. Avoids the virtual Comparator dispatch and compares
+// up to 32 bytes per step; the 8-byte internal-key tag is decoded and
+// compared branchlessly since the branch is unpredictable for hot keys.
+inline int BytewiseCompareKeySeq(const Slice& akey, const Slice& bkey) {
+  assert(akey.size() >= kNumInternalBytes);
+  assert(bkey.size() >= kNumInternalBytes);
+  const char* a = akey.data();
+  const char* b = bkey.data();
+  const size_t a_len = akey.size() - kNumInternalBytes;
+  const size_t b_len = bkey.size() - kNumInternalBytes;
+  const size_t min_len = std::min(a_len, b_len);
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 32 <= min_len; i += 32) {
+    const __m256i va =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    const uint32_t eq = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+    if (eq != 0xffffffffU) {
+      const size_t pos = i + CountTrailingZeroBits(~eq);
+      return static_cast<unsigned char>(a[pos]) <
+                     static_cast<unsigned char>(b[pos])
+                 ? -1
+                 : +1;
+    }
+  }
+#endif  // __AVX2__
+  for (; i + 8 <= min_len; i += 8) {
+    const uint64_t wa = DecodeFixed64(a + i);
+    const uint64_t wb = DecodeFixed64(b + i);
+    if (wa != wb) {
+      // Fixed64 decoding is little-endian, so byte order must be reversed
+      // before an arithmetic comparison yields the memcmp() ordering.
+      return EndianSwapValue(wa) < EndianSwapValue(wb) ? -1 : +1;
+    }
+  }
+  for (; i < min_len; ++i) {
+    if (a[i] != b[i]) {
+      return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i])
+                 ? -1
+                 : +1;
+    }
+  }
+  if (a_len != b_len) {
+    return a_len < b_len ? -1 : +1;
+  }
+  // Equal user keys: order by decreasing sequence number. The low tag byte
+  // (value type) is shifted out to match CompareKeySeq().
+  const uint64_t anum = DecodeFixed64(a + a_len) >> 8;
+  const uint64_t bnum = DecodeFixed64(b + b_len) >> 8;
+  return (anum < bnum) - (anum > bnum);
+}
+
+}  // namespace
+
 int MemTable::KeyComparator::operator()(const char* prefix_len_key1,
                                         const char* prefix_len_key2) const {
   // Internal keys are encoded as length-prefixed strings.
   Slice k1 = GetLengthPrefixedSlice(prefix_len_key1);
   Slice k2 = GetLengthPrefixedSlice(prefix_len_key2);
+  if (bytewise_fast_path) {
+    return BytewiseCompareKeySeq(k1, k2);
+  }
   return comparator.CompareKeySeq(k1, k2);
 }
 
@@ -249,6 +321,9 @@ int MemTable::KeyComparator::operator()(const char* prefix_len_key,
     const {
   // Internal keys are encoded as length-prefixed strings.
   Slice a = GetLengthPrefixedSlice(prefix_len_key);
+  if (bytewise_fast_path) {
+    return BytewiseCompareKeySeq(a, key);
+  }
   return comparator.CompareKeySeq(a, key);
 }
 
@@ -455,6 +530,14 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIterator(
 
 FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIteratorInternal(
     const ReadOptions& read_options, SequenceNumber read_seq) {
+  if (fragmented_range_tombstone_list_ != nullptr) {
+    // The memtable is immutable, so the cached fragmented tombstone list is
+    // complete. The returned iterator does not own the list; the memtable
+    // outlives it because readers hold a super version reference.
+    return new FragmentedRangeTombstoneIterator(
+        fragmented_range_tombstone_list_.get(), comparator_.comparator,
+        read_seq);
+  }
   auto* unfragmented_iter = new MemTableIterator(
       *this, read_options, nullptr /* arena */, true /* use_range_del_table */);
   auto fragmented_tombstone_list =
@@ -467,10 +550,49 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIteratorInternal(
   return fragmented_iter;
 }
 
+void MemTable::ConstructFragmentedRangeTombstones() {
+  assert(fragmented_range_tombstone_list_ == nullptr);
+  if (!is_range_del_table_empty_.load(std::memory_order_relaxed)) {
+    auto* unfragmented_iter =
+        new MemTableIterator(*this, ReadOptions(), nullptr /* arena */,
+                             true /* use_range_del_table */);
+    fragmented_range_tombstone_list_ =
+        std::make_unique<FragmentedRangeTombstoneList>(
+            std::unique_ptr<InternalIterator>(unfragmented_iter),
+            comparator_.comparator);
+  }
+}
+
 port::RWMutex* MemTable::GetLock(const Slice& key) {
   return &locks_[GetSliceRangedNPHash(key, locks_.size())];
 }
 
+void MemTable::UpdateTimestampRange(const Slice& ts) {
+  const Comparator* ucmp = GetInternalKeyComparator().user_comparator();
+  MutexLock l(&timestamp_range_mutex_);
+  if (min_timestamp_.empty() ||
+      ucmp->CompareTimestamp(ts, min_timestamp_) < 0) {
+    min_timestamp_.assign(ts.data(), ts.size());
+  }
+  if (max_timestamp_.empty() ||
+      ucmp->CompareTimestamp(ts, max_timestamp_) > 0) {
+    max_timestamp_.assign(ts.data(), ts.size());
+  }
+}
+
+bool MemTable::MayContainDataVisibleAt(const Slice& read_timestamp) const {
+  const Comparator* ucmp = GetInternalKeyComparator().user_comparator();
+  assert(ucmp->timestamp_size() > 0);
+  MutexLock l(&timestamp_range_mutex_);
+  if (min_timestamp_.empty()) {
+    // Nothing added yet; cannot rule anything out.
+    return true;
+  }
+  // A read at `read_timestamp` only sees entries at or below it, so a
+  // memtable whose oldest entry is newer has nothing visible.
+  return ucmp->CompareTimestamp(read_timestamp, min_timestamp_) >= 0;
+}
+
 MemTable::MemTableStats MemTable::ApproximateStats(const Slice& start_ikey,
                                                    const Slice& end_ikey) {
   uint64_t entry_count = table_->ApproximateNumEntries(start_ikey, end_ikey);
@@ -575,6 +697,9 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
 
   size_t ts_sz = GetInternalKeyComparator().user_comparator()->timestamp_size();
   Slice key_without_ts = StripTimestampFromUserKey(key, ts_sz);
+  if (ts_sz > 0) {
+    UpdateTimestampRange(ExtractTimestampFromUserKey(key, ts_sz));
+  }
 
   if (!allow_concurrent) {
     // Extract prefix for insert with hint.
@@ -891,6 +1016,11 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
     // Avoiding recording stats for speed.
     return false;
   }
+  if (read_opts.timestamp != nullptr &&
+      !MayContainDataVisibleAt(*read_opts.timestamp)) {
+    // Every entry (including tombstones) is newer than the read timestamp.
+    return false;
+  }
   PERF_TIMER_GUARD(get_from_memtable_time);
 
   std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
@@ -1009,14 +1139,15 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       }
     }
     bloom_filter_->MayContain(num_keys, &bloom_keys[0], &may_match[0]);
+    int num_misses = 0;
     for (int i = 0; i < num_keys; ++i) {
       if (!may_match[i]) {
         temp_range.SkipIndex(range_indexes[i]);
-        PERF_COUNTER_ADD(bloom_memtable_miss_count, 1);
-      } else {
-        PERF_COUNTER_ADD(bloom_memtable_hit_count, 1);
+        ++num_misses;
       }
     }
+    PERF_COUNTER_ADD(bloom_memtable_miss_count, num_misses);
+    PERF_COUNTER_ADD(bloom_memtable_hit_count, num_keys - num_misses);
   }
   for (auto iter = temp_range.begin(); iter != temp_range.end(); ++iter) {
     bool found_final_value{false};
@@ -87,7 +87,13 @@ class MemTable {
  public:
   struct KeyComparator : public MemTableRep::KeyComparator {
     const InternalKeyComparator comparator;
-    explicit KeyComparator(const InternalKeyComparator& c) : comparator(c) { }
+    // True iff the user comparator is the built-in forward bytewise
+    // comparator, in which case key comparisons take a vectorized raw-byte
+    // fast path instead of going through the virtual Comparator interface.
+    const bool bytewise_fast_path;
+    explicit KeyComparator(const InternalKeyComparator& c)
+        : comparator(c),
+          bytewise_fast_path(c.user_comparator() == BytewiseComparator()) {}
     virtual int operator()(const char* prefix_len_key1,
                            const char* prefix_len_key2) const override;
     virtual int operator()(const char* prefix_len_key,
@@ -361,6 +367,12 @@ class MemTable {
   // operations on the same MemTable (unless this Memtable is immutable).
   bool IsEmpty() const { return first_seqno_ == 0; }
 
+  // Returns false iff the memtable is known to contain no entries visible
+  // to a read at `read_timestamp`, i.e. every entry added so far carries a
+  // user-defined timestamp newer than `read_timestamp`. Only meaningful
+  // when the user comparator has a nonzero timestamp size.
+  bool MayContainDataVisibleAt(const Slice& read_timestamp) const;
+
   // Returns the sequence number of the first element that was inserted
   // into the memtable.
   // REQUIRES: external synchronization to prevent simultaneous
@@ -403,6 +415,11 @@ class MemTable {
 
   void SetCreationSeq(SequenceNumber sn) { creation_seq_ = sn; }
 
+  // Wall-clock time (in microseconds) when this memtable was created. Used
+  // to estimate per-CF fill rate when the write buffer manager picks a
+  // column family to flush.
+  uint64_t GetCreationClockMicros() const { return creation_clock_micros_; }
+
   // Returns the next active logfile number when this memtable is about to
   // be flushed to storage
   // REQUIRES: external synchronization to prevent simultaneous
@@ -429,6 +446,9 @@ class MemTable {
   // write anything to this MemTable().  (Ie. do not call Add() or Update()).
   void MarkImmutable() {
     table_->MarkReadOnly();
+    // No range tombstone can be added once the memtable is read-only, so
+    // fragment them once here instead of on every iterator creation.
+    ConstructFragmentedRangeTombstones();
     mem_tracker_.DoneAllocating();
   }
 
@@ -470,6 +490,17 @@ class MemTable {
     return &moptions_;
   }
 
+  // Filter over the point keys of this memtable, or nullptr if the memtable
+  // was built without one.
+  const DynamicBloom* GetBloomFilter() const { return bloom_filter_.get(); }
+
+  const SliceTransform* GetPrefixExtractor() const { return prefix_extractor_; }
+
+  // Whether no range tombstone has been added to this memtable.
+  bool IsRangeDelTableEmpty() const {
+    return is_range_del_table_empty_.load(std::memory_order_relaxed);
+  }
+
   uint64_t ApproximateOldestKeyTime() const {
     return oldest_key_time_.load(std::memory_order_relaxed);
   }
@@ -544,6 +575,7 @@ class MemTable {
   std::atomic<SequenceNumber> earliest_seqno_;
 
   SequenceNumber creation_seq_;
+  uint64_t creation_clock_micros_;
 
   // The log files earlier than this number can be deleted.
   uint64_t mem_next_logfile_number_;
@@ -571,6 +603,14 @@ class MemTable {
   // Timestamp of oldest key
   std::atomic<uint64_t> oldest_key_time_;
 
+  // Range of user-defined timestamps added so far, in the comparator's raw
+  // encoding; empty until the first entry is added. Only maintained when
+  // the user comparator has a nonzero timestamp size. Protected by
+  // timestamp_range_mutex_ since Add() may run concurrently.
+  mutable port::Mutex timestamp_range_mutex_;
+  std::string min_timestamp_;
+  std::string max_timestamp_;
+
   // Memtable id to track flush.
   uint64_t id_ = 0;
 
@@ -594,6 +634,10 @@ class MemTable {
 
   void UpdateOldestKeyTime();
 
+  // Folds the user-defined timestamp of a newly added entry into
+  // min_timestamp_/max_timestamp_.
+  void UpdateTimestampRange(const Slice& ts);
+
   void GetFromTable(const LookupKey& key,
                     SequenceNumber max_covering_tombstone_seq, bool do_merge,
                     ReadCallback* callback, bool* is_blob_index,
@@ -604,6 +648,19 @@ class MemTable {
   // Always returns non-null and assumes certain pre-checks are done
   FragmentedRangeTombstoneIterator* NewRangeTombstoneIteratorInternal(
       const ReadOptions& read_options, SequenceNumber read_seq);
+
+  // Fragment the contents of the range tombstone table into
+  // fragmented_range_tombstone_list_ so that NewRangeTombstoneIterator()
+  // can serve iterators from the cached list instead of re-fragmenting.
+  // REQUIRES: external synchronization to prevent simultaneous
+  // operations on the same MemTable; no tombstones may be added afterwards.
+  void ConstructFragmentedRangeTombstones();
+
+  // Cached fragmented range tombstones; built by
+  // ConstructFragmentedRangeTombstones() when the memtable becomes
+  // immutable, nullptr before that.
+  std::unique_ptr<FragmentedRangeTombstoneList>
+      fragmented_range_tombstone_list_;
 };
 
 extern const char* EncodeKey(std::string* scratch, const Slice& target);
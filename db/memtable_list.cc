@@ -17,6 +17,7 @@
 #include "db/version_set.h"
 #include "logging/log_buffer.h"
 #include "logging/logging.h"
+#include "monitoring/perf_context_imp.h"
 #include "monitoring/thread_status_util.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
@@ -61,6 +62,8 @@ MemTableListVersion::MemTableListVersion(
   for (auto& m : memlist_history_) {
     m->Ref();
   }
+
+  RebuildAggregateBloom();
 }
 
 MemTableListVersion::MemTableListVersion(
@@ -110,11 +113,83 @@ bool MemTableListVersion::Get(const LookupKey& key, std::string* value,
                               SequenceNumber* max_covering_tombstone_seq,
                               SequenceNumber* seq, const ReadOptions& read_opts,
                               ReadCallback* callback, bool* is_blob_index) {
+  if (agg_bloom_ != nullptr && !AggregateBloomMayContain(key)) {
+    // No immutable memtable can contain the key, and none of them has range
+    // tombstones (see RebuildAggregateBloom()).
+    PERF_COUNTER_ADD(bloom_memtable_miss_count, 1);
+    *seq = kMaxSequenceNumber;
+    return false;
+  }
   return GetFromList(&memlist_, key, value, timestamp, s, merge_context,
                      max_covering_tombstone_seq, seq, read_opts, callback,
                      is_blob_index);
 }
 
+bool MemTableListVersion::AggregateBloomMayContain(
+    const LookupKey& key) const {
+  assert(agg_bloom_ != nullptr);
+  assert(!memlist_.empty());
+  size_t ts_sz = memlist_.front()
+                     ->GetInternalKeyComparator()
+                     .user_comparator()
+                     ->timestamp_size();
+  Slice user_key_without_ts = StripTimestampFromUserKey(key.user_key(), ts_sz);
+  if (agg_bloom_whole_key_) {
+    return agg_bloom_->MayContain(user_key_without_ts);
+  }
+  assert(agg_bloom_prefix_extractor_ != nullptr);
+  if (!agg_bloom_prefix_extractor_->InDomain(user_key_without_ts)) {
+    // Keys outside the prefix domain have no filter entry in the memtables,
+    // so they cannot be screened.
+    return true;
+  }
+  return agg_bloom_->MayContain(
+      agg_bloom_prefix_extractor_->Transform(user_key_without_ts));
+}
+
+// The merge requires every memtable to carry a bloom filter of the same
+// shape and settings, and to be free of range tombstones: a negative
+// aggregate probe skips the range tombstone lookup in MemTable::Get() along
+// with the point lookup.
+void MemTableListVersion::RebuildAggregateBloom() {
+  agg_bloom_.reset();
+  agg_bloom_arena_.reset();
+  agg_bloom_whole_key_ = false;
+  agg_bloom_prefix_extractor_ = nullptr;
+  if (memlist_.size() < 2) {
+    // Screening a single memtable would just duplicate its own filter probe.
+    return;
+  }
+  const MemTable* first = memlist_.front();
+  const DynamicBloom* first_bloom = first->GetBloomFilter();
+  if (first_bloom == nullptr) {
+    return;
+  }
+  const bool whole_key =
+      first->GetImmutableMemTableOptions()->memtable_whole_key_filtering;
+  const SliceTransform* prefix_extractor = first->GetPrefixExtractor();
+  if (!whole_key && prefix_extractor == nullptr) {
+    return;
+  }
+  for (const MemTable* m : memlist_) {
+    const DynamicBloom* bloom = m->GetBloomFilter();
+    if (bloom == nullptr || !first_bloom->IsCompatible(*bloom) ||
+        !m->IsRangeDelTableEmpty() ||
+        m->GetImmutableMemTableOptions()->memtable_whole_key_filtering !=
+            whole_key ||
+        m->GetPrefixExtractor() != prefix_extractor) {
+      return;
+    }
+  }
+  agg_bloom_arena_.reset(new Arena());
+  agg_bloom_.reset(new DynamicBloom(agg_bloom_arena_.get(), *first_bloom));
+  for (const MemTable* m : memlist_) {
+    agg_bloom_->MergeFrom(*m->GetBloomFilter());
+  }
+  agg_bloom_whole_key_ = whole_key;
+  agg_bloom_prefix_extractor_ = whole_key ? nullptr : prefix_extractor;
+}
+
 void MemTableListVersion::MultiGet(const ReadOptions& read_options,
                                    MultiGetRange* range,
                                    ReadCallback* callback) {
@@ -264,10 +339,24 @@ SequenceNumber MemTableListVersion::GetFirstSequenceNumber() const {
   return min_first_seqno;
 }
 
+void MemTableListVersion::GetMemTablesNewerThan(
+    const MemTable* mem, autovector<MemTable*>* mems) const {
+  // memlist_ is ordered newest first.
+  for (MemTable* m : memlist_) {
+    if (m == mem) {
+      return;
+    }
+    mems->push_back(m);
+  }
+  // `mem` must be in the list; otherwise the appended set is meaningless.
+  assert(false);
+}
+
 // caller is responsible for referencing m
 void MemTableListVersion::Add(MemTable* m, autovector<MemTable*>* to_delete) {
   assert(refs_ == 1);  // only when refs_ == 1 is MemTableListVersion mutable
   AddMemTable(m);
+  RebuildAggregateBloom();
   // m->MemoryAllocatedBytes() is added in MemoryAllocatedBytesExcludingLast
   TrimHistory(to_delete, 0);
 }
@@ -277,6 +366,7 @@ void MemTableListVersion::Remove(MemTable* m,
                                  autovector<MemTable*>* to_delete) {
   assert(refs_ == 1);  // only when refs_ == 1 is MemTableListVersion mutable
   memlist_.remove(m);
+  RebuildAggregateBloom();
 
   m->MarkFlushed();
   if (max_write_buffer_size_to_maintain_ > 0 ||
@@ -15,6 +15,7 @@
 #include "db/logs_with_prep_tracker.h"
 #include "db/memtable.h"
 #include "db/range_del_aggregator.h"
+#include "memory/arena.h"
 #include "file/filename.h"
 #include "logging/log_buffer.h"
 #include "monitoring/instrumented_mutex.h"
@@ -134,6 +135,13 @@ class MemTableListVersion {
   // Return kMaxSequenceNumber if the list is empty.
   SequenceNumber GetFirstSequenceNumber() const;
 
+  // Appends to `mems` the memtables in this list version that were switched
+  // in after `mem` (i.e. are newer than `mem`), newest first. `mem` must be
+  // in the list. Used by iterator Refresh() to find the memtables an
+  // already-built iterator tree does not contain yet.
+  void GetMemTablesNewerThan(const MemTable* mem,
+                             autovector<MemTable*>* mems) const;
+
  private:
   friend class MemTableList;
 
@@ -169,6 +177,14 @@ class MemTableListVersion {
 
   void UnrefMemTable(autovector<MemTable*>* to_delete, MemTable* m);
 
+  // Rebuilds agg_bloom_ from the memtables in memlist_. Called whenever
+  // memlist_ changes.
+  void RebuildAggregateBloom();
+
+  // Returns false iff agg_bloom_ proves that no memtable in memlist_
+  // contains `key`. REQUIRES: agg_bloom_ != nullptr.
+  bool AggregateBloomMayContain(const LookupKey& key) const;
+
   // Calculate the total amount of memory used by memlist_ and memlist_history_
   // excluding the last MemTable in memlist_history_. The reason for excluding
   // the last MemTable is to see if dropping the last MemTable will keep total
@@ -188,6 +204,16 @@ class MemTableListVersion {
   // (used during Transaction validation)
   std::list<MemTable*> memlist_history_;
 
+  // Merged copy of the bloom filters of every memtable in memlist_, or
+  // nullptr when the list has fewer than two memtables or some memtable
+  // cannot be screened (no filter, mismatched filter shape or settings, or
+  // range tombstones; see RebuildAggregateBloom()). When set, a single
+  // negative probe lets Get() skip every immutable memtable.
+  std::unique_ptr<Arena> agg_bloom_arena_;
+  std::unique_ptr<DynamicBloom> agg_bloom_;
+  bool agg_bloom_whole_key_ = false;
+  const SliceTransform* agg_bloom_prefix_extractor_ = nullptr;
+
   // Maximum number of MemTables to keep in memory (including both flushed
   const int max_write_buffer_number_to_maintain_;
   // Maximum size of MemTables to keep in memory (including both flushed
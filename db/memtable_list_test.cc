@@ -343,6 +343,77 @@ TEST_F(MemTableListTest, GetTest) {
   }
 }
 
+TEST_F(MemTableListTest, AggregateBloomTest) {
+  // Create MemTableList
+  int min_write_buffer_number_to_merge = 2;
+  int max_write_buffer_number_to_maintain = 0;
+  int64_t max_write_buffer_size_to_maintain = 0;
+  MemTableList list(min_write_buffer_number_to_merge,
+                    max_write_buffer_number_to_maintain,
+                    max_write_buffer_size_to_maintain);
+
+  SequenceNumber seq = 1;
+  std::string value;
+  Status s;
+  MergeContext merge_context;
+  SequenceNumber max_covering_tombstone_seq = 0;
+  autovector<MemTable*> to_delete;
+
+  // Enable memtable bloom filters so that adding the second memtable
+  // builds the merged filter over the whole list.
+  auto factory = std::make_shared<SkipListFactory>();
+  options.memtable_factory = factory;
+  options.memtable_prefix_bloom_size_ratio = 0.25;
+  options.memtable_whole_key_filtering = true;
+  ImmutableOptions ioptions(options);
+  InternalKeyComparator cmp(BytewiseComparator());
+
+  WriteBufferManager wb(options.db_write_buffer_size);
+  MemTable* mem = new MemTable(cmp, ioptions, MutableCFOptions(options), &wb,
+                               kMaxSequenceNumber, 0 /* column_family_id */);
+  mem->Ref();
+  ASSERT_OK(mem->Add(++seq, kTypeValue, "key1", "value1",
+                     nullptr /* kv_prot_info */));
+  list.Add(mem, &to_delete);
+
+  WriteBufferManager wb2(options.db_write_buffer_size);
+  MemTable* mem2 = new MemTable(cmp, ioptions, MutableCFOptions(options), &wb2,
+                                kMaxSequenceNumber, 0 /* column_family_id */);
+  mem2->Ref();
+  ASSERT_OK(mem2->Add(++seq, kTypeValue, "key2", "value2",
+                      nullptr /* kv_prot_info */));
+  list.Add(mem2, &to_delete);
+
+  ASSERT_EQ(2, list.NumNotFlushed());
+
+  // Keys in either memtable are still found through the merged filter.
+  merge_context.Clear();
+  bool found = list.current()->Get(
+      LookupKey("key1", seq), &value, /*timestamp*/nullptr, &s,
+      &merge_context, &max_covering_tombstone_seq, ReadOptions());
+  ASSERT_TRUE(s.ok() && found);
+  ASSERT_EQ("value1", value);
+
+  merge_context.Clear();
+  found = list.current()->Get(
+      LookupKey("key2", seq), &value, /*timestamp*/nullptr, &s,
+      &merge_context, &max_covering_tombstone_seq, ReadOptions());
+  ASSERT_TRUE(s.ok() && found);
+  ASSERT_EQ("value2", value);
+
+  // A key in neither memtable is screened out.
+  merge_context.Clear();
+  found = list.current()->Get(
+      LookupKey("missing", seq), &value, /*timestamp*/nullptr, &s,
+      &merge_context, &max_covering_tombstone_seq, ReadOptions());
+  ASSERT_FALSE(found);
+
+  list.current()->Unref(&to_delete);
+  for (MemTable* m : to_delete) {
+    delete m;
+  }
+}
+
 TEST_F(MemTableListTest, GetFromHistoryTest) {
   // Create MemTableList
   int min_write_buffer_number_to_merge = 2;
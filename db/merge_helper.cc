@@ -154,6 +154,9 @@ Status MergeHelper::MergeUntil(InternalIterator* iter,
   if (!s.ok()) return s;
 
   bool hit_the_next_user_key = false;
+  // Set once PartialMergeMulti() declines to combine the gathered operands,
+  // so we don't retry on every following operand of the same key.
+  bool partial_merge_declined = false;
   for (; iter->Valid(); iter->Next(), original_key_is_iter = false) {
     if (IsShuttingDown()) {
       s = Status::ShutdownInProgress();
@@ -301,7 +304,7 @@ Status MergeHelper::MergeUntil(InternalIterator* iter,
       if (filter != CompactionFilter::Decision::kRemoveAndSkipUntil &&
           range_del_agg != nullptr &&
           range_del_agg->ShouldDelete(
-              iter->key(), RangeDelPositioningMode::kForwardTraversal)) {
+              ikey, RangeDelPositioningMode::kForwardTraversal)) {
         filter = CompactionFilter::Decision::kRemove;
       }
       if (filter == CompactionFilter::Decision::kKeep ||
@@ -328,6 +331,37 @@ Status MergeHelper::MergeUntil(InternalIterator* iter,
           // to compaction_filter_value_.
           merge_context_.PushOperand(compaction_filter_value_, false);
         }
+        // Bound the memory used by keys with very long runs of merge
+        // operands: once enough have accumulated, collapse them into a
+        // single operand with the user's associative merge function. All
+        // operands gathered by one MergeUntil() call lie in the same
+        // snapshot stripe, so collapsing them here is equivalent to the
+        // partial merge that would otherwise happen after iteration.
+        if (!partial_merge_declined &&
+            merge_context_.GetNumOperands() >= kPartialMergeOperandThreshold) {
+          bool merge_success = false;
+          std::string merge_result;
+          {
+            StopWatchNano timer(clock_, stats_ != nullptr);
+            PERF_TIMER_GUARD(merge_operator_time_nanos);
+            merge_success = user_merge_operator_->PartialMergeMulti(
+                orig_ikey.user_key,
+                std::deque<Slice>(merge_context_.GetOperands().begin(),
+                                  merge_context_.GetOperands().end()),
+                &merge_result, logger_);
+            RecordTick(stats_, MERGE_OPERATION_TOTAL_TIME,
+                       stats_ ? timer.ElapsedNanosSafe() : 0);
+          }
+          if (merge_success) {
+            // Replace the operands with the merge result, keeping only the
+            // most recent key, which also keeps orig_ikey anchored.
+            merge_context_.Clear();
+            merge_context_.PushOperand(merge_result);
+            keys_.erase(keys_.begin(), keys_.end() - 1);
+          } else {
+            partial_merge_declined = true;
+          }
+        }
       } else if (filter == CompactionFilter::Decision::kRemoveAndSkipUntil) {
         // Compaction filter asked us to remove this key altogether
         // (not just this operand), along with some keys following it.
@@ -149,6 +149,11 @@ class MergeHelper {
   }
 
  private:
+  // While gathering merge operands in MergeUntil(), attempt to collapse them
+  // with PartialMergeMulti() once this many have accumulated, so that keys
+  // with very long runs of operands don't buffer the whole run in memory.
+  static const size_t kPartialMergeOperandThreshold = 256;
+
   Env* env_;
   SystemClock* clock_;
   const Comparator* user_comparator_;
@@ -144,6 +144,27 @@ TEST_F(MergeHelperTest, SingleOperand) {
   ASSERT_EQ(1U, merge_helper_->values().size());
 }
 
+// A long run of operands is collapsed with PartialMergeMulti while it is
+// still being gathered, so the whole run is never buffered at once. The
+// result is the same single combined operand as a final partial merge.
+TEST_F(MergeHelperTest, CollapseLongOperandRun) {
+  merge_op_ = MergeOperators::CreateUInt64AddOperator();
+
+  const uint64_t kNumOperands = 600;  // > kPartialMergeOperandThreshold
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < kNumOperands; ++i) {
+    AddKeyVal("a", 1000 - i, kTypeMerge, test::EncodeInt(i));
+    sum += i;
+  }
+
+  ASSERT_TRUE(Run(0, false).IsMergeInProgress());
+  ASSERT_FALSE(iter_->Valid());
+  ASSERT_EQ(test::KeyStr("a", 1000, kTypeMerge), merge_helper_->keys()[0]);
+  ASSERT_EQ(test::EncodeInt(sum), merge_helper_->values()[0]);
+  ASSERT_EQ(1U, merge_helper_->keys().size());
+  ASSERT_EQ(1U, merge_helper_->values().size());
+}
+
 // Merging with a deletion turns the deletion into a value
 TEST_F(MergeHelperTest, MergeDeletion) {
   merge_op_ = MergeOperators::CreateUInt64AddOperator();
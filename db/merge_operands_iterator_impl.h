@@ -0,0 +1,81 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include "db/db_impl/db_impl.h"
+#include "db/merge_context.h"
+#include "db/pinned_iterators_manager.h"
+#include "rocksdb/db.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Implements DB::GetMergeOperandsIterator(): holds the MergeContext
+// collected by a GetImpl() pass together with the block pins and the
+// superversion reference that keep its operand slices alive, and walks the
+// operands in insertion order. Populated by GetImpl() via
+// GetImplOptions::merge_operands_iter.
+class MergeOperandsIteratorImpl : public MergeOperandsIterator {
+ public:
+  MergeOperandsIteratorImpl() = default;
+
+  ~MergeOperandsIteratorImpl() override {
+    if (sv_ != nullptr) {
+      // Release the pins into the superversion's data before dropping the
+      // superversion itself
+      if (pinned_iters_mgr_.PinningEnabled()) {
+        pinned_iters_mgr_.ReleasePinnedData();
+      }
+      db_->ReturnAndCleanupSuperVersion(cfd_, sv_);
+    }
+  }
+
+  void SeekToFirst() override { index_ = 0; }
+
+  bool Valid() const override { return index_ < operands_.size(); }
+
+  void Next() override {
+    assert(Valid());
+    ++index_;
+  }
+
+  Slice operand() const override {
+    assert(Valid());
+    return operands_[index_];
+  }
+
+  // The rest of the interface is used by GetImpl() while collecting.
+
+  PinnedIteratorsManager* pinned_iters_mgr() { return &pinned_iters_mgr_; }
+
+  void SetOperands(MergeContext&& merge_context) {
+    merge_context_ = std::move(merge_context);
+    operands_ = merge_context_.GetOperands();
+    index_ = 0;
+  }
+
+  // Take over the caller's superversion reference; it is released when the
+  // iterator is destroyed.
+  void TakeSuperVersion(DBImpl* db, ColumnFamilyData* cfd, SuperVersion* sv) {
+    assert(sv_ == nullptr);
+    db_ = db;
+    cfd_ = cfd;
+    sv_ = sv;
+  }
+
+ private:
+  DBImpl* db_ = nullptr;
+  ColumnFamilyData* cfd_ = nullptr;
+  SuperVersion* sv_ = nullptr;
+  PinnedIteratorsManager pinned_iters_mgr_;
+  MergeContext merge_context_;
+  std::vector<Slice> operands_;
+  size_t index_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -651,6 +651,46 @@ TEST_F(PerfContextTest, ToString) {
   ASSERT_NE(std::string::npos, zero_excluded.find("= 12345"));
 }
 
+TEST_F(PerfContextTest, RequestPerfContext) {
+  ASSERT_OK(DestroyDB(kDbName, Options()));
+  auto db = OpenDb();
+  WriteOptions write_options;
+  ReadOptions read_options;
+
+  // Run the thread at kDisable; only tagged requests should be measured.
+  SetPerfLevel(kDisable);
+  get_perf_context()->Reset();
+  get_iostats_context()->Reset();
+
+  RequestPerfContext write_ctx;
+  write_options.request_perf_context = &write_ctx;
+  ASSERT_OK(db->Put(write_options, "foo", "bar"));
+  ASSERT_GT(write_ctx.perf_context.write_wal_time, 0u);
+  ASSERT_GT(write_ctx.perf_context.write_memtable_time, 0u);
+
+  // An untagged write is not measured.
+  write_options.request_perf_context = nullptr;
+  ASSERT_OK(db->Put(write_options, "foo2", "bar2"));
+
+  RequestPerfContext get_ctx;
+  read_options.request_perf_context = &get_ctx;
+  std::string value;
+  ASSERT_OK(db->Get(read_options, "foo", &value));
+  ASSERT_EQ(value, "bar");
+  ASSERT_GT(get_ctx.perf_context.get_from_memtable_count, 0u);
+  ASSERT_GT(get_ctx.perf_context.get_from_memtable_time, 0u);
+
+  read_options.request_perf_context = nullptr;
+  ASSERT_OK(db->Get(read_options, "foo2", &value));
+
+  // The thread-local contexts were restored around the tagged requests
+  // and the untagged requests ran at kDisable, so nothing accumulated.
+  ASSERT_EQ(get_perf_context()->get_from_memtable_count, 0u);
+  ASSERT_EQ(get_perf_context()->write_wal_time, 0u);
+  ASSERT_EQ(GetPerfLevel(), kDisable);
+  SetPerfLevel(kEnableCount);
+}
+
 TEST_F(PerfContextTest, MergeOperatorTime) {
   DestroyDB(kDbName, Options());
   DB* db;
@@ -15,6 +15,7 @@ const std::string PeriodicWorkTaskNames::kDumpStats = "dump_st";
 const std::string PeriodicWorkTaskNames::kPersistStats = "pst_st";
 const std::string PeriodicWorkTaskNames::kFlushInfoLog = "flush_info_log";
 const std::string PeriodicWorkTaskNames::kRecordSeqnoTime = "record_seq_time";
+const std::string PeriodicWorkTaskNames::kAdaptivePinning = "adaptive_pin";
 
 PeriodicWorkScheduler::PeriodicWorkScheduler(
     const std::shared_ptr<SystemClock>& clock) {
@@ -58,6 +59,16 @@ Status PeriodicWorkScheduler::Register(DBImpl* dbi,
   if (!succeeded) {
     return Status::Aborted("Unable to add periodic task FlushInfoLog");
   }
+  succeeded = timer->Add(
+      [dbi]() { dbi->MaintainAdaptiveMetadataPinning(); },
+      GetTaskName(dbi, PeriodicWorkTaskNames::kAdaptivePinning),
+      initial_delay.fetch_add(1) % kDefaultAdaptivePinningPeriodSec *
+          kMicrosInSecond,
+      kDefaultAdaptivePinningPeriodSec * kMicrosInSecond);
+  if (!succeeded) {
+    return Status::Aborted(
+        "Unable to add periodic task MaintainAdaptiveMetadataPinning");
+  }
   return Status::OK();
 }
 
@@ -91,6 +102,7 @@ void PeriodicWorkScheduler::Unregister(DBImpl* dbi) {
   timer->Cancel(GetTaskName(dbi, PeriodicWorkTaskNames::kDumpStats));
   timer->Cancel(GetTaskName(dbi, PeriodicWorkTaskNames::kPersistStats));
   timer->Cancel(GetTaskName(dbi, PeriodicWorkTaskNames::kFlushInfoLog));
+  timer->Cancel(GetTaskName(dbi, PeriodicWorkTaskNames::kAdaptivePinning));
   if (!timer->HasPendingTask()) {
     timer->Shutdown();
   }
@@ -43,6 +43,11 @@ class PeriodicWorkScheduler {
   // log.
   static const uint64_t kDefaultFlushInfoLogPeriodSec = 10;
 
+  // Cadence of the adaptive metadata pinning maintenance; see
+  // MetadataCacheOptions::adaptive_pinning_min_accesses. The task is cheap
+  // for DBs that don't enable the feature.
+  static const uint64_t kDefaultAdaptivePinningPeriodSec = 10;
+
  protected:
   std::unique_ptr<Timer> timer;
   // `timer_mu_` serves two purposes currently:
@@ -83,6 +88,7 @@ struct PeriodicWorkTaskNames {
   static const std::string kPersistStats;
   static const std::string kFlushInfoLog;
   static const std::string kRecordSeqnoTime;
+  static const std::string kAdaptivePinning;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
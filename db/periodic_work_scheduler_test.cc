@@ -72,7 +72,7 @@ TEST_F(PeriodicWorkSchedulerTest, Basic) {
 
   auto scheduler = dbfull()->TEST_GetPeriodicWorkScheduler();
   ASSERT_NE(nullptr, scheduler);
-  ASSERT_EQ(3, scheduler->TEST_GetValidTaskNum());
+  ASSERT_EQ(4, scheduler->TEST_GetValidTaskNum());
 
   ASSERT_EQ(1, dump_st_counter);
   ASSERT_EQ(1, pst_st_counter);
@@ -106,7 +106,7 @@ TEST_F(PeriodicWorkSchedulerTest, Basic) {
   ASSERT_EQ(4, flush_info_log_counter);
 
   scheduler = dbfull()->TEST_GetPeriodicWorkScheduler();
-  ASSERT_EQ(1u, scheduler->TEST_GetValidTaskNum());
+  ASSERT_EQ(2u, scheduler->TEST_GetValidTaskNum());
 
   // Re-enable one task
   ASSERT_OK(dbfull()->SetDBOptions({{"stats_dump_period_sec", "5"}}));
@@ -115,7 +115,7 @@ TEST_F(PeriodicWorkSchedulerTest, Basic) {
 
   scheduler = dbfull()->TEST_GetPeriodicWorkScheduler();
   ASSERT_NE(nullptr, scheduler);
-  ASSERT_EQ(2, scheduler->TEST_GetValidTaskNum());
+  ASSERT_EQ(3, scheduler->TEST_GetValidTaskNum());
 
   dbfull()->TEST_WaitForPeridicWorkerRun(
       [&] { mock_clock_->MockSleepForSeconds(static_cast<int>(kPeriodSec)); });
@@ -154,7 +154,7 @@ TEST_F(PeriodicWorkSchedulerTest, MultiInstances) {
 
   auto dbi = static_cast_with_check<DBImpl>(dbs[kInstanceNum - 1]);
   auto scheduler = dbi->TEST_GetPeriodicWorkScheduler();
-  ASSERT_EQ(kInstanceNum * 3, scheduler->TEST_GetValidTaskNum());
+  ASSERT_EQ(kInstanceNum * 4, scheduler->TEST_GetValidTaskNum());
 
   int expected_run = kInstanceNum;
   dbi->TEST_WaitForPeridicWorkerRun(
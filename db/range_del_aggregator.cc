@@ -363,15 +363,25 @@ void CompactionRangeDelAggregator::AddTombstones(
     assert(it != reps_.end());
     it->second.AddTombstones(std::move(split_iter.second));
   }
+  // New stripes may have been inserted; the cached lookup could now resolve
+  // to a different stripe.
+  cached_rep_ = nullptr;
 }
 
 bool CompactionRangeDelAggregator::ShouldDelete(const ParsedInternalKey& parsed,
                                                 RangeDelPositioningMode mode) {
+  if (cached_rep_ != nullptr && parsed.sequence >= cached_lower_ &&
+      parsed.sequence <= cached_upper_) {
+    return cached_rep_->ShouldDelete(parsed, mode);
+  }
   auto it = reps_.lower_bound(parsed.sequence);
   if (it == reps_.end()) {
     return false;
   }
-  return it->second.ShouldDelete(parsed, mode);
+  cached_rep_ = &it->second;
+  cached_upper_ = it->first;
+  cached_lower_ = it == reps_.begin() ? 0 : std::prev(it)->first + 1;
+  return cached_rep_->ShouldDelete(parsed, mode);
 }
 
 namespace {
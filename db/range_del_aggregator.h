@@ -440,6 +440,16 @@ class CompactionRangeDelAggregator : public RangeDelAggregator {
   std::vector<std::unique_ptr<TruncatedRangeDelIterator>> parent_iters_;
   std::map<SequenceNumber, StripeRep> reps_;
 
+  // Memoized result of the last reps_ lookup: cached_rep_ is the stripe
+  // covering sequence numbers in [cached_lower_, cached_upper_], or nullptr
+  // if no lookup has been cached. Compactions call ShouldDelete() with long
+  // runs of keys from the same snapshot stripe (e.g. all merge operands of
+  // one user key), so remembering the last stripe avoids a map lookup per
+  // key. Invalidated by AddTombstones().
+  StripeRep* cached_rep_ = nullptr;
+  SequenceNumber cached_lower_ = 0;
+  SequenceNumber cached_upper_ = 0;
+
   const std::vector<SequenceNumber>* snapshots_;
 };
 
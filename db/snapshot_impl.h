@@ -34,6 +34,12 @@ class SnapshotImpl : public Snapshot {
 
   uint64_t GetTimestamp() const override { return timestamp_; }
 
+  // Whether the snapshot's lease has expired as of `now` (unix time in
+  // seconds). Snapshots without a lease never expire.
+  bool HasExpired(int64_t now) const {
+    return expiry_unix_time_ > 0 && now >= expiry_unix_time_;
+  }
+
  private:
   friend class SnapshotList;
 
@@ -45,6 +51,11 @@ class SnapshotImpl : public Snapshot {
 
   int64_t unix_time_;
 
+  // Unix time (in seconds) after which the snapshot's lease has expired and
+  // flushes/compactions no longer keep data visible to it alive. Zero means
+  // the snapshot has no lease and never expires.
+  int64_t expiry_unix_time_;
+
   uint64_t timestamp_;
 
   // Will this snapshot be used by a Transaction to do write-conflict checking?
@@ -60,6 +71,7 @@ class SnapshotList {
     // Set all the variables to make UBSAN happy.
     list_.list_ = nullptr;
     list_.unix_time_ = 0;
+    list_.expiry_unix_time_ = 0;
     list_.timestamp_ = 0;
     list_.is_write_conflict_boundary_ = false;
     count_ = 0;
@@ -77,9 +89,11 @@ class SnapshotList {
 
   SnapshotImpl* New(SnapshotImpl* s, SequenceNumber seq, uint64_t unix_time,
                     bool is_write_conflict_boundary,
-                    uint64_t ts = std::numeric_limits<uint64_t>::max()) {
+                    uint64_t ts = std::numeric_limits<uint64_t>::max(),
+                    int64_t expiry_unix_time = 0) {
     s->number_ = seq;
     s->unix_time_ = unix_time;
+    s->expiry_unix_time_ = expiry_unix_time;
     s->timestamp_ = ts;
     s->is_write_conflict_boundary_ = is_write_conflict_boundary;
     s->list_ = this;
@@ -101,17 +115,21 @@ class SnapshotList {
 
   // retrieve all snapshot numbers up until max_seq. They are sorted in
   // ascending order (with no duplicates).
+  // If `now` (unix time in seconds) is non-zero, leased snapshots whose
+  // lease has expired as of `now` are left out.
   std::vector<SequenceNumber> GetAll(
       SequenceNumber* oldest_write_conflict_snapshot = nullptr,
-      const SequenceNumber& max_seq = kMaxSequenceNumber) const {
+      const SequenceNumber& max_seq = kMaxSequenceNumber,
+      int64_t now = 0) const {
     std::vector<SequenceNumber> ret;
-    GetAll(&ret, oldest_write_conflict_snapshot, max_seq);
+    GetAll(&ret, oldest_write_conflict_snapshot, max_seq, now);
     return ret;
   }
 
   void GetAll(std::vector<SequenceNumber>* snap_vector,
               SequenceNumber* oldest_write_conflict_snapshot = nullptr,
-              const SequenceNumber& max_seq = kMaxSequenceNumber) const {
+              const SequenceNumber& max_seq = kMaxSequenceNumber,
+              int64_t now = 0) const {
     std::vector<SequenceNumber>& ret = *snap_vector;
     // So far we have no use case that would pass a non-empty vector
     assert(ret.size() == 0);
@@ -128,6 +146,11 @@ class SnapshotList {
       if (s->next_->number_ > max_seq) {
         break;
       }
+      // Expired leased snapshots no longer keep obsolete data alive.
+      if (now > 0 && s->next_->HasExpired(now)) {
+        s = s->next_;
+        continue;
+      }
       // Avoid duplicates
       if (ret.empty() || ret.back() != s->next_->number_) {
         ret.push_back(s->next_->number_);
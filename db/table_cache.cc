@@ -162,7 +162,8 @@ Status TableCache::GetTableReader(
             ioptions_, prefix_extractor, file_options, internal_comparator,
             skip_filters, immortal_tables_, false /* force_direct_prefetch */,
             level, fd.largest_seqno, block_cache_tracer_,
-            max_file_size_for_l0_meta_pin, db_session_id_, fd.GetNumber()),
+            max_file_size_for_l0_meta_pin, db_session_id_, fd.GetNumber(),
+            fd.tail_size),
         std::move(file_reader), fd.GetFileSize(), table_reader,
         prefetch_index_and_filter_in_cache);
     TEST_SYNC_POINT("TableCache::GetTableReader:0");
@@ -227,6 +228,67 @@ Status TableCache::FindTable(
   return Status::OK();
 }
 
+bool TableCache::EvaluateTableFilter(const ReadOptions& options,
+                                     const FileDescriptor& fd, bool* keep) {
+  if (!options.table_filter) {
+    return false;
+  }
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (t == nullptr) {
+    uint64_t number = fd.GetNumber();
+    Slice key = GetSliceForFileNumber(&number);
+    handle = cache_->Lookup(key);
+    if (handle == nullptr) {
+      return false;
+    }
+    t = GetTableReaderFromHandle(handle);
+  }
+  *keep = options.table_filter(*t->GetTableProperties());
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+  return true;
+}
+
+bool TableCache::PruneForReadTimestamp(const FileDescriptor& fd,
+                                       const Comparator* ucmp,
+                                       const Slice& read_timestamp) {
+  assert(ucmp != nullptr && ucmp->timestamp_size() > 0);
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (t == nullptr) {
+    uint64_t number = fd.GetNumber();
+    Slice key = GetSliceForFileNumber(&number);
+    handle = cache_->Lookup(key);
+    if (handle == nullptr) {
+      return false;
+    }
+    t = GetTableReaderFromHandle(handle);
+  }
+  bool prune = false;
+  std::shared_ptr<const TableProperties> props = t->GetTableProperties();
+  if (props != nullptr) {
+    // Persisted by TimestampTablePropertiesCollector for every table built
+    // with user-defined timestamps enabled.
+    const auto& uprops = props->user_collected_properties;
+    auto it = uprops.find("rocksdb.timestamp_min");
+    if (it != uprops.end() && it->second.size() == ucmp->timestamp_size()) {
+      // A read at `read_timestamp` only sees entries at or below it, so a
+      // file whose oldest timestamp is newer cannot contribute anything,
+      // not even tombstones.
+      prune = ucmp->CompareTimestamp(read_timestamp, it->second) < 0;
+    }
+  }
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+  if (prune) {
+    TEST_SYNC_POINT("TableCache::PruneForReadTimestamp:Pruned");
+  }
+  return prune;
+}
+
 InternalIterator* TableCache::NewIterator(
     const ReadOptions& options, const FileOptions& file_options,
     const InternalKeyComparator& icomparator, const FileMetaData& file_meta,
@@ -236,7 +298,8 @@ InternalIterator* TableCache::NewIterator(
     TableReaderCaller caller, Arena* arena, bool skip_filters, int level,
     size_t max_file_size_for_l0_meta_pin,
     const InternalKey* smallest_compaction_key,
-    const InternalKey* largest_compaction_key, bool allow_unprepared_value) {
+    const InternalKey* largest_compaction_key, bool allow_unprepared_value,
+    bool skip_table_filter) {
   PERF_TIMER_GUARD(new_table_iterator_nanos);
 
   Status s;
@@ -260,9 +323,11 @@ InternalIterator* TableCache::NewIterator(
     }
   }
   InternalIterator* result = nullptr;
+  bool table_filter_rejected = false;
   if (s.ok()) {
-    if (options.table_filter &&
+    if (!skip_table_filter && options.table_filter &&
         !options.table_filter(*table_reader->GetTableProperties())) {
+      table_filter_rejected = true;
       result = NewEmptyInternalIterator<Slice>(arena);
     } else {
       result = table_reader->NewIterator(
@@ -281,7 +346,10 @@ InternalIterator* TableCache::NewIterator(
       *table_reader_ptr = table_reader;
     }
   }
-  if (s.ok() && range_del_agg != nullptr && !options.ignore_range_deletions) {
+  // A table rejected by the table filter contributes nothing to the scan,
+  // including its range tombstones.
+  if (s.ok() && !table_filter_rejected && range_del_agg != nullptr &&
+      !options.ignore_range_deletions) {
     if (range_del_agg->AddFile(fd.GetNumber())) {
       std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
           static_cast<FragmentedRangeTombstoneIterator*>(
@@ -548,6 +616,28 @@ Status TableCache::ApproximateKeyAnchors(
   return s;
 }
 
+Status TableCache::ApproximateCachedKeyRanges(
+    const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+    const FileDescriptor& fd,
+    std::vector<TableReader::CachedKeyRange>& ranges) {
+  Status s;
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (t == nullptr) {
+    s = FindTable(ro, file_options_, internal_comparator, fd, &handle);
+    if (s.ok()) {
+      t = GetTableReaderFromHandle(handle);
+    }
+  }
+  if (s.ok() && t != nullptr) {
+    s = t->ApproximateCachedKeyRanges(ro, ranges);
+  }
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+  return s;
+}
+
 size_t TableCache::GetMemoryUsageByTableReader(
     const FileOptions& file_options,
     const InternalKeyComparator& internal_comparator, const FileDescriptor& fd,
@@ -47,6 +47,16 @@ class HistogramImpl;
 // DB is configured with a row cache, and the lookup key is present in the row
 // cache, lookup is very fast. The row cache is obtained from
 // ioptions.row_cache
+//
+// Note on locking: every FindTable() call goes through the sharded cache's
+// mutex, so the hot read path is designed to avoid it. When the cache has
+// infinite capacity (max_open_files = -1), VersionBuilder::LoadTableHandlers
+// pins the handle in FileMetaData::table_reader_handle and resolves the
+// reader into FileDescriptor::table_reader when a version is built; Get(),
+// MultiGet() and NewIterator() consult that pointer first and skip the cache
+// entirely in steady state. With a bounded cache, handles are pinned the
+// same way only while the cache is under a quarter full, after which reads
+// fall back to per-call lookups so that LRU eviction stays meaningful.
 class TableCache {
  public:
   TableCache(const ImmutableOptions& ioptions,
@@ -70,6 +80,9 @@ class TableCache {
   //                       not cached), depending on the CF options
   // @param skip_filters Disables loading/accessing the filter block
   // @param level The level this table is at, -1 for "not set / don't know"
+  // @param skip_table_filter If true, options.table_filter has already been
+  //                          evaluated by the caller (see
+  //                          EvaluateTableFilter) and is not consulted again
   InternalIterator* NewIterator(
       const ReadOptions& options, const FileOptions& toptions,
       const InternalKeyComparator& internal_comparator,
@@ -79,7 +92,27 @@ class TableCache {
       TableReaderCaller caller, Arena* arena, bool skip_filters, int level,
       size_t max_file_size_for_l0_meta_pin,
       const InternalKey* smallest_compaction_key,
-      const InternalKey* largest_compaction_key, bool allow_unprepared_value);
+      const InternalKey* largest_compaction_key, bool allow_unprepared_value,
+      bool skip_table_filter = false);
+
+  // Evaluate options.table_filter against the properties of the table
+  // referenced by `fd` if that table is already resident in the cache.
+  // Returns true if the filter could be consulted without any I/O, storing
+  // its verdict in `*keep`. Returns false when no filter is set or the table
+  // has not been opened yet; in the latter case the filter is applied inside
+  // NewIterator once the table is open. This lets iterator builders prune
+  // filtered-out files without touching them.
+  bool EvaluateTableFilter(const ReadOptions& options, const FileDescriptor& fd,
+                           bool* keep);
+
+  // Returns true if the table referenced by `fd` is known to contain no
+  // entries visible to a read at `read_timestamp`, i.e. its persisted
+  // minimum user-defined timestamp is newer than `read_timestamp`.
+  // Best effort and I/O free: returns false when the table has not been
+  // opened yet or was built without timestamp range properties, in which
+  // case the file must be examined normally.
+  bool PruneForReadTimestamp(const FileDescriptor& fd, const Comparator* ucmp,
+                             const Slice& read_timestamp);
 
   // If a seek to internal key "k" in specified file finds an entry,
   // call get_context->SaveValue() repeatedly until
@@ -170,6 +203,13 @@ class TableCache {
                                const FileDescriptor& file_meta,
                                std::vector<TableReader::Anchor>& anchors);
 
+  // Append the user-key ranges of the file whose data blocks are currently
+  // resident in the block cache.
+  Status ApproximateCachedKeyRanges(
+      const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+      const FileDescriptor& file_meta,
+      std::vector<TableReader::CachedKeyRange>& ranges);
+
   // Return total memory usage of the table reader of the file.
   // 0 if table reader of the file is not loaded.
   size_t GetMemoryUsageByTableReader(
@@ -292,6 +292,8 @@ Status TransactionLogIteratorImpl::OpenLogReader(const LogFile* log_file) {
   current_log_reader_.reset(
       new log::Reader(options_->info_log, std::move(file), &reporter_,
                       read_options_.verify_checksums_, log_file->LogNumber()));
+  current_log_reader_->SetCompressionDictionary(
+      options_->wal_compression_dict);
   return Status::OK();
 }
 }  // namespace ROCKSDB_NAMESPACE
@@ -220,6 +220,12 @@ bool VersionEdit::EncodeTo(std::string* dst) const {
       PutVarint64(&oldest_blob_file_number, f.oldest_blob_file_number);
       PutLengthPrefixedSlice(dst, Slice(oldest_blob_file_number));
     }
+    if (f.fd.tail_size != 0) {
+      PutVarint32(dst, NewFileCustomTag::kTailSize);
+      std::string varint_tail_size;
+      PutVarint64(&varint_tail_size, f.fd.tail_size);
+      PutLengthPrefixedSlice(dst, Slice(varint_tail_size));
+    }
     UniqueId64x2 unique_id = f.unique_id;
     TEST_SYNC_POINT_CALLBACK("VersionEdit::EncodeTo:UniqueId", &unique_id);
     if (unique_id != kNullUniqueId64x2) {
@@ -316,6 +322,7 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
   uint64_t file_size = 0;
   SequenceNumber smallest_seqno = 0;
   SequenceNumber largest_seqno = kMaxSequenceNumber;
+  uint64_t tail_size = 0;
   if (GetLevel(input, &level, &msg) && GetVarint64(input, &number) &&
       GetVarint64(input, &file_size) && GetInternalKey(input, &f.smallest) &&
       GetInternalKey(input, &f.largest) &&
@@ -395,6 +402,11 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
             return "invalid unique id";
           }
           break;
+        case kTailSize:
+          if (!GetVarint64(&field, &tail_size)) {
+            return "invalid tail size";
+          }
+          break;
         default:
           if ((custom_tag & kCustomTagNonSafeIgnoreMask) != 0) {
             // Should not proceed if cannot understand it
@@ -408,6 +420,7 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
   }
   f.fd =
       FileDescriptor(number, path_id, file_size, smallest_seqno, largest_seqno);
+  f.fd.tail_size = tail_size;
   new_files_.push_back(std::make_pair(level, f));
   return nullptr;
 }
@@ -821,6 +834,10 @@ std::string VersionEdit::DebugString(bool hex_key) const {
       // permanent
       r.append(std::to_string(static_cast<int>(f.temperature)));
     }
+    if (f.fd.tail_size != 0) {
+      r.append(" tail_size: ");
+      AppendNumberTo(&r, f.fd.tail_size);
+    }
     if (f.unique_id != kNullUniqueId64x2) {
       r.append(" unique_id(internal): ");
       UniqueId64x2 id = f.unique_id;
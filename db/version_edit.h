@@ -87,6 +87,7 @@ enum NewFileCustomTag : uint32_t {
   kMinTimestamp = 10,
   kMaxTimestamp = 11,
   kUniqueId = 12,
+  kTailSize = 13,
 
   // If this bit for the custom tag is set, opening DB should fail if
   // we don't know this field.
@@ -118,6 +119,13 @@ struct FileDescriptor {
   uint64_t file_size;  // File size in bytes
   SequenceNumber smallest_seqno;  // The smallest seqno in this file
   SequenceNumber largest_seqno;   // The largest seqno in this file
+  // Size in bytes of the "tail" of the file: everything from the start of
+  // the meta blocks (index, filter, properties, ...) to the end of the
+  // footer. Recorded at file creation time and persisted in the MANIFEST so
+  // that a cold table open can prefetch exactly the tail with a single read.
+  // 0 if unknown (e.g. files written by older versions), in which case table
+  // open falls back to its prefetch heuristics.
+  uint64_t tail_size = 0;
 
   FileDescriptor() : FileDescriptor(0, 0, 0) {}
 
@@ -140,6 +148,7 @@ struct FileDescriptor {
     file_size = fd.file_size;
     smallest_seqno = fd.smallest_seqno;
     largest_seqno = fd.largest_seqno;
+    tail_size = fd.tail_size;
     return *this;
   }
 
@@ -185,6 +194,8 @@ struct FileMetaData {
   // single-threaded LogAndApply thread
   uint64_t num_entries = 0;     // the number of entries.
   uint64_t num_deletions = 0;   // the number of deletion entries.
+  // the number of DeleteRange entries, a subset of num_deletions.
+  uint64_t num_range_deletions = 0;
   uint64_t raw_key_size = 0;    // total uncompressed key size.
   uint64_t raw_value_size = 0;  // total uncompressed value size.
 
@@ -198,6 +209,14 @@ struct FileMetaData {
                                        // compact this file.
   Temperature temperature = Temperature::kUnknown;
 
+  // Read-aging state maintained by
+  // VersionStorageInfo::ComputeFilesMarkedForTemperatureChange() under the
+  // DB mutex: the last observed stats.num_reads_sampled value and the time
+  // the observation last changed (0 until the file is first observed).
+  // Not persisted, so aging restarts when the DB is reopened.
+  uint64_t last_observed_num_reads = 0;
+  uint64_t last_read_observed_time = 0;
+
   // Used only in BlobDB. The file number of the oldest blob file this SST file
   // refers to. 0 is an invalid value; BlobDB numbers the files starting from 1.
   uint64_t oldest_blob_file_number = kInvalidBlobFileNumber;
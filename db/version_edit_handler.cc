@@ -9,6 +9,7 @@
 
 #include "db/version_edit_handler.h"
 
+#include <atomic>
 #include <cinttypes>
 #include <sstream>
 
@@ -16,6 +17,7 @@
 #include "db/blob/blob_source.h"
 #include "logging/logging.h"
 #include "monitoring/persistent_stats_history.h"
+#include "port/port.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -163,7 +165,9 @@ VersionEditHandler::VersionEditHandler(
       no_error_if_files_missing_(no_error_if_files_missing),
       io_tracer_(io_tracer),
       skip_load_table_files_(skip_load_table_files),
-      initialized_(false) {
+      initialized_(false),
+      defer_builder_apply_(
+          version_set->db_options_->max_manifest_recovery_threads > 1) {
   assert(version_set_ != nullptr);
 }
 
@@ -307,7 +311,14 @@ Status VersionEditHandler::OnNonCfOperation(VersionEdit& edit,
       assert(tmp_cfd != nullptr);
       s = MaybeCreateVersion(edit, tmp_cfd, /*force_create_version=*/false);
       if (s.ok()) {
-        s = builder_iter->second->version_builder()->Apply(&edit);
+        if (defer_builder_apply_) {
+          // Builder state is not needed until CheckIterationResult(), so the
+          // edit can be buffered and applied in parallel with the other
+          // column families once the whole MANIFEST has been read.
+          cf_pending_edits_[edit.column_family_].emplace_back(edit);
+        } else {
+          s = builder_iter->second->version_builder()->Apply(&edit);
+        }
       }
     }
     *cfd = tmp_cfd;
@@ -391,6 +402,9 @@ void VersionEditHandler::CheckIterationResult(const log::Reader& reader,
     msg = msg.substr(2);
     *s = Status::InvalidArgument("Column families not opened: " + msg);
   }
+  if (s->ok() && !cf_pending_edits_.empty()) {
+    *s = ApplyPendingEdits();
+  }
   if (s->ok()) {
     version_set_->GetColumnFamilySet()->UpdateMaxColumnFamily(
         version_edit_params_.max_column_family_);
@@ -497,6 +511,7 @@ ColumnFamilyData* VersionEditHandler::DestroyCfAndCleanup(
   auto builder_iter = builders_.find(edit.column_family_);
   assert(builder_iter != builders_.end());
   builders_.erase(builder_iter);
+  cf_pending_edits_.erase(edit.column_family_);
   if (track_missing_files_) {
     auto missing_files_iter = cf_to_missing_files_.find(edit.column_family_);
     assert(missing_files_iter != cf_to_missing_files_.end());
@@ -553,6 +568,11 @@ Status VersionEditHandler::LoadTables(ColumnFamilyData* cfd,
   if (skip_load_table_files) {
     return Status::OK();
   }
+  if (is_initial_load && version_set_->db_options_->lazy_open_table_files) {
+    // Table readers are created on first access instead; DBImpl schedules a
+    // background warmer after recovery. See lazy_open_table_files.
+    return Status::OK();
+  }
   assert(cfd != nullptr);
   assert(!cfd->IsDropped());
   auto builder_iter = builders_.find(cfd->GetID());
@@ -575,6 +595,62 @@ Status VersionEditHandler::LoadTables(ColumnFamilyData* cfd,
   return s;
 }
 
+Status VersionEditHandler::ApplyPendingEdits() {
+  assert(defer_builder_apply_);
+  // Dropped column families had their buffered edits erased in
+  // DestroyCfAndCleanup(), so everything left belongs to a live builder.
+  struct CfWork {
+    VersionBuilder* builder;
+    std::vector<VersionEdit>* edits;
+  };
+  std::vector<CfWork> work;
+  work.reserve(cf_pending_edits_.size());
+  for (auto& elem : cf_pending_edits_) {
+    auto builder_iter = builders_.find(elem.first);
+    assert(builder_iter != builders_.end());
+    work.push_back(
+        {builder_iter->second->version_builder(), &elem.second});
+  }
+  const int num_threads = std::min(
+      static_cast<int>(work.size()),
+      std::max(1, version_set_->db_options_->max_manifest_recovery_threads));
+  std::vector<Status> statuses(num_threads);
+  std::atomic<size_t> next_work(0);
+  auto apply_fn = [&work, &next_work](Status* thread_status) {
+    size_t i;
+    while ((i = next_work.fetch_add(1)) < work.size()) {
+      for (VersionEdit& edit : *work[i].edits) {
+        Status s = work[i].builder->Apply(&edit);
+        if (!s.ok()) {
+          *thread_status = s;
+          return;
+        }
+      }
+    }
+  };
+  if (num_threads <= 1) {
+    apply_fn(&statuses[0]);
+  } else {
+    std::vector<port::Thread> threads;
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; i++) {
+      threads.emplace_back(apply_fn, &statuses[i]);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+  Status s;
+  for (const Status& thread_status : statuses) {
+    if (!thread_status.ok()) {
+      s = thread_status;
+      break;
+    }
+  }
+  cf_pending_edits_.clear();
+  return s;
+}
+
 Status VersionEditHandler::ExtractInfoFromVersionEdit(ColumnFamilyData* cfd,
                                                       const VersionEdit& edit) {
   Status s;
@@ -645,7 +721,11 @@ VersionEditHandlerPointInTime::VersionEditHandlerPointInTime(
     VersionSet* version_set, const std::shared_ptr<IOTracer>& io_tracer)
     : VersionEditHandler(read_only, column_families, version_set,
                          /*track_missing_files=*/true,
-                         /*no_error_if_files_missing=*/true, io_tracer) {}
+                         /*no_error_if_files_missing=*/true, io_tracer) {
+  // Point-in-time recovery creates versions while the MANIFEST is being
+  // iterated and thus needs builder state to be current for every edit.
+  defer_builder_apply_ = false;
+}
 
 VersionEditHandlerPointInTime::~VersionEditHandlerPointInTime() {
   for (const auto& elem : versions_) {
@@ -168,6 +168,13 @@ class VersionEditHandler : public VersionEditHandlerBase {
                     bool prefetch_index_and_filter_in_cache,
                     bool is_initial_load);
 
+  // Applies the version edits buffered in cf_pending_edits_ to the
+  // per-column-family version builders, using up to
+  // max_manifest_recovery_threads threads. Edits are applied in MANIFEST
+  // order within each column family, so the result is the same as applying
+  // them inline during Iterate().
+  Status ApplyPendingEdits();
+
   virtual bool MustOpenAllColumnFamilies() const { return !read_only_; }
 
   const bool read_only_;
@@ -189,6 +196,13 @@ class VersionEditHandler : public VersionEditHandlerBase {
   bool skip_load_table_files_;
   bool initialized_;
   std::unique_ptr<std::unordered_map<uint32_t, std::string>> cf_to_cmp_names_;
+  // When true, OnNonCfOperation() buffers edits in cf_pending_edits_ instead
+  // of applying them to the version builders inline; the buffered edits are
+  // applied in parallel by ApplyPendingEdits() once the whole MANIFEST has
+  // been read. Disabled by subclasses that need builder state to be current
+  // while iterating (e.g. point-in-time recovery).
+  bool defer_builder_apply_;
+  std::unordered_map<uint32_t, std::vector<VersionEdit>> cf_pending_edits_;
 
  private:
   Status ExtractInfoFromVersionEdit(ColumnFamilyData* cfd,
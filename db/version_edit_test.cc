@@ -114,6 +114,34 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
   ASSERT_EQ(1001, new_files[3].second.oldest_blob_file_number);
 }
 
+TEST_F(VersionEditTest, EncodeDecodeTailSize) {
+  static const uint64_t kBig = 1ull << 50;
+
+  VersionEdit edit;
+  FileMetaData meta(300, 3, 100, InternalKey("foo", kBig + 500, kTypeValue),
+                    InternalKey("zoo", kBig + 600, kTypeDeletion), kBig + 500,
+                    kBig + 600, true, Temperature::kUnknown,
+                    kInvalidBlobFileNumber, kUnknownOldestAncesterTime,
+                    kUnknownFileCreationTime, kUnknownFileChecksum,
+                    kUnknownFileChecksumFuncName, kNullUniqueId64x2);
+  meta.fd.tail_size = 4096;
+  edit.AddFile(3, meta);
+  edit.SetComparatorName("foo");
+  edit.SetLogNumber(kBig + 100);
+  edit.SetNextFile(kBig + 200);
+  edit.SetLastSequence(kBig + 1000);
+  TestEncodeDecode(edit);
+
+  std::string encoded;
+  edit.EncodeTo(&encoded);
+  VersionEdit parsed;
+  Status s = parsed.DecodeFrom(encoded);
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  auto& new_files = parsed.GetNewFiles();
+  ASSERT_EQ(1u, new_files.size());
+  ASSERT_EQ(4096u, new_files[0].second.fd.tail_size);
+}
+
 TEST_F(VersionEditTest, ForwardCompatibleNewFile4) {
   static const uint64_t kBig = 1ull << 50;
   VersionEdit edit;
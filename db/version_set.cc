@@ -39,7 +39,7 @@
 #include "db/table_cache.h"
 #include "db/version_builder.h"
 #include "db/version_edit_handler.h"
-#if USE_COROUTINES
+#if USE_COROUTINES && !defined(USE_STD_COROUTINES)
 #include "folly/experimental/coro/BlockingWait.h"
 #include "folly/experimental/coro/Collect.h"
 #endif
@@ -73,18 +73,6 @@
 #include "util/string_util.h"
 #include "util/user_comparator_wrapper.h"
 
-// Generate the regular and coroutine versions of some methods by
-// including version_set_sync_and_async.h twice
-// Macros in the header will expand differently based on whether
-// WITH_COROUTINES or WITHOUT_COROUTINES is defined
-// clang-format off
-#define WITHOUT_COROUTINES
-#include "db/version_set_sync_and_async.h"
-#undef WITHOUT_COROUTINES
-#define WITH_COROUTINES
-#include "db/version_set_sync_and_async.h"
-#undef WITH_COROUTINES
-// clang-format on
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -144,7 +132,8 @@ class FilePicker {
   FilePicker(const Slice& user_key, const Slice& ikey,
              autovector<LevelFilesBrief>* file_levels, unsigned int num_levels,
              FileIndexer* file_indexer, const Comparator* user_comparator,
-             const InternalKeyComparator* internal_comparator)
+             const InternalKeyComparator* internal_comparator,
+             const std::vector<std::vector<int>>* l0_sorted_runs = nullptr)
       : num_levels_(num_levels),
         curr_level_(static_cast<unsigned int>(-1)),
         returned_file_level_(static_cast<unsigned int>(-1)),
@@ -154,6 +143,9 @@ class FilePicker {
         level_files_brief_(file_levels),
         is_hit_file_last_in_level_(false),
         curr_file_level_(nullptr),
+        l0_sorted_runs_(l0_sorted_runs),
+        use_l0_candidates_(false),
+        curr_candidate_(0),
         user_key_(user_key),
         ikey_(ikey),
         file_indexer_(file_indexer),
@@ -162,11 +154,29 @@ class FilePicker {
     // Setup member variables to search first level.
     search_ended_ = !PrepareNextLevel();
     if (!search_ended_) {
-      // Prefetch Level 0 table data to avoid cache miss if possible.
-      for (unsigned int i = 0; i < (*level_files_brief_)[0].num_files; ++i) {
-        auto* r = (*level_files_brief_)[0].files[i].fd.table_reader;
-        if (r) {
-          r->Prepare(ikey);
+      // Same condition under which GetNextFile() would do key range
+      // filtering; with fewer files a linear pass over L0 is cheap anyway.
+      if (curr_level_ == 0 && l0_sorted_runs_ != nullptr &&
+          !l0_sorted_runs_->empty() &&
+          (num_levels_ > 1 || curr_file_level_->num_files > 3)) {
+        BuildL0Candidates();
+      }
+      if (use_l0_candidates_) {
+        // Prefetch table data only for the files that may contain the key.
+        for (size_t i = 0; i < l0_candidates_.size(); ++i) {
+          auto* r =
+              (*level_files_brief_)[0].files[l0_candidates_[i]].fd.table_reader;
+          if (r) {
+            r->Prepare(ikey);
+          }
+        }
+      } else {
+        // Prefetch Level 0 table data to avoid cache miss if possible.
+        for (unsigned int i = 0; i < (*level_files_brief_)[0].num_files; ++i) {
+          auto* r = (*level_files_brief_)[0].files[i].fd.table_reader;
+          if (r) {
+            r->Prepare(ikey);
+          }
         }
       }
     }
@@ -176,6 +186,21 @@ class FilePicker {
 
   FdWithKeyRange* GetNextFile() {
     while (!search_ended_) {  // Loops over different levels.
+      if (curr_level_ == 0 && use_l0_candidates_) {
+        // The candidate list already holds exactly the L0 files whose key
+        // range covers user_key_, newest to oldest.
+        if (curr_candidate_ < l0_candidates_.size()) {
+          unsigned int file_index = l0_candidates_[curr_candidate_++];
+          FdWithKeyRange* f = &curr_file_level_->files[file_index];
+          hit_file_level_ = 0;
+          returned_file_level_ = 0;
+          is_hit_file_last_in_level_ =
+              file_index == curr_file_level_->num_files - 1;
+          return f;
+        }
+        search_ended_ = !PrepareNextLevel();
+        continue;
+      }
       while (curr_index_in_curr_level_ < curr_file_level_->num_files) {
         // Loops over all files in current level.
         FdWithKeyRange* f = &curr_file_level_->files[curr_index_in_curr_level_];
@@ -264,6 +289,10 @@ class FilePicker {
   bool search_ended_;
   bool is_hit_file_last_in_level_;
   LevelFilesBrief* curr_file_level_;
+  const std::vector<std::vector<int>>* l0_sorted_runs_;
+  bool use_l0_candidates_;
+  size_t curr_candidate_;
+  autovector<unsigned int, 8> l0_candidates_;
   unsigned int curr_index_in_curr_level_;
   unsigned int start_index_in_curr_level_;
   Slice user_key_;
@@ -272,6 +301,41 @@ class FilePicker {
   const Comparator* user_comparator_;
   const InternalKeyComparator* internal_comparator_;
 
+  // Collect the L0 files whose key range covers user_key_ by binary searching
+  // each sorted run instead of range-checking every file. Runs are ordered
+  // newest to oldest and so are the resulting candidates, preserving the
+  // order GetNextFile() must return L0 files in. Within a run files do not
+  // overlap in user key, so each run contributes at most one candidate.
+  void BuildL0Candidates() {
+    assert(curr_level_ == 0);
+    assert(l0_sorted_runs_ != nullptr);
+    for (const auto& run : *l0_sorted_runs_) {
+      // Find the last file in the run whose smallest user key is <= user_key_.
+      int left = 0;
+      int right = static_cast<int>(run.size()) - 1;
+      int found = -1;
+      while (left <= right) {
+        int mid = left + (right - left) / 2;
+        const FdWithKeyRange* f = &curr_file_level_->files[run[mid]];
+        if (user_comparator_->CompareWithoutTimestamp(
+                ExtractUserKey(f->smallest_key), user_key_) <= 0) {
+          found = mid;
+          left = mid + 1;
+        } else {
+          right = mid - 1;
+        }
+      }
+      if (found >= 0) {
+        const FdWithKeyRange* f = &curr_file_level_->files[run[found]];
+        if (user_comparator_->CompareWithoutTimestamp(
+                user_key_, ExtractUserKey(f->largest_key)) <= 0) {
+          l0_candidates_.push_back(static_cast<unsigned int>(run[found]));
+        }
+      }
+    }
+    use_l0_candidates_ = true;
+  }
+
   // Setup local variables to search next level.
   // Returns false if there are no more levels to search.
   bool PrepareNextLevel() {
@@ -347,7 +411,13 @@ class FilePicker {
     return false;
   }
 };
+}  // anonymous namespace
 
+// In a named namespace rather than the anonymous one above: the coroutine
+// frame of Version::MultiGetCoroutine() is an external-linkage type with a
+// FilePickerMultiGet member, which gcc rejects for internal-linkage types
+// under -Wsubobject-linkage.
+namespace multiget_detail {
 class FilePickerMultiGet {
  private:
   struct FilePickerContext;
@@ -754,7 +824,25 @@ class FilePickerMultiGet {
     return false;
   }
 };
-}  // anonymous namespace
+}  // namespace multiget_detail
+
+using multiget_detail::FilePickerMultiGet;
+}  // namespace ROCKSDB_NAMESPACE
+
+// Generate the regular and coroutine versions of some methods by
+// including version_set_sync_and_async.h twice
+// Macros in the header will expand differently based on whether
+// WITH_COROUTINES or WITHOUT_COROUTINES is defined
+// clang-format off
+#define WITHOUT_COROUTINES
+#include "db/version_set_sync_and_async.h"
+#undef WITHOUT_COROUTINES
+#define WITH_COROUTINES
+#include "db/version_set_sync_and_async.h"
+#undef WITH_COROUTINES
+// clang-format on
+
+namespace ROCKSDB_NAMESPACE {
 
 VersionStorageInfo::~VersionStorageInfo() { delete[] files_; }
 
@@ -889,7 +977,8 @@ class LevelIterator final : public InternalIterator {
                 RangeDelAggregator* range_del_agg,
                 const std::vector<AtomicCompactionUnitBoundary>*
                     compaction_boundaries = nullptr,
-                bool allow_unprepared_value = false)
+                bool allow_unprepared_value = false,
+                ColumnFamilyData* cfd = nullptr)
       : table_cache_(table_cache),
         read_options_(read_options),
         file_options_(file_options),
@@ -907,12 +996,22 @@ class LevelIterator final : public InternalIterator {
         range_del_agg_(range_del_agg),
         pinned_iters_mgr_(nullptr),
         compaction_boundaries_(compaction_boundaries),
-        is_next_read_sequential_(false) {
+        is_next_read_sequential_(false),
+        cfd_(cfd) {
     // Empty level is not supported.
     assert(flevel_ != nullptr && flevel_->num_files > 0);
   }
 
-  ~LevelIterator() override { delete file_iter_.Set(nullptr); }
+  ~LevelIterator() override {
+    if (cfd_ != nullptr && file_iter_.iter() != nullptr) {
+      // Publish the readahead state this scan ramped up to, so the next
+      // scan on the column family starts from it.
+      ReadaheadFileInfo readahead_file_info;
+      file_iter_.iter()->GetReadaheadState(&readahead_file_info);
+      cfd_->PublishReadaheadInfo(readahead_file_info);
+    }
+    delete file_iter_.Set(nullptr);
+  }
 
   void Seek(const Slice& target) override;
   void SeekForPrev(const Slice& target) override;
@@ -920,6 +1019,13 @@ class LevelIterator final : public InternalIterator {
   void SeekToLast() override;
   void Next() final override;
   bool NextAndGetResult(IterateResult* result) override;
+  void NextBatch(IterateResultBuffer* buffer) override {
+    assert(Valid());
+    // One file is open at a time, so there is no merge logic to apply here;
+    // delegate to the file iterator, which batches within its current data
+    // block. Advancing past the batch goes through Next() as usual.
+    file_iter_.iter()->NextBatch(buffer);
+  }
   void Prev() override;
 
   bool Valid() const override { return file_iter_.Valid(); }
@@ -1004,13 +1110,31 @@ class LevelIterator final : public InternalIterator {
       largest_compaction_key = (*compaction_boundaries_)[file_index_].largest;
     }
     CheckMayBeOutOfLowerBound();
+    bool keep = true;
+    const bool table_filter_evaluated =
+        table_cache_->EvaluateTableFilter(read_options_, file_meta.fd, &keep);
+    if (!keep) {
+      // The scan's table filter rejected this file based on its cached
+      // properties, so skip it without opening it. The empty iterator makes
+      // SkipEmptyFileForward()/Backward() move on to the next file.
+      return NewEmptyInternalIterator<Slice>(/*arena=*/nullptr);
+    }
+    if (read_options_.timestamp != nullptr &&
+        table_cache_->PruneForReadTimestamp(file_meta.fd,
+                                            user_comparator_.user_comparator(),
+                                            *read_options_.timestamp)) {
+      // All entries in this file are newer than the read timestamp, so none
+      // of them are visible to this scan.
+      return NewEmptyInternalIterator<Slice>(/*arena=*/nullptr);
+    }
     return table_cache_->NewIterator(
         read_options_, file_options_, icomparator_, *file_meta.file_metadata,
         range_del_agg_, prefix_extractor_,
         nullptr /* don't need reference to table */, file_read_hist_, caller_,
         /*arena=*/nullptr, skip_filters_, level_,
         /*max_file_size_for_l0_meta_pin=*/0, smallest_compaction_key,
-        largest_compaction_key, allow_unprepared_value_);
+        largest_compaction_key, allow_unprepared_value_,
+        table_filter_evaluated /* skip_table_filter */);
   }
 
   // Check if current file being fully within iterate_lower_bound.
@@ -1056,6 +1180,11 @@ class LevelIterator final : public InternalIterator {
   const std::vector<AtomicCompactionUnitBoundary>* compaction_boundaries_;
 
   bool is_next_read_sequential_;
+
+  // If non-null, readahead state learned by previous scans on this column
+  // family seeds new file iterators, and the state reached by this scan is
+  // published back on destruction. Only set for user iterators.
+  ColumnFamilyData* cfd_;
 };
 
 void LevelIterator::Seek(const Slice& target) {
@@ -1238,6 +1367,14 @@ void LevelIterator::SetFileIterator(InternalIterator* iter) {
   // Update the read pattern for PrefetchBuffer.
   if (is_next_read_sequential_) {
     file_iter_.UpdateReadaheadState(old_iter);
+  } else if (old_iter == nullptr && iter != nullptr && cfd_ != nullptr) {
+    // First file this iterator opens: seed the readahead ramp from what
+    // previous scans on this column family learned instead of starting
+    // from the initial readahead size.
+    ReadaheadFileInfo readahead_file_info;
+    if (cfd_->SeedReadaheadInfo(&readahead_file_info)) {
+      iter->SetReadaheadState(&readahead_file_info);
+    }
   }
 
   if (pinned_iters_mgr_ && pinned_iters_mgr_->PinningEnabled()) {
@@ -1600,6 +1737,35 @@ Status Version::VerifySstUniqueIds() const {
   return Status::OK();
 }
 
+void Version::WarmTableCacheAtLevel(int level,
+                                    const std::atomic<bool>& abort) {
+  assert(level < storage_info_.num_levels());
+  for (FileMetaData* file_meta : storage_info_.LevelFiles(level)) {
+    if (abort.load(std::memory_order_acquire)) {
+      return;
+    }
+    if (file_meta->table_reader_handle != nullptr ||
+        file_meta->fd.table_reader != nullptr) {
+      continue;
+    }
+    Cache::Handle* handle = nullptr;
+    Status s = cfd_->table_cache()->FindTable(
+        ReadOptions(), file_options_, cfd_->internal_comparator(),
+        file_meta->fd, &handle, mutable_cf_options_.prefix_extractor,
+        false /* no_io */, false /* record_read_stats */,
+        nullptr /* file_read_hist */, false /* skip_filters */, level,
+        false /* prefetch_index_and_filter_in_cache */,
+        MaxFileSizeForL0MetaPin(mutable_cf_options_), file_meta->temperature);
+    if (s.ok()) {
+      cfd_->table_cache()->ReleaseHandle(handle);
+    } else {
+      // Warming is best-effort; the first read of this file will report the
+      // error.
+      s.PermitUncheckedError();
+    }
+  }
+}
+
 uint64_t VersionStorageInfo::GetEstimatedActiveKeys() const {
   // Estimation will be inaccurate when:
   // (1) there exist merge keys
@@ -1682,6 +1848,21 @@ void Version::AddIteratorsForLevel(const ReadOptions& read_options,
     // Merge all level zero files together since they may overlap
     for (size_t i = 0; i < storage_info_.LevelFilesBrief(0).num_files; i++) {
       const auto& file = storage_info_.LevelFilesBrief(0).files[i];
+      bool keep = true;
+      const bool table_filter_evaluated =
+          cfd_->table_cache()->EvaluateTableFilter(read_options, file.fd,
+                                                   &keep);
+      if (!keep) {
+        // The scan's table filter rejected this file based on its cached
+        // properties; prune it without opening it.
+        continue;
+      }
+      if (read_options.timestamp != nullptr &&
+          cfd_->table_cache()->PruneForReadTimestamp(
+              file.fd, user_comparator(), *read_options.timestamp)) {
+        // All entries in this file are newer than the read timestamp.
+        continue;
+      }
       merge_iter_builder->AddIterator(cfd_->table_cache()->NewIterator(
           read_options, soptions, cfd_->internal_comparator(),
           *file.file_metadata, range_del_agg,
@@ -1690,7 +1871,8 @@ void Version::AddIteratorsForLevel(const ReadOptions& read_options,
           TableReaderCaller::kUserIterator, arena,
           /*skip_filters=*/false, /*level=*/0, max_file_size_for_l0_meta_pin_,
           /*smallest_compaction_key=*/nullptr,
-          /*largest_compaction_key=*/nullptr, allow_unprepared_value));
+          /*largest_compaction_key=*/nullptr, allow_unprepared_value,
+          table_filter_evaluated /* skip_table_filter */));
     }
     if (should_sample) {
       // Count ones for every L0 files. This is done per iterator creation
@@ -1713,7 +1895,7 @@ void Version::AddIteratorsForLevel(const ReadOptions& read_options,
         cfd_->internal_stats()->GetFileReadHist(level),
         TableReaderCaller::kUserIterator, IsFilterSkipped(level), level,
         range_del_agg,
-        /*compaction_boundaries=*/nullptr, allow_unprepared_value));
+        /*compaction_boundaries=*/nullptr, allow_unprepared_value, cfd_));
   }
 }
 
@@ -2015,7 +2197,7 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
   FilePicker fp(user_key, ikey, &storage_info_.level_files_brief_,
                 storage_info_.num_non_empty_levels_,
                 &storage_info_.file_indexer_, user_comparator(),
-                internal_comparator());
+                internal_comparator(), &storage_info_.l0_sorted_runs_);
   FdWithKeyRange* f = fp.GetNextFile();
 
   while (f != nullptr) {
@@ -2024,6 +2206,14 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       // stop here.
       break;
     }
+    if (read_options.timestamp != nullptr &&
+        table_cache_->PruneForReadTimestamp(f->fd, user_comparator(),
+                                            *read_options.timestamp)) {
+      // Every entry in this file is newer than the read timestamp; skip it
+      // without touching the table.
+      f = fp.GetNextFile();
+      continue;
+    }
     if (get_context.sample()) {
       sample_file_read_inc(f->file_metadata);
     }
@@ -2147,214 +2337,6 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
   }
 }
 
-void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
-                       ReadCallback* callback) {
-  PinnedIteratorsManager pinned_iters_mgr;
-
-  // Pin blocks that we read to hold merge operands
-  if (merge_operator_) {
-    pinned_iters_mgr.StartPinning();
-  }
-  uint64_t tracing_mget_id = BlockCacheTraceHelper::kReservedGetId;
-
-  if (vset_ && vset_->block_cache_tracer_ &&
-      vset_->block_cache_tracer_->is_tracing_enabled()) {
-    tracing_mget_id = vset_->block_cache_tracer_->NextGetId();
-  }
-  // Even though we know the batch size won't be > MAX_BATCH_SIZE,
-  // use autovector in order to avoid unnecessary construction of GetContext
-  // objects, which is expensive
-  autovector<GetContext, 16> get_ctx;
-  BlobFetcher blob_fetcher(this, read_options);
-  for (auto iter = range->begin(); iter != range->end(); ++iter) {
-    assert(iter->s->ok() || iter->s->IsMergeInProgress());
-    get_ctx.emplace_back(
-        user_comparator(), merge_operator_, info_log_, db_statistics_,
-        iter->s->ok() ? GetContext::kNotFound : GetContext::kMerge,
-        iter->ukey_with_ts, iter->value, iter->timestamp, nullptr,
-        &(iter->merge_context), true, &iter->max_covering_tombstone_seq, clock_,
-        nullptr, merge_operator_ ? &pinned_iters_mgr : nullptr, callback,
-        &iter->is_blob_index, tracing_mget_id, &blob_fetcher);
-    // MergeInProgress status, if set, has been transferred to the get_context
-    // state, so we set status to ok here. From now on, the iter status will
-    // be used for IO errors, and get_context state will be used for any
-    // key level errors
-    *(iter->s) = Status::OK();
-  }
-  int get_ctx_index = 0;
-  for (auto iter = range->begin(); iter != range->end();
-       ++iter, get_ctx_index++) {
-    iter->get_context = &(get_ctx[get_ctx_index]);
-  }
-
-  MultiGetRange file_picker_range(*range, range->begin(), range->end());
-  FilePickerMultiGet fp(
-      &file_picker_range,
-      &storage_info_.level_files_brief_, storage_info_.num_non_empty_levels_,
-      &storage_info_.file_indexer_, user_comparator(), internal_comparator());
-  FdWithKeyRange* f = fp.GetNextFileInLevel();
-  Status s;
-  uint64_t num_index_read = 0;
-  uint64_t num_filter_read = 0;
-  uint64_t num_sst_read = 0;
-  uint64_t num_level_read = 0;
-
-  MultiGetRange keys_with_blobs_range(*range, range->begin(), range->end());
-  // blob_file => [[blob_idx, it], ...]
-  std::unordered_map<uint64_t, BlobReadContexts> blob_ctxs;
-  int prev_level = -1;
-
-  while (!fp.IsSearchEnded()) {
-    // This will be set to true later if we actually look up in a file in L0.
-    // For per level stats purposes, an L0 file is treated as a level
-    bool dump_stats_for_l0_file = false;
-
-    // Avoid using the coroutine version if we're looking in a L0 file, since
-    // L0 files won't be parallelized anyway. The regular synchronous version
-    // is faster.
-    if (!read_options.async_io || !using_coroutines() ||
-        fp.GetHitFileLevel() == 0 || !fp.RemainingOverlapInLevel()) {
-      if (f) {
-        // Call MultiGetFromSST for looking up a single file
-        s = MultiGetFromSST(read_options, fp.CurrentFileRange(),
-                            fp.GetHitFileLevel(), fp.IsHitFileLastInLevel(), f,
-                            blob_ctxs, num_filter_read, num_index_read,
-                            num_sst_read);
-        if (fp.GetHitFileLevel() == 0) {
-          dump_stats_for_l0_file = true;
-        }
-      }
-      if (s.ok()) {
-        f = fp.GetNextFileInLevel();
-      }
-#if USE_COROUTINES
-    } else {
-      std::vector<folly::coro::Task<Status>> mget_tasks;
-      while (f != nullptr) {
-        mget_tasks.emplace_back(MultiGetFromSSTCoroutine(
-            read_options, fp.CurrentFileRange(), fp.GetHitFileLevel(),
-            fp.IsHitFileLastInLevel(), f, blob_ctxs, num_filter_read,
-            num_index_read, num_sst_read));
-        if (fp.KeyMaySpanNextFile()) {
-          break;
-        }
-        f = fp.GetNextFileInLevel();
-      }
-      if (mget_tasks.size() > 0) {
-        RecordTick(db_statistics_, MULTIGET_COROUTINE_COUNT, mget_tasks.size());
-        // Collect all results so far
-        std::vector<Status> statuses = folly::coro::blockingWait(
-            folly::coro::collectAllRange(std::move(mget_tasks))
-                .scheduleOn(&range->context()->executor()));
-        for (Status stat : statuses) {
-          if (!stat.ok()) {
-            s = stat;
-          }
-        }
-
-        if (s.ok() && fp.KeyMaySpanNextFile()) {
-          f = fp.GetNextFileInLevel();
-        }
-      }
-#endif  // USE_COROUTINES
-    }
-    // If bad status or we found final result for all the keys
-    if (!s.ok() || file_picker_range.empty()) {
-      break;
-    }
-    if (!f) {
-      // Reached the end of this level. Prepare the next level
-      fp.PrepareNextLevelForSearch();
-      if (!fp.IsSearchEnded()) {
-        // Its possible there is no overlap on this level and f is nullptr
-        f = fp.GetNextFileInLevel();
-      }
-      if (dump_stats_for_l0_file ||
-          (prev_level != 0 && prev_level != (int)fp.GetHitFileLevel())) {
-        // Dump the stats if the search has moved to the next level and
-        // reset for next level.
-        if (num_filter_read + num_index_read) {
-          RecordInHistogram(db_statistics_,
-                            NUM_INDEX_AND_FILTER_BLOCKS_READ_PER_LEVEL,
-                            num_index_read + num_filter_read);
-        }
-        if (num_sst_read) {
-          RecordInHistogram(db_statistics_, NUM_SST_READ_PER_LEVEL,
-                            num_sst_read);
-          num_level_read++;
-        }
-        num_filter_read = 0;
-        num_index_read = 0;
-        num_sst_read = 0;
-      }
-      prev_level = fp.GetHitFileLevel();
-    }
-  }
-
-  // Dump stats for most recent level
-  if (num_filter_read + num_index_read) {
-    RecordInHistogram(db_statistics_,
-                      NUM_INDEX_AND_FILTER_BLOCKS_READ_PER_LEVEL,
-                      num_index_read + num_filter_read);
-  }
-  if (num_sst_read) {
-    RecordInHistogram(db_statistics_, NUM_SST_READ_PER_LEVEL, num_sst_read);
-    num_level_read++;
-  }
-  if (num_level_read) {
-    RecordInHistogram(db_statistics_, NUM_LEVEL_READ_PER_MULTIGET,
-                      num_level_read);
-  }
-
-  if (s.ok() && !blob_ctxs.empty()) {
-    MultiGetBlob(read_options, keys_with_blobs_range, blob_ctxs);
-  }
-
-  // Process any left over keys
-  for (auto iter = range->begin(); s.ok() && iter != range->end(); ++iter) {
-    GetContext& get_context = *iter->get_context;
-    Status* status = iter->s;
-    Slice user_key = iter->lkey->user_key();
-
-    if (db_statistics_ != nullptr) {
-      get_context.ReportCounters();
-    }
-    if (GetContext::kMerge == get_context.State()) {
-      if (!merge_operator_) {
-        *status = Status::InvalidArgument(
-            "merge_operator is not properly initialized.");
-        range->MarkKeyDone(iter);
-        continue;
-      }
-      // merge_operands are in saver and we hit the beginning of the key history
-      // do a final merge of nullptr and operands;
-      std::string* str_value =
-          iter->value != nullptr ? iter->value->GetSelf() : nullptr;
-      *status = MergeHelper::TimedFullMerge(
-          merge_operator_, user_key, nullptr, iter->merge_context.GetOperands(),
-          str_value, info_log_, db_statistics_, clock_,
-          nullptr /* result_operand */, true);
-      if (LIKELY(iter->value != nullptr)) {
-        iter->value->PinSelf();
-        range->AddValueSize(iter->value->size());
-        range->MarkKeyDone(iter);
-        if (range->GetValueSize() > read_options.value_size_soft_limit) {
-          s = Status::Aborted();
-          break;
-        }
-      }
-    } else {
-      range->MarkKeyDone(iter);
-      *status = Status::NotFound();  // Use an empty error message for speed
-    }
-  }
-
-  for (auto iter = range->begin(); iter != range->end(); ++iter) {
-    range->MarkKeyDone(iter);
-    *(iter->s) = s;
-  }
-}
-
 bool Version::IsFilterSkipped(int level, bool is_file_last_in_level) {
   // Reaching the bottom level implies misses at all upper levels, so we'll
   // skip checking the filters when we predict a hit.
@@ -2381,8 +2363,11 @@ void VersionStorageInfo::PrepareForVersionAppend(
   GenerateFileIndexer();
   GenerateLevelFilesBrief();
   GenerateLevel0NonOverlapping();
+  GenerateLevel0SortedRuns();
+  GenerateLevel0OverlapIndex();
   GenerateBottommostFiles();
   GenerateFileLocationIndex();
+  GenerateSizeSketch();
 }
 
 void Version::PrepareAppend(const MutableCFOptions& mutable_cf_options,
@@ -2416,6 +2401,7 @@ bool Version::MaybeInitializeFileMetaData(FileMetaData* file_meta) {
   if (tp.get() == nullptr) return false;
   file_meta->num_entries = tp->num_entries;
   file_meta->num_deletions = tp->num_deletions;
+  file_meta->num_range_deletions = tp->num_range_deletions;
   file_meta->raw_value_size = tp->raw_value_size;
   file_meta->raw_key_size = tp->raw_key_size;
 
@@ -2525,6 +2511,23 @@ void VersionStorageInfo::ComputeCompensatedSizes() {
               (file_meta->num_deletions * 2 - file_meta->num_entries) *
               average_value_size * kDeletionWeightOnCompaction;
         }
+        if (file_meta->num_range_deletions > 0) {
+          // Credit range-tombstone-carrying files with the deeper-level
+          // bytes their tombstones are expected to reclaim, so they are
+          // prioritized by reclaimable bytes and not just their own size.
+          // Only newly created files get here, so the per-level scans are
+          // cheap.
+          FileReclaimedBytesEstimator estimator(internal_comparator_);
+          uint64_t overlapping_bytes = 0;
+          // A file can only reclaim from levels deeper than its own.
+          for (int below = level + 1; below < num_levels_; below++) {
+            overlapping_bytes +=
+                estimator.OverlappingBytes(*file_meta, files_[below]);
+          }
+          file_meta->compensated_file_size +=
+              FileReclaimedBytesEstimator::ScaleByTombstoneDensity(
+                  *file_meta, overlapping_bytes);
+        }
       }
     }
   }
@@ -2805,11 +2808,21 @@ void VersionStorageInfo::ComputeCompactionScore(
   ComputeBottommostFilesMarkedForCompaction();
   if (mutable_cf_options.ttl > 0) {
     ComputeExpiredTtlFiles(immutable_options, mutable_cf_options.ttl);
+    if (mutable_cf_options.ttl_delete_expired_files &&
+        compaction_style_ == kCompactionStyleLevel) {
+      ComputeBottommostExpiredTtlFiles(immutable_options,
+                                       mutable_cf_options.ttl);
+    }
   }
   if (mutable_cf_options.periodic_compaction_seconds > 0) {
     ComputeFilesMarkedForPeriodicCompaction(
         immutable_options, mutable_cf_options.periodic_compaction_seconds);
   }
+  if (mutable_cf_options.cold_file_age_seconds > 0) {
+    ComputeFilesMarkedForTemperatureChange(
+        immutable_options, mutable_cf_options.cold_file_age_seconds,
+        mutable_cf_options.cold_file_temperature);
+  }
 
   if (mutable_cf_options.enable_blob_garbage_collection &&
       mutable_cf_options.blob_garbage_collection_age_cutoff > 0.0 &&
@@ -2871,6 +2884,41 @@ void VersionStorageInfo::ComputeExpiredTtlFiles(
   }
 }
 
+void VersionStorageInfo::ComputeBottommostExpiredTtlFiles(
+    const ImmutableOptions& ioptions, const uint64_t ttl) {
+  assert(ttl > 0);
+
+  bottommost_expired_ttl_files_.clear();
+
+  int64_t _current_time;
+  auto status = ioptions.clock->GetCurrentTime(&_current_time);
+  if (!status.ok()) {
+    return;
+  }
+  const uint64_t current_time = static_cast<uint64_t>(_current_time);
+  if (current_time < ttl) {
+    // All files are younger than the TTL. Guarding here also avoids
+    // underflow below.
+    return;
+  }
+
+  // Only bottommost files are eligible for dropping: there can be no
+  // older versions of their keys buried in lower levels. The file
+  // creation time upper-bounds the write time of every entry in the
+  // file, so a file whose creation time has passed the TTL contains
+  // only expired entries.
+  const int last_level = num_levels() - 1;
+  for (FileMetaData* f : files_[last_level]) {
+    if (!f->being_compacted) {
+      uint64_t file_creation_time = f->TryGetFileCreationTime();
+      if (file_creation_time > 0 &&
+          file_creation_time < (current_time - ttl)) {
+        bottommost_expired_ttl_files_.emplace_back(last_level, f);
+      }
+    }
+  }
+}
+
 void VersionStorageInfo::ComputeFilesMarkedForPeriodicCompaction(
     const ImmutableOptions& ioptions,
     const uint64_t periodic_compaction_seconds) {
@@ -2928,6 +2976,52 @@ void VersionStorageInfo::ComputeFilesMarkedForPeriodicCompaction(
   }
 }
 
+void VersionStorageInfo::ComputeFilesMarkedForTemperatureChange(
+    const ImmutableOptions& ioptions, const uint64_t cold_file_age_seconds,
+    const Temperature cold_file_temperature) {
+  assert(cold_file_age_seconds > 0);
+
+  files_marked_for_temperature_change_.clear();
+
+  int64_t temp_current_time;
+  auto status = ioptions.clock->GetCurrentTime(&temp_current_time);
+  if (!status.ok()) {
+    return;
+  }
+  const uint64_t current_time = static_cast<uint64_t>(temp_current_time);
+
+  // If cold_file_age_seconds is larger than current time, temperature
+  // change can't possibly be triggered.
+  if (cold_file_age_seconds > current_time) {
+    return;
+  }
+
+  const uint64_t allowed_time_limit = current_time - cold_file_age_seconds;
+
+  for (int level = 0; level < num_levels(); level++) {
+    for (auto f : files_[level]) {
+      if (f->being_compacted) {
+        continue;
+      }
+      const uint64_t num_reads =
+          f->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      if (f->last_read_observed_time == 0 ||
+          num_reads != f->last_observed_num_reads) {
+        // First time we see this file, or it has been read since the last
+        // scan. Restart the cooldown clock, so a file only migrates after
+        // a full unread period has been observed by this DB instance.
+        f->last_observed_num_reads = num_reads;
+        f->last_read_observed_time = current_time;
+        continue;
+      }
+      if (f->temperature != cold_file_temperature &&
+          f->last_read_observed_time <= allowed_time_limit) {
+        files_marked_for_temperature_change_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
 void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     double blob_garbage_collection_age_cutoff,
     double blob_garbage_collection_force_threshold) {
@@ -2944,13 +3038,16 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     return;
   }
 
-  // Compute the sum of total and garbage bytes over the oldest batch of blob
-  // files. The oldest batch is defined as the set of blob files which are
-  // kept alive by the same SSTs as the very oldest one. Here is a toy example.
-  // Let's assume we have three SSTs 1, 2, and 3, and four blob files 10, 11,
-  // 12, and 13. Also, let's say SSTs 1 and 2 both rely on blob file 10 and
-  // potentially some higher-numbered ones, while SST 3 relies on blob file 12
-  // and potentially some higher-numbered ones. Then, the SST to oldest blob
+  // Blob files can only be collected in age order: a blob file is freed once
+  // all the SSTs keeping it alive have been rewritten, and each SST pins its
+  // oldest blob file plus every newer one up to the next pinned file. This
+  // partitions the blob files into batches, where each batch consists of a
+  // blob file with a non-empty set of linked SSTs followed by any blob files
+  // which are kept alive by the same SSTs. Here is a toy example. Let's assume
+  // we have three SSTs 1, 2, and 3, and four blob files 10, 11, 12, and 13.
+  // Also, let's say SSTs 1 and 2 both rely on blob file 10 and potentially
+  // some higher-numbered ones, while SST 3 relies on blob file 12 and
+  // potentially some higher-numbered ones. Then, the SST to oldest blob
   // file mapping is as follows:
   //
   // SST file number               Oldest blob file number
@@ -2967,70 +3064,89 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
   // 12                            {3}
   // 13                            {}
   //
-  // Then, the oldest batch of blob files consists of blob files 10 and 11,
-  // and we can get rid of them by forcing the compaction of SSTs 1 and 2.
+  // Then, the first batch of blob files consists of blob files 10 and 11, the
+  // second one of blob files 12 and 13, and we can get rid of the first batch
+  // by forcing the compaction of SSTs 1 and 2 (or of both batches by forcing
+  // the compaction of all three SSTs).
   //
-  // Note that the overall ratio of garbage computed for the batch has to exceed
-  // blob_garbage_collection_force_threshold and the entire batch has to be
-  // eligible for GC according to blob_garbage_collection_age_cutoff in order
-  // for us to schedule any compactions.
-  const auto& oldest_meta = blob_files_.front();
-  assert(oldest_meta);
+  // Since the batches can only be collected oldest-first, the candidates are
+  // the prefixes of the batch sequence that are entirely eligible for GC
+  // according to blob_garbage_collection_age_cutoff. Among those, we pick the
+  // prefix that would reclaim the most garbage per byte of blob data
+  // rewritten, i.e. the one with the highest overall ratio of garbage; this
+  // way, a low-garbage oldest batch does not hold up the collection of
+  // high-garbage newer ones. The winning prefix's overall garbage ratio still
+  // has to reach blob_garbage_collection_force_threshold in order for us to
+  // schedule any compactions.
+  assert(cutoff_count <= blob_files_.size());
 
-  const auto& linked_ssts = oldest_meta->GetLinkedSsts();
-  assert(!linked_ssts.empty());
+  uint64_t sum_total_blob_bytes = 0;
+  uint64_t sum_garbage_blob_bytes = 0;
 
-  size_t count = 1;
-  uint64_t sum_total_blob_bytes = oldest_meta->GetTotalBlobBytes();
-  uint64_t sum_garbage_blob_bytes = oldest_meta->GetGarbageBlobBytes();
+  size_t best_count = 0;
+  uint64_t best_total_blob_bytes = 0;
+  uint64_t best_garbage_blob_bytes = 0;
+  double best_garbage_ratio = 0.0;
 
-  assert(cutoff_count <= blob_files_.size());
+  size_t count = 0;
+  while (count < cutoff_count) {
+    assert(blob_files_[count]);
+    assert(!blob_files_[count]->GetLinkedSsts().empty());
 
-  for (; count < cutoff_count; ++count) {
-    const auto& meta = blob_files_[count];
-    assert(meta);
+    do {
+      const auto& meta = blob_files_[count];
+      assert(meta);
 
-    if (!meta->GetLinkedSsts().empty()) {
-      // Found the beginning of the next batch of blob files
-      break;
-    }
+      sum_total_blob_bytes += meta->GetTotalBlobBytes();
+      sum_garbage_blob_bytes += meta->GetGarbageBlobBytes();
 
-    sum_total_blob_bytes += meta->GetTotalBlobBytes();
-    sum_garbage_blob_bytes += meta->GetGarbageBlobBytes();
-  }
+      ++count;
+    } while (count < blob_files_.size() &&
+             blob_files_[count]->GetLinkedSsts().empty());
 
-  if (count < blob_files_.size()) {
-    const auto& meta = blob_files_[count];
-    assert(meta);
+    if (count > cutoff_count) {
+      // Some files in the last batch examined are not eligible for GC, and
+      // neither is any later batch
+      break;
+    }
 
-    if (meta->GetLinkedSsts().empty()) {
-      // Some files in the oldest batch are not eligible for GC
-      return;
+    assert(sum_total_blob_bytes > 0);
+    const double garbage_ratio = static_cast<double>(sum_garbage_blob_bytes) /
+                                 static_cast<double>(sum_total_blob_bytes);
+    if (garbage_ratio > best_garbage_ratio) {
+      best_count = count;
+      best_total_blob_bytes = sum_total_blob_bytes;
+      best_garbage_blob_bytes = sum_garbage_blob_bytes;
+      best_garbage_ratio = garbage_ratio;
     }
   }
 
-  if (sum_garbage_blob_bytes <
-      blob_garbage_collection_force_threshold * sum_total_blob_bytes) {
+  if (!best_count ||
+      best_garbage_blob_bytes <
+          blob_garbage_collection_force_threshold * best_total_blob_bytes) {
     return;
   }
 
-  for (uint64_t sst_file_number : linked_ssts) {
-    const FileLocation location = GetFileLocation(sst_file_number);
-    assert(location.IsValid());
+  for (size_t pos = 0; pos < best_count; ++pos) {
+    const auto& meta = blob_files_[pos];
+    assert(meta);
+
+    for (uint64_t sst_file_number : meta->GetLinkedSsts()) {
+      const FileLocation location = GetFileLocation(sst_file_number);
+      assert(location.IsValid());
 
-    const int level = location.GetLevel();
-    assert(level >= 0);
+      const int level = location.GetLevel();
+      assert(level >= 0);
 
-    const size_t pos = location.GetPosition();
+      FileMetaData* const sst_meta = files_[level][location.GetPosition()];
+      assert(sst_meta);
 
-    FileMetaData* const sst_meta = files_[level][pos];
-    assert(sst_meta);
+      if (sst_meta->being_compacted) {
+        continue;
+      }
 
-    if (sst_meta->being_compacted) {
-      continue;
+      files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
     }
-
-    files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
   }
 }
 
@@ -3345,6 +3461,136 @@ void VersionStorageInfo::GenerateLevel0NonOverlapping() {
   }
 }
 
+void VersionStorageInfo::GenerateLevel0SortedRuns() {
+  assert(!finalized_);
+  l0_sorted_runs_.clear();
+  if (level_files_brief_.size() == 0) {
+    return;
+  }
+  // Group L0 files, newest to oldest, into consecutive sorted runs: each run
+  // is a maximal stretch of files whose user key ranges do not overlap, kept
+  // sorted by smallest key. A point lookup can then binary search each run
+  // for the one file that may cover the key instead of range-checking every
+  // L0 file. Runs must be consecutive in age order so that visiting them
+  // front to back preserves the newest-to-oldest order Get relies on.
+  //
+  // Overlap here is judged on user keys, strictly: two files whose
+  // boundaries share a user key (differing only in sequence) both land as
+  // lookup candidates, in separate runs.
+  const ROCKSDB_NAMESPACE::LevelFilesBrief& brief = level_files_brief_[0];
+  for (size_t i = 0; i < brief.num_files; ++i) {
+    const FdWithKeyRange& f = brief.files[i];
+    const Slice f_smallest = ExtractUserKey(f.smallest_key);
+    const Slice f_largest = ExtractUserKey(f.largest_key);
+    bool added = false;
+    if (!l0_sorted_runs_.empty()) {
+      std::vector<int>& run = l0_sorted_runs_.back();
+      // Position of the first file in the run whose smallest key is not
+      // less than f's.
+      size_t pos = run.size();
+      size_t lo = 0;
+      size_t hi = run.size();
+      while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (user_comparator_->CompareWithoutTimestamp(
+                ExtractUserKey(brief.files[run[mid]].smallest_key),
+                f_smallest) < 0) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      pos = lo;
+      const bool overlaps_prev =
+          pos > 0 && user_comparator_->CompareWithoutTimestamp(
+                         ExtractUserKey(brief.files[run[pos - 1]].largest_key),
+                         f_smallest) >= 0;
+      const bool overlaps_next =
+          pos < run.size() &&
+          user_comparator_->CompareWithoutTimestamp(
+              f_largest,
+              ExtractUserKey(brief.files[run[pos]].smallest_key)) >= 0;
+      if (!overlaps_prev && !overlaps_next) {
+        run.insert(run.begin() + pos, static_cast<int>(i));
+        added = true;
+      }
+    }
+    if (!added) {
+      l0_sorted_runs_.emplace_back(1, static_cast<int>(i));
+    }
+  }
+}
+
+void VersionStorageInfo::GenerateLevel0OverlapIndex() {
+  assert(!finalized_);
+  l0_files_by_smallest_.clear();
+  l0_largest_key_tree_.clear();
+  if (level_files_brief_.size() == 0) {
+    return;
+  }
+  const size_t num_files = level_files_brief_[0].num_files;
+  if (num_files == 0) {
+    return;
+  }
+  l0_files_by_smallest_.resize(num_files);
+  for (size_t i = 0; i < num_files; ++i) {
+    l0_files_by_smallest_[i] = i;
+  }
+  const FdWithKeyRange* files = level_files_brief_[0].files;
+  std::sort(l0_files_by_smallest_.begin(), l0_files_by_smallest_.end(),
+            [this, files](size_t a, size_t b) -> bool {
+              return internal_comparator_->Compare(files[a].smallest_key,
+                                                   files[b].smallest_key) < 0;
+            });
+  l0_largest_key_tree_.resize(4 * num_files);
+  BuildL0LargestKeyTree(0, 0, num_files - 1);
+}
+
+void VersionStorageInfo::BuildL0LargestKeyTree(size_t node, size_t lo,
+                                               size_t hi) {
+  if (lo == hi) {
+    l0_largest_key_tree_[node] = l0_files_by_smallest_[lo];
+    return;
+  }
+  const size_t mid = (lo + hi) / 2;
+  BuildL0LargestKeyTree(2 * node + 1, lo, mid);
+  BuildL0LargestKeyTree(2 * node + 2, mid + 1, hi);
+  const FdWithKeyRange* files = level_files_brief_[0].files;
+  const size_t left = l0_largest_key_tree_[2 * node + 1];
+  const size_t right = l0_largest_key_tree_[2 * node + 2];
+  l0_largest_key_tree_[node] =
+      user_comparator_->CompareWithoutTimestamp(
+          ExtractUserKey(files[left].largest_key),
+          ExtractUserKey(files[right].largest_key)) < 0
+          ? right
+          : left;
+}
+
+void VersionStorageInfo::CollectL0OverlapsInTree(
+    size_t node, size_t lo, size_t hi, size_t max_pos, const Slice* user_begin,
+    std::vector<size_t>* positions) const {
+  if (lo > max_pos) {
+    return;
+  }
+  const FdWithKeyRange* files = level_files_brief_[0].files;
+  if (user_begin != nullptr &&
+      user_comparator_->CompareWithoutTimestamp(
+          ExtractUserKey(files[l0_largest_key_tree_[node]].largest_key),
+          *user_begin) < 0) {
+    // Every file in this subtree ends before the queried range.
+    return;
+  }
+  if (lo == hi) {
+    positions->push_back(l0_files_by_smallest_[lo]);
+    return;
+  }
+  const size_t mid = (lo + hi) / 2;
+  CollectL0OverlapsInTree(2 * node + 1, lo, mid, max_pos, user_begin,
+                          positions);
+  CollectL0OverlapsInTree(2 * node + 2, mid + 1, hi, max_pos, user_begin,
+                          positions);
+}
+
 void VersionStorageInfo::GenerateBottommostFiles() {
   assert(!finalized_);
   assert(bottommost_files_.empty());
@@ -3392,6 +3638,76 @@ void VersionStorageInfo::GenerateFileLocationIndex() {
   }
 }
 
+void VersionStorageInfo::GenerateSizeSketch() {
+  assert(size_sketch_by_largest_.empty());
+  assert(size_sketch_by_smallest_.empty());
+
+  size_t num_files = 0;
+  for (int level = 0; level < num_levels_; ++level) {
+    num_files += files_[level].size();
+  }
+  size_sketch_by_largest_.reserve(num_files);
+  size_sketch_by_smallest_.reserve(num_files);
+
+  for (int level = 0; level < num_levels_; ++level) {
+    for (const FileMetaData* meta : files_[level]) {
+      const uint64_t file_size = meta->fd.GetFileSize();
+      size_sketch_by_largest_.emplace_back(meta->largest.Encode().ToString(),
+                                           file_size);
+      size_sketch_by_smallest_.emplace_back(meta->smallest.Encode().ToString(),
+                                            file_size);
+    }
+  }
+
+  auto cmp = [this](const std::pair<std::string, uint64_t>& a,
+                    const std::pair<std::string, uint64_t>& b) {
+    return internal_comparator_->Compare(a.first, b.first) < 0;
+  };
+  std::sort(size_sketch_by_largest_.begin(), size_sketch_by_largest_.end(),
+            cmp);
+  std::sort(size_sketch_by_smallest_.begin(), size_sketch_by_smallest_.end(),
+            cmp);
+
+  // Turn the per-file sizes into cumulative sums so a query is a binary
+  // search plus a subtraction.
+  uint64_t cumulative = 0;
+  for (auto& entry : size_sketch_by_largest_) {
+    cumulative += entry.second;
+    entry.second = cumulative;
+  }
+  cumulative = 0;
+  for (auto& entry : size_sketch_by_smallest_) {
+    cumulative += entry.second;
+    entry.second = cumulative;
+  }
+}
+
+uint64_t VersionStorageInfo::ApproximateSizeFromSketch(
+    const Slice& start, const Slice& end) const {
+  // Cumulative bytes of the sketch entries with a key <= `key`.
+  auto cum_at =
+      [this](const std::vector<std::pair<std::string, uint64_t>>& sketch,
+             const Slice& key) -> uint64_t {
+    auto it = std::upper_bound(
+        sketch.begin(), sketch.end(), key,
+        [this](const Slice& k, const std::pair<std::string, uint64_t>& entry) {
+          return internal_comparator_->Compare(k, Slice(entry.first)) < 0;
+        });
+    return it == sketch.begin() ? 0 : std::prev(it)->second;
+  };
+  // Bytes estimated to lie at or before `key`: all of every file whose
+  // largest key is <= key, plus half of every file straddling key.
+  auto bytes_before = [&](const Slice& key) -> uint64_t {
+    const uint64_t full_files = cum_at(size_sketch_by_largest_, key);
+    const uint64_t started_files = cum_at(size_sketch_by_smallest_, key);
+    assert(started_files >= full_files);
+    return full_files + (started_files - full_files) / 2;
+  };
+  const uint64_t end_bytes = bytes_before(end);
+  const uint64_t start_bytes = bytes_before(start);
+  return end_bytes > start_bytes ? end_bytes - start_bytes : 0;
+}
+
 void VersionStorageInfo::UpdateOldestSnapshot(SequenceNumber seqnum) {
   assert(seqnum >= oldest_snapshot_seqnum_);
   oldest_snapshot_seqnum_ = seqnum;
@@ -3476,6 +3792,12 @@ void VersionStorageInfo::GetOverlappingInputs(
     *next_smallest = nullptr;
   }
 
+  const size_t num_files = level_files_brief_[level].num_files;
+  if (num_files == 0) {
+    return;
+  }
+  assert(l0_files_by_smallest_.size() == num_files);
+
   Slice user_begin, user_end;
   if (begin != nullptr) {
     user_begin = begin->user_key();
@@ -3484,52 +3806,64 @@ void VersionStorageInfo::GetOverlappingInputs(
     user_end = end->user_key();
   }
 
-  // index stores the file index need to check.
-  std::list<size_t> index;
-  for (size_t i = 0; i < level_files_brief_[level].num_files; i++) {
-    index.emplace_back(i);
-  }
-
-  while (!index.empty()) {
-    bool found_overlapping_file = false;
-    auto iter = index.begin();
-    while (iter != index.end()) {
-      FdWithKeyRange* f = &(level_files_brief_[level].files[*iter]);
-      const Slice file_start = ExtractUserKey(f->smallest_key);
-      const Slice file_limit = ExtractUserKey(f->largest_key);
-      if (begin != nullptr &&
-          user_cmp->CompareWithoutTimestamp(file_limit, user_begin) < 0) {
-        // "f" is completely before specified range; skip it
-        iter++;
-      } else if (end != nullptr &&
-                 user_cmp->CompareWithoutTimestamp(file_start, user_end) > 0) {
-        // "f" is completely after specified range; skip it
-        iter++;
-      } else {
-        // if overlap
-        inputs->emplace_back(files_[level][*iter]);
-        found_overlapping_file = true;
-        // record the first file index.
-        if (file_index && *file_index == -1) {
-          *file_index = static_cast<int>(*iter);
+  const FdWithKeyRange* files = level_files_brief_[level].files;
+  // Query the L0 overlap index: files whose smallest key sorts after
+  // user_end cannot overlap, so binary search for the last candidate
+  // position in smallest-key order, then descend the max-largest-key tree
+  // to enumerate the candidates whose largest key reaches user_begin.
+  // With expand_range, repeat the query whenever an overlapping file
+  // widened the range; every pass adds at least one file, so there are at
+  // most O(k) passes for k overlapping files.
+  std::vector<bool> added(num_files, false);
+  std::vector<size_t> found;
+  bool range_changed = true;
+  while (range_changed) {
+    range_changed = false;
+    size_t max_pos = num_files - 1;
+    if (end != nullptr) {
+      // First position in smallest-key order whose file starts after
+      // user_end; every position before it is a candidate.
+      const auto it = std::upper_bound(
+          l0_files_by_smallest_.begin(), l0_files_by_smallest_.end(), user_end,
+          [this, files](const Slice& key, size_t pos) -> bool {
+            return user_comparator_->CompareWithoutTimestamp(
+                       key, ExtractUserKey(files[pos].smallest_key)) < 0;
+          });
+      if (it == l0_files_by_smallest_.begin()) {
+        break;
+      }
+      max_pos = static_cast<size_t>(it - l0_files_by_smallest_.begin()) - 1;
+    }
+    found.clear();
+    CollectL0OverlapsInTree(0, 0, num_files - 1, max_pos,
+                            begin != nullptr ? &user_begin : nullptr, &found);
+    for (const size_t i : found) {
+      if (added[i]) {
+        continue;
+      }
+      added[i] = true;
+      if (expand_range) {
+        const Slice file_start = ExtractUserKey(files[i].smallest_key);
+        const Slice file_limit = ExtractUserKey(files[i].largest_key);
+        if (begin != nullptr &&
+            user_cmp->CompareWithoutTimestamp(file_start, user_begin) < 0) {
+          user_begin = file_start;
+          range_changed = true;
         }
-        // the related file is overlap, erase to avoid checking again.
-        iter = index.erase(iter);
-        if (expand_range) {
-          if (begin != nullptr &&
-              user_cmp->CompareWithoutTimestamp(file_start, user_begin) < 0) {
-            user_begin = file_start;
-          }
-          if (end != nullptr &&
-              user_cmp->CompareWithoutTimestamp(file_limit, user_end) > 0) {
-            user_end = file_limit;
-          }
+        if (end != nullptr &&
+            user_cmp->CompareWithoutTimestamp(file_limit, user_end) > 0) {
+          user_end = file_limit;
+          range_changed = true;
         }
       }
     }
-    // if all the files left are not overlap, break
-    if (!found_overlapping_file) {
-      break;
+  }
+  for (size_t i = 0; i < num_files; i++) {
+    if (added[i]) {
+      inputs->emplace_back(files_[level][i]);
+      if (file_index && *file_index == -1) {
+        *file_index = static_cast<int>(i);
+      }
     }
   }
 }
@@ -4473,7 +4807,7 @@ Status VersionSet::ProcessManifestWrites(
                builder_guards.size() == versions.size());
         ColumnFamilyData* cfd = versions[i]->cfd_;
         s = builder_guards[i]->version_builder()->LoadTableHandlers(
-            cfd->internal_stats(), 1 /* max_threads */,
+            cfd->internal_stats(), db_options_->max_file_opening_threads,
             true /* prefetch_index_and_filter_in_cache */,
             false /* is_initial_load */,
             mutable_cf_options_ptrs[i]->prefix_extractor,
@@ -5630,6 +5964,15 @@ uint64_t VersionSet::ApproximateSize(const SizeApproximationOptions& options,
 
   assert(start_level <= end_level);
 
+  if (options.use_size_sketch && start_level == 0 &&
+      end_level == num_non_empty_levels) {
+    // Serve the query from the sketch built at version install; no table
+    // readers are opened and no index blocks are read. The sketch covers
+    // all levels, so level-restricted queries fall through to the precise
+    // path below.
+    return vstorage->ApproximateSizeFromSketch(start, end);
+  }
+
   // Outline of the optimization that uses options.files_size_error_margin.
   // When approximating the files total size that is used to store a keys range,
   // we first sum up the sizes of the files that fully fall into the range.
@@ -198,12 +198,24 @@ class VersionStorageInfo {
   void ComputeExpiredTtlFiles(const ImmutableOptions& ioptions,
                               const uint64_t ttl);
 
+  // This computes bottommost_expired_ttl_files_ and is called by
+  // ComputeCompactionScore()
+  void ComputeBottommostExpiredTtlFiles(const ImmutableOptions& ioptions,
+                                        const uint64_t ttl);
+
   // This computes files_marked_for_periodic_compaction_ and is called by
   // ComputeCompactionScore()
   void ComputeFilesMarkedForPeriodicCompaction(
       const ImmutableOptions& ioptions,
       const uint64_t periodic_compaction_seconds);
 
+  // This computes files_marked_for_temperature_change_ and is called by
+  // ComputeCompactionScore(). It also advances the per-file read-aging
+  // state (see FileMetaData::last_read_observed_time).
+  void ComputeFilesMarkedForTemperatureChange(
+      const ImmutableOptions& ioptions, const uint64_t cold_file_age_seconds,
+      const Temperature cold_file_temperature);
+
   // This computes bottommost_files_marked_for_compaction_ and is called by
   // ComputeCompactionScore() or UpdateOldestSnapshot().
   //
@@ -228,6 +240,12 @@ class VersionStorageInfo {
     return level0_non_overlapping_;
   }
 
+  // L0 file positions (into LevelFilesBrief) grouped into age-consecutive
+  // sorted runs; see GenerateLevel0SortedRuns().
+  const std::vector<std::vector<int>>& level0_sorted_runs() const {
+    return l0_sorted_runs_;
+  }
+
   // Updates the oldest snapshot and related internal state, like the bottommost
   // files marked for compaction.
   // REQUIRES: DB mutex held
@@ -443,6 +461,14 @@ class VersionStorageInfo {
     return expired_ttl_files_;
   }
 
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>& BottommostExpiredTtlFiles()
+      const {
+    assert(finalized_);
+    return bottommost_expired_ttl_files_;
+  }
+
   // REQUIRES: ComputeCompactionScore has been called
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>&
@@ -455,6 +481,14 @@ class VersionStorageInfo {
     files_marked_for_periodic_compaction_.emplace_back(level, f);
   }
 
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForTemperatureChange() const {
+    assert(finalized_);
+    return files_marked_for_temperature_change_;
+  }
+
   // REQUIRES: ComputeCompactionScore has been called
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>&
@@ -551,6 +585,14 @@ class VersionStorageInfo {
   // Returns an estimate of the amount of live data in bytes.
   uint64_t EstimateLiveDataSize() const;
 
+  // Answers an approximate-size query for the internal key range
+  // [start, end) from the size sketch built by GenerateSizeSketch(),
+  // without opening any table reader. Files straddling a range boundary
+  // are counted as half inside, so the error is bounded by half the total
+  // size of the straddling files.
+  uint64_t ApproximateSizeFromSketch(const Slice& start,
+                                     const Slice& end) const;
+
   uint64_t estimated_compaction_needed_bytes() const {
     return estimated_compaction_needed_bytes_;
   }
@@ -589,8 +631,21 @@ class VersionStorageInfo {
 
   void GenerateLevelFilesBrief();
   void GenerateLevel0NonOverlapping();
+  void GenerateLevel0SortedRuns();
+  void GenerateLevel0OverlapIndex();
+  // Recursively builds the max-largest-key tree node covering the sorted
+  // positions [lo, hi] of l0_files_by_smallest_.
+  void BuildL0LargestKeyTree(size_t node, size_t lo, size_t hi);
+  // Appends to `positions` the L0 file positions among the sorted positions
+  // [lo, hi] (capped at max_pos) whose largest user key is not less than
+  // *user_begin, pruning subtrees via the max-largest-key tree. A null
+  // user_begin matches every file.
+  void CollectL0OverlapsInTree(size_t node, size_t lo, size_t hi,
+                               size_t max_pos, const Slice* user_begin,
+                               std::vector<size_t>* positions) const;
   void GenerateBottommostFiles();
   void GenerateFileLocationIndex();
+  void GenerateSizeSketch();
 
   const InternalKeyComparator* internal_comparator_;
   const Comparator* user_comparator_;
@@ -634,6 +689,21 @@ class VersionStorageInfo {
   // If true, means that files in L0 have keys with non overlapping ranges
   bool level0_non_overlapping_;
 
+  // L0 files grouped, newest to oldest, into consecutive runs whose user key
+  // ranges do not overlap within a run. Each inner vector holds positions
+  // into level_files_brief_[0].files sorted by smallest key. Point lookups
+  // binary search each run instead of range-checking every L0 file.
+  std::vector<std::vector<int>> l0_sorted_runs_;
+
+  // Overlap index over L0, rebuilt per version: positions into
+  // level_files_brief_[0].files sorted by smallest key, plus a segment tree
+  // over that ordering whose nodes store the position of the file with the
+  // largest `largest_key` in their range. GetOverlappingInputs() descends
+  // the tree to enumerate the L0 files overlapping a key range in
+  // O(log n + k) instead of scanning the whole level under the DB mutex.
+  std::vector<size_t> l0_files_by_smallest_;
+  std::vector<size_t> l0_largest_key_tree_;
+
   // An index into files_by_compaction_pri_ that specifies the first
   // file that is not yet compacted
   std::vector<int> next_file_to_compact_by_size_;
@@ -652,9 +722,18 @@ class VersionStorageInfo {
 
   autovector<std::pair<int, FileMetaData*>> expired_ttl_files_;
 
+  // Bottommost files whose entries are all older than the configured TTL,
+  // eligible to be dropped without a rewrite. Only populated when
+  // ttl_delete_expired_files is set. Protected by DB mutex. It is
+  // calculated in ComputeCompactionScore()
+  autovector<std::pair<int, FileMetaData*>> bottommost_expired_ttl_files_;
+
   autovector<std::pair<int, FileMetaData*>>
       files_marked_for_periodic_compaction_;
 
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_temperature_change_;
+
   // These files are considered bottommost because none of their keys can exist
   // at lower levels. They are not necessarily all in the same level. The marked
   // ones are eligible for compaction because they contain duplicate key
@@ -667,6 +746,15 @@ class VersionStorageInfo {
 
   autovector<std::pair<int, FileMetaData*>> files_marked_for_forced_blob_gc_;
 
+  // Cumulative key -> bytes histograms over all files in the version,
+  // built by GenerateSizeSketch() at version install and immutable
+  // afterwards. Entries are (internal key, cumulative file bytes) sorted
+  // by key; size_sketch_by_largest_ accumulates each file's size at its
+  // largest key, size_sketch_by_smallest_ at its smallest key. Together
+  // they answer ApproximateSizeFromSketch() with two binary searches.
+  std::vector<std::pair<std::string, uint64_t>> size_sketch_by_largest_;
+  std::vector<std::pair<std::string, uint64_t>> size_sketch_by_smallest_;
+
   // Threshold for needing to mark another bottommost file. Maintain it so we
   // can quickly check when releasing a snapshot whether more bottommost files
   // became eligible for compaction. It's defined as the min of the max nonzero
@@ -843,8 +931,9 @@ class Version {
            SequenceNumber* seq = nullptr, ReadCallback* callback = nullptr,
            bool* is_blob = nullptr, bool do_merge = true);
 
-  void MultiGet(const ReadOptions&, MultiGetRange* range,
-                ReadCallback* callback = nullptr);
+  DECLARE_SYNC_AND_ASYNC(void, MultiGet, const ReadOptions&,
+                         MultiGetRange* range,
+                         ReadCallback* callback = nullptr);
 
   // Interprets blob_index_slice as a blob reference, and (assuming the
   // corresponding blob file is part of this Version) retrieves the blob and
@@ -956,6 +1045,13 @@ class Version {
 
   Status VerifySstUniqueIds() const;
 
+  // Best-effort creation of table readers for the files at `level` that have
+  // not been opened yet, so that later reads hit the table cache instead of
+  // opening the file. Used by the background warmer started when
+  // lazy_open_table_files is set; stops early once `abort` becomes true.
+  // Errors are ignored and will resurface on the first read of the file.
+  void WarmTableCacheAtLevel(int level, const std::atomic<bool>& abort);
+
  private:
   Env* env_;
   SystemClock* clock_;
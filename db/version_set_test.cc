@@ -512,6 +512,32 @@ TEST_F(VersionStorageInfoTest, GetOverlappingInputs) {
       1, {"i", 0, kTypeValue}, {"j", 0, kTypeValue}));
 }
 
+TEST_F(VersionStorageInfoTest, GetOverlappingInputsLevel0) {
+  // Level 0 files may overlap each other arbitrarily, and overlap queries
+  // expand the range transitively across overlapping files.
+  Add(0, 1U, {"a", 0, kTypeValue}, {"c", 0, kTypeValue}, 1);
+  Add(0, 2U, {"b", 0, kTypeValue}, {"d", 0, kTypeValue}, 1);
+  Add(0, 3U, {"e", 0, kTypeValue}, {"g", 0, kTypeValue}, 1);
+  Add(0, 4U, {"f", 0, kTypeValue}, {"j", 0, kTypeValue}, 1);
+  Add(0, 5U, {"l", 0, kTypeValue}, {"m", 0, kTypeValue}, 1);
+
+  UpdateVersionStorageInfo();
+
+  // [a, a] hits file 1, whose range pulls in file 2.
+  ASSERT_EQ("1,2", GetOverlappingFiles(
+      0, {"a", 0, kTypeValue}, {"a", 0, kTypeValue}));
+  // [h, i] hits only file 4, whose range pulls in file 3.
+  ASSERT_EQ("3,4", GetOverlappingFiles(
+      0, {"h", 0, kTypeValue}, {"i", 0, kTypeValue}));
+  // [k, k] falls in the gap between files 4 and 5.
+  ASSERT_EQ("", GetOverlappingFiles(
+      0, {"k", 0, kTypeValue}, {"k", 0, kTypeValue}));
+  ASSERT_EQ("5", GetOverlappingFiles(
+      0, {"m", 0, kTypeValue}, {"z", 0, kTypeValue}));
+  ASSERT_EQ("1,2,3,4,5", GetOverlappingFiles(
+      0, {"a", 0, kTypeValue}, {"z", 0, kTypeValue}));
+}
+
 TEST_F(VersionStorageInfoTest, FileLocationAndMetaDataByNumber) {
   Add(0, 11U, "1", "2", 5000U);
   Add(0, 12U, "1", "2", 5000U);
@@ -868,6 +894,133 @@ TEST_F(VersionStorageInfoTest, ForcedBlobGCMultipleBatches) {
   }
 }
 
+TEST_F(VersionStorageInfoTest, ForcedBlobGCHighGarbageNewerBatch) {
+  // Test that a mostly-live oldest batch of blob files does not hold up the
+  // collection of a high-garbage newer batch. We have two L0 SSTs (1 and 2)
+  // and three blob files (10, 11, and 12). SST 1 keeps blob files 10 and 11
+  // alive, so they form the oldest batch, which has hardly any garbage; blob
+  // file 12, which is linked to SST 2 and forms the second batch, consists
+  // mostly of garbage.
+
+  constexpr int level = 0;
+
+  constexpr uint64_t first_sst = 1;
+  constexpr uint64_t second_sst = 2;
+
+  constexpr uint64_t first_blob = 10;
+  constexpr uint64_t second_blob = 11;
+  constexpr uint64_t third_blob = 12;
+
+  {
+    constexpr char smallest[] = "bar1";
+    constexpr char largest[] = "foo1";
+    constexpr uint64_t file_size = 1000;
+
+    Add(level, first_sst, smallest, largest, file_size, first_blob);
+  }
+
+  {
+    constexpr char smallest[] = "bar2";
+    constexpr char largest[] = "foo2";
+    constexpr uint64_t file_size = 2000;
+
+    Add(level, second_sst, smallest, largest, file_size, third_blob);
+  }
+
+  {
+    constexpr uint64_t total_blob_count = 10;
+    constexpr uint64_t total_blob_bytes = 100000;
+    constexpr uint64_t garbage_blob_count = 1;
+    constexpr uint64_t garbage_blob_bytes = 5000;
+
+    AddBlob(first_blob, total_blob_count, total_blob_bytes,
+            BlobFileMetaData::LinkedSsts{first_sst}, garbage_blob_count,
+            garbage_blob_bytes);
+  }
+
+  {
+    constexpr uint64_t total_blob_count = 10;
+    constexpr uint64_t total_blob_bytes = 100000;
+    constexpr uint64_t garbage_blob_count = 1;
+    constexpr uint64_t garbage_blob_bytes = 5000;
+
+    AddBlob(second_blob, total_blob_count, total_blob_bytes,
+            BlobFileMetaData::LinkedSsts{}, garbage_blob_count,
+            garbage_blob_bytes);
+  }
+
+  {
+    constexpr uint64_t total_blob_count = 20;
+    constexpr uint64_t total_blob_bytes = 200000;
+    constexpr uint64_t garbage_blob_count = 18;
+    constexpr uint64_t garbage_blob_bytes = 180000;
+
+    AddBlob(third_blob, total_blob_count, total_blob_bytes,
+            BlobFileMetaData::LinkedSsts{second_sst}, garbage_blob_count,
+            garbage_blob_bytes);
+  }
+
+  UpdateVersionStorageInfo();
+
+  assert(vstorage_.num_levels() > 0);
+  const auto& level_files = vstorage_.LevelFiles(level);
+
+  assert(level_files.size() == 2);
+  assert(level_files[0] && level_files[0]->fd.GetNumber() == first_sst);
+  assert(level_files[1] && level_files[1]->fd.GetNumber() == second_sst);
+
+  // The second batch is ineligible due to the age cutoff, and the garbage
+  // ratio of the oldest batch alone is below the threshold
+
+  {
+    constexpr double age_cutoff = 2.0 / 3.0;
+    constexpr double force_threshold = 0.3;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  }
+
+  // Both batches are eligible based on age cutoff but even the garbage ratio
+  // of the best prefix (both batches combined, 190000 / 400000 = 0.475) is
+  // below the threshold
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.5;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  }
+
+  // Both batches are eligible based on age cutoff; the oldest batch alone
+  // does not meet the threshold but the two batches combined do, so both
+  // linked SSTs get marked
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.3;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold);
+
+    auto ssts_to_be_compacted = vstorage_.FilesMarkedForForcedBlobGC();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 2);
+
+    std::sort(ssts_to_be_compacted.begin(), ssts_to_be_compacted.end(),
+              [](const std::pair<int, FileMetaData*>& lhs,
+                 const std::pair<int, FileMetaData*>& rhs) {
+                assert(lhs.second);
+                assert(rhs.second);
+                return lhs.second->fd.GetNumber() < rhs.second->fd.GetNumber();
+              });
+
+    const autovector<std::pair<int, FileMetaData*>>
+        expected_ssts_to_be_compacted{{level, level_files[0]},
+                                      {level, level_files[1]}};
+
+    ASSERT_EQ(ssts_to_be_compacted[0], expected_ssts_to_be_compacted[0]);
+    ASSERT_EQ(ssts_to_be_compacted[1], expected_ssts_to_be_compacted[1]);
+  }
+}
+
 class VersionStorageInfoTimestampTest : public VersionStorageInfoTestBase {
  public:
   VersionStorageInfoTimestampTest()
@@ -3429,6 +3582,50 @@ TEST_F(VersionSetTestMissingFiles, NoFileMissing) {
   }
 }
 
+TEST_F(VersionSetTestMissingFiles, ParallelManifestReplay) {
+  db_options_.max_manifest_recovery_threads = 4;
+  std::vector<SstInfo> existing_files = {
+      SstInfo(100, kDefaultColumnFamilyName, "a"),
+      SstInfo(101, kDefaultColumnFamilyName, "b"),
+      SstInfo(102, kDefaultColumnFamilyName, "c"),
+      SstInfo(103, kColumnFamilyName1, "a"),
+      SstInfo(104, kColumnFamilyName1, "b"),
+      SstInfo(105, kColumnFamilyName2, "a"),
+      SstInfo(106, kColumnFamilyName2, "b"),
+      SstInfo(107, kColumnFamilyName3, "a"),
+      SstInfo(108, kColumnFamilyName3, "b")};
+  std::vector<FileMetaData> file_metas;
+  CreateDummyTableFiles(existing_files, &file_metas);
+
+  PrepareManifest(&column_families_, &last_seqno_, &log_writer_);
+  // One edit per file so replay has multiple edits to apply per column
+  // family, then delete a file from the default column family to verify
+  // that edits are applied in MANIFEST order within each column family.
+  const uint32_t cf_of_file[] = {0, 0, 0, 1, 1, 2, 2, 3, 3};
+  for (size_t i = 0; i < file_metas.size(); ++i) {
+    std::vector<std::pair<int, FileMetaData>> added_files;
+    added_files.emplace_back(0, file_metas[i]);
+    WriteFileAdditionAndDeletionToManifest(
+        cf_of_file[i], added_files, std::vector<std::pair<int, uint64_t>>());
+  }
+  std::vector<std::pair<int, uint64_t>> deleted_files;
+  deleted_files.emplace_back(/*level=*/0, 100);
+  WriteFileAdditionAndDeletionToManifest(
+      /*cf=*/0, std::vector<std::pair<int, FileMetaData>>(), deleted_files);
+  log_writer_.reset();
+  Status s = SetCurrentFile(fs_.get(), dbname_, 1, nullptr);
+  ASSERT_OK(s);
+  ASSERT_OK(versions_->Recover(column_families_, /*read_only=*/false));
+  for (ColumnFamilyData* cfd : *(versions_->GetColumnFamilySet())) {
+    VersionStorageInfo* vstorage = cfd->current()->storage_info();
+    const std::vector<FileMetaData*>& files = vstorage->LevelFiles(0);
+    ASSERT_EQ(2, files.size());
+    for (const auto* fmeta : files) {
+      ASSERT_NE(100, fmeta->fd.GetNumber());
+    }
+  }
+}
+
 TEST_F(VersionSetTestMissingFiles, MinLogNumberToKeep2PC) {
   db_options_.allow_2pc = true;
   NewDB();
@@ -486,6 +486,7 @@ Status WalManager::ReadFirstLine(const std::string& fname,
   reporter.ignore_error = !db_options_.paranoid_checks;
   log::Reader reader(db_options_.info_log, std::move(file_reader), &reporter,
                      true /*checksum*/, number);
+  reader.SetCompressionDictionary(db_options_.wal_compression_dict);
   std::string scratch;
   Slice record;
 
@@ -15,37 +15,126 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-Status WideColumnSerialization::Serialize(const WideColumns& columns,
-                                          std::string& output) {
+namespace {
+
+// Checks shared by Serialize and SerializeIndexed.
+Status ValidateColumns(const WideColumns& columns) {
   if (columns.size() >
       static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
     return Status::InvalidArgument("Too many wide columns");
   }
 
-  PutVarint32(&output, kCurrentVersion);
-
-  PutVarint32(&output, static_cast<uint32_t>(columns.size()));
-
   for (size_t i = 0; i < columns.size(); ++i) {
     const WideColumn& column = columns[i];
 
-    const Slice& name = column.name();
-    if (name.size() >
+    if (column.name().size() >
         static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
       return Status::InvalidArgument("Wide column name too long");
     }
-    if (i > 0 && columns[i - 1].name().compare(name) >= 0) {
+    if (i > 0 && columns[i - 1].name().compare(column.name()) >= 0) {
       return Status::Corruption("Wide columns out of order");
     }
 
-    const Slice& value = column.value();
-    if (value.size() >
+    if (column.value().size() >
         static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
       return Status::InvalidArgument("Wide column value too long");
     }
+  }
+
+  return Status::OK();
+}
+
+// Reads the parts of the header common to all versions and rejects
+// versions from the future.
+Status ReadHeader(Slice& input, uint32_t& version, uint32_t& num_columns) {
+  if (!GetVarint32(&input, &version)) {
+    return Status::Corruption("Error decoding wide column version");
+  }
+
+  if (version > WideColumnSerialization::kIndexedVersion) {
+    return Status::NotSupported("Unsupported wide column version");
+  }
+
+  if (!GetVarint32(&input, &num_columns)) {
+    return Status::Corruption("Error decoding number of wide columns");
+  }
+
+  return Status::OK();
+}
+
+// View of an entity in the indexed (version 2) format. The offset table
+// holds 2N+1 fixed32 entries relative to the first byte after the table:
+// the start of each name, the start of each value, and the end of the
+// last value. Since the names are stored back to back followed by the
+// values, the span of any name or value is delimited by two consecutive
+// table entries.
+struct IndexedEntityRef {
+  const char* table = nullptr;
+  const char* base = nullptr;
+  size_t payload_size = 0;
+  uint32_t num_columns = 0;
+
+  static size_t TableSize(uint32_t num_columns) {
+    return (2 * static_cast<size_t>(num_columns) + 1) * sizeof(uint32_t);
+  }
+
+  uint32_t Offset(size_t i) const {
+    return DecodeFixed32(table + i * sizeof(uint32_t));
+  }
+
+  // Extracts the byte range delimited by table entries i and i + 1.
+  // Returns false if the offsets are inverted or out of bounds.
+  bool GetSpan(size_t i, Slice* span) const {
+    const uint32_t begin = Offset(i);
+    const uint32_t end = Offset(i + 1);
+    if (end < begin || end > payload_size) {
+      return false;
+    }
+    *span = Slice(base + begin, end - begin);
+    return true;
+  }
+
+  bool GetName(size_t i, Slice* name) const { return GetSpan(i, name); }
+
+  bool GetValue(size_t i, Slice* value) const {
+    return GetSpan(num_columns + i, value);
+  }
+};
 
-    PutLengthPrefixedSlice(&output, name);
-    PutVarint32(&output, static_cast<uint32_t>(value.size()));
+// input is expected to point just past the header.
+Status OpenIndexed(const Slice& input, uint32_t num_columns,
+                   IndexedEntityRef* entity) {
+  assert(entity);
+
+  const size_t table_size = IndexedEntityRef::TableSize(num_columns);
+  if (input.size() < table_size) {
+    return Status::Corruption("Error decoding wide column offset table");
+  }
+
+  entity->table = input.data();
+  entity->base = input.data() + table_size;
+  entity->payload_size = input.size() - table_size;
+  entity->num_columns = num_columns;
+
+  return Status::OK();
+}
+
+}  // namespace
+
+Status WideColumnSerialization::Serialize(const WideColumns& columns,
+                                          std::string& output) {
+  const Status s = ValidateColumns(columns);
+  if (!s.ok()) {
+    return s;
+  }
+
+  PutVarint32(&output, kCurrentVersion);
+
+  PutVarint32(&output, static_cast<uint32_t>(columns.size()));
+
+  for (const auto& column : columns) {
+    PutLengthPrefixedSlice(&output, column.name());
+    PutVarint32(&output, static_cast<uint32_t>(column.value().size()));
   }
 
   for (const auto& column : columns) {
@@ -57,22 +146,65 @@ Status WideColumnSerialization::Serialize(const WideColumns& columns,
   return Status::OK();
 }
 
-Status WideColumnSerialization::Deserialize(Slice& input,
-                                            WideColumns& columns) {
-  assert(columns.empty());
+Status WideColumnSerialization::SerializeIndexed(const WideColumns& columns,
+                                                 std::string& output) {
+  const Status s = ValidateColumns(columns);
+  if (!s.ok()) {
+    return s;
+  }
 
-  uint32_t version = 0;
-  if (!GetVarint32(&input, &version)) {
-    return Status::Corruption("Error decoding wide column version");
+  PutVarint32(&output, kIndexedVersion);
+
+  PutVarint32(&output, static_cast<uint32_t>(columns.size()));
+
+  if (columns.empty()) {
+    return Status::OK();
   }
 
-  if (version > kCurrentVersion) {
-    return Status::NotSupported("Unsupported wide column version");
+  uint64_t total_size = 0;
+  for (const auto& column : columns) {
+    total_size += column.name().size() + column.value().size();
   }
+  if (total_size >
+      static_cast<uint64_t>(std::numeric_limits<uint32_t>::max())) {
+    return Status::InvalidArgument("Wide column entity too large");
+  }
+
+  uint64_t offset = 0;
+  for (const auto& column : columns) {
+    PutFixed32(&output, static_cast<uint32_t>(offset));
+    offset += column.name().size();
+  }
+  for (const auto& column : columns) {
+    PutFixed32(&output, static_cast<uint32_t>(offset));
+    offset += column.value().size();
+  }
+  PutFixed32(&output, static_cast<uint32_t>(offset));
+
+  for (const auto& column : columns) {
+    const Slice& name = column.name();
 
+    output.append(name.data(), name.size());
+  }
+
+  for (const auto& column : columns) {
+    const Slice& value = column.value();
+
+    output.append(value.data(), value.size());
+  }
+
+  return Status::OK();
+}
+
+Status WideColumnSerialization::Deserialize(Slice& input,
+                                            WideColumns& columns) {
+  assert(columns.empty());
+
+  uint32_t version = 0;
   uint32_t num_columns = 0;
-  if (!GetVarint32(&input, &num_columns)) {
-    return Status::Corruption("Error decoding number of wide columns");
+  const Status s = ReadHeader(input, version, num_columns);
+  if (!s.ok()) {
+    return s;
   }
 
   if (!num_columns) {
@@ -81,6 +213,30 @@ Status WideColumnSerialization::Deserialize(Slice& input,
 
   columns.reserve(num_columns);
 
+  if (version == kIndexedVersion) {
+    IndexedEntityRef entity;
+    const Status open_s = OpenIndexed(input, num_columns, &entity);
+    if (!open_s.ok()) {
+      return open_s;
+    }
+
+    for (uint32_t i = 0; i < num_columns; ++i) {
+      Slice name;
+      Slice value;
+      if (!entity.GetName(i, &name) || !entity.GetValue(i, &value)) {
+        return Status::Corruption("Error decoding wide column offset table");
+      }
+
+      if (!columns.empty() && columns.back().name().compare(name) >= 0) {
+        return Status::Corruption("Wide columns out of order");
+      }
+
+      columns.emplace_back(name, value);
+    }
+
+    return Status::OK();
+  }
+
   autovector<uint32_t, 16> column_value_sizes;
   column_value_sizes.reserve(num_columns);
 
@@ -122,6 +278,129 @@ Status WideColumnSerialization::Deserialize(Slice& input,
   return Status::OK();
 }
 
+Status WideColumnSerialization::GetColumn(const Slice& input,
+                                          const Slice& column_name,
+                                          WideColumn& column, bool* exists) {
+  assert(exists);
+  *exists = false;
+
+  Slice in(input);
+
+  uint32_t version = 0;
+  uint32_t num_columns = 0;
+  const Status s = ReadHeader(in, version, num_columns);
+  if (!s.ok()) {
+    return s;
+  }
+
+  if (!num_columns) {
+    return Status::OK();
+  }
+
+  if (version == kIndexedVersion) {
+    IndexedEntityRef entity;
+    const Status open_s = OpenIndexed(in, num_columns, &entity);
+    if (!open_s.ok()) {
+      return open_s;
+    }
+
+    // The names are sorted, so the offset table supports a binary search
+    // that only ever touches the names it compares against.
+    size_t lo = 0;
+    size_t hi = num_columns;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+
+      Slice name;
+      if (!entity.GetName(mid, &name)) {
+        return Status::Corruption("Error decoding wide column offset table");
+      }
+
+      const int cmp = name.compare(column_name);
+      if (cmp < 0) {
+        lo = mid + 1;
+      } else if (cmp > 0) {
+        hi = mid;
+      } else {
+        Slice value;
+        if (!entity.GetValue(mid, &value)) {
+          return Status::Corruption("Error decoding wide column offset table");
+        }
+        column = WideColumn(name, value);
+        *exists = true;
+        return Status::OK();
+      }
+    }
+
+    return Status::OK();
+  }
+
+  // Version 1: the value area only begins after the last index entry, so
+  // the index has to be walked to the end even once the column has been
+  // found. Still, the other columns are neither materialized nor copied.
+  bool found = false;
+  Slice found_name;
+  uint64_t value_offset = 0;
+  uint32_t found_value_size = 0;
+
+  uint64_t pos = 0;
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    Slice name;
+    if (!GetLengthPrefixedSlice(&in, &name)) {
+      return Status::Corruption("Error decoding wide column name");
+    }
+
+    uint32_t value_size = 0;
+    if (!GetVarint32(&in, &value_size)) {
+      return Status::Corruption("Error decoding wide column value size");
+    }
+
+    if (!found && name == column_name) {
+      found = true;
+      found_name = name;
+      value_offset = pos;
+      found_value_size = value_size;
+    }
+
+    pos += value_size;
+  }
+
+  if (!found) {
+    return Status::OK();
+  }
+
+  if (value_offset + found_value_size > in.size()) {
+    return Status::Corruption("Error decoding wide column value payload");
+  }
+
+  column =
+      WideColumn(found_name, Slice(in.data() + value_offset,
+                                   found_value_size));
+  *exists = true;
+
+  return Status::OK();
+}
+
+Status WideColumnSerialization::ProjectColumns(
+    const Slice& input, const std::vector<Slice>& column_names,
+    WideColumns& columns) {
+  for (const Slice& column_name : column_names) {
+    WideColumn column;
+    bool exists = false;
+
+    const Status s = GetColumn(input, column_name, column, &exists);
+    if (!s.ok()) {
+      return s;
+    }
+
+    if (exists) {
+      columns.emplace_back(column);
+    }
+  }
+
+  return Status::OK();
+}
+
 WideColumns::const_iterator WideColumnSerialization::Find(
     const WideColumns& columns, const Slice& column_name) {
   const auto it =
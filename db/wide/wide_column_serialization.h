@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/status.h"
@@ -40,16 +41,58 @@ class Slice;
 //          ...---+----------+-------+----------+-------+---...---+-------+
 //                | varint32 | bytes | varint32 | bytes |         | bytes |
 //          ...---+----------+-------+----------+-------+---...---+-------+
+//
+// The indexed variant (version 2) replaces the varint index with a
+// fixed-width offset table so that any column can be located with a binary
+// search and sliced out without decoding the others. The table holds
+// 2N+1 little-endian fixed32 offsets, all relative to the first byte after
+// the table: the start of each of the N (sorted) column names, the start
+// of each column value, and the end of the last value. Name i spans
+// [offset i, offset i+1) and value i spans [offset N+i, offset N+i+1),
+// which works out because the names are laid out back to back, followed
+// directly by the values.
+//
+//      +----------+--------------+------------------+-------+---...
+//      | version  | # of columns | 2N+1 offsets     | names | values
+//      +----------+--------------+------------------+-------+---...
+//      | varint32 |   varint32   | fixed32 each     | bytes | bytes
+//      +----------+--------------+------------------+-------+---...
 
 class WideColumnSerialization {
  public:
   static Status Serialize(const WideColumns& columns, std::string& output);
+
+  // Serializes in the indexed format (version 2), which makes GetColumn
+  // and ProjectColumns O(log number of columns) and allocation-free.
+  // Deserialize handles both formats transparently.
+  static Status SerializeIndexed(const WideColumns& columns,
+                                 std::string& output);
+
   static Status Deserialize(Slice& input, WideColumns& columns);
 
+  // Extracts a single column from a serialized entity without
+  // materializing the others. Sets *exists to whether the entity has the
+  // column; when it does, column's name and value point into input, so
+  // the underlying data must outlive them. With the indexed format only
+  // the names examined by the binary search are touched; with the
+  // original format the index is scanned but column values are neither
+  // decoded nor copied.
+  static Status GetColumn(const Slice& input, const Slice& column_name,
+                          WideColumn& column, bool* exists);
+
+  // Extracts the requested columns from a serialized entity, appending
+  // them to columns in the order requested. Column names not present in
+  // the entity are skipped. Like GetColumn, the result points into input
+  // and the columns that were not requested are not decoded.
+  static Status ProjectColumns(const Slice& input,
+                               const std::vector<Slice>& column_names,
+                               WideColumns& columns);
+
   static WideColumns::const_iterator Find(const WideColumns& columns,
                                           const Slice& column_name);
 
   static constexpr uint32_t kCurrentVersion = 1;
+  static constexpr uint32_t kIndexedVersion = 2;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -300,6 +300,125 @@ TEST(WideColumnSerializationTest, DeserializeColumnsOutOfOrder) {
   ASSERT_TRUE(std::strstr(s.getState(), "order"));
 }
 
+TEST(WideColumnSerializationTest, SerializeDeserializeIndexed) {
+  WideColumns columns{{"foo", "bar"}, {"hello", "world"}};
+  std::string output;
+
+  ASSERT_OK(WideColumnSerialization::SerializeIndexed(columns, output));
+
+  Slice input(output);
+  WideColumns deserialized_columns;
+
+  ASSERT_OK(WideColumnSerialization::Deserialize(input, deserialized_columns));
+  ASSERT_EQ(columns, deserialized_columns);
+}
+
+TEST(WideColumnSerializationTest, SerializeIndexedErrors) {
+  {
+    WideColumns columns{{"foo", "bar"}, {"foo", "baz"}};
+    std::string output;
+
+    ASSERT_TRUE(WideColumnSerialization::SerializeIndexed(columns, output)
+                    .IsCorruption());
+  }
+
+  {
+    WideColumns columns{{"hello", "world"}, {"foo", "bar"}};
+    std::string output;
+
+    ASSERT_TRUE(WideColumnSerialization::SerializeIndexed(columns, output)
+                    .IsCorruption());
+  }
+}
+
+TEST(WideColumnSerializationTest, GetColumn) {
+  WideColumns columns{
+      {"aardvark", "ant"}, {"foo", "bar"}, {"hello", "world"}};
+
+  // The projection APIs behave identically for both formats.
+  for (const bool indexed : {false, true}) {
+    std::string output;
+    if (indexed) {
+      ASSERT_OK(WideColumnSerialization::SerializeIndexed(columns, output));
+    } else {
+      ASSERT_OK(WideColumnSerialization::Serialize(columns, output));
+    }
+
+    const Slice input(output);
+
+    for (const WideColumn& expected : columns) {
+      WideColumn column;
+      bool exists = false;
+      ASSERT_OK(WideColumnSerialization::GetColumn(input, expected.name(),
+                                                   column, &exists));
+      ASSERT_TRUE(exists);
+      ASSERT_EQ(column, expected);
+    }
+
+    {
+      WideColumn column;
+      bool exists = true;
+      ASSERT_OK(
+          WideColumnSerialization::GetColumn(input, "fubar", column, &exists));
+      ASSERT_FALSE(exists);
+    }
+  }
+
+  // Empty entity
+  {
+    std::string output;
+    ASSERT_OK(WideColumnSerialization::SerializeIndexed(WideColumns(),
+                                                        output));
+
+    WideColumn column;
+    bool exists = true;
+    ASSERT_OK(WideColumnSerialization::GetColumn(Slice(output), "foo", column,
+                                                 &exists));
+    ASSERT_FALSE(exists);
+  }
+}
+
+TEST(WideColumnSerializationTest, ProjectColumns) {
+  WideColumns columns{
+      {"aardvark", "ant"}, {"foo", "bar"}, {"hello", "world"}};
+
+  for (const bool indexed : {false, true}) {
+    std::string output;
+    if (indexed) {
+      ASSERT_OK(WideColumnSerialization::SerializeIndexed(columns, output));
+    } else {
+      ASSERT_OK(WideColumnSerialization::Serialize(columns, output));
+    }
+
+    const Slice input(output);
+
+    WideColumns projected;
+    ASSERT_OK(WideColumnSerialization::ProjectColumns(
+        input, {"hello", "fubar", "aardvark"}, projected));
+
+    // Missing columns are skipped; the rest come back in request order.
+    ASSERT_EQ(projected.size(), 2u);
+    ASSERT_EQ(projected[0], columns[2]);
+    ASSERT_EQ(projected[1], columns[0]);
+  }
+}
+
+TEST(WideColumnSerializationTest, DeserializeIndexedTruncatedTable) {
+  WideColumns columns{{"foo", "bar"}, {"hello", "world"}};
+  std::string output;
+
+  ASSERT_OK(WideColumnSerialization::SerializeIndexed(columns, output));
+
+  // Chop off part of the offset table.
+  Slice input(output.data(), 6);
+  WideColumns deserialized_columns;
+
+  const Status s =
+      WideColumnSerialization::Deserialize(input, deserialized_columns);
+  ASSERT_TRUE(s.IsCorruption());
+  ASSERT_TRUE(std::strstr(s.getState(), "offset table"));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
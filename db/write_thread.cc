@@ -4,11 +4,13 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #include "db/write_thread.h"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include "db/column_family.h"
 #include "monitoring/perf_context_imp.h"
 #include "port/port.h"
+#include "rocksdb/system_clock.h"
 #include "test_util/sync_point.h"
 #include "util/random.h"
 
@@ -19,11 +21,18 @@ WriteThread::WriteThread(const ImmutableDBOptions& db_options)
                           ? db_options.write_thread_max_yield_usec
                           : 0),
       slow_yield_usec_(db_options.write_thread_slow_yield_usec),
+      spinning_waiters_(0),
       allow_concurrent_memtable_write_(
           db_options.allow_concurrent_memtable_write),
       enable_pipelined_write_(db_options.enable_pipelined_write),
       max_write_batch_group_size_bytes(
           db_options.max_write_batch_group_size_bytes),
+      adaptive_group_size_(db_options.adaptive_write_batch_group_size),
+      clock_(db_options.clock),
+      adaptive_max_size_(db_options.max_write_batch_group_size_bytes),
+      epoch_bytes_(0),
+      epoch_nanos_(0),
+      epoch_groups_(0),
       newest_writer_(nullptr),
       newest_memtable_writer_(nullptr),
       last_sequence_(0),
@@ -71,9 +80,20 @@ uint8_t WriteThread::AwaitState(Writer* w, uint8_t goal_mask,
   // is the effect of the pause instruction), so 200 iterations is a bit
   // more than a microsecond.  This is long enough that waits longer than
   // this can amortize the cost of accessing the clock and yielding.
-  for (uint32_t tries = 0; tries < 200; ++tries) {
+  //
+  // Spinning is only profitable while few threads are doing it: with (say)
+  // 100 writer threads parked in this loop, the pause spins and the state
+  // cacheline traffic visibly slow down the leader itself. Scale the spin
+  // budget down as the number of concurrent spinners grows, converging to
+  // an almost immediate handoff to yielding/blocking under heavy load.
+  const uint32_t spinners =
+      spinning_waiters_.fetch_add(1, std::memory_order_relaxed);
+  const uint32_t max_pause_tries =
+      spinners < 8 ? 200 : (spinners < 32 ? 50 : 1);
+  for (uint32_t tries = 0; tries < max_pause_tries; ++tries) {
     state = w->state.load(std::memory_order_acquire);
     if ((state & goal_mask) != 0) {
+      spinning_waiters_.fetch_sub(1, std::memory_order_relaxed);
       return state;
     }
     port::AsmVolatilePause();
@@ -139,10 +159,16 @@ uint8_t WriteThread::AwaitState(Writer* w, uint8_t goal_mask,
   // 1/sampling_base.
   const int sampling_base = 256;
 
+  // Under heavy writer concurrency the yield loop degrades into a herd of
+  // runnable threads bouncing through the scheduler, so skip it (except for
+  // the occasional sampling run that keeps yield_credit fresh) and block.
+  const uint32_t kMaxSpinningWaiters = 32;
+
   if (max_yield_usec_ > 0) {
     update_ctx = Random::GetTLSInstance()->OneIn(sampling_base);
 
-    if (update_ctx || yield_credit.load(std::memory_order_relaxed) >= 0) {
+    if ((update_ctx || yield_credit.load(std::memory_order_relaxed) >= 0) &&
+        spinners < kMaxSpinningWaiters) {
       // we're updating the adaptation statistics, or spinning has >
       // 50% chance of being shorter than max_yield_usec_ and causing no
       // involuntary context switches
@@ -182,6 +208,9 @@ uint8_t WriteThread::AwaitState(Writer* w, uint8_t goal_mask,
     }
   }
 
+  // Blocked waiters do not count as spinners.
+  spinning_waiters_.fetch_sub(1, std::memory_order_relaxed);
+
   if ((state & goal_mask) == 0) {
     TEST_SYNC_POINT_CALLBACK("WriteThread::AwaitState:BlockingWaiting", w);
     state = BlockingAwaitState(w, goal_mask);
@@ -253,6 +282,11 @@ bool WriteThread::LinkOne(Writer* w, std::atomic<Writer*>* newest_writer) {
     if (newest_writer->compare_exchange_weak(writers, w)) {
       return (writers == nullptr);
     }
+    // Failed CAS: many writers are arriving at once. A short pause takes
+    // this thread out of the cacheline arbitration for a moment and lets
+    // the list settle, which empirically resolves the retry storm faster
+    // than immediately re-CASing.
+    port::AsmVolatilePause();
   }
 }
 
@@ -413,6 +447,51 @@ void WriteThread::JoinBatchGroup(Writer* w) {
   }
 }
 
+void WriteThread::UpdateAdaptiveGroupSize(uint64_t group_bytes,
+                                          uint64_t group_nanos) {
+  if (group_bytes == 0) {
+    return;
+  }
+  epoch_bytes_.fetch_add(group_bytes, std::memory_order_relaxed);
+  epoch_nanos_.fetch_add(group_nanos, std::memory_order_relaxed);
+  if (epoch_groups_.fetch_add(1, std::memory_order_acq_rel) + 1 !=
+      kAdaptiveEpochGroups) {
+    return;
+  }
+  // This thread closed the epoch. The counter only grows until it is reset
+  // below, so no other thread gets here concurrently; groups that race the
+  // reset may be dropped from the accounting, which is harmless noise.
+  uint64_t bytes = epoch_bytes_.load(std::memory_order_relaxed);
+  uint64_t nanos = epoch_nanos_.load(std::memory_order_relaxed);
+  epoch_bytes_.store(0, std::memory_order_relaxed);
+  epoch_nanos_.store(0, std::memory_order_relaxed);
+
+  // Probe for the group size that minimizes per-byte commit latency the way
+  // TCP probes for bandwidth: keep stepping the limit in the current
+  // direction while latency holds or improves, and reverse when it regresses
+  // beyond a small deadband. The deadband avoids flapping on measurement
+  // noise; the 1/8x..8x clamp keeps a pathological epoch from running away.
+  double nanos_per_byte = static_cast<double>(nanos) / bytes;
+  if (last_epoch_nanos_per_byte_ > 0.0 &&
+      nanos_per_byte > last_epoch_nanos_per_byte_ * 1.05) {
+    probe_up_ = !probe_up_;
+  }
+  last_epoch_nanos_per_byte_ = nanos_per_byte;
+
+  const uint64_t min_limit =
+      std::max<uint64_t>(max_write_batch_group_size_bytes / 8, 4096);
+  const uint64_t max_limit = max_write_batch_group_size_bytes * 8;
+  uint64_t limit = adaptive_max_size_.load(std::memory_order_relaxed);
+  if (probe_up_) {
+    limit = std::min(max_limit, limit + limit / 4);
+  } else {
+    limit = std::max(min_limit, limit - limit / 4);
+  }
+  adaptive_max_size_.store(limit, std::memory_order_relaxed);
+
+  epoch_groups_.store(0, std::memory_order_release);
+}
+
 size_t WriteThread::EnterAsBatchGroupLeader(Writer* leader,
                                             WriteGroup* write_group) {
   assert(leader->link_older == nullptr);
@@ -424,8 +503,8 @@ size_t WriteThread::EnterAsBatchGroupLeader(Writer* leader,
   // Allow the group to grow up to a maximum size, but if the
   // original write is small, limit the growth so we do not slow
   // down the small write too much.
-  size_t max_size = max_write_batch_group_size_bytes;
-  const uint64_t min_batch_size_bytes = max_write_batch_group_size_bytes / 8;
+  size_t max_size = GetMaxWriteBatchGroupSizeBytes();
+  const uint64_t min_batch_size_bytes = max_size / 8;
   if (size <= min_batch_size_bytes) {
     max_size = size + min_batch_size_bytes;
   }
@@ -499,6 +578,10 @@ size_t WriteThread::EnterAsBatchGroupLeader(Writer* leader,
     write_group->last_writer = w;
     write_group->size++;
   }
+  if (adaptive_group_size_) {
+    write_group->bytes = size;
+    write_group->start_nanos = clock_->NowNanos();
+  }
   TEST_SYNC_POINT_CALLBACK("WriteThread::EnterAsBatchGroupLeader:End", w);
   return size;
 }
@@ -515,8 +598,8 @@ void WriteThread::EnterAsMemTableWriter(Writer* leader,
   // Allow the group to grow up to a maximum size, but if the
   // original write is small, limit the growth so we do not slow
   // down the small write too much.
-  size_t max_size = max_write_batch_group_size_bytes;
-  const uint64_t min_batch_size_bytes = max_write_batch_group_size_bytes / 8;
+  size_t max_size = GetMaxWriteBatchGroupSizeBytes();
+  const uint64_t min_batch_size_bytes = max_size / 8;
   if (size <= min_batch_size_bytes) {
     max_size = size + min_batch_size_bytes;
   }
@@ -644,6 +727,11 @@ void WriteThread::ExitAsBatchGroupLeader(WriteGroup& write_group,
   Writer* last_writer = write_group.last_writer;
   assert(leader->link_older == nullptr);
 
+  if (adaptive_group_size_ && write_group.start_nanos > 0) {
+    UpdateAdaptiveGroupSize(write_group.bytes,
+                            clock_->NowNanos() - write_group.start_nanos);
+  }
+
   // If status is non-ok already, then write_group.status won't have the chance
   // of being propagated to caller.
   if (!status.ok()) {
@@ -27,6 +27,8 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class SystemClock;
+
 class WriteThread {
  public:
   enum State : uint8_t {
@@ -83,6 +85,12 @@ class WriteThread {
     Status status;
     std::atomic<size_t> running;
     size_t size = 0;
+    // Total batch bytes and formation time of the group, recorded by
+    // EnterAsBatchGroupLeader when adaptive group sizing is enabled so
+    // that ExitAsBatchGroupLeader can feed the completed group into the
+    // size controller.
+    uint64_t bytes = 0;
+    uint64_t start_nanos = 0;
 
     struct Iterator {
       Writer* writer;
@@ -362,11 +370,35 @@ class WriteThread {
   // Remove the dummy writer and wake up waiting writers
   void EndWriteStall();
 
+  // The limit on the number of bytes a write group may grow to. Equal to
+  // max_write_batch_group_size_bytes unless adaptive group sizing is
+  // enabled, in which case it returns the current auto-tuned limit.
+  uint64_t GetMaxWriteBatchGroupSizeBytes() const {
+    return adaptive_group_size_
+               ? adaptive_max_size_.load(std::memory_order_relaxed)
+               : max_write_batch_group_size_bytes;
+  }
+
+  // Feed one completed write group (its total batch bytes and the wall time
+  // from group formation through commit) into the adaptive group size
+  // controller. Called by ExitAsBatchGroupLeader when adaptive group sizing
+  // is enabled; public for testing.
+  void UpdateAdaptiveGroupSize(uint64_t group_bytes, uint64_t group_nanos);
+
+  // Number of write groups in one measurement epoch of the adaptive group
+  // size controller.
+  static constexpr uint32_t kAdaptiveEpochGroups = 32;
+
  private:
   // See AwaitState.
   const uint64_t max_yield_usec_;
   const uint64_t slow_yield_usec_;
 
+  // Number of writers currently spinning in AwaitState. Used to scale the
+  // spin phases down under heavy writer concurrency, where fully-spinning
+  // waiters steal cycles from the group leader and inflate queueing jitter.
+  std::atomic<uint32_t> spinning_waiters_;
+
   // Allow multiple writers write to memtable concurrently.
   const bool allow_concurrent_memtable_write_;
 
@@ -378,6 +410,31 @@ class WriteThread {
   // is larger than 1/8 of this limit.
   const uint64_t max_write_batch_group_size_bytes;
 
+  // True if the group size limit is auto-tuned at runtime (see
+  // DBOptions::adaptive_write_batch_group_size).
+  const bool adaptive_group_size_;
+
+  // Clock used to time write groups for the adaptive controller.
+  SystemClock* clock_;
+
+  // The current auto-tuned group size limit, kept within
+  // [max_write_batch_group_size_bytes / 8,
+  //  max_write_batch_group_size_bytes * 8]. Only meaningful when
+  // adaptive_group_size_ is true.
+  std::atomic<uint64_t> adaptive_max_size_;
+
+  // Bytes and wall nanos accumulated over the current measurement epoch,
+  // and the number of groups that have reported so far. The writer whose
+  // group completes the epoch closes it and steps the limit.
+  std::atomic<uint64_t> epoch_bytes_;
+  std::atomic<uint64_t> epoch_nanos_;
+  std::atomic<uint32_t> epoch_groups_;
+
+  // Controller state. Only touched by the single thread closing an epoch,
+  // so no synchronization is needed beyond the counters above.
+  double last_epoch_nanos_per_byte_ = 0.0;
+  bool probe_up_ = true;
+
   // Points to the newest pending writer. Only leader can remove
   // elements, adding can be done lock-free by anybody.
   std::atomic<Writer*> newest_writer_;
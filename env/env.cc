@@ -1138,6 +1138,8 @@ EnvOptions Env::OptimizeForCompactionTableWrite(
   EnvOptions optimized_env_options(env_options);
   optimized_env_options.use_direct_writes =
       db_options.use_direct_io_for_flush_and_compaction;
+  optimized_env_options.use_async_buffered_writes =
+      db_options.use_async_sst_file_writes;
   return optimized_env_options;
 }
 
@@ -967,25 +967,41 @@ Status BlockAccessCipherStream::Encrypt(uint64_t fileOffset, char *data, size_t
   while (1) {
     char *block = data;
     size_t n = std::min(dataSize, blockSize - blockOffset);
-    if (n != blockSize) {
-      // We're not encrypting a full block.
-      // Copy data to blockBuffer
-      if (!blockBuffer.get()) {
-        // Allocate buffer
-        blockBuffer = std::unique_ptr<char[]>(new char[blockSize]);
+    if (n == blockSize) {
+      // A run of whole blocks: hand them to the batched path in a single
+      // call, so streams with a batched implementation can keep several
+      // blocks in flight and only pay one virtual dispatch per run.
+      const size_t numBlocks = dataSize / blockSize;
+      auto status =
+          EncryptBlocks(blockIndex, data, numBlocks, (char*)scratch.data());
+      if (!status.ok()) {
+        return status;
       }
-      block = blockBuffer.get();
-      // Copy plain data to block buffer
-      memmove(block + blockOffset, data, n);
+      const size_t numBytes = numBlocks * blockSize;
+      dataSize -= numBytes;
+      if (dataSize == 0) {
+        return Status::OK();
+      }
+      // A trailing partial block remains.
+      data += numBytes;
+      blockIndex += numBlocks;
+      continue;
+    }
+    // We're not encrypting a full block.
+    // Copy data to blockBuffer
+    if (!blockBuffer.get()) {
+      // Allocate buffer
+      blockBuffer = std::unique_ptr<char[]>(new char[blockSize]);
     }
+    block = blockBuffer.get();
+    // Copy plain data to block buffer
+    memmove(block + blockOffset, data, n);
     auto status = EncryptBlock(blockIndex, block, (char*)scratch.data());
     if (!status.ok()) {
       return status;
     }
-    if (block != data) {
-      // Copy encrypted data back to `data`.
-      memmove(data, block + blockOffset, n);
-    }
+    // Copy encrypted data back to `data`.
+    memmove(data, block + blockOffset, n);
     dataSize -= n;
     if (dataSize == 0) {
       return Status::OK();
@@ -996,6 +1012,31 @@ Status BlockAccessCipherStream::Encrypt(uint64_t fileOffset, char *data, size_t
   }
 }
 
+// Encrypt `numBlocks` consecutive whole blocks, one EncryptBlock() call at
+// a time. Streams that can batch keystream generation override this.
+Status BlockAccessCipherStream::EncryptBlocks(uint64_t blockIndex, char* data,
+                                              size_t numBlocks,
+                                              char* scratch) {
+  const size_t blockSize = BlockSize();
+  Status status;
+  for (size_t i = 0; status.ok() && i < numBlocks; i++) {
+    status = EncryptBlock(blockIndex + i, data + i * blockSize, scratch);
+  }
+  return status;
+}
+
+// Same as EncryptBlocks, decrypting.
+Status BlockAccessCipherStream::DecryptBlocks(uint64_t blockIndex, char* data,
+                                              size_t numBlocks,
+                                              char* scratch) {
+  const size_t blockSize = BlockSize();
+  Status status;
+  for (size_t i = 0; status.ok() && i < numBlocks; i++) {
+    status = DecryptBlock(blockIndex + i, data + i * blockSize, scratch);
+  }
+  return status;
+}
+
 // Decrypt one or more (partial) blocks of data at the file offset.
 // Length of data is given in dataSize.
 Status BlockAccessCipherStream::Decrypt(uint64_t fileOffset, char *data, size_t dataSize) {
@@ -1012,25 +1053,40 @@ Status BlockAccessCipherStream::Decrypt(uint64_t fileOffset, char *data, size_t
   while (1) {
     char *block = data;
     size_t n = std::min(dataSize, blockSize - blockOffset);
-    if (n != blockSize) {
-      // We're not decrypting a full block.
-      // Copy data to blockBuffer
-      if (!blockBuffer.get()) {
-        // Allocate buffer
-        blockBuffer = std::unique_ptr<char[]>(new char[blockSize]);
+    if (n == blockSize) {
+      // A run of whole blocks: hand them to the batched path in a single
+      // call, matching Encrypt() above.
+      const size_t numBlocks = dataSize / blockSize;
+      auto status =
+          DecryptBlocks(blockIndex, data, numBlocks, (char*)scratch.data());
+      if (!status.ok()) {
+        return status;
+      }
+      const size_t numBytes = numBlocks * blockSize;
+      dataSize -= numBytes;
+      if (dataSize == 0) {
+        return Status::OK();
       }
-      block = blockBuffer.get();
-      // Copy encrypted data to block buffer
-      memmove(block + blockOffset, data, n);
+      // A trailing partial block remains.
+      data += numBytes;
+      blockIndex += numBlocks;
+      continue;
     }
+    // We're not decrypting a full block.
+    // Copy data to blockBuffer
+    if (!blockBuffer.get()) {
+      // Allocate buffer
+      blockBuffer = std::unique_ptr<char[]>(new char[blockSize]);
+    }
+    block = blockBuffer.get();
+    // Copy encrypted data to block buffer
+    memmove(block + blockOffset, data, n);
     auto status = DecryptBlock(blockIndex, block, (char*)scratch.data());
     if (!status.ok()) {
       return status;
     }
-    if (block != data) {
-      // Copy decrypted data back to `data`.
-      memmove(data, block + blockOffset, n);
-    }
+    // Copy decrypted data back to `data`.
+    memmove(data, block + blockOffset, n);
 
     // Simply decrementing dataSize by n could cause it to underflow,
     // which will very likely make it read over the original bounds later
@@ -1100,7 +1156,8 @@ static const std::unordered_map<std::string, OptionTypeInfo>
 // Allocate scratch space which is passed to EncryptBlock/DecryptBlock.
 void CTRCipherStream::AllocateScratch(std::string& scratch) {
   auto blockSize = cipher_->BlockSize();
-  scratch.reserve(blockSize);
+  // Room for a full pipeline of counter blocks; see EncryptBlocks().
+  scratch.reserve(kPipelineDepth * blockSize);
 }
 
 // Encrypt a block of data at the given block index.
@@ -1133,6 +1190,44 @@ Status CTRCipherStream::DecryptBlock(uint64_t blockIndex, char* data,
   return EncryptBlock(blockIndex, data, scratch);
 }
 
+// Encrypt a run of whole blocks. Counter blocks are laid out back to back
+// in scratch, up to kPipelineDepth at a time, and handed to the cipher in
+// one call so pipelined implementations (e.g. AES-NI) can overlap them and
+// the virtual dispatch is paid once per batch instead of once per block.
+Status CTRCipherStream::EncryptBlocks(uint64_t blockIndex, char* data,
+                                      size_t numBlocks, char* scratch) {
+  const size_t blockSize = cipher_->BlockSize();
+  while (numBlocks > 0) {
+    const size_t n = std::min(numBlocks, kPipelineDepth);
+    // Create nonce + counter for each block of the batch
+    for (size_t i = 0; i < n; i++) {
+      char* counterBlock = scratch + i * blockSize;
+      memmove(counterBlock, iv_.data(), blockSize);
+      EncodeFixed64(counterBlock, blockIndex + i + initialCounter_);
+    }
+    // Encrypt the nonce+counter batch
+    auto status = cipher_->EncryptBlocks(scratch, n);
+    if (!status.ok()) {
+      return status;
+    }
+    // XOR data with ciphertext.
+    const size_t numBytes = n * blockSize;
+    for (size_t i = 0; i < numBytes; i++) {
+      data[i] = data[i] ^ scratch[i];
+    }
+    data += numBytes;
+    blockIndex += n;
+    numBlocks -= n;
+  }
+  return Status::OK();
+}
+
+// For CTR decryption & encryption are the same
+Status CTRCipherStream::DecryptBlocks(uint64_t blockIndex, char* data,
+                                      size_t numBlocks, char* scratch) {
+  return EncryptBlocks(blockIndex, data, numBlocks, scratch);
+}
+
 CTREncryptionProvider::CTREncryptionProvider(
     const std::shared_ptr<BlockCipher>& c)
     : cipher_(c) {
@@ -31,6 +31,10 @@ class CTRCipherStream final : public BlockAccessCipherStream {
   // BlockSize returns the size of each block supported by this cipher stream.
   size_t BlockSize() override { return cipher_->BlockSize(); }
 
+  // Number of counter blocks generated per batched cipher call. Eight
+  // blocks is enough to hide the latency of hardware AES pipelines.
+  static constexpr size_t kPipelineDepth = 8;
+
  protected:
   // Allocate scratch space which is passed to EncryptBlock/DecryptBlock.
   void AllocateScratch(std::string&) override;
@@ -42,6 +46,15 @@ class CTRCipherStream final : public BlockAccessCipherStream {
   // Decrypt a block of data at the given block index.
   // Length of data is equal to BlockSize();
   Status DecryptBlock(uint64_t blockIndex, char* data, char* scratch) override;
+
+  // Batched versions of the above: counter blocks are generated for up to
+  // kPipelineDepth blocks at a time and handed to the cipher in one call,
+  // so pipelined cipher implementations can keep several blocks in flight.
+  Status EncryptBlocks(uint64_t blockIndex, char* data, size_t numBlocks,
+                       char* scratch) override;
+
+  Status DecryptBlocks(uint64_t blockIndex, char* data, size_t numBlocks,
+                       char* scratch) override;
 };
 
 // This encryption provider uses a CTR cipher stream, with a given block cipher
@@ -61,6 +61,7 @@
 #include "util/coding.h"
 #include "util/crc32c.h"
 #include "util/mutexlock.h"
+#include "util/threadpool_imp.h"
 #include "util/random.h"
 #include "util/string_util.h"
 #include "utilities/counted_fs.h"
@@ -476,6 +477,47 @@ TEST_P(EnvPosixTestWithParam, RunMany) {
 }
 #endif
 
+// In work-stealing mode, submissions spread over per-thread queues must
+// all run, stay countable via GetQueueLen() and remain unschedulable by
+// tag, exactly as in the default single-queue mode.
+TEST_F(EnvPosixTest, WorkStealingThreadPool) {
+  ThreadPoolImpl pool;
+  pool.SetBackgroundThreads(2);
+  pool.EnableWorkStealing();
+
+  // Park both threads so that scheduled jobs stay queued in the shards.
+  test::SleepingBackgroundTask sleeping_tasks[2];
+  for (auto& task : sleeping_tasks) {
+    pool.Schedule(&test::SleepingBackgroundTask::DoSleepTask, &task, nullptr,
+                  nullptr);
+    task.WaitUntilSleeping();
+  }
+
+  std::atomic<int> ran(0);
+  struct CB {
+    static void Run(void* arg) {
+      reinterpret_cast<std::atomic<int>*>(arg)->fetch_add(1);
+    }
+  };
+  int kept_tag;
+  int dropped_tag;
+  for (int i = 0; i < 16; i++) {
+    pool.Schedule(&CB::Run, &ran, &kept_tag, nullptr);
+    pool.Schedule(&CB::Run, &ran, &dropped_tag, nullptr);
+  }
+  ASSERT_EQ(32U, pool.GetQueueLen());
+
+  // Tagged jobs are found in whichever shard they landed in.
+  ASSERT_EQ(16, pool.UnSchedule(&dropped_tag));
+  ASSERT_EQ(16U, pool.GetQueueLen());
+
+  for (auto& task : sleeping_tasks) {
+    task.WakeUp();
+  }
+  pool.WaitForJobsAndJoinAllThreads();
+  ASSERT_EQ(16, ran.load());
+}
+
 struct State {
   port::Mutex mu;
   int val;
@@ -2679,6 +2721,39 @@ TEST_F(CreateEnvTest, LoadROT13Cipher) {
   ASSERT_NE(cipher, nullptr);
   ASSERT_STREQ(cipher->Name(), "ROT13");
 }
+
+TEST_F(CreateEnvTest, CTRCipherStreamBatchedRoundTrip) {
+  // Encrypt in one large call (exercising the batched whole-block path,
+  // including several full pipelines plus a remainder) and decrypt in
+  // small odd-sized chunks (exercising the single-block and partial-block
+  // paths); both must agree for a faithful round trip.
+  std::shared_ptr<BlockCipher> cipher = BlockCipher::NewROT13Cipher(16);
+  const std::string iv(cipher->BlockSize(), 'i');
+  CTRCipherStream encrypt_stream(cipher, iv.data(), /*initialCounter=*/123);
+  CTRCipherStream decrypt_stream(cipher, iv.data(), /*initialCounter=*/123);
+
+  Random rnd(301);
+  // Partial first and last blocks, with 3 pipelines' worth in between.
+  const size_t kDataSize = 16 * (3 * CTRCipherStream::kPipelineDepth + 1);
+  const uint64_t kFileOffset = 8;
+  std::string plain = rnd.RandomString(static_cast<int>(kDataSize));
+  std::string data = plain;
+
+  ASSERT_OK(encrypt_stream.Encrypt(kFileOffset, &data[0], data.size()));
+  ASSERT_NE(data, plain);
+
+  uint64_t offset = kFileOffset;
+  size_t pos = 0;
+  size_t chunk_size = 1;
+  while (pos < data.size()) {
+    const size_t n = std::min(chunk_size, data.size() - pos);
+    ASSERT_OK(decrypt_stream.Decrypt(offset, &data[pos], n));
+    offset += n;
+    pos += n;
+    chunk_size = chunk_size * 2 + 1;
+  }
+  ASSERT_EQ(data, plain);
+}
 #endif  // ROCKSDB_LITE
 
 TEST_F(CreateEnvTest, CreateDefaultSystemClock) {
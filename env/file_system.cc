@@ -169,6 +169,8 @@ FileOptions FileSystem::OptimizeForCompactionTableWrite(
   FileOptions optimized_file_options(file_options);
   optimized_file_options.use_direct_writes =
       db_options.use_direct_io_for_flush_and_compaction;
+  optimized_file_options.use_async_buffered_writes =
+      db_options.use_async_sst_file_writes;
   return optimized_file_options;
 }
 
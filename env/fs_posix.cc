@@ -276,7 +276,8 @@ class PosixFileSystem : public FileSystem {
           options
 #if defined(ROCKSDB_IOURING_PRESENT)
           ,
-          !IsIOUringEnabled() ? nullptr : thread_local_io_urings_.get()
+          !IsIOUringEnabled() ? nullptr : thread_local_io_urings_.get(),
+          !IsIOUringEnabled() ? nullptr : io_uring_reactor_.get()
 #endif
               ));
     }
@@ -358,6 +359,11 @@ class PosixFileSystem : public FileSystem {
       // disable mmap writes
       EnvOptions no_mmap_writes_options = options;
       no_mmap_writes_options.use_mmap_writes = false;
+      if (reopen) {
+        // io_uring appends use pwrite()-style offsets, which O_APPEND
+        // overrides on Linux; stay synchronous for reopened files.
+        no_mmap_writes_options.use_io_uring_writes = false;
+      }
       result->reset(
           new PosixWritableFile(fname, fd,
                                 GetLogicalBlockSizeForWriteIfNeeded(
@@ -926,6 +932,7 @@ class PosixFileSystem : public FileSystem {
     optimized.fallocate_with_keep_size = true;
     optimized.writable_file_max_buffer_size =
         db_options.writable_file_max_buffer_size;
+    optimized.use_io_uring_writes = db_options.use_io_uring_wal_writes;
     return optimized;
   }
 
@@ -1016,15 +1023,58 @@ class PosixFileSystem : public FileSystem {
   virtual IOStatus Poll(std::vector<void*>& io_handles,
                         size_t /*min_completions*/) override {
 #if defined(ROCKSDB_IOURING_PRESENT)
+    // Requests routed through the shared completion reactor are reaped by
+    // the reactor thread; finalize them here in the caller's thread so the
+    // callback threading matches the thread-local-ring path.
+    for (size_t i = 0; i < io_handles.size(); i++) {
+      Posix_IOHandle* posix_handle =
+          static_cast<Posix_IOHandle*>(io_handles[i]);
+      if (posix_handle->is_finished || posix_handle->reactor == nullptr) {
+        continue;
+      }
+      posix_handle->reactor->WaitForCompletion(posix_handle);
+      struct io_uring_cqe reaped_cqe = {};
+      reaped_cqe.res = posix_handle->cqe_res;
+
+      FSReadRequest req;
+      req.scratch = posix_handle->scratch;
+      req.offset = posix_handle->offset;
+      req.len = posix_handle->len;
+
+      size_t finished_len = 0;
+      size_t bytes_read = 0;
+      bool read_again = false;
+      UpdateResult(&reaped_cqe, "", req.len, posix_handle->iov.iov_len,
+                   true /*async_read*/, posix_handle->use_direct_io,
+                   posix_handle->alignment, finished_len, &req, bytes_read,
+                   read_again);
+      posix_handle->is_finished = true;
+      posix_handle->cb(req, posix_handle->cb_arg);
+
+      (void)finished_len;
+      (void)bytes_read;
+      (void)read_again;
+    }
+
     // io_uring_queue_init.
     struct io_uring* iu = nullptr;
     if (thread_local_io_urings_) {
-      iu = static_cast<struct io_uring*>(thread_local_io_urings_->Get());
+      IoUringCtx* ctx =
+          static_cast<IoUringCtx*>(thread_local_io_urings_->Get());
+      if (ctx != nullptr) {
+        iu = &ctx->ring;
+      }
     }
 
     // Init failed, platform doesn't support io_uring.
     if (iu == nullptr) {
-      return IOStatus::NotSupported("Poll");
+      for (size_t i = 0; i < io_handles.size(); i++) {
+        if (!(static_cast<Posix_IOHandle*>(io_handles[i]))->is_finished) {
+          return IOStatus::NotSupported("Poll");
+        }
+      }
+      // Everything was handled by the reactor.
+      return IOStatus::OK();
     }
 
     for (size_t i = 0; i < io_handles.size(); i++) {
@@ -1088,10 +1138,30 @@ class PosixFileSystem : public FileSystem {
 
   virtual IOStatus AbortIO(std::vector<void*>& io_handles) override {
 #if defined(ROCKSDB_IOURING_PRESENT)
+    // Reactor-routed requests cannot be individually cancelled without
+    // racing the reactor thread for the CQ; wait for them to complete and
+    // report them as aborted, matching the cancel path's callback.
+    for (size_t i = 0; i < io_handles.size(); i++) {
+      Posix_IOHandle* posix_handle =
+          static_cast<Posix_IOHandle*>(io_handles[i]);
+      if (posix_handle->is_finished || posix_handle->reactor == nullptr) {
+        continue;
+      }
+      posix_handle->reactor->WaitForCompletion(posix_handle);
+      posix_handle->is_finished = true;
+      FSReadRequest req;
+      req.status = IOStatus::Aborted();
+      posix_handle->cb(req, posix_handle->cb_arg);
+    }
+
     // io_uring_queue_init.
     struct io_uring* iu = nullptr;
     if (thread_local_io_urings_) {
-      iu = static_cast<struct io_uring*>(thread_local_io_urings_->Get());
+      IoUringCtx* ctx =
+          static_cast<IoUringCtx*>(thread_local_io_urings_->Get());
+      if (ctx != nullptr) {
+        iu = &ctx->ring;
+      }
     }
 
     // Init failed, platform doesn't support io_uring.
@@ -1192,6 +1262,9 @@ class PosixFileSystem : public FileSystem {
 #if defined(ROCKSDB_IOURING_PRESENT)
   // io_uring instance
   std::unique_ptr<ThreadLocalPtr> thread_local_io_urings_;
+  // Shared ReadAsync completion reactor; non-null only when the
+  // application opted in via RocksDbIOUringReactorEnable().
+  std::unique_ptr<PosixIoUringReactor> io_uring_reactor_;
 #endif
 
   size_t page_size_;
@@ -1249,10 +1322,13 @@ PosixFileSystem::PosixFileSystem()
   // Test whether IOUring is supported, and if it does, create a managing
   // object for thread local point so that in the future thread-local
   // io_uring can be created.
-  struct io_uring* new_io_uring = CreateIOUring();
-  if (new_io_uring != nullptr) {
-    thread_local_io_urings_.reset(new ThreadLocalPtr(DeleteIOUring));
-    delete new_io_uring;
+  IoUringCtx* probe_ctx = CreateIoUringCtx();
+  if (probe_ctx != nullptr) {
+    thread_local_io_urings_.reset(new ThreadLocalPtr(DeleteIoUringCtx));
+    DeleteIoUringCtx(probe_ctx);
+    if (RocksDbIOUringReactorEnable && RocksDbIOUringReactorEnable()) {
+      io_uring_reactor_.reset(PosixIoUringReactor::TryCreate());
+    }
   }
 #endif
 }
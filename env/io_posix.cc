@@ -542,7 +542,8 @@ PosixRandomAccessFile::PosixRandomAccessFile(
     const EnvOptions& options
 #if defined(ROCKSDB_IOURING_PRESENT)
     ,
-    ThreadLocalPtr* thread_local_io_urings
+    ThreadLocalPtr* thread_local_io_urings,
+    PosixIoUringReactor* io_uring_reactor
 #endif
     )
     : filename_(fname),
@@ -551,7 +552,8 @@ PosixRandomAccessFile::PosixRandomAccessFile(
       logical_sector_size_(logical_block_size)
 #if defined(ROCKSDB_IOURING_PRESENT)
       ,
-      thread_local_io_urings_(thread_local_io_urings)
+      thread_local_io_urings_(thread_local_io_urings),
+      io_uring_reactor_(io_uring_reactor)
 #endif
 {
   assert(!options.use_direct_reads || !options.use_mmap_reads);
@@ -601,6 +603,114 @@ IOStatus PosixRandomAccessFile::Read(uint64_t offset, size_t n,
   return s;
 }
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+int PosixRandomAccessFile::GetFixedFileSlot(IoUringCtx* ctx) const {
+  if (!ctx->fixed_files_supported) {
+    return -1;
+  }
+  // dev/ino let the ring tell a recycled fd number apart from the file
+  // that was registered under it; see IoUringCtx::RegisterFd().
+  struct stat buf;
+  if (fstat(fd_, &buf) != 0) {
+    return -1;
+  }
+  return ctx->RegisterFd(fd_, static_cast<uint64_t>(buf.st_dev),
+                         static_cast<uint64_t>(buf.st_ino));
+}
+
+PosixIoUringReactor::PosixIoUringReactor()
+    : submit_cv_(&mu_), complete_cv_(&mu_) {}
+
+PosixIoUringReactor* PosixIoUringReactor::TryCreate() {
+  std::unique_ptr<PosixIoUringReactor> reactor(new PosixIoUringReactor());
+  if (io_uring_queue_init(kIoUringDepth, &reactor->ring_, 0)) {
+    return nullptr;
+  }
+  reactor->thread_ = port::Thread(&PosixIoUringReactor::Run, reactor.get());
+  return reactor.release();
+}
+
+PosixIoUringReactor::~PosixIoUringReactor() {
+  if (!thread_.joinable()) {
+    // TryCreate() failed before the thread started; the ring was never
+    // initialized either.
+    return;
+  }
+  {
+    // A NOP with null user data tells the reactor thread to exit.
+    MutexLock l(&mu_);
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    assert(sqe != nullptr);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+  thread_.join();
+  io_uring_queue_exit(&ring_);
+}
+
+IOStatus PosixIoUringReactor::SubmitRead(int fd, Posix_IOHandle* handle) {
+  MutexLock l(&mu_);
+  // Backpressure: hold the caller until the ring has room.
+  while (inflight_ >= kIoUringDepth) {
+    submit_cv_.Wait();
+  }
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    // Cannot happen while inflight_ bounds the SQ, but don't crash on it.
+    return IOStatus::Busy("io_uring submission queue full");
+  }
+  io_uring_prep_readv(sqe, fd, &handle->iov, 1, handle->offset);
+  io_uring_sqe_set_data(sqe, handle);
+  ssize_t ret = io_uring_submit(&ring_);
+  if (ret < 0) {
+    return IOStatus::IOError("io_uring_submit() requested but returned " +
+                             std::to_string(ret));
+  }
+  ++inflight_;
+  return IOStatus::OK();
+}
+
+void PosixIoUringReactor::WaitForCompletion(Posix_IOHandle* handle) {
+  MutexLock l(&mu_);
+  while (!handle->reaped) {
+    complete_cv_.Wait();
+  }
+}
+
+void PosixIoUringReactor::Run() {
+  while (true) {
+    struct io_uring_cqe* cqe = nullptr;
+    int ret = io_uring_wait_cqe(&ring_, &cqe);
+    if (ret) {
+      if (ret == -EINTR) {
+        continue;
+      }
+      // As in Poll(): the ring is in an indeterminate state and there is
+      // no good way to recover.
+      abort();
+    }
+    assert(cqe != nullptr);
+    void* data = io_uring_cqe_get_data(cqe);
+    int32_t res = cqe->res;
+    // Reset cqe data to catch any stray reuse of it
+    cqe->user_data = 0xd5d5d5d5d5d5d5d5;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (data == nullptr) {
+      // Shutdown NOP from the destructor.
+      break;
+    }
+    Posix_IOHandle* handle = static_cast<Posix_IOHandle*>(data);
+    MutexLock l(&mu_);
+    handle->cqe_res = res;
+    handle->reaped = true;
+    --inflight_;
+    submit_cv_.Signal();
+    complete_cv_.SignalAll();
+  }
+}
+#endif
+
 IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs,
                                           size_t num_reqs,
                                           const IOOptions& options,
@@ -614,22 +724,27 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs,
   }
 
 #if defined(ROCKSDB_IOURING_PRESENT)
-  struct io_uring* iu = nullptr;
+  IoUringCtx* ctx = nullptr;
   if (thread_local_io_urings_) {
-    iu = static_cast<struct io_uring*>(thread_local_io_urings_->Get());
-    if (iu == nullptr) {
-      iu = CreateIOUring();
-      if (iu != nullptr) {
-        thread_local_io_urings_->Reset(iu);
+    ctx = static_cast<IoUringCtx*>(thread_local_io_urings_->Get());
+    if (ctx == nullptr) {
+      ctx = CreateIoUringCtx();
+      if (ctx != nullptr) {
+        thread_local_io_urings_->Reset(ctx);
       }
     }
   }
 
   // Init failed, platform doesn't support io_uring. Fall back to
   // serialized reads
-  if (iu == nullptr) {
+  if (ctx == nullptr) {
     return FSRandomAccessFile::MultiRead(reqs, num_reqs, options, dbg);
   }
+  struct io_uring* iu = &ctx->ring;
+  // Submit against the ring's fixed file table when possible; this skips
+  // the per-request fd lookup in the kernel and keeps SQPOLL rings usable
+  // on kernels that require registered files in polling mode.
+  const int fixed_file_slot = GetFixedFileSlot(ctx);
 
   IOStatus ios = IOStatus::OK();
 
@@ -672,8 +787,12 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs,
       struct io_uring_sqe* sqe;
       sqe = io_uring_get_sqe(iu);
       io_uring_prep_readv(
-          sqe, fd_, &rep_to_submit->iov, 1,
+          sqe, fixed_file_slot >= 0 ? fixed_file_slot : fd_,
+          &rep_to_submit->iov, 1,
           rep_to_submit->req->offset + rep_to_submit->finished_len);
+      if (fixed_file_slot >= 0) {
+        sqe->flags |= IOSQE_FIXED_FILE;
+      }
       io_uring_sqe_set_data(sqe, rep_to_submit);
       wrap_cache.emplace(rep_to_submit);
     }
@@ -862,22 +981,41 @@ IOStatus PosixRandomAccessFile::ReadAsync(
   }
 
 #if defined(ROCKSDB_IOURING_PRESENT)
+  if (io_uring_reactor_ != nullptr) {
+    // Route through the shared completion reactor; the reactor thread owns
+    // the CQ and Poll()/AbortIO() just wait for it to flag the handle.
+    Posix_IOHandle* posix_handle = new Posix_IOHandle(
+        /*_iu=*/nullptr, cb, cb_arg, req.offset, req.len, req.scratch,
+        use_direct_io(), GetRequiredBufferAlignment());
+    posix_handle->iov.iov_base = req.scratch;
+    posix_handle->iov.iov_len = req.len;
+    posix_handle->reactor = io_uring_reactor_;
+    *io_handle = static_cast<void*>(posix_handle);
+    *del_fn = [](void* args) -> void {
+      delete (static_cast<Posix_IOHandle*>(args));
+      args = nullptr;
+    };
+    return io_uring_reactor_->SubmitRead(fd_, posix_handle);
+  }
+
   // io_uring_queue_init.
-  struct io_uring* iu = nullptr;
+  IoUringCtx* ctx = nullptr;
   if (thread_local_io_urings_) {
-    iu = static_cast<struct io_uring*>(thread_local_io_urings_->Get());
-    if (iu == nullptr) {
-      iu = CreateIOUring();
-      if (iu != nullptr) {
-        thread_local_io_urings_->Reset(iu);
+    ctx = static_cast<IoUringCtx*>(thread_local_io_urings_->Get());
+    if (ctx == nullptr) {
+      ctx = CreateIoUringCtx();
+      if (ctx != nullptr) {
+        thread_local_io_urings_->Reset(ctx);
       }
     }
   }
 
   // Init failed, platform doesn't support io_uring.
-  if (iu == nullptr) {
+  if (ctx == nullptr) {
     return IOStatus::NotSupported("ReadAsync");
   }
+  struct io_uring* iu = &ctx->ring;
+  const int fixed_file_slot = GetFixedFileSlot(ctx);
 
   // Allocate io_handle.
   IOHandleDeleter deletefn = [](void* args) -> void {
@@ -899,7 +1037,11 @@ IOStatus PosixRandomAccessFile::ReadAsync(
   struct io_uring_sqe* sqe;
   sqe = io_uring_get_sqe(iu);
 
-  io_uring_prep_readv(sqe, fd_, &posix_handle->iov, 1, posix_handle->offset);
+  io_uring_prep_readv(sqe, fixed_file_slot >= 0 ? fixed_file_slot : fd_,
+                      &posix_handle->iov, 1, posix_handle->offset);
+  if (fixed_file_slot >= 0) {
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
 
   io_uring_sqe_set_data(sqe, posix_handle);
 
@@ -941,6 +1083,13 @@ PosixMmapReadableFile::PosixMmapReadableFile(const int fd,
 }
 
 PosixMmapReadableFile::~PosixMmapReadableFile() {
+#ifdef OS_LINUX
+  if (locked_length_ > 0) {
+    // Best effort; munmap() below drops any remaining lock anyway.
+    munlock(reinterpret_cast<char*>(mmapped_region_) + locked_offset_,
+            locked_length_);
+  }
+#endif
   int ret = munmap(mmapped_region_, length_);
   if (ret != 0) {
     fprintf(stdout, "failed to munmap %p length %" ROCKSDB_PRIszt " \n",
@@ -966,6 +1115,45 @@ IOStatus PosixMmapReadableFile::Read(uint64_t offset, size_t n,
   return s;
 }
 
+IOStatus PosixMmapReadableFile::Prefetch(uint64_t offset, size_t n,
+                                         const IOOptions& /*opts*/,
+                                         IODebugContext* /*dbg*/) {
+  if (offset > length_) {
+    return IOError("While mmap prefetch offset " + std::to_string(offset) +
+                       " larger than file length " + std::to_string(length_),
+                   filename_, EINVAL);
+  } else if (offset + n > length_) {
+    n = static_cast<size_t>(length_ - offset);
+  }
+  // Page-align the range and fault it in up front.
+  size_t aligned_off = static_cast<size_t>(offset) & ~(port::kPageSize - 1);
+  size_t aligned_len = ((static_cast<size_t>(offset) + n + port::kPageSize -
+                         1) &
+                        ~(port::kPageSize - 1)) -
+                       aligned_off;
+  char* addr = reinterpret_cast<char*>(mmapped_region_) + aligned_off;
+  Madvise(addr, aligned_len, POSIX_MADV_WILLNEED);
+#ifdef OS_LINUX
+  // The only caller that prefetches through the raw file in mmap mode is the
+  // table reader's tail prefetch on open, which covers the
+  // footer/metaindex/index/filter region. Pin that region so that metadata
+  // pages survive scans that cycle the rest of the mapping, and back it with
+  // huge pages where the kernel supports them. Both calls are best effort:
+  // mlock() may fail under RLIMIT_MEMLOCK and MADV_HUGEPAGE may be rejected
+  // for file mappings; prefetching still succeeded either way.
+  if (aligned_off + aligned_len >= length_ && locked_length_ == 0) {
+#ifdef MADV_HUGEPAGE
+    madvise(addr, aligned_len, MADV_HUGEPAGE);
+#endif
+    if (mlock(addr, aligned_len) == 0) {
+      locked_offset_ = aligned_off;
+      locked_length_ = aligned_len;
+    }
+  }
+#endif
+  return IOStatus::OK();
+}
+
 void PosixMmapReadableFile::Hint(AccessPattern pattern) {
   switch (pattern) {
     case kNormal:
@@ -981,7 +1169,10 @@ void PosixMmapReadableFile::Hint(AccessPattern pattern) {
       Madvise(mmapped_region_, length_, POSIX_MADV_WILLNEED);
       break;
     case kWontNeed:
-      Madvise(mmapped_region_, length_, POSIX_MADV_DONTNEED);
+      // Keep the pinned metadata tail; madvise() rejects mlock()ed pages.
+      Madvise(mmapped_region_,
+              locked_length_ > 0 ? locked_offset_ : length_,
+              POSIX_MADV_DONTNEED);
       break;
     default:
       assert(false);
@@ -995,6 +1186,22 @@ IOStatus PosixMmapReadableFile::InvalidateCache(size_t offset, size_t length) {
   (void)length;
   return IOStatus::OK();
 #else
+  // Drop the resident pages of the mapping itself (fadvise below only
+  // affects the page cache, not an established mapping). Skip the pinned
+  // metadata tail; mlock()ed pages would make madvise() fail with EINVAL.
+  size_t madv_off = offset & ~(port::kPageSize - 1);
+  size_t madv_end = std::min(
+      (offset + (length == 0 ? length_ - offset : length) + port::kPageSize -
+       1) &
+          ~(port::kPageSize - 1),
+      length_);
+  if (locked_length_ > 0 && madv_end > locked_offset_) {
+    madv_end = locked_offset_;
+  }
+  if (madv_end > madv_off) {
+    Madvise(reinterpret_cast<char*>(mmapped_region_) + madv_off,
+            madv_end - madv_off, POSIX_MADV_DONTNEED);
+  }
   // free OS pages
   int ret = Fadvise(fd_, offset, length, POSIX_FADV_DONTNEED);
   if (ret == 0) {
@@ -1281,6 +1488,15 @@ PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   sync_file_range_supported_ = IsSyncFileRangeSupported(fd_);
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  write_iu_ = nullptr;
+  inflight_writes_ = 0;
+  if (options.use_io_uring_writes && !use_direct_io_) {
+    // If the ring cannot be created (old kernel, RLIMIT_MEMLOCK, ...) fall
+    // back silently to synchronous writes.
+    write_iu_ = CreateIOUring();
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
   assert(!options.use_mmap_writes);
 }
 
@@ -1291,6 +1507,65 @@ PosixWritableFile::~PosixWritableFile() {
   }
 }
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+namespace {
+// State owned by one in-flight async append; freed when its completion is
+// reaped. The data is copied because the caller may reuse its buffer as soon
+// as Append() returns.
+struct PosixAsyncWriteRequest {
+  std::string buf;
+  uint64_t offset;
+};
+
+// How often to retry io_uring_submit() before giving up on the ring.
+constexpr int kAsyncWriteSubmitAttempts = 3;
+}  // anonymous namespace
+
+// Reaps completions of async appends; with wait_all, blocks until none are
+// in flight. Short writes are completed synchronously with pwrite() since
+// the target range is known. Returns (and clears) the first error seen.
+IOStatus PosixWritableFile::DrainAsyncWrites(bool wait_all) {
+  while (inflight_writes_ > 0) {
+    struct io_uring_cqe* cqe = nullptr;
+    if (wait_all) {
+      if (io_uring_wait_cqe(write_iu_, &cqe) != 0) {
+        break;
+      }
+    } else if (io_uring_peek_cqe(write_iu_, &cqe) != 0) {
+      break;
+    }
+    auto* req = static_cast<PosixAsyncWriteRequest*>(io_uring_cqe_get_data(cqe));
+    if (cqe->res < 0) {
+      if (async_write_status_.ok()) {
+        async_write_status_ =
+            IOError("While appending (io_uring) to file", filename_,
+                    -cqe->res);
+      }
+    } else if (static_cast<size_t>(cqe->res) < req->buf.size()) {
+      // Finish the remainder of a short write synchronously.
+      size_t done = static_cast<size_t>(cqe->res);
+      if (!PosixPositionedWrite(fd_, req->buf.data() + done,
+                                req->buf.size() - done,
+                                static_cast<off_t>(req->offset + done))) {
+        if (async_write_status_.ok()) {
+          async_write_status_ = IOError(
+              "While completing short append (io_uring) to file", filename_,
+              errno);
+        }
+      }
+    }
+    delete req;
+    io_uring_cqe_seen(write_iu_, cqe);
+    --inflight_writes_;
+  }
+  IOStatus s = async_write_status_;
+  if (!s.ok()) {
+    async_write_status_ = IOStatus::OK();
+  }
+  return s;
+}
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
 IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
                                    IODebugContext* /*dbg*/) {
   if (use_direct_io()) {
@@ -1300,6 +1575,69 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   const char* src = data.data();
   size_t nbytes = data.size();
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    // Reap whatever has completed; block for one slot only when the ring is
+    // full so submission stays non-blocking in the common case.
+    IOStatus s = DrainAsyncWrites(inflight_writes_ >= kIoUringDepth);
+    if (!s.ok()) {
+      return s;
+    }
+    struct io_uring_sqe* sqe = io_uring_get_sqe(write_iu_);
+    if (sqe == nullptr) {
+      // Ring momentarily full; complete this request synchronously at the
+      // tracked offset (the fd's implicit offset is not advanced by the
+      // async writes).
+      if (!PosixPositionedWrite(fd_, src, nbytes,
+                                static_cast<off_t>(filesize_))) {
+        return IOError("While appending to file", filename_, errno);
+      }
+      filesize_ += nbytes;
+      return IOStatus::OK();
+    }
+    auto* req = new PosixAsyncWriteRequest;
+    req->buf.assign(src, nbytes);
+    req->offset = filesize_;
+    io_uring_prep_write(sqe, fd_, req->buf.data(),
+                        static_cast<unsigned>(req->buf.size()), req->offset);
+    io_uring_sqe_set_data(sqe, req);
+    // A failed submit (0 or -EAGAIN/-EBUSY) leaves the prepared SQE queued
+    // in the submission ring. The request must not be torn down while that
+    // SQE exists: a later successful submit would push it with user_data
+    // and iov pointing at freed memory. Retry, and if the failure
+    // persists, retire the whole ring below.
+    ssize_t ret = io_uring_submit(write_iu_);
+    for (int attempt = 1; ret != 1 && attempt < kAsyncWriteSubmitAttempts;
+         ++attempt) {
+      ret = io_uring_submit(write_iu_);
+    }
+    if (ret == 1) {
+      ++inflight_writes_;
+      filesize_ += nbytes;
+      return IOStatus::OK();
+    }
+    // Reap the writes already in flight (waiting for completions never
+    // submits the pending SQE), then tear the ring down, taking the stale
+    // SQE with it; the file continues with synchronous writes.
+    IOStatus drain_status = DrainAsyncWrites(true /* wait_all */);
+    io_uring_queue_exit(write_iu_);
+    delete write_iu_;
+    write_iu_ = nullptr;
+    delete req;
+    if (!drain_status.ok()) {
+      return drain_status;
+    }
+    // The implicit file offset was never advanced while the ring was in
+    // use; move it to the logical end so this and later appends continue
+    // from the right place.
+    if (lseek(fd_, static_cast<off_t>(filesize_), SEEK_SET) < 0) {
+      return IOError("While seeking after retiring io_uring writes",
+                     filename_, errno);
+    }
+    // Fall through to the synchronous append below.
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
   if (!PosixWrite(fd_, src, nbytes)) {
     return IOError("While appending to file", filename_, errno);
   }
@@ -1330,6 +1668,14 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
 IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
                                      IODebugContext* /*dbg*/) {
   IOStatus s;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    s = DrainAsyncWrites(true /* wait_all */);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
   int r = ftruncate(fd_, size);
   if (r < 0) {
     s = IOError("While ftruncate file to size " + std::to_string(size),
@@ -1344,6 +1690,20 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
   IOStatus s;
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    s = DrainAsyncWrites(true /* wait_all */);
+    io_uring_queue_exit(write_iu_);
+    delete write_iu_;
+    write_iu_ = nullptr;
+    if (!s.ok()) {
+      close(fd_);
+      fd_ = -1;
+      return s;
+    }
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
   size_t block_size;
   size_t last_allocated_block;
   GetPreallocationStatus(&block_size, &last_allocated_block);
@@ -1398,6 +1758,14 @@ IOStatus PosixWritableFile::Flush(const IOOptions& /*opts*/,
 
 IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
                                  IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    IOStatus s = DrainAsyncWrites(true /* wait_all */);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1412,6 +1780,14 @@ IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
 
 IOStatus PosixWritableFile::Fsync(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    IOStatus s = DrainAsyncWrites(true /* wait_all */);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1494,6 +1870,14 @@ IOStatus PosixWritableFile::Allocate(uint64_t offset, uint64_t len,
 IOStatus PosixWritableFile::RangeSync(uint64_t offset, uint64_t nbytes,
                                       const IOOptions& opts,
                                       IODebugContext* dbg) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    IOStatus s = DrainAsyncWrites(true /* wait_all */);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
   assert(nbytes <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
@@ -1628,6 +2012,29 @@ IOStatus PosixRandomRWFile::Close(const IOOptions& /*opts*/,
   return IOStatus::OK();
 }
 
+IOStatus PosixRandomRWFile::PunchHole(uint64_t offset, uint64_t length,
+                                      const IOOptions& /*opts*/,
+                                      IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_FALLOCATE_PRESENT) && defined(FALLOC_FL_PUNCH_HOLE)
+  // FALLOC_FL_KEEP_SIZE keeps the file size unchanged; the deallocated
+  // range reads back as zeros.
+  if (fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                static_cast<off_t>(offset), static_cast<off_t>(length)) != 0) {
+    if (errno == EOPNOTSUPP) {
+      return IOStatus::NotSupported(
+          "File system does not support punching holes");
+    }
+    return IOError("While punching hole in random read/write file", filename_,
+                   errno);
+  }
+  return IOStatus::OK();
+#else
+  (void)offset;
+  (void)length;
+  return IOStatus::NotSupported("PunchHole is not supported on this platform");
+#endif
+}
+
 PosixMemoryMappedFileBuffer::~PosixMemoryMappedFileBuffer() {
   // TODO should have error handling though not much we can do...
   munmap(this->base_, length_);
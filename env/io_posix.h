@@ -14,6 +14,7 @@
 #endif
 #include <unistd.h>
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <map>
@@ -67,6 +68,8 @@ inline bool IsSectorAligned(const void* ptr, size_t sector_size) {
 #endif
 
 #if defined(ROCKSDB_IOURING_PRESENT)
+class PosixIoUringReactor;
+
 struct Posix_IOHandle {
   Posix_IOHandle(struct io_uring* _iu,
                  std::function<void(const FSReadRequest&, void*)> _cb,
@@ -95,6 +98,13 @@ struct Posix_IOHandle {
   bool is_finished;
   // req_count is used by AbortIO API to keep track of number of requests.
   uint32_t req_count;
+  // Non-null when the request was submitted through the shared completion
+  // reactor rather than the caller's thread-local ring; iu is then null.
+  PosixIoUringReactor* reactor = nullptr;
+  // Set by the reactor thread once this request's cqe has been reaped;
+  // both fields are protected by the reactor's mutex.
+  bool reaped = false;
+  int32_t cqe_res = 0;
 };
 
 inline void UpdateResult(struct io_uring_cqe* cqe, const std::string& file_name,
@@ -256,6 +266,23 @@ class PosixSequentialFile : public FSSequentialFile {
 // io_uring instance queue depth
 const unsigned int kIoUringDepth = 256;
 
+// Number of slots in the fixed file table registered with each read ring.
+const unsigned int kIoUringNumRegisteredFiles = 64;
+
+// Applications can define this symbol (returning true) to request SQPOLL
+// mode for the thread-local read rings: the kernel starts a submission
+// queue polling thread per ring, so batches are picked up without an
+// io_uring_enter() syscall per submission. Analogous to
+// RocksDbIOUringEnable(); defaults to off since SQPOLL needs elevated
+// privileges (or a recent kernel) and a dedicated kernel thread per ring.
+extern "C" bool RocksDbIOUringSqpollEnable() __attribute__((__weak__));
+
+// Applications can define this symbol (returning true) to route ReadAsync
+// requests through a single per-FileSystem reactor thread that owns a
+// dedicated io_uring and reaps all completions, instead of every waiter
+// polling its own thread-local ring. See PosixIoUringReactor.
+extern "C" bool RocksDbIOUringReactorEnable() __attribute__((__weak__));
+
 inline void DeleteIOUring(void* p) {
   struct io_uring* iu = static_cast<struct io_uring*>(p);
   delete iu;
@@ -270,6 +297,149 @@ inline struct io_uring* CreateIOUring() {
   }
   return new_io_uring;
 }
+
+// A thread-local read ring plus the state of the fixed file table
+// registered with it. Registering a table file descriptor once per ring
+// lets every later submission for that file carry IOSQE_FIXED_FILE, which
+// skips the per-request fdget/fdput in the kernel and is what allows the
+// SQPOLL thread to issue IO on kernels that predate unregistered-file
+// support in polling mode.
+struct IoUringCtx {
+  struct io_uring ring;
+
+  // False when the kernel rejected the file table at ring creation;
+  // submissions then always use plain fds.
+  bool fixed_files_supported = false;
+
+  // Returns the fixed-file slot holding fd, registering it (and possibly
+  // displacing another file) if needed, or -1 if fixed files are
+  // unavailable and the caller must submit the plain fd. dev/ino guard
+  // against fd number reuse: a registered slot pins the original open file
+  // description in the kernel, so a recycled fd number must not be taken
+  // for the file that was registered under it. Displaced slots are updated
+  // safely even with requests in flight (the kernel resolves a fixed file
+  // at submission time), but a slot does keep its file alive until it is
+  // reused, so at most kIoUringNumRegisteredFiles deleted files per ring
+  // can linger on disk until their slots rotate out.
+  int RegisterFd(int fd, uint64_t dev, uint64_t ino) {
+    if (!fixed_files_supported) {
+      return -1;
+    }
+    for (unsigned int i = 0; i < kIoUringNumRegisteredFiles; i++) {
+      if (files_[i].fd == fd && files_[i].dev == dev && files_[i].ino == ino) {
+        return static_cast<int>(i);
+      }
+    }
+    unsigned int slot = next_slot_;
+    if (io_uring_register_files_update(&ring, slot, &fd, 1) != 1) {
+      // e.g. a kernel without IORING_REGISTER_FILES_UPDATE
+      fixed_files_supported = false;
+      return -1;
+    }
+    next_slot_ = (next_slot_ + 1) % kIoUringNumRegisteredFiles;
+    files_[slot] = {fd, dev, ino};
+    return static_cast<int>(slot);
+  }
+
+ private:
+  struct RegisteredFile {
+    int fd = -1;
+    uint64_t dev = 0;
+    uint64_t ino = 0;
+  };
+  std::array<RegisteredFile, kIoUringNumRegisteredFiles> files_;
+  // Round-robin cursor for displacing slots once the table is full.
+  unsigned int next_slot_ = 0;
+};
+
+inline void DeleteIoUringCtx(void* p) {
+  IoUringCtx* ctx = static_cast<IoUringCtx*>(p);
+  io_uring_queue_exit(&ctx->ring);
+  delete ctx;
+}
+
+inline IoUringCtx* CreateIoUringCtx() {
+  IoUringCtx* ctx = new IoUringCtx();
+  bool sqpoll = RocksDbIOUringSqpollEnable && RocksDbIOUringSqpollEnable();
+  int ret = -1;
+  if (sqpoll) {
+    struct io_uring_params params = {};
+    params.flags = IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = 2000;  // ms idle before the SQ thread sleeps
+    ret = io_uring_queue_init_params(kIoUringDepth, &ctx->ring, &params);
+  }
+  if (ret) {
+    // SQPOLL not requested, or it needs privileges/kernel support we lack.
+    sqpoll = false;
+    ret = io_uring_queue_init(kIoUringDepth, &ctx->ring, 0);
+  }
+  if (ret) {
+    delete ctx;
+    return nullptr;
+  }
+  // Register an empty (all -1) fixed file table up front; individual fds
+  // are installed later with io_uring_register_files_update().
+  std::array<int, kIoUringNumRegisteredFiles> empty_fds;
+  empty_fds.fill(-1);
+  if (io_uring_register_files(&ctx->ring, empty_fds.data(),
+                              kIoUringNumRegisteredFiles) == 0) {
+    ctx->fixed_files_supported = true;
+  } else if (sqpoll) {
+    // Kernels old enough to reject a sparse file table also require fixed
+    // files for SQPOLL submissions; fall back to a plain ring instead.
+    io_uring_queue_exit(&ctx->ring);
+    if (io_uring_queue_init(kIoUringDepth, &ctx->ring, 0)) {
+      delete ctx;
+      return nullptr;
+    }
+  }
+  return ctx;
+}
+
+// A single background thread owning a dedicated io_uring for ReadAsync
+// requests. Submissions from any thread are serialized on the reactor's
+// mutex and the reactor thread blocks in io_uring_wait_cqe(), parking each
+// completion's result in its Posix_IOHandle and waking waiters, so
+// thousands of requests can be in flight without every waiter running its
+// own poll loop. Backpressure is built in: SubmitRead() blocks while the
+// ring is at capacity (kIoUringDepth requests in flight).
+//
+// Result finalization (UpdateResult and the user callback) deliberately
+// stays in the waiting thread, inside Poll()/AbortIO(), so callers such as
+// FilePrefetchBuffer keep the same threading semantics as the
+// thread-local-ring path.
+class PosixIoUringReactor {
+ public:
+  // Returns nullptr if the ring or thread could not be created.
+  static PosixIoUringReactor* TryCreate();
+  ~PosixIoUringReactor();
+
+  // No copying: the reactor thread holds `this`.
+  PosixIoUringReactor(const PosixIoUringReactor&) = delete;
+  PosixIoUringReactor& operator=(const PosixIoUringReactor&) = delete;
+
+  // Submits handle's readv against fd. Blocks while kIoUringDepth requests
+  // are already in flight. The handle must stay alive until its completion
+  // has been consumed through WaitForCompletion().
+  IOStatus SubmitRead(int fd, Posix_IOHandle* handle);
+
+  // Blocks until the reactor has reaped handle's completion; on return
+  // handle->cqe_res is valid and the caller finalizes the request.
+  void WaitForCompletion(Posix_IOHandle* handle);
+
+ private:
+  PosixIoUringReactor();
+  void Run();
+
+  struct io_uring ring_;
+  port::Mutex mu_;
+  // Signaled when inflight_ drops below the ring capacity.
+  port::CondVar submit_cv_;
+  // Broadcast whenever a completion has been reaped.
+  port::CondVar complete_cv_;
+  size_t inflight_ = 0;
+  port::Thread thread_;
+};
 #endif  // defined(ROCKSDB_IOURING_PRESENT)
 
 class PosixRandomAccessFile : public FSRandomAccessFile {
@@ -280,6 +450,9 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
   size_t logical_sector_size_;
 #if defined(ROCKSDB_IOURING_PRESENT)
   ThreadLocalPtr* thread_local_io_urings_;
+  // Shared completion reactor for ReadAsync; null when disabled, in which
+  // case ReadAsync submits to the thread-local ring.
+  PosixIoUringReactor* io_uring_reactor_;
 #endif
 
  public:
@@ -288,7 +461,8 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
                         const EnvOptions& options
 #if defined(ROCKSDB_IOURING_PRESENT)
                         ,
-                        ThreadLocalPtr* thread_local_io_urings
+                        ThreadLocalPtr* thread_local_io_urings,
+                        PosixIoUringReactor* io_uring_reactor
 #endif
   );
   virtual ~PosixRandomAccessFile();
@@ -313,6 +487,11 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
   virtual size_t GetRequiredBufferAlignment() const override {
     return logical_sector_size_;
   }
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // Resolves the ring's fixed-file slot for fd_, registering it on first
+  // use; -1 means submissions must carry the plain fd.
+  int GetFixedFileSlot(IoUringCtx* ctx) const;
+#endif
   // EXPERIMENTAL
   virtual IOStatus ReadAsync(
       FSReadRequest& req, const IOOptions& opts,
@@ -336,6 +515,19 @@ class PosixWritableFile : public FSWritableFile {
   // support it, so we need to do a dynamic check too.
   bool sync_file_range_supported_;
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // Non-null iff EnvOptions::use_io_uring_writes was set and the ring could
+  // be created. Appends are then submitted asynchronously and completions
+  // are reaped lazily; DrainAsyncWrites(true) is called wherever the file
+  // contents must be stable (sync, truncate, range-sync, close).
+  struct io_uring* write_iu_;
+  // Number of submitted but not yet reaped write requests.
+  size_t inflight_writes_;
+  // First error observed on a completed async write; sticky until surfaced.
+  IOStatus async_write_status_;
+
+  IOStatus DrainAsyncWrites(bool wait_all);
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
 
  public:
   explicit PosixWritableFile(const std::string& fname, int fd,
@@ -396,6 +588,12 @@ class PosixMmapReadableFile : public FSRandomAccessFile {
   std::string filename_;
   void* mmapped_region_;
   size_t length_;
+  // Page-aligned tail subrange pinned with mlock() by Prefetch(); table
+  // readers prefetch the footer/metaindex/index/filter tail on open, and
+  // pinning it keeps metadata pages resident while large scans recycle the
+  // rest of the mapping. Unpinned in the destructor.
+  size_t locked_offset_ = 0;
+  size_t locked_length_ = 0;
 
  public:
   PosixMmapReadableFile(const int fd, const std::string& fname, void* base,
@@ -403,6 +601,8 @@ class PosixMmapReadableFile : public FSRandomAccessFile {
   virtual ~PosixMmapReadableFile();
   IOStatus Read(uint64_t offset, size_t n, const IOOptions& opts, Slice* result,
                 char* scratch, IODebugContext* dbg) const override;
+  IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& opts,
+                    IODebugContext* dbg) override;
   void Hint(AccessPattern pattern) override;
   IOStatus InvalidateCache(size_t offset, size_t length) override;
 };
@@ -486,6 +686,10 @@ class PosixRandomRWFile : public FSRandomRWFile {
   virtual IOStatus Fsync(const IOOptions& opts, IODebugContext* dbg) override;
   virtual IOStatus Close(const IOOptions& opts, IODebugContext* dbg) override;
 
+  virtual IOStatus PunchHole(uint64_t offset, uint64_t length,
+                             const IOOptions& opts,
+                             IODebugContext* dbg) override;
+
  private:
   const std::string filename_;
   int fd_;
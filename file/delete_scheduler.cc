@@ -228,6 +228,13 @@ void DeleteScheduler::BackgroundEmptyTrash() {
     uint64_t start_time = clock_->NowMicros();
     uint64_t total_deleted_bytes = 0;
     int64_t current_delete_rate = rate_bytes_per_sec_.load();
+    // Directories with deleted files whose fsync is still outstanding.
+    // Syncs are batched (see kMaxFilesPerDirSync) instead of issued after
+    // every unlink; a crash can at worst resurrect directory entries of
+    // already-unlinked trash files, which CleanupDirectory() removes on
+    // the next DB open.
+    std::set<std::string> dirs_pending_sync;
+    int deletes_since_dir_sync = 0;
     while (!queue_.empty() && !closing_) {
       if (current_delete_rate != rate_bytes_per_sec_.load()) {
         // User changed the delete rate
@@ -247,9 +254,12 @@ void DeleteScheduler::BackgroundEmptyTrash() {
       uint64_t deleted_bytes = 0;
       bool is_complete = true;
       // Delete file from trash and update total_penlty value
-      Status s =
-          DeleteTrashFile(path_in_trash, fad.dir, &deleted_bytes, &is_complete);
+      Status s = DeleteTrashFile(path_in_trash, fad.dir, &deleted_bytes,
+                                 &is_complete, &dirs_pending_sync);
       total_deleted_bytes += deleted_bytes;
+      if (is_complete) {
+        ++deletes_since_dir_sync;
+      }
       mu_.Lock();
       if (is_complete) {
         queue_.pop();
@@ -259,6 +269,18 @@ void DeleteScheduler::BackgroundEmptyTrash() {
         bg_errors_[path_in_trash] = s;
       }
 
+      // Flush the batched directory syncs once enough files were unlinked
+      // or the queue drained, and always before pending_files_ can reach
+      // zero below so WaitForEmptyTrash() returns with the syncs done.
+      if (!dirs_pending_sync.empty() &&
+          (queue_.empty() || closing_ ||
+           deletes_since_dir_sync >= kMaxFilesPerDirSync)) {
+        mu_.Unlock();
+        SyncDirsOfDeletedFiles(&dirs_pending_sync);
+        mu_.Lock();
+        deletes_since_dir_sync = 0;
+      }
+
       // Apply penalty if necessary
       uint64_t total_penalty;
       if (current_delete_rate > 0) {
@@ -290,13 +312,19 @@ void DeleteScheduler::BackgroundEmptyTrash() {
         cv_.SignalAll();
       }
     }
+    if (!dirs_pending_sync.empty()) {
+      // The loop was cut short by closing_; don't leave syncs behind.
+      mu_.Unlock();
+      SyncDirsOfDeletedFiles(&dirs_pending_sync);
+      mu_.Lock();
+    }
   }
 }
 
-Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
-                                        const std::string& dir_to_sync,
-                                        uint64_t* deleted_bytes,
-                                        bool* is_complete) {
+Status DeleteScheduler::DeleteTrashFile(
+    const std::string& path_in_trash, const std::string& dir_to_sync,
+    uint64_t* deleted_bytes, bool* is_complete,
+    std::set<std::string>* dirs_pending_sync) {
   uint64_t file_size;
   Status s = fs_->GetFileSize(path_in_trash, IOOptions(), &file_size, nullptr);
   *is_complete = true;
@@ -351,21 +379,11 @@ Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
 
     if (need_full_delete) {
       s = fs_->DeleteFile(path_in_trash, IOOptions(), nullptr);
-      if (!dir_to_sync.empty()) {
-        std::unique_ptr<FSDirectory> dir_obj;
-        if (s.ok()) {
-          s = fs_->NewDirectory(dir_to_sync, IOOptions(), &dir_obj, nullptr);
-        }
-        if (s.ok()) {
-          s = dir_obj->FsyncWithDirOptions(
-              IOOptions(), nullptr,
-              DirFsyncOptions(DirFsyncOptions::FsyncReason::kFileDeleted));
-          TEST_SYNC_POINT_CALLBACK(
-              "DeleteScheduler::DeleteTrashFile::AfterSyncDir",
-              reinterpret_cast<void*>(const_cast<std::string*>(&dir_to_sync)));
-        }
-      }
       if (s.ok()) {
+        if (!dir_to_sync.empty()) {
+          // The directory sync is batched; see BackgroundEmptyTrash().
+          dirs_pending_sync->insert(dir_to_sync);
+        }
         *deleted_bytes = file_size;
         s = sst_file_manager_->OnDeleteFile(path_in_trash);
       }
@@ -383,6 +401,29 @@ Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
   return s;
 }
 
+void DeleteScheduler::SyncDirsOfDeletedFiles(std::set<std::string>* dirs) {
+  for (const std::string& dir_to_sync : *dirs) {
+    std::unique_ptr<FSDirectory> dir_obj;
+    Status s = fs_->NewDirectory(dir_to_sync, IOOptions(), &dir_obj, nullptr);
+    if (s.ok()) {
+      s = dir_obj->FsyncWithDirOptions(
+          IOOptions(), nullptr,
+          DirFsyncOptions(DirFsyncOptions::FsyncReason::kFileDeleted));
+    }
+    if (s.ok()) {
+      TEST_SYNC_POINT_CALLBACK(
+          "DeleteScheduler::DeleteTrashFile::AfterSyncDir",
+          reinterpret_cast<void*>(const_cast<std::string*>(&dir_to_sync)));
+    } else {
+      ROCKS_LOG_ERROR(info_log_, "Failed to sync directory %s -- %s",
+                      dir_to_sync.c_str(), s.ToString().c_str());
+      InstrumentedMutexLock l(&mu_);
+      bg_errors_[dir_to_sync] = s;
+    }
+  }
+  dirs->clear();
+}
+
 void DeleteScheduler::WaitForEmptyTrash() {
   InstrumentedMutexLock l(&mu_);
   while (pending_files_ > 0 && !closing_) {
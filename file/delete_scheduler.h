@@ -9,6 +9,7 @@
 
 #include <map>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
 
@@ -80,6 +81,11 @@ class DeleteScheduler {
   static const std::string kTrashExtension;
   static bool IsTrashFile(const std::string& file_path);
 
+  // Directory fsyncs for deleted trash files are batched: one sync per
+  // affected directory per this many deletions (or per queue drain,
+  // whichever comes first) instead of one sync per file.
+  static constexpr int kMaxFilesPerDirSync = 32;
+
   // Check if there are any .trash files in path, and schedule their deletion
   // Or delete immediately if sst_file_manager is nullptr
   static Status CleanupDirectory(Env* env, SstFileManagerImpl* sfm,
@@ -95,7 +101,12 @@ class DeleteScheduler {
 
   Status DeleteTrashFile(const std::string& path_in_trash,
                          const std::string& dir_to_sync,
-                         uint64_t* deleted_bytes, bool* is_complete);
+                         uint64_t* deleted_bytes, bool* is_complete,
+                         std::set<std::string>* dirs_pending_sync);
+
+  // Fsync every directory in *dirs and clear the set. Called with mu_
+  // unlocked; sync errors are recorded in bg_errors_ under mu_.
+  void SyncDirsOfDeletedFiles(std::set<std::string>* dirs);
 
   void BackgroundEmptyTrash();
 
@@ -182,7 +182,12 @@ TEST_F(DeleteSchedulerTest, BasicRateLimiting) {
     }
     ASSERT_GT(time_spent_deleting, expected_penlty * 0.9);
 
-    ASSERT_EQ(num_files, dir_synced);
+    // Directory syncs are batched: one per kMaxFilesPerDirSync deletions
+    // (plus one for the final partial batch).
+    int expected_dir_syncs =
+        (num_files + DeleteScheduler::kMaxFilesPerDirSync - 1) /
+        DeleteScheduler::kMaxFilesPerDirSync;
+    ASSERT_EQ(expected_dir_syncs, dir_synced);
 
     ASSERT_EQ(CountTrashFiles(), 0);
     ASSERT_EQ(num_files, stats_->getAndResetTickerCount(FILES_MARKED_TRASH));
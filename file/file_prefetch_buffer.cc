@@ -119,12 +119,16 @@ Status FilePrefetchBuffer::ReadAsync(const IOOptions& opts,
   req.offset = rounddown_start + chunk_len;
   req.result = result;
   req.scratch = bufs_[index].buffer_.BufferStart() + chunk_len;
-  Status s = reader->ReadAsync(req, opts, fp,
-                               /*cb_arg=*/nullptr, &io_handle_, &del_fn_,
-                               /*aligned_buf=*/nullptr);
+  // The index of the buffer being filled is passed through cb_arg so the
+  // callback knows which ring buffer the completion belongs to.
+  Status s = reader->ReadAsync(
+      req, opts, fp,
+      /*cb_arg=*/reinterpret_cast<void*>(static_cast<uintptr_t>(index)),
+      &bufs_[index].io_handle_, &bufs_[index].del_fn_,
+      /*aligned_buf=*/nullptr);
   req.status.PermitUncheckedError();
   if (s.ok()) {
-    async_read_in_progress_ = true;
+    bufs_[index].async_read_in_progress_ = true;
   }
   return s;
 }
@@ -162,7 +166,7 @@ Status FilePrefetchBuffer::Prefetch(const IOOptions& opts,
   return s;
 }
 
-// Copy data from src to third buffer.
+// Copy data from src to the overlap buffer (index num_buffers_).
 void FilePrefetchBuffer::CopyDataToBuffer(uint32_t src, uint64_t& offset,
                                           size_t& length) {
   if (length == 0) {
@@ -178,10 +182,11 @@ void FilePrefetchBuffer::CopyDataToBuffer(uint32_t src, uint64_t& offset,
     copy_len = bufs_[src].buffer_.CurrentSize() - copy_offset;
   }
 
-  memcpy(bufs_[2].buffer_.BufferStart() + bufs_[2].buffer_.CurrentSize(),
+  AlignedBuffer& overlap_buf = bufs_[num_buffers_].buffer_;
+  memcpy(overlap_buf.BufferStart() + overlap_buf.CurrentSize(),
          bufs_[src].buffer_.BufferStart() + copy_offset, copy_len);
 
-  bufs_[2].buffer_.Size(bufs_[2].buffer_.CurrentSize() + copy_len);
+  overlap_buf.Size(overlap_buf.CurrentSize() + copy_len);
 
   // Update offset and length.
   offset += copy_len;
@@ -194,75 +199,125 @@ void FilePrefetchBuffer::CopyDataToBuffer(uint32_t src, uint64_t& offset,
   }
 }
 
-void FilePrefetchBuffer::PollAndUpdateBuffersIfNeeded(uint64_t offset) {
-  if (async_read_in_progress_ && fs_ != nullptr) {
+void FilePrefetchBuffer::PollBuffer(uint32_t index) {
+  if (bufs_[index].async_read_in_progress_ && fs_ != nullptr) {
     // Wait for prefetch data to complete.
-    // No mutex is needed as PrefetchAsyncCallback updates the result in second
-    // buffer and FilePrefetchBuffer should wait for Poll before accessing the
-    // second buffer.
+    // No mutex is needed as PrefetchAsyncCallback updates the result in the
+    // buffer being filled and FilePrefetchBuffer waits for Poll before
+    // accessing that buffer.
     std::vector<void*> handles;
-    handles.emplace_back(io_handle_);
+    handles.emplace_back(bufs_[index].io_handle_);
     StopWatch sw(clock_, stats_, POLL_WAIT_MICROS);
     fs_->Poll(handles, 1).PermitUncheckedError();
   }
 
-  // Reset and Release io_handle_ after the Poll API as request has been
-  // completed.
-  async_read_in_progress_ = false;
-  if (io_handle_ != nullptr && del_fn_ != nullptr) {
-    del_fn_(io_handle_);
-    io_handle_ = nullptr;
-    del_fn_ = nullptr;
-  }
+  // Reset and release the io handle after the Poll API as the request has
+  // been completed.
+  bufs_[index].async_read_in_progress_ = false;
+  ReleaseIOHandle(index);
+}
 
-  // Index of second buffer.
-  uint32_t second = curr_ ^ 1;
+void FilePrefetchBuffer::PollAllBuffers() {
+  for (uint32_t i = 0; i < num_buffers_; ++i) {
+    if (bufs_[i].async_read_in_progress_) {
+      PollBuffer(i);
+    }
+  }
+}
 
-  // First clear the buffers if it contains outdated data. Outdated data can be
-  // because previous sequential reads were read from the cache instead of these
-  // buffer.
-  {
-    if (bufs_[curr_].buffer_.CurrentSize() > 0 &&
-        offset >= bufs_[curr_].offset_ + bufs_[curr_].buffer_.CurrentSize()) {
-      bufs_[curr_].buffer_.Clear();
+void FilePrefetchBuffer::PollAndUpdateBuffersIfNeeded(uint64_t offset,
+                                                      size_t length) {
+  for (uint32_t step = 0; step < num_buffers_; ++step) {
+    BufferInfo& buf = bufs_[curr_];
+    if (buf.async_read_in_progress_) {
+      // Either the read covers part of the request, or the request is behind
+      // every prefetched range (a non sequential access). In both cases wait
+      // for it so that curr_ is never left with a read in flight; reads into
+      // the buffers further along the ring stay outstanding.
+      PollBuffer(curr_);
+    }
+    if (buf.buffer_.CurrentSize() > 0 &&
+        offset >= buf.offset_ + buf.buffer_.CurrentSize()) {
+      // The consumer has moved past this buffer. This can happen when
+      // previous sequential reads were served from the block cache instead
+      // of these buffers.
+      buf.buffer_.Clear();
+      curr_ = NextBuffer(curr_);
+      continue;
     }
-    if (bufs_[second].buffer_.CurrentSize() > 0 &&
-        offset >= bufs_[second].offset_ + bufs_[second].buffer_.CurrentSize()) {
-      bufs_[second].buffer_.Clear();
+    if (buf.buffer_.CurrentSize() == 0) {
+      // Nothing was read into this buffer; the next ring buffer may hold the
+      // prefetched data.
+      curr_ = NextBuffer(curr_);
+      continue;
     }
+    // curr_ holds data at or beyond offset. The request may extend into the
+    // next buffer; make sure that read has completed before the caller
+    // inspects it.
+    uint32_t next = NextBuffer(curr_);
+    if (bufs_[next].async_read_in_progress_ &&
+        bufs_[next].offset_ < offset + length) {
+      PollBuffer(next);
+    }
+    return;
   }
+}
 
-  // If data is in second buffer, make it curr_. Second buffer can be either
-  // partial filled or full.
-  if (bufs_[second].buffer_.CurrentSize() > 0 &&
-      offset >= bufs_[second].offset_ &&
-      offset < bufs_[second].offset_ + bufs_[second].buffer_.CurrentSize()) {
-    // Clear the curr_ as buffers have been swapped and curr_ contains the
-    // outdated data and switch the buffers.
-    bufs_[curr_].buffer_.Clear();
-    curr_ = curr_ ^ 1;
+void FilePrefetchBuffer::ScheduleAsyncPrefetches(const IOOptions& opts,
+                                                 RandomAccessFileReader* reader,
+                                                 uint64_t next_start,
+                                                 size_t per_buffer_len,
+                                                 size_t alignment) {
+  // Walk the ring in order after curr_: buffers already holding data or with
+  // a read in flight extend the covered range; empty ones are scheduled to
+  // read the next chunk. This keeps ring order equal to file offset order,
+  // which PollAndUpdateBuffersIfNeeded relies on.
+  for (uint32_t i = NextBuffer(curr_); i != curr_; i = NextBuffer(i)) {
+    BufferInfo& buf = bufs_[i];
+    if (buf.async_read_in_progress_) {
+      next_start = std::max(next_start, buf.offset_ + buf.async_req_len_);
+      continue;
+    }
+    if (buf.buffer_.CurrentSize() > 0) {
+      next_start =
+          std::max(next_start, buf.offset_ + buf.buffer_.CurrentSize());
+      continue;
+    }
+    uint64_t rounddown_start = next_start;
+    uint64_t roundup_end = Roundup(rounddown_start + per_buffer_len, alignment);
+    uint64_t roundup_len = roundup_end - rounddown_start;
+    uint64_t chunk_len = 0;
+    CalculateOffsetAndLen(alignment, rounddown_start, roundup_len, i,
+                          false /*refit_tail*/, chunk_len);
+    buf.offset_ = rounddown_start;
+    buf.async_req_len_ = roundup_len;
+    assert(roundup_len >= chunk_len);
+    uint64_t read_len = static_cast<size_t>(roundup_len - chunk_len);
+    ReadAsync(opts, reader, read_len, chunk_len, rounddown_start, i)
+        .PermitUncheckedError();
+    next_start = roundup_end;
   }
 }
 
-// If async_read = true:
-// async_read is enabled in case of sequential reads. So when
-// buffers are switched, we clear the curr_ buffer as we assume the data has
-// been consumed because of sequential reads.
+// async_read is enabled in case of sequential reads. So when buffers are
+// advanced past, we clear them as we assume the data has been consumed
+// because of sequential reads.
 //
 // Scenarios for prefetching asynchronously:
-// Case1: If both buffers are empty, prefetch n bytes
-//        synchronously in curr_
-//        and prefetch readahead_size_/2 async in second buffer.
-// Case2: If second buffer has partial or full data, make it current and
-//        prefetch readahead_size_/2 async in second buffer. In case of
+// Case1: If all buffers are empty, prefetch n bytes synchronously in curr_
+//        and schedule readahead_size_/2 async reads in each free ring buffer
+//        after it.
+// Case2: If the buffer after curr_ has partial or full data, make it current
+//        and top up the free ring buffers with async reads. In case of
 //        partial data, prefetch remaining bytes from size n synchronously to
 //        fulfill the requested bytes request.
 // Case3: If curr_ has partial data, prefetch remaining bytes from size n
 //        synchronously in curr_ to fulfill the requested bytes request and
-//        prefetch readahead_size_/2 bytes async in second buffer.
-// Case4: If data is in both buffers, copy requested data from curr_ and second
-//        buffer to third buffer. If all requested bytes have been copied, do
-//        the asynchronous prefetching in second buffer.
+//        top up the free ring buffers with async reads.
+// Case4: If data overlaps curr_ and the next buffer, copy the requested data
+//        from both into the overlap buffer (index num_buffers_). If all
+//        requested bytes have been copied, only schedule asynchronous reads
+//        into the free ring buffers.
 Status FilePrefetchBuffer::PrefetchAsyncInternal(
     const IOOptions& opts, RandomAccessFileReader* reader, uint64_t offset,
     size_t length, size_t readahead_size, Env::IOPriority rate_limiter_priority,
@@ -273,7 +328,7 @@ Status FilePrefetchBuffer::PrefetchAsyncInternal(
 
   TEST_SYNC_POINT("FilePrefetchBuffer::PrefetchAsyncInternal:Start");
 
-  PollAndUpdateBuffersIfNeeded(offset);
+  PollAndUpdateBuffersIfNeeded(offset, length);
 
   // If all the requested bytes are in curr_, it will go for async prefetching
   // only.
@@ -296,42 +351,43 @@ Status FilePrefetchBuffer::PrefetchAsyncInternal(
   Status s;
   size_t prefetch_size = length + readahead_size;
   size_t alignment = reader->file()->GetRequiredBufferAlignment();
-  // Index of second buffer.
-  uint32_t second = curr_ ^ 1;
+  // Index of the ring buffer after curr_.
+  uint32_t next = NextBuffer(curr_);
 
   // Data is overlapping i.e. some of the data is in curr_ buffer and remaining
-  // in second buffer.
-  if (bufs_[curr_].buffer_.CurrentSize() > 0 &&
-      bufs_[second].buffer_.CurrentSize() > 0 &&
+  // in the next buffer. The next buffer's size must not be inspected while a
+  // read into it is still in flight.
+  if (!bufs_[next].async_read_in_progress_ &&
+      bufs_[curr_].buffer_.CurrentSize() > 0 &&
+      bufs_[next].buffer_.CurrentSize() > 0 &&
       offset >= bufs_[curr_].offset_ &&
       offset < bufs_[curr_].offset_ + bufs_[curr_].buffer_.CurrentSize() &&
-      offset + length > bufs_[second].offset_) {
-    // Allocate new buffer to third buffer;
-    bufs_[2].buffer_.Clear();
-    bufs_[2].buffer_.Alignment(alignment);
-    bufs_[2].buffer_.AllocateNewBuffer(length);
-    bufs_[2].offset_ = offset;
+      offset + length > bufs_[next].offset_) {
+    // Allocate the overlap buffer.
+    bufs_[num_buffers_].buffer_.Clear();
+    bufs_[num_buffers_].buffer_.Alignment(alignment);
+    bufs_[num_buffers_].buffer_.AllocateNewBuffer(length);
+    bufs_[num_buffers_].offset_ = offset;
     copy_to_third_buffer = true;
 
-    // Move data from curr_ buffer to third.
+    // Move data from curr_ buffer to the overlap buffer.
     CopyDataToBuffer(curr_, offset, length);
     if (length == 0) {
       // Requested data has been copied and curr_ still has unconsumed data.
       return s;
     }
-    CopyDataToBuffer(second, offset, length);
-    // Length == 0: All the requested data has been copied to third buffer. It
-    // should go for only async prefetching.
-    // Length > 0: More data needs to be consumed so it will continue async and
-    // sync prefetching and copy the remaining data to third buffer in the end.
-    // swap the buffers.
-    curr_ = curr_ ^ 1;
+    CopyDataToBuffer(next, offset, length);
+    // Length == 0: All the requested data has been copied to the overlap
+    // buffer. It should go for only async prefetching.
+    // Length > 0: More data needs to be consumed so it will continue async
+    // and sync prefetching and copy the remaining data to the overlap buffer
+    // in the end. Advance to the next ring buffer.
+    curr_ = next;
     // Update prefetch_size as length has been updated in CopyDataToBuffer.
     prefetch_size = length + readahead_size;
   }
 
   size_t _offset = static_cast<size_t>(offset);
-  second = curr_ ^ 1;
 
   // offset and size alignment for curr_ buffer with synchronous prefetching
   uint64_t rounddown_start1 = Rounddown(_offset, alignment);
@@ -350,31 +406,22 @@ Status FilePrefetchBuffer::PrefetchAsyncInternal(
     read_len1 = static_cast<size_t>(roundup_len1 - chunk_len1);
   }
   {
-    // offset and size alignment for second buffer for asynchronous
-    // prefetching
-    uint64_t rounddown_start2 = roundup_end1;
-    uint64_t roundup_end2 =
-        Roundup(rounddown_start2 + readahead_size, alignment);
-
-    // For length == 0, do the asynchronous prefetching in second instead of
-    // synchronous prefetching in curr_.
+    // Asynchronous prefetching in the ring buffers after curr_, starting
+    // where the synchronous read (or the data already in curr_) ends. Each
+    // free buffer covers the next readahead-sized chunk, keeping up to
+    // num_buffers_ - 1 reads in flight.
+    uint64_t next_start = roundup_end1;
+    size_t per_buffer_len = readahead_size;
+
+    // For length == 0, do the asynchronous prefetching right after the data
+    // in curr_ instead of synchronous prefetching in curr_.
     if (length == 0) {
-      rounddown_start2 =
-          bufs_[curr_].offset_ + bufs_[curr_].buffer_.CurrentSize();
-      roundup_end2 = Roundup(rounddown_start2 + prefetch_size, alignment);
+      next_start = bufs_[curr_].offset_ + bufs_[curr_].buffer_.CurrentSize();
+      per_buffer_len = prefetch_size;
     }
 
-    uint64_t roundup_len2 = roundup_end2 - rounddown_start2;
-    uint64_t chunk_len2 = 0;
-    CalculateOffsetAndLen(alignment, rounddown_start2, roundup_len2, second,
-                          false /*refit_tail*/, chunk_len2);
-
-    // Update the buffer offset.
-    bufs_[second].offset_ = rounddown_start2;
-    assert(roundup_len2 >= chunk_len2);
-    uint64_t read_len2 = static_cast<size_t>(roundup_len2 - chunk_len2);
-    ReadAsync(opts, reader, read_len2, chunk_len2, rounddown_start2, second)
-        .PermitUncheckedError();
+    ScheduleAsyncPrefetches(opts, reader, next_start, per_buffer_len,
+                            alignment);
   }
 
   if (read_len1 > 0) {
@@ -516,7 +563,7 @@ bool FilePrefetchBuffer::TryReadFromCacheAsync(
 
   uint32_t index = curr_;
   if (copy_to_third_buffer) {
-    index = 2;
+    index = num_buffers_;
   }
   uint64_t offset_in_buffer = offset - bufs_[index].offset_;
   *result = Slice(bufs_[index].buffer_.BufferStart() + offset_in_buffer, n);
@@ -528,8 +575,10 @@ bool FilePrefetchBuffer::TryReadFromCacheAsync(
 }
 
 void FilePrefetchBuffer::PrefetchAsyncCallback(const FSReadRequest& req,
-                                               void* /*cb_arg*/) {
-  uint32_t index = curr_ ^ 1;
+                                               void* cb_arg) {
+  uint32_t index =
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cb_arg));
+  assert(index < num_buffers_);
 
 #ifndef NDEBUG
   if (req.result.size() < req.len) {
@@ -567,10 +616,14 @@ Status FilePrefetchBuffer::PrefetchAsync(const IOOptions& opts,
   }
   TEST_SYNC_POINT("FilePrefetchBuffer::PrefetchAsync:Start");
 
-  PollAndUpdateBuffersIfNeeded(offset);
+  // PrefetchAsync can be called on non sequential reads, which restart the
+  // pipeline; wait for every read in flight so the ring buffers can be
+  // reused safely.
+  PollAllBuffers();
+  PollAndUpdateBuffersIfNeeded(offset, n);
 
-  // Index of second buffer.
-  uint32_t second = curr_ ^ 1;
+  // Index of the ring buffer after curr_.
+  uint32_t next = NextBuffer(curr_);
 
   // Since PrefetchAsync can be called on non sequential reads. So offset can
   // be less than buffers' offset. In that case it clears the buffer and
@@ -593,11 +646,14 @@ Status FilePrefetchBuffer::PrefetchAsync(const IOOptions& opts,
 
   // TODO akanksha: Handle the scenario if data is overlapping in 2 buffers.
   // Currently, tt covers 2 scenarios. Either one buffer (curr_) has no data or
-  // it has partial data. It ignores the contents in second buffer (overlapping
-  // data in 2 buffers) and send the request to re-read that data again.
+  // it has partial data. It ignores the contents in the other ring buffers
+  // (overlapping data) and sends the request to re-read that data again.
 
-  // Clear the second buffer in order to do asynchronous prefetching.
-  bufs_[second].buffer_.Clear();
+  // Clear the other ring buffers in order to restart asynchronous
+  // prefetching.
+  for (uint32_t i = NextBuffer(curr_); i != curr_; i = NextBuffer(i)) {
+    bufs_[i].buffer_.Clear();
+  }
 
   size_t offset_to_read = static_cast<size_t>(offset);
   uint64_t rounddown_start = 0;
@@ -620,16 +676,17 @@ Status FilePrefetchBuffer::PrefetchAsync(const IOOptions& opts,
   assert(roundup_len % alignment == 0);
 
   uint64_t chunk_len = 0;
-  CalculateOffsetAndLen(alignment, rounddown_start, roundup_len, second, false,
+  CalculateOffsetAndLen(alignment, rounddown_start, roundup_len, next, false,
                         chunk_len);
 
   // Update the buffer offset.
-  bufs_[second].offset_ = rounddown_start;
+  bufs_[next].offset_ = rounddown_start;
+  bufs_[next].async_req_len_ = roundup_len;
   assert(roundup_len >= chunk_len);
 
   size_t read_len = static_cast<size_t>(roundup_len - chunk_len);
 
-  s = ReadAsync(opts, reader, read_len, chunk_len, rounddown_start, second);
+  s = ReadAsync(opts, reader, read_len, chunk_len, rounddown_start, next);
 
   if (!s.ok()) {
     return s;
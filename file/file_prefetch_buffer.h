@@ -31,6 +31,15 @@ class RandomAccessFileReader;
 struct BufferInfo {
   AlignedBuffer buffer_;
   uint64_t offset_ = 0;
+  // Length of the read scheduled into this buffer, for buffers with an
+  // asynchronous read in flight. buffer_ must not be inspected until the
+  // request has been Poll-ed; the completion callback fills it in.
+  uint64_t async_req_len_ = 0;
+  // io_handle_ is allocated and used by underlying file system in case of
+  // asynchronous reads.
+  void* io_handle_ = nullptr;
+  IOHandleDeleter del_fn_ = nullptr;
+  bool async_read_in_progress_ = false;
 };
 
 // FilePrefetchBuffer is a smart buffer to store and read data from a file.
@@ -55,8 +64,12 @@ class FilePrefetchBuffer {
   // implicit_auto_readahead : Readahead is enabled implicitly by rocksdb after
   //   doing sequential scans for two times.
   // async_io : When async_io is enabled, if it's implicit_auto_readahead, it
-  //   prefetches data asynchronously in second buffer while curr_ is being
-  //   consumed.
+  //   prefetches data asynchronously in the buffers following curr_ while
+  //   curr_ is being consumed.
+  // num_buffers : number of buffers in the prefetch ring. With asynchronous
+  //   reads, up to num_buffers - 1 reads are kept in flight ahead of the
+  //   buffer being consumed, so the value controls the effective queue depth
+  //   on the device. Values below 2 are treated as 2.
   //
   // Automatic readhead is enabled for a file if readahead_size
   // and max_readahead_size are passed in.
@@ -66,8 +79,10 @@ class FilePrefetchBuffer {
                      bool enable = true, bool track_min_offset = false,
                      bool implicit_auto_readahead = false,
                      uint64_t num_file_reads = 0, FileSystem* fs = nullptr,
-                     SystemClock* clock = nullptr, Statistics* stats = nullptr)
+                     SystemClock* clock = nullptr, Statistics* stats = nullptr,
+                     size_t num_buffers = 2)
       : curr_(0),
+        num_buffers_(static_cast<uint32_t>(std::max(num_buffers, size_t{2}))),
         readahead_size_(readahead_size),
         initial_auto_readahead_size_(readahead_size),
         max_readahead_size_(max_readahead_size),
@@ -78,45 +93,45 @@ class FilePrefetchBuffer {
         prev_offset_(0),
         prev_len_(0),
         num_file_reads_(num_file_reads),
-        io_handle_(nullptr),
-        del_fn_(nullptr),
-        async_read_in_progress_(false),
         async_request_submitted_(false),
         fs_(fs),
         clock_(clock),
         stats_(stats) {
     assert((num_file_reads_ >= kMinNumFileReadsToStartAutoReadahead + 1) ||
            (num_file_reads_ == 0));
-    // If async_io_ is enabled, data is asynchronously filled in second buffer
-    // while curr_ is being consumed. If data is overlapping in two buffers,
-    // data is copied to third buffer to return continuous buffer.
-    bufs_.resize(3);
+    // If async_io_ is enabled, data is asynchronously filled in the ring
+    // buffers following curr_ while curr_ is being consumed. If data is
+    // overlapping in two buffers, data is copied to one extra buffer at the
+    // end (index num_buffers_) to return a continuous buffer.
+    bufs_.resize(num_buffers_ + 1);
   }
 
   ~FilePrefetchBuffer() {
-    // Abort any pending async read request before destroying the class object.
-    if (async_read_in_progress_ && fs_ != nullptr) {
+    // Abort any pending async read requests before destroying the class
+    // object.
+    if (fs_ != nullptr) {
       std::vector<void*> handles;
-      handles.emplace_back(io_handle_);
-      Status s = fs_->AbortIO(handles);
-      assert(s.ok());
+      for (uint32_t i = 0; i < num_buffers_; ++i) {
+        if (bufs_[i].async_read_in_progress_ &&
+            bufs_[i].io_handle_ != nullptr) {
+          handles.emplace_back(bufs_[i].io_handle_);
+        }
+      }
+      if (!handles.empty()) {
+        Status s = fs_->AbortIO(handles);
+        assert(s.ok());
+      }
     }
 
     // Prefetch buffer bytes discarded.
     uint64_t bytes_discarded = 0;
-    if (bufs_[curr_].buffer_.CurrentSize() != 0) {
-      bytes_discarded = bufs_[curr_].buffer_.CurrentSize();
-    }
-    if (bufs_[curr_ ^ 1].buffer_.CurrentSize() != 0) {
-      bytes_discarded += bufs_[curr_ ^ 1].buffer_.CurrentSize();
+    for (uint32_t i = 0; i < num_buffers_; ++i) {
+      bytes_discarded += bufs_[i].buffer_.CurrentSize();
     }
     RecordInHistogram(stats_, PREFETCHED_BYTES_DISCARDED, bytes_discarded);
 
-    // Release io_handle_.
-    if (io_handle_ != nullptr && del_fn_ != nullptr) {
-      del_fn_(io_handle_);
-      io_handle_ = nullptr;
-      del_fn_ = nullptr;
+    for (uint32_t i = 0; i < num_buffers_; ++i) {
+      ReleaseIOHandle(i);
     }
   }
 
@@ -227,10 +242,39 @@ class FilePrefetchBuffer {
                              size_t roundup_len, size_t index, bool refit_tail,
                              uint64_t& chunk_len);
 
-  // It calls Poll API if any there is any pending asynchronous request. It then
-  // checks if data is in any buffer. It clears the outdated data and swaps the
-  // buffers if required.
-  void PollAndUpdateBuffersIfNeeded(uint64_t offset);
+  uint32_t NextBuffer(uint32_t index) const {
+    return (index + 1) % num_buffers_;
+  }
+
+  // Waits for the asynchronous read into `index` (if any) to complete and
+  // releases its io handle.
+  void PollBuffer(uint32_t index);
+
+  // Waits for every in-flight asynchronous read to complete. Called on
+  // non-sequential access, where the pipeline is restarted from scratch.
+  void PollAllBuffers();
+
+  void ReleaseIOHandle(uint32_t index) {
+    if (bufs_[index].io_handle_ != nullptr && bufs_[index].del_fn_ != nullptr) {
+      bufs_[index].del_fn_(bufs_[index].io_handle_);
+      bufs_[index].io_handle_ = nullptr;
+      bufs_[index].del_fn_ = nullptr;
+    }
+  }
+
+  // Walks the ring starting at curr_, waiting for any in-flight read that may
+  // cover part of [offset, offset + length), dropping buffers the consumer
+  // has moved past and advancing curr_ to the first buffer that still holds
+  // useful data.
+  void PollAndUpdateBuffersIfNeeded(uint64_t offset, size_t length);
+
+  // Schedules asynchronous reads into every free ring buffer so that up to
+  // num_buffers_ - 1 reads are outstanding, each covering the next
+  // readahead chunk of the file starting at next_start.
+  void ScheduleAsyncPrefetches(const IOOptions& opts,
+                               RandomAccessFileReader* reader,
+                               uint64_t next_start, size_t per_buffer_len,
+                               size_t alignment);
 
   Status PrefetchAsyncInternal(const IOOptions& opts,
                                RandomAccessFileReader* reader, uint64_t offset,
@@ -246,7 +290,7 @@ class FilePrefetchBuffer {
                    uint64_t read_len, uint64_t chunk_len,
                    uint64_t rounddown_start, uint32_t index);
 
-  // Copy the data from src to third buffer.
+  // Copy the data from src to the overlap buffer (index num_buffers_).
   void CopyDataToBuffer(uint32_t src, uint64_t& offset, size_t& length);
 
   bool IsBlockSequential(const size_t& offset) {
@@ -285,8 +329,11 @@ class FilePrefetchBuffer {
 
   std::vector<BufferInfo> bufs_;
   // curr_ represents the index for bufs_ indicating which buffer is being
-  // consumed currently.
+  // consumed currently. The ring buffers are bufs_[0..num_buffers_ - 1];
+  // bufs_[num_buffers_] is only used to join data overlapping two ring
+  // buffers into one continuous result.
   uint32_t curr_;
+  uint32_t num_buffers_;
   size_t readahead_size_;
   size_t initial_auto_readahead_size_;
   // FilePrefetchBuffer object won't be created from Iterator flow if
@@ -309,12 +356,6 @@ class FilePrefetchBuffer {
   // num_file_reads_ is only used when implicit_auto_readahead_ is set.
   uint64_t num_file_reads_;
 
-  // io_handle_ is allocated and used by underlying file system in case of
-  // asynchronous reads.
-  void* io_handle_;
-  IOHandleDeleter del_fn_;
-  bool async_read_in_progress_;
-
   // If async_request_submitted_ is set then it indicates RocksDB called
   // PrefetchAsync to submit request. It needs to TryReadFromCacheAsync to poll
   // the submitted request without checking if data is sequential and
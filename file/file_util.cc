@@ -21,7 +21,7 @@ IOStatus CopyFile(FileSystem* fs, const std::string& source,
                   std::unique_ptr<WritableFileWriter>& dest_writer,
                   uint64_t size, bool use_fsync,
                   const std::shared_ptr<IOTracer>& io_tracer,
-                  const Temperature temperature) {
+                  const Temperature temperature, RateLimiter* rate_limiter) {
   FileOptions soptions;
   IOStatus io_s;
   std::unique_ptr<SequentialFileReader> src_reader;
@@ -49,7 +49,10 @@ IOStatus CopyFile(FileSystem* fs, const std::string& source,
   Slice slice;
   while (size > 0) {
     size_t bytes_to_read = std::min(sizeof(buffer), static_cast<size_t>(size));
-    // TODO: rate limit copy file
+    if (rate_limiter != nullptr) {
+      rate_limiter->Request(static_cast<int64_t>(bytes_to_read), Env::IO_LOW,
+                            nullptr /* stats */, RateLimiter::OpType::kRead);
+    }
     io_s = status_to_io_status(
         src_reader->Read(bytes_to_read, &slice, buffer,
                          Env::IO_TOTAL /* rate_limiter_priority */));
@@ -71,7 +74,7 @@ IOStatus CopyFile(FileSystem* fs, const std::string& source,
 IOStatus CopyFile(FileSystem* fs, const std::string& source,
                   const std::string& destination, uint64_t size, bool use_fsync,
                   const std::shared_ptr<IOTracer>& io_tracer,
-                  const Temperature temperature) {
+                  const Temperature temperature, RateLimiter* rate_limiter) {
   FileOptions options;
   IOStatus io_s;
   std::unique_ptr<WritableFileWriter> dest_writer;
@@ -89,7 +92,7 @@ IOStatus CopyFile(FileSystem* fs, const std::string& source,
   }
 
   return CopyFile(fs, source, dest_writer, size, use_fsync, io_tracer,
-                  temperature);
+                  temperature, rate_limiter);
 }
 
 // Utility function to create a file with the provided contents
@@ -19,24 +19,29 @@
 namespace ROCKSDB_NAMESPACE {
 // use_fsync maps to options.use_fsync, which determines the way that
 // the file is synced after copying.
+// If rate_limiter is non-null, the reads of the source file are charged
+// against it, so concurrent copies share its bandwidth budget.
 extern IOStatus CopyFile(FileSystem* fs, const std::string& source,
                          std::unique_ptr<WritableFileWriter>& dest_writer,
                          uint64_t size, bool use_fsync,
                          const std::shared_ptr<IOTracer>& io_tracer,
-                         const Temperature temperature);
+                         const Temperature temperature,
+                         RateLimiter* rate_limiter = nullptr);
 extern IOStatus CopyFile(FileSystem* fs, const std::string& source,
                          const std::string& destination, uint64_t size,
                          bool use_fsync,
                          const std::shared_ptr<IOTracer>& io_tracer,
-                         const Temperature temperature);
+                         const Temperature temperature,
+                         RateLimiter* rate_limiter = nullptr);
 inline IOStatus CopyFile(const std::shared_ptr<FileSystem>& fs,
                          const std::string& source,
                          const std::string& destination, uint64_t size,
                          bool use_fsync,
                          const std::shared_ptr<IOTracer>& io_tracer,
-                         const Temperature temperature) {
+                         const Temperature temperature,
+                         RateLimiter* rate_limiter = nullptr) {
   return CopyFile(fs.get(), source, destination, size, use_fsync, io_tracer,
-                  temperature);
+                  temperature, rate_limiter);
 }
 extern IOStatus CreateFile(FileSystem* fs, const std::string& destination,
                            const std::string& contents, bool use_fsync);
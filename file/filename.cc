@@ -251,6 +251,10 @@ std::string IdentityFileName(const std::string& dbname) {
   return dbname + "/IDENTITY";
 }
 
+std::string VerifyChecksumProgressFileName(const std::string& dbname) {
+  return dbname + "/VERIFY_PROGRESS";
+}
+
 // Owned filenames have the form:
 //    dbname/IDENTITY
 //    dbname/CURRENT
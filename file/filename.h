@@ -148,6 +148,11 @@ extern std::string MetaDatabaseName(const std::string& dbname,
 // either from a backup-image or empty
 extern std::string IdentityFileName(const std::string& dbname);
 
+// Return the name of the file that records which files a previous
+// VerifyChecksum()/VerifyFileChecksums() call has already verified, so a
+// later call can resume where an interrupted one left off
+extern std::string VerifyChecksumProgressFileName(const std::string& dbname);
+
 // If filename is a rocksdb file, store the type of the file in *type.
 // The number encoded in the filename is stored in *number.  If the
 // filename was successfully parsed, returns true.  Else return false.
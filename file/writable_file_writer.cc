@@ -83,7 +83,8 @@ IOStatus WritableFileWriter::Append(const Slice& data, uint32_t crc32c_checksum,
   // Flush only when buffered I/O
   if (!use_direct_io() && (buf_.Capacity() - buf_.CurrentSize()) < left) {
     if (buf_.CurrentSize() > 0) {
-      s = Flush(op_rate_limiter_priority);
+      s = async_buffered_writes_ ? FlushAsyncBuffer(op_rate_limiter_priority)
+                                 : Flush(op_rate_limiter_priority);
       if (!s.ok()) {
         return s;
       }
@@ -143,7 +144,9 @@ IOStatus WritableFileWriter::Append(const Slice& data, uint32_t crc32c_checksum,
         src += appended;
 
         if (left > 0) {
-          s = Flush(op_rate_limiter_priority);
+          s = async_buffered_writes_
+                  ? FlushAsyncBuffer(op_rate_limiter_priority)
+                  : Flush(op_rate_limiter_priority);
           if (!s.ok()) {
             break;
           }
@@ -152,6 +155,13 @@ IOStatus WritableFileWriter::Append(const Slice& data, uint32_t crc32c_checksum,
     } else {
       // Writing directly to file bypassing the buffer
       assert(buf_.CurrentSize() == 0);
+      if (async_buffered_writes_) {
+        // Preserve write ordering relative to previously queued buffers.
+        s = DrainAsyncWrites();
+        if (!s.ok()) {
+          return s;
+        }
+      }
       if (perform_data_verification_ && buffered_data_with_checksum_) {
         buffered_data_crc32c_checksum_ = crc32c::Value(src, left);
         s = WriteBufferedWithChecksum(src, left, op_rate_limiter_priority);
@@ -216,6 +226,11 @@ IOStatus WritableFileWriter::Close() {
 
   s = Flush();  // flush cache to OS
 
+  // The background writer has nothing left to do after the flush barrier
+  // above (even on error it only drops buffers), so retire it before
+  // closing the file.
+  StopAsyncWriter();
+
   IOStatus interim;
   IOOptions io_options;
   io_options.rate_limiter_priority = writable_file_->GetIOPriority();
@@ -308,6 +323,15 @@ IOStatus WritableFileWriter::Flush(Env::IOPriority op_rate_limiter_priority) {
   IOStatus s;
   TEST_KILL_RANDOM_WITH_WEIGHT("WritableFileWriter::Flush:0", REDUCE_ODDS2);
 
+  if (async_buffered_writes_) {
+    // Completion barrier: previously queued buffers must reach the file
+    // before buf_ below to keep the writes ordered.
+    s = DrainAsyncWrites();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
   if (buf_.CurrentSize() > 0) {
     if (use_direct_io()) {
 #ifndef ROCKSDB_LITE
@@ -593,6 +617,184 @@ IOStatus WritableFileWriter::WriteBuffered(
   return s;
 }
 
+// Background-thread counterpart of WriteBuffered(): writes a buffer that has
+// already been detached from buf_, so no writer-buffer state is touched on
+// either success or failure. The caller (AsyncWriteLoop) records the error
+// and drops the buffer, matching the synchronous failure behavior.
+IOStatus WritableFileWriter::WriteQueuedBuffer(
+    const char* data, size_t size, Env::IOPriority op_rate_limiter_priority) {
+  IOStatus s;
+  assert(!use_direct_io());
+  const char* src = data;
+  size_t left = size;
+  DataVerificationInfo v_info;
+  char checksum_buf[sizeof(uint32_t)];
+  Env::IOPriority rate_limiter_priority_used =
+      WritableFileWriter::DecideRateLimiterPriority(
+          writable_file_->GetIOPriority(), op_rate_limiter_priority);
+  IOOptions io_options;
+  io_options.rate_limiter_priority = rate_limiter_priority_used;
+
+  while (left > 0) {
+    size_t allowed = left;
+    if (rate_limiter_ != nullptr &&
+        rate_limiter_priority_used != Env::IO_TOTAL) {
+      allowed = rate_limiter_->RequestToken(left, 0 /* alignment */,
+                                            rate_limiter_priority_used, stats_,
+                                            RateLimiter::OpType::kWrite);
+    }
+
+    {
+      IOSTATS_TIMER_GUARD(write_nanos);
+      TEST_SYNC_POINT("WritableFileWriter::Flush:BeforeAppend");
+
+#ifndef ROCKSDB_LITE
+      FileOperationInfo::StartTimePoint start_ts;
+      uint64_t old_size = writable_file_->GetFileSize(io_options, nullptr);
+      if (ShouldNotifyListeners()) {
+        start_ts = FileOperationInfo::StartNow();
+      }
+#endif
+      {
+        auto prev_perf_level = GetPerfLevel();
+
+        IOSTATS_CPU_TIMER_GUARD(cpu_write_nanos, clock_);
+        if (perform_data_verification_) {
+          Crc32cHandoffChecksumCalculation(src, allowed, checksum_buf);
+          v_info.checksum = Slice(checksum_buf, sizeof(uint32_t));
+          s = writable_file_->Append(Slice(src, allowed), io_options, v_info,
+                                     nullptr);
+        } else {
+          s = writable_file_->Append(Slice(src, allowed), io_options, nullptr);
+        }
+        SetPerfLevel(prev_perf_level);
+      }
+#ifndef ROCKSDB_LITE
+      if (ShouldNotifyListeners()) {
+        auto finish_ts = std::chrono::steady_clock::now();
+        NotifyOnFileWriteFinish(old_size, allowed, start_ts, finish_ts, s);
+        if (!s.ok()) {
+          NotifyOnIOError(s, FileOperationType::kAppend, file_name(), allowed,
+                          old_size);
+        }
+      }
+#endif
+      if (!s.ok()) {
+        return s;
+      }
+    }
+
+    IOSTATS_ADD(bytes_written, allowed);
+
+    left -= allowed;
+    src += allowed;
+    uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
+    flushed_size_.store(cur_size + allowed, std::memory_order_release);
+  }
+  return s;
+}
+
+IOStatus WritableFileWriter::FlushAsyncBuffer(
+    Env::IOPriority op_rate_limiter_priority) {
+  assert(async_buffered_writes_);
+  if (buf_.CurrentSize() == 0) {
+    return IOStatus::OK();
+  }
+  if (!async_thread_.joinable()) {
+    // Started lazily so writers that never fill a buffer stay threadless.
+    async_thread_ = port::Thread(&WritableFileWriter::AsyncWriteLoop, this);
+  }
+  const size_t cap = buf_.Capacity();
+  AlignedBuffer next;
+  async_mu_.Lock();
+  while (async_io_status_.ok() &&
+         async_queue_.size() + (async_write_in_progress_ ? 1 : 0) >=
+             kNumAsyncWriteBuffers) {
+    async_drain_cv_.Wait();
+  }
+  if (!async_io_status_.ok()) {
+    IOStatus s = async_io_status_;
+    async_mu_.Unlock();
+    // Match the synchronous failure path: drop the buffered data and let
+    // the caller determine error handling.
+    buf_.Size(0);
+    buffered_data_crc32c_checksum_ = 0;
+    return s;
+  }
+  if (!async_spare_bufs_.empty()) {
+    next = std::move(async_spare_bufs_.front());
+    async_spare_bufs_.pop_front();
+  }
+  async_queue_.emplace_back();
+  async_queue_.back().buf = std::move(buf_);
+  async_queue_.back().prio = op_rate_limiter_priority;
+  async_work_cv_.Signal();
+  async_mu_.Unlock();
+
+  buf_ = std::move(next);
+  if (buf_.Capacity() < cap) {
+    buf_.Alignment(writable_file_->GetRequiredBufferAlignment());
+    buf_.AllocateNewBuffer(cap);
+  }
+  return IOStatus::OK();
+}
+
+IOStatus WritableFileWriter::DrainAsyncWrites() {
+  assert(async_buffered_writes_);
+  async_mu_.Lock();
+  while (!async_queue_.empty() || async_write_in_progress_) {
+    async_drain_cv_.Wait();
+  }
+  IOStatus s = async_io_status_;
+  async_mu_.Unlock();
+  return s;
+}
+
+void WritableFileWriter::AsyncWriteLoop() {
+  async_mu_.Lock();
+  while (true) {
+    while (!async_shutdown_ && async_queue_.empty()) {
+      async_work_cv_.Wait();
+    }
+    if (async_queue_.empty()) {
+      break;
+    }
+    AsyncWriteBuf work = std::move(async_queue_.front());
+    async_queue_.pop_front();
+    if (!async_io_status_.ok()) {
+      // A previous write failed; drop the remaining buffers.
+      async_drain_cv_.SignalAll();
+      continue;
+    }
+    async_write_in_progress_ = true;
+    async_mu_.Unlock();
+    IOStatus s = WriteQueuedBuffer(work.buf.BufferStart(),
+                                   work.buf.CurrentSize(),
+                                   work.prio);
+    async_mu_.Lock();
+    async_write_in_progress_ = false;
+    if (!s.ok()) {
+      async_io_status_ = s;
+    } else if (async_spare_bufs_.size() < kNumAsyncWriteBuffers) {
+      work.buf.Size(0);
+      async_spare_bufs_.emplace_back(std::move(work.buf));
+    }
+    async_drain_cv_.SignalAll();
+  }
+  async_mu_.Unlock();
+}
+
+void WritableFileWriter::StopAsyncWriter() {
+  if (!async_thread_.joinable()) {
+    return;
+  }
+  async_mu_.Lock();
+  async_shutdown_ = true;
+  async_work_cv_.SignalAll();
+  async_mu_.Unlock();
+  async_thread_.join();
+}
+
 IOStatus WritableFileWriter::WriteBufferedWithChecksum(
     const char* data, size_t size, Env::IOPriority op_rate_limiter_priority) {
   IOStatus s;
@@ -9,6 +9,7 @@
 
 #pragma once
 #include <atomic>
+#include <deque>
 #include <string>
 
 #include "db/version_edit.h"
@@ -165,6 +166,31 @@ class WritableFileWriter {
   Temperature temperature_;
 #endif  // ROCKSDB_LITE
 
+  // Double buffering for buffered writes (see
+  // EnvOptions::use_async_buffered_writes). Append() hands a filled buf_ to
+  // async_queue_ and keeps filling a fresh buffer while async_thread_ drains
+  // the queue in order; Flush()/Sync()/Close() wait via DrainAsyncWrites().
+  // At most kNumAsyncWriteBuffers buffers are queued or being written at a
+  // time; Append() blocks once the ring is full. All fields below except
+  // async_buffered_writes_ and async_thread_ are protected by async_mu_.
+  struct AsyncWriteBuf {
+    AlignedBuffer buf;
+    Env::IOPriority prio = Env::IO_TOTAL;
+  };
+  static constexpr size_t kNumAsyncWriteBuffers = 2;
+  bool async_buffered_writes_;
+  port::Mutex async_mu_;
+  port::CondVar async_work_cv_;
+  port::CondVar async_drain_cv_;
+  std::deque<AsyncWriteBuf> async_queue_;
+  std::deque<AlignedBuffer> async_spare_bufs_;
+  // First error hit by the background thread; sticky. Later buffers are
+  // dropped, mirroring how the synchronous path discards buf_ on failure.
+  IOStatus async_io_status_;
+  bool async_write_in_progress_ = false;
+  bool async_shutdown_ = false;
+  port::Thread async_thread_;
+
  public:
   WritableFileWriter(
       std::unique_ptr<FSWritableFile>&& file, const std::string& _file_name,
@@ -195,7 +221,15 @@ class WritableFileWriter {
         checksum_finalized_(false),
         perform_data_verification_(perform_data_verification),
         buffered_data_crc32c_checksum_(0),
-        buffered_data_with_checksum_(buffered_data_with_checksum) {
+        buffered_data_with_checksum_(buffered_data_with_checksum),
+        // Full-buffer checksum handoff ties buffered_data_crc32c_checksum_
+        // to buf_, which cannot be tracked across a background handoff.
+        async_buffered_writes_(options.use_async_buffered_writes &&
+                               !writable_file_->use_direct_io() &&
+                               !(perform_data_verification &&
+                                 buffered_data_with_checksum)),
+        async_work_cv_(&async_mu_),
+        async_drain_cv_(&async_mu_) {
 #ifndef ROCKSDB_LITE
     temperature_ = options.temperature;
 #endif  // ROCKSDB_LITE
@@ -303,6 +337,17 @@ class WritableFileWriter {
   // Normal write.
   IOStatus WriteBuffered(const char* data, size_t size,
                          Env::IOPriority op_rate_limiter_priority);
+  // Hand the filled buf_ to the background writer and install a fresh
+  // buffer; blocks while kNumAsyncWriteBuffers buffers are outstanding.
+  IOStatus FlushAsyncBuffer(Env::IOPriority op_rate_limiter_priority);
+  // Completion barrier: wait until all queued buffers reached the file and
+  // return the first background write error, if any.
+  IOStatus DrainAsyncWrites();
+  void AsyncWriteLoop();
+  void StopAsyncWriter();
+  // Body of the background write; WriteBuffered() minus the buf_ handling.
+  IOStatus WriteQueuedBuffer(const char* data, size_t size,
+                             Env::IOPriority op_rate_limiter_priority);
   IOStatus WriteBufferedWithChecksum(const char* data, size_t size,
                                      Env::IOPriority op_rate_limiter_priority);
   IOStatus RangeSync(uint64_t offset, uint64_t nbytes);
@@ -139,6 +139,12 @@ struct CompressionOptions {
   //
   // This option is valid only when BlockBasedTable is used.
   //
+  // It applies wherever the table builder runs, including compaction
+  // outputs: the thread driving the merging iterator only slices blocks,
+  // while compression runs on a worker pool and a dedicated thread writes
+  // the compressed blocks to the output file. This lets a single large
+  // subcompaction that cannot be split further use more than one core.
+  //
   // When parallel compression is enabled, SST size file sizes might be
   // more inflated compared to the target size, because more data of unknown
   // compressed size is in flight when compression is parallelized. To be
@@ -194,6 +200,36 @@ struct CompressionOptions {
   // Default: true
   bool use_zstd_dict_trainer;
 
+  // EXPERIMENTAL
+  // Train the compression dictionary once per (sub)compaction and reuse it
+  // for all subsequent output files of that (sub)compaction, instead of
+  // buffering and training a fresh dictionary for every output file. This
+  // takes dictionary training off the compaction hot path and lets later
+  // output files skip the buffered state entirely. The dictionary is still
+  // stored in each file's metaindex block, so the SST format is unchanged.
+  //
+  // Only has an effect when `max_dict_bytes` is nonzero.
+  //
+  // Default: false
+  bool share_compaction_dict;
+
+  // EXPERIMENTAL
+  // When nonzero, estimate the Shannon entropy of a sample of every data
+  // block, in bits per byte, and skip compressing blocks whose estimate
+  // exceeds this threshold. Blocks of already-compressed or encrypted
+  // values sit close to 8.0 and compressing them wastes CPU twice: once
+  // here and once on every read that has to decompress a block that
+  // barely shrank. The existing post-compression ratio check only rejects
+  // such a block after paying for its compression; this check runs
+  // before. A reasonable starting point is 7.5; the estimate cannot see
+  // cross-byte redundancy, so keep the threshold high to avoid skipping
+  // blocks that would compress on longer-range patterns.
+  //
+  // Only data blocks are skipped; metadata blocks are small and cheap.
+  //
+  // Default: 0.0 (disabled)
+  double max_compress_entropy;
+
   CompressionOptions()
       : window_bits(-14),
         level(kDefaultCompressionLevel),
@@ -203,12 +239,16 @@ struct CompressionOptions {
         parallel_threads(1),
         enabled(false),
         max_dict_buffer_bytes(0),
-        use_zstd_dict_trainer(true) {}
+        use_zstd_dict_trainer(true),
+        share_compaction_dict(false),
+        max_compress_entropy(0.0) {}
   CompressionOptions(int wbits, int _lev, int _strategy,
                      uint32_t _max_dict_bytes, uint32_t _zstd_max_train_bytes,
                      uint32_t _parallel_threads, bool _enabled,
                      uint64_t _max_dict_buffer_bytes,
-                     bool _use_zstd_dict_trainer)
+                     bool _use_zstd_dict_trainer,
+                     bool _share_compaction_dict = false,
+                     double _max_compress_entropy = 0.0)
       : window_bits(wbits),
         level(_lev),
         strategy(_strategy),
@@ -217,7 +257,9 @@ struct CompressionOptions {
         parallel_threads(_parallel_threads),
         enabled(_enabled),
         max_dict_buffer_bytes(_max_dict_buffer_bytes),
-        use_zstd_dict_trainer(_use_zstd_dict_trainer) {}
+        use_zstd_dict_trainer(_use_zstd_dict_trainer),
+        share_compaction_dict(_share_compaction_dict),
+        max_compress_entropy(_max_compress_entropy) {}
 };
 
 // Temperature of a file. Used to pass to FileSystem for a different
@@ -832,6 +874,25 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   uint64_t ttl = 0xfffffffffffffffe;
 
+  // EXPERIMENTAL
+  // Only supported in leveled compaction. If true, files in the bottommost
+  // level whose file creation time is older than `ttl` are deleted outright
+  // by a version edit instead of being read, filtered, and rewritten by a
+  // compaction. The file creation time is an upper bound on the write time
+  // of every entry in a file, so a file only qualifies once all its entries
+  // are older than `ttl`.
+  //
+  // WARNING: this deletes data. Only enable it when entries older than
+  // `ttl` are guaranteed to be garbage, e.g. when the column family is
+  // managed by DBWithTTL or an equivalent retention contract. Like FIFO's
+  // TTL deletion, it does not consult snapshots before dropping files.
+  // Has no effect when `ttl` is 0.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetOptions() API
+  bool ttl_delete_expired_files = false;
+
   // Files older than this value will be picked up for compaction, and
   // re-written to the same level as they were before.
   // One main use of the feature is to make sure a file goes through compaction
@@ -888,6 +949,31 @@ struct AdvancedColumnFamilyOptions {
   // Default: 0 (disable the feature)
   uint64_t preclude_last_level_data_seconds = 0;
 
+  // EXPERIMENTAL
+  // If non-zero, SST files that have not been read for at least this many
+  // seconds are marked for a background compaction that rewrites them in
+  // place with `cold_file_temperature` passed to the FileSystem, so data
+  // automatically migrates to the appropriate storage tier as it cools.
+  // Reads are observed through the existing sampled read counters, so a
+  // file only migrates after a full unread period has been seen by this
+  // DB instance; files created or opened recently are given a full period
+  // before they qualify. Only supported in leveled compaction; FIFO has
+  // its own mechanism (see CompactionOptionsFIFO::age_for_warm).
+  //
+  // Default: 0 (disable the feature)
+  //
+  // Dynamically changeable through the SetOptions() API
+  uint64_t cold_file_age_seconds = 0;
+
+  // EXPERIMENTAL
+  // The temperature that files picked by `cold_file_age_seconds` are
+  // rewritten with. Has no effect when `cold_file_age_seconds` is 0.
+  //
+  // Default: kWarm
+  //
+  // Dynamically changeable through the SetOptions() API
+  Temperature cold_file_temperature = Temperature::kWarm;
+
   // When set, large values (blobs) are written to separate blob files, and
   // only pointers to them are stored in SST files. This can reduce write
   // amplification for large-value use cases at the cost of introducing a level
@@ -932,6 +1018,32 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   CompressionType blob_compression_type = kNoCompression;
 
+  // EXPERIMENTAL
+  // When non-zero and blob_compression_type supports dictionaries, each blob
+  // file gets a compression dictionary of at most this size, trained on the
+  // first blobs written to the file. Blobs written after the dictionary is
+  // finalized are compressed using it, which can significantly improve the
+  // compression ratio for small, similarly structured blobs that do not
+  // compress well individually. Note that enable_blob_files has to be set in
+  // order for this option to have any effect.
+  //
+  // Default: 0 (no compression dictionary)
+  //
+  // Dynamically changeable through the SetOptions() API
+  uint32_t blob_compression_max_dict_bytes = 0;
+
+  // EXPERIMENTAL
+  // Maximum size of the training data sampled per blob file and passed to
+  // zstd's dictionary trainer when building the dictionary described under
+  // blob_compression_max_dict_bytes. If zero (or the trainer is unavailable),
+  // the first blob_compression_max_dict_bytes of blob data are used as the
+  // dictionary directly.
+  //
+  // Default: 0
+  //
+  // Dynamically changeable through the SetOptions() API
+  uint32_t blob_compression_zstd_max_train_bytes = 0;
+
   // Enables garbage collection of blobs. Blob GC is performed as part of
   // compaction. Valid blobs residing in blob files older than a cutoff get
   // relocated to new files as they are encountered during compaction, which
@@ -968,6 +1080,21 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   double blob_garbage_collection_force_threshold = 1.0;
 
+  // EXPERIMENTAL
+  // If enabled, compactions keep track of the extents of blobs that became
+  // garbage, and once it is safe to do so (i.e. no live version can reference
+  // them anymore), the corresponding regions of the blob files are
+  // deallocated by punching holes (see FSRandomRWFile::PunchHole). This
+  // reclaims space from partially garbage blob files without relocating
+  // their remaining live blobs, unlike the rewrite-based garbage collection
+  // controlled by the options above. It has no effect on file systems that
+  // do not support hole punching.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through the SetOptions() API
+  bool blob_garbage_collection_punch_holes = false;
+
   // Compaction readahead for blob files.
   //
   // Default: 0
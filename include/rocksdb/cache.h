@@ -93,6 +93,34 @@ struct LRUCacheOptions {
   // A SecondaryCache instance to use a the non-volatile tier.
   std::shared_ptr<SecondaryCache> secondary_cache;
 
+  // EXPERIMENTAL
+  // Fraction of capacity proactively freed, beyond the minimum needed for
+  // the triggering insert, whenever eviction runs. With a non-zero ratio an
+  // insert that crosses capacity evicts in one batched pass down to
+  // capacity * (1 - low_watermark_ratio), so subsequent inserts pay no
+  // eviction cost until capacity is reached again. 0.0 (the default)
+  // preserves the strict per-insert eviction behavior.
+  double low_watermark_ratio = 0.0;
+
+  // EXPERIMENTAL
+  // If true, a background thread owned by the cache performs the batched
+  // eviction passes instead of the inserting threads, which are then allowed
+  // to transiently push usage above capacity. Ignored when
+  // strict_capacity_limit is set, since the limit requires inline eviction.
+  // Most useful together with a non-zero low_watermark_ratio.
+  bool use_background_trimmer = false;
+
+  // EXPERIMENTAL
+  // If true and RocksDB was built with NUMA support (-DNUMA with libnuma),
+  // shards are partitioned into per-NUMA-node groups. Inserts go to a shard
+  // of the inserting thread's node, so entries are resident in local DRAM
+  // for the threads that use them, and lookups fall back to the other
+  // nodes' shards on a local miss so entries inserted from any node remain
+  // visible everywhere. A key may transiently occupy a shard on more than
+  // one node if inserted from several nodes. Without NUMA support, or on
+  // single-node hosts, this has no effect.
+  bool numa_aware = false;
+
   LRUCacheOptions() {}
   LRUCacheOptions(size_t _capacity, int _num_shard_bits,
                   bool _strict_capacity_limit, double _high_pri_pool_ratio,
@@ -142,6 +170,15 @@ struct CompressedSecondaryCacheOptions : LRUCacheOptions {
   // header in varint32 format.
   uint32_t compress_format_version = 2;
 
+  // Number of lookups an entry must accumulate before it is promoted out of
+  // the compressed tier. Until then a lookup still returns the value (so the
+  // primary cache can hold an uncompressed copy), but the compressed copy is
+  // retained and the primary copy is marked as also present here, so evicting
+  // it again does not recompress. This hysteresis keeps single-hit blocks in
+  // the compressed tier instead of ping-ponging between the tiers. 1 (the
+  // default) promotes on the first lookup, the historical behavior.
+  uint32_t promotion_lookup_threshold = 1;
+
   CompressedSecondaryCacheOptions() {}
   CompressedSecondaryCacheOptions(
       size_t _capacity, int _num_shard_bits, bool _strict_capacity_limit,
@@ -151,12 +188,14 @@ struct CompressedSecondaryCacheOptions : LRUCacheOptions {
       CacheMetadataChargePolicy _metadata_charge_policy =
           kDefaultCacheMetadataChargePolicy,
       CompressionType _compression_type = CompressionType::kLZ4Compression,
-      uint32_t _compress_format_version = 2)
+      uint32_t _compress_format_version = 2,
+      uint32_t _promotion_lookup_threshold = 1)
       : LRUCacheOptions(_capacity, _num_shard_bits, _strict_capacity_limit,
                         _high_pri_pool_ratio, std::move(_memory_allocator),
                         _use_adaptive_mutex, _metadata_charge_policy),
         compression_type(_compression_type),
-        compress_format_version(_compress_format_version) {}
+        compress_format_version(_compress_format_version),
+        promotion_lookup_threshold(_promotion_lookup_threshold) {}
 };
 
 // EXPERIMENTAL
@@ -169,7 +208,8 @@ extern std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
     CacheMetadataChargePolicy metadata_charge_policy =
         kDefaultCacheMetadataChargePolicy,
     CompressionType compression_type = CompressionType::kLZ4Compression,
-    uint32_t compress_format_version = 2);
+    uint32_t compress_format_version = 2,
+    uint32_t promotion_lookup_threshold = 1);
 
 extern std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
     const CompressedSecondaryCacheOptions& opts);
@@ -192,6 +232,34 @@ extern std::shared_ptr<Cache> NewClockCache(
     CacheMetadataChargePolicy metadata_charge_policy =
         kDefaultCacheMetadataChargePolicy);
 
+// EXPERIMENTAL Construct the in-development clock-based Cache directly,
+// bypassing the NewClockCache stand-in above. The returned cache is a
+// lock-free, open-addressed variant of CLOCK that avoids the per-shard
+// mutex of LRUCache on hot read paths, at the cost of some restrictions:
+//
+// * Only fixed-size 16-byte keys are supported, i.e. the keys produced
+//   for block cache and similar uses (see cache/cache_key.h). Insert and
+//   Lookup assert on (or reject) other key sizes, so this cache is not a
+//   general-purpose Cache replacement yet.
+// * The hash table is sized up front from capacity / estimated_value_size,
+//   so a good estimate of the average charge per entry matters. When the
+//   table fills up despite capacity remaining (estimate too large),
+//   inserts that request a handle fall back to standalone entries that
+//   are freed on release and are not shareable via Lookup.
+//
+// Aside from those restrictions it supports the full Cache contract,
+// including strict_capacity_limit and cache reservations, with the same
+// full-cache behavior as LRUCache. Returns nullptr if num_shard_bits is
+// out of range.
+//
+// Once the restrictions are lifted, NewClockCache will construct this
+// cache and this function will be removed.
+extern std::shared_ptr<Cache> ExperimentalNewClockCache(
+    size_t capacity, size_t estimated_value_size, int num_shard_bits = -1,
+    bool strict_capacity_limit = false,
+    CacheMetadataChargePolicy metadata_charge_policy =
+        kDefaultCacheMetadataChargePolicy);
+
 class Cache {
  public:
   // Depending on implementation, cache entries with high priority could be less
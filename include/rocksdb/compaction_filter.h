@@ -186,6 +186,37 @@ class CompactionFilter : public Customizable {
     return Decision::kKeep;
   }
 
+  // Returns true if this filter supports FilterBatchV2(). When it does, the
+  // compaction hands the filter several entries per call instead of calling
+  // FilterV2() once per key, amortizing the per-call overhead (virtual
+  // dispatch, argument setup) across the batch. A batching filter must
+  // reach its decision purely from the passed key and value: to form
+  // batches the compaction looks ahead in its input, so the filter can be
+  // consulted for entries whose decision is never used (e.g. versions that
+  // turn out to be shadowed by a newer write).
+  virtual bool CanFilterBatches() const { return false; }
+
+  // Batched form of FilterV2() for plain values, called only if
+  // CanFilterBatches() returns true. Receives num_entries user keys with
+  // their existing values and must fill decisions[0, num_entries). An entry
+  // decided as kChangeValue must have its replacement value stored in
+  // new_values[i]. Only kKeep, kRemove, kPurge, kChangeValue and
+  // kUndetermined may be returned; kUndetermined falls back to a per-key
+  // FilterV2() call for that entry, which is the way to reach decisions the
+  // batch API cannot express (e.g. kRemoveAndSkipUntil). Merge operands,
+  // deletions and blob indexes never appear in a batch; they always take
+  // the per-key path.
+  //
+  // The default implementation defers every entry to FilterV2().
+  virtual void FilterBatchV2(int /*level*/, size_t num_entries,
+                             const Slice* /*keys*/, const Slice* /*values*/,
+                             std::string* /*new_values*/,
+                             Decision* decisions) const {
+    for (size_t i = 0; i < num_entries; ++i) {
+      decisions[i] = Decision::kUndetermined;
+    }
+  }
+
   // Internal (BlobDB) use only. Do not override in application code.
   virtual BlobDecision PrepareBlobOutput(const Slice& /* key */,
                                          const Slice& /* existing_value */,
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -65,6 +66,7 @@ class StatsHistoryIterator;
 #ifndef ROCKSDB_LITE
 class TraceReader;
 class TraceWriter;
+class WalStreamSink;
 #endif
 class WriteBatch;
 
@@ -139,6 +141,32 @@ struct GetMergeOperandsOptions {
   int expected_max_number_of_operands = 0;
 };
 
+// Iterates over the merge operands of a single key without materializing
+// them into caller-owned buffers. Obtained from
+// DB::GetMergeOperandsIterator(). Operands are exposed in the order of
+// insertion as zero-copy slices pinned into the DB's internal data
+// (memtables and cached blocks); the pins and a superversion reference are
+// held for the lifetime of the iterator, so it should not outlive the fold
+// over the operands, and it must be released before the DB is closed.
+class MergeOperandsIterator {
+ public:
+  virtual ~MergeOperandsIterator() {}
+
+  // Position at the first (oldest) operand.
+  virtual void SeekToFirst() = 0;
+
+  // True while the iterator is positioned at an operand.
+  virtual bool Valid() const = 0;
+
+  // Advance to the next operand.
+  // REQUIRES: Valid()
+  virtual void Next() = 0;
+
+  // The operand at the current position.
+  // REQUIRES: Valid()
+  virtual Slice operand() const = 0;
+};
+
 // A collections of table properties objects, where
 //  key: is the table's file name.
 //  value: the table properties object of the given table.
@@ -541,6 +569,29 @@ class DB {
     return Get(options, DefaultColumnFamily(), key, value);
   }
 
+  // EXPERIMENTAL
+  // Callback-style version of Get(). The callback is invoked exactly once
+  // with the status of the lookup; *value is valid inside the callback when
+  // the status is OK. When the underlying implementation and file system
+  // support it (see ReadOptions::async_io), table reads for a cache miss are
+  // issued with ReadAsync and overlapped rather than pinning the thread in a
+  // blocking read. The callback currently runs on the calling thread before
+  // GetAsync() returns; a detached completion model may come later without
+  // changing this signature.
+  //
+  // The default implementation performs the lookup synchronously.
+  virtual void GetAsync(const ReadOptions& options,
+                        ColumnFamilyHandle* column_family, const Slice& key,
+                        PinnableSlice* value,
+                        std::function<void(Status)> callback) {
+    callback(Get(options, column_family, key, value));
+  }
+  virtual void GetAsync(const ReadOptions& options, const Slice& key,
+                        PinnableSlice* value,
+                        std::function<void(Status)> callback) {
+    GetAsync(options, DefaultColumnFamily(), key, value, std::move(callback));
+  }
+
   // Get() methods that return timestamp. Derived DB classes don't need to worry
   // about this group of methods if they don't care about timestamp feature.
   virtual inline Status Get(const ReadOptions& options,
@@ -587,6 +638,20 @@ class DB {
       GetMergeOperandsOptions* get_merge_operands_options,
       int* number_of_operands) = 0;
 
+  // Lazy variant of GetMergeOperands(): returns an iterator over the merge
+  // operands of `key` instead of copying them into a caller-provided array,
+  // so consumers can fold over a large number of operands incrementally
+  // with zero-copy slices and without an
+  // expected_max_number_of_operands-style capacity limit. Returns NotFound
+  // if no entry for `key` exists. See the MergeOperandsIterator comment for
+  // lifetime considerations.
+  virtual Status GetMergeOperandsIterator(
+      const ReadOptions& /*options*/, ColumnFamilyHandle* /*column_family*/,
+      const Slice& /*key*/,
+      std::unique_ptr<MergeOperandsIterator>* /*iterator*/) {
+    return Status::NotSupported("GetMergeOperandsIterator() not implemented");
+  }
+
   // Consistent Get of many keys across column families without the need
   // for an explicit snapshot. NOTE: the implementation of this MultiGet API
   // does not have the performance benefits of the void-returning MultiGet
@@ -889,6 +954,16 @@ class DB {
     //      available in the map form.
     static const std::string kBlockCacheEntryStats;
 
+    //  "rocksdb.block-cache-heatmap" - returns a multi-line string or map
+    //      with cumulative block cache hit/miss/insert counters for the
+    //      column family's live SST files, aggregated per level and block
+    //      type under keys of the form
+    //      "L<level>.<block type>.<hit|miss|insert>". Counters are
+    //      maintained by each open table reader, so a file's contribution
+    //      is dropped when its reader is closed or the file is compacted
+    //      away. Cheap enough to query regularly in production.
+    static const std::string kBlockCacheHeatmap;
+
     //  "rocksdb.num-immutable-mem-table" - returns number of immutable
     //      memtables that have not yet been flushed.
     static const std::string kNumImmutableMemTable;
@@ -1060,6 +1135,34 @@ class DB {
     //      of options.statistics
     static const std::string kOptionsStatistics;
 
+    // "rocksdb.cf-statistics" - returns multi-line string of the
+    //      statistics covering only the given column family. Only
+    //      supported when options.statistics is the default ("basic")
+    //      implementation.
+    static const std::string kCFStatistics;
+
+    // "rocksdb.perf-sample-stats" - returns a map of per-operation-type
+    //      read latency breakdowns (nanos spent in the memtables, table
+    //      files, block reads, checksums and decompression) collected by
+    //      sampling perf-context timing. Only populated when
+    //      DBOptions::perf_sample_frequency is non-zero; use
+    //      GetMapProperty().
+    static const std::string kPerfSampleStats;
+
+    // "rocksdb.slo-stats" - returns a map of windowed latency percentiles
+    //      (micros) per operation type as maintained by the SLO tracker.
+    //      Only populated when DBOptions::slo_tracker is non-nullptr; use
+    //      GetMapProperty().
+    static const std::string kSLOStats;
+
+    // "rocksdb.db-mutex-contention-stats" - returns a multi-line string
+    //      with one line per DB-mutex Lock() call site: that site's
+    //      acquisition count, contended-acquisition count, cumulative wait
+    //      and hold times (micros) and deepest waiter queue seen. Only
+    //      populated when options.statistics runs at a stats level above
+    //      kExceptTimeForMutex.
+    static const std::string kDBMutexContentionStats;
+
     // "rocksdb.num-blob-files" - returns number of blob files in the current
     //      version.
     static const std::string kNumBlobFiles;
@@ -1491,6 +1594,27 @@ class DB {
       const TransactionLogIterator::ReadOptions& read_options =
           TransactionLogIterator::ReadOptions()) = 0;
 
+  // EXPERIMENTAL
+  // Register a sink that receives each write group's WAL payload in memory
+  // at commit time, starting with the next WAL write. See
+  // rocksdb/wal_stream.h for the delivery contract, including how
+  // backpressure and resuming from a sequence number work. Registering the
+  // same sink twice is an error.
+  virtual Status RegisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& /*sink*/) {
+    return Status::NotSupported("RegisterWalStreamSink() is not implemented.");
+  }
+
+  // EXPERIMENTAL
+  // Detach a sink registered with RegisterWalStreamSink. Returns NotFound
+  // if the sink is not registered (e.g. it was already detached for
+  // backpressure). After this returns, OnWalWrite will not be called again.
+  virtual Status UnregisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& /*sink*/) {
+    return Status::NotSupported(
+        "UnregisterWalStreamSink() is not implemented.");
+  }
+
 // Windows API macro interference
 #undef DeleteFile
   // WARNING: This API is planned for removal in RocksDB 7.0 since it does not
@@ -1699,6 +1823,24 @@ class DB {
     return Status::NotSupported("PromoteL0() is not implemented.");
   }
 
+  // EXPERIMENTAL
+  // Computes user keys that split the range [begin, end) of the given column
+  // family into at most max_partitions contiguous partitions of roughly equal
+  // data size, based on the SST file boundaries in the current version. The
+  // returned keys are sorted ascending and fall strictly inside (begin, end);
+  // they are suitable as Seek() targets and iterate_upper_bound values for
+  // scanning the partitions independently, e.g. in parallel. A nullptr begin
+  // or end means unbounded on that side. The partitioning is approximate:
+  // sizes can be skewed by overlapping L0 files, and data in the memtables is
+  // not consulted.
+  virtual Status GetScanPartitionBoundaries(
+      ColumnFamilyHandle* /*column_family*/, const Slice* /*begin*/,
+      const Slice* /*end*/, size_t /*max_partitions*/,
+      std::vector<std::string>* /*boundaries*/) {
+    return Status::NotSupported(
+        "GetScanPartitionBoundaries() is not implemented.");
+  }
+
   // Trace DB operations. Use EndTrace() to stop tracing.
   virtual Status StartTrace(const TraceOptions& /*options*/,
                             std::unique_ptr<TraceWriter>&& /*trace_writer*/) {
@@ -97,6 +97,25 @@ struct EnvOptions {
   // If true, then use O_DIRECT for writing data
   bool use_direct_writes = false;
 
+  // EXPERIMENTAL
+  // If true and the platform supports it (Linux with io_uring), buffered
+  // appends to this file are submitted to a per-file io_uring instance and
+  // only awaited at the next Sync()/Fsync()/Close(), letting the caller
+  // overlap other work with the kernel's processing of the writes. Honored
+  // by the default POSIX FileSystem for buffered (non-mmap, non-direct)
+  // writable files; ignored elsewhere.
+  bool use_io_uring_writes = false;
+
+  // EXPERIMENTAL
+  // If true, buffered writes that go through WritableFileWriter are double
+  // buffered: a filled write buffer is handed to a background thread that
+  // drains it to the file while the caller keeps filling a fresh buffer.
+  // Flush(), Sync() and Close() act as completion barriers. Requires the
+  // FileSystem to tolerate Append() being issued from a thread other than
+  // the one calling PrepareWrite(); writes themselves stay ordered. Ignored
+  // for direct I/O and for writers that hand off full-buffer checksums.
+  bool use_async_buffered_writes = false;
+
   // If false, fallocate() calls are bypassed
   bool allow_fallocate = true;
 
@@ -59,6 +59,18 @@ class BlockAccessCipherStream {
   // Length of data is equal to BlockSize();
   virtual Status DecryptBlock(uint64_t blockIndex, char* data,
                               char* scratch) = 0;
+
+  // Encrypt `numBlocks` consecutive whole blocks of data starting at the
+  // given block index. The default implementation processes them with one
+  // EncryptBlock() call per block; streams that can batch work (e.g. CTR
+  // keystream generation) override this so the per-block virtual dispatch
+  // is hoisted out of the loop.
+  virtual Status EncryptBlocks(uint64_t blockIndex, char* data,
+                               size_t numBlocks, char* scratch);
+
+  // Same as EncryptBlocks, decrypting.
+  virtual Status DecryptBlocks(uint64_t blockIndex, char* data,
+                               size_t numBlocks, char* scratch);
 };
 
 // BlockCipher
@@ -104,6 +116,31 @@ class BlockCipher : public Customizable {
   // Decrypt a block of data.
   // Length of data is equal to BlockSize().
   virtual Status Decrypt(char* data) = 0;
+
+  // Encrypt `numBlocks` consecutive blocks of data laid out back to back.
+  // The default implementation handles them one Encrypt() call at a time.
+  // Hardware-pipelined ciphers (e.g. AES-NI) should override this and keep
+  // several blocks in flight to hide instruction latency. Deliberately not
+  // an Encrypt() overload: that would be hidden in subclasses overriding
+  // only the single-block form.
+  virtual Status EncryptBlocks(char* data, size_t numBlocks) {
+    Status status;
+    const size_t block_size = BlockSize();
+    for (size_t i = 0; status.ok() && i < numBlocks; i++) {
+      status = Encrypt(data + i * block_size);
+    }
+    return status;
+  }
+
+  // Same as the above, decrypting.
+  virtual Status DecryptBlocks(char* data, size_t numBlocks) {
+    Status status;
+    const size_t block_size = BlockSize();
+    for (size_t i = 0; status.ok() && i < numBlocks; i++) {
+      status = Decrypt(data + i * block_size);
+    }
+    return status;
+  }
 };
 
 // The encryption provider is used to create a cipher stream for a specific
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "rocksdb/db.h"
+#include "rocksdb/iterator.h"
 #include "rocksdb/status.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -52,5 +53,40 @@ Status UpdateManifestForFilesState(
     const std::vector<ColumnFamilyDescriptor>& column_families,
     const UpdateManifestForFilesStateOptions& opts = {});
 
+struct ParallelScanOptions {
+  // Number of threads scanning partitions concurrently.
+  size_t parallelism = 4;
+
+  // Maximum number of partitions the range is split into. More partitions
+  // than threads smooths out skew in the per-partition data sizes. 0 means
+  // 4 * parallelism.
+  size_t max_partitions = 0;
+
+  // Soft cap on the key plus value bytes buffered per chunk handed from a
+  // scanning thread to the caller. At most two chunks are buffered per
+  // in-flight partition, which bounds the memory used by the scan.
+  size_t chunk_bytes = 2 << 20;
+};
+
+// Returns a heap-allocated iterator over the user keys in [begin, end) of
+// the given column family (nullptr means unbounded). The range is split into
+// partitions along SST file boundaries (see
+// DB::GetScanPartitionBoundaries()), the partitions are scanned by a pool of
+// threads, and the resulting chunks are streamed to the caller in key order
+// through the ordinary Iterator interface.
+//
+// The iterator is forward-only and single-pass: it supports one
+// SeekToFirst() followed by Next() until exhaustion; Seek(), SeekForPrev(),
+// SeekToLast() and Prev() fail with Status::NotSupported(). Keys and values
+// are copied out of the underlying partitions, so they remain valid until
+// the next call to Next(), but read_options.tailing and explicit iterate
+// bounds are not supported (pass begin/end instead). If
+// read_options.snapshot is nullptr a snapshot is taken internally so all
+// partitions observe the same view.
+Iterator* NewParallelIterator(DB* db, const ReadOptions& read_options,
+                              ColumnFamilyHandle* column_family,
+                              const Slice* begin, const Slice* end,
+                              const ParallelScanOptions& options = {});
+
 }  // namespace experimental
 }  // namespace ROCKSDB_NAMESPACE
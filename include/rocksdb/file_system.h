@@ -1215,6 +1215,18 @@ class FSRandomRWFile {
 
   virtual IOStatus Close(const IOOptions& options, IODebugContext* dbg) = 0;
 
+  // EXPERIMENTAL
+  // Deallocate the file system blocks backing the byte range
+  // [offset, offset + length). Reads of the range return zeros afterwards,
+  // and the file size is unchanged. Used to release the space of dead
+  // regions in files whose live regions are still being read (e.g. blob
+  // files). Returns NotSupported() if the file system cannot punch holes.
+  virtual IOStatus PunchHole(uint64_t /*offset*/, uint64_t /*length*/,
+                             const IOOptions& /*options*/,
+                             IODebugContext* /*dbg*/) {
+    return IOStatus::NotSupported("PunchHole is not supported");
+  }
+
   // EXPERIMENTAL
   // When available, returns the actual temperature for the file. This is
   // useful in case some outside process moves a file from one tier to another,
@@ -1777,6 +1789,10 @@ class FSRandomRWFileWrapper : public FSRandomRWFile {
   IOStatus Close(const IOOptions& options, IODebugContext* dbg) override {
     return target_->Close(options, dbg);
   }
+  IOStatus PunchHole(uint64_t offset, uint64_t length, const IOOptions& options,
+                     IODebugContext* dbg) override {
+    return target_->PunchHole(offset, length, options, dbg);
+  }
   Temperature GetTemperature() const override {
     return target_->GetTemperature();
   }
@@ -35,6 +35,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class Slice;
+class Statistics;
 struct BlockBasedTableOptions;
 struct ConfigOptions;
 
@@ -60,6 +61,11 @@ struct FilterBuildingContext {
 
   // An optional logger for reporting errors, warnings, etc.
   Logger* info_log = nullptr;
+
+  // Optional statistics of the DB the table is being built for, so a
+  // policy can size filters from observed lookup behavior (see
+  // NewAdaptiveBloomFilterPolicy). May be nullptr.
+  Statistics* statistics = nullptr;
   // END from (DB|ColumnFamily)Options
 
   // Name of the column family for the table (or empty string if unknown)
@@ -165,6 +171,19 @@ class FilterPolicy : public Customizable {
 extern const FilterPolicy* NewBloomFilterPolicy(
     double bits_per_key, bool IGNORED_use_block_based_builder = false);
 
+// EXPERIMENTAL: like NewBloomFilterPolicy, but bits_per_key is treated as
+// a baseline that is re-sized per SST file from the build context. Files
+// for levels near the bottom of the LSM, where a false positive usually
+// costs a cold storage read, get up to ~1.25x the baseline; files for
+// upper levels, whose data is usually cached, get as little as ~0.75x.
+// When DB statistics are available, the result is further scaled by the
+// observed fraction of lookups that filters can help (negative lookups,
+// from the filter useful/positive tickers), within a factor of two of the
+// baseline overall. This approximately minimizes total filter memory plus
+// extra read I/O without per-level hand tuning. Filters produced this way
+// are readable by NewBloomFilterPolicy and vice versa.
+extern const FilterPolicy* NewAdaptiveBloomFilterPolicy(double bits_per_key);
+
 // A new Bloom alternative that saves about 30% space compared to
 // Bloom filters, with similar query times but roughly 3-4x CPU time
 // and 3x temporary space usage during construction.  For example, if
@@ -200,7 +219,40 @@ extern const FilterPolicy* NewBloomFilterPolicy(
 //
 // Also consider using optimize_filters_for_memory to save filter
 // memory.
+//
+// EXPERIMENTAL: construction_threads > 1 parallelizes construction of
+// large Ribbon filters (roughly > 2M keys in one filter): keys are
+// sharded into independent sub-filters built concurrently and
+// concatenated, so big compaction outputs no longer pay seconds of
+// single-threaded banding per file. The sharded format is written with
+// its own metadata marker; RocksDB versions that do not know it read
+// such filters as if no filter was present (degraded performance until
+// recompaction, same as reading Ribbon filters with pre-6.15 versions).
+// Smaller filters are unaffected and use the standard format.
 extern const FilterPolicy* NewRibbonFilterPolicy(
-    double bloom_equivalent_bits_per_key, int bloom_before_level = 0);
+    double bloom_equivalent_bits_per_key, int bloom_before_level = 0,
+    int construction_threads = 1);
+
+// EXPERIMENTAL: a range filter for Seek-heavy workloads, as an alternative
+// to hash-based filters (Bloom/Ribbon), which can only answer point and
+// exact-prefix queries. Instead of hashing, this policy stores the sorted
+// set of distinct key/prefix segments (keys truncated to segment_len
+// bytes), so a Seek into a range of the key space that contains no segment
+// is recognized as empty at the filter, without touching index or data
+// blocks. With a prefix_extractor configured and
+// ReadOptions::prefix_same_as_start (or auto_prefix_mode), iterator Seeks
+// into empty prefix ranges terminate at the filter; Get() is also
+// supported (no false negatives, same as Bloom).
+//
+// Space is roughly (segment_len + 1) bytes per distinct segment, so
+// segment_len trades space for precision: longer segments distinguish
+// more ranges but store more bytes. segment_len should be at least the
+// prefix_extractor length to filter at full prefix granularity.
+//
+// Requires keys to be ordered bytewise (BytewiseComparator); a custom
+// comparator that orders keys differently would break the ordered search
+// and must not be used with this policy.
+extern const FilterPolicy* NewExperimentalRangeFilterPolicy(
+    size_t segment_len = 8);
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -148,6 +148,10 @@ enum class CompactionReason : int {
   kChangeTemperature,
   // Compaction scheduled to force garbage collection of blob files
   kForcedBlobGC,
+  // [Level] bottommost files whose entries are all older than TTL are
+  // deleted without being rewritten (see
+  // AdvancedColumnFamilyOptions::ttl_delete_expired_files)
+  kTtlFileDeletion,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
@@ -191,6 +195,17 @@ enum class WriteStallCondition {
   kStopped,
 };
 
+enum class WriteStallCause {
+  kNone,
+  kMemtableLimit,
+  kL0FileCountLimit,
+  kPendingCompactionBytes,
+  // Predictive throttling started shaping the write rate before any limit
+  // was reached; see DBOptions::predictive_write_throttling. Reported with
+  // WriteStallCondition::kNormal since no limit-based stall is active.
+  kPredictiveCompactionDebt,
+};
+
 struct WriteStallInfo {
   // the name of the column family
   std::string cf_name;
@@ -199,6 +214,17 @@ struct WriteStallInfo {
     WriteStallCondition cur;
     WriteStallCondition prev;
   } condition;
+  // why the DB is (or was) slowing down writes; kNone when the new
+  // condition is kNormal and no predictive slowdown is active
+  WriteStallCause cause = WriteStallCause::kNone;
+  // the write rate enforced while the DB is delaying writes, in
+  // bytes/second; 0 when writes are not being delayed
+  uint64_t delayed_write_rate = 0;
+  // best-effort prediction of how long the slowdown will last, in
+  // milliseconds. For predictive slowdowns this is the predicted time
+  // until the soft limit would be reached at the recent compaction debt
+  // growth rate. 0 means no prediction is available.
+  uint64_t predicted_duration_ms = 0;
 };
 
 #ifndef ROCKSDB_LITE
@@ -78,4 +78,32 @@ extern Status NewJemallocNodumpAllocator(
     JemallocAllocatorOptions& options,
     std::shared_ptr<MemoryAllocator>* memory_allocator);
 
+struct HugePageAllocatorOptions {
+  static const char* kName() { return "HugePageAllocatorOptions"; }
+  // Allocations of at least this size are backed by anonymous mmap regions
+  // advised with MADV_HUGEPAGE; smaller allocations use new/delete. Mapped
+  // regions are rounded up to a multiple of huge_page_size, so lowering
+  // the threshold below huge_page_size trades memory for TLB coverage.
+  size_t huge_page_threshold = 2 * 1024 * 1024;
+
+  // The transparent huge page size of the system, used for sizing and
+  // aligning mapped regions. 2MB on x86-64 and most aarch64 kernels.
+  size_t huge_page_size = 2 * 1024 * 1024;
+
+  // After this many consecutive failures to set up a huge page region
+  // (e.g. when physical memory is too fragmented for the kernel to
+  // assemble huge pages), the allocator stops trying and serves all
+  // allocations from the heap.
+  size_t max_consecutive_failures = 8;
+};
+
+// Generate a memory allocator that serves large allocations from mmap
+// regions advised with MADV_HUGEPAGE, reducing dTLB misses when a large
+// block cache dominates a process's memory footprint. Intended to be
+// plugged into LRUCacheOptions::memory_allocator. Only supported on
+// Linux; returns NotSupported elsewhere.
+extern Status NewHugePageAllocator(
+    const HugePageAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator);
+
 }  // namespace ROCKSDB_NAMESPACE
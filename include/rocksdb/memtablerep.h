@@ -397,6 +397,17 @@ extern MemTableRepFactory* NewHashSkipListRepFactory(
     size_t bucket_count = 1000000, int32_t skiplist_height = 4,
     int32_t skiplist_branching_factor = 4);
 
+// This creates memtables that hash-partition keys across a fixed array of
+// skiplists so that concurrent writers mostly insert into disjoint lists.
+// Point reads go straight to the owning shard; ordered iteration merges the
+// shards on the fly. If a prefix extractor is configured, keys are placed by
+// the hash of their prefix, which keeps prefix scans within a single shard.
+// num_shards: number of skiplist shards; rounded down to a power of two.
+//             A value near the number of concurrently writing threads is a
+//             good starting point.
+extern MemTableRepFactory* NewShardedSkipListRepFactory(
+    size_t num_shards = 16);
+
 // The factory is to create memtables based on a hash table:
 // it contains a fixed array of buckets, each pointing to either a linked list
 // or a skip list if number of entries inside the bucket exceeds
@@ -0,0 +1,69 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// EXPERIMENTAL
+// A compact, sharded cache of keys recently observed to be absent from a
+// column family's table files. It is consulted by point lookups after the
+// memtables miss, so a repeated negative lookup costs one hash probe
+// instead of traversing bloom filters and indexes across every level.
+// Entries are tagged with the superversion number they were observed
+// under; any flush, compaction or memtable switch installs a new
+// superversion and implicitly invalidates them, so no hook into the write
+// path is needed. Intended for workloads (e.g. dedup) where a large
+// fraction of Gets miss.
+//
+// Share one instance across DBs or column families as desired; entries are
+// keyed by column family ID, so a cache shared across DBs should not be,
+// unless the DBs cannot have clashing column family IDs.
+class NegativeLookupCache {
+ public:
+  // capacity_bytes is an approximate bound on the total memory used by
+  // cached keys and their bookkeeping.
+  explicit NegativeLookupCache(size_t capacity_bytes);
+  // No copying allowed
+  NegativeLookupCache(const NegativeLookupCache&) = delete;
+  NegativeLookupCache& operator=(const NegativeLookupCache&) = delete;
+
+  ~NegativeLookupCache();
+
+  // Returns true if `user_key` was recorded as absent from the table files
+  // of column family `column_family_id` under superversion
+  // `version_number`. Returns false on a cache miss or when the entry was
+  // recorded under a different superversion.
+  bool KnownNotFound(uint32_t column_family_id, const Slice& user_key,
+                     uint64_t version_number) const;
+
+  // Records that `user_key` was not found in the table files of
+  // `column_family_id` under superversion `version_number`.
+  void Insert(uint32_t column_family_id, const Slice& user_key,
+              uint64_t version_number);
+
+  // Drops all entries.
+  void Clear();
+
+ private:
+  struct Shard;
+
+  Shard& GetShard(const Slice& cache_key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+  const size_t per_shard_capacity_;
+};
+
+// Create a new NegativeLookupCache with the given approximate capacity in
+// bytes, for use with DBOptions::negative_lookup_cache.
+extern std::shared_ptr<NegativeLookupCache> NewNegativeLookupCache(
+    size_t capacity_bytes);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -49,7 +49,11 @@ class FilterPolicy;
 class Logger;
 class MergeOperator;
 class Snapshot;
+struct RequestPerfContext;
 class MemTableRepFactory;
+class NegativeLookupCache;
+class SLOTracker;
+class RowLookupCache;
 class RateLimiter;
 class Slice;
 class Statistics;
@@ -444,6 +448,32 @@ class CompactionService : public Customizable {
     return CompactionServiceJobStatus::kUseLocal;
   }
 
+  // EXPERIMENTAL
+  // Return true if the service can deliver remote compaction output files
+  // one by one, as the remote side finishes them, through
+  // `WaitForNextOutputFile()`. When false (the default), the primary only
+  // installs output files from the monolithic `WaitForCompleteV2()` result
+  // after the whole remote compaction is done.
+  virtual bool SupportsOutputFileStreaming() const { return false; }
+
+  // EXPERIMENTAL
+  // Block until the remote compaction for `info` finishes its next output
+  // file, then return kSuccess with the file metadata serialized by
+  // `CompactionServiceOutputFile::Write()` in `*serialized_output_file`.
+  // Unlike the file names in `WaitForCompleteV2()` result, `file_name` of a
+  // streamed output file must be its full path, readable by the primary's
+  // FileSystem, and files must be delivered in the order the remote
+  // compaction finished them. Return kSuccess with `*serialized_output_file`
+  // empty once all output files have been delivered. Any other status stops
+  // the streaming and the primary falls back to installing the files which
+  // were not streamed from the `WaitForCompleteV2()` result. Only called
+  // when `SupportsOutputFileStreaming()` returns true.
+  virtual CompactionServiceJobStatus WaitForNextOutputFile(
+      const CompactionServiceJobInfo& /*info*/,
+      std::string* /*serialized_output_file*/) {
+    return CompactionServiceJobStatus::kFailure;
+  }
+
   ~CompactionService() override = default;
 };
 
@@ -586,6 +616,18 @@ struct DBOptions {
   InfoLogLevel info_log_level = DEBUG_LEVEL;
 #endif  // NDEBUG
 
+  // EXPERIMENTAL
+  // If true, info log writes are made asynchronous: Logv() formats the
+  // message into a bounded lock-free buffer and returns, and a dedicated
+  // background thread writes it to the log file. Flush, compaction and
+  // write threads then never block on a slow log volume. If the buffer
+  // fills up, messages are dropped and a warning with the drop count is
+  // logged once the writer catches up. Log lines are timestamped when
+  // they are written out, so under a backlog the recorded time can lag
+  // the call. Ignored if info_log is set by the user.
+  // Default: false
+  bool async_info_log = false;
+
   // Number of open files that can be used by the DB.  You may need to
   // increase this if your database has a large working set. Value -1 means
   // files opened are always kept open. You can estimate number of files based
@@ -603,9 +645,45 @@ struct DBOptions {
 
   // If max_open_files is -1, DB will open all files on DB::Open(). You can
   // use this option to increase the number of threads used to open the files.
+  // The same pool size also bounds the threads used to prepare (open, verify
+  // and copy) external files in IngestExternalFile().
   // Default: 16
   int max_file_opening_threads = 16;
 
+  // Number of threads used by VerifyChecksum() and VerifyFileChecksums()
+  // to verify files concurrently. Verification reads do not pollute the
+  // block cache (fill_cache is forced off) and can be paced with
+  // ReadOptions::rate_limiter_priority, so a larger value mainly trades
+  // disk bandwidth for verification wall-clock time.
+  // Default: 1 (verify one file at a time, on the calling thread)
+  int max_verify_checksum_threads = 1;
+
+  // EXPERIMENTAL
+  // If true, DB::Open() does not open the table files up front. Table
+  // readers are created on first access instead, and a low-priority
+  // background task warms the table cache level by level (L0 first) once
+  // the DB is open, so a DB with a very large number of files serves
+  // traffic almost immediately after Open() while cold files trickle in.
+  // This mainly matters with max_open_files = -1, which otherwise opens
+  // every file during Open(). Errors that eager loading would have
+  // reported at Open() (e.g. a corrupt table footer) are instead reported
+  // by the first read of the affected file.
+  // Default: false
+  bool lazy_open_table_files = false;
+
+  // EXPERIMENTAL
+  // If greater than one, MANIFEST replay during DB::Open() applies the
+  // recovered version edits to the per-column-family version builders with
+  // up to this many threads. Edits are buffered per column family while the
+  // MANIFEST is read and applied in order within each column family, so the
+  // recovered state is identical to a single-threaded replay. This mainly
+  // helps DBs with many column families and very large MANIFEST files (e.g.
+  // hundreds of thousands of live SST files). Memory usage during recovery
+  // grows with the size of the MANIFEST tail being replayed, which is
+  // bounded by max_manifest_file_size.
+  // Default: 1 (single-threaded replay)
+  int max_manifest_recovery_threads = 1;
+
   // Once write-ahead logs exceed this size, we will start forcing the flush of
   // column families whose memtables are backed by the oldest live WAL file
   // (i.e. the ones that are causing all the space amplification). If set to 0
@@ -632,6 +710,41 @@ struct DBOptions {
   // If non-null, then we should collect metrics about database operations
   std::shared_ptr<Statistics> statistics = nullptr;
 
+  // EXPERIMENTAL
+  // If non-zero, one in every perf_sample_frequency user read operations
+  // (Get/MultiGet) is timed with full perf-context instrumentation, and the
+  // resulting latency breakdowns (time spent in the memtables, in the table
+  // files, and on block reads, checksums and decompression) are aggregated
+  // into per-operation-type histograms retrievable via
+  // DB::GetMapProperty("rocksdb.perf-sample-stats"). This provides an
+  // always-on profile of the read path at a small fraction of the overhead
+  // of enabling perf-context timing for every operation.
+  // Default: 0 (disabled)
+  uint64_t perf_sample_frequency = 0;
+
+  // If true, the DB shapes the delayed write rate continuously from the
+  // growth rate of the estimated compaction debt instead of reacting only
+  // when a hard threshold (L0 file count, pending compaction bytes) is
+  // crossed: once the debt is projected to reach
+  // soft_pending_compaction_bytes_limit within a short horizon, writes are
+  // throttled proportionally to the remaining headroom, so throughput
+  // degrades gradually instead of hitting a stall cliff. Slowdowns are
+  // reported through EventListener::OnStallConditionsChanged() with their
+  // cause and a predicted duration (see WriteStallInfo).
+  //
+  // Default: false
+  bool predictive_write_throttling = false;
+
+  // EXPERIMENTAL
+  // If non-nullptr, the DB records the latency of every Get, MultiGet,
+  // iterator Seek/Next and Write into this tracker, which maintains
+  // windowed per-op-type percentiles and fires user-registered callbacks
+  // when a percentile exceeds its threshold. See NewSLOTracker() in
+  // rocksdb/slo_tracker.h; the windowed percentiles are also retrievable
+  // via GetMapProperty("rocksdb.slo-stats").
+  // Default: nullptr (disabled)
+  std::shared_ptr<SLOTracker> slo_tracker = nullptr;
+
   // By default, writes to stable storage use fdatasync (on platforms
   // where this function is available). If this option is true,
   // fsync is used instead.
@@ -726,6 +839,19 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint32_t max_subcompactions = 1;
 
+  // EXPERIMENTAL
+  // Size compaction parallelism by feedback instead of manual tuning. While
+  // the estimated compaction backlog of a column family is above its
+  // soft_pending_compaction_bytes_limit, compactions may claim idle
+  // background compaction threads as extra subcompactions beyond
+  // max_subcompactions (and beyond 1 even if subcompactions are otherwise
+  // disabled), releasing them again when fewer key ranges materialize or
+  // the backlog drains. Uses the same thread reservation machinery as
+  // round-robin compaction.
+  //
+  // Default: false
+  bool auto_tune_subcompactions = false;
+
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -932,6 +1058,17 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   size_t compaction_readahead_size = 0;
 
+  // If true, compaction input reads use the asynchronous prefetching path:
+  // readahead reads are submitted through FileSystem::ReadAsync (io_uring on
+  // supported Linux kernels) and kept in flight ahead of the merge thread
+  // instead of being issued synchronously per exhausted buffer. The number of
+  // in-flight reads is controlled by
+  // BlockBasedTableOptions::async_prefetch_depth, and the size of each read
+  // by `compaction_readahead_size`.
+  //
+  // Default: false
+  bool use_async_io_for_compaction = false;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1063,6 +1200,16 @@ struct DBOptions {
   // Default: false
   bool enable_pipelined_write = false;
 
+  // If enable_pipelined_flush is true, flushes run as a two-stage pipeline:
+  // one thread drains the memtable (including compaction filter and merge
+  // handling) into batches while a second thread builds, compresses and
+  // writes the table file. Flush duration then approaches the longer of the
+  // two stages rather than their sum, at the cost of one extra thread and a
+  // bounded amount of buffering per flush.
+  //
+  // Default: false
+  bool enable_pipelined_flush = false;
+
   // Setting unordered_write to true trades higher write throughput with
   // relaxing the immutability guarantee of snapshots. This violates the
   // repeatability one expects from ::Get from a snapshot, as well as
@@ -1114,6 +1261,17 @@ struct DBOptions {
   // Default: 1 MB
   uint64_t max_write_batch_group_size_bytes = 1 << 20;
 
+  // If true, max_write_batch_group_size_bytes is only the starting point for
+  // the write group size limit. The write threads track per-group commit
+  // latency against group size and keep probing the limit up and down,
+  // within 1/8x to 8x of max_write_batch_group_size_bytes, toward the size
+  // that minimizes per-byte commit latency under the current load. Useful
+  // when the optimal group size differs between latency-sensitive foreground
+  // traffic and bulk loads served by the same instance.
+  //
+  // Default: false
+  bool adaptive_write_batch_group_size = false;
+
   // The maximum number of microseconds that a write operation will use
   // a yielding spin loop to coordinate with other write threads before
   // blocking on a mutex.  (Assuming write_thread_slow_yield_usec is
@@ -1164,6 +1322,22 @@ struct DBOptions {
   // Not supported in ROCKSDB_LITE mode!
   std::shared_ptr<Cache> row_cache = nullptr;
 
+  // EXPERIMENTAL
+  // A cache of keys recently observed to be absent from the table files,
+  // consulted by point lookups after the memtables miss. See
+  // NewNegativeLookupCache() in rocksdb/negative_lookup_cache.h. Helpful
+  // for workloads where a large fraction of Gets are misses.
+  // Default: nullptr (disabled)
+  std::shared_ptr<NegativeLookupCache> negative_lookup_cache = nullptr;
+
+  // EXPERIMENTAL
+  // A cache of row values recently read from the table files, consulted by
+  // point lookups after the memtables miss. Unlike row_cache, entries are
+  // keyed by user key rather than table file number, so they survive
+  // compactions. See NewRowLookupCache() in rocksdb/row_lookup_cache.h.
+  // Default: nullptr (disabled)
+  std::shared_ptr<RowLookupCache> row_lookup_cache = nullptr;
+
 #ifndef ROCKSDB_LITE
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
@@ -1193,6 +1367,19 @@ struct DBOptions {
   // DEFAULT: false
   bool avoid_flush_during_recovery = false;
 
+  // EXPERIMENTAL
+  // If greater than 1, WAL write batches are applied to the memtables by up
+  // to this many threads during recovery, partitioned by column family id.
+  // The WAL format guarantees ordering per column family, and the sequence
+  // number bookkeeping is computed identically by every worker, so recovery
+  // results are unchanged; only replay of large batches that span multiple
+  // column families is spread over threads. DBs using two-phase commit or
+  // seq_per_batch (e.g. WritePrepared transactions) fall back to
+  // single-threaded replay.
+  //
+  // DEFAULT: 1 (single-threaded WAL replay)
+  int max_wal_recovery_threads = 1;
+
   // By default RocksDB will flush all memtables on DB close if there are
   // unpersisted data (i.e. with WAL disabled) The flush can be skip to speedup
   // DB close. Unpersisted data WILL BE LOST.
@@ -1390,6 +1577,38 @@ struct DBOptions {
   // of the contract leads to undefined behaviors with high possibility of data
   // inconsistency, e.g. deleted old data become visible again, etc.
   bool enforce_single_del_contracts = true;
+
+  // EXPERIMENTAL
+  // If true and the platform supports it (Linux with io_uring), WAL appends
+  // are submitted asynchronously to an io_uring instance and awaited at the
+  // next WAL sync, so a write group leader can overlap WAL persistence with
+  // other work instead of blocking on each write() call. Ignored on
+  // platforms without io_uring support.
+  //
+  // Default: false
+  bool use_io_uring_wal_writes = false;
+
+  // EXPERIMENTAL
+  // If true, SST files written by flush and compaction use double-buffered
+  // writes: a table builder keeps producing blocks into a fresh buffer while
+  // a background thread drains previously filled buffers to the file, and
+  // Sync() acts as a completion barrier. Only applies to buffered
+  // (non-direct) I/O. See EnvOptions::use_async_buffered_writes.
+  //
+  // Default: false
+  bool use_async_sst_file_writes = false;
+
+  // EXPERIMENTAL
+  // A pre-trained compression dictionary for WAL compression (see
+  // wal_compression). WAL records are short, so a dictionary trained on
+  // representative write traffic can improve their compression ratio
+  // substantially. The dictionary is not persisted in the WAL: recovering a
+  // WAL that was written with a dictionary requires opening the DB with the
+  // exact same dictionary, so treat it as immutable once deployed. Ignored
+  // when empty or when wal_compression does not support dictionaries.
+  //
+  // Default: empty (no dictionary)
+  std::string wal_compression_dict = "";
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -1504,6 +1723,11 @@ struct ReadOptions {
   // needed.
   // Using a large readahead size (> 2MB) can typically improve the performance
   // of forward iteration on spinning disks.
+  // When the column family stores large values in blob files (see
+  // AdvancedColumnFamilyOptions::enable_blob_files), a non-zero value also
+  // enables readahead of the same size for the blob files referenced by the
+  // iterator, so that consecutive blob values are resolved using batched
+  // reads instead of one small read per entry.
   // Default: 0
   size_t readahead_size;
 
@@ -1604,8 +1828,10 @@ struct ReadOptions {
   // A callback to determine whether relevant keys for this scan exist in a
   // given table based on the table's properties. The callback is passed the
   // properties of each table during iteration. If the callback returns false,
-  // the table will not be scanned. This option only affects Iterators and has
-  // no impact on point lookups.
+  // the table is skipped entirely and contributes nothing to the scan,
+  // including its range tombstones. Tables whose properties are already
+  // resident in the table cache are pruned without touching the file at all.
+  // This option only affects Iterators and has no impact on point lookups.
   // Default: empty (every table will be scanned)
   std::function<bool(const TableProperties&)> table_filter;
 
@@ -1685,6 +1911,15 @@ struct ReadOptions {
   // Default: false
   bool async_io;
 
+  // If non-nullptr, record a full PerfContext and IOStatsContext breakdown
+  // for this request into the pointed-to context, independent of the
+  // thread-local contexts and SetPerfLevel(). See RequestPerfContext in
+  // perf_context.h. The caller owns the object and must keep it alive for
+  // the duration of the request.
+  //
+  // Default: nullptr
+  RequestPerfContext* request_perf_context = nullptr;
+
   ReadOptions();
   ReadOptions(bool cksum, bool cache);
 };
@@ -1768,6 +2003,14 @@ struct WriteOptions {
   // Default: zero (disabled).
   size_t protection_bytes_per_key;
 
+  // If non-nullptr, record a full PerfContext and IOStatsContext breakdown
+  // for this write into the pointed-to context, independent of the
+  // thread-local contexts and SetPerfLevel(). See RequestPerfContext in
+  // perf_context.h and ReadOptions::request_perf_context.
+  //
+  // Default: nullptr
+  RequestPerfContext* request_perf_context;
+
   WriteOptions()
       : sync(false),
         disableWAL(false),
@@ -1776,7 +2019,8 @@ struct WriteOptions {
         low_pri(false),
         memtable_insert_hint_per_batch(false),
         rate_limiter_priority(Env::IO_TOTAL),
-        protection_bytes_per_key(0) {}
+        protection_bytes_per_key(0),
+        request_perf_context(nullptr) {}
 };
 
 // Options that control flush operations
@@ -2001,6 +2245,22 @@ struct TraceOptions {
   // Specify trace sampling option, i.e. capture one per how many requests.
   // Default to 1 (capture every request).
   uint64_t sampling_frequency = 1;
+  // Per-operation-type sampling frequencies overriding `sampling_frequency`
+  // for the listed types. Keys are individual TraceFilterType bits, values
+  // have the same "capture one per N requests" meaning as
+  // `sampling_frequency`, e.g. {{kTraceFilterGet, 100},
+  // {kTraceFilterIteratorSeek, 1}} keeps 1% of Gets and every Seek. Each
+  // listed type is counted independently of the other operations, so rare
+  // operations are not crowded out by frequent ones. Types without an entry
+  // fall back to `sampling_frequency`.
+  std::unordered_map<uint64_t, uint64_t> type_sampling_frequency;
+  // If non-empty, only trace Get, MultiGet and iterator seek operations
+  // whose key is >= trace_key_lower_bound (bytewise). A MultiGet is traced
+  // if any of its keys qualifies. Write batches are not key-scoped.
+  std::string trace_key_lower_bound;
+  // If non-empty, only trace Get, MultiGet and iterator seek operations
+  // whose key is < trace_key_upper_bound (bytewise), as above.
+  std::string trace_key_upper_bound;
   // Note: The filtering happens before sampling.
   uint64_t filter = kTraceFilterNone;
   // When true, the order of write records in the trace will match the order of
@@ -2036,6 +2296,15 @@ struct SizeApproximationOptions {
   // If the value is non-positive - a more precise yet more CPU intensive
   // estimation is performed.
   double files_size_error_margin = -1.0;
+  // If true, the files portion of the estimate is answered from a
+  // per-Version size sketch (a cumulative key-range -> bytes histogram
+  // built from file metadata when the version is installed), without
+  // opening table readers or touching index blocks. This keeps frequent
+  // GetApproximateSizes callers off the read path and out of the block
+  // cache, at the cost of accuracy: files straddling a range boundary are
+  // counted as half inside, so the error is bounded by half the total size
+  // of the straddling files. When set, files_size_error_margin is ignored.
+  bool use_size_sketch = false;
 };
 
 struct CompactionServiceOptionsOverride {
@@ -9,6 +9,7 @@
 #include <map>
 #include <string>
 
+#include "rocksdb/iostats_context.h"
 #include "rocksdb/perf_level.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -197,6 +198,12 @@ struct PerfContext {
   uint64_t bloom_sst_hit_count;
   // total number of SST table bloom misses
   uint64_t bloom_sst_miss_count;
+  // number of filter cache lines (or interleaved filter blocks) probed
+  // while evaluating point-lookup filters
+  uint64_t filter_cachelines_touched;
+  // number of filter queries answered from probe state prepared (hashed
+  // and prefetched) up front by a batched MultiGet-style filter check
+  uint64_t filter_prepared_probes_reused;
 
   // Time spent waiting on key locks in transaction lock manager.
   uint64_t key_lock_wait_time;
@@ -253,4 +260,28 @@ struct PerfContext {
 // This function never returns nullptr.
 PerfContext* get_perf_context();
 
+// A unified per-request performance context, combining PerfContext and
+// IOStatsContext in one object that is attached to an individual request
+// through ReadOptions::request_perf_context or
+// WriteOptions::request_perf_context, rather than to a thread.
+//
+// While a request with an attached context executes, perf counting runs at
+// `level` regardless of SetPerfLevel(), and the request's work is accounted
+// to the attached context instead of the calling thread's thread-local
+// contexts, which are saved on entry and restored when the request
+// finishes. This makes it cheap to record a full breakdown for a small
+// sampled fraction of requests without enabling perf levels process- or
+// thread-wide, and without relying on thread identity.
+//
+// The caller owns the object and must keep it alive for the duration of
+// the request. A context must not be attached to two concurrent requests.
+struct RequestPerfContext {
+  // The perf level the request runs at.
+  PerfLevel level = PerfLevel::kEnableTimeExceptForMutex;
+
+  // Filled in when the request finishes.
+  PerfContext perf_context;
+  IOStatsContext iostats_context;
+};
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "rocksdb/env.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
@@ -150,10 +152,22 @@ class RateLimiter {
 // @auto_tuned: Enables dynamic adjustment of rate limit within the range
 //              `[rate_bytes_per_sec / 20, rate_bytes_per_sec]`, according to
 //              the recent demand for background I/O.
+// @priority_reservation_pcts: EXPERIMENTAL. When non-empty, must hold one
+// entry per Env::IOPriority (IO_LOW, IO_MID, IO_HIGH, IO_USER, in that
+// order), each in [0, 100] with a sum of at most 100. Every refill period
+// the given percentage of the refill is reserved for that priority's queue
+// and handed out deficit-round-robin before the regular fairness-based
+// pass, so e.g. flush writes (IO_HIGH) keep their share of the budget even
+// while compactions (IO_LOW/IO_MID) are backlogged. A backlogged priority
+// may bank up to two periods worth of its reservation, letting a short
+// burst (such as a small flush) clear in one period; an idle priority
+// forfeits its deficit. Unreserved and unused bytes are still distributed
+// to all priorities as before, so the limiter stays work conserving.
 extern RateLimiter* NewGenericRateLimiter(
     int64_t rate_bytes_per_sec, int64_t refill_period_us = 100 * 1000,
     int32_t fairness = 10,
     RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly,
-    bool auto_tuned = false);
+    bool auto_tuned = false,
+    const std::vector<int32_t>& priority_reservation_pcts = {});
 
 }  // namespace ROCKSDB_NAMESPACE
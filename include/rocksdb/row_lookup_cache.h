@@ -0,0 +1,68 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// EXPERIMENTAL
+// A sharded cache of row values recently read from a column family's table
+// files, consulted by point lookups after the memtables miss. Unlike
+// DBOptions::row_cache, entries are keyed by user key rather than by table
+// file number, so they stay useful across compactions: each entry is tagged
+// with the column family's "new data epoch", which the DB advances only when
+// the file set gains data it did not logically contain before (flush,
+// ingestion), not when a compaction merely rewrites it. A hit serves the row
+// with a single hash probe; there is no per-lookup LRU maintenance, so
+// lookups only touch a shard mutex for the duration of the probe itself.
+//
+// Entries are keyed by column family ID, so a cache shared across DBs should
+// not be, unless the DBs cannot have clashing column family IDs.
+class RowLookupCache {
+ public:
+  // capacity_bytes is an approximate bound on the total memory used by
+  // cached keys, values and their bookkeeping.
+  explicit RowLookupCache(size_t capacity_bytes);
+  // No copying allowed
+  RowLookupCache(const RowLookupCache&) = delete;
+  RowLookupCache& operator=(const RowLookupCache&) = delete;
+
+  ~RowLookupCache();
+
+  // If a value for `user_key` in column family `column_family_id` was
+  // recorded under new data epoch `epoch`, copies it into `*value` and
+  // returns true. Returns false on a cache miss or when the entry was
+  // recorded under a different epoch.
+  bool Lookup(uint32_t column_family_id, const Slice& user_key, uint64_t epoch,
+              std::string* value) const;
+
+  // Records the value read for `user_key` from the table files of
+  // `column_family_id` under new data epoch `epoch`.
+  void Insert(uint32_t column_family_id, const Slice& user_key, uint64_t epoch,
+              const Slice& value);
+
+  // Drops all entries.
+  void Clear();
+
+ private:
+  struct Shard;
+
+  Shard& GetShard(const Slice& cache_key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+  const size_t per_shard_capacity_;
+};
+
+// Create a new RowLookupCache with the given approximate capacity in bytes,
+// for use with DBOptions::row_lookup_cache.
+extern std::shared_ptr<RowLookupCache> NewRowLookupCache(size_t capacity_bytes);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,92 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct HistogramData;
+
+// EXPERIMENTAL
+// Tracks latency percentiles per operation type over a sliding set of time
+// windows and invokes user-registered callbacks when a percentile exceeds
+// its threshold, making it possible to react to degrading tail latencies
+// (e.g. by shedding load) without polling and parsing the stats dump.
+// Create one with NewSLOTracker() and install it via
+// DBOptions::slo_tracker; the DB then records the latency of every tracked
+// operation into it.
+//
+// All methods are thread-safe.
+class SLOTracker {
+ public:
+  enum OpType : uint32_t {
+    kGet = 0,
+    kMultiGet,
+    kSeek,
+    kNext,
+    kWrite,
+    kNumOpTypes,
+  };
+
+  using ThresholdCallback =
+      std::function<void(OpType op_type, double percentile,
+                         uint64_t threshold_micros, double observed_micros)>;
+
+  virtual ~SLOTracker() {}
+
+  // Registers `callback` to be invoked when the given latency percentile
+  // (e.g. 99.0) of the given op type over the tracked windows exceeds
+  // `threshold_micros`. To keep the overhead off the operation path,
+  // thresholds are evaluated periodically rather than on every operation,
+  // and a breached threshold fires at most once per window length. The
+  // callback is invoked from the thread executing the operation that
+  // triggered the evaluation, so it must be fast and must not call back
+  // into the DB.
+  virtual void RegisterThresholdCallback(OpType op_type, double percentile,
+                                         uint64_t threshold_micros,
+                                         ThresholdCallback callback) = 0;
+
+  // Retrieves the latency distribution (in microseconds) of the given op
+  // type over the tracked windows
+  virtual void GetHistogramData(OpType op_type,
+                                HistogramData* data) const = 0;
+
+  // Returns the given latency percentile (e.g. 99.9) in microseconds of
+  // the given op type over the tracked windows
+  virtual double GetPercentile(OpType op_type, double percentile) const = 0;
+
+  // Records a completed operation of the given type; called by the DB
+  virtual void Record(OpType op_type, uint64_t latency_micros) = 0;
+
+  // Times one operation and records it on destruction; no-op when
+  // `tracker` is nullptr. Used by the DB.
+  class ScopedTimer {
+   public:
+    ScopedTimer(SLOTracker* tracker, OpType op_type);
+    ~ScopedTimer();
+
+    // No copying allowed
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+   private:
+    SLOTracker* tracker_;
+    OpType op_type_;
+    uint64_t start_micros_;
+  };
+};
+
+// Creates an SLOTracker whose reported percentiles cover (approximately)
+// the last `num_windows` windows of `window_micros` each.
+extern std::shared_ptr<SLOTracker> NewSLOTracker(
+    uint64_t window_micros = 60 * 1000000ULL, uint64_t num_windows = 3);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -89,13 +89,21 @@ class SstFileWriter {
   // The `skip_filters` option is DEPRECATED and could be removed in the
   // future. Use `BlockBasedTableOptions::filter_policy` to control filter
   // generation.
+  // If `pipelined_build` is true, table building runs on a dedicated
+  // background thread: Add()/Put()/Merge()/Delete() only validate ordering
+  // and hand the entry off, so the caller is not blocked on block building,
+  // compression or file I/O (backpressure applies once the builder falls a
+  // bounded number of blocks behind). Combine with
+  // Options::compression_opts.parallel_threads > 1 to also compress blocks
+  // in parallel. Build and I/O errors surface on Finish().
   SstFileWriter(const EnvOptions& env_options, const Options& options,
                 ColumnFamilyHandle* column_family = nullptr,
                 bool invalidate_page_cache = true,
                 Env::IOPriority io_priority = Env::IOPriority::IO_TOTAL,
-                bool skip_filters = false)
+                bool skip_filters = false, bool pipelined_build = false)
       : SstFileWriter(env_options, options, options.comparator, column_family,
-                      invalidate_page_cache, io_priority, skip_filters) {}
+                      invalidate_page_cache, io_priority, skip_filters,
+                      pipelined_build) {}
 
   // Deprecated API
   SstFileWriter(const EnvOptions& env_options, const Options& options,
@@ -103,7 +111,7 @@ class SstFileWriter {
                 ColumnFamilyHandle* column_family = nullptr,
                 bool invalidate_page_cache = true,
                 Env::IOPriority io_priority = Env::IOPriority::IO_TOTAL,
-                bool skip_filters = false);
+                bool skip_filters = false, bool pipelined_build = false);
 
   ~SstFileWriter();
 
@@ -103,6 +103,18 @@ struct MetadataCacheOptions {
   // any effect. Otherwise the unpartitioned meta-blocks would be held in table
   // reader memory, outside the block cache.
   PinningTier unpartitioned_pinning = PinningTier::kFallback;
+
+  // EXPERIMENTAL
+  // When non-zero, filter and index partitions are additionally pinned and
+  // unpinned adaptively, based on observed per-file accesses. A periodic
+  // maintenance pass promotes a file's partitions to pinned once they have
+  // been accessed at least this many times since the previous pass, and,
+  // when the block cache is under pressure (usage at roughly 90% of
+  // capacity or above), unpins partitions of files that fell below the
+  // threshold so the capacity goes to the metadata that is actually hot.
+  // Files whose partitions are already pinned by `partition_pinning` are
+  // not managed adaptively. 0 (the default) disables adaptive pinning.
+  uint32_t adaptive_pinning_min_accesses = 0;
 };
 
 struct CacheEntryRoleOptions {
@@ -229,6 +241,32 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // EXPERIMENTAL.
+    // Like kBinarySearch, but seeks consult a piecewise linear model
+    // ("learned index") over the first keys of the data blocks, built in
+    // memory when the table is opened, so a seek touches one or two restart
+    // points instead of a log2(#blocks) binary search. The on-disk format is
+    // the same as kBinarySearch except that index_block_restart_interval is
+    // forced to 1. The model requires keys whose bytewise order matches the
+    // comparator order: with a non-default comparator, user-defined
+    // timestamps, or keys the model cannot fit, seeks silently fall back to
+    // plain binary search.
+    kLearnedSearch = 0x04,
+
+    // EXPERIMENTAL.
+    // Like kBinarySearch, but a bucket array hashed over the whole user
+    // keys is serialized next to the index block, so a point lookup (Get /
+    // MultiGet) resolves directly to its data block instead of binary
+    // searching the index. Hash collisions fall back to the binary search,
+    // and iterators always use it, so results are unaffected. Unlike
+    // kHashSearch this needs no prefix_extractor. Intended for point-
+    // lookup-heavy column families; costs roughly 5-6 bytes per key of
+    // additional index space. With user-defined timestamps the bucket
+    // array is not written and lookups degrade to binary search. Files
+    // written with this index type are not readable by RocksDB versions
+    // that do not support it.
+    kWholeKeyHashSearch = 0x05,
   };
 
   IndexType index_type = kBinarySearch;
@@ -294,6 +332,17 @@ struct BlockBasedTableOptions {
   // Same as block_restart_interval but used for the index block.
   int index_block_restart_interval = 1;
 
+  // EXPERIMENTAL: if true, index entries store no inline block handle.
+  // Instead the data block offsets are written as a fixed-stride array in
+  // a separate meta block, with each block's size derived from the next
+  // offset. This shrinks the binary-searched portion of the index block
+  // and turns handle decoding into a single load instead of a chain of
+  // varint decodes. Only applies when index_type is kBinarySearch or
+  // kLearnedSearch and index_block_restart_interval is 1; ignored
+  // otherwise. Files written with this option cannot be read by RocksDB
+  // versions that do not support it.
+  bool use_fixed_stride_index_handles = false;
+
   // Block size for partitioned metadata. Currently applied to indexes when
   // kTwoLevelIndexSearch is used and to filters when partition_filters is used.
   // Note: Since in the current implementation the filters and index partitions
@@ -401,6 +450,24 @@ struct BlockBasedTableOptions {
   // block cache even when cache_index_and_filter_blocks=false.
   bool partition_filters = false;
 
+  // EXPERIMENTAL
+  // When non-zero and partition_filters is enabled, additionally build a
+  // small whole-file "fence" Bloom filter with this many bits per key over
+  // every key (and prefix) in the file. The fence filter lives in its own
+  // meta block, stays pinned in the table reader, and is consulted before
+  // the top-level filter index, so most negative queries skip the filter
+  // partition fetch (and the associated block cache traffic) entirely.
+  // Because it covers the whole file at few bits per key it is expected to
+  // have a high false positive rate; it is a fence in front of the real
+  // partitioned filter, not a replacement for it.
+  //
+  // Typical values are 2 to 4. Files written with this option remain
+  // readable by older versions, which ignore the extra meta block, and
+  // files without the block are read as if the option were off.
+  //
+  // Default: 0 (no fence filter)
+  uint32_t fence_filter_bits_per_key = 0;
+
   // Option to generate Bloom/Ribbon filters that minimize memory
   // internal fragmentation.
   //
@@ -518,6 +585,10 @@ struct BlockBasedTableOptions {
   // 5 -- Can be read by RocksDB's versions since 6.6.0. Full and partitioned
   // filters use a generally faster and more accurate Bloom filter
   // implementation, with a different schema.
+  // 6 -- Can only be read by this fork. Data block entry headers (shared,
+  // non-shared and value lengths) are group-encoded behind a control byte
+  // instead of three varints, so they decode without data-dependent
+  // branches. Speeds up in-memory scans; slightly larger blocks.
   uint32_t format_version = 5;
 
   // Store index blocks on disk in compressed format. Changing this option to
@@ -591,6 +662,19 @@ struct BlockBasedTableOptions {
   // Default: 256 KB (256 * 1024).
   size_t max_auto_readahead_size = 256 * 1024;
 
+  // EXPERIMENTAL
+  // Number of prefetch buffers kept per table file when scanning with
+  // ReadOptions::async_io. Up to async_prefetch_depth - 1 asynchronous reads
+  // are kept in flight ahead of the buffer being consumed, so this controls
+  // the effective queue depth on the device; NVMe devices typically need a
+  // higher depth than the default to reach full bandwidth. Each in-flight
+  // read covers up to half of the current readahead size, which still adapts
+  // between initial_auto_readahead_size and max_auto_readahead_size based on
+  // the observed read pattern. Values below 2 are treated as 2.
+  //
+  // Default: 2 (one read in flight, the behavior before this option existed).
+  size_t async_prefetch_depth = 2;
+
   // If enabled, prepopulate warm/hot blocks (data, uncompressed dict, index and
   // filter blocks) which are already in memory into block cache at the time of
   // flush. On a flush, the block that is in memory (in memtables) get flushed
@@ -608,6 +692,12 @@ struct BlockBasedTableOptions {
     kDisable,
     // Prepopulate blocks during flush only.
     kFlushOnly,
+    // Prepopulate blocks during flush, and additionally warm compaction
+    // output files for the key ranges whose input data blocks were resident
+    // in the block cache when the compaction finished. Compaction outputs
+    // for cold ranges are not inserted, so hot ranges stay warm across
+    // compactions without flooding the cache with cold data.
+    kFlushAndCompaction,
   };
 
   PrepopulateBlockCache prepopulate_block_cache =
@@ -641,6 +731,21 @@ struct BlockBasedTableOptions {
   //
   // Default: 8 KB (8 * 1024).
   size_t initial_auto_readahead_size = 8 * 1024;
+
+  // EXPERIMENTAL
+  // Number of entries in a small per-table-reader cache mapping a user key
+  // fingerprint to the data block handle where the last point lookup for
+  // that key completed. When a Get hits the cache, the index iterator (and
+  // the index block binary search) is skipped and the data block is
+  // retrieved directly; the result is validated against the block contents,
+  // so a mismatch simply falls back to the regular index path. This helps
+  // point-lookup heavy workloads where a skewed (e.g. Zipfian) key
+  // distribution keeps hitting the same blocks, at a cost of 24 bytes of
+  // table reader memory per entry. Rounded up to a power of two. Ignored
+  // for column families with user-defined timestamps.
+  //
+  // Default: 0 (disabled).
+  size_t hot_key_handle_cache_entries = 0;
 };
 
 // Table Properties that are specific to block-based table properties.
@@ -777,6 +882,11 @@ struct CuckooTablePropertyNames {
   static const std::string kUseModuleHash;
   // Fixed user key length
   static const std::string kUserKeyLength;
+  // crc32c of the hash table (the data blob holding all buckets). Written
+  // by newer builders; readers verify it at open when present. Files
+  // written before this property was introduced simply lack it and are
+  // not verified.
+  static const std::string kDataChecksum;
 };
 
 struct CuckooTableOptions {
@@ -808,12 +918,59 @@ struct CuckooTableOptions {
   // power of two, and bit and is used to calculate hash, which is faster in
   // general.
   bool use_module_hash = true;
+  // Number of threads used to precompute bucket hashes while building the
+  // table. Placement itself stays single threaded (displacing keys is order
+  // dependent) but hashing dominates build time for large files. Values <= 1
+  // keep the build fully single threaded.
+  uint32_t max_build_threads = 1;
 };
 
 // Cuckoo Table Factory for SST table format using Cache Friendly Cuckoo Hashing
 extern TableFactory* NewCuckooTableFactory(
     const CuckooTableOptions& table_options = CuckooTableOptions());
 
+struct FlatTablePropertyNames {
+  // Fixed length of value.
+  static const std::string kValueLength;
+  // Number of displacement buckets of the perfect hash function.
+  static const std::string kNumBuckets;
+  // Number of key-value slots. Equal to the number of entries since the
+  // hash function is minimal.
+  static const std::string kNumSlots;
+  // Denotes if the key sorted in the file is Internal Key (if false)
+  // or User Key only (if true).
+  static const std::string kIsLastLevel;
+  // Fixed user key length
+  static const std::string kUserKeyLength;
+};
+
+struct FlatTableOptions {
+  static const char* kName() { return "FlatTableOptions"; };
+
+  // Average number of keys hashed into one displacement bucket of the
+  // perfect hash function. Larger values shrink the displacement array
+  // (4 bytes per bucket) but make file building slower.
+  uint32_t keys_per_bucket = 4;
+
+  // Maximum displacement value the builder tries per bucket before giving
+  // up on building the perfect hash function. Builds practically never
+  // need more than a few thousand; this is a safety bound.
+  uint32_t max_displacement = 1 << 20;
+};
+
+// Flat Table stores fixed-stride key-value slots addressed by a minimal
+// perfect hash function over whole user keys, built at flush/compaction
+// time. A point lookup computes the slot from the displacement array kept
+// in memory and issues exactly one read of one slot. Unlike PlainTable it
+// does not require mmap or a prefix extractor and works with direct I/O.
+//
+// Some assumptions:
+// - Key length and Value length are fixed.
+// - Does not support Snapshot.
+// - Does not support Merge operations.
+extern TableFactory* NewFlatTableFactory(
+    const FlatTableOptions& table_options = FlatTableOptions());
+
 #endif  // ROCKSDB_LITE
 
 class RandomAccessFileReader;
@@ -827,6 +984,7 @@ class TableFactory : public Customizable {
   static const char* kBlockBasedTableName() { return "BlockBasedTable"; };
   static const char* kPlainTableName() { return "PlainTable"; }
   static const char* kCuckooTableName() { return "CuckooTable"; };
+  static const char* kFlatTableName() { return "FlatTable"; };
 
   // Creates and configures a new TableFactory from the input options and id.
   static Status CreateFromString(const ConfigOptions& config_options,
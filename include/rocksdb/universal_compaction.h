@@ -81,6 +81,18 @@ class CompactionOptionsUniversal {
   // Default: false
   bool incremental;
 
+  // EXPERIMENTAL
+  // Hybrid "lazy leveling" shape: the upper levels stay tiered while the
+  // last level is kept as a single fully sorted run. Size-ratio and
+  // sorted-run-count compactions only merge the tiered runs with each other
+  // and never include the last level, so the bulk of the data is rewritten
+  // only when a size-amplification (or delete/periodic) compaction merges
+  // everything into the bottom. This trades tiered write amplification on
+  // the upper levels for leveled read amplification at the bottom, tuned by
+  // max_size_amplification_percent.
+  // Default: false
+  bool lazy_leveling;
+
   // Default set of parameters
   CompactionOptionsUniversal()
       : size_ratio(1),
@@ -90,7 +102,8 @@ class CompactionOptionsUniversal {
         compression_size_percent(-1),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
-        incremental(false) {}
+        incremental(false),
+        lazy_leveling(false) {}
 };
 
 }  // namespace ROCKSDB_NAMESPACE
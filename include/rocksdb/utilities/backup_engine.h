@@ -220,6 +220,22 @@ struct BackupEngineOptions {
   // setting, a known temperature overrides UNKNOWN.
   bool current_temperatures_override_manifest = false;
 
+  // If true, copy backup files with kernel-side zero-copy
+  // (copy_file_range(), falling back to sendfile()) when both the DB and
+  // the backup directory live on the default POSIX file system and the
+  // file's checksum is already known (e.g. from the DB manifest or from
+  // the checksum pass that names shared_checksum files), avoiding a
+  // second read of the file through user space. Currently only has an
+  // effect on Linux.
+  //
+  // Trade-off: with this option the copy itself is not re-checksummed, so
+  // corruption introduced during the copy is only caught by a later
+  // VerifyBackup(..., verify_with_checksum=true) rather than at backup
+  // time. Rate limits and progress callbacks still apply.
+  //
+  // Default: false
+  bool zero_copy_local_backup = false;
+
   void Dump(Logger* logger) const;
 
   explicit BackupEngineOptions(
@@ -300,6 +316,15 @@ struct RestoreOptions {
   // Default: false
   bool keep_log_files;
 
+  // If true, the backup files are read with direct I/O, bypassing the OS
+  // page cache. Recommended when restoring a large DB on a live host, so
+  // that streaming terabytes of backup data through the cache does not
+  // evict the working set of the databases still serving traffic.
+  // Restore parallelism is governed by
+  // BackupEngineOptions::max_background_operations, same as backup.
+  // Default: false
+  bool use_direct_reads = false;
+
   explicit RestoreOptions(bool _keep_log_files = false)
       : keep_log_files(_keep_log_files) {}
 };
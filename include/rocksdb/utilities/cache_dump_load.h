@@ -68,6 +68,14 @@ class CacheDumpReader {
 // dump or load process related control variables can be added here.
 struct CacheDumpOptions {
   SystemClock* clock;
+  // Number of worker threads used by the default CacheDumper and
+  // CacheDumpedLoader. For the dumper, the workers encode and checksum the
+  // blocks copied out of the cache while the writes to the CacheDumpWriter
+  // stay ordered; for the loader, the workers verify, decode, and insert
+  // the blocks read by a single reader thread. 0 or 1 means all the work
+  // is done inline.
+  // Default: 1
+  uint32_t worker_threads = 1;
 };
 
 // NOTE that: this class is EXPERIMENTAL! May be changed in the future!
@@ -91,6 +99,20 @@ class CacheDumper {
     (void)db_list;
     return Status::NotSupported("SetDumpFilter is not supported");
   }
+  // Skip the blocks whose cache key is in `keys`, e.g. the set returned by
+  // GetDumpedKeys() of a previous dump, so that only the entries added to
+  // the cache since that dump are written out (an incremental dump). The
+  // result is a regular dump file; loading it after the previous one(s)
+  // restores the full set, since re-inserting an already loaded block is
+  // harmless.
+  virtual Status SetAlreadyDumpedKeys(std::set<std::string> keys) {
+    (void)keys;
+    return Status::NotSupported("SetAlreadyDumpedKeys is not supported");
+  }
+  // The keys of the blocks written by the last DumpCacheEntriesToWriter
+  // call. To chain incremental dumps, feed the union of the sets returned
+  // so far into SetAlreadyDumpedKeys of the next dumper.
+  virtual std::set<std::string> GetDumpedKeys() const { return {}; }
   // The main function to dump out all the blocks that satisfy the filter
   // condition from block cache to a certain CacheDumpWriter in one shot. This
   // process may take some time.
@@ -112,6 +134,76 @@ class CacheDumpedLoader {
   }
 };
 
+// Options for shipping block-cache warmth from a primary to secondaries.
+struct CacheWarmthShippingOptions {
+  // Used for scheduling, timestamps, and file operations.
+  // If nullptr, Env::Default() is used.
+  Env* env = nullptr;
+  // The file the warmth is shipped through, e.g. a path in the shared
+  // directory the secondaries already read the primary's files from. The
+  // exporter writes each dump to "<warmth_file>.tmp" and renames it over
+  // warmth_file, so importers never observe a partially written dump.
+  // Required.
+  std::string warmth_file;
+  // Interval at which the primary re-exports its hot block set and at
+  // which a secondary re-checks the file for a new dump.
+  // Default: 10 minutes
+  uint64_t shipping_interval_seconds = 600;
+  // Worker threads used for each dump/load cycle; see
+  // CacheDumpOptions::worker_threads.
+  // Default: 1
+  uint32_t worker_threads = 1;
+};
+
+// NOTE that: this class is EXPERIMENTAL! May be changed in the future!
+// The primary side of cache-warmth shipping. Every
+// shipping_interval_seconds, a background task dumps the blocks that
+// `db` holds in its block cache (via CacheDumper) to warmth_file, from
+// where CacheWarmthImporter instances on the secondaries pick them up.
+class CacheWarmthExporter {
+ public:
+  virtual ~CacheWarmthExporter() = default;
+  // Begin periodic exports. The first dump is taken immediately.
+  virtual Status Start() = 0;
+  // Stop the background work; also performed by the destructor.
+  virtual Status Stop() = 0;
+  // Result of the most recent export, for monitoring. Failed exports are
+  // not fatal; the next interval simply retries.
+  virtual Status LastStatus() = 0;
+};
+
+// NOTE that: this class is EXPERIMENTAL! May be changed in the future!
+// The secondary side of cache-warmth shipping. A background task polls
+// warmth_file and, whenever the primary has published a new dump, loads
+// its blocks into this instance's secondary cache (via
+// CacheDumpedLoader), so a freshly restarted secondary converges on the
+// primary's working set without waiting for reads to miss.
+class CacheWarmthImporter {
+ public:
+  virtual ~CacheWarmthImporter() = default;
+  // Begin polling. The file is checked immediately, then every interval.
+  virtual Status Start() = 0;
+  // Stop the background work; also performed by the destructor.
+  virtual Status Stop() = 0;
+  // Result of the most recent poll/load, for monitoring.
+  virtual Status LastStatus() = 0;
+};
+
+// Create a warmth exporter for `db`, dumping from `cache` (the block
+// cache `db` uses). Does not start it.
+Status NewCacheWarmthExporter(const CacheWarmthShippingOptions& options,
+                              DB* db, const std::shared_ptr<Cache>& cache,
+                              std::unique_ptr<CacheWarmthExporter>* exporter);
+
+// Create a warmth importer inserting into `secondary_cache`. `toptions`
+// must describe the block-based table options of the importing DB so the
+// blocks can be reconstructed. Does not start it.
+Status NewCacheWarmthImporter(
+    const CacheWarmthShippingOptions& options,
+    const BlockBasedTableOptions& toptions,
+    const std::shared_ptr<SecondaryCache>& secondary_cache,
+    std::unique_ptr<CacheWarmthImporter>* importer);
+
 // Get the writer which stores all the metadata and data sequentially to a file
 IOStatus NewToFileCacheDumpWriter(const std::shared_ptr<FileSystem>& fs,
                                   const FileOptions& file_opts,
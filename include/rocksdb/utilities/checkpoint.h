@@ -8,6 +8,7 @@
 #pragma once
 #ifndef ROCKSDB_LITE
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "rocksdb/status.h"
@@ -16,9 +17,24 @@ namespace ROCKSDB_NAMESPACE {
 
 class DB;
 class ColumnFamilyHandle;
+class RateLimiter;
 struct LiveFileMetaData;
 struct ExportImportFilesMetaData;
 
+// Options for Checkpoint::ExportColumnFamily.
+struct ExportColumnFamilyOptions {
+  // Number of threads copying SST files in parallel when the export
+  // directory is on a different filesystem than the DB (hard-linked
+  // exports are cheap and stay sequential). 0 or 1 means the files are
+  // copied one at a time.
+  // Default: 1
+  uint32_t max_copy_threads = 1;
+  // If non-null, the copy reads are charged against this rate limiter so
+  // the export does not saturate the storage the DB is serving from.
+  // Default: nullptr
+  std::shared_ptr<RateLimiter> rate_limiter;
+};
+
 class Checkpoint {
  public:
   // Creates a Checkpoint object to be used for creating openable snapshots
@@ -47,6 +63,26 @@ class Checkpoint {
                                   uint64_t log_size_for_flush = 0,
                                   uint64_t* sequence_number_ptr = nullptr);
 
+  // EXPERIMENTAL
+  // Brings an existing checkpoint directory up to date with the current
+  // state of the DB, in place. Table and blob files are immutable and
+  // uniquely named, so only files that are missing from checkpoint_dir are
+  // hard linked (or copied across filesystems); metadata files (MANIFEST,
+  // CURRENT, OPTIONS, WALs) are always refreshed, and files that are no
+  // longer live are removed. The cost of a refresh is therefore
+  // proportional to the churn since the previous (refresh of the)
+  // checkpoint, not to the total number of files in the DB.
+  // checkpoint_dir must contain a checkpoint previously created by
+  // CreateCheckpoint() or RefreshCheckpoint(). The new CURRENT file is
+  // installed with an atomic rename, so a crash mid-refresh leaves either
+  // the old or the new checkpoint openable, possibly with some unreferenced
+  // extra files that the next refresh cleans up.
+  // log_size_for_flush and sequence_number_ptr behave as in
+  // CreateCheckpoint().
+  virtual Status RefreshCheckpoint(const std::string& checkpoint_dir,
+                                   uint64_t log_size_for_flush = 0,
+                                   uint64_t* sequence_number_ptr = nullptr);
+
   // Exports all live SST files of a specified Column Family onto export_dir,
   // returning SST files information in metadata.
   // - SST files will be created as hard links when the directory specified
@@ -57,6 +93,13 @@ class Checkpoint {
                                     const std::string& export_dir,
                                     ExportImportFilesMetaData** metadata);
 
+  // Same as the above, with control over the copy phase; see
+  // ExportColumnFamilyOptions.
+  virtual Status ExportColumnFamily(ColumnFamilyHandle* handle,
+                                    const std::string& export_dir,
+                                    ExportImportFilesMetaData** metadata,
+                                    const ExportColumnFamilyOptions& options);
+
   virtual ~Checkpoint() {}
 };
 
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -46,5 +48,59 @@ class MemoryUtil {
       const std::unordered_set<const Cache*> cache_set,
       std::map<MemoryUtil::UsageType, uint64_t>* usage_by_type);
 };
+
+// Options for a MemoryMonitor.
+struct MemoryMonitorOptions {
+  // Used for scheduling the polls. If nullptr, Env::Default() is used.
+  Env* env = nullptr;
+  // Interval at which the monitor re-aggregates the memory usage of the
+  // registered DBs and caches.
+  // Default: 10 seconds
+  uint64_t poll_interval_seconds = 10;
+  // If > 0, on_high_watermark is invoked when the aggregate usage
+  // (kMemTableTotal + kTableReadersTotal + kCacheTotal; kMemTableUnFlushed
+  // is a subset of kMemTableTotal and not counted again) crosses this
+  // value from below. The callback re-arms once the usage drops below the
+  // watermark again.
+  // Default: 0 (no watermark)
+  uint64_t high_watermark_bytes = 0;
+  // Invoked from the monitor's background thread with the usage breakdown
+  // and the aggregate that crossed the watermark, e.g. to trigger a flush
+  // or cache eviction before the kernel OOM killer steps in. Must not
+  // block for long; the next poll is delayed until it returns.
+  std::function<void(
+      const std::map<MemoryUtil::UsageType, uint64_t>& usage_by_type,
+      uint64_t total_usage)>
+      on_high_watermark;
+};
+
+// NOTE that: this class is EXPERIMENTAL! May be changed in the future!
+// A background monitor that keeps the memory usage aggregation of
+// GetApproximateMemoryUsageByType continuously up to date, so callers can
+// read an instant snapshot instead of paying for the walk on every poll,
+// and that pushes a high-watermark notification for proactive
+// flush/evict. The monitored DBs and caches must outlive the monitor (or
+// the monitor must be stopped before they are closed).
+class MemoryMonitor {
+ public:
+  virtual ~MemoryMonitor() = default;
+  // Begin polling. The first poll is taken immediately.
+  virtual Status Start() = 0;
+  // Stop the background work; also performed by the destructor.
+  virtual Status Stop() = 0;
+  // Copy of the most recently polled usage breakdown. Does not walk the
+  // DBs; this is cheap enough to call at high frequency. Returns the
+  // status of the last poll.
+  virtual Status GetUsageSnapshot(
+      std::map<MemoryUtil::UsageType, uint64_t>* usage_by_type) = 0;
+};
+
+// Create a monitor over `dbs` and `cache_set` (the same inputs
+// MemoryUtil::GetApproximateMemoryUsageByType takes). Does not start it.
+Status NewMemoryMonitor(const MemoryMonitorOptions& options,
+                        const std::vector<DB*>& dbs,
+                        const std::unordered_set<const Cache*>& cache_set,
+                        std::unique_ptr<MemoryMonitor>* monitor);
+
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // !ROCKSDB_LITE
@@ -29,10 +29,23 @@ struct ReplayOptions {
   //   If > 1, speed up the replay by this amount.
   double fast_forward;
 
-  ReplayOptions() : num_threads(1), fast_forward(1.0) {}
+  // Only takes effect when num_threads > 1. By default, multi-threaded
+  // replay executes records in whatever order the threads get to them, so
+  // operations on the same key may be reordered relative to the trace. If
+  // true, records are partitioned into num_threads lanes by key hash and
+  // each lane replays its records in trace order, preserving per-key
+  // ordering; records whose keys span multiple lanes (e.g. a WriteBatch)
+  // are synchronized across the involved lanes. This makes a sped-up
+  // replay produce the same per-key end state as the original workload.
+  bool preserve_key_order;
+
+  ReplayOptions()
+      : num_threads(1), fast_forward(1.0), preserve_key_order(false) {}
 
   ReplayOptions(uint32_t num_of_threads, double fast_forward_ratio)
-      : num_threads(num_of_threads), fast_forward(fast_forward_ratio) {}
+      : num_threads(num_of_threads),
+        fast_forward(fast_forward_ratio),
+        preserve_key_order(false) {}
 };
 
 // Replayer helps to replay the captured RocksDB query level operations.
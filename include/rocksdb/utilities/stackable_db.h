@@ -110,6 +110,15 @@ class StackableDB : public DB {
                                  number_of_operands);
   }
 
+  using DB::GetMergeOperandsIterator;
+  virtual Status GetMergeOperandsIterator(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      const Slice& key,
+      std::unique_ptr<MergeOperandsIterator>* iterator) override {
+    return db_->GetMergeOperandsIterator(options, column_family, key,
+                                         iterator);
+  }
+
   using DB::MultiGet;
   virtual std::vector<Status> MultiGet(
       const ReadOptions& options,
@@ -520,6 +529,16 @@ class StackableDB : public DB {
     return db_->GetUpdatesSince(seq_number, iter, read_options);
   }
 
+  virtual Status RegisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& sink) override {
+    return db_->RegisterWalStreamSink(sink);
+  }
+
+  virtual Status UnregisterWalStreamSink(
+      const std::shared_ptr<WalStreamSink>& sink) override {
+    return db_->UnregisterWalStreamSink(sink);
+  }
+
   virtual Status SuggestCompactRange(ColumnFamilyHandle* column_family,
                                      const Slice* begin,
                                      const Slice* end) override {
@@ -531,6 +550,13 @@ class StackableDB : public DB {
     return db_->PromoteL0(column_family, target_level);
   }
 
+  virtual Status GetScanPartitionBoundaries(
+      ColumnFamilyHandle* column_family, const Slice* begin, const Slice* end,
+      size_t max_partitions, std::vector<std::string>* boundaries) override {
+    return db_->GetScanPartitionBoundaries(column_family, begin, end,
+                                           max_partitions, boundaries);
+  }
+
   virtual ColumnFamilyHandle* DefaultColumnFamily() const override {
     return db_->DefaultColumnFamily();
   }
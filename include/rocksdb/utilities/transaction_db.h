@@ -161,8 +161,21 @@ struct TransactionDBOptions {
   // Increasing this value will increase the concurrency by dividing the lock
   // table (per column family) into more sub-tables, each with their own
   // separate mutex.
+  // If set to 0, the number of stripes is chosen automatically based on the
+  // number of CPU cores, which is a better fit for hosts with many
+  // concurrently locking threads than the fixed default.
   size_t num_stripes = 16;
 
+  // If true, deadlock detection for point locks runs on a dedicated
+  // background thread instead of on the lock-acquire path: transactions that
+  // block only publish their wait-for edges, and the detector walks the
+  // graph asynchronously, picking a victim of any cycle it finds to abort
+  // with Status::Busy(). This keeps lock-acquire latency flat for
+  // transactions with TransactionOptions::deadlock_detect set, at the cost
+  // of deadlocks being noticed with a small delay.
+  // Only effective with the point lock manager.
+  bool async_deadlock_detect = false;
+
   // If positive, specifies the default wait timeout in milliseconds when
   // a transaction attempts to lock a key if not specified by
   // TransactionOptions::lock_timeout.
@@ -236,16 +249,25 @@ struct TransactionDBOptions {
                      const Slice& /*key*/)>
       rollback_deletion_type_callback;
 
- private:
-  // 128 entries
+  // Number of sequence numbers that the lock-free snapshot cache used by
+  // write-prepared/write-unprepared transactions can hold: 128 entries by
+  // default. Snapshots beyond that spill to a sorted list protected by a
+  // shared mutex.
   // Should the default value change, please also update wp_snapshot_cache_bits
   // in db_stress_gflags.cc
   size_t wp_snapshot_cache_bits = static_cast<size_t>(7);
-  // 8m entry, 64MB size
+
+  // Size of the lock-free commit cache used by write-prepared/write-unprepared
+  // transactions, as a power of two: 8m entries (64MB) by default. The cache
+  // holds the commit sequence of the last 2^wp_commit_cache_bits sequence
+  // numbers; reads against data older than that window fall back to slower
+  // eviction bookkeeping, so workloads whose transactions or snapshots live
+  // longer than the window benefit from a larger cache.
   // Should the default value change, please also update wp_commit_cache_bits
   // in db_stress_gflags.cc
   size_t wp_commit_cache_bits = static_cast<size_t>(23);
 
+ private:
   // For testing, whether transaction name should be auto-generated or not. This
   // is useful for write unprepared which requires named transactions.
   bool autogenerate_name = false;
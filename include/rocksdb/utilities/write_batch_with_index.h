@@ -95,10 +95,17 @@ class WriteBatchWithIndex : public WriteBatchBase {
   // overwrite_key: if true, overwrite the key in the index when inserting
   //                the same key as previously, so iterator will never
   //                show two entries with the same key.
+  // use_hash_index: if true, additionally maintain a hash index of the latest
+  //                update for each key, making point lookups through
+  //                GetFromBatch() and GetFromBatchAndDB() O(1) instead of an
+  //                ordered search. Only engaged for column families whose
+  //                comparator equality coincides with byte equality (e.g. the
+  //                bytewise comparators); iterators are unaffected.
   explicit WriteBatchWithIndex(
       const Comparator* backup_index_comparator = BytewiseComparator(),
       size_t reserved_bytes = 0, bool overwrite_key = false,
-      size_t max_bytes = 0, size_t protection_bytes_per_key = 0);
+      size_t max_bytes = 0, size_t protection_bytes_per_key = 0,
+      bool use_hash_index = false);
 
   ~WriteBatchWithIndex() override;
   WriteBatchWithIndex(WriteBatchWithIndex&&);
@@ -292,6 +299,16 @@ class WriteBatchWithIndex : public WriteBatchBase {
   // last sub-batch.
   size_t SubBatchCnt();
 
+  // Point lookup through the optional hash index (see use_hash_index). If
+  // the hash index can answer the lookup authoritatively, returns true and
+  // sets *exists; when *exists is true, *entry is the latest update for the
+  // key, valid until the next mutation of the batch. Returns false when the
+  // hash index is disabled, does not apply to the column family, or the
+  // latest update is a merge, whose older operands need an ordered scan.
+  bool GetEntryFromHashIndex(ColumnFamilyHandle* column_family,
+                             const Slice& key, WriteEntry* entry,
+                             bool* exists);
+
   Status GetFromBatchAndDB(DB* db, const ReadOptions& read_options,
                            ColumnFamilyHandle* column_family, const Slice& key,
                            PinnableSlice* value, ReadCallback* callback);
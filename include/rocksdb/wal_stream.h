@@ -0,0 +1,64 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#ifndef ROCKSDB_LITE
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "rocksdb/types.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// NOTE that: this class is EXPERIMENTAL! May be changed in the future!
+//
+// A sink that receives each write group's WAL payload in memory at commit
+// time, registered via DB::RegisterWalStreamSink. This enables push-based
+// replication without polling DB::GetUpdatesSince, which re-opens and
+// re-reads WAL files from disk on every call.
+//
+// Delivery contract:
+// * OnWalWrite is called once per WAL record, in WAL order, right after the
+//   record is appended to the log file. `sequence` is the sequence number
+//   of the first update in the record and `payload` is the serialized
+//   WriteBatch, valid only for the duration of the call (copy it to keep
+//   it). The same representation is returned by
+//   TransactionLogIterator::GetBatch, so both delivery paths feed the same
+//   downstream code.
+// * OnWalWrite runs on the write path; implementations must be fast (e.g.
+//   enqueue to the sink's own buffer) since blocking here stalls all
+//   writers.
+// * Records are delivered before the WAL is synced. A crash may lose
+//   payloads that sinks have already seen; replication that requires
+//   durability must track the primary's persisted sequence separately.
+// * Backpressure: when a sink cannot keep up (e.g. its buffer is full), it
+//   returns a non-OK status from OnWalWrite. The DB then detaches the sink
+//   and calls OnStreamStalled with the sequence number of the first record
+//   the sink did not receive. The WAL on disk is the spill: the sink
+//   catches up via DB::GetUpdatesSince(next_sequence), re-registers, and
+//   continues reading GetUpdatesSince until it reaches the first sequence
+//   pushed after re-registration, buffering pushed records meanwhile.
+class WalStreamSink {
+ public:
+  virtual ~WalStreamSink() = default;
+
+  // A name identifying the sink, for logging and debugging.
+  virtual const char* Name() const = 0;
+
+  // See the delivery contract above. Returning a non-OK status detaches
+  // the sink from the DB.
+  virtual Status OnWalWrite(SequenceNumber sequence, const Slice& payload) = 0;
+
+  // Called (on the write path) when the sink has been detached because
+  // OnWalWrite returned `cause`. `next_sequence` is where to resume from
+  // via DB::GetUpdatesSince. The sink is no longer registered when this is
+  // called.
+  virtual void OnStreamStalled(SequenceNumber /*next_sequence*/,
+                               const Status& /*cause*/) {}
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
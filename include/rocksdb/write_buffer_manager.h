@@ -105,6 +105,14 @@ class WriteBufferManager final {
         // triggering more flush may not help. We will hold it instead.
         return true;
       }
+      if (ProjectedToExceedBufferSize() &&
+          mutable_memtable_memory_usage() >= local_size / 2) {
+        // At the recently observed fill rate we will hit buffer_size within
+        // roughly one rate window, so start flushing proactively instead of
+        // letting every writer slam into the stall threshold at once. The
+        // same half-flushing guard as above bounds how much we schedule.
+        return true;
+      }
     }
     return false;
   }
@@ -170,7 +178,17 @@ class WriteBufferManager final {
   // while holding mu_, but it can be read without a lock.
   std::atomic<bool> stall_active_;
 
+  // Fill-rate tracking for proactive flush scheduling; see ShouldFlush().
+  std::atomic<uint64_t> fill_rate_window_start_micros_;
+  std::atomic<size_t> fill_rate_window_bytes_;
+  std::atomic<size_t> fill_rate_last_window_bytes_;
+
   void ReserveMemWithCache(size_t mem);
   void FreeMemWithCache(size_t mem);
+  void UpdateFillRate(size_t mem);
+  // Returns true if, extrapolating the bytes reserved during the previous
+  // rate window, total memory usage would reach buffer_size before another
+  // window elapses.
+  bool ProjectedToExceedBufferSize() const;
 };
 }  // namespace ROCKSDB_NAMESPACE
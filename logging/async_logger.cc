@@ -0,0 +1,177 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#include "logging/async_logger.h"
+
+#include <cinttypes>
+
+#include "logging/logging.h"
+#include "rocksdb/system_clock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+#ifndef ROCKSDB_LITE
+
+namespace {
+// How long the background thread sleeps when the ring is empty. Producers
+// never signal it (that would reintroduce a lock on the logging path), so
+// this bounds the latency between Logv() and the line reaching the log.
+const uint64_t kIdleWaitMicros = 10 * 1000;
+
+// Forward an already formatted and level-filtered line to `target`.
+void LogLine(Logger* target, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  target->Logv(format, args);
+  va_end(args);
+}
+}  // namespace
+
+AsyncLogger::AsyncLogger(const std::shared_ptr<Logger>& target)
+    : Logger(target->GetInfoLogLevel()),
+      target_(target),
+      slots_(new Slot[kRingSize]),
+      enqueue_pos_(0),
+      dequeue_pos_(0),
+      dropped_(0),
+      flush_pending_(false),
+      shutting_down_(false),
+      mutex_(),
+      bg_cv_(&mutex_) {
+  static_assert((kRingSize & (kRingSize - 1)) == 0,
+                "kRingSize must be a power of two");
+  for (uint64_t i = 0; i < kRingSize; ++i) {
+    slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+  bg_thread_ = port::Thread(&AsyncLogger::BackgroundThread, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  if (!closed_) {
+    CloseImpl().PermitUncheckedError();
+  }
+}
+
+Status AsyncLogger::CloseImpl() {
+  if (bg_thread_.joinable()) {
+    {
+      MutexLock l(&mutex_);
+      shutting_down_.store(true, std::memory_order_release);
+      bg_cv_.SignalAll();
+    }
+    bg_thread_.join();
+  }
+  return target_->Close();
+}
+
+bool AsyncLogger::Enqueue(const char* format, va_list ap) {
+  uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = slots_[pos & (kRingSize - 1)];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    int64_t dif = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (dif == 0) {
+      // The slot is free; try to claim position `pos`. On failure `pos` is
+      // reloaded by compare_exchange_weak and we retry.
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        int count = vsnprintf(slot.msg, kMaxMessageSize, format, ap);
+        (void)count;
+        assert(count >= 0);
+        slot.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (dif < 0) {
+      // The consumer has not freed this slot yet: the ring is full. Drop
+      // rather than wait; the background thread reports the count.
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      // Another producer claimed `pos` first; catch up.
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncLogger::DrainOnce() {
+  bool did_work = false;
+  for (;;) {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & (kRingSize - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+      // The next message is either not enqueued or still being formatted.
+      break;
+    }
+    // The message is a fully formatted line (any level prefix was added
+    // before it was queued); pass it through verbatim.
+    LogLine(target_.get(), "%s", slot.msg);
+    // Mark the slot free for the producer one lap ahead.
+    slot.seq.store(pos + kRingSize, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_release);
+    did_work = true;
+  }
+  return did_work;
+}
+
+void AsyncLogger::BackgroundThread() {
+  for (;;) {
+    bool did_work = DrainOnce();
+    uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      ROCKS_LOG_WARN(target_.get(),
+                     "%" PRIu64
+                     " info log entries dropped because the async logging "
+                     "buffer was full",
+                     dropped);
+    }
+    if (flush_pending_.exchange(false, std::memory_order_acquire)) {
+      target_->Flush();
+    }
+    if (did_work || dropped > 0) {
+      continue;
+    }
+    if (shutting_down_.load(std::memory_order_acquire)) {
+      // Producers racing with shutdown may still have slots mid-format;
+      // take one final pass before exiting.
+      DrainOnce();
+      break;
+    }
+    MutexLock l(&mutex_);
+    if (!shutting_down_.load(std::memory_order_acquire)) {
+      bg_cv_.TimedWait(SystemClock::Default()->NowMicros() + kIdleWaitMicros);
+    }
+  }
+}
+
+void AsyncLogger::Logv(const char* format, va_list ap) {
+  // Returns immediately whether the message was queued or dropped; the
+  // caller never waits for the log device.
+  Enqueue(format, ap);
+}
+
+void AsyncLogger::LogHeader(const char* format, va_list ap) {
+  target_->LogHeader(format, ap);
+}
+
+void AsyncLogger::Flush() {
+  flush_pending_.store(true, std::memory_order_release);
+}
+
+void AsyncLogger::TEST_WaitForDrain() {
+  while (dequeue_pos_.load(std::memory_order_acquire) !=
+             enqueue_pos_.load(std::memory_order_acquire) ||
+         flush_pending_.load(std::memory_order_acquire) ||
+         dropped_.load(std::memory_order_acquire) > 0) {
+    {
+      MutexLock l(&mutex_);
+      bg_cv_.SignalAll();
+    }
+    SystemClock::Default()->SleepForMicroseconds(100);
+  }
+}
+
+#endif  // !ROCKSDB_LITE
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,124 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// Logger decorator that moves the actual log write off the calling thread.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "port/port.h"
+#include "rocksdb/env.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+#ifndef ROCKSDB_LITE
+// AsyncLogger wraps another Logger and makes Logv() non-blocking: the
+// message is formatted into a fixed-size slot of a bounded lock-free ring
+// and a dedicated background thread drains the ring to the wrapped logger.
+// The producer side takes no mutex and never waits for the log device, so
+// logging can not backpressure flush, compaction or the write path even
+// when the log volume is slow.
+//
+// When the ring is full the message is dropped and counted; the background
+// thread emits a warning with the drop count once it catches up. Flush()
+// is also asynchronous: it requests a flush of the wrapped logger after
+// the ring has been drained and returns immediately.
+//
+// Tradeoffs: log lines are timestamped by the wrapped logger when they are
+// written, so under a backlog the recorded time (and thread id, for
+// loggers that print one) is that of the drain, not of the caller.
+class AsyncLogger : public Logger {
+ public:
+  explicit AsyncLogger(const std::shared_ptr<Logger>& target);
+
+  ~AsyncLogger() override;
+
+  using Logger::Logv;
+  void Logv(const char* format, va_list ap) override;
+
+  // Headers are rare (DB open and log roll) and must be retained by the
+  // wrapped logger, so they are forwarded synchronously.
+  void LogHeader(const char* format, va_list ap) override;
+
+  // Requests a flush of the wrapped logger once the ring is drained and
+  // returns without waiting for it.
+  void Flush() override;
+
+  size_t GetLogFileSize() const override { return target_->GetLogFileSize(); }
+
+  using Logger::GetInfoLogLevel;
+  InfoLogLevel GetInfoLogLevel() const override {
+    return target_->GetInfoLogLevel();
+  }
+
+  using Logger::SetInfoLogLevel;
+  void SetInfoLogLevel(const InfoLogLevel log_level) override {
+    Logger::SetInfoLogLevel(log_level);
+    target_->SetInfoLogLevel(log_level);
+  }
+
+  // Number of messages dropped because the ring was full and not yet
+  // reported to the wrapped logger.
+  uint64_t TEST_pending_dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  Logger* TEST_target_logger() const { return target_.get(); }
+
+  // Block until everything logged so far has reached the wrapped logger.
+  // Only meant for tests; production callers rely on Close()/destruction.
+  void TEST_WaitForDrain();
+
+ protected:
+  // Implementation of Close(). Drains the ring, stops the background
+  // thread and closes the wrapped logger.
+  Status CloseImpl() override;
+
+ private:
+  // Number of message slots. Must be a power of two.
+  static const size_t kRingSize = 1024;
+  // Messages longer than this are truncated, matching the limit the
+  // AutoRollLogger applies to retained headers.
+  static const size_t kMaxMessageSize = 1024;
+
+  // One slot of the ring. `seq` implements the classic bounded MPMC
+  // queue protocol: a slot is free for the producer of position `pos`
+  // when seq == pos, and ready for the consumer when seq == pos + 1.
+  struct Slot {
+    std::atomic<uint64_t> seq;
+    char msg[kMaxMessageSize];
+  };
+
+  // Formats the message into a free slot. Returns false (and counts the
+  // drop) if the ring is full. Lock-free; called by any thread.
+  bool Enqueue(const char* format, va_list ap);
+
+  // Writes all currently ready slots to the wrapped logger. Returns true
+  // if at least one message was written. Called only by bg_thread_.
+  bool DrainOnce();
+
+  void BackgroundThread();
+
+  std::shared_ptr<Logger> target_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> enqueue_pos_;
+  std::atomic<uint64_t> dequeue_pos_;
+  // Messages dropped since the last drop report.
+  std::atomic<uint64_t> dropped_;
+  std::atomic<bool> flush_pending_;
+  std::atomic<bool> shutting_down_;
+  // Only coordinates the background thread's idle wait and shutdown; the
+  // logging fast path never touches it.
+  port::Mutex mutex_;
+  port::CondVar bg_cv_;
+  port::Thread bg_thread_;
+};
+#endif  // !ROCKSDB_LITE
+
+}  // namespace ROCKSDB_NAMESPACE
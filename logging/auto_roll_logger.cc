@@ -8,6 +8,7 @@
 #include <algorithm>
 
 #include "file/filename.h"
+#include "logging/async_logger.h"
 #include "logging/logging.h"
 #include "rocksdb/env.h"
 #include "rocksdb/file_system.h"
@@ -312,6 +313,9 @@ Status CreateLoggerFromOptions(const std::string& dbname,
       delete result;
     } else {
       logger->reset(result);
+      if (options.async_info_log) {
+        *logger = std::make_shared<AsyncLogger>(*logger);
+      }
     }
     return s;
   }
@@ -353,6 +357,11 @@ Status CreateLoggerFromOptions(const std::string& dbname,
   }
   if (s.ok() && logger->get() != nullptr) {
     (*logger)->SetInfoLogLevel(options.info_log_level);
+#ifndef ROCKSDB_LITE
+    if (options.async_info_log) {
+      *logger = std::make_shared<AsyncLogger>(*logger);
+    }
+#endif  // !ROCKSDB_LITE
   }
   return s;
 }
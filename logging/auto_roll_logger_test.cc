@@ -10,6 +10,8 @@
 
 #include <sys/stat.h>
 
+#include <atomic>
+
 #include <algorithm>
 #include <cmath>
 #include <fstream>
@@ -21,6 +23,7 @@
 
 #include "db/db_test_util.h"
 #include "env/emulated_clock.h"
+#include "logging/async_logger.h"
 #include "logging/env_logger.h"
 #include "logging/logging.h"
 #include "port/port.h"
@@ -730,6 +733,118 @@ TEST_F(AutoRollLoggerTest, RenameError) {
   }
 }
 
+namespace {
+// A Logger that records every line it receives and can be made to block,
+// emulating a slow log volume.
+class RecordingLogger : public Logger {
+ public:
+  using Logger::Logv;
+  void Logv(const char* format, va_list ap) override {
+    char buffer[1024];
+    vsnprintf(buffer, sizeof(buffer), format, ap);
+    {
+      MutexLock l(&mutex_);
+      lines_.emplace_back(buffer);
+    }
+    // Block after recording so tests can tell the line has been picked up.
+    while (blocked_.load()) {
+      SystemClock::Default()->SleepForMicroseconds(100);
+    }
+  }
+
+  size_t GetLogFileSize() const override { return 0; }
+
+  void SetBlocked(bool blocked) { blocked_.store(blocked); }
+
+  std::vector<std::string> Lines() {
+    MutexLock l(&mutex_);
+    return lines_;
+  }
+
+ protected:
+  Status CloseImpl() override { return Status::OK(); }
+
+ private:
+  std::atomic<bool> blocked_{false};
+  port::Mutex mutex_;
+  std::vector<std::string> lines_;
+};
+}  // namespace
+
+TEST_F(AutoRollLoggerTest, AsyncLoggerDeliversInOrder) {
+  auto target = std::make_shared<RecordingLogger>();
+  auto async_logger = std::make_shared<AsyncLogger>(target);
+  const int kNumMessages = 100;
+  for (int i = 0; i < kNumMessages; ++i) {
+    ROCKS_LOG_INFO(async_logger.get(), "message %d", i);
+  }
+  async_logger->TEST_WaitForDrain();
+  std::vector<std::string> lines = target->Lines();
+  ASSERT_EQ(kNumMessages, static_cast<int>(lines.size()));
+  for (int i = 0; i < kNumMessages; ++i) {
+    ASSERT_EQ("message " + std::to_string(i), lines[i]);
+  }
+  ASSERT_OK(async_logger->Close());
+}
+
+TEST_F(AutoRollLoggerTest, AsyncLoggerDropsUnderOverload) {
+  auto target = std::make_shared<RecordingLogger>();
+  auto async_logger = std::make_shared<AsyncLogger>(target);
+  target->SetBlocked(true);
+  // Wait for the background thread to get stuck writing the first
+  // message, then overrun the ring. The ring holds 1024 messages, so a
+  // good portion of these must be dropped.
+  ROCKS_LOG_INFO(async_logger.get(), "plug");
+  while (target->Lines().empty()) {
+    SystemClock::Default()->SleepForMicroseconds(100);
+  }
+  const int kNumMessages = 4096;
+  for (int i = 0; i < kNumMessages; ++i) {
+    ROCKS_LOG_INFO(async_logger.get(), "message %d", i);
+  }
+  ASSERT_GT(async_logger->TEST_pending_dropped(), 0);
+  target->SetBlocked(false);
+  async_logger->TEST_WaitForDrain();
+  // Everything that was not dropped arrives, plus a warning carrying the
+  // drop count.
+  std::vector<std::string> lines = target->Lines();
+  ASSERT_LT(lines.size(), static_cast<size_t>(kNumMessages) + 1);
+  bool found_drop_report = false;
+  for (const std::string& line : lines) {
+    if (line.find("info log entries dropped") != std::string::npos) {
+      found_drop_report = true;
+    }
+  }
+  ASSERT_TRUE(found_drop_report);
+  ASSERT_OK(async_logger->Close());
+}
+
+TEST_F(AutoRollLoggerTest, AsyncLoggerFromOptions) {
+  InitTestDb();
+  DBOptions options;
+  options.async_info_log = true;
+
+  // Without rolling the async logger wraps a plain logger.
+  std::shared_ptr<Logger> logger;
+  ASSERT_OK(CreateLoggerFromOptions(kTestDir, options, &logger));
+  AsyncLogger* async_logger = dynamic_cast<AsyncLogger*>(logger.get());
+  ASSERT_TRUE(async_logger);
+  ASSERT_TRUE(dynamic_cast<EnvLogger*>(async_logger->TEST_target_logger()));
+
+  // With rolling enabled it wraps the auto roll logger.
+  InitTestDb();
+  options.max_log_file_size = 1024;
+  ASSERT_OK(CreateLoggerFromOptions(kTestDir, options, &logger));
+  async_logger = dynamic_cast<AsyncLogger*>(logger.get());
+  ASSERT_TRUE(async_logger);
+  ASSERT_TRUE(
+      dynamic_cast<AutoRollLogger*>(async_logger->TEST_target_logger()));
+  LogMessage(logger.get(), "async message");
+  async_logger->TEST_WaitForDrain();
+  logger->Flush();
+  async_logger->TEST_WaitForDrain();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
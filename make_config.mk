@@ -0,0 +1,31 @@
+CC=cc
+CXX=g++
+AR=gcc-ar
+PLATFORM=OS_LINUX
+PLATFORM_LDFLAGS= -lpthread -lrt -ldl -lz -lbz2 -lnuma -ltbb -lbenchmark
+PLATFORM_CMAKE_FLAGS=
+JAVA_LDFLAGS= -lpthread -lrt -ldl -lz -lbz2 -lnuma -ltbb
+JAVA_STATIC_LDFLAGS= -lpthread -lrt -ldl
+JAVA_STATIC_DEPS_CCFLAGS=
+JAVA_STATIC_DEPS_CXXFLAGS=
+JAVA_STATIC_DEPS_LDFLAGS=
+JAVAC_ARGS=-source 8
+VALGRIND_VER=
+PLATFORM_CCFLAGS= -DROCKSDB_PLATFORM_POSIX -DROCKSDB_LIB_IO_POSIX  -DOS_LINUX -fno-builtin-memcmp -DROCKSDB_FALLOCATE_PRESENT -DZLIB -DBZIP2 -DNUMA -DTBB -DROCKSDB_MALLOC_USABLE_SIZE -DROCKSDB_PTHREAD_ADAPTIVE_MUTEX -DROCKSDB_BACKTRACE -DROCKSDB_RANGESYNC_PRESENT -DROCKSDB_SCHED_GETCPU_PRESENT -DROCKSDB_AUXV_GETAUXVAL_PRESENT -march=native   -DHAVE_SSE42  -DHAVE_PCLMUL  -DHAVE_AVX2  -DHAVE_BMI  -DHAVE_LZCNT -DHAVE_UINT128_EXTENSION
+PLATFORM_CXXFLAGS=-std=c++17  -faligned-new -DHAVE_ALIGNED_NEW -DROCKSDB_PLATFORM_POSIX -DROCKSDB_LIB_IO_POSIX  -DOS_LINUX -fno-builtin-memcmp -DROCKSDB_FALLOCATE_PRESENT -DZLIB -DBZIP2 -DNUMA -DTBB -DROCKSDB_MALLOC_USABLE_SIZE -DROCKSDB_PTHREAD_ADAPTIVE_MUTEX -DROCKSDB_BACKTRACE -DROCKSDB_RANGESYNC_PRESENT -DROCKSDB_SCHED_GETCPU_PRESENT -DROCKSDB_AUXV_GETAUXVAL_PRESENT -march=native   -DHAVE_SSE42  -DHAVE_PCLMUL  -DHAVE_AVX2  -DHAVE_BMI  -DHAVE_LZCNT -DHAVE_UINT128_EXTENSION
+PLATFORM_SHARED_CFLAGS=-fPIC
+PLATFORM_SHARED_EXT=so
+PLATFORM_SHARED_LDFLAGS=-Wl,--no-as-needed -shared -Wl,-soname -Wl,
+PLATFORM_SHARED_VERSIONED=true
+EXEC_LDFLAGS=-ldl
+JEMALLOC_INCLUDE=
+JEMALLOC_LIB=
+ROCKSDB_MAJOR=7
+ROCKSDB_MINOR=6
+ROCKSDB_PATCH=0
+CLANG_SCAN_BUILD=scan-build
+CLANG_ANALYZER=
+PROFILING_FLAGS=-pg
+FIND=find
+WATCH=watch
+LUA_PATH=
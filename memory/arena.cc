@@ -31,6 +31,85 @@ const size_t Arena::kMinBlockSize = 4096;
 const size_t Arena::kMaxBlockSize = 2u << 30;
 static const int kAlignUnit = alignof(max_align_t);
 
+ArenaBlockPool::ArenaBlockPool(size_t max_pool_bytes)
+    : max_pool_bytes_(max_pool_bytes) {}
+
+ArenaBlockPool::~ArenaBlockPool() {
+  for (auto& sized : blocks_) {
+    for (char* block : sized.second) {
+      delete[] block;
+    }
+  }
+#ifdef MAP_HUGETLB
+  for (auto& sized : huge_pages_) {
+    for (void* addr : sized.second) {
+      auto ret = munmap(addr, sized.first);
+      if (ret != 0) {
+        // TODO(sdong): Better handling
+      }
+    }
+  }
+#endif  // MAP_HUGETLB
+}
+
+ArenaBlockPool* ArenaBlockPool::Default() {
+  static ArenaBlockPool pool;
+  return &pool;
+}
+
+char* ArenaBlockPool::TakeBlock(size_t block_bytes) {
+  MutexLock l(&mutex_);
+  auto it = blocks_.find(block_bytes);
+  if (it == blocks_.end() || it->second.empty()) {
+    return nullptr;
+  }
+  char* block = it->second.back();
+  it->second.pop_back();
+  pooled_bytes_ -= block_bytes;
+  return block;
+}
+
+void ArenaBlockPool::ReturnBlock(char* block, size_t block_bytes) {
+  {
+    MutexLock l(&mutex_);
+    if (pooled_bytes_ + block_bytes <= max_pool_bytes_) {
+      blocks_[block_bytes].push_back(block);
+      pooled_bytes_ += block_bytes;
+      return;
+    }
+  }
+  delete[] block;
+}
+
+#ifdef MAP_HUGETLB
+void* ArenaBlockPool::TakeHugePage(size_t length) {
+  MutexLock l(&mutex_);
+  auto it = huge_pages_.find(length);
+  if (it == huge_pages_.end() || it->second.empty()) {
+    return nullptr;
+  }
+  void* addr = it->second.back();
+  it->second.pop_back();
+  pooled_bytes_ -= length;
+  return addr;
+}
+
+void ArenaBlockPool::ReturnHugePage(void* addr, size_t length) {
+  {
+    MutexLock l(&mutex_);
+    if (pooled_bytes_ + length <= max_pool_bytes_) {
+      huge_pages_[length].push_back(addr);
+      pooled_bytes_ += length;
+      return;
+    }
+  }
+  auto ret = munmap(addr, length);
+  if (ret != 0) {
+    // TODO(sdong): Better handling
+  }
+}
+#endif  // MAP_HUGETLB
+
 size_t OptimizeBlockSize(size_t block_size) {
   // Make sure block_size is in optimal range
   block_size = std::max(Arena::kMinBlockSize, block_size);
@@ -44,8 +123,11 @@ size_t OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)), tracker_(tracker) {
+Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+             ArenaBlockPool* block_pool)
+    : kBlockSize(OptimizeBlockSize(block_size)),
+      tracker_(tracker),
+      block_pool_(block_pool) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   TEST_SYNC_POINT_CALLBACK("Arena::Arena:0", const_cast<size_t*>(&kBlockSize));
@@ -74,12 +156,23 @@ Arena::~Arena() {
   for (const auto& block : blocks_) {
     delete[] block;
   }
+  for (const auto& block : recyclable_blocks_) {
+    if (block_pool_ != nullptr) {
+      block_pool_->ReturnBlock(block, kBlockSize);
+    } else {
+      delete[] block;
+    }
+  }
 
 #ifdef MAP_HUGETLB
   for (const auto& mmap_info : huge_blocks_) {
     if (mmap_info.addr_ == nullptr) {
       continue;
     }
+    if (block_pool_ != nullptr) {
+      block_pool_->ReturnHugePage(mmap_info.addr_, mmap_info.length_);
+      continue;
+    }
     auto ret = munmap(mmap_info.addr_, mmap_info.length_);
     if (ret != 0) {
       // TODO(sdong): Better handling
@@ -137,11 +230,17 @@ char* Arena::AllocateFromHugePage(size_t bytes) {
   //   via RAII.
   huge_blocks_.emplace_back(nullptr /* addr */, 0 /* length */);
 
-  void* addr = mmap(nullptr, bytes, (PROT_READ | PROT_WRITE),
-                    (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
+  // A retired mapping of the right size can be reused intact, keeping its
+  // hugepage reservation and already-faulted pages.
+  void* addr = block_pool_ != nullptr ? block_pool_->TakeHugePage(bytes)
+                                      : nullptr;
+  if (addr == nullptr) {
+    addr = mmap(nullptr, bytes, (PROT_READ | PROT_WRITE),
+                (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
 
-  if (addr == MAP_FAILED) {
-    return nullptr;
+    if (addr == MAP_FAILED) {
+      return nullptr;
+    }
   }
   huge_blocks_.back() = MmapInfo(addr, bytes);
   blocks_memory_ += bytes;
@@ -200,7 +299,12 @@ char* Arena::AllocateAligned(size_t bytes, size_t huge_page_size,
 }
 
 char* Arena::AllocateNewBlock(size_t block_bytes) {
-  // Reserve space in `blocks_` before allocating memory via new.
+  // Only regularly-sized blocks go through the pool: they are the ones that
+  // other arenas of the same block size can reuse.
+  const bool recyclable = block_pool_ != nullptr && block_bytes == kBlockSize;
+  Blocks& block_list = recyclable ? recyclable_blocks_ : blocks_;
+
+  // Reserve space in the block list before allocating memory via new.
   // Use `emplace_back()` instead of `reserve()` to let std::vector manage its
   // own memory and do fewer reallocations.
   //
@@ -208,9 +312,12 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   //   yet.
   // - If `new` throws, no memory leaks because the vector will be cleaned up
   //   via RAII.
-  blocks_.emplace_back(nullptr);
+  block_list.emplace_back(nullptr);
 
-  char* block = new char[block_bytes];
+  char* block = recyclable ? block_pool_->TakeBlock(block_bytes) : nullptr;
+  if (block == nullptr) {
+    block = new char[block_bytes];
+  }
   size_t allocated_size;
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
   allocated_size = malloc_usable_size(block);
@@ -227,7 +334,7 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   if (tracker_ != nullptr) {
     tracker_->Allocate(allocated_size);
   }
-  blocks_.back() = block;
+  block_list.back() = block;
   return block;
 }
 
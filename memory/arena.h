@@ -19,12 +19,67 @@
 #include <stdint.h>
 #include <cerrno>
 #include <cstddef>
+#include <unordered_map>
 #include <vector>
 #include "memory/allocator.h"
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+// A process-wide freelist of retired arena blocks. When an arena is
+// destroyed (e.g. a memtable is flushed), its regularly-sized blocks are
+// returned here instead of being freed, and new arenas draw from the pool
+// before going to the allocator. Reusing blocks intact avoids the page
+// zeroing and TLB shootdowns of releasing and re-faulting gigabytes of
+// memtable memory per minute, and keeps hugepage-backed blocks mapped so
+// their reservation is never re-negotiated with the kernel. The pool caps
+// the bytes it retains; blocks beyond the cap are freed as before.
+class ArenaBlockPool {
+ public:
+  // No copying allowed
+  ArenaBlockPool(const ArenaBlockPool&) = delete;
+  void operator=(const ArenaBlockPool&) = delete;
+
+  static const size_t kDefaultMaxPoolBytes = 64 << 20;
+
+  explicit ArenaBlockPool(size_t max_pool_bytes = kDefaultMaxPoolBytes);
+  ~ArenaBlockPool();
+
+  // The pool shared by all arenas that are not given their own.
+  static ArenaBlockPool* Default();
+
+  // Returns a previously retired new[]-allocated block of exactly
+  // `block_bytes` bytes, or nullptr if none is pooled.
+  char* TakeBlock(size_t block_bytes);
+
+  // Retires a new[]-allocated block of `block_bytes` bytes. Frees it
+  // immediately if the pool is at capacity.
+  void ReturnBlock(char* block, size_t block_bytes);
+
+#ifdef MAP_HUGETLB
+  // Same as the above, for MAP_HUGETLB mappings of exactly `length` bytes.
+  void* TakeHugePage(size_t length);
+  void ReturnHugePage(void* addr, size_t length);
+#endif  // MAP_HUGETLB
+
+  // Total bytes currently retained by the pool.
+  size_t PooledBytes() const {
+    MutexLock l(&mutex_);
+    return pooled_bytes_;
+  }
+
+ private:
+  mutable port::Mutex mutex_;
+  const size_t max_pool_bytes_;
+  size_t pooled_bytes_ = 0;
+  // Freelists keyed by block size; arenas of a given block size only ever
+  // retire blocks of that size, so each map stays small.
+  std::unordered_map<size_t, std::vector<char*>> blocks_;
+#ifdef MAP_HUGETLB
+  std::unordered_map<size_t, std::vector<void*>> huge_pages_;
+#endif  // MAP_HUGETLB
+};
+
 class Arena : public Allocator {
  public:
   // No copying allowed
@@ -38,8 +93,11 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
+  // block_pool: regularly-sized blocks are drawn from and retired to this
+  // pool; defaults to the process-wide pool.
   explicit Arena(size_t block_size = kMinBlockSize,
-                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0);
+                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0,
+                 ArenaBlockPool* block_pool = ArenaBlockPool::Default());
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -63,7 +121,9 @@ class Arena : public Allocator {
   // by the arena (exclude the space allocated but not yet used for future
   // allocations).
   size_t ApproximateMemoryUsage() const {
-    return blocks_memory_ + blocks_.capacity() * sizeof(char*) -
+    return blocks_memory_ +
+           (blocks_.capacity() + recyclable_blocks_.capacity()) *
+               sizeof(char*) -
            alloc_bytes_remaining_;
   }
 
@@ -78,7 +138,8 @@ class Arena : public Allocator {
   size_t BlockSize() const override { return kBlockSize; }
 
   bool IsInInlineBlock() const {
-    return blocks_.empty() && huge_blocks_.empty();
+    return blocks_.empty() && recyclable_blocks_.empty() &&
+           huge_blocks_.empty();
   }
 
  private:
@@ -88,6 +149,9 @@ class Arena : public Allocator {
   // Array of new[] allocated memory blocks
   using Blocks = std::vector<char*>;
   Blocks blocks_;
+  // Blocks of exactly kBlockSize bytes, retired to block_pool_ rather than
+  // freed when the arena is destroyed. Irregular blocks stay in blocks_.
+  Blocks recyclable_blocks_;
 
   struct MmapInfo {
     void* addr_;
@@ -118,6 +182,7 @@ class Arena : public Allocator {
   // Bytes of memory in blocks allocated so far
   size_t blocks_memory_ = 0;
   AllocTracker* tracker_;
+  ArenaBlockPool* block_pool_;
 };
 
 inline char* Arena::Allocate(size_t bytes) {
@@ -196,6 +196,46 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(0);
   SimpleTest(kHugePageSize);
 }
+
+TEST_F(ArenaTest, BlockPoolRecycling) {
+  ArenaBlockPool pool;
+  const size_t bsz = 32 * 1024;
+  {
+    Arena arena(bsz, nullptr, 0, &pool);
+    arena.Allocate(4 * 1024);  // forces one regular block
+    ASSERT_EQ(0U, pool.PooledBytes());
+  }
+  // The retired block is pooled, not freed.
+  ASSERT_EQ(bsz, pool.PooledBytes());
+  {
+    // A new arena with the same block size draws from the pool.
+    Arena arena(bsz, nullptr, 0, &pool);
+    arena.Allocate(4 * 1024);
+    ASSERT_EQ(0U, pool.PooledBytes());
+  }
+  ASSERT_EQ(bsz, pool.PooledBytes());
+  {
+    // A different block size does not match the pooled block.
+    Arena arena(bsz / 2, nullptr, 0, &pool);
+    arena.Allocate(3 * 1024);
+    ASSERT_EQ(bsz, pool.PooledBytes());
+  }
+  ASSERT_EQ(bsz + bsz / 2, pool.PooledBytes());
+}
+
+TEST_F(ArenaTest, BlockPoolCap) {
+  const size_t bsz = 32 * 1024;
+  ArenaBlockPool pool(bsz /* max_pool_bytes */);
+  {
+    Arena arena1(bsz, nullptr, 0, &pool);
+    arena1.Allocate(4 * 1024);
+    Arena arena2(bsz, nullptr, 0, &pool);
+    arena2.Allocate(4 * 1024);
+  }
+  // Only one of the two retired blocks fits under the cap; the other was
+  // freed immediately.
+  ASSERT_EQ(bsz, pool.PooledBytes());
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -8,6 +8,11 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include "memory/concurrent_arena.h"
+
+#ifdef NUMA
+#include <numa.h>
+#endif
+
 #include <thread>
 #include "port/port.h"
 #include "util/random.h"
@@ -29,9 +34,60 @@ ConcurrentArena::ConcurrentArena(size_t block_size, AllocTracker* tracker,
     : shard_block_size_(std::min(kMaxShardBlockSize, block_size / 8)),
       shards_(),
       arena_(block_size, tracker, huge_page_size) {
+#ifdef NUMA
+  if (numa_available() >= 0) {
+    int nodes = numa_num_configured_nodes();
+    if (nodes > 1) {
+      node_caches_.resize(static_cast<size_t>(nodes));
+    }
+  }
+#endif  // NUMA
   Fixup();
 }
 
+#ifdef NUMA
+char* ConcurrentArena::AllocateShardBlockOnNode(size_t bytes, size_t cpu_idx) {
+  if (node_caches_.empty()) {
+    // Single-node system or NUMA unavailable.
+    return nullptr;
+  }
+  int node = numa_node_of_cpu(static_cast<int>(cpu_idx));
+  if (node < 0 || static_cast<size_t>(node) >= node_caches_.size()) {
+    return nullptr;
+  }
+  NodeCache& cache = node_caches_[static_cast<size_t>(node)];
+  if (cache.avail_ < bytes) {
+    // Refill with a multi-shard-block chunk so the mbind() syscall is
+    // amortized over several reloads. The leftover of the previous chunk is
+    // abandoned; it stays owned (and eventually freed) by arena_ and only
+    // slightly overstates ApproximateMemoryUsage().
+    size_t chunk = std::max(bytes, 4 * shard_block_size_);
+    char* mem = arena_.AllocateAligned(chunk);
+    if (mem == nullptr) {
+      return nullptr;
+    }
+    // mbind() works on whole pages; bind the pages fully inside the chunk
+    // and leave the edge pages (shared with neighboring allocations) on
+    // their first-touch node.
+    const size_t page = static_cast<size_t>(port::kPageSize);
+    char* bind_begin = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(mem) + page - 1) & ~(page - 1));
+    char* bind_end = reinterpret_cast<char*>(
+        reinterpret_cast<uintptr_t>(mem + chunk) & ~(page - 1));
+    if (bind_end > bind_begin) {
+      numa_tonode_memory(bind_begin, static_cast<size_t>(bind_end - bind_begin),
+                         node);
+    }
+    cache.free_begin_ = mem;
+    cache.avail_ = chunk;
+  }
+  char* rv = cache.free_begin_;
+  cache.free_begin_ += bytes;
+  cache.avail_ -= bytes;
+  return rv;
+}
+#endif  // NUMA
+
 ConcurrentArena::Shard* ConcurrentArena::Repick() {
   auto shard_and_index = shards_.AccessElementAndIndex();
   // even if we are cpu 0, use a non-zero tls_cpuid so we can tell we
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "memory/allocator.h"
 #include "memory/arena.h"
 #include "port/lang.h"
@@ -107,6 +108,17 @@ class ConcurrentArena : public Allocator {
 
   Arena arena_;
   mutable SpinMutex arena_mutex_;
+#ifdef NUMA
+  // One carve buffer per NUMA node, so that shard blocks handed to cores on
+  // a node come from pages bound to that node instead of wherever the
+  // arena's current block happens to live. Non-empty only on multi-node
+  // systems. Guarded by arena_mutex_.
+  struct NodeCache {
+    char* free_begin_ = nullptr;
+    size_t avail_ = 0;
+  };
+  std::vector<NodeCache> node_caches_;
+#endif  // NUMA
   std::atomic<size_t> arena_allocated_and_unused_;
   std::atomic<size_t> memory_allocated_bytes_;
   std::atomic<size_t> irregular_block_num_;
@@ -115,6 +127,15 @@ class ConcurrentArena : public Allocator {
 
   Shard* Repick();
 
+#ifdef NUMA
+  // Carves a shard block of `bytes` from the cache of the NUMA node that
+  // cpu_idx belongs to, refilling the cache from arena_ (and binding the
+  // fresh pages to the node) as needed. Returns nullptr if node-aware
+  // placement is unavailable; the caller then falls back to the plain
+  // arena path. REQUIRES: arena_mutex_ held.
+  char* AllocateShardBlockOnNode(size_t bytes, size_t cpu_idx);
+#endif  // NUMA
+
   size_t ShardAllocatedAndUnused() const {
     size_t total = 0;
     for (size_t i = 0; i < shards_.Size(); ++i) {
@@ -181,7 +202,15 @@ class ConcurrentArena : public Allocator {
       avail = exact >= shard_block_size_ / 2 && exact < shard_block_size_ * 2
                   ? exact
                   : shard_block_size_;
+#ifdef NUMA
+      s->free_begin_ =
+          AllocateShardBlockOnNode(avail, cpu & (shards_.Size() - 1));
+      if (s->free_begin_ == nullptr) {
+        s->free_begin_ = arena_.AllocateAligned(avail);
+      }
+#else
       s->free_begin_ = arena_.AllocateAligned(avail);
+#endif  // NUMA
       Fixup();
     }
     s->allocated_and_unused_.store(avail - bytes, std::memory_order_relaxed);
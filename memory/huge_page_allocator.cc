@@ -0,0 +1,164 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memory/huge_page_allocator.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "rocksdb/utilities/options_type.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+static std::unordered_map<std::string, OptionTypeInfo> huge_page_type_info = {
+#ifndef ROCKSDB_LITE
+    {"huge_page_threshold",
+     {offsetof(struct HugePageAllocatorOptions, huge_page_threshold),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+    {"huge_page_size",
+     {offsetof(struct HugePageAllocatorOptions, huge_page_size),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+    {"max_consecutive_failures",
+     {offsetof(struct HugePageAllocatorOptions, max_consecutive_failures),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+#endif  // ROCKSDB_LITE
+};
+
+HugePageAllocator::HugePageAllocator(const HugePageAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &huge_page_type_info);
+}
+
+HugePageAllocator::~HugePageAllocator() {
+#ifdef ROCKSDB_MADV_HUGEPAGE_PRESENT
+  // All allocations should have been returned by now; unmap any stragglers
+  // so the allocator does not leak address space.
+  assert(mapped_regions_.empty());
+  for (const auto& region : mapped_regions_) {
+    munmap(region.first, region.second);
+  }
+#endif  // ROCKSDB_MADV_HUGEPAGE_PRESENT
+}
+
+bool HugePageAllocator::IsSupported(std::string* msg) {
+#ifdef ROCKSDB_MADV_HUGEPAGE_PRESENT
+  (void)msg;
+  return true;
+#else
+  *msg = "Transparent huge pages require Linux with MADV_HUGEPAGE";
+  return false;
+#endif  // ROCKSDB_MADV_HUGEPAGE_PRESENT
+}
+
+Status HugePageAllocator::PrepareOptions(const ConfigOptions& options) {
+  std::string msg;
+  if (!IsSupported(&msg)) {
+    return Status::NotSupported(msg);
+  } else if (options_.huge_page_size == 0 ||
+             (options_.huge_page_size & (options_.huge_page_size - 1)) != 0) {
+    return Status::InvalidArgument("huge_page_size must be a power of two");
+  } else {
+    return MemoryAllocator::PrepareOptions(options);
+  }
+}
+
+#ifdef ROCKSDB_MADV_HUGEPAGE_PRESENT
+void* HugePageAllocator::AllocateHugePageRegion(size_t size) {
+  const size_t huge_page_size = options_.huge_page_size;
+  // Round the region up to whole huge pages so that, once aligned, it can
+  // be fully assembled from huge pages by the kernel.
+  const size_t len =
+      (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+  // Over-map by one huge page so the start can be aligned, then trim the
+  // unaligned head and tail. mmap only guarantees regular page alignment.
+  const size_t map_len = len + huge_page_size;
+  void* const raw = mmap(nullptr, map_len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const uintptr_t raw_addr = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t start =
+      (raw_addr + huge_page_size - 1) & ~(huge_page_size - 1);
+  if (start != raw_addr) {
+    munmap(raw, start - raw_addr);
+  }
+  const uintptr_t map_end = raw_addr + map_len;
+  if (map_end != start + len) {
+    munmap(reinterpret_cast<void*>(start + len), map_end - (start + len));
+  }
+  void* const region = reinterpret_cast<void*>(start);
+  if (madvise(region, len, MADV_HUGEPAGE) != 0) {
+    // Kernel built without transparent huge page support; the mapping is
+    // still usable but brings no TLB benefit, so count it as a failure.
+    munmap(region, len);
+    return nullptr;
+  }
+  MutexLock l(&mutex_);
+  mapped_regions_.emplace(region, len);
+  return region;
+}
+
+void* HugePageAllocator::Allocate(size_t size) {
+  if (size >= options_.huge_page_threshold &&
+      consecutive_failures_.load(std::memory_order_relaxed) <
+          options_.max_consecutive_failures) {
+    void* region = AllocateHugePageRegion(size);
+    if (region != nullptr) {
+      consecutive_failures_.store(0, std::memory_order_relaxed);
+      return region;
+    }
+    consecutive_failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return static_cast<void*>(new char[size]);
+}
+
+void HugePageAllocator::Deallocate(void* p) {
+  size_t len = 0;
+  {
+    MutexLock l(&mutex_);
+    auto it = mapped_regions_.find(p);
+    if (it != mapped_regions_.end()) {
+      len = it->second;
+      mapped_regions_.erase(it);
+    }
+  }
+  if (len > 0) {
+    munmap(p, len);
+  } else {
+    delete[] static_cast<char*>(p);
+  }
+}
+
+size_t HugePageAllocator::UsableSize(void* p, size_t allocation_size) const {
+  MutexLock l(&mutex_);
+  auto it = mapped_regions_.find(p);
+  return it != mapped_regions_.end() ? it->second : allocation_size;
+}
+#endif  // ROCKSDB_MADV_HUGEPAGE_PRESENT
+
+Status NewHugePageAllocator(
+    const HugePageAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator) {
+  if (memory_allocator == nullptr) {
+    return Status::InvalidArgument("memory_allocator must be non-null.");
+  }
+  std::string msg;
+  if (!HugePageAllocator::IsSupported(&msg)) {
+    return Status::NotSupported(msg);
+  }
+  if (options.huge_page_size == 0 ||
+      (options.huge_page_size & (options.huge_page_size - 1)) != 0) {
+    return Status::InvalidArgument("huge_page_size must be a power of two");
+  }
+  memory_allocator->reset(new HugePageAllocator(options));
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,75 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <unordered_map>
+
+#ifdef OS_LINUX
+#include <sys/mman.h>
+#ifdef MADV_HUGEPAGE
+#define ROCKSDB_MADV_HUGEPAGE_PRESENT
+#endif
+#endif
+
+#include "port/port.h"
+#include "rocksdb/memory_allocator.h"
+#include "utilities/memory_allocators.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A memory allocator that backs large allocations with anonymous mmap
+// regions advised with MADV_HUGEPAGE, so the kernel can serve them with
+// transparent huge pages. Large block cache entries (uncompressed index,
+// filter and data blocks) dominate the dTLB footprint of big caches;
+// mapping them on 2MB pages cuts the TLB miss rate without requiring a
+// hugetlbfs reservation the way Arena's explicit hugetlb support does.
+//
+// Allocations below huge_page_threshold, and all allocations once huge
+// page setup has failed max_consecutive_failures times in a row (e.g.
+// because physical memory is too fragmented for the kernel to assemble
+// huge pages), fall back to new/delete.
+class HugePageAllocator : public BaseMemoryAllocator {
+ public:
+  explicit HugePageAllocator(
+      const HugePageAllocatorOptions& options = HugePageAllocatorOptions());
+  ~HugePageAllocator() override;
+
+  static const char* kClassName() { return "HugePageAllocator"; }
+  const char* Name() const override { return kClassName(); }
+  static bool IsSupported() {
+    std::string unused;
+    return IsSupported(&unused);
+  }
+  static bool IsSupported(std::string* msg);
+  Status PrepareOptions(const ConfigOptions& options) override;
+
+#ifdef ROCKSDB_MADV_HUGEPAGE_PRESENT
+  void* Allocate(size_t size) override;
+  void Deallocate(void* p) override;
+  size_t UsableSize(void* p, size_t allocation_size) const override;
+#endif  // ROCKSDB_MADV_HUGEPAGE_PRESENT
+
+ private:
+#ifdef ROCKSDB_MADV_HUGEPAGE_PRESENT
+  // Returns a huge-page-aligned region of at least size bytes, or nullptr
+  // if the region could not be set up, in which case the caller falls
+  // back to the heap.
+  void* AllocateHugePageRegion(size_t size);
+#endif  // ROCKSDB_MADV_HUGEPAGE_PRESENT
+
+  HugePageAllocatorOptions options_;
+  // Tracks mapped length by region start, both to munmap on Deallocate
+  // and to tell mapped regions apart from heap fallback allocations.
+  // Huge page allocations are rare and large, so a mutex-guarded map is
+  // not a contention concern.
+  mutable port::Mutex mutex_;
+  std::unordered_map<void*, size_t> mapped_regions_;
+  // Consecutive failures to set up a huge page region; once it reaches
+  // options_.max_consecutive_failures, huge pages are not attempted again.
+  std::atomic<size_t> consecutive_failures_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include "rocksdb/memory_allocator.h"
 
+#include "memory/huge_page_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/utilities/customizable_util.h"
@@ -49,6 +50,15 @@ static int RegisterBuiltinAllocators(ObjectLibrary& library,
         }
         return guard->get();
       });
+  library.AddFactory<MemoryAllocator>(
+      HugePageAllocator::kClassName(),
+      [](const std::string& /*uri*/, std::unique_ptr<MemoryAllocator>* guard,
+         std::string* errmsg) {
+        if (HugePageAllocator::IsSupported(errmsg)) {
+          guard->reset(new HugePageAllocator());
+        }
+        return guard->get();
+      });
   library.AddFactory<MemoryAllocator>(
       MemkindKmemAllocator::kClassName(),
       [](const std::string& /*uri*/, std::unique_ptr<MemoryAllocator>* guard,
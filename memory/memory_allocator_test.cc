@@ -6,6 +6,7 @@
 
 #include <cstdio>
 
+#include "memory/huge_page_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/cache.h"
@@ -229,6 +230,43 @@ INSTANTIATE_TEST_CASE_P(
                                       JemallocNodumpAllocator::IsSupported())));
 #endif  // ROCKSDB_JEMALLOC
 
+INSTANTIATE_TEST_CASE_P(
+    HugePageAllocator, MemoryAllocatorTest,
+    ::testing::Values(std::make_tuple(HugePageAllocator::kClassName(),
+                                      HugePageAllocator::IsSupported())));
+
+TEST(HugePageAllocatorTest, LargeAndSmallAllocations) {
+  std::string msg;
+  if (!HugePageAllocator::IsSupported(&msg)) {
+    ROCKSDB_GTEST_BYPASS("Not supported");
+    return;
+  }
+  HugePageAllocatorOptions opts;
+  std::shared_ptr<MemoryAllocator> allocator;
+  ASSERT_OK(NewHugePageAllocator(opts, &allocator));
+
+  // A large allocation is huge-page-aligned, usable to its rounded
+  // length, and fully writable.
+  const size_t large = 3 * 1024 * 1024;
+  char* p = static_cast<char*>(allocator->Allocate(large));
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % opts.huge_page_size, 0u);
+  ASSERT_EQ(allocator->UsableSize(p, large), 4 * 1024 * 1024);
+  memset(p, 0xab, large);
+  allocator->Deallocate(p);
+
+  // A small allocation takes the heap path.
+  char* q = static_cast<char*>(allocator->Allocate(100));
+  ASSERT_NE(q, nullptr);
+  ASSERT_EQ(allocator->UsableSize(q, 100), 100u);
+  memset(q, 0xcd, 100);
+  allocator->Deallocate(q);
+
+  // An invalid huge page size is rejected.
+  opts.huge_page_size = 3000;
+  ASSERT_TRUE(NewHugePageAllocator(opts, &allocator).IsInvalidArgument());
+}
+
 #endif  // ROCKSDB_LITE
 
 }  // namespace ROCKSDB_NAMESPACE
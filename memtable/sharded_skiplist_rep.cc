@@ -0,0 +1,324 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+
+#ifndef ROCKSDB_LITE
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "memtable/inlineskiplist.h"
+#include "port/port.h"
+#include "rocksdb/memtablerep.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/slice_transform.h"
+#include "rocksdb/utilities/options_type.h"
+#include "util/hash.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+
+// A memtable rep that hash-partitions keys across a fixed array of
+// InlineSkipLists so that concurrent writers mostly touch disjoint lists
+// instead of contending on the CAS chains of a single one. Point operations
+// (Insert/Get/Contains) go straight to one shard; ordered iteration merges
+// the shards on the fly. When a prefix extractor is configured, keys are
+// placed by the hash of their prefix so that prefix scans also stay within
+// one shard.
+class ShardedSkipListRep : public MemTableRep {
+  using Shard = InlineSkipList<const MemTableRep::KeyComparator&>;
+
+ public:
+  ShardedSkipListRep(const MemTableRep::KeyComparator& compare,
+                     Allocator* allocator, const SliceTransform* transform,
+                     size_t num_shards)
+      : MemTableRep(allocator),
+        num_shards_(static_cast<size_t>(1)
+                    << FloorLog2(std::max(num_shards, size_t{1}))),
+        cmp_(compare),
+        transform_(transform) {
+    auto mem = allocator->AllocateAligned(sizeof(Shard*) * num_shards_);
+    shards_ = reinterpret_cast<Shard**>(mem);
+    for (size_t i = 0; i < num_shards_; ++i) {
+      auto addr = allocator->AllocateAligned(sizeof(Shard));
+      shards_[i] = new (addr) Shard(compare, allocator);
+    }
+  }
+
+  ~ShardedSkipListRep() override {}
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    // The node layout produced by AllocateKey() does not depend on which
+    // list performed the allocation, so the shard is picked later, once the
+    // key bytes are known.
+    *buf = shards_[0]->AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    auto* key = static_cast<char*>(handle);
+    GetShard(UserKey(key))->Insert(key);
+  }
+
+  bool InsertKey(KeyHandle handle) override {
+    auto* key = static_cast<char*>(handle);
+    return GetShard(UserKey(key))->Insert(key);
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    auto* key = static_cast<char*>(handle);
+    GetShard(UserKey(key))->InsertConcurrently(key);
+  }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    auto* key = static_cast<char*>(handle);
+    return GetShard(UserKey(key))->InsertConcurrently(key);
+  }
+
+  bool Contains(const char* key) const override {
+    return GetShard(UserKey(key))->Contains(key);
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    Shard::Iterator iter(GetShard(k.user_key()));
+    for (iter.Seek(k.memtable_key().data());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    std::string tmp1, tmp2;
+    const char* start_key = EncodeKey(&tmp1, start_ikey);
+    const char* end_key = EncodeKey(&tmp2, end_ikey);
+    uint64_t total = 0;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      uint64_t start_count = shards_[i]->EstimateCount(start_key);
+      uint64_t end_count = shards_[i]->EstimateCount(end_key);
+      total += (end_count >= start_count) ? (end_count - start_count) : 0;
+    }
+    return total;
+  }
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override;
+
+ private:
+  friend class MergingIterator;
+
+  const size_t num_shards_;  // power of two
+  Shard** shards_;
+  const MemTableRep::KeyComparator& cmp_;
+  // The user-supplied transform whose domain is the user keys.
+  const SliceTransform* transform_;
+
+  Shard* GetShard(const Slice& user_key) const {
+    Slice hashed = user_key;
+    if (transform_ != nullptr && transform_->InDomain(user_key)) {
+      hashed = transform_->Transform(user_key);
+    }
+    return shards_[GetSliceNPHash64(hashed) & (num_shards_ - 1)];
+  }
+
+  // Merges the per-shard lists with a linear scan over the (small, fixed)
+  // set of shard iterators. Matches the ordering a single InlineSkipList
+  // would produce.
+  class MergingIterator : public MemTableRep::Iterator {
+   public:
+    explicit MergingIterator(const ShardedSkipListRep& rep)
+        : rep_(rep), current_(kInvalid), direction_(kForward) {
+      iters_.reserve(rep_.num_shards_);
+      for (size_t i = 0; i < rep_.num_shards_; ++i) {
+        iters_.emplace_back(rep_.shards_[i]);
+      }
+    }
+
+    ~MergingIterator() override {}
+
+    bool Valid() const override { return current_ != kInvalid; }
+
+    const char* key() const override {
+      assert(Valid());
+      return iters_[current_].key();
+    }
+
+    void Next() override {
+      assert(Valid());
+      if (direction_ != kForward) {
+        // The non-current children sit at positions <= key(); move them past
+        // it before resuming forward merging. Keys are unique, so Seek()
+        // cannot land on key() itself for any other shard.
+        const char* encoded_key = key();
+        for (size_t i = 0; i < iters_.size(); ++i) {
+          if (i != current_) {
+            iters_[i].Seek(encoded_key);
+          }
+        }
+        direction_ = kForward;
+      }
+      iters_[current_].Next();
+      FindSmallest();
+    }
+
+    void Prev() override {
+      assert(Valid());
+      if (direction_ != kBackward) {
+        const char* encoded_key = key();
+        for (size_t i = 0; i < iters_.size(); ++i) {
+          if (i != current_) {
+            iters_[i].SeekForPrev(encoded_key);
+          }
+        }
+        direction_ = kBackward;
+      }
+      iters_[current_].Prev();
+      FindLargest();
+    }
+
+    void Seek(const Slice& internal_key, const char* memtable_key) override {
+      const char* encoded_key = (memtable_key != nullptr)
+                                    ? memtable_key
+                                    : EncodeKey(&tmp_, internal_key);
+      for (auto& iter : iters_) {
+        iter.Seek(encoded_key);
+      }
+      direction_ = kForward;
+      FindSmallest();
+    }
+
+    void SeekForPrev(const Slice& internal_key,
+                     const char* memtable_key) override {
+      const char* encoded_key = (memtable_key != nullptr)
+                                    ? memtable_key
+                                    : EncodeKey(&tmp_, internal_key);
+      for (auto& iter : iters_) {
+        iter.SeekForPrev(encoded_key);
+      }
+      direction_ = kBackward;
+      FindLargest();
+    }
+
+    void SeekToFirst() override {
+      for (auto& iter : iters_) {
+        iter.SeekToFirst();
+      }
+      direction_ = kForward;
+      FindSmallest();
+    }
+
+    void SeekToLast() override {
+      for (auto& iter : iters_) {
+        iter.SeekToLast();
+      }
+      direction_ = kBackward;
+      FindLargest();
+    }
+
+   private:
+    static constexpr size_t kInvalid = std::numeric_limits<size_t>::max();
+
+    void FindSmallest() {
+      current_ = kInvalid;
+      for (size_t i = 0; i < iters_.size(); ++i) {
+        if (iters_[i].Valid() &&
+            (current_ == kInvalid ||
+             rep_.cmp_(iters_[i].key(), iters_[current_].key()) < 0)) {
+          current_ = i;
+        }
+      }
+    }
+
+    void FindLargest() {
+      current_ = kInvalid;
+      for (size_t i = 0; i < iters_.size(); ++i) {
+        if (iters_[i].Valid() &&
+            (current_ == kInvalid ||
+             rep_.cmp_(iters_[i].key(), iters_[current_].key()) > 0)) {
+          current_ = i;
+        }
+      }
+    }
+
+    const ShardedSkipListRep& rep_;
+    std::vector<Shard::Iterator> iters_;
+    size_t current_;
+    enum Direction { kForward, kBackward };
+    Direction direction_;
+    std::string tmp_;  // For passing to EncodeKey
+  };
+};
+
+MemTableRep::Iterator* ShardedSkipListRep::GetIterator(Arena* arena) {
+  if (arena == nullptr) {
+    return new MergingIterator(*this);
+  } else {
+    auto mem = arena->AllocateAligned(sizeof(MergingIterator));
+    return new (mem) MergingIterator(*this);
+  }
+}
+
+struct ShardedSkipListRepOptions {
+  static const char* kName() { return "ShardedSkipListRepFactoryOptions"; }
+  size_t num_shards;
+};
+
+static std::unordered_map<std::string, OptionTypeInfo> sharded_skiplist_info = {
+    {"num_shards",
+     {offsetof(struct ShardedSkipListRepOptions, num_shards),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+};
+
+class ShardedSkipListRepFactory : public MemTableRepFactory {
+ public:
+  explicit ShardedSkipListRepFactory(size_t num_shards) {
+    options_.num_shards = num_shards;
+    RegisterOptions(&options_, &sharded_skiplist_info);
+  }
+
+  using MemTableRepFactory::CreateMemTableRep;
+  virtual MemTableRep* CreateMemTableRep(
+      const MemTableRep::KeyComparator& compare, Allocator* allocator,
+      const SliceTransform* transform, Logger* logger) override;
+
+  static const char* kClassName() { return "ShardedSkipListRepFactory"; }
+  static const char* kNickName() { return "sharded_skiplist"; }
+
+  virtual const char* Name() const override { return kClassName(); }
+  virtual const char* NickName() const override { return kNickName(); }
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+  bool CanHandleDuplicatedKey() const override { return true; }
+
+ private:
+  ShardedSkipListRepOptions options_;
+};
+
+}  // namespace
+
+MemTableRep* ShardedSkipListRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* transform, Logger* /*logger*/) {
+  return new ShardedSkipListRep(compare, allocator, transform,
+                                options_.num_shards);
+}
+
+MemTableRepFactory* NewShardedSkipListRepFactory(size_t num_shards) {
+  return new ShardedSkipListRepFactory(num_shards);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,230 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "port/port.h"
+#include "rocksdb/comparator.h"
+#include "rocksdb/memtablerep.h"
+#include "test_util/testharness.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class ShardedSkipListRepTest : public testing::Test {
+ public:
+  ShardedSkipListRepTest()
+      : internal_comparator_(BytewiseComparator()),
+        key_comparator_(internal_comparator_) {}
+
+  MemTableRep* NewRep(size_t num_shards) {
+    factory_.reset(NewShardedSkipListRepFactory(num_shards));
+    rep_.reset(factory_->CreateMemTableRep(key_comparator_, &arena_,
+                                           /*transform=*/nullptr,
+                                           /*logger=*/nullptr));
+    return rep_.get();
+  }
+
+  // Encodes a memtable entry (length-prefixed internal key followed by a
+  // length-prefixed value) into memory allocated from the rep.
+  static KeyHandle Encode(MemTableRep* rep, const Slice& user_key,
+                          SequenceNumber seq, const Slice& value) {
+    uint32_t internal_key_size = static_cast<uint32_t>(user_key.size() + 8);
+    uint32_t value_size = static_cast<uint32_t>(value.size());
+    size_t encoded_len = VarintLength(internal_key_size) + internal_key_size +
+                         VarintLength(value_size) + value_size;
+    char* buf = nullptr;
+    KeyHandle handle = rep->Allocate(encoded_len, &buf);
+    char* p = EncodeVarint32(buf, internal_key_size);
+    memcpy(p, user_key.data(), user_key.size());
+    p += user_key.size();
+    EncodeFixed64(p, PackSequenceAndType(seq, kTypeValue));
+    p += 8;
+    p = EncodeVarint32(p, value_size);
+    memcpy(p, value.data(), value.size());
+    return handle;
+  }
+
+  // Extracts the user key from an encoded memtable entry.
+  static Slice EntryUserKey(const char* entry) {
+    Slice internal_key = GetLengthPrefixedSlice(entry);
+    return ExtractUserKey(internal_key);
+  }
+
+ protected:
+  InternalKeyComparator internal_comparator_;
+  MemTable::KeyComparator key_comparator_;
+  Arena arena_;
+  std::unique_ptr<MemTableRepFactory> factory_;
+  std::unique_ptr<MemTableRep> rep_;
+};
+
+namespace {
+
+// Returns false on the first entry so Get() visits exactly one entry.
+struct GetState {
+  bool found = false;
+  std::string key;
+  std::string value;
+};
+
+bool GetCallback(void* arg, const char* entry) {
+  auto* state = static_cast<GetState*>(arg);
+  state->found = true;
+  Slice internal_key = GetLengthPrefixedSlice(entry);
+  state->key = ExtractUserKey(internal_key).ToString();
+  const char* value_ptr = internal_key.data() + internal_key.size();
+  state->value = GetLengthPrefixedSlice(value_ptr).ToString();
+  return false;
+}
+
+std::string TestKey(int i) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "key%06d", i);
+  return std::string(buf);
+}
+
+}  // namespace
+
+TEST_F(ShardedSkipListRepTest, ConcurrentInsertVisibility) {
+  // More threads than shards so that some shards see concurrent writers.
+  constexpr int kNumThreads = 8;
+  constexpr int kKeysPerThread = 1000;
+  MemTableRep* rep = NewRep(4);
+
+  std::atomic<uint64_t> sequence{0};
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kKeysPerThread; ++i) {
+        int k = t * kKeysPerThread + i;
+        SequenceNumber seq = ++sequence;
+        KeyHandle handle = Encode(rep, TestKey(k), seq, "value" + TestKey(k));
+        ASSERT_TRUE(rep->InsertKeyConcurrently(handle));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Every insert is visible through the point-lookup path once the writers
+  // have finished.
+  for (int k = 0; k < kNumThreads * kKeysPerThread; ++k) {
+    LookupKey lookup_key(TestKey(k), kMaxSequenceNumber);
+    GetState state;
+    rep->Get(lookup_key, &state, GetCallback);
+    ASSERT_TRUE(state.found) << "missing " << TestKey(k);
+    ASSERT_EQ(TestKey(k), state.key);
+    ASSERT_EQ("value" + TestKey(k), state.value);
+  }
+
+  // The merged iterator sees every key exactly once, in order, even though
+  // the keys are spread across shards.
+  std::unique_ptr<MemTableRep::Iterator> iter(rep->GetIterator());
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(TestKey(count), EntryUserKey(iter->key()).ToString());
+    ++count;
+  }
+  ASSERT_EQ(kNumThreads * kKeysPerThread, count);
+}
+
+TEST_F(ShardedSkipListRepTest, MergingIteratorAcrossShards) {
+  constexpr int kNumKeys = 500;
+  MemTableRep* rep = NewRep(8);
+  for (int k = 0; k < kNumKeys; ++k) {
+    rep->Insert(Encode(rep, TestKey(k), /*seq=*/k + 1, "v"));
+  }
+
+  std::unique_ptr<MemTableRep::Iterator> iter(rep->GetIterator());
+
+  // Backward scan from the end.
+  int expected = kNumKeys - 1;
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+    ASSERT_EQ(TestKey(expected), EntryUserKey(iter->key()).ToString());
+    --expected;
+  }
+  ASSERT_EQ(-1, expected);
+
+  // Seek into the middle, then exercise direction switches: the non-current
+  // shard iterators have to be repositioned each time the direction flips.
+  std::string seek_target;
+  AppendInternalKey(&seek_target,
+                    ParsedInternalKey(TestKey(250), kMaxSequenceNumber,
+                                      kValueTypeForSeek));
+  iter->Seek(seek_target, nullptr);
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(TestKey(250), EntryUserKey(iter->key()).ToString());
+  iter->Next();
+  ASSERT_EQ(TestKey(251), EntryUserKey(iter->key()).ToString());
+  iter->Prev();
+  ASSERT_EQ(TestKey(250), EntryUserKey(iter->key()).ToString());
+  iter->Prev();
+  ASSERT_EQ(TestKey(249), EntryUserKey(iter->key()).ToString());
+  iter->Next();
+  ASSERT_EQ(TestKey(250), EntryUserKey(iter->key()).ToString());
+
+  // SeekForPrev on a key between two stored keys lands on the smaller one.
+  std::string seek_for_prev_target;
+  AppendInternalKey(&seek_for_prev_target,
+                    ParsedInternalKey(TestKey(100) + "x", kMaxSequenceNumber,
+                                      kValueTypeForSeek));
+  iter->SeekForPrev(seek_for_prev_target, nullptr);
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(TestKey(100), EntryUserKey(iter->key()).ToString());
+
+  // Seek past the last key invalidates the iterator.
+  std::string past_end;
+  AppendInternalKey(&past_end,
+                    ParsedInternalKey(TestKey(kNumKeys), kMaxSequenceNumber,
+                                      kValueTypeForSeek));
+  iter->Seek(past_end, nullptr);
+  ASSERT_FALSE(iter->Valid());
+}
+
+TEST_F(ShardedSkipListRepTest, SingleShardDegenerateCase) {
+  // num_shards is rounded down to a power of two; 1 keeps everything in one
+  // list, which must still behave like a plain skiplist rep.
+  constexpr int kNumKeys = 100;
+  MemTableRep* rep = NewRep(1);
+  for (int k = kNumKeys - 1; k >= 0; --k) {
+    rep->Insert(Encode(rep, TestKey(k), /*seq=*/kNumKeys - k, "v"));
+  }
+  std::unique_ptr<MemTableRep::Iterator> iter(rep->GetIterator());
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(TestKey(count), EntryUserKey(iter->key()).ToString());
+    ++count;
+  }
+  ASSERT_EQ(kNumKeys, count);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#else  // ROCKSDB_LITE
+
+#include <stdio.h>
+
+int main(int /*argc*/, char** /*argv*/) {
+  fprintf(stderr,
+          "SKIPPED as ShardedSkipListRep is not supported in ROCKSDB_LITE\n");
+  return 0;
+}
+
+#endif  // ROCKSDB_LITE
@@ -15,6 +15,7 @@
 #include "cache/cache_reservation_manager.h"
 #include "db/db_impl/db_impl.h"
 #include "rocksdb/status.h"
+#include "rocksdb/system_clock.h"
 #include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -27,7 +28,10 @@ WriteBufferManager::WriteBufferManager(size_t _buffer_size,
       memory_active_(0),
       cache_res_mgr_(nullptr),
       allow_stall_(allow_stall),
-      stall_active_(false) {
+      stall_active_(false),
+      fill_rate_window_start_micros_(0),
+      fill_rate_window_bytes_(0),
+      fill_rate_last_window_bytes_(0) {
 #ifndef ROCKSDB_LITE
   if (cache) {
     // Memtable's memory usage tends to fluctuate frequently
@@ -65,9 +69,49 @@ void WriteBufferManager::ReserveMem(size_t mem) {
   }
   if (enabled()) {
     memory_active_.fetch_add(mem, std::memory_order_relaxed);
+    UpdateFillRate(mem);
   }
 }
 
+namespace {
+// Length of the window over which the recent fill rate is measured for
+// proactive flush scheduling.
+const uint64_t kFillRateWindowMicros = 1000000;
+}  // namespace
+
+void WriteBufferManager::UpdateFillRate(size_t mem) {
+  uint64_t now_micros = SystemClock::Default()->NowMicros();
+  uint64_t window_start =
+      fill_rate_window_start_micros_.load(std::memory_order_relaxed);
+  if (now_micros - window_start >= kFillRateWindowMicros) {
+    // Rotate the window. Only the winner of the CAS publishes the finished
+    // window; a lost race just means the bytes are attributed to the new
+    // window, which is fine for an estimate.
+    if (fill_rate_window_start_micros_.compare_exchange_strong(
+            window_start, now_micros, std::memory_order_relaxed)) {
+      size_t window_bytes =
+          fill_rate_window_bytes_.exchange(0, std::memory_order_relaxed);
+      // A window much longer than kFillRateWindowMicros means writes were
+      // idle; treat the stale sample as no recent fill.
+      if (now_micros - window_start >= 2 * kFillRateWindowMicros) {
+        window_bytes = 0;
+      }
+      fill_rate_last_window_bytes_.store(window_bytes,
+                                         std::memory_order_relaxed);
+    }
+  }
+  fill_rate_window_bytes_.fetch_add(mem, std::memory_order_relaxed);
+}
+
+bool WriteBufferManager::ProjectedToExceedBufferSize() const {
+  size_t last_window_bytes =
+      fill_rate_last_window_bytes_.load(std::memory_order_relaxed);
+  if (last_window_bytes == 0) {
+    return false;
+  }
+  return memory_usage() + last_window_bytes >= buffer_size();
+}
+
 // Should only be called from write thread
 void WriteBufferManager::ReserveMemWithCache(size_t mem) {
 #ifndef ROCKSDB_LITE
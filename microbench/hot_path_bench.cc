@@ -0,0 +1,423 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Microbenchmarks for individual hot-path components, so a regression in
+// one of them can be caught before it is buried inside an end-to-end
+// db_bench number. Each suite exercises one internal API directly (no DB
+// instance) and exposes the relevant PerfContext counters (or a dedicated
+// comparison counter where the component is not wired to PerfContext) via
+// benchmark counters.
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "db/compaction/compaction_iterator.h"
+#include "db/dbformat.h"
+#include "db/merge_helper.h"
+#include "db/range_del_aggregator.h"
+#include "db/write_thread.h"
+#include "memory/arena.h"
+#include "memtable/inlineskiplist.h"
+#include "options/db_options.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/options.h"
+#include "rocksdb/perf_context.h"
+#include "rocksdb/perf_level.h"
+#include "rocksdb/write_batch.h"
+#include "table/block_based/block.h"
+#include "table/block_based/block_builder.h"
+#include "table/merging_iterator.h"
+#include "util/random.h"
+#include "util/vector_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// The skip list under test stores 8-byte unsigned integers, like
+// memtable/inlineskiplist_test.cc does.
+using SkipListKey = uint64_t;
+
+SkipListKey DecodeSkipListKey(const char* key) {
+  SkipListKey rv;
+  memcpy(&rv, key, sizeof(SkipListKey));
+  return rv;
+}
+
+// InlineSkipList comparisons are not counted in PerfContext (that happens
+// one layer up, in MemTable), so count them here to get a per-operation
+// comparison number that is stable across machines.
+struct CountingSkipListComparator {
+  using DecodedType = SkipListKey;
+
+  static DecodedType decode_key(const char* b) {
+    return DecodeSkipListKey(b);
+  }
+
+  int Compare(SkipListKey a, SkipListKey b) const {
+    ++*count;
+    if (a < b) {
+      return -1;
+    } else if (a > b) {
+      return +1;
+    } else {
+      return 0;
+    }
+  }
+
+  int operator()(const char* a, const char* b) const {
+    return Compare(DecodeSkipListKey(a), DecodeSkipListKey(b));
+  }
+
+  int operator()(const char* a, const DecodedType b) const {
+    return Compare(DecodeSkipListKey(a), b);
+  }
+
+  uint64_t* count;
+};
+
+using BenchInlineSkipList = InlineSkipList<CountingSkipListComparator>;
+
+// Maps a dense index to a unique pseudo-random key (multiplication by an
+// odd constant is a bijection on uint64_t), so inserts arrive in random
+// order without pre-generating and shuffling a key vector.
+SkipListKey NthSkipListKey(uint64_t n) {
+  return n * 0x9E3779B97F4A7C13ull;
+}
+
+void SkipListInsert(BenchInlineSkipList* list, SkipListKey key) {
+  char* buf = list->AllocateKey(sizeof(SkipListKey));
+  memcpy(buf, &key, sizeof(SkipListKey));
+  list->Insert(buf);
+}
+
+}  // namespace
+
+static void InlineSkipListInsert(benchmark::State& state) {
+  uint64_t comparisons = 0;
+  CountingSkipListComparator cmp{&comparisons};
+  Arena arena;
+  BenchInlineSkipList list(cmp, &arena);
+
+  uint64_t n = 0;
+  for (auto _ : state) {
+    SkipListInsert(&list, NthSkipListKey(n++));
+  }
+  state.counters["comparisons"] = benchmark::Counter(
+      static_cast<double>(comparisons), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(InlineSkipListInsert)->Iterations(400000);
+
+static void InlineSkipListSeek(benchmark::State& state) {
+  const uint64_t num_keys = state.range(0);
+
+  uint64_t comparisons = 0;
+  CountingSkipListComparator cmp{&comparisons};
+  Arena arena;
+  BenchInlineSkipList list(cmp, &arena);
+  for (uint64_t i = 0; i < num_keys; i++) {
+    SkipListInsert(&list, NthSkipListKey(i));
+  }
+  comparisons = 0;
+
+  Random64 rnd(301);
+  BenchInlineSkipList::Iterator iter(&list);
+  for (auto _ : state) {
+    SkipListKey target = NthSkipListKey(rnd.Next() % num_keys);
+    iter.Seek(reinterpret_cast<const char*>(&target));
+    if (!iter.Valid()) {
+      state.SkipWithError("key not found");
+    }
+  }
+  state.counters["comparisons"] = benchmark::Counter(
+      static_cast<double>(comparisons), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(InlineSkipListSeek)
+    ->Iterations(1000000)
+    ->Arg(4 << 10)
+    ->Arg(256 << 10)
+    ->ArgName("num_keys");
+
+static void MergingIteratorNext(benchmark::State& state) {
+  const int num_children = static_cast<int>(state.range(0));
+  const int num_records = 100000;
+
+  Options options;
+  InternalKeyComparator icmp(options.comparator);
+
+  // Distribute sorted keys round-robin over the children so the merging
+  // iterator has to switch child on (almost) every step, like an LSM read
+  // across levels with interleaved key ranges does.
+  std::vector<std::vector<std::string>> keys(num_children);
+  std::vector<std::vector<std::string>> values(num_children);
+  char key_buf[16];
+  for (int i = 0; i < num_records; i++) {
+    snprintf(key_buf, sizeof(key_buf), "key%09d", i);
+    InternalKey ikey(key_buf, /*s=*/1, kTypeValue);
+    keys[i % num_children].emplace_back(ikey.Encode().ToString());
+    values[i % num_children].emplace_back("value");
+  }
+  std::vector<InternalIterator*> children;
+  for (int i = 0; i < num_children; i++) {
+    // Owned (and deleted) by the merging iterator.
+    children.push_back(
+        new VectorIterator(std::move(keys[i]), std::move(values[i]), &icmp));
+  }
+  InternalIterator* iter =
+      NewMergingIterator(&icmp, children.data(), num_children);
+  iter->SeekToFirst();
+
+  SetPerfLevel(kEnableTime);
+  get_perf_context()->Reset();
+  for (auto _ : state) {
+    iter->Next();
+    if (!iter->Valid()) {
+      iter->SeekToFirst();
+    }
+  }
+  state.counters["ukey_comparisons"] = benchmark::Counter(
+      static_cast<double>(get_perf_context()->user_key_comparison_count),
+      benchmark::Counter::kAvgIterations);
+  delete iter;
+}
+
+BENCHMARK(MergingIteratorNext)
+    ->Iterations(4000000)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->ArgName("num_children");
+
+namespace {
+
+// Builds a binary-searchable data block of `num_records` sequential
+// internal keys and returns the backing store in `*block_data`.
+std::unique_ptr<Block> BuildDataBlock(int num_records,
+                                      std::string* block_data) {
+  BlockBuilder builder(16, true, false,
+                       BlockBasedTableOptions::kDataBlockBinarySearch);
+  char key_buf[16];
+  for (int i = 0; i < num_records; i++) {
+    snprintf(key_buf, sizeof(key_buf), "key%09d", i);
+    InternalKey ikey(key_buf, /*s=*/0, kTypeValue);
+    builder.Add(ikey.Encode().ToString(), "value");
+  }
+  *block_data = builder.Finish().ToString();
+  BlockContents contents;
+  contents.data = Slice(*block_data);
+  return std::unique_ptr<Block>(new Block(std::move(contents)));
+}
+
+}  // namespace
+
+// Complements DataBlockSeek in db_basic_bench.cc (which measures the
+// binary-search path) by measuring the sequential parse/decode path.
+static void DataBlockIterNext(benchmark::State& state) {
+  const int num_records = 500;
+  Options options;
+  std::string block_data;
+  std::unique_ptr<Block> reader = BuildDataBlock(num_records, &block_data);
+
+  std::unique_ptr<DataBlockIter> iter(reader->NewDataIterator(
+      options.comparator, kDisableGlobalSequenceNumber));
+
+  SetPerfLevel(kEnableTime);
+  get_perf_context()->Reset();
+  // One benchmark iteration scans the whole block.
+  for (auto _ : state) {
+    iter->SeekToFirst();
+    while (iter->Valid()) {
+      iter->Next();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_records);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(block_data.size()));
+  state.counters["seek_ns"] = benchmark::Counter(
+      static_cast<double>(get_perf_context()->block_seek_nanos),
+      benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(DataBlockIterNext)->Iterations(20000);
+
+static void WriteThreadJoinGroup(benchmark::State& state) {
+  static WriteThread* write_thread = nullptr;
+  static ImmutableDBOptions* db_options = nullptr;
+  if (state.thread_index() == 0) {
+    db_options = new ImmutableDBOptions();
+    write_thread = new WriteThread(*db_options);
+  }
+
+  WriteOptions wo;
+  WriteBatch batch;
+  Status s = batch.Put("key", "value");
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+  }
+
+  SetPerfLevel(kEnableTime);
+  get_perf_context()->Reset();
+  uint64_t leader_count = 0;
+  uint64_t group_size_sum = 0;
+  for (auto _ : state) {
+    WriteThread::Writer w(wo, &batch, /*_callback=*/nullptr, /*_log_ref=*/0,
+                          /*_disable_memtable=*/false);
+    write_thread->JoinBatchGroup(&w);
+    if (w.state == WriteThread::STATE_GROUP_LEADER) {
+      WriteThread::WriteGroup group;
+      write_thread->EnterAsBatchGroupLeader(&w, &group);
+      leader_count++;
+      group_size_sum += group.size;
+      Status group_status;
+      write_thread->ExitAsBatchGroupLeader(group, group_status);
+    } else {
+      assert(w.state == WriteThread::STATE_COMPLETED);
+    }
+  }
+  // Counters sum over threads, so with kAvgIterations "leader_frac" is the
+  // fraction of writes that became a group leader and "group_size" is the
+  // average size of the groups those leaders formed times that fraction;
+  // together they recover the average group size.
+  state.counters["leader_frac"] = benchmark::Counter(
+      static_cast<double>(leader_count), benchmark::Counter::kAvgIterations);
+  state.counters["group_size"] = benchmark::Counter(
+      static_cast<double>(group_size_sum),
+      benchmark::Counter::kAvgIterations);
+  state.counters["wait_ns"] = benchmark::Counter(
+      static_cast<double>(get_perf_context()->write_thread_wait_nanos),
+      benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    delete write_thread;
+    write_thread = nullptr;
+    delete db_options;
+    db_options = nullptr;
+  }
+}
+
+BENCHMARK(WriteThreadJoinGroup)->Threads(1)->Iterations(400000);
+BENCHMARK(WriteThreadJoinGroup)->Threads(4)->Iterations(100000);
+BENCHMARK(WriteThreadJoinGroup)->Threads(8)->Iterations(50000);
+
+static void LRUCacheShardOps(benchmark::State& state) {
+  // A single shard (num_shard_bits = 0), so every thread contends on the
+  // same shard mutex like a hot shard in a real cache does.
+  static std::shared_ptr<Cache> cache = nullptr;
+  if (state.thread_index() == 0) {
+    cache = NewLRUCache(/*capacity=*/32 << 20, /*num_shard_bits=*/0);
+  }
+
+  const uint64_t key_space = 64 * 1024;
+  static char value[100];
+  auto deleter = [](const Slice& /*key*/, void* /*value*/) {};
+
+  Random64 rnd(301 + state.thread_index());
+  char key_buf[sizeof(uint64_t)];
+  uint64_t hits = 0;
+  for (auto _ : state) {
+    uint64_t k = rnd.Next() % key_space;
+    memcpy(key_buf, &k, sizeof(k));
+    Slice key(key_buf, sizeof(key_buf));
+    // 1 insert per 16 lookups, roughly a warmed cache with some churn.
+    if (k % 16 == 0) {
+      Status s = cache->Insert(key, value, sizeof(value), deleter);
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    } else {
+      Cache::Handle* handle = cache->Lookup(key);
+      if (handle != nullptr) {
+        hits++;
+        cache->Release(handle);
+      }
+    }
+  }
+  state.counters["hit_rate"] = benchmark::Counter(
+      static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    cache = nullptr;
+  }
+}
+
+BENCHMARK(LRUCacheShardOps)->Threads(1)->Iterations(2000000);
+BENCHMARK(LRUCacheShardOps)->Threads(8)->Iterations(250000);
+
+static void CompactionIteratorThroughput(benchmark::State& state) {
+  const int num_user_keys = 100000;
+
+  Options options;
+  InternalKeyComparator icmp(options.comparator);
+
+  // Two versions for every 8th user key, so the iterator both passes
+  // through single-version keys and drops obsolete ones.
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  char key_buf[16];
+  for (int i = 0; i < num_user_keys; i++) {
+    snprintf(key_buf, sizeof(key_buf), "key%09d", i);
+    InternalKey newer(key_buf, /*s=*/2, kTypeValue);
+    keys.emplace_back(newer.Encode().ToString());
+    values.emplace_back("value");
+    if (i % 8 == 0) {
+      InternalKey older(key_buf, /*s=*/1, kTypeValue);
+      keys.emplace_back(older.Encode().ToString());
+      values.emplace_back("old_value");
+    }
+  }
+  const int num_records = static_cast<int>(keys.size());
+  VectorIterator input(std::move(keys), std::move(values), &icmp);
+
+  std::vector<SequenceNumber> snapshots;
+  std::atomic<bool> shutting_down{false};
+  const std::atomic<bool> manual_compaction_canceled{false};
+  MergeHelper merge_helper(Env::Default(), options.comparator,
+                           /*user_merge_operator=*/nullptr,
+                           /*compaction_filter=*/nullptr, /*logger=*/nullptr,
+                           /*assert_valid_internal_key=*/false,
+                           /*latest_snapshot=*/0, /*snapshot_checker=*/nullptr,
+                           /*level=*/0, /*stats=*/nullptr, &shutting_down);
+
+  SetPerfLevel(kEnableTime);
+  get_perf_context()->Reset();
+  uint64_t drop_hidden = 0;
+  // One benchmark iteration drains a full pass over the input.
+  for (auto _ : state) {
+    CompactionRangeDelAggregator range_del_agg(&icmp, snapshots);
+    input.SeekToFirst();
+    CompactionIterator c_iter(
+        &input, options.comparator, &merge_helper, kMaxSequenceNumber,
+        &snapshots, /*earliest_write_conflict_snapshot=*/kMaxSequenceNumber,
+        /*job_snapshot=*/kMaxSequenceNumber, /*snapshot_checker=*/nullptr,
+        Env::Default(), /*report_detailed_time=*/false,
+        /*expect_valid_internal_key=*/true, &range_del_agg,
+        /*blob_file_builder=*/nullptr, /*allow_data_in_errors=*/true,
+        /*enforce_single_del_contracts=*/true, manual_compaction_canceled);
+    c_iter.SeekToFirst();
+    while (c_iter.Valid()) {
+      c_iter.Next();
+    }
+    if (!c_iter.status().ok()) {
+      state.SkipWithError(c_iter.status().ToString().c_str());
+    }
+    drop_hidden += c_iter.iter_stats().num_record_drop_hidden;
+  }
+  state.SetItemsProcessed(state.iterations() * num_records);
+  state.counters["ukey_comparisons"] = benchmark::Counter(
+      static_cast<double>(get_perf_context()->user_key_comparison_count),
+      benchmark::Counter::kAvgIterations);
+  state.counters["drop_hidden"] = benchmark::Counter(
+      static_cast<double>(drop_hidden), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(CompactionIteratorThroughput)->Iterations(200);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
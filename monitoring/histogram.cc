@@ -18,6 +18,7 @@
 
 #include "port/port.h"
 #include "util/cast_util.h"
+#include "util/math.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -40,15 +41,32 @@ HistogramBucketMapper::HistogramBucketMapper() {
   }
   maxBucketValue_ = bucketValues_.back();
   minBucketValue_ = bucketValues_.front();
+  for (int bit = 0; bit < 64; bit++) {
+    const uint64_t smallest_value_of_width = uint64_t{1} << bit;
+    indexForBitWidth_[bit] = std::min(
+        static_cast<size_t>(std::lower_bound(bucketValues_.begin(),
+                                             bucketValues_.end(),
+                                             smallest_value_of_width) -
+                            bucketValues_.begin()),
+        bucketValues_.size() - 1);
+  }
 }
 
 size_t HistogramBucketMapper::IndexForValue(const uint64_t value) const {
-  auto beg = bucketValues_.begin();
-  auto end = bucketValues_.end();
-  if (value >= maxBucketValue_)
-    return end - beg - 1;  // bucketValues_.size() - 1
-  else
-    return std::lower_bound(beg, end, value) - beg;
+  if (value >= maxBucketValue_) {
+    return bucketValues_.size() - 1;
+  }
+  // Constant time: jump to the first bucket limit that can hold values
+  // with the same bit width as `value`, then advance. The limits grow by
+  // 1.5x, so fewer than three buckets share a bit width and the loop runs
+  // at most twice. This is called on every timed operation when
+  // statistics are enabled, so it must stay branch-light; the previous
+  // binary search over all the limits showed up in profiles.
+  size_t index = indexForBitWidth_[FloorLog2(value | 1)];
+  while (bucketValues_[index] < value) {
+    index++;
+  }
+  return index;
 }
 
 namespace {
@@ -48,6 +48,10 @@ class HistogramBucketMapper {
   std::vector<uint64_t> bucketValues_;
   uint64_t maxBucketValue_;
   uint64_t minBucketValue_;
+  // For each possible bit width of a value, the index of the first bucket
+  // whose limit can hold values of that width. Lets IndexForValue() start
+  // right next to the answer instead of binary searching; see there.
+  size_t indexForBitWidth_[64];
 };
 
 struct HistogramStat {
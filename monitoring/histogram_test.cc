@@ -108,6 +108,34 @@ TEST_F(HistogramTest, BoundaryValue) {
   ASSERT_LE(fabs(histogram.Percentile(50.0) - 0.5), kIota);
 }
 
+TEST_F(HistogramTest, BucketMapperIndexForValue) {
+  // The constant-time IndexForValue() must agree with a straightforward
+  // scan over the bucket limits for every value.
+  auto reference_index = [&](uint64_t value) -> size_t {
+    if (value >= bucketMapper.LastValue()) {
+      return bucketMapper.BucketCount() - 1;
+    }
+    size_t index = 0;
+    while (bucketMapper.BucketLimit(index) < value) {
+      index++;
+    }
+    return index;
+  };
+  // Every bucket limit and its neighbors.
+  for (size_t b = 0; b < bucketMapper.BucketCount(); b++) {
+    const uint64_t limit = bucketMapper.BucketLimit(b);
+    for (uint64_t value : {limit - 1, limit, limit + 1}) {
+      ASSERT_EQ(bucketMapper.IndexForValue(value), reference_index(value));
+    }
+  }
+  // A spread of random values across all bit widths.
+  Random64 rnd(test::RandomSeed());
+  for (int i = 0; i < 10000; i++) {
+    const uint64_t value = rnd.Next() >> (rnd.Next() % 64);
+    ASSERT_EQ(bucketMapper.IndexForValue(value), reference_index(value));
+  }
+}
+
 TEST_F(HistogramTest, MergeHistogram) {
   HistogramImpl histogram;
   HistogramImpl other;
@@ -24,18 +24,108 @@ Statistics* stats_for_report(SystemClock* clock, Statistics* stats) {
 #endif  // NPERF_CONTEXT
 }  // namespace
 
-void InstrumentedMutex::Lock() {
+void InstrumentedMutex::Lock(const char* file, int line) {
   PERF_CONDITIONAL_TIMER_FOR_MUTEX_GUARD(
       db_mutex_lock_nanos, stats_code_ == DB_MUTEX_WAIT_MICROS,
       stats_for_report(clock_, stats_), stats_code_);
-  LockInternal();
+  LockInternal(file, line);
 }
 
-void InstrumentedMutex::LockInternal() {
+bool InstrumentedMutex::TrackContention() const {
+  return clock_ != nullptr && stats_ != nullptr &&
+         stats_->get_stats_level() > kExceptTimeForMutex;
+}
+
+void InstrumentedMutex::LockInternal(const char* file, int line) {
 #ifndef NDEBUG
   ThreadStatusUtil::TEST_StateDelay(ThreadStatus::STATE_MUTEX_WAIT);
 #endif
+  const bool track = TrackContention();
+  bool waited = false;
+  int waiter_depth = 0;
+  uint64_t wait_start_nanos = 0;
+  if (!mutex_.TryLock()) {
+    waited = true;
+    waiter_depth = waiters_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (track) {
+      wait_start_nanos = clock_->NowNanos();
+    }
+    // Spin a bounded number of rounds before parking: critical sections
+    // under this mutex are often far shorter than a futex round trip.
+    const uint32_t spin_limit = spin_limit_.load(std::memory_order_relaxed);
+    bool acquired = false;
+    for (uint32_t i = 0; i < spin_limit; ++i) {
+      port::AsmVolatilePause();
+      if (mutex_.TryLock()) {
+        acquired = true;
+        break;
+      }
+    }
+    if (acquired) {
+      // Spinning paid off; allow a larger budget next time.
+      if (spin_limit < kMaxSpinRounds) {
+        spin_limit_.store(std::min(kMaxSpinRounds, spin_limit * 2 + 1),
+                          std::memory_order_relaxed);
+      }
+    } else {
+      // The holder is taking too long for spinning to be worth it. Shrink
+      // the budget (keeping a single round so it can grow back) and park.
+      spin_limit_.store(std::max(spin_limit / 2, 1u),
+                        std::memory_order_relaxed);
+      mutex_.Lock();
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  if (track) {
+    // The mutex itself now guards the call-site map and the hold state.
+    const uint64_t now = clock_->NowNanos();
+    CallSiteStats& site = call_sites_[{file, line}];
+    ++site.lock_count;
+    if (waited) {
+      ++site.wait_count;
+      site.wait_time_nanos += now - wait_start_nanos;
+      if (static_cast<uint64_t>(waiter_depth) > site.max_waiter_depth) {
+        site.max_waiter_depth = static_cast<uint64_t>(waiter_depth);
+      }
+    }
+    held_file_ = file;
+    held_line_ = line;
+    hold_start_nanos_ = now;
+  }
+}
+
+void InstrumentedMutex::FlushHoldAccounting() {
+  if (hold_start_nanos_ == 0) {
+    return;
+  }
+  // clock_ is non-null whenever hold_start_nanos_ was set.
+  CallSiteStats& site = call_sites_[{held_file_, held_line_}];
+  site.hold_time_nanos += clock_->NowNanos() - hold_start_nanos_;
+  hold_start_nanos_ = 0;
+}
+
+void InstrumentedMutex::Unlock() {
+  FlushHoldAccounting();
+  mutex_.Unlock();
+}
+
+void InstrumentedMutex::GetCallSiteContention(
+    std::vector<MutexCallSiteContention>* sites) {
+  sites->clear();
   mutex_.Lock();
+  sites->reserve(call_sites_.size());
+  for (const auto& entry : call_sites_) {
+    MutexCallSiteContention site;
+    site.file = entry.first.first;
+    site.line = entry.first.second;
+    site.lock_count = entry.second.lock_count;
+    site.wait_count = entry.second.wait_count;
+    site.wait_time_nanos = entry.second.wait_time_nanos;
+    site.hold_time_nanos = entry.second.hold_time_nanos;
+    site.max_waiter_depth = entry.second.max_waiter_depth;
+    sites->push_back(site);
+  }
+  mutex_.Unlock();
 }
 
 void InstrumentedCondVar::Wait() {
@@ -49,6 +139,10 @@ void InstrumentedCondVar::WaitInternal() {
 #ifndef NDEBUG
   ThreadStatusUtil::TEST_StateDelay(ThreadStatus::STATE_MUTEX_WAIT);
 #endif
+  // The wait releases the mutex without going through Unlock(); close out
+  // the caller's hold interval so it is not charged for the sleep and so
+  // lockers during the wait account against their own sites.
+  instrumented_mutex_->FlushHoldAccounting();
   cond_.Wait();
 }
 
@@ -67,6 +161,7 @@ bool InstrumentedCondVar::TimedWaitInternal(uint64_t abs_time_us) {
   TEST_SYNC_POINT_CALLBACK("InstrumentedCondVar::TimedWaitInternal",
                            &abs_time_us);
 
+  instrumented_mutex_->FlushHoldAccounting();
   return cond_.TimedWait(abs_time_us);
 }
 
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "monitoring/statistics.h"
 #include "port/port.h"
 #include "rocksdb/statistics.h"
@@ -12,11 +17,56 @@
 #include "rocksdb/thread_status.h"
 #include "util/stop_watch.h"
 
+// Call-site capture for contention profiling. As default arguments,
+// __builtin_FILE() and __builtin_LINE() evaluate at the caller, so
+// existing Lock() call sites are attributed without being modified.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_FILE) && __has_builtin(__builtin_LINE)
+#define ROCKSDB_MUTEX_CALLER_SUPPORTED
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 5
+#define ROCKSDB_MUTEX_CALLER_SUPPORTED
+#endif
+
+#ifdef ROCKSDB_MUTEX_CALLER_SUPPORTED
+#define ROCKSDB_MUTEX_CALLER_FILE __builtin_FILE()
+#define ROCKSDB_MUTEX_CALLER_LINE __builtin_LINE()
+#else
+#define ROCKSDB_MUTEX_CALLER_FILE static_cast<const char*>(nullptr)
+#define ROCKSDB_MUTEX_CALLER_LINE 0
+#endif
+
 namespace ROCKSDB_NAMESPACE {
 class InstrumentedCondVar;
 
+// Snapshot of the contention counters an InstrumentedMutex keeps for one
+// Lock() call site; see InstrumentedMutex::GetCallSiteContention(). file
+// is the caller's __FILE__ literal (nullptr when the compiler cannot
+// capture call sites).
+struct MutexCallSiteContention {
+  const char* file = nullptr;
+  int line = 0;
+  // Total acquisitions from this site.
+  uint64_t lock_count = 0;
+  // Acquisitions that found the mutex taken and had to spin or park.
+  uint64_t wait_count = 0;
+  // Time spent spinning or parked before acquiring, cumulative.
+  uint64_t wait_time_nanos = 0;
+  // Time this site kept the mutex locked, cumulative. Intervals spent
+  // inside InstrumentedCondVar::Wait() are excluded.
+  uint64_t hold_time_nanos = 0;
+  // Largest number of concurrent waiters observed when waiting here.
+  uint64_t max_waiter_depth = 0;
+};
+
 // A wrapper class for port::Mutex that provides additional layer
 // for collecting stats and instrumentation.
+//
+// Beyond the stats_ reporting, the wrapper keeps per-call-site contention
+// counters (enabled when `stats` runs at a stats level above
+// kExceptTimeForMutex) and spins a bounded, adaptive number of rounds
+// before parking, so short critical sections do not pay a futex round
+// trip per contended acquisition.
 class InstrumentedMutex {
  public:
   explicit InstrumentedMutex(bool adaptive = false)
@@ -32,23 +82,59 @@ class InstrumentedMutex {
         clock_(clock),
         stats_code_(stats_code) {}
 
-  void Lock();
+  void Lock(const char* file = ROCKSDB_MUTEX_CALLER_FILE,
+            int line = ROCKSDB_MUTEX_CALLER_LINE);
 
-  void Unlock() {
-    mutex_.Unlock();
-  }
+  void Unlock();
 
   void AssertHeld() {
     mutex_.AssertHeld();
   }
 
+  // Snapshot the per-call-site contention counters accumulated so far.
+  // Empty unless contention tracking is enabled (see class comment).
+  // Briefly acquires the mutex.
+  void GetCallSiteContention(std::vector<MutexCallSiteContention>* sites);
+
  private:
-  void LockInternal();
+  void LockInternal(const char* file, int line);
+  // True when per-call-site accounting is on; same stats-level gate as
+  // the wait-time reporting to stats_.
+  bool TrackContention() const;
+  // Fold the current hold interval into its call site's counters and
+  // clear the hold state. REQUIRES: mutex_ held.
+  void FlushHoldAccounting();
+
   friend class InstrumentedCondVar;
+
+  // A successful spin grows the budget, parking shrinks it, so mutexes
+  // whose critical sections are too long to spin for converge to parking
+  // almost immediately.
+  static constexpr uint32_t kInitialSpinRounds = 128;
+  static constexpr uint32_t kMaxSpinRounds = 1024;
+
+  struct CallSiteStats {
+    uint64_t lock_count = 0;
+    uint64_t wait_count = 0;
+    uint64_t wait_time_nanos = 0;
+    uint64_t hold_time_nanos = 0;
+    uint64_t max_waiter_depth = 0;
+  };
+
   port::Mutex mutex_;
   Statistics* stats_;
   SystemClock* clock_;
   int stats_code_;
+
+  // Contention state. waiters_ and spin_limit_ are shared with relaxed
+  // atomics; the call-site map and the hold tracking below it are only
+  // touched while mutex_ is held.
+  std::atomic<int> waiters_{0};
+  std::atomic<uint32_t> spin_limit_{kInitialSpinRounds};
+  std::map<std::pair<const char*, int>, CallSiteStats> call_sites_;
+  const char* held_file_ = nullptr;
+  int held_line_ = 0;
+  uint64_t hold_start_nanos_ = 0;
 };
 
 class ALIGN_AS(CACHE_LINE_SIZE) CacheAlignedInstrumentedMutex
@@ -61,8 +147,11 @@ static_assert(alignof(CacheAlignedInstrumentedMutex) != CACHE_LINE_SIZE ||
 // RAII wrapper for InstrumentedMutex
 class InstrumentedMutexLock {
  public:
-  explicit InstrumentedMutexLock(InstrumentedMutex* mutex) : mutex_(mutex) {
-    mutex_->Lock();
+  explicit InstrumentedMutexLock(InstrumentedMutex* mutex,
+                                 const char* file = ROCKSDB_MUTEX_CALLER_FILE,
+                                 int line = ROCKSDB_MUTEX_CALLER_LINE)
+      : mutex_(mutex) {
+    mutex_->Lock(file, line);
   }
 
   ~InstrumentedMutexLock() {
@@ -79,14 +168,20 @@ class InstrumentedMutexLock {
 // InstrumentedMutexLock
 class InstrumentedMutexUnlock {
  public:
-  explicit InstrumentedMutexUnlock(InstrumentedMutex* mutex) : mutex_(mutex) {
+  explicit InstrumentedMutexUnlock(InstrumentedMutex* mutex,
+                                   const char* file = ROCKSDB_MUTEX_CALLER_FILE,
+                                   int line = ROCKSDB_MUTEX_CALLER_LINE)
+      : mutex_(mutex), file_(file), line_(line) {
     mutex_->Unlock();
   }
 
-  ~InstrumentedMutexUnlock() { mutex_->Lock(); }
+  ~InstrumentedMutexUnlock() { mutex_->Lock(file_, line_); }
 
  private:
   InstrumentedMutex* const mutex_;
+  // Re-acquisition is attributed to the site that created this unlocker.
+  const char* const file_;
+  const int line_;
   InstrumentedMutexUnlock(const InstrumentedMutexUnlock&) = delete;
   void operator=(const InstrumentedMutexUnlock&) = delete;
 };
@@ -95,6 +190,7 @@ class InstrumentedCondVar {
  public:
   explicit InstrumentedCondVar(InstrumentedMutex* instrumented_mutex)
       : cond_(&(instrumented_mutex->mutex_)),
+        instrumented_mutex_(instrumented_mutex),
         stats_(instrumented_mutex->stats_),
         clock_(instrumented_mutex->clock_),
         stats_code_(instrumented_mutex->stats_code_) {}
@@ -115,6 +211,7 @@ class InstrumentedCondVar {
   void WaitInternal();
   bool TimedWaitInternal(uint64_t abs_time_us);
   port::CondVar cond_;
+  InstrumentedMutex* const instrumented_mutex_;
   Statistics* stats_;
   SystemClock* clock_;
   int stats_code_;
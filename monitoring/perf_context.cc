@@ -6,9 +6,12 @@
 
 #include <sstream>
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/request_perf_context.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+thread_local bool ScopedRequestPerfContext::active_on_thread_ = false;
+
 #if defined(NPERF_CONTEXT)
 // Should not be used because the counters are not thread-safe.
 // Put here just to make get_perf_context() simple without ifdef.
@@ -93,6 +96,8 @@ PerfContext::PerfContext(const PerfContext& other) {
   bloom_memtable_miss_count = other.bloom_memtable_miss_count;
   bloom_sst_hit_count = other.bloom_sst_hit_count;
   bloom_sst_miss_count = other.bloom_sst_miss_count;
+  filter_cachelines_touched = other.filter_cachelines_touched;
+  filter_prepared_probes_reused = other.filter_prepared_probes_reused;
   key_lock_wait_time = other.key_lock_wait_time;
   key_lock_wait_count = other.key_lock_wait_count;
 
@@ -200,6 +205,8 @@ PerfContext::PerfContext(PerfContext&& other) noexcept {
   bloom_memtable_miss_count = other.bloom_memtable_miss_count;
   bloom_sst_hit_count = other.bloom_sst_hit_count;
   bloom_sst_miss_count = other.bloom_sst_miss_count;
+  filter_cachelines_touched = other.filter_cachelines_touched;
+  filter_prepared_probes_reused = other.filter_prepared_probes_reused;
   key_lock_wait_time = other.key_lock_wait_time;
   key_lock_wait_count = other.key_lock_wait_count;
 
@@ -309,6 +316,8 @@ PerfContext& PerfContext::operator=(const PerfContext& other) {
   bloom_memtable_miss_count = other.bloom_memtable_miss_count;
   bloom_sst_hit_count = other.bloom_sst_hit_count;
   bloom_sst_miss_count = other.bloom_sst_miss_count;
+  filter_cachelines_touched = other.filter_cachelines_touched;
+  filter_prepared_probes_reused = other.filter_prepared_probes_reused;
   key_lock_wait_time = other.key_lock_wait_time;
   key_lock_wait_count = other.key_lock_wait_count;
 
@@ -415,6 +424,8 @@ void PerfContext::Reset() {
   bloom_memtable_miss_count = 0;
   bloom_sst_hit_count = 0;
   bloom_sst_miss_count = 0;
+  filter_cachelines_touched = 0;
+  filter_prepared_probes_reused = 0;
   key_lock_wait_time = 0;
   key_lock_wait_count = 0;
 
@@ -542,6 +553,8 @@ std::string PerfContext::ToString(bool exclude_zero_counters) const {
   PERF_CONTEXT_OUTPUT(bloom_memtable_miss_count);
   PERF_CONTEXT_OUTPUT(bloom_sst_hit_count);
   PERF_CONTEXT_OUTPUT(bloom_sst_miss_count);
+  PERF_CONTEXT_OUTPUT(filter_cachelines_touched);
+  PERF_CONTEXT_OUTPUT(filter_prepared_probes_reused);
   PERF_CONTEXT_OUTPUT(key_lock_wait_time);
   PERF_CONTEXT_OUTPUT(key_lock_wait_count);
   PERF_CONTEXT_OUTPUT(env_new_sequential_file_nanos);
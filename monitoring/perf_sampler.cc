@@ -0,0 +1,109 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#include "monitoring/perf_sampler.h"
+
+#include <cassert>
+
+#include "rocksdb/perf_context.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+void SnapshotPerfContext(uint64_t (&values)[PerfSampler::kNumStages]) {
+  const PerfContext* const perf_context = get_perf_context();
+  assert(perf_context);
+
+  values[PerfSampler::kStageMemtable] = perf_context->get_from_memtable_time;
+  values[PerfSampler::kStageOutputFiles] =
+      perf_context->get_from_output_files_time;
+  values[PerfSampler::kStageBlockRead] = perf_context->block_read_time;
+  values[PerfSampler::kStageBlockChecksum] = perf_context->block_checksum_time;
+  values[PerfSampler::kStageBlockDecompress] =
+      perf_context->block_decompress_time;
+}
+
+}  // namespace
+
+PerfSampler::PerfSampler(uint64_t sample_frequency)
+    : sample_frequency_(sample_frequency) {
+  assert(sample_frequency_ > 0);
+}
+
+void PerfSampler::GetStats(std::map<std::string, std::string>* stats) const {
+  assert(stats);
+
+  static const char* const kOpTypeNames[kNumOpTypes] = {"get", "multiget"};
+  static const char* const kStageNames[kNumStages] = {
+      "memtable", "output-files", "block-read", "block-checksum",
+      "block-decompress"};
+
+  for (size_t op_type = 0; op_type < kNumOpTypes; ++op_type) {
+    const std::string op_name(kOpTypeNames[op_type]);
+
+    // All stages of a sample are recorded together, so any stage's count
+    // gives the number of operations sampled
+    (*stats)[op_name + ".samples"] = std::to_string(
+        histograms_[op_type][kStageMemtable].num());
+
+    for (size_t stage = 0; stage < kNumStages; ++stage) {
+      HistogramData data;
+      histograms_[op_type][stage].Data(&data);
+
+      const std::string prefix = op_name + "." + kStageNames[stage] + ".";
+      (*stats)[prefix + "p50"] = std::to_string(data.median);
+      (*stats)[prefix + "p95"] = std::to_string(data.percentile95);
+      (*stats)[prefix + "p99"] = std::to_string(data.percentile99);
+      (*stats)[prefix + "max"] = std::to_string(data.max);
+      (*stats)[prefix + "sum"] = std::to_string(data.sum);
+    }
+  }
+}
+
+void PerfSampler::Record(OpType op_type,
+                         const uint64_t (&deltas)[kNumStages]) {
+  assert(op_type < kNumOpTypes);
+  for (size_t stage = 0; stage < kNumStages; ++stage) {
+    histograms_[op_type][stage].Add(deltas[stage]);
+  }
+}
+
+PerfSampler::ScopedSample::ScopedSample(PerfSampler* sampler, OpType op_type)
+    : op_type_(op_type) {
+  if (sampler == nullptr || !sampler->ShouldSample()) {
+    return;
+  }
+  sampler_ = sampler;
+
+  saved_perf_level_ = GetPerfLevel();
+  if (saved_perf_level_ < kEnableTimeExceptForMutex) {
+    SetPerfLevel(kEnableTimeExceptForMutex);
+  }
+
+  SnapshotPerfContext(start_);
+}
+
+PerfSampler::ScopedSample::~ScopedSample() {
+  if (sampler_ == nullptr) {
+    return;
+  }
+
+  uint64_t end[kNumStages];
+  SnapshotPerfContext(end);
+
+  if (saved_perf_level_ < kEnableTimeExceptForMutex) {
+    SetPerfLevel(saved_perf_level_ > kUninitialized ? saved_perf_level_
+                                                    : kDisable);
+  }
+
+  uint64_t deltas[kNumStages];
+  for (size_t stage = 0; stage < kNumStages; ++stage) {
+    deltas[stage] = end[stage] - start_[stage];
+  }
+  sampler_->Record(op_type_, deltas);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,94 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "monitoring/histogram.h"
+#include "rocksdb/perf_level.h"
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Collects full perf-context timing for one in every N user read operations
+// and aggregates the measurements into per-operation-type latency-breakdown
+// histograms (time spent in the memtables, in the table files, and on block
+// reads, checksums and decompression). This provides an always-on view of
+// where read latency goes at a small fraction of the cost of running every
+// operation at kEnableTimeExceptForMutex. The aggregates are exposed through
+// the DB map property "rocksdb.perf-sample-stats"; see
+// DBOptions::perf_sample_frequency.
+//
+// Thread-safe: operations from any number of threads may be sampled
+// concurrently.
+class PerfSampler {
+ public:
+  enum OpType : size_t {
+    kGet = 0,
+    kMultiGet,
+    kNumOpTypes,
+  };
+
+  enum Stage : size_t {
+    kStageMemtable = 0,
+    kStageOutputFiles,
+    kStageBlockRead,
+    kStageBlockChecksum,
+    kStageBlockDecompress,
+    kNumStages,
+  };
+
+  // Samples one in every `sample_frequency` operations (per op type);
+  // `sample_frequency` must be positive.
+  explicit PerfSampler(uint64_t sample_frequency);
+
+  PerfSampler(const PerfSampler&) = delete;
+  PerfSampler& operator=(const PerfSampler&) = delete;
+
+  // Populates `stats` with one group of entries per op type and stage, e.g.
+  // "get.memtable.p50", plus the number of operations sampled per op type
+  // ("get.samples"). Times are in nanoseconds.
+  void GetStats(std::map<std::string, std::string>* stats) const;
+
+  // Measures a single operation. If `sampler` is nullptr or the operation is
+  // not selected for sampling, this is nearly free (one relaxed atomic
+  // increment). Otherwise, perf-context timing is enabled for the duration
+  // of the scope (unless the calling thread already has it enabled) and the
+  // measured breakdown is recorded on destruction.
+  class ScopedSample {
+   public:
+    ScopedSample(PerfSampler* sampler, OpType op_type);
+    ~ScopedSample();
+
+    // No copying allowed
+    ScopedSample(const ScopedSample&) = delete;
+    ScopedSample& operator=(const ScopedSample&) = delete;
+
+   private:
+    PerfSampler* sampler_ = nullptr;
+    OpType op_type_;
+    PerfLevel saved_perf_level_ = kDisable;
+    uint64_t start_[kNumStages];
+  };
+
+ private:
+  // Returns true if the operation that is about to start should be sampled
+  bool ShouldSample() {
+    return ops_.fetch_add(1, std::memory_order_relaxed) % sample_frequency_ ==
+           0;
+  }
+
+  void Record(OpType op_type, const uint64_t (&deltas)[kNumStages]);
+
+  const uint64_t sample_frequency_;
+  std::atomic<uint64_t> ops_{0};
+  HistogramImpl histograms_[kNumOpTypes][kNumStages];
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,68 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#pragma once
+
+#include "monitoring/iostats_context_imp.h"
+#include "monitoring/perf_context_imp.h"
+#include "rocksdb/perf_context.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Redirects the thread's perf accounting to a RequestPerfContext for the
+// scope of one request, implementing
+// ReadOptions/WriteOptions::request_perf_context. On entry the thread-local
+// PerfContext and IOStatsContext are saved and reset and the perf level is
+// raised to the request's level; on exit the accumulated counters are
+// copied into the attached context and the thread-local state is restored.
+//
+// Nesting-safe: DB entry points call each other (e.g. MultiGet overloads
+// funnel into MultiGetImpl), so only the outermost guard on a thread is
+// active; inner guards with the same or no attached context are no-ops.
+class ScopedRequestPerfContext {
+ public:
+  explicit ScopedRequestPerfContext(RequestPerfContext* ctx) : ctx_(ctx) {
+    if (ctx_ == nullptr || active_on_thread_) {
+      ctx_ = nullptr;
+      return;
+    }
+    active_on_thread_ = true;
+    saved_level_ = GetPerfLevel();
+    saved_perf_context_ = *get_perf_context();
+    saved_iostats_context_ = *get_iostats_context();
+    get_perf_context()->Reset();
+    get_iostats_context()->Reset();
+    SetPerfLevel(ctx_->level);
+  }
+
+  ~ScopedRequestPerfContext() {
+    if (ctx_ == nullptr) {
+      return;
+    }
+    ctx_->perf_context = *get_perf_context();
+    ctx_->iostats_context = *get_iostats_context();
+    *get_perf_context() = saved_perf_context_;
+    *get_iostats_context() = saved_iostats_context_;
+    SetPerfLevel(saved_level_);
+    active_on_thread_ = false;
+  }
+
+  // No copy or move; the guard is strictly scoped
+  ScopedRequestPerfContext(const ScopedRequestPerfContext&) = delete;
+  ScopedRequestPerfContext& operator=(const ScopedRequestPerfContext&) =
+      delete;
+
+ private:
+  static thread_local bool active_on_thread_;
+
+  RequestPerfContext* ctx_;
+  PerfLevel saved_level_ = PerfLevel::kUninitialized;
+  // Note: default-constructed contexts are left uninitialized by design
+  // (see PerfContext()), so an inactive guard costs only the null check
+  PerfContext saved_perf_context_;
+  IOStatsContext saved_iostats_context_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,153 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/slo_tracker.h"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+#include "monitoring/histogram_windowing.h"
+#include "rocksdb/system_clock.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+class SLOTrackerImpl : public SLOTracker {
+ public:
+  SLOTrackerImpl(uint64_t window_micros, uint64_t num_windows)
+      : window_micros_(window_micros), clock_(SystemClock::Default().get()) {
+    assert(window_micros_ > 0);
+    assert(num_windows > 0);
+    histograms_.reserve(kNumOpTypes);
+    for (uint32_t i = 0; i < kNumOpTypes; ++i) {
+      histograms_.emplace_back(new HistogramWindowingImpl(
+          num_windows, window_micros, /* min_num_per_window */ 0));
+    }
+  }
+
+  void RegisterThresholdCallback(OpType op_type, double percentile,
+                                 uint64_t threshold_micros,
+                                 ThresholdCallback callback) override {
+    assert(op_type < kNumOpTypes);
+    assert(callback);
+
+    auto threshold = std::unique_ptr<Threshold>(new Threshold());
+    threshold->percentile = percentile;
+    threshold->threshold_micros = threshold_micros;
+    threshold->callback = std::move(callback);
+
+    MutexLock lock(&thresholds_mutex_);
+    thresholds_[op_type].emplace_back(std::move(threshold));
+  }
+
+  void GetHistogramData(OpType op_type, HistogramData* data) const override {
+    assert(op_type < kNumOpTypes);
+    histograms_[op_type]->Data(data);
+  }
+
+  double GetPercentile(OpType op_type, double percentile) const override {
+    assert(op_type < kNumOpTypes);
+    return histograms_[op_type]->Percentile(percentile);
+  }
+
+  void Record(OpType op_type, uint64_t latency_micros) override {
+    assert(op_type < kNumOpTypes);
+    histograms_[op_type]->Add(latency_micros);
+
+    // Evaluating the registered thresholds on every operation would be too
+    // expensive (computing a percentile takes the histogram's lock), so
+    // only do it periodically
+    if ((op_counts_[op_type].fetch_add(1, std::memory_order_relaxed) + 1) %
+            kEvaluationInterval ==
+        0) {
+      EvaluateThresholds(op_type);
+    }
+  }
+
+ private:
+  struct Threshold {
+    double percentile = 0.0;
+    uint64_t threshold_micros = 0;
+    ThresholdCallback callback;
+    // Time the threshold last fired; enforces the once-per-window limit
+    std::atomic<uint64_t> last_fire_micros{0};
+  };
+
+  static constexpr uint64_t kEvaluationInterval = 64;
+
+  void EvaluateThresholds(OpType op_type) {
+    // Collect the breaches under the mutex but invoke the callbacks outside
+    // of it, so a callback cannot deadlock with a concurrent registration
+    struct Breach {
+      ThresholdCallback callback;
+      double percentile;
+      uint64_t threshold_micros;
+      double observed_micros;
+    };
+    std::vector<Breach> breaches;
+
+    const uint64_t now_micros = clock_->NowMicros();
+    {
+      MutexLock lock(&thresholds_mutex_);
+      for (const auto& threshold : thresholds_[op_type]) {
+        const double observed_micros =
+            histograms_[op_type]->Percentile(threshold->percentile);
+        if (observed_micros <=
+            static_cast<double>(threshold->threshold_micros)) {
+          continue;
+        }
+        const uint64_t last_fire_micros =
+            threshold->last_fire_micros.load(std::memory_order_relaxed);
+        if (now_micros - last_fire_micros < window_micros_) {
+          continue;
+        }
+        threshold->last_fire_micros.store(now_micros,
+                                          std::memory_order_relaxed);
+        breaches.emplace_back(Breach{threshold->callback,
+                                     threshold->percentile,
+                                     threshold->threshold_micros,
+                                     observed_micros});
+      }
+    }
+
+    for (const auto& breach : breaches) {
+      breach.callback(op_type, breach.percentile, breach.threshold_micros,
+                      breach.observed_micros);
+    }
+  }
+
+  const uint64_t window_micros_;
+  SystemClock* clock_;
+  std::vector<std::unique_ptr<HistogramWindowingImpl>> histograms_;
+  std::atomic<uint64_t> op_counts_[kNumOpTypes]{};
+  mutable port::Mutex thresholds_mutex_;
+  std::vector<std::unique_ptr<Threshold>> thresholds_[kNumOpTypes];
+};
+
+}  // namespace
+
+SLOTracker::ScopedTimer::ScopedTimer(SLOTracker* tracker, OpType op_type)
+    : tracker_(tracker), op_type_(op_type), start_micros_(0) {
+  if (tracker_ != nullptr) {
+    start_micros_ = SystemClock::Default()->NowMicros();
+  }
+}
+
+SLOTracker::ScopedTimer::~ScopedTimer() {
+  if (tracker_ != nullptr) {
+    tracker_->Record(op_type_,
+                     SystemClock::Default()->NowMicros() - start_micros_);
+  }
+}
+
+std::shared_ptr<SLOTracker> NewSLOTracker(uint64_t window_micros,
+                                          uint64_t num_windows) {
+  return std::make_shared<SLOTrackerImpl>(window_micros, num_windows);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -348,11 +348,85 @@ StatisticsImpl::StatisticsImpl(std::shared_ptr<Statistics> stats)
   RegisterOptions("StatisticsOptions", &stats_, &stats_type_info);
 }
 
-StatisticsImpl::~StatisticsImpl() {}
+StatisticsImpl::~StatisticsImpl() {
+  if (parent_ != nullptr) {
+    parent_->foldChildData(this);
+  }
+}
 
-uint64_t StatisticsImpl::getTickerCount(uint32_t tickerType) const {
+std::shared_ptr<Statistics> StatisticsImpl::CreateChildStatistics(
+    const std::shared_ptr<Statistics>& stats) {
+  if (!stats) {
+    return nullptr;
+  }
+  // The rollup scheme below relies on StatisticsImpl internals, so only
+  // engage it when the outermost object is one (as opposed to e.g. a user
+  // wrapper whose Inner() is a StatisticsImpl).
+  if (stats->CheckedCast<StatisticsImpl>() != stats.get()) {
+    return nullptr;
+  }
+  const auto parent = std::static_pointer_cast<StatisticsImpl>(stats);
+
+  std::shared_ptr<StatisticsImpl> child =
+      std::make_shared<StatisticsImpl>(parent->stats_);
+  child->parent_ = parent.get();
+  child->parent_guard_ = stats;
+  child->set_stats_level(parent->get_stats_level());
+
+  MutexLock lock(&parent->aggregate_lock_);
+  parent->children_.emplace_back(child);
+  return child;
+}
+
+std::vector<std::shared_ptr<StatisticsImpl>> StatisticsImpl::getChildrenLocked()
+    const {
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
+  children.reserve(children_.size());
+  for (const auto& weak_child : children_) {
+    std::shared_ptr<StatisticsImpl> child = weak_child.lock();
+    if (child) {
+      children.emplace_back(std::move(child));
+    }
+  }
+  return children;
+}
+
+void StatisticsImpl::foldChildData(StatisticsImpl* child) {
+  assert(child);
   MutexLock lock(&aggregate_lock_);
-  return getTickerCountLocked(tickerType);
+  // The child is being destroyed, so no other thread can be recording into
+  // it anymore; fold its data into our own so our totals do not go backwards
+  // once its weak registration expires.
+  for (uint32_t t = 0; t < TICKER_ENUM_MAX; ++t) {
+    per_core_stats_.AccessAtCore(0)->tickers_[t].fetch_add(
+        child->getTickerCountLocked(t), std::memory_order_relaxed);
+  }
+  for (uint32_t h = 0; h < HISTOGRAM_ENUM_MAX; ++h) {
+    per_core_stats_.AccessAtCore(0)->histograms_[h].Merge(
+        *child->getHistogramImplLocked(h));
+  }
+  children_.erase(std::remove_if(children_.begin(), children_.end(),
+                                 [](const std::weak_ptr<StatisticsImpl>& c) {
+                                   return c.expired();
+                                 }),
+                  children_.end());
+}
+
+uint64_t StatisticsImpl::getTickerCount(uint32_t tickerType) const {
+  // Note: destroying a child folds its data into this object and thus needs
+  // `aggregate_lock_`, so the references in `children` (which might be the
+  // last ones) must not be dropped until after the lock is released.
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
+  uint64_t res = 0;
+  {
+    MutexLock lock(&aggregate_lock_);
+    children = getChildrenLocked();
+    res = getTickerCountLocked(tickerType);
+  }
+  for (const auto& child : children) {
+    res += child->getTickerCount(tickerType);
+  }
+  return res;
 }
 
 uint64_t StatisticsImpl::getTickerCountLocked(uint32_t tickerType) const {
@@ -366,8 +440,23 @@ uint64_t StatisticsImpl::getTickerCountLocked(uint32_t tickerType) const {
 
 void StatisticsImpl::histogramData(uint32_t histogramType,
                                    HistogramData* const data) const {
-  MutexLock lock(&aggregate_lock_);
-  getHistogramImplLocked(histogramType)->Data(data);
+  getHistogramImpl(histogramType)->Data(data);
+}
+
+std::unique_ptr<HistogramImpl> StatisticsImpl::getHistogramImpl(
+    uint32_t histogramType) const {
+  // See getTickerCount() for why `children` must outlive the lock scope
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
+  std::unique_ptr<HistogramImpl> res_hist;
+  {
+    MutexLock lock(&aggregate_lock_);
+    children = getChildrenLocked();
+    res_hist = getHistogramImplLocked(histogramType);
+  }
+  for (const auto& child : children) {
+    res_hist->Merge(*child->getHistogramImpl(histogramType));
+  }
+  return res_hist;
 }
 
 std::unique_ptr<HistogramImpl> StatisticsImpl::getHistogramImplLocked(
@@ -382,15 +471,21 @@ std::unique_ptr<HistogramImpl> StatisticsImpl::getHistogramImplLocked(
 }
 
 std::string StatisticsImpl::getHistogramString(uint32_t histogramType) const {
-  MutexLock lock(&aggregate_lock_);
-  return getHistogramImplLocked(histogramType)->ToString();
+  return getHistogramImpl(histogramType)->ToString();
 }
 
 void StatisticsImpl::setTickerCount(uint32_t tickerType, uint64_t count) {
+  // See getTickerCount() for why `children` must outlive the lock scope
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
   {
     MutexLock lock(&aggregate_lock_);
+    children = getChildrenLocked();
     setTickerCountLocked(tickerType, count);
   }
+  for (const auto& child : children) {
+    MutexLock child_lock(&child->aggregate_lock_);
+    child->setTickerCountLocked(tickerType, 0);
+  }
   if (stats_ && tickerType < TICKER_ENUM_MAX) {
     stats_->setTickerCount(tickerType, count);
   }
@@ -408,16 +503,28 @@ void StatisticsImpl::setTickerCountLocked(uint32_t tickerType, uint64_t count) {
 }
 
 uint64_t StatisticsImpl::getAndResetTickerCount(uint32_t tickerType) {
+  // See getTickerCount() for why `children` must outlive the lock scope
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
   uint64_t sum = 0;
   {
     MutexLock lock(&aggregate_lock_);
     assert(tickerType < TICKER_ENUM_MAX);
+    children = getChildrenLocked();
     for (size_t core_idx = 0; core_idx < per_core_stats_.Size(); ++core_idx) {
       sum +=
           per_core_stats_.AccessAtCore(core_idx)->tickers_[tickerType].exchange(
               0, std::memory_order_relaxed);
     }
   }
+  for (const auto& child : children) {
+    MutexLock child_lock(&child->aggregate_lock_);
+    for (size_t core_idx = 0; core_idx < child->per_core_stats_.Size();
+         ++core_idx) {
+      sum += child->per_core_stats_.AccessAtCore(core_idx)
+                 ->tickers_[tickerType]
+                 .exchange(0, std::memory_order_relaxed);
+    }
+  }
   if (stats_ && tickerType < TICKER_ENUM_MAX) {
     stats_->setTickerCount(tickerType, 0);
   }
@@ -451,15 +558,25 @@ void StatisticsImpl::recordInHistogram(uint32_t histogramType, uint64_t value) {
 }
 
 Status StatisticsImpl::Reset() {
-  MutexLock lock(&aggregate_lock_);
-  for (uint32_t i = 0; i < TICKER_ENUM_MAX; ++i) {
-    setTickerCountLocked(i, 0);
-  }
-  for (uint32_t i = 0; i < HISTOGRAM_ENUM_MAX; ++i) {
-    for (size_t core_idx = 0; core_idx < per_core_stats_.Size(); ++core_idx) {
-      per_core_stats_.AccessAtCore(core_idx)->histograms_[i].Clear();
+  // See getTickerCount() for why `children` must outlive the lock scope
+  std::vector<std::shared_ptr<StatisticsImpl>> children;
+  {
+    MutexLock lock(&aggregate_lock_);
+    children = getChildrenLocked();
+    for (uint32_t i = 0; i < TICKER_ENUM_MAX; ++i) {
+      setTickerCountLocked(i, 0);
+    }
+    for (uint32_t i = 0; i < HISTOGRAM_ENUM_MAX; ++i) {
+      for (size_t core_idx = 0; core_idx < per_core_stats_.Size(); ++core_idx) {
+        per_core_stats_.AccessAtCore(core_idx)->histograms_[i].Clear();
+      }
     }
   }
+  for (const auto& child : children) {
+    Status s = child->Reset();
+    assert(s.ok());
+    s.PermitUncheckedError();
+  }
   return Status::OK();
 }
 
@@ -471,21 +588,20 @@ const int kTmpStrBufferSize = 200;
 } // namespace
 
 std::string StatisticsImpl::ToString() const {
-  MutexLock lock(&aggregate_lock_);
   std::string res;
   res.reserve(20000);
   for (const auto& t : TickersNameMap) {
     assert(t.first < TICKER_ENUM_MAX);
     char buffer[kTmpStrBufferSize];
     snprintf(buffer, kTmpStrBufferSize, "%s COUNT : %" PRIu64 "\n",
-             t.second.c_str(), getTickerCountLocked(t.first));
+             t.second.c_str(), getTickerCount(t.first));
     res.append(buffer);
   }
   for (const auto& h : HistogramsNameMap) {
     assert(h.first < HISTOGRAM_ENUM_MAX);
     char buffer[kTmpStrBufferSize];
     HistogramData hData;
-    getHistogramImplLocked(h.first)->Data(&hData);
+    getHistogramImpl(h.first)->Data(&hData);
     // don't handle failures - buffer should always be big enough and arguments
     // should be provided correctly
     int ret =
@@ -509,10 +625,9 @@ bool StatisticsImpl::getTickerMap(
   assert(stats_map);
   if (!stats_map) return false;
   stats_map->clear();
-  MutexLock lock(&aggregate_lock_);
   for (const auto& t : TickersNameMap) {
     assert(t.first < TICKER_ENUM_MAX);
-    (*stats_map)[t.second.c_str()] = getTickerCountLocked(t.first);
+    (*stats_map)[t.second.c_str()] = getTickerCount(t.first);
   }
   return true;
 }
@@ -47,6 +47,18 @@ class StatisticsImpl : public Statistics {
   const char* Name() const override { return kClassName(); }
   static const char* kClassName() { return "BasicStatistics"; }
 
+  // Creates a child statistics object whose updates are included in the
+  // totals reported by `stats`. A child records into its own core-local
+  // buffers, so it adds no atomic operations to the parent's update path;
+  // the parent aggregates the data of all its children lazily on read.
+  // When a child is destroyed, its data is folded into the parent so the
+  // parent's totals do not go backwards. The child adopts the parent's
+  // stats level at creation time; subsequent level changes do not
+  // propagate. Returns nullptr if `stats` is not a StatisticsImpl, in
+  // which case callers should simply keep recording into `stats` directly.
+  static std::shared_ptr<Statistics> CreateChildStatistics(
+      const std::shared_ptr<Statistics>& stats);
+
   virtual uint64_t getTickerCount(uint32_t ticker_type) const override;
   virtual void histogramData(uint32_t histogram_type,
                              HistogramData* const data) const override;
@@ -106,6 +118,21 @@ class StatisticsImpl : public Statistics {
 
   CoreLocalArray<StatisticsData> per_core_stats_;
 
+  // Set for objects created by CreateChildStatistics(). `parent_guard_`
+  // keeps the parent alive for as long as the child exists so the child's
+  // data can be folded into it on destruction.
+  StatisticsImpl* parent_ = nullptr;
+  std::shared_ptr<Statistics> parent_guard_;
+
+  // Children created by CreateChildStatistics(); protected by
+  // `aggregate_lock_`. Mutable so expired entries can be pruned lazily.
+  mutable std::vector<std::weak_ptr<StatisticsImpl>> children_;
+
+  std::vector<std::shared_ptr<StatisticsImpl>> getChildrenLocked() const;
+  void foldChildData(StatisticsImpl* child);
+
+  std::unique_ptr<HistogramImpl> getHistogramImpl(
+      uint32_t histogram_type) const;
   uint64_t getTickerCountLocked(uint32_t ticker_type) const;
   std::unique_ptr<HistogramImpl> getHistogramImplLocked(
       uint32_t histogram_type) const;
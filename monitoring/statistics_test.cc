@@ -6,6 +6,7 @@
 
 #include "rocksdb/statistics.h"
 
+#include "monitoring/statistics.h"
 #include "port/stack_trace.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/utilities/options_type.h"
@@ -40,6 +41,46 @@ TEST_F(StatisticsTest, SanityHistograms) {
   }
 }
 
+TEST_F(StatisticsTest, ChildStatistics) {
+  std::shared_ptr<Statistics> stats = CreateDBStatistics();
+  std::shared_ptr<Statistics> child =
+      StatisticsImpl::CreateChildStatistics(stats);
+  ASSERT_NE(child, nullptr);
+
+  stats->recordTick(BYTES_WRITTEN, 100);
+  child->recordTick(BYTES_WRITTEN, 10);
+  child->recordInHistogram(DB_GET, 5);
+
+  // The child only reports its own updates, while the parent lazily
+  // aggregates the data of its children into its totals
+  ASSERT_EQ(child->getTickerCount(BYTES_WRITTEN), 10U);
+  ASSERT_EQ(stats->getTickerCount(BYTES_WRITTEN), 110U);
+
+  HistogramData data;
+  stats->histogramData(DB_GET, &data);
+  ASSERT_EQ(data.count, 1U);
+
+  // Destroying the child folds its data into the parent
+  child.reset();
+  ASSERT_EQ(stats->getTickerCount(BYTES_WRITTEN), 110U);
+  stats->histogramData(DB_GET, &data);
+  ASSERT_EQ(data.count, 1U);
+
+  // Resetting the parent resets its children as well
+  child = StatisticsImpl::CreateChildStatistics(stats);
+  ASSERT_NE(child, nullptr);
+  child->recordTick(BYTES_WRITTEN, 10);
+  ASSERT_OK(stats->Reset());
+  ASSERT_EQ(child->getTickerCount(BYTES_WRITTEN), 0U);
+  ASSERT_EQ(stats->getTickerCount(BYTES_WRITTEN), 0U);
+
+  // getAndResetTickerCount() covers children too
+  child->recordTick(BYTES_WRITTEN, 10);
+  stats->recordTick(BYTES_WRITTEN, 100);
+  ASSERT_EQ(stats->getAndResetTickerCount(BYTES_WRITTEN), 110U);
+  ASSERT_EQ(child->getTickerCount(BYTES_WRITTEN), 0U);
+}
+
 TEST_F(StatisticsTest, NoNameStats) {
   static std::unordered_map<std::string, OptionTypeInfo> no_name_opt_info = {
 #ifndef ROCKSDB_LITE
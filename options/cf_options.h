@@ -131,6 +131,7 @@ struct MutableCFOptions {
         max_bytes_for_level_base(options.max_bytes_for_level_base),
         max_bytes_for_level_multiplier(options.max_bytes_for_level_multiplier),
         ttl(options.ttl),
+        ttl_delete_expired_files(options.ttl_delete_expired_files),
         periodic_compaction_seconds(options.periodic_compaction_seconds),
         max_bytes_for_level_multiplier_additional(
             options.max_bytes_for_level_multiplier_additional),
@@ -140,11 +141,17 @@ struct MutableCFOptions {
         min_blob_size(options.min_blob_size),
         blob_file_size(options.blob_file_size),
         blob_compression_type(options.blob_compression_type),
+        blob_compression_max_dict_bytes(
+            options.blob_compression_max_dict_bytes),
+        blob_compression_zstd_max_train_bytes(
+            options.blob_compression_zstd_max_train_bytes),
         enable_blob_garbage_collection(options.enable_blob_garbage_collection),
         blob_garbage_collection_age_cutoff(
             options.blob_garbage_collection_age_cutoff),
         blob_garbage_collection_force_threshold(
             options.blob_garbage_collection_force_threshold),
+        blob_garbage_collection_punch_holes(
+            options.blob_garbage_collection_punch_holes),
         blob_compaction_readahead_size(options.blob_compaction_readahead_size),
         blob_file_starting_level(options.blob_file_starting_level),
         prepopulate_blob_cache(options.prepopulate_blob_cache),
@@ -159,6 +166,8 @@ struct MutableCFOptions {
         compression_opts(options.compression_opts),
         bottommost_compression_opts(options.bottommost_compression_opts),
         bottommost_temperature(options.bottommost_temperature),
+        cold_file_age_seconds(options.cold_file_age_seconds),
+        cold_file_temperature(options.cold_file_temperature),
         sample_for_compression(
             options.sample_for_compression),  // TODO: is 0 fine here?
         compression_per_level(options.compression_per_level) {
@@ -188,15 +197,19 @@ struct MutableCFOptions {
         max_bytes_for_level_base(0),
         max_bytes_for_level_multiplier(0),
         ttl(0),
+        ttl_delete_expired_files(false),
         periodic_compaction_seconds(0),
         compaction_options_fifo(),
         enable_blob_files(false),
         min_blob_size(0),
         blob_file_size(0),
         blob_compression_type(kNoCompression),
+        blob_compression_max_dict_bytes(0),
+        blob_compression_zstd_max_train_bytes(0),
         enable_blob_garbage_collection(false),
         blob_garbage_collection_age_cutoff(0.0),
         blob_garbage_collection_force_threshold(0.0),
+        blob_garbage_collection_punch_holes(false),
         blob_compaction_readahead_size(0),
         blob_file_starting_level(0),
         prepopulate_blob_cache(PrepopulateBlobCache::kDisable),
@@ -207,6 +220,8 @@ struct MutableCFOptions {
         compression(Snappy_Supported() ? kSnappyCompression : kNoCompression),
         bottommost_compression(kDisableCompressionOption),
         bottommost_temperature(Temperature::kUnknown),
+        cold_file_age_seconds(0),
+        cold_file_temperature(Temperature::kWarm),
         sample_for_compression(0) {}
 
   explicit MutableCFOptions(const Options& options);
@@ -268,6 +283,7 @@ struct MutableCFOptions {
   uint64_t max_bytes_for_level_base;
   double max_bytes_for_level_multiplier;
   uint64_t ttl;
+  bool ttl_delete_expired_files;
   uint64_t periodic_compaction_seconds;
   std::vector<int> max_bytes_for_level_multiplier_additional;
   CompactionOptionsFIFO compaction_options_fifo;
@@ -278,9 +294,12 @@ struct MutableCFOptions {
   uint64_t min_blob_size;
   uint64_t blob_file_size;
   CompressionType blob_compression_type;
+  uint32_t blob_compression_max_dict_bytes;
+  uint32_t blob_compression_zstd_max_train_bytes;
   bool enable_blob_garbage_collection;
   double blob_garbage_collection_age_cutoff;
   double blob_garbage_collection_force_threshold;
+  bool blob_garbage_collection_punch_holes;
   uint64_t blob_compaction_readahead_size;
   int blob_file_starting_level;
   PrepopulateBlobCache prepopulate_blob_cache;
@@ -297,6 +316,8 @@ struct MutableCFOptions {
   // TODO this experimental option isn't made configurable
   // through strings yet.
   Temperature bottommost_temperature;
+  uint64_t cold_file_age_seconds;
+  Temperature cold_file_temperature;
 
   uint64_t sample_for_compression;
   std::vector<CompressionType> compression_per_level;
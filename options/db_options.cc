@@ -136,6 +136,9 @@ static std::unordered_map<std::string, OptionTypeInfo>
         /*
          // not yet supported
           std::shared_ptr<Cache> row_cache;
+          std::shared_ptr<NegativeLookupCache> negative_lookup_cache;
+          std::shared_ptr<SLOTracker> slo_tracker;
+          std::shared_ptr<RowLookupCache> row_lookup_cache;
           std::shared_ptr<DeleteScheduler> delete_scheduler;
           std::shared_ptr<Logger> info_log;
           std::shared_ptr<RateLimiter> rate_limiter;
@@ -171,6 +174,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    use_direct_io_for_flush_and_compaction),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_async_io_for_compaction",
+         {offsetof(struct ImmutableDBOptions, use_async_io_for_compaction),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"auto_tune_subcompactions",
+         {offsetof(struct ImmutableDBOptions, auto_tune_subcompactions),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"allow_2pc",
          {offsetof(struct ImmutableDBOptions, allow_2pc), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
@@ -261,6 +272,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, max_file_opening_threads),
           OptionType::kInt, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_verify_checksum_threads",
+         {offsetof(struct ImmutableDBOptions, max_verify_checksum_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"lazy_open_table_files",
+         {offsetof(struct ImmutableDBOptions, lazy_open_table_files),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_manifest_recovery_threads",
+         {offsetof(struct ImmutableDBOptions, max_manifest_recovery_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"table_cache_numshardbits",
          {offsetof(struct ImmutableDBOptions, table_cache_numshardbits),
           OptionType::kInt, OptionVerificationType::kNormal,
@@ -319,6 +342,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, enable_pipelined_write),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"enable_pipelined_flush",
+         {offsetof(struct ImmutableDBOptions, enable_pipelined_flush),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"unordered_write",
          {offsetof(struct ImmutableDBOptions, unordered_write),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -344,6 +371,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, max_write_batch_group_size_bytes),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"adaptive_write_batch_group_size",
+         {offsetof(struct ImmutableDBOptions, adaptive_write_batch_group_size),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"write_thread_max_yield_usec",
          {offsetof(struct ImmutableDBOptions, write_thread_max_yield_usec),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -357,10 +388,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          OptionTypeInfo::Enum<InfoLogLevel>(
              offsetof(struct ImmutableDBOptions, info_log_level),
              &info_log_level_string_map)},
+        {"async_info_log",
+         {offsetof(struct ImmutableDBOptions, async_info_log),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"dump_malloc_stats",
          {offsetof(struct ImmutableDBOptions, dump_malloc_stats),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_wal_recovery_threads",
+         {offsetof(struct ImmutableDBOptions, max_wal_recovery_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"avoid_flush_during_recovery",
          {offsetof(struct ImmutableDBOptions, avoid_flush_during_recovery),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -489,6 +528,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
              OptionVerificationType::kNormal,
              OptionTypeFlags::kCompareNever | OptionTypeFlags::kDontSerialize |
                  OptionTypeFlags::kAllowNull)},
+        {"perf_sample_frequency",
+         {offsetof(struct ImmutableDBOptions, perf_sample_frequency),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"predictive_write_throttling",
+         {offsetof(struct ImmutableDBOptions, predictive_write_throttling),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         // Allow EventListeners that have a non-empty Name() to be read/written
         // as options Each listener will either be
         // - A simple name (e.g. "MyEventListener")
@@ -558,6 +605,19 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, enforce_single_del_contracts),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_io_uring_wal_writes",
+         {offsetof(struct ImmutableDBOptions, use_io_uring_wal_writes),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"use_async_sst_file_writes",
+         {offsetof(struct ImmutableDBOptions, use_async_sst_file_writes),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"wal_compression_dict",
+         {offsetof(struct ImmutableDBOptions, wal_compression_dict),
+          OptionType::kString, OptionVerificationType::kNormal,
+          // Arbitrary binary contents; not representable in an options file.
+          OptionTypeFlags::kDontSerialize}},
 };
 
 const std::string OptionsHelper::kDBOptionsName = "DBOptions";
@@ -689,8 +749,14 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       sst_file_manager(options.sst_file_manager),
       info_log(options.info_log),
       info_log_level(options.info_log_level),
+      async_info_log(options.async_info_log),
       max_file_opening_threads(options.max_file_opening_threads),
+      max_verify_checksum_threads(options.max_verify_checksum_threads),
+      lazy_open_table_files(options.lazy_open_table_files),
+      max_manifest_recovery_threads(options.max_manifest_recovery_threads),
       statistics(options.statistics),
+      perf_sample_frequency(options.perf_sample_frequency),
+      predictive_write_throttling(options.predictive_write_throttling),
       use_fsync(options.use_fsync),
       db_paths(options.db_paths),
       db_log_dir(options.db_log_dir),
@@ -705,12 +771,15 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       WAL_size_limit_MB(options.WAL_size_limit_MB),
       max_write_batch_group_size_bytes(
           options.max_write_batch_group_size_bytes),
+      adaptive_write_batch_group_size(options.adaptive_write_batch_group_size),
       manifest_preallocation_size(options.manifest_preallocation_size),
       allow_mmap_reads(options.allow_mmap_reads),
       allow_mmap_writes(options.allow_mmap_writes),
       use_direct_reads(options.use_direct_reads),
       use_direct_io_for_flush_and_compaction(
           options.use_direct_io_for_flush_and_compaction),
+      use_async_io_for_compaction(options.use_async_io_for_compaction),
+      auto_tune_subcompactions(options.auto_tune_subcompactions),
       allow_fallocate(options.allow_fallocate),
       is_fd_close_on_exec(options.is_fd_close_on_exec),
       advise_random_on_open(options.advise_random_on_open),
@@ -722,6 +791,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       listeners(options.listeners),
       enable_thread_tracking(options.enable_thread_tracking),
       enable_pipelined_write(options.enable_pipelined_write),
+      enable_pipelined_flush(options.enable_pipelined_flush),
       unordered_write(options.unordered_write),
       allow_concurrent_memtable_write(options.allow_concurrent_memtable_write),
       enable_write_thread_adaptive_yield(
@@ -734,12 +804,16 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       wal_recovery_mode(options.wal_recovery_mode),
       allow_2pc(options.allow_2pc),
       row_cache(options.row_cache),
+      negative_lookup_cache(options.negative_lookup_cache),
+      slo_tracker(options.slo_tracker),
+      row_lookup_cache(options.row_lookup_cache),
 #ifndef ROCKSDB_LITE
       wal_filter(options.wal_filter),
 #endif  // ROCKSDB_LITE
       fail_if_options_file_error(options.fail_if_options_file_error),
       dump_malloc_stats(options.dump_malloc_stats),
       avoid_flush_during_recovery(options.avoid_flush_during_recovery),
+      max_wal_recovery_threads(options.max_wal_recovery_threads),
       allow_ingest_behind(options.allow_ingest_behind),
       two_write_queues(options.two_write_queues),
       manual_wal_flush(options.manual_wal_flush),
@@ -758,7 +832,10 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       checksum_handoff_file_types(options.checksum_handoff_file_types),
       lowest_used_cache_tier(options.lowest_used_cache_tier),
       compaction_service(options.compaction_service),
-      enforce_single_del_contracts(options.enforce_single_del_contracts) {
+      enforce_single_del_contracts(options.enforce_single_del_contracts),
+      use_io_uring_wal_writes(options.use_io_uring_wal_writes),
+      use_async_sst_file_writes(options.use_async_sst_file_writes),
+      wal_compression_dict(options.wal_compression_dict) {
   fs = env->GetFileSystem();
   clock = env->GetSystemClock().get();
   logger = info_log.get();
@@ -786,10 +863,25 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    fs->Name());
   ROCKS_LOG_HEADER(log, "                               Options.info_log: %p",
                    info_log.get());
+  ROCKS_LOG_HEADER(log, "                         Options.async_info_log: %d",
+                   async_info_log);
   ROCKS_LOG_HEADER(log, "               Options.max_file_opening_threads: %d",
                    max_file_opening_threads);
+  ROCKS_LOG_HEADER(log, "             Options.max_verify_checksum_threads: %d",
+                   max_verify_checksum_threads);
+  ROCKS_LOG_HEADER(log, "                  Options.lazy_open_table_files: %d",
+                   lazy_open_table_files);
+  ROCKS_LOG_HEADER(log,
+                   "           Options.max_manifest_recovery_threads: %d",
+                   max_manifest_recovery_threads);
   ROCKS_LOG_HEADER(log, "                             Options.statistics: %p",
                    stats);
+  ROCKS_LOG_HEADER(log,
+                   "                  Options.perf_sample_frequency: %" PRIu64,
+                   perf_sample_frequency);
+  ROCKS_LOG_HEADER(log,
+                   "            Options.predictive_write_throttling: %d",
+                   predictive_write_throttling);
   ROCKS_LOG_HEADER(log, "                              Options.use_fsync: %d",
                    use_fsync);
   ROCKS_LOG_HEADER(
@@ -819,6 +911,10 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    "                       "
                    "Options.use_direct_io_for_flush_and_compaction: %d",
                    use_direct_io_for_flush_and_compaction);
+  ROCKS_LOG_HEADER(log, "            Options.use_async_io_for_compaction: %d",
+                   use_async_io_for_compaction);
+  ROCKS_LOG_HEADER(log, "              Options.auto_tune_subcompactions: %d",
+                   auto_tune_subcompactions);
   ROCKS_LOG_HEADER(log, "         Options.create_missing_column_families: %d",
                    create_missing_column_families);
   ROCKS_LOG_HEADER(log, "                             Options.db_log_dir: %s",
@@ -837,6 +933,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    "                       "
                    "Options.max_write_batch_group_size_bytes: %" PRIu64,
                    max_write_batch_group_size_bytes);
+  ROCKS_LOG_HEADER(log, "      Options.adaptive_write_batch_group_size: %d",
+                   adaptive_write_batch_group_size);
   ROCKS_LOG_HEADER(
       log, "            Options.manifest_preallocation_size: %" ROCKSDB_PRIszt,
       manifest_preallocation_size);
@@ -867,6 +965,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    enable_thread_tracking);
   ROCKS_LOG_HEADER(log, "                 Options.enable_pipelined_write: %d",
                    enable_pipelined_write);
+  ROCKS_LOG_HEADER(log, "                 Options.enable_pipelined_flush: %d",
+                   enable_pipelined_flush);
   ROCKS_LOG_HEADER(log, "                 Options.unordered_write: %d",
                    unordered_write);
   ROCKS_LOG_HEADER(log, "        Options.allow_concurrent_memtable_write: %d",
@@ -888,6 +988,22 @@ void ImmutableDBOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "                              Options.row_cache: None");
   }
+  if (negative_lookup_cache) {
+    ROCKS_LOG_HEADER(log,
+                     "                Options.negative_lookup_cache: present");
+  } else {
+    ROCKS_LOG_HEADER(log,
+                     "                Options.negative_lookup_cache: None");
+  }
+  ROCKS_LOG_HEADER(log, "                            Options.slo_tracker: %s",
+                   slo_tracker ? "present" : "None");
+  if (row_lookup_cache) {
+    ROCKS_LOG_HEADER(log,
+                     "                     Options.row_lookup_cache: present");
+  } else {
+    ROCKS_LOG_HEADER(log,
+                     "                     Options.row_lookup_cache: None");
+  }
 #ifndef ROCKSDB_LITE
   ROCKS_LOG_HEADER(log, "                             Options.wal_filter: %s",
                    wal_filter ? wal_filter->Name() : "None");
@@ -895,6 +1011,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
 
   ROCKS_LOG_HEADER(log, "            Options.avoid_flush_during_recovery: %d",
                    avoid_flush_during_recovery);
+  ROCKS_LOG_HEADER(log, "             Options.max_wal_recovery_threads: %d",
+                   max_wal_recovery_threads);
   ROCKS_LOG_HEADER(log, "            Options.allow_ingest_behind: %d",
                    allow_ingest_behind);
   ROCKS_LOG_HEADER(log, "            Options.two_write_queues: %d",
@@ -930,6 +1048,12 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    db_host_id.c_str());
   ROCKS_LOG_HEADER(log, "            Options.enforce_single_del_contracts: %s",
                    enforce_single_del_contracts ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "            Options.use_io_uring_wal_writes: %s",
+                   use_io_uring_wal_writes ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "            Options.use_async_sst_file_writes: %s",
+                   use_async_sst_file_writes ? "true" : "false");
+  ROCKS_LOG_HEADER(log, "            Options.wal_compression_dict: %s",
+                   wal_compression_dict.empty() ? "(none)" : "(set)");
 }
 
 bool ImmutableDBOptions::IsWalDirSameAsDBPath() const {
@@ -32,8 +32,14 @@ struct ImmutableDBOptions {
   std::shared_ptr<SstFileManager> sst_file_manager;
   std::shared_ptr<Logger> info_log;
   InfoLogLevel info_log_level;
+  bool async_info_log;
   int max_file_opening_threads;
+  int max_verify_checksum_threads;
+  bool lazy_open_table_files;
+  int max_manifest_recovery_threads;
   std::shared_ptr<Statistics> statistics;
+  uint64_t perf_sample_frequency;
+  bool predictive_write_throttling;
   bool use_fsync;
   std::vector<DbPath> db_paths;
   std::string db_log_dir;
@@ -50,11 +56,14 @@ struct ImmutableDBOptions {
   uint64_t WAL_ttl_seconds;
   uint64_t WAL_size_limit_MB;
   uint64_t max_write_batch_group_size_bytes;
+  bool adaptive_write_batch_group_size;
   size_t manifest_preallocation_size;
   bool allow_mmap_reads;
   bool allow_mmap_writes;
   bool use_direct_reads;
   bool use_direct_io_for_flush_and_compaction;
+  bool use_async_io_for_compaction;
+  bool auto_tune_subcompactions;
   bool allow_fallocate;
   bool is_fd_close_on_exec;
   bool advise_random_on_open;
@@ -66,6 +75,7 @@ struct ImmutableDBOptions {
   std::vector<std::shared_ptr<EventListener>> listeners;
   bool enable_thread_tracking;
   bool enable_pipelined_write;
+  bool enable_pipelined_flush;
   bool unordered_write;
   bool allow_concurrent_memtable_write;
   bool enable_write_thread_adaptive_yield;
@@ -76,12 +86,16 @@ struct ImmutableDBOptions {
   WALRecoveryMode wal_recovery_mode;
   bool allow_2pc;
   std::shared_ptr<Cache> row_cache;
+  std::shared_ptr<NegativeLookupCache> negative_lookup_cache;
+  std::shared_ptr<SLOTracker> slo_tracker;
+  std::shared_ptr<RowLookupCache> row_lookup_cache;
 #ifndef ROCKSDB_LITE
   WalFilter* wal_filter;
 #endif  // ROCKSDB_LITE
   bool fail_if_options_file_error;
   bool dump_malloc_stats;
   bool avoid_flush_during_recovery;
+  int max_wal_recovery_threads;
   bool allow_ingest_behind;
   bool two_write_queues;
   bool manual_wal_flush;
@@ -106,6 +120,9 @@ struct ImmutableDBOptions {
   Logger* logger;
   std::shared_ptr<CompactionService> compaction_service;
   bool enforce_single_del_contracts;
+  bool use_io_uring_wal_writes;
+  bool use_async_sst_file_writes;
+  std::string wal_compression_dict;
 
   bool IsWalDirSameAsDBPath() const;
   bool IsWalDirSameAsDBPath(const std::string& path) const;
@@ -98,11 +98,16 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       min_blob_size(options.min_blob_size),
       blob_file_size(options.blob_file_size),
       blob_compression_type(options.blob_compression_type),
+      blob_compression_max_dict_bytes(options.blob_compression_max_dict_bytes),
+      blob_compression_zstd_max_train_bytes(
+          options.blob_compression_zstd_max_train_bytes),
       enable_blob_garbage_collection(options.enable_blob_garbage_collection),
       blob_garbage_collection_age_cutoff(
           options.blob_garbage_collection_age_cutoff),
       blob_garbage_collection_force_threshold(
           options.blob_garbage_collection_force_threshold),
+      blob_garbage_collection_punch_holes(
+          options.blob_garbage_collection_punch_holes),
       blob_compaction_readahead_size(options.blob_compaction_readahead_size),
       blob_file_starting_level(options.blob_file_starting_level),
       blob_cache(options.blob_cache),
@@ -221,6 +226,10 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         log,
         "        Options.bottommost_compression_opts.use_zstd_dict_trainer: %s",
         bottommost_compression_opts.use_zstd_dict_trainer ? "true" : "false");
+    ROCKS_LOG_HEADER(
+        log,
+        "        Options.bottommost_compression_opts.max_compress_entropy: %f",
+        bottommost_compression_opts.max_compress_entropy);
     ROCKS_LOG_HEADER(log, "           Options.compression_opts.window_bits: %d",
                      compression_opts.window_bits);
     ROCKS_LOG_HEADER(log, "                 Options.compression_opts.level: %d",
@@ -249,6 +258,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      "        Options.compression_opts.max_dict_buffer_bytes: "
                      "%" PRIu64,
                      compression_opts.max_dict_buffer_bytes);
+    ROCKS_LOG_HEADER(
+        log, "        Options.compression_opts.max_compress_entropy: %f",
+        compression_opts.max_compress_entropy);
     ROCKS_LOG_HEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
                      level0_file_num_compaction_trigger);
     ROCKS_LOG_HEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
@@ -413,12 +425,20 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         blob_file_size);
     ROCKS_LOG_HEADER(log, "                  Options.blob_compression_type: %s",
                      CompressionTypeToString(blob_compression_type).c_str());
+    ROCKS_LOG_HEADER(
+        log, "        Options.blob_compression_max_dict_bytes: %" PRIu32,
+        blob_compression_max_dict_bytes);
+    ROCKS_LOG_HEADER(
+        log, "  Options.blob_compression_zstd_max_train_bytes: %" PRIu32,
+        blob_compression_zstd_max_train_bytes);
     ROCKS_LOG_HEADER(log, "         Options.enable_blob_garbage_collection: %s",
                      enable_blob_garbage_collection ? "true" : "false");
     ROCKS_LOG_HEADER(log, "     Options.blob_garbage_collection_age_cutoff: %f",
                      blob_garbage_collection_age_cutoff);
     ROCKS_LOG_HEADER(log, "Options.blob_garbage_collection_force_threshold: %f",
                      blob_garbage_collection_force_threshold);
+    ROCKS_LOG_HEADER(log, "    Options.blob_garbage_collection_punch_holes: %s",
+                     blob_garbage_collection_punch_holes ? "true" : "false");
     ROCKS_LOG_HEADER(
         log, "         Options.blob_compaction_readahead_size: %" PRIu64,
         blob_compaction_readahead_size);
@@ -77,11 +77,20 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.sst_file_manager = immutable_db_options.sst_file_manager;
   options.info_log = immutable_db_options.info_log;
   options.info_log_level = immutable_db_options.info_log_level;
+  options.async_info_log = immutable_db_options.async_info_log;
   options.max_open_files = mutable_db_options.max_open_files;
   options.max_file_opening_threads =
       immutable_db_options.max_file_opening_threads;
+  options.lazy_open_table_files = immutable_db_options.lazy_open_table_files;
+  options.max_verify_checksum_threads =
+      immutable_db_options.max_verify_checksum_threads;
+  options.max_manifest_recovery_threads =
+      immutable_db_options.max_manifest_recovery_threads;
   options.max_total_wal_size = mutable_db_options.max_total_wal_size;
   options.statistics = immutable_db_options.statistics;
+  options.perf_sample_frequency = immutable_db_options.perf_sample_frequency;
+  options.predictive_write_throttling =
+      immutable_db_options.predictive_write_throttling;
   options.use_fsync = immutable_db_options.use_fsync;
   options.db_paths = immutable_db_options.db_paths;
   options.db_log_dir = immutable_db_options.db_log_dir;
@@ -112,6 +121,10 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.use_direct_reads = immutable_db_options.use_direct_reads;
   options.use_direct_io_for_flush_and_compaction =
       immutable_db_options.use_direct_io_for_flush_and_compaction;
+  options.use_async_io_for_compaction =
+      immutable_db_options.use_async_io_for_compaction;
+  options.auto_tune_subcompactions =
+      immutable_db_options.auto_tune_subcompactions;
   options.allow_fallocate = immutable_db_options.allow_fallocate;
   options.is_fd_close_on_exec = immutable_db_options.is_fd_close_on_exec;
   options.stats_dump_period_sec = mutable_db_options.stats_dump_period_sec;
@@ -136,6 +149,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.enable_thread_tracking = immutable_db_options.enable_thread_tracking;
   options.delayed_write_rate = mutable_db_options.delayed_write_rate;
   options.enable_pipelined_write = immutable_db_options.enable_pipelined_write;
+  options.enable_pipelined_flush = immutable_db_options.enable_pipelined_flush;
   options.unordered_write = immutable_db_options.unordered_write;
   options.allow_concurrent_memtable_write =
       immutable_db_options.allow_concurrent_memtable_write;
@@ -143,6 +157,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.enable_write_thread_adaptive_yield;
   options.max_write_batch_group_size_bytes =
       immutable_db_options.max_write_batch_group_size_bytes;
+  options.adaptive_write_batch_group_size =
+      immutable_db_options.adaptive_write_batch_group_size;
   options.write_thread_max_yield_usec =
       immutable_db_options.write_thread_max_yield_usec;
   options.write_thread_slow_yield_usec =
@@ -154,6 +170,9 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.wal_recovery_mode = immutable_db_options.wal_recovery_mode;
   options.allow_2pc = immutable_db_options.allow_2pc;
   options.row_cache = immutable_db_options.row_cache;
+  options.negative_lookup_cache = immutable_db_options.negative_lookup_cache;
+  options.slo_tracker = immutable_db_options.slo_tracker;
+  options.row_lookup_cache = immutable_db_options.row_lookup_cache;
 #ifndef ROCKSDB_LITE
   options.wal_filter = immutable_db_options.wal_filter;
 #endif  // ROCKSDB_LITE
@@ -162,6 +181,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.dump_malloc_stats = immutable_db_options.dump_malloc_stats;
   options.avoid_flush_during_recovery =
       immutable_db_options.avoid_flush_during_recovery;
+  options.max_wal_recovery_threads =
+      immutable_db_options.max_wal_recovery_threads;
   options.avoid_flush_during_shutdown =
       mutable_db_options.avoid_flush_during_shutdown;
   options.allow_ingest_behind = immutable_db_options.allow_ingest_behind;
@@ -186,6 +207,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.lowest_used_cache_tier = immutable_db_options.lowest_used_cache_tier;
   options.enforce_single_del_contracts =
       immutable_db_options.enforce_single_del_contracts;
+  options.use_io_uring_wal_writes = immutable_db_options.use_io_uring_wal_writes;
+  options.wal_compression_dict = immutable_db_options.wal_compression_dict;
   return options;
 }
 
@@ -233,6 +256,7 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
   cf_opts->max_bytes_for_level_multiplier =
       moptions.max_bytes_for_level_multiplier;
   cf_opts->ttl = moptions.ttl;
+  cf_opts->ttl_delete_expired_files = moptions.ttl_delete_expired_files;
   cf_opts->periodic_compaction_seconds = moptions.periodic_compaction_seconds;
 
   cf_opts->max_bytes_for_level_multiplier_additional.clear();
@@ -248,12 +272,18 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
   cf_opts->min_blob_size = moptions.min_blob_size;
   cf_opts->blob_file_size = moptions.blob_file_size;
   cf_opts->blob_compression_type = moptions.blob_compression_type;
+  cf_opts->blob_compression_max_dict_bytes =
+      moptions.blob_compression_max_dict_bytes;
+  cf_opts->blob_compression_zstd_max_train_bytes =
+      moptions.blob_compression_zstd_max_train_bytes;
   cf_opts->enable_blob_garbage_collection =
       moptions.enable_blob_garbage_collection;
   cf_opts->blob_garbage_collection_age_cutoff =
       moptions.blob_garbage_collection_age_cutoff;
   cf_opts->blob_garbage_collection_force_threshold =
       moptions.blob_garbage_collection_force_threshold;
+  cf_opts->blob_garbage_collection_punch_holes =
+      moptions.blob_garbage_collection_punch_holes;
   cf_opts->blob_compaction_readahead_size =
       moptions.blob_compaction_readahead_size;
   cf_opts->blob_file_starting_level = moptions.blob_file_starting_level;
@@ -273,6 +303,8 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
   cf_opts->sample_for_compression = moptions.sample_for_compression;
   cf_opts->compression_per_level = moptions.compression_per_level;
   cf_opts->bottommost_temperature = moptions.bottommost_temperature;
+  cf_opts->cold_file_age_seconds = moptions.cold_file_age_seconds;
+  cf_opts->cold_file_temperature = moptions.cold_file_temperature;
 }
 
 void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
@@ -8,6 +8,8 @@ LIB_SOURCES =                                                   \
   cache/clock_cache.cc                                          \
   cache/fast_lru_cache.cc                                       \
   cache/lru_cache.cc                                            \
+  cache/negative_lookup_cache.cc                                \
+  cache/row_lookup_cache.cc                                     \
   cache/compressed_secondary_cache.cc                           \
   cache/sharded_cache.cc                                        \
   db/arena_wrapped_db_iter.cc                                   \
@@ -117,17 +119,20 @@ LIB_SOURCES =                                                   \
   file/sequence_file_reader.cc                                  \
   file/sst_file_manager_impl.cc                                 \
   file/writable_file_writer.cc                                  \
+  logging/async_logger.cc                                       \
   logging/auto_roll_logger.cc                                   \
   logging/event_logger.cc                                       \
   logging/log_buffer.cc                                         \
   memory/arena.cc                                               \
   memory/concurrent_arena.cc                                    \
+  memory/huge_page_allocator.cc                                 \
   memory/jemalloc_nodump_allocator.cc                           \
   memory/memkind_kmem_allocator.cc                              \
   memory/memory_allocator.cc                                    \
   memtable/alloc_tracker.cc                                     \
   memtable/hash_linklist_rep.cc                                 \
   memtable/hash_skiplist_rep.cc                                 \
+  memtable/sharded_skiplist_rep.cc                              \
   memtable/skiplistrep.cc                                       \
   memtable/vectorrep.cc                                         \
   memtable/write_buffer_manager.cc                              \
@@ -138,6 +143,8 @@ LIB_SOURCES =                                                   \
   monitoring/iostats_context.cc                                 \
   monitoring/perf_context.cc                                    \
   monitoring/perf_level.cc                                      \
+  monitoring/perf_sampler.cc                                    \
+  monitoring/slo_tracker.cc                                     \
   monitoring/persistent_stats_history.cc                        \
   monitoring/statistics.cc                                      \
   monitoring/thread_status_impl.cc                              \
@@ -179,16 +186,23 @@ LIB_SOURCES =                                                   \
   table/block_based/hash_index_reader.cc                        \
   table/block_based/index_builder.cc                            \
   table/block_based/index_reader_common.cc                      \
+  table/block_based/learned_index.cc                            \
+  table/block_based/learned_index_reader.cc                     \
   table/block_based/parsed_full_filter_block.cc                 \
   table/block_based/partitioned_filter_block.cc                 \
   table/block_based/partitioned_index_iterator.cc               \
   table/block_based/partitioned_index_reader.cc                 \
   table/block_based/reader_common.cc                            \
+  table/block_based/uncompression_dict_pool.cc                  \
   table/block_based/uncompression_dict_reader.cc                \
+  table/block_based/whole_key_hash_index.cc                     \
   table/block_fetcher.cc                                        \
   table/cuckoo/cuckoo_table_builder.cc                          \
   table/cuckoo/cuckoo_table_factory.cc                          \
   table/cuckoo/cuckoo_table_reader.cc                           \
+  table/flat/flat_table_builder.cc                              \
+  table/flat/flat_table_factory.cc                              \
+  table/flat/flat_table_reader.cc                               \
   table/format.cc                                               \
   table/get_context.cc                                          \
   table/iterator.cc                                             \
@@ -342,6 +356,7 @@ TOOL_LIB_SOURCES =                                              \
   utilities/blob_db/blob_dump_tool.cc                           \
 
 ANALYZER_LIB_SOURCES =                                          \
+  tools/block_cache_analyzer/block_cache_online_analyzer.cc     \
   tools/block_cache_analyzer/block_cache_trace_analyzer.cc      \
   tools/trace_analyzer_tool.cc                                  \
 
@@ -488,6 +503,7 @@ TEST_MAIN_SOURCES =                                                     \
   db/external_sst_file_test.cc                                          \
   db/fault_injection_test.cc                                            \
   db/file_indexer_test.cc                                               \
+  db/flat_table_db_test.cc                                              \
   db/filename_test.cc                                                   \
   db/flush_job_test.cc                                                  \
   db/listener_test.cc                                                   \
@@ -529,6 +545,7 @@ TEST_MAIN_SOURCES =                                                     \
   memory/arena_test.cc                                                  \
   memory/memory_allocator_test.cc                                       \
   memtable/inlineskiplist_test.cc                                       \
+  memtable/sharded_skiplist_rep_test.cc                                 \
   memtable/skiplist_test.cc                                             \
   memtable/write_buffer_manager_test.cc                                 \
   monitoring/histogram_test.cc                                          \
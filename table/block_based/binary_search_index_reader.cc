@@ -11,8 +11,9 @@
 namespace ROCKSDB_NAMESPACE {
 Status BinarySearchIndexReader::Create(
     const BlockBasedTable* table, const ReadOptions& ro,
-    FilePrefetchBuffer* prefetch_buffer, bool use_cache, bool prefetch,
-    bool pin, BlockCacheLookupContext* lookup_context,
+    FilePrefetchBuffer* prefetch_buffer, InternalIterator* meta_index_iter,
+    bool use_cache, bool prefetch, bool pin,
+    BlockCacheLookupContext* lookup_context,
     std::unique_ptr<IndexReader>* index_reader) {
   assert(table != nullptr);
   assert(table->get_rep());
@@ -33,10 +34,12 @@ Status BinarySearchIndexReader::Create(
     }
   }
 
-  index_reader->reset(
-      new BinarySearchIndexReader(table, std::move(index_block)));
+  BinarySearchIndexReader* const reader =
+      new BinarySearchIndexReader(table, std::move(index_block));
+  index_reader->reset(reader);
 
-  return Status::OK();
+  return ReadIndexHandleOffsets(table, prefetch_buffer, meta_index_iter,
+                                &reader->handle_offsets_);
 }
 
 InternalIteratorBase<IndexValue>* BinarySearchIndexReader::NewIterator(
@@ -64,7 +67,11 @@ InternalIteratorBase<IndexValue>* BinarySearchIndexReader::NewIterator(
   auto it = index_block.GetValue()->NewIndexIterator(
       internal_comparator()->user_comparator(),
       rep->get_global_seqno(BlockType::kIndex), iter, kNullStats, true,
-      index_has_first_key(), index_key_includes_seq(), index_value_is_full());
+      index_has_first_key(), index_key_includes_seq(), index_value_is_full(),
+      false /* block_contents_pinned */, nullptr /* prefix_index */,
+      nullptr /* learned_index */,
+      handle_offsets_.empty() ? nullptr : handle_offsets_.data(),
+      static_cast<uint32_t>(handle_offsets_.size() / sizeof(uint64_t)));
 
   assert(it != nullptr);
   index_block.TransferTo(it);
@@ -20,7 +20,8 @@ class BinarySearchIndexReader : public BlockBasedTable::IndexReaderCommon {
   // On success, index_reader will be populated; otherwise it will remain
   // unmodified.
   static Status Create(const BlockBasedTable* table, const ReadOptions& ro,
-                       FilePrefetchBuffer* prefetch_buffer, bool use_cache,
+                       FilePrefetchBuffer* prefetch_buffer,
+                       InternalIterator* meta_index_iter, bool use_cache,
                        bool prefetch, bool pin,
                        BlockCacheLookupContext* lookup_context,
                        std::unique_ptr<IndexReader>* index_reader);
@@ -37,6 +38,7 @@ class BinarySearchIndexReader : public BlockBasedTable::IndexReaderCommon {
 #else
     usage += sizeof(*this);
 #endif  // ROCKSDB_MALLOC_USABLE_SIZE
+    usage += handle_offsets_.size();
     return usage;
   }
 
@@ -44,5 +46,9 @@ class BinarySearchIndexReader : public BlockBasedTable::IndexReaderCommon {
   BinarySearchIndexReader(const BlockBasedTable* t,
                           CachableEntry<Block>&& index_block)
       : IndexReaderCommon(t, std::move(index_block)) {}
+
+  // Fixed-stride data block offsets when the table was written with
+  // use_fixed_stride_index_handles; empty otherwise.
+  std::string handle_offsets_;
 };
 }  // namespace ROCKSDB_NAMESPACE
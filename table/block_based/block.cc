@@ -20,6 +20,7 @@
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
+#include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_footer.h"
 #include "table/format.h"
@@ -104,6 +105,56 @@ struct DecodeKey {
   }
 };
 
+// Little-endian truncation masks for grouped entry headers, indexed by byte
+// width.
+static const uint32_t kGroupedWidthMask[5] = {0, 0xffu, 0xffffu, 0xffffffu,
+                                              0xffffffffu};
+
+// Decodes a grouped entry header (data blocks of format_version >= 6): one
+// control byte carrying the byte width of each of the three values, then
+// the values as little-endian integers truncated to those widths. Unlike
+// the varint format, the decode is free of data-dependent branches. See the
+// format comment in block_builder.cc.
+struct DecodeGroupedEntry {
+  inline const char* operator()(const char* p, const char* limit,
+                                uint32_t* shared, uint32_t* non_shared,
+                                uint32_t* value_length) {
+    // The smallest possible header is the control byte plus one byte per
+    // value.
+    assert(limit - p >= 4);
+    // limit only feeds the assertions; like DecodeEntry above, we do not
+    // pay for per-key corruption checks in release builds.
+    (void)limit;
+    const uint32_t control = reinterpret_cast<const unsigned char*>(p)[0];
+    const size_t w_shared = (control & 0x3) + 1;
+    const size_t w_non_shared = ((control >> 2) & 0x3) + 1;
+    const size_t w_value = ((control >> 4) & 0x3) + 1;
+    p += 1;
+    // The 4-byte loads below may read up to three bytes past the encoded
+    // header, but never past the end of the block: the restart array and
+    // the block footer (at least eight bytes) follow the entry data.
+    *shared = DecodeFixed32(p) & kGroupedWidthMask[w_shared];
+    p += w_shared;
+    *non_shared = DecodeFixed32(p) & kGroupedWidthMask[w_non_shared];
+    p += w_non_shared;
+    *value_length = DecodeFixed32(p) & kGroupedWidthMask[w_value];
+    p += w_value;
+
+    // Using an assert in place of "return null" since we should not pay the
+    // cost of checking for corruption on every single key decoding
+    assert(!(static_cast<uint32_t>(limit - p) < (*non_shared + *value_length)));
+    return p;
+  }
+};
+
+struct DecodeGroupedKey {
+  inline const char* operator()(const char* p, const char* limit,
+                                uint32_t* shared, uint32_t* non_shared) {
+    uint32_t value_length;
+    return DecodeGroupedEntry()(p, limit, shared, non_shared, &value_length);
+  }
+};
+
 // In format_version 4, which is used by index blocks, the value size is not
 // encoded before the entry, as the value is known to be the handle with the
 // known size.
@@ -228,7 +279,8 @@ void DataBlockIter::PrevImpl() {
     return;
   }
 
-  // Clear prev entries cache
+  // Clear prev entries cache (the buffers keep their capacity, so steady
+  // state reverse scans do not reallocate per fill)
   prev_entries_idx_ = -1;
   prev_entries_.clear();
   prev_entries_keys_buff_.clear();
@@ -245,6 +297,16 @@ void DataBlockIter::PrevImpl() {
     restart_index_--;
   }
 
+  // Cache a window of up to kNumPrevCacheRestartIntervals restart intervals
+  // ending right before `original` instead of just one, so consecutive
+  // cache fills during a reverse scan are rarer. ParseNextDataKey() below
+  // re-advances restart_index_ as the walk crosses restart points.
+  if (restart_index_ >= kNumPrevCacheRestartIntervals - 1) {
+    restart_index_ -= kNumPrevCacheRestartIntervals - 1;
+  } else {
+    restart_index_ = 0;
+  }
+
   SeekToRestartPoint(restart_index_);
 
   do {
@@ -279,7 +341,10 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = grouped_entry_headers_
+                ? BinarySeek<DecodeGroupedKey>(seek_key, &index,
+                                               &skip_linear_scan)
+                : BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -402,8 +467,8 @@ bool DataBlockIter::SeekForGetImpl(const Slice& target) {
     return true;
   }
 
-  if (icmp_->user_comparator()->Compare(raw_key_.GetUserKey(),
-                                        target_user_key) != 0) {
+  if (icmp_->user_comparator_wrapper().Compare(raw_key_.GetUserKey(),
+                                               target_user_key) != 0) {
     // the key is not in this block and cannot be at the next block either.
     return false;
   }
@@ -434,6 +499,36 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     seek_key = ExtractUserKey(target);
   }
   status_ = Status::OK();
+  if (whole_key_hash_index_ != nullptr) {
+    const Slice user_target =
+        raw_key_.IsUserKey() ? seek_key : ExtractUserKey(seek_key);
+    uint32_t entry = 0;
+    switch (whole_key_hash_index_->Lookup(user_target, &entry)) {
+      case WholeKeyHashIndex::LookupResult::kAbsent:
+        // No key in the table hashes to the target's bucket, so the key is
+        // guaranteed absent. As with a non-existing prefix below, set
+        // NotFound so the caller can tell this apart from running off the
+        // end of the index.
+        current_ = restarts_;
+        restart_index_ = num_restarts_;
+        status_ = Status::NotFound();
+        return;
+      case WholeKeyHashIndex::LookupResult::kFound:
+        // Land directly on the first index entry whose data block may hold
+        // the user key. The caller's forward walk covers the (rare) case of
+        // an absent key whose hash points at an earlier entry.
+        if (entry >= num_restarts_) {
+          CorruptionError();
+          return;
+        }
+        SeekToRestartPoint(entry);
+        ParseNextIndexKey();
+        return;
+      case WholeKeyHashIndex::LookupResult::kAmbiguous:
+        // Ambiguous bucket; fall through to binary search.
+        break;
+    }
+  }
   uint32_t index = 0;
   bool skip_linear_scan = false;
   bool ok = false;
@@ -450,6 +545,24 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
+  } else if (learned_index_ != nullptr) {
+    // The model bounds where the binary search result can be; searching only
+    // that range gives the same result as a full binary search.
+    const Slice user_target =
+        raw_key_.IsUserKey() ? seek_key : ExtractUserKey(seek_key);
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    learned_index_->Predict(LearnedIndex::KeyPrefix(user_target), &begin,
+                            &end);
+    if (value_delta_encoded_) {
+      ok = BinarySeekInRange<DecodeKeyV4>(seek_key,
+                                          static_cast<int64_t>(begin) - 1, end,
+                                          &index, &skip_linear_scan);
+    } else {
+      ok = BinarySeekInRange<DecodeKey>(seek_key,
+                                        static_cast<int64_t>(begin) - 1, end,
+                                        &index, &skip_linear_scan);
+    }
   } else if (value_delta_encoded_) {
     ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
@@ -470,7 +583,10 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = grouped_entry_headers_
+                ? BinarySeek<DecodeGroupedKey>(seek_key, &index,
+                                               &skip_linear_scan)
+                : BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -624,7 +740,9 @@ bool BlockIter<TValue>::ParseNextKey(bool* is_shared) {
 }
 
 bool DataBlockIter::ParseNextDataKey(bool* is_shared) {
-  if (ParseNextKey<DecodeEntry>(is_shared)) {
+  bool ok = grouped_entry_headers_ ? ParseNextKey<DecodeGroupedEntry>(is_shared)
+                                   : ParseNextKey<DecodeEntry>(is_shared);
+  if (ok) {
 #ifndef NDEBUG
     if (global_seqno_ != kDisableGlobalSequenceNumber) {
       // If we are reading a file with a global sequence number we should
@@ -654,7 +772,8 @@ bool IndexBlockIter::ParseNextIndexKey() {
   bool ok = (value_delta_encoded_) ? ParseNextKey<DecodeEntryV4>(&is_shared)
                                    : ParseNextKey<DecodeEntry>(&is_shared);
   if (ok) {
-    if (value_delta_encoded_ || global_seqno_state_ != nullptr) {
+    if (value_delta_encoded_ || fixed_handle_offsets_ != nullptr ||
+        global_seqno_state_ != nullptr) {
       DecodeCurrentValue(is_shared);
     }
   }
@@ -673,6 +792,27 @@ bool IndexBlockIter::ParseNextIndexKey() {
 // Otherwise the format is delta-size = block handle size - size of last block
 // handle.
 void IndexBlockIter::DecodeCurrentValue(bool is_shared) {
+  if (fixed_handle_offsets_ != nullptr) {
+    // Entries carry no inline value. The handle for restart point i is a
+    // plain load from the fixed-stride offset array; the size falls out of
+    // the next offset because data blocks are laid out back to back.
+    assert(!is_shared);  // requires index_block_restart_interval == 1
+    const uint32_t ord = restart_index_;
+    if (is_shared || ord + 1 >= num_fixed_handle_offsets_) {
+      CorruptionError();
+      return;
+    }
+    const uint64_t offset = DecodeFixed64(fixed_handle_offsets_ + ord * 8);
+    const uint64_t next = DecodeFixed64(fixed_handle_offsets_ + ord * 8 + 8);
+    if (next < offset + BlockBasedTable::kBlockTrailerSize) {
+      CorruptionError();
+      return;
+    }
+    decoded_value_.handle =
+        BlockHandle(offset, next - offset - BlockBasedTable::kBlockTrailerSize);
+    decoded_value_.first_internal_key = Slice();
+    return;
+  }
   Slice v(value_.data(), data_ + restarts_ - value_.data());
   // Delta encoding is used if `shared` != 0.
   Status decode_s __attribute__((__unused__)) = decoded_value_.DecodeFrom(
@@ -752,6 +892,21 @@ template <class TValue>
 template <typename DecodeKeyFunc>
 bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
                                    bool* skip_linear_scan) {
+  return BinarySeekInRange<DecodeKeyFunc>(
+      target, /*left=*/-1, static_cast<int64_t>(num_restarts_) - 1, index,
+      skip_linear_scan);
+}
+
+// Same as BinarySeek() above, but with the initial search interval supplied
+// by the caller. The loop invariants below must hold for the initial bounds:
+// the restart key at `left` (with -1 acting as a key smaller than all keys)
+// must be less than or equal to `target`, and all restart keys after `right`
+// must be strictly greater than `target`.
+template <class TValue>
+template <typename DecodeKeyFunc>
+bool BlockIter<TValue>::BinarySeekInRange(const Slice& target, int64_t left,
+                                          int64_t right, uint32_t* index,
+                                          bool* skip_linear_scan) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
     // that have no keys while also having `num_restarts_ == 1`. This would
@@ -763,16 +918,45 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   }
 
   *skip_linear_scan = false;
+
+  // The whole binary search reads from the restart array, so get it in
+  // flight up front. Only bother for arrays up to a few cache lines; for
+  // larger ones the search touches a scattered log2(n) subset and blanket
+  // prefetching would mostly pull in dead lines.
+  const uint32_t restart_array_bytes =
+      num_restarts_ * static_cast<uint32_t>(sizeof(uint32_t));
+  if (restart_array_bytes <= 4 * CACHE_LINE_SIZE) {
+    for (uint32_t off = 0; off < restart_array_bytes;
+         off += CACHE_LINE_SIZE) {
+      PREFETCH(data_ + restarts_ + off, 0 /* rw */, 1 /* locality */);
+    }
+  }
+
+  assert(left >= -1);
+  assert(right < static_cast<int64_t>(num_restarts_));
   // Loop invariants:
   // - Restart key at index `left` is less than or equal to the target key. The
   //   sentinel index `-1` is considered to have a key that is less than all
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
+    if (right - left > 1) {
+      // Prefetch the restart keys at the midpoints of both possible next
+      // halves, so the next iteration's key bytes are on the way while the
+      // current key is decoded and compared. The indexes are clamped into
+      // [0, num_restarts_) rather than checked for usefulness; a wasted
+      // prefetch inside the block is harmless.
+      const int64_t mid_if_larger = mid + (right - mid + 1) / 2;
+      const int64_t mid_if_smaller = std::max<int64_t>(left, 0) +
+                                     (mid - std::max<int64_t>(left, 0)) / 2;
+      PREFETCH(data_ + GetRestartPoint(static_cast<uint32_t>(mid_if_larger)),
+               0 /* rw */, 1 /* locality */);
+      PREFETCH(data_ + GetRestartPoint(static_cast<uint32_t>(mid_if_smaller)),
+               0 /* rw */, 1 /* locality */);
+    }
     uint32_t region_offset = GetRestartPoint(static_cast<uint32_t>(mid));
     uint32_t shared, non_shared;
     const char* key_ptr = DecodeKeyFunc()(
@@ -1053,7 +1237,8 @@ MetaBlockIter* Block::NewMetaIterator(bool block_contents_pinned) {
 DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
                                       SequenceNumber global_seqno,
                                       DataBlockIter* iter, Statistics* stats,
-                                      bool block_contents_pinned) {
+                                      bool block_contents_pinned,
+                                      bool grouped_entry_headers) {
   DataBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1072,7 +1257,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         read_amp_bitmap_.get(), block_contents_pinned,
-        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr);
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
+        grouped_entry_headers);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
@@ -1088,7 +1274,10 @@ IndexBlockIter* Block::NewIndexIterator(
     const Comparator* raw_ucmp, SequenceNumber global_seqno,
     IndexBlockIter* iter, Statistics* /*stats*/, bool total_order_seek,
     bool have_first_key, bool key_includes_seq, bool value_is_full,
-    bool block_contents_pinned, BlockPrefixIndex* prefix_index) {
+    bool block_contents_pinned, BlockPrefixIndex* prefix_index,
+    const LearnedIndex* learned_index, const char* fixed_handle_offsets,
+    uint32_t num_fixed_handle_offsets,
+    const WholeKeyHashIndex* whole_key_hash_index) {
   IndexBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1107,7 +1296,9 @@ IndexBlockIter* Block::NewIndexIterator(
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index;
     ret_iter->Initialize(raw_ucmp, data_, restart_offset_, num_restarts_,
-                         global_seqno, prefix_index_ptr, have_first_key,
+                         global_seqno, prefix_index_ptr, learned_index,
+                         fixed_handle_offsets, num_fixed_handle_offsets,
+                         whole_key_hash_index, have_first_key,
                          key_includes_seq, value_is_full,
                          block_contents_pinned);
   }
@@ -21,7 +21,9 @@
 #include "rocksdb/statistics.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_prefix_index.h"
+#include "table/block_based/learned_index.h"
 #include "table/block_based/data_block_hash_index.h"
+#include "table/block_based/whole_key_hash_index.h"
 #include "table/format.h"
 #include "table/internal_iterator.h"
 #include "test_util/sync_point.h"
@@ -188,11 +190,16 @@ class Block {
   // NOTE: for the hash based lookup, if a key prefix doesn't match any key,
   // the iterator will simply be set as "invalid", rather than returning
   // the key that is just pass the target key.
+  // `grouped_entry_headers` must be true iff the block was written with
+  // group-encoded entry headers (data blocks of format_version >= 6); it is
+  // the caller's job to derive this from the table's footer since blocks do
+  // not self-describe it.
   DataBlockIter* NewDataIterator(const Comparator* raw_ucmp,
                                  SequenceNumber global_seqno,
                                  DataBlockIter* iter = nullptr,
                                  Statistics* stats = nullptr,
-                                 bool block_contents_pinned = false);
+                                 bool block_contents_pinned = false,
+                                 bool grouped_entry_headers = false);
 
   // Returns an MetaBlockIter for iterating over blocks containing metadata
   // (like Properties blocks).  Unlike data blocks, the keys for these blocks
@@ -220,17 +227,34 @@ class Block {
   // If `prefix_index` is not nullptr this block will do hash lookup for the key
   // prefix. If total_order_seek is true, prefix_index_ is ignored.
   //
+  // If `learned_index` is not nullptr, seeks consult the model to narrow the
+  // binary search to a few restart points. Unlike `prefix_index`, the model
+  // returns the same result as a total order seek, so it is never ignored.
+  //
   // `have_first_key` controls whether IndexValue will contain
   // first_internal_key. It affects data serialization format, so the same value
   // have_first_key must be used when writing and reading index.
   // It is determined by IndexType property of the table.
-  IndexBlockIter* NewIndexIterator(const Comparator* raw_ucmp,
-                                   SequenceNumber global_seqno,
-                                   IndexBlockIter* iter, Statistics* stats,
-                                   bool total_order_seek, bool have_first_key,
-                                   bool key_includes_seq, bool value_is_full,
-                                   bool block_contents_pinned = false,
-                                   BlockPrefixIndex* prefix_index = nullptr);
+  //
+  // If `fixed_handle_offsets` is not nullptr, index entries carry no inline
+  // block handle; handles are decoded from this fixed-stride offset array
+  // instead (see IndexBlockIter::fixed_handle_offsets_).
+  //
+  // If `whole_key_hash_index` is not nullptr, seeks first look the target's
+  // user key up in this hash index; a hit lands directly on the matching
+  // index entry and a guaranteed miss invalidates the iterator with a
+  // NotFound status, so it must only be passed for point lookups.
+  // Collisions fall back to binary search.
+  IndexBlockIter* NewIndexIterator(
+      const Comparator* raw_ucmp, SequenceNumber global_seqno,
+      IndexBlockIter* iter, Statistics* stats, bool total_order_seek,
+      bool have_first_key, bool key_includes_seq, bool value_is_full,
+      bool block_contents_pinned = false,
+      BlockPrefixIndex* prefix_index = nullptr,
+      const LearnedIndex* learned_index = nullptr,
+      const char* fixed_handle_offsets = nullptr,
+      uint32_t num_fixed_handle_offsets = 0,
+      const WholeKeyHashIndex* whole_key_hash_index = nullptr);
 
   // Report an approximation of how much memory has been used.
   size_t ApproximateMemoryUsage() const;
@@ -325,6 +349,14 @@ class BlockIter : public InternalIteratorBase<TValue> {
     return key_;
   }
 
+  // Whether the block contains another entry after the current one, i.e.
+  // whether Next() would leave the iterator valid.
+  // REQUIRES: Valid()
+  bool HasNextEntry() const {
+    assert(Valid());
+    return NextEntryOffset() < restarts_;
+  }
+
 #ifndef NDEBUG
   ~BlockIter() override {
     // Assert that the BlockIter is never deleted while Pinning is Enabled.
@@ -436,7 +468,11 @@ class BlockIter : public InternalIteratorBase<TValue> {
   int CompareCurrentKey(const Slice& other) {
     if (raw_key_.IsUserKey()) {
       assert(global_seqno_ == kDisableGlobalSequenceNumber);
-      return icmp_->user_comparator()->Compare(raw_key_.GetUserKey(), other);
+      // Compare through the wrapper so the built-in bytewise comparators
+      // are served inline instead of through the vtable; this is the
+      // comparison in every index- and data-block binary seek.
+      return icmp_->user_comparator_wrapper().Compare(raw_key_.GetUserKey(),
+                                                      other);
     } else if (global_seqno_ == kDisableGlobalSequenceNumber) {
       return icmp_->Compare(raw_key_.GetInternalKey(), other);
     }
@@ -481,6 +517,14 @@ class BlockIter : public InternalIteratorBase<TValue> {
   inline bool BinarySeek(const Slice& target, uint32_t* index,
                          bool* is_index_key_result);
 
+  // Same as BinarySeek() but starts from externally supplied bounds: the
+  // restart key at `left` (or the -1 sentinel) must be less than or equal to
+  // the target, and all restart keys after `right` must be strictly greater.
+  template <typename DecodeKeyFunc>
+  inline bool BinarySeekInRange(const Slice& target, int64_t left,
+                                int64_t right, uint32_t* index,
+                                bool* is_index_key_result);
+
   void FindKeyAfterBinarySeek(const Slice& target, uint32_t index,
                               bool is_index_key_result);
 };
@@ -492,23 +536,27 @@ class DataBlockIter final : public BlockIter<Slice> {
   DataBlockIter(const Comparator* raw_ucmp, const char* data, uint32_t restarts,
                 uint32_t num_restarts, SequenceNumber global_seqno,
                 BlockReadAmpBitmap* read_amp_bitmap, bool block_contents_pinned,
-                DataBlockHashIndex* data_block_hash_index)
+                DataBlockHashIndex* data_block_hash_index,
+                bool grouped_entry_headers = false)
       : DataBlockIter() {
     Initialize(raw_ucmp, data, restarts, num_restarts, global_seqno,
-               read_amp_bitmap, block_contents_pinned, data_block_hash_index);
+               read_amp_bitmap, block_contents_pinned, data_block_hash_index,
+               grouped_entry_headers);
   }
   void Initialize(const Comparator* raw_ucmp, const char* data,
                   uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno,
                   BlockReadAmpBitmap* read_amp_bitmap,
                   bool block_contents_pinned,
-                  DataBlockHashIndex* data_block_hash_index) {
+                  DataBlockHashIndex* data_block_hash_index,
+                  bool grouped_entry_headers = false) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
                    block_contents_pinned);
     raw_key_.SetIsUserKey(false);
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    grouped_entry_headers_ = grouped_entry_headers;
   }
 
   Slice value() const override {
@@ -576,12 +624,23 @@ class DataBlockIter final : public BlockIter<Slice> {
     // value slice pointing to data in block
     Slice value;
   };
+  // Number of restart intervals decoded per cache fill in PrevImpl(). A
+  // larger window amortizes the backward restart scan and the buffer refill
+  // over more Prev() steps, at the cost of decoding entries further ahead
+  // of the cursor than a single Prev() needs.
+  static constexpr uint32_t kNumPrevCacheRestartIntervals = 8;
+
   std::string prev_entries_keys_buff_;
   std::vector<CachedPrevEntry> prev_entries_;
   int32_t prev_entries_idx_ = -1;
 
   DataBlockHashIndex* data_block_hash_index_;
 
+  // True if entry headers are group-encoded (control byte + truncated
+  // little-endian lengths) rather than varints; data blocks written with
+  // format_version >= 6. See the format comment in block_builder.cc.
+  bool grouped_entry_headers_ = false;
+
   bool SeekForGetImpl(const Slice& target);
 };
 
@@ -618,7 +677,8 @@ class MetaBlockIter final : public BlockIter<Slice> {
 
 class IndexBlockIter final : public BlockIter<IndexValue> {
  public:
-  IndexBlockIter() : BlockIter(), prefix_index_(nullptr) {}
+  IndexBlockIter()
+      : BlockIter(), prefix_index_(nullptr), learned_index_(nullptr) {}
 
   // key_includes_seq, default true, means that the keys are in internal key
   // format.
@@ -627,12 +687,20 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   void Initialize(const Comparator* raw_ucmp, const char* data,
                   uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno, BlockPrefixIndex* prefix_index,
+                  const LearnedIndex* learned_index,
+                  const char* fixed_handle_offsets,
+                  uint32_t num_fixed_handle_offsets,
+                  const WholeKeyHashIndex* whole_key_hash_index,
                   bool have_first_key, bool key_includes_seq,
                   bool value_is_full, bool block_contents_pinned) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts,
                    kDisableGlobalSequenceNumber, block_contents_pinned);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    learned_index_ = learned_index;
+    fixed_handle_offsets_ = fixed_handle_offsets;
+    num_fixed_handle_offsets_ = num_fixed_handle_offsets;
+    whole_key_hash_index_ = whole_key_hash_index;
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -649,7 +717,8 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
 
   IndexValue value() const override {
     assert(Valid());
-    if (value_delta_encoded_ || global_seqno_state_ != nullptr) {
+    if (value_delta_encoded_ || fixed_handle_offsets_ != nullptr ||
+        global_seqno_state_ != nullptr) {
       return decoded_value_;
     } else {
       IndexValue entry;
@@ -698,6 +767,21 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   bool value_delta_encoded_;
   bool have_first_key_;  // value includes first_internal_key
   BlockPrefixIndex* prefix_index_;
+  // Optional piecewise linear model over the block's keys; see
+  // learned_index.h. Owned by the index reader that created this iterator.
+  const LearnedIndex* learned_index_;
+  // When non-null, index entries carry no inline value; the handle for the
+  // entry at restart point i is read from this fixed-stride array of
+  // little-endian 8-byte file offsets (with one trailing sentinel offset,
+  // so num_fixed_handle_offsets_ is the entry count plus one). Requires
+  // every entry to be a restart point (index_block_restart_interval == 1).
+  // Owned by the index reader that created this iterator.
+  const char* fixed_handle_offsets_ = nullptr;
+  uint32_t num_fixed_handle_offsets_ = 0;
+  // Optional whole-user-key hash index mapping a key hash to the index
+  // entry holding the key; see whole_key_hash_index.h. Only set for point
+  // lookups. Owned by the index reader that created this iterator.
+  const WholeKeyHashIndex* whole_key_hash_index_ = nullptr;
   // Whether the value is delta encoded. In that case the value is assumed to be
   // BlockHandle. The first value in each restart interval is the full encoded
   // BlockHandle; the restart of encoded size part of the BlockHandle. The
@@ -13,6 +13,7 @@
 #include <stdio.h>
 
 #include <atomic>
+#include <cmath>
 #include <list>
 #include <map>
 #include <memory>
@@ -95,7 +96,8 @@ FilterBlockBuilder* CreateFilterBlockBuilder(
       return new PartitionedFilterBlockBuilder(
           mopt.prefix_extractor.get(), table_opt.whole_key_filtering,
           filter_bits_builder, table_opt.index_block_restart_interval,
-          use_delta_encoding_for_index_values, p_index_builder, partition_size);
+          use_delta_encoding_for_index_values, p_index_builder, partition_size,
+          table_opt.fence_filter_bits_per_key);
     } else {
       return new FullFilterBlockBuilder(mopt.prefix_extractor.get(),
                                         table_opt.whole_key_filtering,
@@ -109,6 +111,32 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
   return compressed_size < raw_size - (raw_size / 8u);
 }
 
+// Estimates the Shannon entropy of a block, in bits per byte, from a byte
+// histogram over a bounded strided sample. This is an upper-bound style
+// estimate: it cannot see cross-byte redundancy, so a low estimate means
+// the block compresses at least that well, while a value close to 8 means
+// the bytes themselves are near-random (e.g. already compressed or
+// encrypted) and a general-purpose compressor will not find much.
+double EstimateEntropyBitsPerByte(const Slice& block) {
+  constexpr size_t kMaxSampleBytes = 2048;
+  const size_t stride =
+      block.size() <= kMaxSampleBytes ? 1 : block.size() / kMaxSampleBytes;
+  uint32_t histogram[256] = {0};
+  size_t num_sampled = 0;
+  for (size_t i = 0; i < block.size(); i += stride) {
+    ++histogram[static_cast<uint8_t>(block[i])];
+    ++num_sampled;
+  }
+  double entropy = 0.0;
+  for (uint32_t count : histogram) {
+    if (count > 0) {
+      double p = static_cast<double>(count) / num_sampled;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
 }  // namespace
 
 // format_version is the block format as defined in include/rocksdb/table.h
@@ -284,6 +312,9 @@ struct BlockBasedTableBuilder::Rep {
   std::vector<std::unique_ptr<CompressionContext>> compression_ctxs;
   std::vector<std::unique_ptr<UncompressionContext>> verify_ctxs;
   std::unique_ptr<UncompressionDict> verify_dict;
+  // Shared with the other output files of the same (sub)compaction; holds
+  // the raw dictionary once one of them has trained it. May be nullptr.
+  std::shared_ptr<std::string> compression_dict_cache;
 
   size_t data_begin_offset = 0;
 
@@ -318,6 +349,9 @@ struct BlockBasedTableBuilder::Rep {
   uint64_t buffer_limit;
   std::shared_ptr<CacheReservationManager>
       compression_dict_buffer_cache_res_mgr;
+  // Effective setting; false when table_options.use_fixed_stride_index_handles
+  // is set but the index type or restart interval does not support it.
+  const bool use_fixed_stride_index_handles;
   const bool use_delta_encoding_for_index_values;
   std::unique_ptr<FilterBlockBuilder> filter_builder;
   OffsetableCacheKey base_cache_key;
@@ -416,8 +450,16 @@ struct BlockBasedTableBuilder::Rep {
                            ->CanKeysWithDifferentByteContentsBeEqual()
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
-                   table_options.data_block_hash_table_util_ratio),
-        range_del_block(1 /* block_restart_interval */),
+                   table_options.data_block_hash_table_util_ratio,
+                   table_options.format_version >= 6),
+        // The range tombstone block is read through DataBlockIter as well,
+        // so it shares the data block entry encoding.
+        range_del_block(
+            1 /* block_restart_interval */, true /* use_delta_encoding */,
+            false /* use_value_delta_encoding */,
+            BlockBasedTableOptions::kDataBlockBinarySearch,
+            0.75 /* data_block_hash_table_util_ratio */,
+            table_options.format_version >= 6),
         internal_prefix_transform(tbo.moptions.prefix_extractor.get()),
         compression_type(tbo.compression_type),
         sample_for_compression(tbo.moptions.sample_for_compression),
@@ -431,16 +473,37 @@ struct BlockBasedTableBuilder::Rep {
         compression_ctxs(tbo.compression_opts.parallel_threads),
         verify_ctxs(tbo.compression_opts.parallel_threads),
         verify_dict(),
-        state((tbo.compression_opts.max_dict_bytes > 0) ? State::kBuffered
-                                                        : State::kUnbuffered),
+        compression_dict_cache(tbo.compression_dict_cache),
+        state((tbo.compression_opts.max_dict_bytes > 0 &&
+               (tbo.compression_dict_cache == nullptr ||
+                tbo.compression_dict_cache->empty()))
+                  ? State::kBuffered
+                  : State::kUnbuffered),
+        use_fixed_stride_index_handles(
+            table_opt.use_fixed_stride_index_handles &&
+            (table_opt.index_type == BlockBasedTableOptions::kBinarySearch ||
+             table_opt.index_type == BlockBasedTableOptions::kLearnedSearch) &&
+            table_opt.index_block_restart_interval == 1),
         use_delta_encoding_for_index_values(table_opt.format_version >= 4 &&
-                                            !table_opt.block_align),
+                                            !table_opt.block_align &&
+                                            !use_fixed_stride_index_handles),
         reason(tbo.reason),
         flush_block_policy(
             table_options.flush_block_policy_factory->NewFlushBlockPolicy(
                 table_options, data_block)),
         status_ok(true),
         io_status_ok(true) {
+    if (compression_opts.max_dict_bytes > 0 && state == State::kUnbuffered &&
+        compression_dict_cache != nullptr) {
+      // An earlier output file of the same (sub)compaction already trained
+      // a dictionary; adopt it so this file skips buffering and training.
+      compression_dict.reset(new CompressionDict(
+          *compression_dict_cache, compression_type, compression_opts.level));
+      verify_dict.reset(new UncompressionDict(
+          *compression_dict_cache,
+          compression_type == kZSTD ||
+              compression_type == kZSTDNotFinalCompression));
+    }
     if (tbo.target_file_size == 0) {
       buffer_limit = compression_opts.max_dict_buffer_bytes;
     } else if (compression_opts.max_dict_buffer_bytes == 0) {
@@ -480,7 +543,7 @@ struct BlockBasedTableBuilder::Rep {
       index_builder.reset(IndexBuilder::CreateIndexBuilder(
           table_options.index_type, &internal_comparator,
           &this->internal_prefix_transform, use_delta_encoding_for_index_values,
-          table_options));
+          use_fixed_stride_index_handles, table_options));
     }
     if (ioptions.optimize_filters_for_hits && tbo.is_bottommost) {
       // Apply optimize_filters_for_hits setting here when applicable by
@@ -496,6 +559,7 @@ struct BlockBasedTableBuilder::Rep {
       FilterBuildingContext filter_context(table_options);
 
       filter_context.info_log = ioptions.logger;
+      filter_context.statistics = ioptions.stats;
       filter_context.column_family_name = tbo.column_family_name;
       filter_context.reason = reason;
 
@@ -1120,7 +1184,21 @@ void BlockBasedTableBuilder::CompressAndVerifyBlock(
       r->ioptions.clock,
       ShouldReportDetailedTime(r->ioptions.env, r->ioptions.stats));
 
-  if (is_status_ok && raw_block_contents.size() < kCompressionSizeLimit) {
+  // Skip compression for data blocks that a cheap entropy estimate says
+  // cannot compress to a useful ratio, e.g. blocks of already-compressed
+  // values. Unlike GoodCompressionRatio() and the verification below,
+  // this rejects a block before paying for its compression, and such
+  // blocks are also served without decompression work later.
+  bool entropy_skip = false;
+  if (is_status_ok && is_data_block && *type != kNoCompression &&
+      r->compression_opts.max_compress_entropy > 0.0 &&
+      raw_block_contents.size() < kCompressionSizeLimit) {
+    entropy_skip = EstimateEntropyBitsPerByte(raw_block_contents) >
+                   r->compression_opts.max_compress_entropy;
+  }
+
+  if (is_status_ok && !entropy_skip &&
+      raw_block_contents.size() < kCompressionSizeLimit) {
     if (is_data_block) {
       r->compressible_input_data_bytes.fetch_add(raw_block_contents.size(),
                                                  std::memory_order_relaxed);
@@ -1195,7 +1273,8 @@ void BlockBasedTableBuilder::CompressAndVerifyBlock(
       }
     }
   } else {
-    // Block is too big to be compressed.
+    // Block is too big to be compressed, or its entropy estimate says
+    // compressing it is not worthwhile.
     if (is_data_block) {
       r->uncompressible_input_data_bytes.fetch_add(raw_block_contents.size(),
                                                    std::memory_order_relaxed);
@@ -1280,6 +1359,11 @@ void BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
       case BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly:
         warm_cache = (r->reason == TableFileCreationReason::kFlush);
         break;
+      case BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction:
+        // Compaction outputs are not inserted wholesale here; CompactionJob
+        // selectively warms the ranges whose input blocks were cached.
+        warm_cache = (r->reason == TableFileCreationReason::kFlush);
+        break;
       case BlockBasedTableOptions::PrepopulateBlockCache::kDisable:
         warm_cache = false;
         break;
@@ -1585,6 +1669,24 @@ void BlockBasedTableBuilder::WriteFilterBlock(
     key.append(rep_->table_options.filter_policy->CompatibilityName());
     meta_index_builder->Add(key, filter_block_handle);
   }
+  if (ok() && is_partitioned_filter) {
+    // Optional whole-file fence filter, in its own meta block. Readers that
+    // do not know about it simply skip the metaindex entry.
+    std::unique_ptr<const char[]> fence_filter_data;
+    Slice fence_filter_content =
+        rep_->filter_builder->FinishFenceFilter(&fence_filter_data);
+    if (!fence_filter_content.empty()) {
+      rep_->props.filter_size += fence_filter_content.size();
+      BlockHandle fence_filter_block_handle;
+      WriteRawBlock(fence_filter_content, kNoCompression,
+                    &fence_filter_block_handle, BlockType::kFilter,
+                    nullptr /*raw_contents*/);
+      if (ok()) {
+        meta_index_builder->Add(BlockBasedTable::kFenceFilterBlockName,
+                                fence_filter_block_handle);
+      }
+    }
+  }
 }
 
 void BlockBasedTableBuilder::WriteIndexBlock(
@@ -1879,6 +1981,12 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
   r->verify_dict.reset(new UncompressionDict(
       dict, r->compression_type == kZSTD ||
                 r->compression_type == kZSTDNotFinalCompression));
+  if (r->compression_dict_cache != nullptr &&
+      r->compression_dict_cache->empty()) {
+    // Publish the dictionary for the remaining output files of this
+    // (sub)compaction.
+    *r->compression_dict_cache = std::move(dict);
+  }
 
   auto get_iterator_for_block = [&r](size_t i) {
     auto& data_block = r->data_block_buffers[i];
@@ -1886,7 +1994,10 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
 
     Block reader{BlockContents{data_block}};
     DataBlockIter* iter = reader.NewDataIterator(
-        r->internal_comparator.user_comparator(), kDisableGlobalSequenceNumber);
+        r->internal_comparator.user_comparator(), kDisableGlobalSequenceNumber,
+        /*iter=*/nullptr, /*stats=*/nullptr,
+        /*block_contents_pinned=*/false,
+        r->table_options.format_version >= 6);
 
     iter->SeekToFirst();
     assert(iter->Valid());
@@ -2094,4 +2205,5 @@ const std::string BlockBasedTable::kObsoleteFilterBlockPrefix = "filter.";
 const std::string BlockBasedTable::kFullFilterBlockPrefix = "fullfilter.";
 const std::string BlockBasedTable::kPartitionedFilterBlockPrefix =
     "partitionedfilter.";
+const std::string BlockBasedTable::kFenceFilterBlockName = "fencefilter";
 }  // namespace ROCKSDB_NAMESPACE
@@ -183,7 +183,10 @@ static std::unordered_map<std::string, BlockBasedTableOptions::IndexType>
         {"kTwoLevelIndexSearch",
          BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch},
         {"kBinarySearchWithFirstKey",
-         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey}};
+         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey},
+        {"kLearnedSearch", BlockBasedTableOptions::IndexType::kLearnedSearch},
+        {"kWholeKeyHashSearch",
+         BlockBasedTableOptions::IndexType::kWholeKeyHashSearch}};
 
 static std::unordered_map<std::string,
                           BlockBasedTableOptions::DataBlockIndexType>
@@ -217,14 +220,20 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"unpartitioned_pinning",
          OptionTypeInfo::Enum<PinningTier>(
              offsetof(struct MetadataCacheOptions, unpartitioned_pinning),
-             &pinning_tier_type_string_map)}};
+             &pinning_tier_type_string_map)},
+        {"adaptive_pinning_min_accesses",
+         {offsetof(struct MetadataCacheOptions, adaptive_pinning_min_accesses),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}}};
 
 static std::unordered_map<std::string,
                           BlockBasedTableOptions::PrepopulateBlockCache>
     block_base_table_prepopulate_block_cache_string_map = {
         {"kDisable", BlockBasedTableOptions::PrepopulateBlockCache::kDisable},
         {"kFlushOnly",
-         BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly}};
+         BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly},
+        {"kFlushAndCompaction",
+         BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction}};
 
 #endif  // ROCKSDB_LITE
 
@@ -299,6 +308,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, index_block_restart_interval),
           OptionType::kInt, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_fixed_stride_index_handles",
+         {offsetof(struct BlockBasedTableOptions,
+                   use_fixed_stride_index_handles),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"index_per_partition",
          {0, OptionType::kUInt64T, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kNone}},
@@ -310,6 +324,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, partition_filters),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"fence_filter_bits_per_key",
+         {offsetof(struct BlockBasedTableOptions, fence_filter_bits_per_key),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"optimize_filters_for_memory",
          {offsetof(struct BlockBasedTableOptions, optimize_filters_for_memory),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -407,6 +425,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, max_auto_readahead_size),
           OptionType::kSizeT, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"async_prefetch_depth",
+         {offsetof(struct BlockBasedTableOptions, async_prefetch_depth),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"prepopulate_block_cache",
          OptionTypeInfo::Enum<BlockBasedTableOptions::PrepopulateBlockCache>(
              offsetof(struct BlockBasedTableOptions, prepopulate_block_cache),
@@ -416,6 +438,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, initial_auto_readahead_size),
           OptionType::kSizeT, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"hot_key_handle_cache_entries",
+         {offsetof(struct BlockBasedTableOptions,
+                   hot_key_handle_cache_entries),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 
 #endif  // ROCKSDB_LITE
 };
@@ -466,9 +493,14 @@ void BlockBasedTableFactory::InitializeOptions() {
   if (table_options_.index_block_restart_interval < 1) {
     table_options_.index_block_restart_interval = 1;
   }
-  if (table_options_.index_type == BlockBasedTableOptions::kHashSearch &&
+  if ((table_options_.index_type == BlockBasedTableOptions::kHashSearch ||
+       table_options_.index_type == BlockBasedTableOptions::kLearnedSearch ||
+       table_options_.index_type ==
+           BlockBasedTableOptions::kWholeKeyHashSearch) &&
       table_options_.index_block_restart_interval != 1) {
-    // Currently kHashSearch is incompatible with index_block_restart_interval > 1
+    // Currently kHashSearch is incompatible with index_block_restart_interval
+    // > 1, and kLearnedSearch and kWholeKeyHashSearch need restart points to
+    // map one-to-one to index entries.
     table_options_.index_block_restart_interval = 1;
   }
   if (table_options_.partition_filters &&
@@ -623,7 +655,8 @@ Status BlockBasedTableFactory::NewTableReader(
       table_reader_options.block_cache_tracer,
       table_reader_options.max_file_size_for_l0_meta_pin,
       table_reader_options.cur_db_session_id,
-      table_reader_options.cur_file_num);
+      table_reader_options.cur_file_num, table_reader_options.tail_size,
+      &uncompression_dict_pool_);
 }
 
 TableBuilder* BlockBasedTableFactory::NewTableBuilder(
@@ -850,12 +883,18 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  use_fixed_stride_index_handles: %d\n",
+           table_options_.use_fixed_stride_index_handles);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  metadata_block_size: %" PRIu64 "\n",
            table_options_.metadata_block_size);
   ret.append(buffer);
   snprintf(buffer, kBufferSize, "  partition_filters: %d\n",
            table_options_.partition_filters);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  fence_filter_bits_per_key: %" PRIu32 "\n",
+           table_options_.fence_filter_bits_per_key);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  use_delta_encoding: %d\n",
            table_options_.use_delta_encoding);
   ret.append(buffer);
@@ -886,6 +925,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
            "  max_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
            table_options_.max_auto_readahead_size);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  async_prefetch_depth: %" ROCKSDB_PRIszt "\n",
+           table_options_.async_prefetch_depth);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  prepopulate_block_cache: %d\n",
            static_cast<int>(table_options_.prepopulate_block_cache));
   ret.append(buffer);
@@ -893,6 +935,10 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
            "  initial_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
            table_options_.initial_auto_readahead_size);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "  hot_key_handle_cache_entries: %" ROCKSDB_PRIszt "\n",
+           table_options_.hot_key_handle_cache_entries);
+  ret.append(buffer);
   return ret;
 }
 
@@ -1041,6 +1087,8 @@ const std::string BlockBasedTablePropertyNames::kPrefixFiltering =
 const std::string kHashIndexPrefixesBlock = "rocksdb.hashindex.prefixes";
 const std::string kHashIndexPrefixesMetadataBlock =
     "rocksdb.hashindex.metadata";
+const std::string kIndexHandleOffsetsBlock = "rocksdb.index.handle.offsets";
+const std::string kWholeKeyHashIndexBlock = "rocksdb.wholekey.hashindex";
 const std::string kPropTrue = "1";
 const std::string kPropFalse = "0";
 
@@ -17,6 +17,7 @@
 #include "port/port.h"
 #include "rocksdb/flush_block_policy.h"
 #include "rocksdb/table.h"
+#include "table/block_based/uncompression_dict_pool.h"
 
 namespace ROCKSDB_NAMESPACE {
 struct ColumnFamilyOptions;
@@ -92,10 +93,15 @@ class BlockBasedTableFactory : public TableFactory {
   BlockBasedTableOptions table_options_;
   std::shared_ptr<CacheReservationManager> table_reader_cache_res_mgr_;
   mutable TailPrefetchStats tail_prefetch_stats_;
+  // Digested uncompression dictionaries deduplicated by content and shared
+  // by all table readers opened through this factory.
+  mutable UncompressionDictPool uncompression_dict_pool_;
 };
 
 extern const std::string kHashIndexPrefixesBlock;
 extern const std::string kHashIndexPrefixesMetadataBlock;
+extern const std::string kIndexHandleOffsetsBlock;
+extern const std::string kWholeKeyHashIndexBlock;
 extern const std::string kPropTrue;
 extern const std::string kPropFalse;
 }  // namespace ROCKSDB_NAMESPACE
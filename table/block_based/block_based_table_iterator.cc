@@ -218,6 +218,31 @@ bool BlockBasedTableIterator::NextAndGetResult(IterateResult* result) {
   return is_valid;
 }
 
+void BlockBasedTableIterator::NextBatch(IterateResultBuffer* buffer) {
+  assert(Valid());
+  buffer->Clear();
+  if (is_at_first_key_from_index_ && !MaterializeCurrentBlock()) {
+    return;
+  }
+  assert(block_iter_points_to_real_block_);
+  buffer->Add(block_iter_.key(), block_iter_.value());
+  // Decode the rest of the block in one go only when the whole block is
+  // known to be within the upper bound; otherwise emit one entry per call
+  // so the per-entry bound handling in FindKeyForward()/CheckOutOfBound()
+  // stays in charge. The walk stops at the last entry of the block, leaving
+  // the iterator valid there, so the block (and the buffered value slices
+  // pointing into it) stays pinned while the caller drains the buffer.
+  if (read_options_.iterate_upper_bound == nullptr ||
+      block_upper_bound_check_ == BlockUpperBound::kUpperBoundBeyondCurBlock) {
+    while (!buffer->Full() && block_iter_.HasNextEntry()) {
+      block_iter_.Next();
+      assert(block_iter_.Valid());
+      buffer->Add(block_iter_.key(), block_iter_.value());
+    }
+  }
+  buffer->Finish();
+}
+
 void BlockBasedTableIterator::Prev() {
   if (is_at_first_key_from_index_) {
     is_at_first_key_from_index_ = false;
@@ -52,6 +52,7 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   void SeekToLast() override;
   void Next() final override;
   bool NextAndGetResult(IterateResult* result) override;
+  void NextBatch(IterateResultBuffer* buffer) override;
   void Prev() override;
   bool Valid() const override {
     return !is_out_of_bound_ &&
@@ -55,6 +55,8 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/hot_key_handle_cache.h"
+#include "table/block_based/learned_index_reader.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -70,6 +72,7 @@
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/hash.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 
@@ -173,6 +176,34 @@ inline bool PrefixExtractorChangedHelper(
   }
 }
 
+// Stable names used as keys by DB::Properties::kBlockCacheHeatmap.
+const char* BlockTypeName(BlockType block_type) {
+  switch (block_type) {
+    case BlockType::kData:
+      return "data";
+    case BlockType::kFilter:
+      return "filter";
+    case BlockType::kFilterPartitionIndex:
+      return "filter_partition_index";
+    case BlockType::kProperties:
+      return "properties";
+    case BlockType::kCompressionDictionary:
+      return "compression_dict";
+    case BlockType::kRangeDeletion:
+      return "range_deletion";
+    case BlockType::kHashIndexPrefixes:
+      return "hash_index_prefixes";
+    case BlockType::kHashIndexMetadata:
+      return "hash_index_metadata";
+    case BlockType::kMetaIndex:
+      return "metaindex";
+    case BlockType::kIndex:
+      return "index";
+    default:
+      return "other";
+  }
+}
+
 }  // namespace
 
 void BlockBasedTable::UpdateCacheHitMetrics(BlockType block_type,
@@ -180,6 +211,9 @@ void BlockBasedTable::UpdateCacheHitMetrics(BlockType block_type,
                                             size_t usage) const {
   Statistics* const statistics = rep_->ioptions.stats;
 
+  rep_->cache_heat[static_cast<size_t>(block_type)].hits.fetch_add(
+      1, std::memory_order_relaxed);
+
   PERF_COUNTER_ADD(block_cache_hit_count, 1);
   PERF_COUNTER_BY_LEVEL_ADD(block_cache_hit_count, 1,
                             static_cast<uint32_t>(rep_->level));
@@ -239,6 +273,9 @@ void BlockBasedTable::UpdateCacheMissMetrics(BlockType block_type,
                                              GetContext* get_context) const {
   Statistics* const statistics = rep_->ioptions.stats;
 
+  rep_->cache_heat[static_cast<size_t>(block_type)].misses.fetch_add(
+      1, std::memory_order_relaxed);
+
   // TODO: introduce aggregate (not per-level) block cache miss count
   PERF_COUNTER_BY_LEVEL_ADD(block_cache_miss_count, 1,
                             static_cast<uint32_t>(rep_->level));
@@ -590,7 +627,8 @@ Status BlockBasedTable::Open(
     TailPrefetchStats* tail_prefetch_stats,
     BlockCacheTracer* const block_cache_tracer,
     size_t max_file_size_for_l0_meta_pin, const std::string& cur_db_session_id,
-    uint64_t cur_file_num) {
+    uint64_t cur_file_num, uint64_t tail_size,
+    UncompressionDictPool* uncompression_dict_pool) {
   table_reader->reset();
 
   Status s;
@@ -614,7 +652,7 @@ Status BlockBasedTable::Open(
   if (!ioptions.allow_mmap_reads) {
     s = PrefetchTail(ro, file.get(), file_size, force_direct_prefetch,
                      tail_prefetch_stats, prefetch_all, preload_all,
-                     &prefetch_buffer);
+                     &prefetch_buffer, tail_size);
     // Return error in prefetch path to users.
     if (!s.ok()) {
       return s;
@@ -655,6 +693,7 @@ Status BlockBasedTable::Open(
                                       file_size, level, immortal_table);
   rep->file = std::move(file);
   rep->footer = footer;
+  rep->uncompression_dict_pool = uncompression_dict_pool;
 
   // For fully portable/stable cache keys, we need to read the properties
   // block before setting up cache keys. TODO: consider setting up a bootstrap
@@ -744,6 +783,12 @@ Status BlockBasedTable::Open(
     }
   }
 
+  if (s.ok() && table_options.hot_key_handle_cache_entries > 0 &&
+      rep->internal_comparator.user_comparator()->timestamp_size() == 0) {
+    rep->hot_key_handle_cache.reset(
+        new HotKeyHandleCache(table_options.hot_key_handle_cache_entries));
+  }
+
   if (s.ok() && table_reader_cache_res_mgr) {
     std::size_t mem_usage = new_table->ApproximateMemoryUsage();
     s = table_reader_cache_res_mgr->MakeCacheReservation(
@@ -768,9 +813,14 @@ Status BlockBasedTable::PrefetchTail(
     const ReadOptions& ro, RandomAccessFileReader* file, uint64_t file_size,
     bool force_direct_prefetch, TailPrefetchStats* tail_prefetch_stats,
     const bool prefetch_all, const bool preload_all,
-    std::unique_ptr<FilePrefetchBuffer>* prefetch_buffer) {
+    std::unique_ptr<FilePrefetchBuffer>* prefetch_buffer, uint64_t tail_size) {
   size_t tail_prefetch_size = 0;
-  if (tail_prefetch_stats != nullptr) {
+  if (tail_size != 0) {
+    // The exact tail size was recorded in the MANIFEST when the file was
+    // created, so there is no need to guess: one read covers precisely the
+    // footer and all the meta blocks.
+    tail_prefetch_size = static_cast<size_t>(tail_size);
+  } else if (tail_prefetch_stats != nullptr) {
     // Multiple threads may get a 0 (no history) when running in parallel,
     // but it will get cleared after the first of them finishes.
     tail_prefetch_size = tail_prefetch_stats->GetSuggestedPrefetchSize();
@@ -1027,6 +1077,36 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     return s;
   }
 
+  // Load the whole-file fence filter, if the file has one (only written for
+  // partitioned filters; absent in files from older versions or when
+  // fence_filter_bits_per_key is 0).
+  if (rep_->filter_type == Rep::FilterType::kPartitionedFilter) {
+    BlockHandle fence_filter_handle;
+    s = FindOptionalMetaBlock(meta_iter, kFenceFilterBlockName,
+                              &fence_filter_handle);
+    if (!s.ok()) {
+      return s;
+    }
+    if (!fence_filter_handle.IsNull()) {
+      BlockContents contents;
+      s = ReadMetaBlock(rep_->file.get(), prefetch_buffer, file_size,
+                        rep_->footer.table_magic_number(), rep_->ioptions,
+                        kFenceFilterBlockName, BlockType::kFilter, &contents);
+      if (!s.ok()) {
+        return s;
+      }
+      const Slice data = contents.data;
+      // Last byte is num_probes; the rest is the FastLocalBloom data.
+      if (data.size() >= 65) {
+        const int num_probes = static_cast<uint8_t>(data[data.size() - 1]);
+        if (num_probes >= 1 && num_probes <= 30) {
+          rep_->fence_filter_data.assign(data.data(), data.size() - 1);
+          rep_->fence_filter_num_probes = static_cast<uint32_t>(num_probes);
+        }
+      }
+    }
+  }
+
   BlockBasedTableOptions::IndexType index_type = rep_->index_type;
 
   const bool use_cache = table_options.cache_index_and_filter_blocks;
@@ -1070,6 +1150,7 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
                 table_options.pin_l0_filter_and_index_blocks_in_cache
                     ? PinningTier::kFlushedAndSimilar
                     : PinningTier::kNone);
+  rep_->partitions_pinned_statically = pin_partition;
 
   // pin the first level of index
   const bool pin_index =
@@ -1339,6 +1420,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
         block->SetCachedValue(block_holder.release(), block_cache,
                               cache_handle);
 
+        rep_->cache_heat[static_cast<size_t>(block_type)].inserts.fetch_add(
+            1, std::memory_order_relaxed);
         UpdateCacheInsertionMetrics(block_type, get_context, charge,
                                     s.IsOkOverwritten(), rep_->ioptions.stats);
       } else {
@@ -1447,6 +1530,8 @@ Status BlockBasedTable::PutDataBlockToCache(
       cached_block->SetCachedValue(block_holder.release(), block_cache,
                                    cache_handle);
 
+      rep_->cache_heat[static_cast<size_t>(block_type)].inserts.fetch_add(
+          1, std::memory_order_relaxed);
       UpdateCacheInsertionMetrics(block_type, get_context, charge,
                                   s.IsOkOverwritten(), rep_->ioptions.stats);
     } else {
@@ -1509,7 +1594,8 @@ DataBlockIter* BlockBasedTable::InitBlockIterator<DataBlockIter>(
     DataBlockIter* input_iter, bool block_contents_pinned) {
   return block->NewDataIterator(rep->internal_comparator.user_comparator(),
                                 rep->get_global_seqno(block_type), input_iter,
-                                rep->ioptions.stats, block_contents_pinned);
+                                rep->ioptions.stats, block_contents_pinned,
+                                rep->footer.format_version() >= 6);
 }
 
 template <>
@@ -1829,8 +1915,9 @@ template Status BlockBasedTable::RetrieveBlock<UncompressionDict>(
 
 BlockBasedTable::PartitionedIndexIteratorState::PartitionedIndexIteratorState(
     const BlockBasedTable* table,
-    UnorderedMap<uint64_t, CachableEntry<Block>>* block_map)
-    : table_(table), block_map_(block_map) {}
+    std::shared_ptr<const UnorderedMap<uint64_t, CachableEntry<Block>>>
+        block_map)
+    : table_(table), block_map_(std::move(block_map)) {}
 
 InternalIteratorBase<IndexValue>*
 BlockBasedTable::PartitionedIndexIteratorState::NewSecondaryIterator(
@@ -2050,6 +2137,86 @@ void BlockBasedTable::FullFilterKeysMayMatch(
   }
 }
 
+bool BlockBasedTable::TryHotKeyHandleCacheGet(const ReadOptions& read_options,
+                                              const Slice& key,
+                                              uint64_t key_fingerprint,
+                                              GetContext* get_context,
+                                              Status* s, bool* matched) const {
+  assert(rep_->hot_key_handle_cache);
+  assert(rep_->internal_comparator.user_comparator()->timestamp_size() == 0);
+  BlockHandle handle;
+  if (!rep_->hot_key_handle_cache->Lookup(key_fingerprint, &handle)) {
+    return false;
+  }
+  // The entry may be torn or aliased (see HotKeyHandleCache), so nothing
+  // about the handle can be trusted until the block behind it has been
+  // validated. First make sure it at least points inside the file; a
+  // garbage handle that passes this check still fails its block checksum.
+  if (handle.offset() + handle.size() + kBlockTrailerSize > rep_->file_size) {
+    return false;
+  }
+  BlockCacheLookupContext lookup_data_block_context{
+      TableReaderCaller::kUserGet, get_context->get_tracing_get_id(),
+      /*get_from_user_specified_snapshot=*/read_options.snapshot != nullptr};
+  DataBlockIter biter;
+  Status tmp_status;
+  NewDataBlockIterator<DataBlockIter>(
+      read_options, handle, &biter, BlockType::kData, get_context,
+      &lookup_data_block_context, /*prefetch_buffer=*/nullptr,
+      /*for_compaction=*/false, /*async_read=*/false, tmp_status);
+  if (!biter.status().ok()) {
+    // Includes the no_io Incomplete case; the index path re-attempts the
+    // read and reports the failure properly.
+    return false;
+  }
+  // Validate that this is exactly the block an index seek for `key` would
+  // land on: the first entry must sort before the key (so the seek cannot
+  // stop at an earlier block) and the last entry at or after it (so the
+  // separator for this block covers the key). Both hold no matter how the
+  // cached handle was produced, so a lookup confined to this block is then
+  // conclusive regardless of torn or aliased cache entries.
+  biter.SeekToFirst();
+  if (!biter.Valid() ||
+      rep_->internal_comparator.Compare(biter.key(), key) >= 0) {
+    return false;
+  }
+  biter.SeekToLast();
+  assert(biter.Valid());
+  if (rep_->internal_comparator.Compare(biter.key(), key) < 0) {
+    return false;
+  }
+  // If the last entry carries the same user key, matching entries may
+  // continue into the next block; only the index path can walk there.
+  if (rep_->internal_comparator.user_comparator_wrapper().Compare(
+          ExtractUserKey(biter.key()), ExtractUserKey(key)) == 0) {
+    return false;
+  }
+  bool may_exist = biter.SeekForGet(key);
+  if (!may_exist) {
+    // As on the index path: a data block hash index miss on the block the
+    // seek lands on means the key is not in the file (timestamps are
+    // excluded at open time).
+    return true;
+  }
+  // From here on, mirror the per-entry scan of the index path. The scan
+  // always terminates within this block: the last entry has a different
+  // user key, so SaveValue returns false no later than that entry.
+  for (; biter.Valid(); biter.Next()) {
+    ParsedInternalKey parsed_key;
+    Status pik_status = ParseInternalKey(biter.key(), &parsed_key,
+                                         false /* log_err_key */);  // TODO
+    if (!pik_status.ok()) {
+      *s = pik_status;
+    }
+    if (!get_context->SaveValue(parsed_key, biter.value(), matched,
+                                biter.IsValuePinned() ? &biter : nullptr)) {
+      break;
+    }
+  }
+  *s = biter.status();
+  return true;
+}
+
 Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
                                               std::vector<Anchor>& anchors) {
   // We iterator the whole index block here. More efficient implementation
@@ -2101,6 +2268,100 @@ Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
   return Status::OK();
 }
 
+Status BlockBasedTable::ApproximateCachedKeyRanges(
+    const ReadOptions& read_options, std::vector<CachedKeyRange>& ranges) {
+  Cache* const block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr) {
+    return Status::OK();
+  }
+  // Walk the whole index block and probe the block cache for each data
+  // block. Same trade-off as in ApproximateKeyAnchors: reading the index
+  // is a small share of the overhead of the compactions this serves.
+  IndexBlockIter iiter_on_stack;
+  auto iiter = NewIndexIterator(
+      read_options, /*disable_prefix_seek=*/false, &iiter_on_stack,
+      /*get_context=*/nullptr, /*lookup_context=*/nullptr);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  bool in_cached_run = false;
+  // User key preceding the current run of cached blocks; empty means the
+  // run starts at the beginning of the file.
+  std::string run_start_key;
+  std::string prev_key;
+  for (iiter->SeekToFirst(); iiter->Valid(); iiter->Next()) {
+    const BlockHandle& bh = iiter->value().handle;
+    CacheKey key = GetCacheKey(rep_->base_cache_key, bh);
+    Cache::Handle* const cache_handle = block_cache->Lookup(key.AsSlice());
+    const bool resident = cache_handle != nullptr;
+    if (resident) {
+      block_cache->Release(cache_handle);
+      if (!in_cached_run) {
+        run_start_key = prev_key;
+        in_cached_run = true;
+      }
+    } else if (in_cached_run) {
+      ranges.emplace_back(run_start_key, prev_key);
+      in_cached_run = false;
+    }
+    prev_key = iiter->user_key().ToString();
+  }
+  if (!iiter->status().ok()) {
+    return iiter->status();
+  }
+  if (in_cached_run) {
+    ranges.emplace_back(run_start_key, prev_key);
+  }
+  return Status::OK();
+}
+
+void BlockBasedTable::GetBlockCacheHeat(
+    std::map<std::string, CacheHeatEntry>* heat) const {
+  assert(heat != nullptr);
+  for (size_t i = 0; i < rep_->cache_heat.size(); i++) {
+    const Rep::CacheHeatCounters& counters = rep_->cache_heat[i];
+    const uint64_t hits = counters.hits.load(std::memory_order_relaxed);
+    const uint64_t misses = counters.misses.load(std::memory_order_relaxed);
+    const uint64_t inserts = counters.inserts.load(std::memory_order_relaxed);
+    if (hits == 0 && misses == 0 && inserts == 0) {
+      continue;
+    }
+    CacheHeatEntry& entry = (*heat)[BlockTypeName(static_cast<BlockType>(i))];
+    entry.hits += hits;
+    entry.misses += misses;
+    entry.inserts += inserts;
+  }
+}
+
+void BlockBasedTable::MaintainAdaptivePinning() {
+  const uint32_t min_accesses =
+      rep_->table_options.metadata_cache_options.adaptive_pinning_min_accesses;
+  if (min_accesses == 0 || rep_->partitions_pinned_statically) {
+    return;
+  }
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr) {
+    return;
+  }
+
+  // The cache is considered under pressure once usage reaches roughly 90%
+  // of capacity; only then are cold partitions unpinned.
+  const size_t capacity = block_cache->GetCapacity();
+  const bool under_pressure =
+      block_cache->GetUsage() >= capacity - capacity / 10;
+
+  const ReadOptions ro;
+  if (rep_->filter) {
+    rep_->filter->MaintainAdaptivePinning(ro, under_pressure, min_accesses);
+  }
+  if (rep_->index_reader) {
+    rep_->index_reader->MaintainAdaptivePinning(ro, under_pressure,
+                                                min_accesses);
+  }
+}
+
 Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
                             GetContext* get_context,
                             const SliceTransform* prefix_extractor,
@@ -2134,6 +2395,26 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
     RecordTick(rep_->ioptions.stats, BLOOM_FILTER_USEFUL);
     PERF_COUNTER_BY_LEVEL_ADD(bloom_filter_useful, 1, rep_->level);
   } else {
+    bool matched = false;  // if such user key matched a key in SST
+    // The hot-key fast path does not write block access trace records, so
+    // stay on the index path while tracing is enabled.
+    HotKeyHandleCache* const hot_key_cache =
+        (block_cache_tracer_ && block_cache_tracer_->is_tracing_enabled())
+            ? nullptr
+            : rep_->hot_key_handle_cache.get();
+    uint64_t key_fingerprint = 0;
+    if (hot_key_cache != nullptr) {
+      key_fingerprint = GetSliceHash64(ExtractUserKey(key));
+      if (TryHotKeyHandleCacheGet(read_options, key, key_fingerprint,
+                                  get_context, &s, &matched)) {
+        if (matched && filter != nullptr) {
+          RecordTick(rep_->ioptions.stats, BLOOM_FILTER_FULL_TRUE_POSITIVE);
+          PERF_COUNTER_BY_LEVEL_ADD(bloom_filter_full_true_positive, 1,
+                                    rep_->level);
+        }
+        return s;
+      }
+    }
     IndexBlockIter iiter_on_stack;
     // if prefix_extractor found in block differs from options, disable
     // BlockPrefixIndex. Only do this check when index_type is kHashSearch.
@@ -2151,7 +2432,6 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
 
     size_t ts_sz =
         rep_->internal_comparator.user_comparator()->timestamp_size();
-    bool matched = false;  // if such user key matched a key in SST
     bool done = false;
     for (iiter->Seek(key); iiter->Valid() && !done; iiter->Next()) {
       IndexValue v = iiter->value();
@@ -2256,6 +2536,11 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
       }
 
       if (done) {
+        if (hot_key_cache != nullptr && matched) {
+          // Remember where this lookup completed so the next Get for the
+          // same key can skip the index seek.
+          hot_key_cache->Insert(key_fingerprint, v.handle);
+        }
         // Avoid the extra Next which is expensive in two-level indexes
         break;
       }
@@ -2421,6 +2706,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kFilterPartitionIndex;
   }
 
+  if (meta_block_name == kFenceFilterBlockName) {
+    return BlockType::kFilter;
+  }
+
   if (meta_block_name == kPropertiesBlockName) {
     return BlockType::kProperties;
   }
@@ -2433,6 +2722,14 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kRangeDeletion;
   }
 
+  if (meta_block_name == kIndexHandleOffsetsBlock) {
+    return BlockType::kIndex;
+  }
+
+  if (meta_block_name == kWholeKeyHashIndexBlock) {
+    return BlockType::kIndex;
+  }
+
   if (meta_block_name == kHashIndexPrefixesBlock) {
     return BlockType::kHashIndexPrefixes;
   }
@@ -2539,17 +2836,27 @@ Status BlockBasedTable::CreateIndexReader(
       FALLTHROUGH_INTENDED;
     case BlockBasedTableOptions::kBinarySearchWithFirstKey: {
       return BinarySearchIndexReader::Create(this, ro, prefetch_buffer,
-                                             use_cache, prefetch, pin,
-                                             lookup_context, index_reader);
+                                             meta_iter, use_cache, prefetch,
+                                             pin, lookup_context, index_reader);
+    }
+    case BlockBasedTableOptions::kLearnedSearch: {
+      return LearnedIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
+                                        use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
+    case BlockBasedTableOptions::kWholeKeyHashSearch: {
+      return WholeKeyHashIndexReader::Create(this, ro, prefetch_buffer,
+                                             meta_iter, use_cache, prefetch,
+                                             pin, lookup_context, index_reader);
     }
     case BlockBasedTableOptions::kHashSearch: {
       if (!rep_->table_prefix_extractor) {
         ROCKS_LOG_WARN(rep_->ioptions.logger,
                        "Missing prefix extractor for hash index. Fall back to"
                        " binary search index.");
-        return BinarySearchIndexReader::Create(this, ro, prefetch_buffer,
-                                               use_cache, prefetch, pin,
-                                               lookup_context, index_reader);
+        return BinarySearchIndexReader::Create(
+            this, ro, prefetch_buffer, meta_iter, use_cache, prefetch, pin,
+            lookup_context, index_reader);
       } else {
         return HashIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
                                        use_cache, prefetch, pin, lookup_context,
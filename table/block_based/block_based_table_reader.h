@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -24,6 +26,7 @@
 #include "table/block_based/block_type.h"
 #include "table/block_based/cachable_entry.h"
 #include "table/block_based/filter_block.h"
+#include "table/block_based/hot_key_handle_cache.h"
 #include "table/block_based/uncompression_dict_reader.h"
 #include "table/format.h"
 #include "table/persistent_cache_options.h"
@@ -69,6 +72,7 @@ class BlockBasedTable : public TableReader {
   static const std::string kObsoleteFilterBlockPrefix;
   static const std::string kFullFilterBlockPrefix;
   static const std::string kPartitionedFilterBlockPrefix;
+  static const std::string kFenceFilterBlockName;
 
   // All the below fields control iterator readahead
   static const int kMinNumFileReadsToStartAutoReadahead = 2;
@@ -111,7 +115,9 @@ class BlockBasedTable : public TableReader {
       TailPrefetchStats* tail_prefetch_stats = nullptr,
       BlockCacheTracer* const block_cache_tracer = nullptr,
       size_t max_file_size_for_l0_meta_pin = 0,
-      const std::string& cur_db_session_id = "", uint64_t cur_file_num = 0);
+      const std::string& cur_db_session_id = "", uint64_t cur_file_num = 0,
+      uint64_t tail_size = 0,
+      UncompressionDictPool* uncompression_dict_pool = nullptr);
 
   bool PrefixRangeMayMatch(const Slice& internal_key,
                            const ReadOptions& read_options,
@@ -171,6 +177,15 @@ class BlockBasedTable : public TableReader {
   Status ApproximateKeyAnchors(const ReadOptions& read_options,
                                std::vector<Anchor>& anchors) override;
 
+  Status ApproximateCachedKeyRanges(
+      const ReadOptions& read_options,
+      std::vector<CachedKeyRange>& ranges) override;
+
+  void GetBlockCacheHeat(
+      std::map<std::string, CacheHeatEntry>* heat) const override;
+
+  void MaintainAdaptivePinning() override;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
@@ -223,6 +238,14 @@ class BlockBasedTable : public TableReader {
                                      bool /* pin */) {
       return Status::OK();
     }
+
+    // Adaptively pin or unpin the dependencies based on how often they were
+    // accessed since the previous call; see
+    // MetadataCacheOptions::adaptive_pinning_min_accesses. Called
+    // periodically from a single maintenance thread.
+    virtual void MaintainAdaptivePinning(const ReadOptions& /*ro*/,
+                                         bool /*under_pressure*/,
+                                         uint32_t /*min_accesses*/) {}
   };
 
   class IndexReaderCommon;
@@ -460,6 +483,17 @@ class BlockBasedTable : public TableReader {
                              BlockCacheLookupContext* lookup_context,
                              Env::IOPriority rate_limiter_priority) const;
 
+  // Tries to serve a point lookup directly from the data block recorded in
+  // rep_->hot_key_handle_cache, bypassing the index iterator. Returns true
+  // iff the lookup was fully resolved, in which case get_context, *matched
+  // and *s carry the final outcome. Returns false with no side effects on
+  // get_context when the regular index path must run instead (cache miss,
+  // unvalidatable handle, or the key may span into a following block).
+  bool TryHotKeyHandleCacheGet(const ReadOptions& read_options,
+                               const Slice& key, uint64_t key_fingerprint,
+                               GetContext* get_context, Status* s,
+                               bool* matched) const;
+
   void FullFilterKeysMayMatch(FilterBlockReader* filter, MultiGetRange* range,
                               const bool no_io,
                               const SliceTransform* prefix_extractor,
@@ -472,7 +506,8 @@ class BlockBasedTable : public TableReader {
       const ReadOptions& ro, RandomAccessFileReader* file, uint64_t file_size,
       bool force_direct_prefetch, TailPrefetchStats* tail_prefetch_stats,
       const bool prefetch_all, const bool preload_all,
-      std::unique_ptr<FilePrefetchBuffer>* prefetch_buffer);
+      std::unique_ptr<FilePrefetchBuffer>* prefetch_buffer,
+      uint64_t tail_size);
   Status ReadMetaIndexBlock(const ReadOptions& ro,
                             FilePrefetchBuffer* prefetch_buffer,
                             std::unique_ptr<Block>* metaindex_block,
@@ -538,14 +573,18 @@ class BlockBasedTable::PartitionedIndexIteratorState
  public:
   PartitionedIndexIteratorState(
       const BlockBasedTable* table,
-      UnorderedMap<uint64_t, CachableEntry<Block>>* block_map);
+      std::shared_ptr<const UnorderedMap<uint64_t, CachableEntry<Block>>>
+          block_map);
   InternalIteratorBase<IndexValue>* NewSecondaryIterator(
       const BlockHandle& index_value) override;
 
  private:
   // Don't own table_
   const BlockBasedTable* table_;
-  UnorderedMap<uint64_t, CachableEntry<Block>>* block_map_;
+  // Shares ownership of the map so the pinned partitions stay alive for the
+  // lifetime of the iterator even if the index reader unpins them.
+  std::shared_ptr<const UnorderedMap<uint64_t, CachableEntry<Block>>>
+      block_map_;
 };
 
 // Stores all the properties associated with a BlockBasedTable.
@@ -586,6 +625,12 @@ struct BlockBasedTable::Rep {
   std::unique_ptr<FilterBlockReader> filter;
   std::unique_ptr<UncompressionDictReader> uncompression_dict_reader;
 
+  // Maps user key fingerprints to the data block where the last point
+  // lookup for that key completed, so hot keys can skip the index seek
+  // (see BlockBasedTableOptions::hot_key_handle_cache_entries). nullptr
+  // when disabled or when the comparator has user-defined timestamps.
+  std::unique_ptr<HotKeyHandleCache> hot_key_handle_cache;
+
   enum class FilterType {
     kNoFilter,
     kFullFilter,
@@ -595,6 +640,14 @@ struct BlockBasedTable::Rep {
   BlockHandle filter_handle;
   BlockHandle compression_dict_handle;
 
+  // Whole-file fence filter (see
+  // BlockBasedTableOptions::fence_filter_bits_per_key), copied out of its
+  // meta block at open time and kept in table reader memory rather than
+  // block cache, since it is tiny and consulted on every filter query.
+  // Empty when the file has no fence filter.
+  std::string fence_filter_data;
+  uint32_t fence_filter_num_probes = 0;
+
   std::shared_ptr<const TableProperties> table_properties;
   BlockBasedTableOptions::IndexType index_type;
   bool whole_key_filtering;
@@ -627,6 +680,11 @@ struct BlockBasedTable::Rep {
   // still work, just not as quickly.
   bool blocks_definitely_zstd_compressed = false;
 
+  // Content-deduplicated pool of digested uncompression dictionaries shared
+  // with the other table readers opened through the same factory; may be
+  // nullptr. Outlives the reader since the factory owns it.
+  UncompressionDictPool* uncompression_dict_pool = nullptr;
+
   // These describe how index is encoded.
   bool index_has_first_key = false;
   bool index_key_includes_seq = true;
@@ -634,6 +692,23 @@ struct BlockBasedTable::Rep {
 
   const bool immortal_table;
 
+  // Whether metadata partitions were pinned at open time by the pinning
+  // tiers; such readers are not managed by adaptive pinning.
+  bool partitions_pinned_statically = false;
+
+  // Cumulative block cache hit/miss/insert counters for this table, indexed
+  // by BlockType. Maintained with relaxed atomics so they are cheap enough
+  // to keep unconditionally; aggregated across a column family's live
+  // tables by DB::Properties::kBlockCacheHeatmap.
+  struct CacheHeatCounters {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> inserts{0};
+  };
+  mutable std::array<CacheHeatCounters,
+                     static_cast<size_t>(BlockType::kInvalid) + 1>
+      cache_heat{};
+
   std::unique_ptr<CacheReservationManager::CacheReservationHandle>
       table_reader_cache_res_handle = nullptr;
 
@@ -670,7 +745,7 @@ struct BlockBasedTable::Rep {
         readahead_size, max_readahead_size,
         !ioptions.allow_mmap_reads /* enable */, false /* track_min_offset */,
         implicit_auto_readahead, num_file_reads, ioptions.fs.get(),
-        ioptions.clock, ioptions.stats));
+        ioptions.clock, ioptions.stats, table_options.async_prefetch_depth));
   }
 
   void CreateFilePrefetchBufferIfNotExists(
@@ -690,6 +765,9 @@ struct BlockBasedTable::Rep {
 #else
     usage += sizeof(*this);
 #endif  // ROCKSDB_MALLOC_USABLE_SIZE
+    if (hot_key_handle_cache) {
+      usage += hot_key_handle_cache->ApproximateMemoryUsage();
+    }
     return usage;
   }
 };
@@ -66,6 +66,10 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
   const bool use_shared_buffer = file->use_direct_io() || scratch != nullptr;
 
   autovector<FSReadRequest, MultiGetContext::MAX_BATCH_SIZE> read_reqs;
+  // Per-request buffers for the non-shared-buffer mode, allocated through
+  // the cache's allocator so an uncompressed block can be handed straight
+  // to the block cache without another copy. Parallel to read_reqs.
+  autovector<CacheAllocationPtr, MultiGetContext::MAX_BATCH_SIZE> block_bufs;
   size_t buf_offset = 0;
   size_t idx_in_batch = 0;
 
@@ -105,7 +109,8 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
           req.scratch = scratch + buf_offset;
           buf_offset += req.len;
         } else {
-          req.scratch = new char[req.len];
+          block_bufs.emplace_back(AllocateBlock(req.len, memory_allocator));
+          req.scratch = block_bufs.back().get();
         }
         read_reqs.emplace_back(req);
       }
@@ -130,7 +135,8 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     } else if (use_shared_buffer) {
       req.scratch = scratch + buf_offset;
     } else {
-      req.scratch = new char[req.len];
+      block_bufs.emplace_back(AllocateBlock(req.len, memory_allocator));
+      req.scratch = block_bufs.back().get();
     }
     read_reqs.emplace_back(req);
   }
@@ -198,8 +204,8 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
         assert(req.result.data() == req.scratch);
         assert(req.result.size() == BlockSizeWithTrailer(handle));
         assert(req_offset == 0);
-        std::unique_ptr<char[]> raw_block(req.scratch);
-        raw_block_contents = BlockContents(std::move(raw_block), handle.size());
+        raw_block_contents =
+            BlockContents(std::move(block_bufs[req_idx]), handle.size());
       } else {
         // We used the scratch buffer or direct io buffer
         // which are shared by the blocks.
@@ -225,8 +231,8 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
         TEST_SYNC_POINT_CALLBACK("RetrieveMultipleBlocks:VerifyChecksum", &s);
       }
     } else if (!use_shared_buffer) {
-      // Free the allocated scratch buffer.
-      delete[] req.scratch;
+      // Free the allocated buffer; this block will not be used.
+      block_bufs[req_idx].reset();
     }
 
     if (s.ok()) {
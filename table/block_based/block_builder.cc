@@ -26,6 +26,16 @@
 //     value: char[value_length]
 // shared_bytes == 0 for restart points.
 //
+// With use_grouped_entry_headers (data blocks of format_version >= 6), the
+// three varints are replaced by a control byte followed by the three values
+// as little-endian integers truncated to 1-4 bytes each:
+//     control: char (2 bits of byte width minus one per value)
+//     shared_bytes: uintLE[1-4]
+//     unshared_bytes: uintLE[1-4]
+//     value_length: uintLE[1-4]
+// This is byte-aligned and decodes without data-dependent branches; see
+// DecodeGroupedEntry in block.cc.
+//
 // The trailer of the block has the form:
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
@@ -42,17 +52,54 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+
+// Number of bytes needed to store `v` as a little-endian truncated integer.
+inline size_t GroupedByteWidth(uint32_t v) {
+  return 1 + (v > 0xffu) + (v > 0xffffu) + (v > 0xffffffu);
+}
+
+// Appends the grouped entry header for (shared, non_shared, value_size):
+// one control byte carrying the byte width of each value, then the values
+// themselves as little-endian integers truncated to their widths.
+inline void PutGroupedEntryHeader(std::string* buffer, uint32_t shared,
+                                  uint32_t non_shared, uint32_t value_size) {
+  const size_t w_shared = GroupedByteWidth(shared);
+  const size_t w_non_shared = GroupedByteWidth(non_shared);
+  const size_t w_value = GroupedByteWidth(value_size);
+  // 1 control byte + up to 3 * 4 value bytes. Each EncodeFixed32 below
+  // writes a full 4 bytes; advancing by the truncated width lets the next
+  // field overwrite the unused high (zero) bytes.
+  char tmp[13];
+  tmp[0] = static_cast<char>((w_shared - 1) | ((w_non_shared - 1) << 2) |
+                             ((w_value - 1) << 4));
+  char* p = tmp + 1;
+  EncodeFixed32(p, shared);
+  p += w_shared;
+  EncodeFixed32(p, non_shared);
+  p += w_non_shared;
+  EncodeFixed32(p, value_size);
+  p += w_value;
+  buffer->append(tmp, p - tmp);
+}
+
+}  // namespace
+
 BlockBuilder::BlockBuilder(
     int block_restart_interval, bool use_delta_encoding,
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    double data_block_hash_table_util_ratio)
+    double data_block_hash_table_util_ratio, bool use_grouped_entry_headers)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
+      use_grouped_entry_headers_(use_grouped_entry_headers),
       restarts_(1, 0),  // First restart point is at offset 0
       counter_(0),
       finished_(false) {
+  // Value delta encoding is an index block format; grouped entry headers
+  // are a data block format. They never apply to the same block.
+  assert(!(use_value_delta_encoding_ && use_grouped_entry_headers_));
   switch (index_type) {
     case BlockBasedTableOptions::kDataBlockBinarySearch:
       break;
@@ -198,7 +245,12 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
 
   const size_t non_shared = key.size() - shared;
 
-  if (use_value_delta_encoding_) {
+  if (use_grouped_entry_headers_) {
+    // Add "<control><shared><non_shared><value_size>" to buffer_
+    PutGroupedEntryHeader(&buffer_, static_cast<uint32_t>(shared),
+                          static_cast<uint32_t>(non_shared),
+                          static_cast<uint32_t>(value.size()));
+  } else if (use_value_delta_encoding_) {
     // Add "<shared><non_shared>" to buffer_
     PutVarint32Varint32(&buffer_, static_cast<uint32_t>(shared),
                         static_cast<uint32_t>(non_shared));
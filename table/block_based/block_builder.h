@@ -27,7 +27,8 @@ class BlockBuilder {
                         bool use_value_delta_encoding = false,
                         BlockBasedTableOptions::DataBlockIndexType index_type =
                             BlockBasedTableOptions::kDataBlockBinarySearch,
-                        double data_block_hash_table_util_ratio = 0.75);
+                        double data_block_hash_table_util_ratio = 0.75,
+                        bool use_grouped_entry_headers = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -85,6 +86,9 @@ class BlockBuilder {
   const bool use_delta_encoding_;
   // Refer to BlockIter::DecodeCurrentValue for format of delta encoded values
   const bool use_value_delta_encoding_;
+  // Control-byte entry headers instead of varints (data blocks of
+  // format_version >= 6); see the format comment in block_builder.cc
+  const bool use_grouped_entry_headers_;
 
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
@@ -184,6 +184,68 @@ void CheckBlockContents(BlockContents contents, const int max_key,
 }
 
 // In this test case, no two key share same prefix.
+TEST_F(BlockTest, GroupedEntryHeaders) {
+  Random rnd(301);
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBuilder builder(16, true /* use_delta_encoding */,
+                       false /* use_value_delta_encoding */,
+                       BlockBasedTableOptions::kDataBlockBinarySearch,
+                       0.75 /* data_block_hash_table_util_ratio */,
+                       true /* use_grouped_entry_headers */);
+  int num_records = 10000;
+
+  GenerateRandomKVs(&keys, &values, 0, num_records);
+  // Use value sizes crossing the 1-byte and 2-byte length boundaries so
+  // several control byte combinations are exercised.
+  for (int i = 0; i < num_records; i++) {
+    if (i % 7 == 0) {
+      values[i] = rnd.RandomString(300 + rnd.Uniform(400));
+    } else if (i % 3 == 0) {
+      values[i] = rnd.RandomString(rnd.Uniform(10));
+    }
+    builder.Add(keys[i], values[i]);
+  }
+
+  Slice rawblock = builder.Finish();
+
+  BlockContents contents;
+  contents.data = rawblock;
+  Block reader(std::move(contents));
+
+  // Forward scan.
+  int count = 0;
+  DataBlockIter *iter = reader.NewDataIterator(
+      options.comparator, kDisableGlobalSequenceNumber, nullptr /* iter */,
+      nullptr /* stats */, false /* block_contents_pinned */,
+      true /* grouped_entry_headers */);
+  for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+    ASSERT_EQ(iter->key().ToString(), keys[count]);
+    ASSERT_EQ(iter->value().ToString(), values[count]);
+  }
+  ASSERT_EQ(count, num_records);
+
+  // Backward scan.
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+    --count;
+    ASSERT_EQ(iter->key().ToString(), keys[count]);
+    ASSERT_EQ(iter->value().ToString(), values[count]);
+  }
+  ASSERT_EQ(count, 0);
+
+  // Random seeks, exercising the binary search decode path.
+  for (int i = 0; i < num_records; i++) {
+    int index = rnd.Uniform(num_records);
+    iter->Seek(Slice(keys[index]));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key().ToString(), keys[index]);
+    ASSERT_EQ(iter->value().ToString(), values[index]);
+  }
+  delete iter;
+}
+
 TEST_F(BlockTest, SimpleIndexHash) {
   const int kMaxKey = 100000;
   std::vector<std::string> keys;
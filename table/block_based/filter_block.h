@@ -85,6 +85,16 @@ class FilterBlockBuilder {
   virtual Status MaybePostVerifyFilter(const Slice& /* filter_content */) {
     return Status::OK();
   }
+
+  // If the builder also maintains a whole-file "fence" filter (see
+  // BlockBasedTableOptions::fence_filter_bits_per_key), generate it and
+  // return its contents, transferring ownership of the underlying data to
+  // filter_data. Returns an empty Slice when no fence filter was built.
+  // Called at most once, after the last call to Finish.
+  virtual Slice FinishFenceFilter(
+      std::unique_ptr<const char[]>* /* filter_data */) {
+    return Slice();
+  }
 };
 
 // A FilterBlockReader is used to parse filter from SST table.
@@ -168,6 +178,14 @@ class FilterBlockReader {
     return Status::OK();
   }
 
+  // Adaptively pin or unpin the dependencies based on how often they were
+  // accessed since the previous call; see
+  // MetadataCacheOptions::adaptive_pinning_min_accesses. Called periodically
+  // from a single maintenance thread.
+  virtual void MaintainAdaptivePinning(const ReadOptions& /*ro*/,
+                                       bool /*under_pressure*/,
+                                       uint32_t /*min_accesses*/) {}
+
   virtual bool RangeMayExist(const Slice* /*iterate_upper_bound*/,
                              const Slice& user_key_without_ts,
                              const SliceTransform* prefix_extractor,
@@ -19,10 +19,13 @@
 #include "cache/cache_entry_roles.h"
 #include "cache/cache_reservation_manager.h"
 #include "logging/logging.h"
+#include "monitoring/perf_context_imp.h"
 #include "port/lang.h"
+#include "port/port.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/slice.h"
+#include "rocksdb/statistics.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/filter_policy_internal.h"
@@ -530,23 +533,36 @@ class FastLocalBloomBitsReader : public BuiltinFilterBitsReader {
     uint32_t byte_offset;
     FastLocalBloomImpl::PrepareHash(Lower32of64(h), len_bytes_, data_,
                                     /*out*/ &byte_offset);
+    // All probes for a key land in one prefetched cache line
+    PERF_COUNTER_ADD(filter_cachelines_touched, 1);
     return FastLocalBloomImpl::HashMayMatchPrepared(Upper32of64(h), num_probes_,
                                                     data_ + byte_offset);
   }
 
   virtual void MayMatch(int num_keys, Slice** keys, bool* may_match) override {
-    std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> hashes;
-    std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> byte_offsets;
-    for (int i = 0; i < num_keys; ++i) {
-      uint64_t h = GetSliceHash64(*keys[i]);
-      FastLocalBloomImpl::PrepareHash(Lower32of64(h), len_bytes_, data_,
-                                      /*out*/ &byte_offsets[i]);
-      hashes[i] = Upper32of64(h);
-    }
+    std::array<uint64_t, MultiGetContext::MAX_BATCH_SIZE> hashes;
+    GetSliceHashes64(keys, num_keys, hashes.data());
+    MayMatch(num_keys, keys, hashes.data(), may_match);
+  }
+
+  void MayMatch(int num_keys, Slice** /*keys*/, const uint64_t* hashes,
+                bool* may_match) override {
+    std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> lower_hashes;
+    std::array<uint32_t, MultiGetContext::MAX_BATCH_SIZE> upper_hashes;
     for (int i = 0; i < num_keys; ++i) {
-      may_match[i] = FastLocalBloomImpl::HashMayMatchPrepared(
-          hashes[i], num_probes_, data_ + byte_offsets[i]);
+      lower_hashes[i] = Lower32of64(hashes[i]);
+      upper_hashes[i] = Upper32of64(hashes[i]);
     }
+    PERF_COUNTER_ADD(filter_cachelines_touched, num_keys);
+    PERF_COUNTER_ADD(filter_prepared_probes_reused, num_keys);
+    // Software-pipelined: prefetches a couple of keys ahead of the one
+    // being tested, rather than issuing all prefetches up front and
+    // risking the earliest lines being evicted before their turn in
+    // large batches.
+    FastLocalBloomImpl::HashMayMatchPipelined(lower_hashes.data(),
+                                              upper_hashes.data(), num_keys,
+                                              len_bytes_, num_probes_, data_,
+                                              may_match);
   }
 
   bool HashMayMatch(const uint64_t h) override {
@@ -584,17 +600,28 @@ struct Standard128RibbonRehasherTypesAndSettings {
 using Standard128RibbonTypesAndSettings =
     ribbon::StandardRehasherAdapter<Standard128RibbonRehasherTypesAndSettings>;
 
+// Shard routing for sharded (multi-threaded construction) Ribbon filters.
+// The hash is remixed so that the bits consumed here are effectively
+// independent of the bits the in-shard Ribbon hashing consumes.
+inline uint32_t RibbonShardOfHash(uint64_t h, int log2_shards) {
+  assert(log2_shards >= 1 && log2_shards <= 6);
+  return static_cast<uint32_t>((h * uint64_t{0x9E3779B97F4A7C15U}) >>
+                               (64 - log2_shards));
+}
+
 class Standard128RibbonBitsBuilder : public XXPH3FilterBitsBuilder {
  public:
   explicit Standard128RibbonBitsBuilder(
       double desired_one_in_fp_rate, int bloom_millibits_per_key,
       std::atomic<int64_t>* aggregate_rounding_balance,
       std::shared_ptr<CacheReservationManager> cache_res_mgr,
-      bool detect_filter_construct_corruption, Logger* info_log)
+      bool detect_filter_construct_corruption, Logger* info_log,
+      int construction_threads = 1)
       : XXPH3FilterBitsBuilder(aggregate_rounding_balance, cache_res_mgr,
                                detect_filter_construct_corruption),
         desired_one_in_fp_rate_(desired_one_in_fp_rate),
         info_log_(info_log),
+        construction_threads_(std::max(1, std::min(construction_threads, 64))),
         bloom_fallback_(bloom_millibits_per_key, aggregate_rounding_balance,
                         cache_res_mgr, detect_filter_construct_corruption) {
     assert(desired_one_in_fp_rate >= 1.0);
@@ -644,6 +671,12 @@ class Standard128RibbonBitsBuilder : public XXPH3FilterBitsBuilder {
       return bloom_fallback_.Finish(buf, status);
     }
 
+    // Multi-threaded construction of large filters, when configured
+    uint32_t num_shards = ChooseNumShards(num_entries);
+    if (num_shards > 1) {
+      return FinishSharded(num_shards, buf, status);
+    }
+
     uint32_t entropy = 0;
     if (!hash_entries_info_.entries.empty()) {
       entropy = Lower32of64(hash_entries_info_.entries.front());
@@ -762,6 +795,180 @@ class Standard128RibbonBitsBuilder : public XXPH3FilterBitsBuilder {
     return rv;
   }
 
+  // Number of sub-filter shards for multi-threaded construction: a power
+  // of two bounded by the configured construction threads and by keeping
+  // shards large enough that per-shard overhead stays negligible.
+  // 1 means use the standard single-band format.
+  uint32_t ChooseNumShards(uint32_t num_entries) const {
+    uint32_t limit = std::min(static_cast<uint32_t>(construction_threads_),
+                              num_entries / kMinShardEntries);
+    if (limit < 2) {
+      return 1;
+    }
+    return uint32_t{1} << FloorLog2(limit);
+  }
+
+  // Sharded construction: keys are split by (remixed) hash into
+  // independent Ribbon sub-bands built concurrently and concatenated,
+  // written under a distinct metadata marker (-3). See
+  // BuiltinFilterPolicy::GetShardedRibbonBitsReader for the layout.
+  Slice FinishSharded(uint32_t num_shards, std::unique_ptr<const char[]>* buf,
+                      Status* status) {
+    assert(num_shards >= 2 && (num_shards & (num_shards - 1)) == 0);
+    const int log2_shards = FloorLog2(num_shards);
+
+    TEST_SYNC_POINT_CALLBACK(
+        "XXPH3FilterBitsBuilder::Finish::"
+        "TamperHashEntries",
+        &hash_entries_info_.entries);
+
+    std::vector<std::vector<uint64_t>> shard_entries(num_shards);
+    for (auto& entries : shard_entries) {
+      entries.reserve(hash_entries_info_.entries.size() / num_shards + 16);
+    }
+    for (uint64_t h : hash_entries_info_.entries) {
+      shard_entries[RibbonShardOfHash(h, log2_shards)].push_back(h);
+    }
+
+    // Per-shard sizing
+    std::vector<uint32_t> shard_slots(num_shards);
+    std::vector<size_t> shard_lens(num_shards);
+    std::vector<size_t> shard_offsets(num_shards);
+    size_t data_len = 0;
+    std::size_t bytes_banding = 0;
+    for (uint32_t i = 0; i < num_shards; ++i) {
+      uint32_t count = static_cast<uint32_t>(shard_entries[i].size());
+      // The reader requires >= 2 blocks (256 slots) per shard
+      uint32_t ns = std::max(NumEntriesToNumSlots(count), uint32_t{256});
+      uint32_t rounding =
+          shard_entries[i].empty() ? 0 : Upper32of64(shard_entries[i].front());
+      shard_slots[i] = ns;
+      shard_offsets[i] = data_len;
+      shard_lens[i] = SolnType::GetBytesForOneInFpRate(
+          ns, desired_one_in_fp_rate_, rounding);
+      data_len += shard_lens[i];
+      bytes_banding += BandingType::EstimateMemoryUsage(ns);
+    }
+    const size_t len_with_metadata =
+        data_len + size_t{num_shards} * kShardDirEntryLen + kMetadataLen;
+
+    // Cache charging for the bandings, which are all live concurrently
+    std::unique_ptr<CacheReservationManager::CacheReservationHandle>
+        banding_res_handle;
+    if (cache_res_mgr_) {
+      Status st = cache_res_mgr_->MakeCacheReservation(bytes_banding,
+                                                       &banding_res_handle);
+      if (st.IsMemoryLimit()) {
+        ROCKS_LOG_WARN(info_log_,
+                       "Cache charging for Ribbon filter banding failed due "
+                       "to cache full");
+        SwapEntriesWith(&bloom_fallback_);
+        assert(hash_entries_info_.entries.empty());
+        banding_res_handle.reset();
+        return bloom_fallback_.Finish(buf, status);
+      }
+    }
+
+    std::unique_ptr<char[]> mutable_buf(new char[len_with_metadata]());
+    std::vector<uint32_t> shard_seeds(num_shards, 0);
+    std::vector<uint32_t> shard_blocks(num_shards, 0);
+    std::atomic<uint32_t> next_shard{0};
+    std::atomic<bool> any_failed{false};
+    auto build_shards = [&]() {
+      for (uint32_t i = next_shard.fetch_add(1); i < num_shards;
+           i = next_shard.fetch_add(1)) {
+        uint32_t entropy = shard_entries[i].empty()
+                               ? 0
+                               : Lower32of64(shard_entries[i].front());
+        BandingType banding;
+        if (!banding.ResetAndFindSeedToSolve(
+                shard_slots[i], shard_entries[i].begin(),
+                shard_entries[i].end(), entropy & 255, 255)) {
+          any_failed.store(true, std::memory_order_relaxed);
+          continue;
+        }
+        SolnType soln(mutable_buf.get() + shard_offsets[i], shard_lens[i]);
+        soln.BackSubstFrom(banding);
+        shard_blocks[i] = soln.GetNumBlocks();
+        shard_seeds[i] = banding.GetOrdinalSeed();
+      }
+    };
+    {
+      int helpers =
+          std::min(construction_threads_, static_cast<int>(num_shards)) - 1;
+      std::vector<port::Thread> threads;
+      threads.reserve(helpers);
+      for (int t = 0; t < helpers; ++t) {
+        threads.emplace_back(build_shards);
+      }
+      build_shards();
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    if (any_failed.load(std::memory_order_relaxed)) {
+      ROCKS_LOG_WARN(
+          info_log_, "Too many re-seeds (256) for sharded Ribbon filter, %llu",
+          static_cast<unsigned long long>(hash_entries_info_.entries.size()));
+      SwapEntriesWith(&bloom_fallback_);
+      assert(hash_entries_info_.entries.empty());
+      return bloom_fallback_.Finish(buf, status);
+    }
+
+    Status verify_hash_entries_checksum_status =
+        MaybeVerifyHashEntriesChecksum();
+    if (!verify_hash_entries_checksum_status.ok()) {
+      ROCKS_LOG_WARN(info_log_, "Verify hash entries checksum error: %s",
+                     verify_hash_entries_checksum_status.getState());
+      if (status) {
+        *status = verify_hash_entries_checksum_status;
+      }
+      return FinishAlwaysTrue(buf);
+    }
+    if (!detect_filter_construct_corruption_) {
+      ResetEntries();
+    }
+
+    // Shard directory
+    char* dir = mutable_buf.get() + data_len;
+    size_t end = 0;
+    for (uint32_t i = 0; i < num_shards; ++i) {
+      end += shard_lens[i];
+      assert(end <= UINT32_MAX);
+      EncodeFixed32(dir, static_cast<uint32_t>(end));
+      assert(shard_blocks[i] < 0x1000000U);
+      dir[4] = static_cast<char>(shard_blocks[i] & 255);
+      dir[5] = static_cast<char>((shard_blocks[i] >> 8) & 255);
+      dir[6] = static_cast<char>((shard_blocks[i] >> 16) & 255);
+      assert(shard_seeds[i] < 256);
+      dir[7] = static_cast<char>(shard_seeds[i]);
+      dir += kShardDirEntryLen;
+    }
+
+    // Metadata: -3 = marker for sharded Standard128 Ribbon, then
+    // log2(num_shards); remaining bytes reserved (already zero)
+    mutable_buf[len_with_metadata - 5] = static_cast<char>(-3);
+    mutable_buf[len_with_metadata - 4] = static_cast<char>(log2_shards);
+
+    // Cache charging for mutable_buf
+    std::unique_ptr<CacheReservationManager::CacheReservationHandle>
+        final_filter_cache_res_handle;
+    if (cache_res_mgr_) {
+      Status s = cache_res_mgr_->MakeCacheReservation(
+          len_with_metadata * sizeof(char), &final_filter_cache_res_handle);
+      s.PermitUncheckedError();
+    }
+
+    Slice rv(mutable_buf.get(), len_with_metadata);
+    *buf = std::move(mutable_buf);
+    final_filter_cache_res_handles_.push_back(
+        std::move(final_filter_cache_res_handle));
+    if (status) {
+      *status = Status::OK();
+    }
+    return rv;
+  }
+
   // Setting num_slots to 0 means "fall back on Bloom filter."
   // And note this implementation does not support num_entries or num_slots
   // beyond uint32_t; see kMaxRibbonEntries.
@@ -938,12 +1145,24 @@ class Standard128RibbonBitsBuilder : public XXPH3FilterBitsBuilder {
   // (for filter metadata).
   static constexpr uint32_t kMaxRibbonEntries = 950000000;  // ~ 1 billion
 
+  // Below this many entries per shard, multi-threaded construction is not
+  // worth the per-shard overhead.
+  static constexpr uint32_t kMinShardEntries = 1 << 20;
+
+  // Per-shard directory entry in the sharded format: 4 bytes cumulative
+  // end offset + 3 bytes num_blocks + 1 byte seed
+  static constexpr size_t kShardDirEntryLen = 8;
+
   // A desired value for 1/fp_rate. For example, 100 -> 1% fp rate.
   double desired_one_in_fp_rate_;
 
   // For warnings, or can be nullptr
   Logger* info_log_;
 
+  // Threads to use in Finish for large filters (1 = single-threaded,
+  // standard format only)
+  const int construction_threads_;
+
   // For falling back on Bloom filter in some exceptional cases and
   // very small filter cases
   FastLocalBloomBitsBuilder bloom_fallback_;
@@ -969,10 +1188,20 @@ class Standard128RibbonBitsReader : public BuiltinFilterBitsReader {
 
   bool MayMatch(const Slice& key) override {
     uint64_t h = GetSliceHash64(key);
+    // A query reads coefficient segments straddling up to two interleaved
+    // blocks
+    PERF_COUNTER_ADD(filter_cachelines_touched, 2);
     return soln_.FilterQuery(h, hasher_);
   }
 
   virtual void MayMatch(int num_keys, Slice** keys, bool* may_match) override {
+    std::array<uint64_t, MultiGetContext::MAX_BATCH_SIZE> hashes;
+    GetSliceHashes64(keys, num_keys, hashes.data());
+    MayMatch(num_keys, keys, hashes.data(), may_match);
+  }
+
+  void MayMatch(int num_keys, Slice** /*keys*/, const uint64_t* hashes,
+                bool* may_match) override {
     struct SavedData {
       uint64_t seeded_hash;
       uint32_t segment_num;
@@ -982,11 +1211,18 @@ class Standard128RibbonBitsReader : public BuiltinFilterBitsReader {
     std::array<SavedData, MultiGetContext::MAX_BATCH_SIZE> saved;
     for (int i = 0; i < num_keys; ++i) {
       ribbon::InterleavedPrepareQuery(
-          GetSliceHash64(*keys[i]), hasher_, soln_, &saved[i].seeded_hash,
+          hashes[i], hasher_, soln_, &saved[i].seeded_hash,
           &saved[i].segment_num, &saved[i].num_columns, &saved[i].start_bits);
     }
+    PERF_COUNTER_ADD(filter_cachelines_touched,
+                     2 * static_cast<uint64_t>(num_keys));
+    PERF_COUNTER_ADD(filter_prepared_probes_reused, num_keys);
     for (int i = 0; i < num_keys; ++i) {
-      may_match[i] = ribbon::InterleavedFilterQuery(
+      // Branch-free variant: with the segments for the whole batch already
+      // prefetched above, the per-column early-exit branches of the single
+      // key query path mispredict and stall the batch, while the
+      // branch-free parity kernel pipelines across keys.
+      may_match[i] = ribbon::InterleavedFilterQueryBranchless(
           saved[i].seeded_hash, saved[i].segment_num, saved[i].num_columns,
           saved[i].start_bits, hasher_, soln_);
     }
@@ -1002,6 +1238,62 @@ class Standard128RibbonBitsReader : public BuiltinFilterBitsReader {
   ribbon::StandardHasher<TS> hasher_;
 };
 
+// For Ribbon filters built multi-threaded as independent sub-bands
+// (see Standard128RibbonBitsBuilder::FinishSharded)
+class Standard128RibbonShardedBitsReader : public BuiltinFilterBitsReader {
+ public:
+  Standard128RibbonShardedBitsReader(const char* data, const char* dir,
+                                     uint32_t num_shards, int log2_shards)
+      : log2_shards_(log2_shards) {
+    solns_.reserve(num_shards);
+    hashers_.resize(num_shards);
+    uint32_t start = 0;
+    for (uint32_t i = 0; i < num_shards; ++i) {
+      const char* entry = dir + i * 8;
+      uint32_t end = DecodeFixed32(entry);
+      uint32_t num_blocks = static_cast<uint8_t>(entry[4]);
+      num_blocks |= static_cast<uint8_t>(entry[5]) << 8;
+      num_blocks |= static_cast<uint8_t>(entry[6]) << 16;
+      uint32_t seed = static_cast<uint8_t>(entry[7]);
+      solns_.emplace_back(const_cast<char*>(data + start), end - start);
+      solns_.back().ConfigureForNumBlocks(num_blocks);
+      hashers_[i].SetOrdinalSeed(seed);
+      start = end;
+    }
+  }
+
+  // No Copy allowed
+  Standard128RibbonShardedBitsReader(
+      const Standard128RibbonShardedBitsReader&) = delete;
+  void operator=(const Standard128RibbonShardedBitsReader&) = delete;
+
+  ~Standard128RibbonShardedBitsReader() override {}
+
+  bool MayMatch(const Slice& key) override {
+    return HashMayMatch(GetSliceHash64(key));
+  }
+
+  using FilterBitsReader::MayMatch;  // inherit overload
+
+  void MayMatch(int num_keys, Slice** /*keys*/, const uint64_t* hashes,
+                bool* may_match) override {
+    for (int i = 0; i < num_keys; ++i) {
+      may_match[i] = HashMayMatch(hashes[i]);
+    }
+  }
+
+  bool HashMayMatch(const uint64_t h) override {
+    uint32_t shard = RibbonShardOfHash(h, log2_shards_);
+    return solns_[shard].FilterQuery(h, hashers_[shard]);
+  }
+
+ private:
+  using TS = Standard128RibbonTypesAndSettings;
+  const int log2_shards_;
+  std::vector<ribbon::SerializableInterleavedSolution<TS>> solns_;
+  std::vector<ribbon::StandardHasher<TS>> hashers_;
+};
+
 // ##################### Legacy Bloom implementation ################### //
 
 using LegacyBloomImpl = LegacyLocalityBloomImpl</*ExtraRotates*/ false>;
@@ -1220,6 +1512,8 @@ class LegacyBloomBitsReader : public BuiltinFilterBitsReader {
 
   ~LegacyBloomBitsReader() override {}
 
+  using FilterBitsReader::MayMatch;  // inherit overload
+
   // "contents" contains the data built by a preceding call to
   // FilterBitsBuilder::Finish. MayMatch must return true if the key was
   // passed to FilterBitsBuilder::AddKey. This method may return true or false
@@ -1230,6 +1524,8 @@ class LegacyBloomBitsReader : public BuiltinFilterBitsReader {
     uint32_t byte_offset;
     LegacyBloomImpl::PrepareHashMayMatch(
         hash, num_lines_, data_, /*out*/ &byte_offset, log2_cache_line_size_);
+    // All probes for a key land in one prefetched cache line
+    PERF_COUNTER_ADD(filter_cachelines_touched, 1);
     return LegacyBloomImpl::HashMayMatchPrepared(
         hash, num_probes_, data_ + byte_offset, log2_cache_line_size_);
   }
@@ -1243,6 +1539,8 @@ class LegacyBloomBitsReader : public BuiltinFilterBitsReader {
                                            /*out*/ &byte_offsets[i],
                                            log2_cache_line_size_);
     }
+    PERF_COUNTER_ADD(filter_cachelines_touched, num_keys);
+    PERF_COUNTER_ADD(filter_prepared_probes_reused, num_keys);
     for (int i = 0; i < num_keys; ++i) {
       may_match[i] = LegacyBloomImpl::HashMayMatchPrepared(
           hashes[i], num_probes_, data_ + byte_offsets[i],
@@ -1275,6 +1573,117 @@ class AlwaysFalseFilter : public BuiltinFilterBitsReader {
   using BuiltinFilterBitsReader::HashMayMatch;  // inherit overload
 };
 
+// For RangeSegmentFilterPolicy
+//
+// Serialized filter layout:
+//  [num_entries records, each segment_len bytes zero-padded + 1 length byte]
+//  [4 bytes: num_entries, little endian]
+//  [1 byte: segment_len]
+//  [1 byte: format version, currently 1]
+// Records are the sorted distinct segments (keys/prefixes truncated to
+// segment_len bytes). Unlike the hash-based builders, keys cannot be
+// condensed as they arrive because whole keys and extracted prefixes are
+// interleaved and only sorted within each stream, so Finish sorts.
+class RangeSegmentFilterBitsBuilder : public FilterBitsBuilder {
+ public:
+  explicit RangeSegmentFilterBitsBuilder(uint32_t segment_len)
+      : segment_len_(segment_len) {
+    assert(segment_len_ >= 1 && segment_len_ <= 255);
+  }
+
+  static constexpr size_t kMetadataLen = 6;
+
+  void AddKey(const Slice& key) override {
+    Slice segment(key.data(), std::min(key.size(), size_t{segment_len_}));
+    // Cheap dedup of adjacent repeats (e.g. keys sharing a prefix);
+    // Finish dedups the rest after sorting.
+    if (segments_.empty() || Slice(segments_.back()) != segment) {
+      segments_.emplace_back(segment.data(), segment.size());
+    }
+    ++num_added_;
+  }
+
+  size_t EstimateEntriesAdded() override { return num_added_; }
+
+  using FilterBitsBuilder::Finish;
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    std::sort(segments_.begin(), segments_.end());
+    segments_.erase(std::unique(segments_.begin(), segments_.end()),
+                    segments_.end());
+    const size_t num = segments_.size();
+    assert(num <= UINT32_MAX);
+    const size_t len = num * (segment_len_ + 1) + kMetadataLen;
+    std::unique_ptr<char[]> data(new char[len]());
+    char* ptr = data.get();
+    for (const auto& segment : segments_) {
+      memcpy(ptr, segment.data(), segment.size());
+      // Remaining bytes are already zero padding
+      ptr[segment_len_] = static_cast<char>(segment.size());
+      ptr += segment_len_ + 1;
+    }
+    EncodeFixed32(ptr, static_cast<uint32_t>(num));
+    ptr[4] = static_cast<char>(segment_len_);
+    ptr[5] = /* format version */ 1;
+    segments_.clear();
+    segments_.shrink_to_fit();
+    num_added_ = 0;
+    Slice rv(data.get(), len);
+    buf->reset(data.release());
+    return rv;
+  }
+
+  size_t ApproximateNumEntries(size_t bytes) override {
+    if (bytes <= kMetadataLen) {
+      return 0;
+    }
+    return (bytes - kMetadataLen) / (segment_len_ + 1);
+  }
+
+ private:
+  const uint32_t segment_len_;
+  std::vector<std::string> segments_;
+  size_t num_added_ = 0;
+};
+
+class RangeSegmentFilterBitsReader : public FilterBitsReader {
+ public:
+  RangeSegmentFilterBitsReader(const char* data, uint32_t num_entries,
+                               uint32_t segment_len)
+      : data_(data), num_entries_(num_entries), segment_len_(segment_len) {}
+
+  // An entry (whole key or prefix) may match iff some stored segment
+  // starts with the entry truncated to segment_len. Stored segments
+  // starting with the query are contiguous and order no less than it, so
+  // the first record >= the query decides.
+  bool MayMatch(const Slice& entry) override {
+    Slice q(entry.data(), std::min(entry.size(), size_t{segment_len_}));
+    uint32_t lo = 0;
+    uint32_t hi = num_entries_;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (RecordAt(mid).compare(q) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo < num_entries_ && RecordAt(lo).starts_with(q);
+  }
+
+  using FilterBitsReader::MayMatch;  // inherit overload
+
+ private:
+  Slice RecordAt(uint32_t i) const {
+    const char* ptr = data_ + uint64_t{i} * (segment_len_ + 1);
+    return Slice(ptr, static_cast<uint8_t>(ptr[segment_len_]));
+  }
+
+  const char* data_;
+  const uint32_t num_entries_;
+  const uint32_t segment_len_;
+};
+
 Status XXPH3FilterBitsBuilder::MaybePostVerify(const Slice& filter_content) {
   Status s = Status::OK();
 
@@ -1403,7 +1812,7 @@ std::string BloomFilterPolicy::GetId() const {
 }
 
 FilterBitsBuilder* BloomLikeFilterPolicy::GetFastLocalBloomBuilderWithContext(
-    const FilterBuildingContext& context) const {
+    const FilterBuildingContext& context, int millibits_override) const {
   bool offm = context.table_options.optimize_filters_for_memory;
   const auto options_overrides_iter =
       context.table_options.cache_usage_options.options_overrides.find(
@@ -1423,8 +1832,8 @@ FilterBitsBuilder* BloomLikeFilterPolicy::GetFastLocalBloomBuilderWithContext(
         context.table_options.block_cache);
   }
         return new FastLocalBloomBitsBuilder(
-            millibits_per_key_, offm ? &aggregate_rounding_balance_ : nullptr,
-            cache_res_mgr,
+            millibits_override >= 0 ? millibits_override : millibits_per_key_,
+            offm ? &aggregate_rounding_balance_ : nullptr, cache_res_mgr,
             context.table_options.detect_filter_construct_corruption);
 }
 
@@ -1452,7 +1861,7 @@ FilterBitsBuilder* BloomLikeFilterPolicy::GetLegacyBloomBuilderWithContext(
 
 FilterBitsBuilder*
 BloomLikeFilterPolicy::GetStandard128RibbonBuilderWithContext(
-    const FilterBuildingContext& context) const {
+    const FilterBuildingContext& context, int construction_threads) const {
   // FIXME: code duplication with GetFastLocalBloomBuilderWithContext
   bool offm = context.table_options.optimize_filters_for_memory;
   const auto options_overrides_iter =
@@ -1476,7 +1885,7 @@ BloomLikeFilterPolicy::GetStandard128RibbonBuilderWithContext(
       desired_one_in_fp_rate_, millibits_per_key_,
       offm ? &aggregate_rounding_balance_ : nullptr, cache_res_mgr,
       context.table_options.detect_filter_construct_corruption,
-      context.info_log);
+      context.info_log, construction_threads);
 }
 
 std::string BloomLikeFilterPolicy::GetBitsPerKeySuffix() const {
@@ -1590,6 +1999,10 @@ BuiltinFilterBitsReader* BuiltinFilterPolicy::GetBuiltinFilterBitsReader(
       case -2:
         // Marker for Ribbon implementations
         return GetRibbonBitsReader(contents);
+      case -3:
+        // Marker for sharded Ribbon implementations (multi-threaded
+        // construction)
+        return GetShardedRibbonBitsReader(contents);
       default:
         // Reserved (treat as zero probes, always FP, for now)
         return new AlwaysTrueFilter();
@@ -1661,6 +2074,57 @@ BuiltinFilterBitsReader* BuiltinFilterPolicy::GetRibbonBitsReader(
                                          seed);
 }
 
+// Sharded Ribbon filter layout (metadata marker -3):
+//             0 +-----------------------------------+
+//               | Shard 0 interleaved solution data |
+//               | ... (num_shards shards)           |
+//      data_len +-----------------------------------+
+//               | Shard directory: 8 bytes/shard    |
+//               |  [4B cumulative end offset (LE)]  |
+//               |  [3B num_blocks (LE)] [1B seed]   |
+//           len +-----------------------------------+
+//               | char{-3} byte                     |
+//               | byte: log2(num_shards)            |
+//               | 3 bytes: reserved (zero)          |
+// len_with_meta +-----------------------------------+
+BuiltinFilterBitsReader* BuiltinFilterPolicy::GetShardedRibbonBitsReader(
+    const Slice& contents) {
+  size_t len_with_meta = contents.size();
+  assert(len_with_meta >= kMetadataLen);  // precondition
+
+  int log2_shards =
+      static_cast<uint8_t>(contents.data()[len_with_meta - kMetadataLen + 1]);
+  if (log2_shards < 1 || log2_shards > 6) {
+    // Not supported / corrupt. Return something safe:
+    return new AlwaysTrueFilter();
+  }
+  uint32_t num_shards = uint32_t{1} << log2_shards;
+  size_t dir_len = size_t{num_shards} * 8;
+  if (len_with_meta < dir_len + kMetadataLen) {
+    return new AlwaysTrueFilter();
+  }
+  size_t data_len = len_with_meta - kMetadataLen - dir_len;
+  const char* dir = contents.data() + data_len;
+  // Validate the directory before trusting it
+  uint32_t prev_end = 0;
+  for (uint32_t i = 0; i < num_shards; ++i) {
+    const char* entry = dir + i * 8;
+    uint32_t end = DecodeFixed32(entry);
+    uint32_t num_blocks = static_cast<uint8_t>(entry[4]);
+    num_blocks |= static_cast<uint8_t>(entry[5]) << 8;
+    num_blocks |= static_cast<uint8_t>(entry[6]) << 16;
+    if (end < prev_end || end > data_len || num_blocks < 2) {
+      return new AlwaysTrueFilter();
+    }
+    prev_end = end;
+  }
+  if (prev_end != data_len) {
+    return new AlwaysTrueFilter();
+  }
+  return new Standard128RibbonShardedBitsReader(contents.data(), dir,
+                                                num_shards, log2_shards);
+}
+
 // For newer Bloom filter implementations
 BuiltinFilterBitsReader* BuiltinFilterPolicy::GetBloomBitsReader(
     const Slice& contents) {
@@ -1728,10 +2192,75 @@ const FilterPolicy* NewBloomFilterPolicy(double bits_per_key,
   return new BloomFilterPolicy(bits_per_key);
 }
 
+int AdaptiveBloomFilterPolicy::AdaptedMillibitsPerKey(
+    const FilterBuildingContext& context) const {
+  const int base = GetMillibitsPerKey();
+  if (context.level_at_creation < 0 || context.num_levels <= 1) {
+    // External SST file or unknown placement; keep the baseline.
+    return base;
+  }
+  // Levels near the bottom of the LSM hold colder data, so a false
+  // positive there usually costs a real storage read, while upper level
+  // data blocks are usually cached. Scale smoothly from 0.75x of the
+  // baseline at L0 to 1.25x at the bottommost level.
+  double depth =
+      context.is_bottommost
+          ? 1.0
+          : std::min(1.0, static_cast<double>(context.level_at_creation) /
+                              (context.num_levels - 1));
+  double factor = 0.75 + 0.5 * depth;
+  // Filter bits only pay off on lookups for absent keys. Once enough
+  // lookups have been observed, scale by the measured fraction of
+  // filter-checked lookups that were negative: mostly-positive workloads
+  // get leaner filters, mostly-negative ones richer filters.
+  if (context.statistics != nullptr) {
+    const uint64_t useful =
+        context.statistics->getTickerCount(BLOOM_FILTER_USEFUL);
+    const uint64_t full_positive =
+        context.statistics->getTickerCount(BLOOM_FILTER_FULL_POSITIVE);
+    constexpr uint64_t kMinObservedLookups = 10000;
+    if (useful + full_positive >= kMinObservedLookups) {
+      double negative_fraction =
+          static_cast<double>(useful) / (useful + full_positive);
+      factor *= 0.5 + negative_fraction;
+    }
+  }
+  int millibits = static_cast<int>(base * factor + 0.5);
+  // Stay within a factor of two of the configured baseline and within
+  // the range accepted for bits/key settings (up to 100 bits/key).
+  millibits = std::min(millibits, std::min(2 * base, 100 * 1000));
+  millibits = std::max(millibits, std::max(base / 2, 1000));
+  return millibits;
+}
+
+FilterBitsBuilder* AdaptiveBloomFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& context) const {
+  if (GetMillibitsPerKey() == 0) {
+    // "No filter" special case
+    return nullptr;
+  } else if (context.table_options.format_version < 5) {
+    // The legacy schema rounds to whole bits per key; not worth adapting.
+    return GetLegacyBloomBuilderWithContext(context);
+  } else {
+    return GetFastLocalBloomBuilderWithContext(context,
+                                               AdaptedMillibitsPerKey(context));
+  }
+}
+
+const char* AdaptiveBloomFilterPolicy::kClassName() {
+  return "adaptive_bloomfilter";
+}
+
+const FilterPolicy* NewAdaptiveBloomFilterPolicy(double bits_per_key) {
+  return new AdaptiveBloomFilterPolicy(bits_per_key);
+}
+
 RibbonFilterPolicy::RibbonFilterPolicy(double bloom_equivalent_bits_per_key,
-                                       int bloom_before_level)
+                                       int bloom_before_level,
+                                       int construction_threads)
     : BloomLikeFilterPolicy(bloom_equivalent_bits_per_key),
-      bloom_before_level_(bloom_before_level) {}
+      bloom_before_level_(bloom_before_level),
+      construction_threads_(construction_threads) {}
 
 FilterBitsBuilder* RibbonFilterPolicy::GetBuilderWithContext(
     const FilterBuildingContext& context) const {
@@ -1766,7 +2295,8 @@ FilterBitsBuilder* RibbonFilterPolicy::GetBuilderWithContext(
   if (levelish < bloom_before_level_) {
     return GetFastLocalBloomBuilderWithContext(context);
   } else {
-    return GetStandard128RibbonBuilderWithContext(context);
+    return GetStandard128RibbonBuilderWithContext(context,
+                                                  construction_threads_);
   }
 }
 
@@ -1779,9 +2309,56 @@ std::string RibbonFilterPolicy::GetId() const {
 }
 
 const FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
-                                          int bloom_before_level) {
+                                          int bloom_before_level,
+                                          int construction_threads) {
   return new RibbonFilterPolicy(bloom_equivalent_bits_per_key,
-                                bloom_before_level);
+                                bloom_before_level, construction_threads);
+}
+
+RangeSegmentFilterPolicy::RangeSegmentFilterPolicy(size_t segment_len)
+    : segment_len_(static_cast<uint32_t>(
+          std::max(size_t{1}, std::min(segment_len, size_t{255})))) {}
+
+FilterBitsBuilder* RangeSegmentFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& /*context*/) const {
+  return new RangeSegmentFilterBitsBuilder(segment_len_);
+}
+
+FilterBitsReader* RangeSegmentFilterPolicy::GetFilterBitsReader(
+    const Slice& contents) const {
+  constexpr size_t kMetadataLen = RangeSegmentFilterBitsBuilder::kMetadataLen;
+  if (contents.size() < kMetadataLen) {
+    // Missing metadata; treat as zero keys and always false.
+    return new AlwaysFalseFilter();
+  }
+  const char* metadata = contents.data() + contents.size() - kMetadataLen;
+  const uint32_t num_entries = DecodeFixed32(metadata);
+  const uint32_t segment_len = static_cast<uint8_t>(metadata[4]);
+  const int version = static_cast<uint8_t>(metadata[5]);
+  if (version != 1 || segment_len < 1 ||
+      contents.size() !=
+          uint64_t{num_entries} * (segment_len + 1) + kMetadataLen) {
+    // Unrecognized or corrupt; schema may have changed in a future version
+    return new AlwaysTrueFilter();
+  }
+  return new RangeSegmentFilterBitsReader(contents.data(), num_entries,
+                                          segment_len);
+}
+
+const char* RangeSegmentFilterPolicy::kClassName() {
+  return "rangesegmentfilter";
+}
+
+const char* RangeSegmentFilterPolicy::kCompatibilityName() {
+  return "rocksdb.RangeSegmentFilter";
+}
+
+std::string RangeSegmentFilterPolicy::GetId() const {
+  return std::string(kClassName()) + ":" + std::to_string(segment_len_);
+}
+
+const FilterPolicy* NewExperimentalRangeFilterPolicy(size_t segment_len) {
+  return new RangeSegmentFilterPolicy(segment_len);
 }
 
 FilterBuildingContext::FilterBuildingContext(
@@ -1865,6 +2442,15 @@ static int RegisterBuiltinFilterPolicies(ObjectLibrary& library,
         guard->reset(NewBloomFilterPolicy(bits_per_key, true));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(AdaptiveBloomFilterPolicy::kClassName()),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        guard->reset(NewAdaptiveBloomFilterPolicy(bits_per_key));
+        return guard->get();
+      });
   library.AddFactory<const FilterPolicy>(
       FilterPatternEntryWithBits(RibbonFilterPolicy::kClassName())
           .AnotherName(RibbonFilterPolicy::kNickName()),
@@ -1887,6 +2473,15 @@ static int RegisterBuiltinFilterPolicies(ObjectLibrary& library,
         guard->reset(NewRibbonFilterPolicy(bits_per_key, bloom_before_level));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(RangeSegmentFilterPolicy::kClassName()),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        size_t segment_len = static_cast<size_t>(ParseInt(vals[1]));
+        guard->reset(NewExperimentalRangeFilterPolicy(segment_len));
+        return guard->get();
+      });
   library.AddFactory<const FilterPolicy>(
       FilterPatternEntryWithBits(test::LegacyBloomFilterPolicy::kClassName()),
       [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
@@ -95,6 +95,15 @@ class FilterBitsReader {
       may_match[i] = MayMatch(*keys[i]);
     }
   }
+
+  // Same as above, but hashes[i] is the GetSliceHash64 value of *keys[i],
+  // already computed by the caller (e.g. once per MultiGet batch). Readers
+  // whose probes are derived from that hash should override this to avoid
+  // rehashing; the default ignores the hashes and probes by key.
+  virtual void MayMatch(int num_keys, Slice** keys,
+                        const uint64_t* /*hashes*/, bool* may_match) {
+    MayMatch(num_keys, keys, may_match);
+  }
 };
 
 // Exposes any extra information needed for testing built-in
@@ -157,6 +166,11 @@ class BuiltinFilterPolicy : public FilterPolicy {
 
   // For Ribbon filter implementation(s)
   static BuiltinFilterBitsReader* GetRibbonBitsReader(const Slice& contents);
+
+  // For sharded Ribbon filters (built multi-threaded; see
+  // NewRibbonFilterPolicy construction_threads)
+  static BuiltinFilterBitsReader* GetShardedRibbonBitsReader(
+      const Slice& contents);
 };
 
 // A "read only" filter policy used for backward compatibility with old
@@ -209,10 +223,14 @@ class BloomLikeFilterPolicy : public BuiltinFilterPolicy {
   // Some implementations used by aggregating policies
   FilterBitsBuilder* GetLegacyBloomBuilderWithContext(
       const FilterBuildingContext& context) const;
+  // millibits_override >= 0 substitutes for the policy's configured
+  // setting, for policies that re-size per file (see
+  // AdaptiveBloomFilterPolicy).
   FilterBitsBuilder* GetFastLocalBloomBuilderWithContext(
-      const FilterBuildingContext& context) const;
+      const FilterBuildingContext& context,
+      int millibits_override = -1) const;
   FilterBitsBuilder* GetStandard128RibbonBuilderWithContext(
-      const FilterBuildingContext& context) const;
+      const FilterBuildingContext& context, int construction_threads = 1) const;
 
   std::string GetBitsPerKeySuffix() const;
 
@@ -271,6 +289,29 @@ class BloomFilterPolicy : public BloomLikeFilterPolicy {
   std::string GetId() const override;
 };
 
+// For NewAdaptiveBloomFilterPolicy
+//
+// A user-facing policy producing ordinary (compatible) Bloom filters,
+// but re-sizing bits/key per SST file from the build context: the LSM
+// level being written and, when statistics are available, the observed
+// fraction of lookups that filters can help.
+class AdaptiveBloomFilterPolicy : public BloomLikeFilterPolicy {
+ public:
+  explicit AdaptiveBloomFilterPolicy(double bits_per_key)
+      : BloomLikeFilterPolicy(bits_per_key) {}
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext&) const override;
+
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+
+ private:
+  // The per-file bits/key decision, in millibits; clamped to a factor of
+  // two of the configured baseline.
+  int AdaptedMillibitsPerKey(const FilterBuildingContext& context) const;
+};
+
 // For NewRibbonFilterPolicy
 //
 // This is a user-facing policy that chooses between Standard128Ribbon
@@ -279,12 +320,14 @@ class BloomFilterPolicy : public BloomLikeFilterPolicy {
 class RibbonFilterPolicy : public BloomLikeFilterPolicy {
  public:
   explicit RibbonFilterPolicy(double bloom_equivalent_bits_per_key,
-                              int bloom_before_level);
+                              int bloom_before_level,
+                              int construction_threads = 1);
 
   FilterBitsBuilder* GetBuilderWithContext(
       const FilterBuildingContext&) const override;
 
   int GetBloomBeforeLevel() const { return bloom_before_level_; }
+  int GetConstructionThreads() const { return construction_threads_; }
 
   static const char* kClassName();
   const char* Name() const override { return kClassName(); }
@@ -294,6 +337,39 @@ class RibbonFilterPolicy : public BloomLikeFilterPolicy {
 
  private:
   const int bloom_before_level_;
+  const int construction_threads_;
+};
+
+// For NewExperimentalRangeFilterPolicy
+//
+// Not part of the Bloom/Ribbon read-compatible family: filters are the
+// sorted set of distinct key/prefix segments (keys truncated to a fixed
+// number of bytes) and are searched by order rather than by hash, so this
+// policy has its own CompatibilityName.
+class RangeSegmentFilterPolicy : public FilterPolicy {
+ public:
+  explicit RangeSegmentFilterPolicy(size_t segment_len);
+
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  const char* CompatibilityName() const override {
+    return kCompatibilityName();
+  }
+  static const char* kCompatibilityName();
+  std::string GetId() const override;
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext&) const override;
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override;
+
+  // Essentially for testing only: configured segment length in bytes
+  uint32_t GetSegmentLen() const { return segment_len_; }
+
+ private:
+  // Bytes each key/prefix is truncated to; bounded to [1, 255] so it fits
+  // the per-entry length byte in the serialized filter.
+  uint32_t segment_len_;
 };
 
 // For testing only, but always constructable with internal names
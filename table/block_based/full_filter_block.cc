@@ -252,11 +252,13 @@ void FullFilterBlockReader::MayMatch(
   // expensive compared to autovector
   std::array<Slice*, MultiGetContext::MAX_BATCH_SIZE> keys;
   std::array<bool, MultiGetContext::MAX_BATCH_SIZE> may_match = {{true}};
+  std::array<uint64_t, MultiGetContext::MAX_BATCH_SIZE> hashes;
   autovector<Slice, MultiGetContext::MAX_BATCH_SIZE> prefixes;
   int num_keys = 0;
   MultiGetRange filter_range(*range, range->begin(), range->end());
   for (auto iter = filter_range.begin(); iter != filter_range.end(); ++iter) {
     if (!prefix_extractor) {
+      hashes[num_keys] = iter->ukey_hash;
       keys[num_keys++] = &iter->ukey_without_ts;
     } else if (prefix_extractor->InDomain(iter->ukey_without_ts)) {
       prefixes.emplace_back(prefix_extractor->Transform(iter->ukey_without_ts));
@@ -266,22 +268,29 @@ void FullFilterBlockReader::MayMatch(
     }
   }
 
-  filter_bits_reader->MayMatch(num_keys, &keys[0], &may_match[0]);
+  if (prefix_extractor) {
+    filter_bits_reader->MayMatch(num_keys, &keys[0], &may_match[0]);
+  } else {
+    // Whole key probes reuse the hash memoized in KeyContext when the batch
+    // was formed, so a key is hashed once per MultiGet rather than once per
+    // file whose filter it is checked against.
+    filter_bits_reader->MayMatch(num_keys, &keys[0], &hashes[0],
+                                 &may_match[0]);
+  }
 
   int i = 0;
+  int num_misses = 0;
   for (auto iter = filter_range.begin(); iter != filter_range.end(); ++iter) {
     if (!may_match[i]) {
       // Update original MultiGet range to skip this key. The filter_range
       // was temporarily used just to skip keys not in prefix_extractor domain
       range->SkipKey(iter);
-      PERF_COUNTER_ADD(bloom_sst_miss_count, 1);
-    } else {
-      // PERF_COUNTER_ADD(bloom_sst_hit_count, 1);
-      PerfContext* perf_ctx = get_perf_context();
-      perf_ctx->bloom_sst_hit_count++;
+      ++num_misses;
     }
     ++i;
   }
+  PERF_COUNTER_ADD(bloom_sst_miss_count, num_misses);
+  PERF_COUNTER_ADD(bloom_sst_hit_count, num_keys - num_misses);
 }
 
 size_t FullFilterBlockReader::ApproximateMemoryUsage() const {
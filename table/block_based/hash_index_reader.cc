@@ -145,4 +145,120 @@ InternalIteratorBase<IndexValue>* HashIndexReader::NewIterator(
 
   return it;
 }
+
+Status WholeKeyHashIndexReader::Create(
+    const BlockBasedTable* table, const ReadOptions& ro,
+    FilePrefetchBuffer* prefetch_buffer, InternalIterator* meta_index_iter,
+    bool use_cache, bool prefetch, bool pin,
+    BlockCacheLookupContext* lookup_context,
+    std::unique_ptr<IndexReader>* index_reader) {
+  assert(table != nullptr);
+  assert(index_reader != nullptr);
+  assert(!pin || prefetch);
+
+  const BlockBasedTable::Rep* rep = table->get_rep();
+  assert(rep != nullptr);
+
+  CachableEntry<Block> index_block;
+  if (prefetch || !use_cache) {
+    const Status s =
+        ReadIndexBlock(table, prefetch_buffer, ro, use_cache,
+                       /*get_context=*/nullptr, lookup_context, &index_block);
+    if (!s.ok()) {
+      return s;
+    }
+
+    if (use_cache && !pin) {
+      index_block.Reset();
+    }
+  }
+
+  // As with the prefix hash index, failure to read the hash index block is
+  // not a hard error: the primary index is a complete binary search index,
+  // so Create succeeds regardless from this point on. The meta block is
+  // also legitimately absent when the table was built with a comparator
+  // using user-defined timestamps (see WholeKeyHashIndexBuilder).
+
+  index_reader->reset(new WholeKeyHashIndexReader(table,
+                                                  std::move(index_block)));
+
+  BlockHandle hash_index_handle;
+  Status s = FindMetaBlock(meta_index_iter, kWholeKeyHashIndexBlock,
+                           &hash_index_handle);
+  if (!s.ok()) {
+    return Status::OK();
+  }
+
+  RandomAccessFileReader* const file = rep->file.get();
+  const Footer& footer = rep->footer;
+  const ImmutableOptions& ioptions = rep->ioptions;
+  const PersistentCacheOptions& cache_options = rep->persistent_cache_options;
+  MemoryAllocator* const memory_allocator =
+      GetMemoryAllocator(rep->table_options);
+
+  BlockContents hash_index_contents;
+  BlockFetcher hash_index_block_fetcher(
+      file, prefetch_buffer, footer, ReadOptions(), hash_index_handle,
+      &hash_index_contents, ioptions, true /*decompress*/,
+      true /*maybe_compressed*/, BlockType::kIndex,
+      UncompressionDict::GetEmptyDict(), cache_options, memory_allocator);
+  s = hash_index_block_fetcher.ReadBlockContents();
+  if (!s.ok()) {
+    return Status::OK();
+  }
+
+  std::unique_ptr<WholeKeyHashIndex> hash_index;
+  s = WholeKeyHashIndex::Create(hash_index_contents.data, &hash_index);
+  if (s.ok()) {
+    WholeKeyHashIndexReader* const reader =
+        static_cast<WholeKeyHashIndexReader*>(index_reader->get());
+    reader->hash_index_ = std::move(hash_index);
+  }
+
+  return Status::OK();
+}
+
+InternalIteratorBase<IndexValue>* WholeKeyHashIndexReader::NewIterator(
+    const ReadOptions& read_options, bool disable_prefix_seek,
+    IndexBlockIter* iter, GetContext* get_context,
+    BlockCacheLookupContext* lookup_context) {
+  const BlockBasedTable::Rep* rep = table()->get_rep();
+  const bool no_io = (read_options.read_tier == kBlockCacheTier);
+  CachableEntry<Block> index_block;
+  const Status s =
+      GetOrReadIndexBlock(no_io, read_options.rate_limiter_priority,
+                          get_context, lookup_context, &index_block);
+  if (!s.ok()) {
+    if (iter != nullptr) {
+      iter->Invalidate(s);
+      return iter;
+    }
+
+    return NewErrorInternalIterator<IndexValue>(s);
+  }
+
+  Statistics* kNullStats = nullptr;
+  // The hash index is only consulted for point lookups (which carry a
+  // get_context): a Seek that lands on the target's data block is correct
+  // for Get's forward walk, but not for an ordinary iterator, which must
+  // honor total order.
+  const bool no_hash_lookup = read_options.total_order_seek ||
+                              disable_prefix_seek || get_context == nullptr;
+  // We don't return pinned data from index blocks, so no need
+  // to set `block_contents_pinned`.
+  auto it = index_block.GetValue()->NewIndexIterator(
+      internal_comparator()->user_comparator(),
+      rep->get_global_seqno(BlockType::kIndex), iter, kNullStats,
+      /* total_order_seek */ true, index_has_first_key(),
+      index_key_includes_seq(), index_value_is_full(),
+      false /* block_contents_pinned */, /* prefix_index */ nullptr,
+      /* learned_index */ nullptr, /* fixed_handle_offsets */ nullptr,
+      /* num_fixed_handle_offsets */ 0,
+      no_hash_lookup ? nullptr : hash_index_.get());
+
+  assert(it != nullptr);
+  index_block.TransferTo(it);
+
+  return it;
+}
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "table/block_based/index_reader_common.h"
+#include "table/block_based/whole_key_hash_index.h"
 
 namespace ROCKSDB_NAMESPACE {
 // Index that leverages an internal hash table to quicken the lookup for a given
@@ -46,4 +47,44 @@ class HashIndexReader : public BlockBasedTable::IndexReaderCommon {
 
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
 };
+
+// Index that hashes the whole user key to the index entry holding it, so a
+// point lookup resolves to its data block without binary searching the
+// index block. Iterators and collisions fall back to binary search; if the
+// kWholeKeyHashIndexBlock meta block is missing or unreadable, the reader
+// degrades to a plain binary search index.
+class WholeKeyHashIndexReader : public BlockBasedTable::IndexReaderCommon {
+ public:
+  static Status Create(const BlockBasedTable* table, const ReadOptions& ro,
+                       FilePrefetchBuffer* prefetch_buffer,
+                       InternalIterator* meta_index_iter, bool use_cache,
+                       bool prefetch, bool pin,
+                       BlockCacheLookupContext* lookup_context,
+                       std::unique_ptr<IndexReader>* index_reader);
+
+  InternalIteratorBase<IndexValue>* NewIterator(
+      const ReadOptions& read_options, bool disable_prefix_seek,
+      IndexBlockIter* iter, GetContext* get_context,
+      BlockCacheLookupContext* lookup_context) override;
+
+  size_t ApproximateMemoryUsage() const override {
+    size_t usage = ApproximateIndexBlockMemoryUsage();
+#ifdef ROCKSDB_MALLOC_USABLE_SIZE
+    usage += malloc_usable_size(const_cast<WholeKeyHashIndexReader*>(this));
+#else
+    if (hash_index_) {
+      usage += hash_index_->ApproximateMemoryUsage();
+    }
+    usage += sizeof(*this);
+#endif  // ROCKSDB_MALLOC_USABLE_SIZE
+    return usage;
+  }
+
+ private:
+  WholeKeyHashIndexReader(const BlockBasedTable* t,
+                          CachableEntry<Block>&& index_block)
+      : IndexReaderCommon(t, std::move(index_block)) {}
+
+  std::unique_ptr<WholeKeyHashIndex> hash_index_;
+};
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,95 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+#include "table/format.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A small, lossy, per-table cache mapping a 64-bit user key fingerprint to
+// the handle of the data block where a point lookup for that key last
+// completed. Point-lookup heavy workloads with a Zipfian key distribution
+// hit the same few data blocks over and over; a hit here lets
+// BlockBasedTable::Get skip the index iterator (and thus the index block
+// access and binary search) and go straight to the data block.
+//
+// The cache is direct-mapped with no locking: each slot is a triple of
+// relaxed atomics (fingerprint, offset, size) that may be observed torn,
+// i.e. a reader can see the fingerprint from one insert combined with the
+// handle from another. This is safe because the consumer never trusts a
+// returned handle: Get re-validates that the retrieved block really is the
+// block an index seek would land on before using any entry in it, and
+// falls back to the regular index path otherwise (see
+// BlockBasedTable::TryHotKeyHandleCacheGet). A bad handle therefore costs
+// at most one wasted block read.
+//
+// Since SST files are immutable, a given key always maps to the same
+// handle within one table; entries never become stale, only evicted by
+// colliding keys.
+class HotKeyHandleCache {
+ public:
+  explicit HotKeyHandleCache(size_t num_entries) {
+    // Round up to a power of two so a fingerprint maps to a slot with a
+    // mask instead of a modulus.
+    size_t n = 1;
+    while (n < num_entries && n < (size_t{1} << 30)) {
+      n <<= 1;
+    }
+    mask_ = n - 1;
+    slots_.reset(new Slot[n]());
+  }
+
+  // No copying (would have to copy atomics).
+  HotKeyHandleCache(const HotKeyHandleCache&) = delete;
+  HotKeyHandleCache& operator=(const HotKeyHandleCache&) = delete;
+
+  // Returns true and sets *handle if a (possibly torn) entry for
+  // fingerprint is present. The caller MUST validate the handle and the
+  // block behind it before acting on the result; see class comment.
+  bool Lookup(uint64_t fingerprint, BlockHandle* handle) const {
+    const Slot& slot = slots_[fingerprint & mask_];
+    if (slot.fingerprint.load(std::memory_order_relaxed) != fingerprint ||
+        fingerprint == 0) {
+      return false;
+    }
+    handle->set_offset(slot.offset.load(std::memory_order_relaxed));
+    handle->set_size(slot.size.load(std::memory_order_relaxed));
+    return true;
+  }
+
+  // Records that a lookup for fingerprint completed in the block at
+  // handle, displacing whatever the slot held before.
+  void Insert(uint64_t fingerprint, const BlockHandle& handle) {
+    if (fingerprint == 0) {
+      // Reserved as the empty marker; losing this one key is harmless.
+      return;
+    }
+    Slot& slot = slots_[fingerprint & mask_];
+    slot.fingerprint.store(fingerprint, std::memory_order_relaxed);
+    slot.offset.store(handle.offset(), std::memory_order_relaxed);
+    slot.size.store(handle.size(), std::memory_order_relaxed);
+  }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(*this) + (mask_ + 1) * sizeof(Slot);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> fingerprint{0};
+    std::atomic<uint64_t> offset{0};
+    std::atomic<uint64_t> size{0};
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -29,6 +29,7 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
     const InternalKeyComparator* comparator,
     const InternalKeySliceTransform* int_key_slice_transform,
     const bool use_value_delta_encoding,
+    const bool use_fixed_stride_handles,
     const BlockBasedTableOptions& table_opt) {
   IndexBuilder* result = nullptr;
   switch (index_type) {
@@ -36,7 +37,8 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
       result = new ShortenedIndexBuilder(
           comparator, table_opt.index_block_restart_interval,
           table_opt.format_version, use_value_delta_encoding,
-          table_opt.index_shortening, /* include_first_key */ false);
+          table_opt.index_shortening, /* include_first_key */ false,
+          use_fixed_stride_handles);
       break;
     }
     case BlockBasedTableOptions::kHashSearch: {
@@ -61,6 +63,28 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
           table_opt.index_shortening, /* include_first_key */ true);
       break;
     }
+    case BlockBasedTableOptions::kLearnedSearch: {
+      // The learned model is built when the table is opened; on disk this is
+      // an ordinary binary search index. Restart interval 1 so that model
+      // positions map one-to-one to restart points.
+      assert(table_opt.index_block_restart_interval == 1);
+      result = new ShortenedIndexBuilder(
+          comparator, table_opt.index_block_restart_interval,
+          table_opt.format_version, use_value_delta_encoding,
+          table_opt.index_shortening, /* include_first_key */ false,
+          use_fixed_stride_handles);
+      break;
+    }
+    case BlockBasedTableOptions::kWholeKeyHashSearch: {
+      // Hash lookups resolve to restart points, so every index entry must
+      // be a restart point.
+      assert(table_opt.index_block_restart_interval == 1);
+      result = new WholeKeyHashIndexBuilder(
+          comparator, table_opt.index_block_restart_interval,
+          table_opt.format_version, use_value_delta_encoding,
+          table_opt.index_shortening);
+      break;
+    }
     default: {
       assert(!"Do not recognize the index type ");
       break;
@@ -18,7 +18,9 @@
 
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_based_table_factory.h"
+#include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/whole_key_hash_index.h"
 #include "table/format.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -39,6 +41,7 @@ class IndexBuilder {
       const ROCKSDB_NAMESPACE::InternalKeyComparator* comparator,
       const InternalKeySliceTransform* int_key_slice_transform,
       const bool use_value_delta_encoding,
+      const bool use_fixed_stride_handles,
       const BlockBasedTableOptions& table_opt);
 
   // Index builder will construct a set of blocks which contain:
@@ -125,7 +128,7 @@ class ShortenedIndexBuilder : public IndexBuilder {
       const int index_block_restart_interval, const uint32_t format_version,
       const bool use_value_delta_encoding,
       BlockBasedTableOptions::IndexShorteningMode shortening_mode,
-      bool include_first_key)
+      bool include_first_key, bool use_fixed_stride_handles = false)
       : IndexBuilder(comparator),
         index_block_builder_(index_block_restart_interval,
                              true /*use_delta_encoding*/,
@@ -134,8 +137,15 @@ class ShortenedIndexBuilder : public IndexBuilder {
                                          true /*use_delta_encoding*/,
                                          use_value_delta_encoding),
         use_value_delta_encoding_(use_value_delta_encoding),
+        use_fixed_stride_handles_(use_fixed_stride_handles),
         include_first_key_(include_first_key),
         shortening_mode_(shortening_mode) {
+    // Fixed-stride handles replace inline values entirely, so the two
+    // encodings are mutually exclusive, and the handle offsets are indexed
+    // by restart point (see IndexBlockIter::DecodeCurrentValue).
+    assert(!use_fixed_stride_handles || !use_value_delta_encoding);
+    assert(!use_fixed_stride_handles || index_block_restart_interval == 1);
+    assert(!use_fixed_stride_handles || !include_first_key);
     // Making the default true will disable the feature for old versions
     seperator_is_key_plus_seq_ = (format_version <= 2);
   }
@@ -175,7 +185,15 @@ class ShortenedIndexBuilder : public IndexBuilder {
     IndexValue entry(block_handle, current_block_first_internal_key_);
     std::string encoded_entry;
     std::string delta_encoded_entry;
-    entry.EncodeTo(&encoded_entry, include_first_key_, nullptr);
+    if (use_fixed_stride_handles_) {
+      // The handle is not stored inline; the offset goes into the
+      // fixed-stride array and the size is derived from the next offset.
+      PutFixed64(&handle_offsets_block_, block_handle.offset());
+      last_handle_end_ = block_handle.offset() + block_handle.size() +
+                         BlockBasedTable::kBlockTrailerSize;
+    } else {
+      entry.EncodeTo(&encoded_entry, include_first_key_, nullptr);
+    }
     if (use_value_delta_encoding_ && !last_encoded_handle_.IsNull()) {
       entry.EncodeTo(&delta_encoded_entry, include_first_key_,
                      &last_encoded_handle_);
@@ -204,6 +222,14 @@ class ShortenedIndexBuilder : public IndexBuilder {
       index_blocks->index_block_contents =
           index_block_builder_without_seq_.Finish();
     }
+    if (use_fixed_stride_handles_ && !handle_offsets_block_.empty()) {
+      // One trailing sentinel offset (end of the last data block plus its
+      // trailer) so readers can derive every block size, including the
+      // last, as offsets[i + 1] - offsets[i] - kBlockTrailerSize.
+      PutFixed64(&handle_offsets_block_, last_handle_end_);
+      index_blocks->meta_blocks.insert(
+          {kIndexHandleOffsetsBlock.c_str(), handle_offsets_block_});
+    }
     index_size_ = index_blocks->index_block_contents.size();
     return Status::OK();
   }
@@ -229,11 +255,17 @@ class ShortenedIndexBuilder : public IndexBuilder {
   BlockBuilder index_block_builder_;
   BlockBuilder index_block_builder_without_seq_;
   const bool use_value_delta_encoding_;
+  const bool use_fixed_stride_handles_;
   bool seperator_is_key_plus_seq_;
   const bool include_first_key_;
   BlockBasedTableOptions::IndexShorteningMode shortening_mode_;
   BlockHandle last_encoded_handle_ = BlockHandle::NullBlockHandle();
   std::string current_block_first_internal_key_;
+  // Fixed-stride (8 bytes per entry) data block offsets, emitted as the
+  // kIndexHandleOffsetsBlock meta block when fixed-stride handles are in
+  // use; empty otherwise.
+  std::string handle_offsets_block_;
+  uint64_t last_handle_end_ = 0;
 };
 
 // HashIndexBuilder contains a binary-searchable primary index and the
@@ -364,6 +396,85 @@ class HashIndexBuilder : public IndexBuilder {
   uint64_t current_restart_index_ = 0;
 };
 
+// WholeKeyHashIndexBuilder contains a binary-searchable primary index and a
+// bucketed hash index over the whole user keys, serialized as the
+// kWholeKeyHashIndexBlock meta block (see WholeKeyHashIndex for the format
+// and lookup semantics). It records one (key hash, index entry ordinal)
+// pair per distinct user key; a user key spanning data blocks records only
+// the first block it appears in, and the reader walks forward from there.
+//
+// The hash index matches exact user key bytes, which user-defined
+// timestamps would defeat (a query carries a different timestamp than the
+// stored keys), so building is skipped for such comparators and readers
+// silently fall back to pure binary search.
+class WholeKeyHashIndexBuilder : public IndexBuilder {
+ public:
+  explicit WholeKeyHashIndexBuilder(
+      const InternalKeyComparator* comparator,
+      int index_block_restart_interval, int format_version,
+      bool use_value_delta_encoding,
+      BlockBasedTableOptions::IndexShorteningMode shortening_mode)
+      : IndexBuilder(comparator),
+        primary_index_builder_(comparator, index_block_restart_interval,
+                               format_version, use_value_delta_encoding,
+                               shortening_mode, /* include_first_key */ false),
+        enabled_(comparator->user_comparator()->timestamp_size() == 0) {}
+
+  virtual void AddIndexEntry(std::string* last_key_in_current_block,
+                             const Slice* first_key_in_next_block,
+                             const BlockHandle& block_handle) override {
+    ++current_entry_;
+    // Deliberately not clearing last_user_key_: a user key spanning the
+    // block boundary must keep the ordinal of the first block it is in.
+    primary_index_builder_.AddIndexEntry(last_key_in_current_block,
+                                         first_key_in_next_block, block_handle);
+  }
+
+  virtual void OnKeyAdded(const Slice& key) override {
+    if (!enabled_) {
+      return;
+    }
+    Slice user_key = ExtractUserKey(key);
+    if (records_.empty() || user_key != last_user_key_) {
+      records_.emplace_back(WholeKeyHashIndex::KeyHash(user_key),
+                            static_cast<uint32_t>(current_entry_));
+      last_user_key_.assign(user_key.data(), user_key.size());
+    }
+  }
+
+  virtual Status Finish(
+      IndexBlocks* index_blocks,
+      const BlockHandle& last_partition_block_handle) override {
+    Status s = primary_index_builder_.Finish(index_blocks,
+                                             last_partition_block_handle);
+    if (enabled_ && !records_.empty()) {
+      WholeKeyHashIndex::SerializeIndex(records_, &hash_index_block_);
+      index_blocks->meta_blocks.insert(
+          {kWholeKeyHashIndexBlock.c_str(), hash_index_block_});
+    }
+    return s;
+  }
+
+  virtual size_t IndexSize() const override {
+    return primary_index_builder_.IndexSize() + hash_index_block_.size();
+  }
+
+  virtual bool seperator_is_key_plus_seq() override {
+    return primary_index_builder_.seperator_is_key_plus_seq();
+  }
+
+ private:
+  ShortenedIndexBuilder primary_index_builder_;
+  // False when the comparator precludes exact-bytes hash matching; the
+  // primary index is then all that gets written.
+  const bool enabled_;
+  // (key hash, index entry ordinal), one per distinct user key.
+  std::vector<std::pair<uint32_t, uint32_t>> records_;
+  std::string last_user_key_;
+  std::string hash_index_block_;
+  uint64_t current_entry_ = 0;
+};
+
 /**
  * IndexBuilder for two-level indexing. Internally it creates a new index for
  * each partition and Finish then in order when Finish is called on it
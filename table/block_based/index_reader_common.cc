@@ -8,6 +8,9 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/index_reader_common.h"
 
+#include "table/block_fetcher.h"
+#include "table/meta_blocks.h"
+
 namespace ROCKSDB_NAMESPACE {
 Status BlockBasedTable::IndexReaderCommon::ReadIndexBlock(
     const BlockBasedTable* table, FilePrefetchBuffer* prefetch_buffer,
@@ -32,6 +35,50 @@ Status BlockBasedTable::IndexReaderCommon::ReadIndexBlock(
   return s;
 }
 
+Status BlockBasedTable::IndexReaderCommon::ReadIndexHandleOffsets(
+    const BlockBasedTable* table, FilePrefetchBuffer* prefetch_buffer,
+    InternalIterator* meta_index_iter, std::string* handle_offsets) {
+  assert(table != nullptr);
+  assert(handle_offsets != nullptr);
+  handle_offsets->clear();
+
+  if (meta_index_iter == nullptr) {
+    return Status::OK();
+  }
+
+  BlockHandle offsets_handle;
+  if (!FindMetaBlock(meta_index_iter, kIndexHandleOffsetsBlock,
+                     &offsets_handle)
+           .ok()) {
+    // Not present: the index stores full handles inline.
+    return Status::OK();
+  }
+
+  const Rep* const rep = table->get_rep();
+  assert(rep != nullptr);
+
+  BlockContents offsets_contents;
+  BlockFetcher offsets_block_fetcher(
+      rep->file.get(), prefetch_buffer, rep->footer, ReadOptions(),
+      offsets_handle, &offsets_contents, rep->ioptions, true /*decompress*/,
+      true /*maybe_compressed*/, BlockType::kIndex,
+      UncompressionDict::GetEmptyDict(), rep->persistent_cache_options,
+      GetMemoryAllocator(rep->table_options));
+  const Status s = offsets_block_fetcher.ReadBlockContents();
+  if (!s.ok()) {
+    return s;
+  }
+
+  // One 8-byte offset per index entry plus the trailing sentinel offset.
+  if (offsets_contents.data.size() < 2 * sizeof(uint64_t) ||
+      offsets_contents.data.size() % sizeof(uint64_t) != 0) {
+    return Status::Corruption("Invalid index handle offsets block");
+  }
+  handle_offsets->assign(offsets_contents.data.data(),
+                         offsets_contents.data.size());
+  return Status::OK();
+}
+
 Status BlockBasedTable::IndexReaderCommon::GetOrReadIndexBlock(
     bool no_io, Env::IOPriority rate_limiter_priority, GetContext* get_context,
     BlockCacheLookupContext* lookup_context,
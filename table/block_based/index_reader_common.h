@@ -33,6 +33,15 @@ class BlockBasedTable::IndexReaderCommon : public BlockBasedTable::IndexReader {
                                BlockCacheLookupContext* lookup_context,
                                CachableEntry<Block>* index_block);
 
+  // Reads the optional fixed-stride handle offsets meta block that is
+  // written when BlockBasedTableOptions::use_fixed_stride_index_handles is
+  // in effect (see IndexBlockIter). *handle_offsets is left empty when the
+  // table has no such block, i.e. the index stores handles inline.
+  static Status ReadIndexHandleOffsets(const BlockBasedTable* table,
+                                       FilePrefetchBuffer* prefetch_buffer,
+                                       InternalIterator* meta_index_iter,
+                                       std::string* handle_offsets);
+
   const BlockBasedTable* table() const { return table_; }
 
   const InternalKeyComparator* internal_comparator() const {
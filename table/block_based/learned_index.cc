@@ -0,0 +1,166 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#include "table/block_based/learned_index.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ROCKSDB_NAMESPACE {
+
+uint64_t LearnedIndex::KeyPrefix(const Slice& user_key) {
+  uint64_t prefix = 0;
+  const size_t n = std::min(user_key.size(), sizeof(uint64_t));
+  for (size_t i = 0; i < n; ++i) {
+    prefix |= static_cast<uint64_t>(static_cast<unsigned char>(user_key[i]))
+              << (8 * (sizeof(uint64_t) - 1 - i));
+  }
+  return prefix;
+}
+
+void LearnedIndex::Predict(uint64_t prefix, uint32_t* begin,
+                           uint32_t* end) const {
+  assert(!segments_.empty());
+  assert(num_keys_ > 0);
+  // Find the last segment whose start prefix is <= the target prefix. If the
+  // target is below every segment, the first segment is used; its prediction
+  // clamps to position 0.
+  size_t left = 0;
+  size_t right = segments_.size() - 1;
+  while (left < right) {
+    size_t mid = left + (right - left + 1) / 2;
+    if (segments_[mid].start_prefix <= prefix) {
+      left = mid;
+    } else {
+      right = mid - 1;
+    }
+  }
+  const Segment& seg = segments_[left];
+
+  double pred = static_cast<double>(seg.first_pos);
+  if (prefix > seg.start_prefix) {
+    pred += seg.slope * static_cast<double>(prefix - seg.start_prefix);
+  }
+  // Clamp into the range of positions the segment actually covers, plus one:
+  // a target beyond the segment's last key belongs just after it. This keeps
+  // predictions monotonic across segment boundaries, which the correctness
+  // guarantee relies on.
+  pred = std::max(pred, static_cast<double>(seg.first_pos));
+  pred = std::min(pred, static_cast<double>(seg.last_pos) + 1);
+  const uint64_t pos = static_cast<uint64_t>(pred + 0.5);
+
+  // One extra position on each side absorbs rounding and the off-by-one
+  // between a key's position and a target's insertion position.
+  *begin = pos > kEpsilon + 1 ? static_cast<uint32_t>(pos - kEpsilon - 1) : 0;
+  *end = static_cast<uint32_t>(
+      std::min(pos + kEpsilon + 1, static_cast<uint64_t>(num_keys_ - 1)));
+}
+
+size_t LearnedIndex::ApproximateMemoryUsage() const {
+  return sizeof(*this) + segments_.capacity() * sizeof(Segment);
+}
+
+LearnedIndexBuilder::LearnedIndexBuilder()
+    : seg_start_prefix_(0),
+      seg_first_pos_(0),
+      seg_last_pos_(0),
+      slope_lo_(0),
+      slope_hi_(0),
+      slope_bounded_(false),
+      in_segment_(false),
+      last_prefix_(0),
+      prefix_run_len_(0),
+      num_keys_(0),
+      infeasible_(false) {}
+
+void LearnedIndexBuilder::CloseSegment() {
+  assert(in_segment_);
+  LearnedIndex::Segment seg;
+  seg.start_prefix = seg_start_prefix_;
+  seg.slope = slope_bounded_ ? (slope_lo_ + slope_hi_) / 2 : slope_lo_;
+  seg.first_pos = seg_first_pos_;
+  seg.last_pos = seg_last_pos_;
+  segments_.push_back(seg);
+  in_segment_ = false;
+}
+
+void LearnedIndexBuilder::Add(const Slice& user_key) {
+  if (infeasible_) {
+    return;
+  }
+  const uint64_t prefix = LearnedIndex::KeyPrefix(user_key);
+  const uint32_t pos = num_keys_++;
+
+  if (pos > 0 && prefix == last_prefix_) {
+    // The prefix does not distinguish these keys, so the model cannot place
+    // a target within the run; it is only safe if the whole run fits inside
+    // the epsilon band around a single prediction.
+    if (++prefix_run_len_ > LearnedIndex::kEpsilon) {
+      infeasible_ = true;
+      return;
+    }
+  } else {
+    if (pos > 0 && prefix < last_prefix_) {
+      // Keys are bytewise ascending, so prefixes must be non-decreasing.
+      assert(false);
+      infeasible_ = true;
+      return;
+    }
+    prefix_run_len_ = 1;
+    last_prefix_ = prefix;
+  }
+
+  if (!in_segment_) {
+    seg_start_prefix_ = prefix;
+    seg_first_pos_ = pos;
+    seg_last_pos_ = pos;
+    slope_lo_ = 0;
+    slope_hi_ = 0;
+    slope_bounded_ = false;
+    in_segment_ = true;
+    return;
+  }
+
+  if (prefix == seg_start_prefix_) {
+    // The segment predicts first_pos for this prefix regardless of slope;
+    // the run length check above already bounds the error by kEpsilon.
+    seg_last_pos_ = pos;
+    return;
+  }
+
+  // Narrow the feasible slope interval so that this key's prediction stays
+  // within kEpsilon of `pos`.
+  const double dx = static_cast<double>(prefix - seg_start_prefix_);
+  const double dy = static_cast<double>(pos - seg_first_pos_);
+  const double lo = std::max(slope_lo_, (dy - LearnedIndex::kEpsilon) / dx);
+  const double hi_cand = (dy + LearnedIndex::kEpsilon) / dx;
+  const double hi = slope_bounded_ ? std::min(slope_hi_, hi_cand) : hi_cand;
+  if (lo > hi) {
+    CloseSegment();
+    seg_start_prefix_ = prefix;
+    seg_first_pos_ = pos;
+    seg_last_pos_ = pos;
+    slope_lo_ = 0;
+    slope_hi_ = 0;
+    slope_bounded_ = false;
+    in_segment_ = true;
+    return;
+  }
+  slope_lo_ = lo;
+  slope_hi_ = hi;
+  slope_bounded_ = true;
+  seg_last_pos_ = pos;
+}
+
+LearnedIndex* LearnedIndexBuilder::Finish() {
+  if (infeasible_ || num_keys_ == 0) {
+    return nullptr;
+  }
+  if (in_segment_) {
+    CloseSegment();
+  }
+  return new LearnedIndex(std::move(segments_), num_keys_);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
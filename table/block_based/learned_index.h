@@ -0,0 +1,97 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A piecewise linear model over the first keys of an index block, used by
+// kLearnedSearch to narrow a seek down to a few restart points instead of
+// binary searching all of them. Each indexed key is mapped to a fixed-width
+// integer (its first eight bytes, big endian) and the model guarantees that
+// the prediction for any indexed key is within kEpsilon positions of its
+// true position. From that, Predict() derives a restart point range that is
+// guaranteed to contain the result of a full binary search for any target
+// key, as long as key bytes order the same way the comparator does (i.e.
+// bytewise, no user-defined timestamps).
+//
+// The model is built in memory when the table is opened; nothing about it is
+// persisted, so the on-disk index format is the same as kBinarySearch.
+class LearnedIndex {
+ public:
+  // Maximum distance between the model's prediction for an indexed key and
+  // the key's true position.
+  static const uint32_t kEpsilon = 8;
+
+  // Maps the first eight bytes of a user key to an integer whose ordering
+  // matches bytewise key ordering. Shorter keys are zero padded.
+  static uint64_t KeyPrefix(const Slice& user_key);
+
+  // Sets [*begin, *end] (both inclusive restart point indexes) such that the
+  // result of a binary search for any key with the given prefix -- the
+  // largest index whose key is <= the target -- is guaranteed to lie in
+  // [*begin - 1, *end]. (*begin - 1 may be -1 when the target is smaller
+  // than every indexed key.)
+  void Predict(uint64_t prefix, uint32_t* begin, uint32_t* end) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  friend class LearnedIndexBuilder;
+
+  struct Segment {
+    uint64_t start_prefix;  // prefix of the first key covered
+    double slope;           // positions per unit of prefix
+    uint32_t first_pos;     // position of the first key covered
+    uint32_t last_pos;      // position of the last key covered
+  };
+
+  LearnedIndex(std::vector<Segment>&& segments, uint32_t num_keys)
+      : segments_(std::move(segments)), num_keys_(num_keys) {}
+
+  std::vector<Segment> segments_;
+  uint32_t num_keys_;
+};
+
+// Builds a LearnedIndex from keys fed in ascending order, one per restart
+// point. Uses the standard greedy fit: a segment's feasible slope interval
+// is narrowed by every key it covers and a new segment starts when the
+// interval becomes empty. Runs of keys sharing an eight byte prefix longer
+// than kEpsilon cannot be predicted from the prefix alone; such key sets are
+// rejected and the caller falls back to plain binary search.
+class LearnedIndexBuilder {
+ public:
+  LearnedIndexBuilder();
+
+  // Keys must be added in ascending order.
+  void Add(const Slice& user_key);
+
+  // Returns the model, or nullptr when no usable model could be built.
+  // The builder must not be reused afterwards.
+  LearnedIndex* Finish();
+
+ private:
+  void CloseSegment();
+
+  std::vector<LearnedIndex::Segment> segments_;
+  uint64_t seg_start_prefix_;
+  uint32_t seg_first_pos_;
+  uint32_t seg_last_pos_;
+  double slope_lo_;
+  double slope_hi_;
+  bool slope_bounded_;  // whether slope_hi_ has been constrained yet
+  bool in_segment_;
+  uint64_t last_prefix_;
+  uint32_t prefix_run_len_;
+  uint32_t num_keys_;
+  bool infeasible_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
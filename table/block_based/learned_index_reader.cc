@@ -0,0 +1,105 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#include "table/block_based/learned_index_reader.h"
+
+#include <cstring>
+
+namespace ROCKSDB_NAMESPACE {
+Status LearnedIndexReader::Create(
+    const BlockBasedTable* table, const ReadOptions& ro,
+    FilePrefetchBuffer* prefetch_buffer, InternalIterator* meta_index_iter,
+    bool use_cache, bool prefetch, bool pin,
+    BlockCacheLookupContext* lookup_context,
+    std::unique_ptr<IndexReader>* index_reader) {
+  assert(table != nullptr);
+  assert(table->get_rep());
+  assert(!pin || prefetch);
+  assert(index_reader != nullptr);
+  // Only consumed by the assertion above: the model build reads the index
+  // block unconditionally.
+  (void)prefetch;
+
+  const BlockBasedTable::Rep* rep = table->get_rep();
+
+  // The model is built from the index block contents, so the block is read
+  // here even when it would otherwise be loaded lazily on first use.
+  CachableEntry<Block> index_block;
+  const Status s =
+      ReadIndexBlock(table, prefetch_buffer, ro, use_cache,
+                     /*get_context=*/nullptr, lookup_context, &index_block);
+  if (!s.ok()) {
+    return s;
+  }
+
+  // Note, failure to build the model does not need to be a hard error; seeks
+  // simply fall back to the full binary search over the index block.
+  std::unique_ptr<LearnedIndex> model;
+  const Comparator* ucmp = rep->internal_comparator.user_comparator();
+  if (ucmp->timestamp_size() == 0 &&
+      strcmp(ucmp->Name(), "leveldb.BytewiseComparator") == 0) {
+    IndexBlockIter biter;
+    index_block.GetValue()->NewIndexIterator(
+        ucmp, rep->get_global_seqno(BlockType::kIndex), &biter,
+        /*stats=*/nullptr, /*total_order_seek=*/true, rep->index_has_first_key,
+        rep->index_key_includes_seq, rep->index_value_is_full);
+    LearnedIndexBuilder builder;
+    for (biter.SeekToFirst(); biter.Valid(); biter.Next()) {
+      builder.Add(biter.user_key());
+    }
+    if (biter.status().ok()) {
+      model.reset(builder.Finish());
+    }
+  }
+
+  if (use_cache && !pin) {
+    index_block.Reset();
+  }
+
+  LearnedIndexReader* const reader =
+      new LearnedIndexReader(table, std::move(index_block));
+  reader->model_ = std::move(model);
+  index_reader->reset(reader);
+
+  return ReadIndexHandleOffsets(table, prefetch_buffer, meta_index_iter,
+                                &reader->handle_offsets_);
+}
+
+InternalIteratorBase<IndexValue>* LearnedIndexReader::NewIterator(
+    const ReadOptions& read_options, bool /* disable_prefix_seek */,
+    IndexBlockIter* iter, GetContext* get_context,
+    BlockCacheLookupContext* lookup_context) {
+  const BlockBasedTable::Rep* rep = table()->get_rep();
+  const bool no_io = (read_options.read_tier == kBlockCacheTier);
+  CachableEntry<Block> index_block;
+  const Status s =
+      GetOrReadIndexBlock(no_io, read_options.rate_limiter_priority,
+                          get_context, lookup_context, &index_block);
+  if (!s.ok()) {
+    if (iter != nullptr) {
+      iter->Invalidate(s);
+      return iter;
+    }
+
+    return NewErrorInternalIterator<IndexValue>(s);
+  }
+
+  Statistics* kNullStats = nullptr;
+  // We don't return pinned data from index blocks, so no need
+  // to set `block_contents_pinned`.
+  auto it = index_block.GetValue()->NewIndexIterator(
+      internal_comparator()->user_comparator(),
+      rep->get_global_seqno(BlockType::kIndex), iter, kNullStats, true,
+      index_has_first_key(), index_key_includes_seq(), index_value_is_full(),
+      false /* block_contents_pinned */, nullptr /* prefix_index */,
+      model_.get(),
+      handle_offsets_.empty() ? nullptr : handle_offsets_.data(),
+      static_cast<uint32_t>(handle_offsets_.size() / sizeof(uint64_t)));
+
+  assert(it != nullptr);
+  index_block.TransferTo(it);
+
+  return it;
+}
+}  // namespace ROCKSDB_NAMESPACE
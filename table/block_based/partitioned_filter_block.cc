@@ -16,7 +16,9 @@
 #include "rocksdb/filter_policy.h"
 #include "table/block_based/block.h"
 #include "table/block_based/block_based_table_reader.h"
+#include "util/bloom_impl.h"
 #include "util/coding.h"
+#include "util/hash.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -25,7 +27,7 @@ PartitionedFilterBlockBuilder::PartitionedFilterBlockBuilder(
     FilterBitsBuilder* filter_bits_builder, int index_block_restart_interval,
     const bool use_value_delta_encoding,
     PartitionedIndexBuilder* const p_index_builder,
-    const uint32_t partition_size)
+    const uint32_t partition_size, const uint32_t fence_filter_bits_per_key)
     : FullFilterBlockBuilder(_prefix_extractor, whole_key_filtering,
                              filter_bits_builder),
       index_on_filter_block_builder_(index_block_restart_interval,
@@ -36,6 +38,7 @@ PartitionedFilterBlockBuilder::PartitionedFilterBlockBuilder(
                                                  use_value_delta_encoding),
       p_index_builder_(p_index_builder),
       keys_added_to_partition_(0),
+      fence_filter_bits_per_key_(fence_filter_bits_per_key),
       total_added_in_built_(0) {
   keys_per_partition_ = static_cast<uint32_t>(
       filter_bits_builder_->ApproximateNumEntries(partition_size));
@@ -115,6 +118,11 @@ void PartitionedFilterBlockBuilder::Add(const Slice& key) {
 void PartitionedFilterBlockBuilder::AddKey(const Slice& key) {
   FullFilterBlockBuilder::AddKey(key);
   keys_added_to_partition_++;
+  if (fence_filter_bits_per_key_ > 0) {
+    // All whole keys and prefixes funnel through here, so the fence filter
+    // covers everything the partitioned filters do.
+    fence_filter_hashes_.push_back(GetSliceHash64(key));
+  }
 }
 
 size_t PartitionedFilterBlockBuilder::EstimateEntriesAdded() {
@@ -184,6 +192,36 @@ Slice PartitionedFilterBlockBuilder::Finish(
   }
 }
 
+Slice PartitionedFilterBlockBuilder::FinishFenceFilter(
+    std::unique_ptr<const char[]>* filter_data) {
+  assert(filter_data);
+  if (fence_filter_bits_per_key_ == 0 || fence_filter_hashes_.empty()) {
+    return Slice();
+  }
+  // Size to the configured bits per key, rounded up to whole cache lines as
+  // FastLocalBloom requires, with a one byte num_probes trailer.
+  uint64_t len = (uint64_t{fence_filter_hashes_.size()} *
+                      fence_filter_bits_per_key_ +
+                  7) /
+                 8;
+  len = std::max(uint64_t{64}, (len + 63) / 64 * 64);
+  // Stay within the uint32_t length FastLocalBloom operates on (only
+  // reachable with absurd key counts; FP rate degrades gracefully).
+  len = std::min(len, uint64_t{0xffffffc0});
+  const int num_probes = FastLocalBloomImpl::ChooseNumProbes(
+      static_cast<int>(fence_filter_bits_per_key_ * 1000));
+  std::unique_ptr<char[]> data(new char[len + 1]());
+  for (uint64_t h : fence_filter_hashes_) {
+    FastLocalBloomImpl::AddHash(Lower32of64(h), Upper32of64(h),
+                                static_cast<uint32_t>(len), num_probes,
+                                data.get());
+  }
+  data[len] = static_cast<char>(num_probes);
+  Slice rv(data.get(), static_cast<size_t>(len) + 1);
+  filter_data->reset(data.release());
+  return rv;
+}
+
 PartitionedFilterBlockReader::PartitionedFilterBlockReader(
     const BlockBasedTable* t, CachableEntry<Block>&& filter_block)
     : FilterBlockReaderCommon(t, std::move(filter_block)) {}
@@ -294,12 +332,26 @@ Status PartitionedFilterBlockReader::GetFilterPartitionBlock(
   assert(filter_block);
   assert(filter_block->IsEmpty());
 
-  if (!filter_map_.empty()) {
-    auto iter = filter_map_.find(fltr_blk_handle.offset());
+  partition_accesses_.fetch_add(1, std::memory_order_relaxed);
+
+  std::shared_ptr<const FilterMap> filter_map =
+      std::atomic_load_explicit(&filter_map_, std::memory_order_acquire);
+  if (filter_map) {
+    auto iter = filter_map->find(fltr_blk_handle.offset());
     // This is a possible scenario since block cache might not have had space
     // for the partition
-    if (iter != filter_map_.end()) {
-      filter_block->SetUnownedValue(iter->second.GetValue());
+    if (iter != filter_map->end()) {
+      Cache* block_cache = table()->get_rep()->table_options.block_cache.get();
+      Cache::Handle* cache_handle = iter->second.GetCacheHandle();
+      if (block_cache != nullptr && cache_handle != nullptr) {
+        // Take an extra reference so the returned entry stays valid even if
+        // the partitions are unpinned while the caller is using it.
+        block_cache->Ref(cache_handle);
+        filter_block->SetCachedValue(iter->second.GetValue(), block_cache,
+                                     cache_handle);
+      } else {
+        filter_block->SetUnownedValue(iter->second.GetValue());
+      }
       return Status::OK();
     }
   }
@@ -320,11 +372,32 @@ Status PartitionedFilterBlockReader::GetFilterPartitionBlock(
   return s;
 }
 
+bool PartitionedFilterBlockReader::FenceMayMatch(const Slice& entry) const {
+  const BlockBasedTable::Rep* rep = table()->get_rep();
+  assert(rep);
+  if (rep->fence_filter_data.empty()) {
+    return true;
+  }
+  const uint64_t h = GetSliceHash64(entry);
+  return FastLocalBloomImpl::HashMayMatch(
+      Lower32of64(h), Upper32of64(h),
+      static_cast<uint32_t>(rep->fence_filter_data.size()),
+      static_cast<int>(rep->fence_filter_num_probes),
+      rep->fence_filter_data.data());
+}
+
 bool PartitionedFilterBlockReader::MayMatch(
     const Slice& slice, bool no_io, const Slice* const_ikey_ptr,
     GetContext* get_context, BlockCacheLookupContext* lookup_context,
     Env::IOPriority rate_limiter_priority,
     FilterFunction filter_function) const {
+  if (!FenceMayMatch(slice)) {
+    // The whole-file fence filter rules the key/prefix out, so skip the
+    // top-level index seek and partition fetch altogether.
+    PERF_COUNTER_ADD(bloom_sst_miss_count, 1);
+    return false;
+  }
+
   CachableEntry<Block> filter_block;
   Status s = GetOrReadFilterBlock(
       no_io, get_context, lookup_context, &filter_block,
@@ -364,6 +437,30 @@ void PartitionedFilterBlockReader::MayMatch(
     BlockCacheLookupContext* lookup_context,
     Env::IOPriority rate_limiter_priority,
     FilterManyFunction filter_function) const {
+  if (!table()->get_rep()->fence_filter_data.empty()) {
+    // Let the whole-file fence filter strike out keys before any top-level
+    // index seeks or partition fetches. Keys outside the prefix extractor
+    // domain are not covered by filters and are left alone.
+    int num_fence_misses = 0;
+    for (auto iter = range->begin(); iter != range->end(); ++iter) {
+      if (prefix_extractor &&
+          !prefix_extractor->InDomain(iter->ukey_without_ts)) {
+        continue;
+      }
+      const Slice entry =
+          prefix_extractor ? prefix_extractor->Transform(iter->ukey_without_ts)
+                           : iter->ukey_without_ts;
+      if (!FenceMayMatch(entry)) {
+        range->SkipKey(iter);
+        ++num_fence_misses;
+      }
+    }
+    PERF_COUNTER_ADD(bloom_sst_miss_count, num_fence_misses);
+    if (range->empty()) {
+      return;
+    }
+  }
+
   CachableEntry<Block> filter_block;
   Status s = GetOrReadFilterBlock(
       no_io, range->begin()->get_context, lookup_context, &filter_block,
@@ -509,6 +606,10 @@ Status PartitionedFilterBlockReader::CacheDependencies(const ReadOptions& ro,
   }
 
   // After prefetch, read the partitions one by one
+  std::shared_ptr<FilterMap> filter_map;
+  if (pin) {
+    filter_map = std::make_shared<FilterMap>();
+  }
   for (biter.SeekToFirst(); biter.Valid(); biter.Next()) {
     handle = biter.value().handle;
 
@@ -528,14 +629,41 @@ Status PartitionedFilterBlockReader::CacheDependencies(const ReadOptions& ro,
     if (block.GetValue() != nullptr) {
       if (block.IsCached()) {
         if (pin) {
-          filter_map_[handle.offset()] = std::move(block);
+          (*filter_map)[handle.offset()] = std::move(block);
         }
       }
     }
   }
+  if (pin) {
+    std::atomic_store_explicit(
+        &filter_map_, std::shared_ptr<const FilterMap>(std::move(filter_map)),
+        std::memory_order_release);
+  }
   return biter.status();
 }
 
+void PartitionedFilterBlockReader::MaintainAdaptivePinning(
+    const ReadOptions& ro, bool under_pressure, uint32_t min_accesses) {
+  const uint64_t accesses = partition_accesses_.load(std::memory_order_relaxed);
+  const uint64_t delta = accesses - partition_accesses_snapshot_;
+  partition_accesses_snapshot_ = accesses;
+
+  const bool pinned =
+      std::atomic_load_explicit(&filter_map_, std::memory_order_acquire) !=
+      nullptr;
+  if (under_pressure) {
+    // Unpin cold partitions; in-flight reads keep them alive through their
+    // own map reference.
+    if (pinned && delta < min_accesses) {
+      std::atomic_store_explicit(&filter_map_,
+                                 std::shared_ptr<const FilterMap>(),
+                                 std::memory_order_release);
+    }
+  } else if (!pinned && delta >= min_accesses) {
+    CacheDependencies(ro, true /* pin */).PermitUncheckedError();
+  }
+}
+
 const InternalKeyComparator* PartitionedFilterBlockReader::internal_comparator()
     const {
   assert(table());
@@ -5,10 +5,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
@@ -30,7 +33,8 @@ class PartitionedFilterBlockBuilder : public FullFilterBlockBuilder {
       FilterBitsBuilder* filter_bits_builder, int index_block_restart_interval,
       const bool use_value_delta_encoding,
       PartitionedIndexBuilder* const p_index_builder,
-      const uint32_t partition_size);
+      const uint32_t partition_size,
+      const uint32_t fence_filter_bits_per_key = 0);
 
   virtual ~PartitionedFilterBlockBuilder();
 
@@ -59,6 +63,9 @@ class PartitionedFilterBlockBuilder : public FullFilterBlockBuilder {
     return Status::OK();
   }
 
+  Slice FinishFenceFilter(
+      std::unique_ptr<const char[]>* filter_data) override;
+
  private:
   // Filter data
   BlockBuilder index_on_filter_block_builder_;  // top-level index builder
@@ -93,6 +100,10 @@ class PartitionedFilterBlockBuilder : public FullFilterBlockBuilder {
   uint32_t keys_per_partition_;
   // The number of keys added to the last partition so far
   uint32_t keys_added_to_partition_;
+  // Bits per key for the optional whole-file fence filter; 0 disables it
+  const uint32_t fence_filter_bits_per_key_;
+  // Hashes of every key/prefix added, for building the fence filter
+  std::vector<uint64_t> fence_filter_hashes_;
   // According to the bits builders, how many keys/prefixes added
   // in all the filters we have fully built
   uint64_t total_added_in_built_;
@@ -130,6 +141,9 @@ class PartitionedFilterBlockReader : public FilterBlockReaderCommon<Block> {
 
   size_t ApproximateMemoryUsage() const override;
 
+  void MaintainAdaptivePinning(const ReadOptions& ro, bool under_pressure,
+                               uint32_t min_accesses) override;
+
  private:
   BlockHandle GetFilterPartitionHandle(const CachableEntry<Block>& filter_block,
                                        const Slice& entry) const;
@@ -140,6 +154,12 @@ class PartitionedFilterBlockReader : public FilterBlockReaderCommon<Block> {
       Env::IOPriority rate_limiter_priority,
       CachableEntry<ParsedFullFilterBlock>* filter_block) const;
 
+  // Checks the whole-file fence filter, if the file has one. Returns true
+  // when the key/prefix may be present (or there is no fence filter), false
+  // when the partitioned filter cannot match and the partition fetch can be
+  // skipped.
+  bool FenceMayMatch(const Slice& entry) const;
+
   using FilterFunction = bool (FullFilterBlockReader::*)(
       const Slice& slice, const bool no_io, const Slice* const const_ikey_ptr,
       GetContext* get_context, BlockCacheLookupContext* lookup_context,
@@ -170,9 +190,21 @@ class PartitionedFilterBlockReader : public FilterBlockReaderCommon<Block> {
   bool index_value_is_full() const;
 
  protected:
+  using FilterMap =
+      UnorderedMap<uint64_t, CachableEntry<ParsedFullFilterBlock>>;
+
   // For partition blocks pinned in cache. Can be a subset of blocks
-  // in case some fail insertion on attempt to pin.
-  UnorderedMap<uint64_t, CachableEntry<ParsedFullFilterBlock>> filter_map_;
+  // in case some fail insertion on attempt to pin. Accessed with
+  // std::atomic_load/std::atomic_store so the partitions can be unpinned by
+  // the adaptive pinning maintenance while reads are in flight; nullptr
+  // when nothing is pinned.
+  std::shared_ptr<const FilterMap> filter_map_;
+
+  // Number of filter partition fetches, for adaptive pinning.
+  mutable std::atomic<uint64_t> partition_accesses_{0};
+  // Value of partition_accesses_ at the previous maintenance pass. Only
+  // read and written by the single maintenance thread.
+  uint64_t partition_accesses_snapshot_ = 0;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
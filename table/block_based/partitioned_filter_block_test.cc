@@ -36,6 +36,7 @@ class MyPartitionedFilterBlockReader : public PartitionedFilterBlockReader {
   MyPartitionedFilterBlockReader(BlockBasedTable* t,
                                  CachableEntry<Block>&& filter_block)
       : PartitionedFilterBlockReader(t, std::move(filter_block)) {
+    auto filter_map = std::make_shared<FilterMap>();
     for (const auto& pair : blooms) {
       const uint64_t offset = pair.first;
       const std::string& bloom = pair.second;
@@ -48,8 +49,10 @@ class MyPartitionedFilterBlockReader : public PartitionedFilterBlockReader {
               BlockContents(Slice(bloom))),
           nullptr /* cache */, nullptr /* cache_handle */,
           true /* own_value */);
-      filter_map_[offset] = std::move(block);
+      (*filter_map)[offset] = std::move(block);
     }
+    std::atomic_store(&filter_map_,
+                      std::shared_ptr<const FilterMap>(std::move(filter_map)));
   }
 };
 
@@ -128,7 +131,8 @@ class PartitionedFilterBlockTest
         BloomFilterPolicy::GetBuilderFromContext(
             FilterBuildingContext(table_options_)),
         table_options_.index_block_restart_interval, !kValueDeltaEncoded,
-        p_index_builder, partition_size);
+        p_index_builder, partition_size,
+        table_options_.fence_filter_bits_per_key);
   }
 
   PartitionedFilterBlockReader* NewReader(
@@ -146,11 +150,23 @@ class PartitionedFilterBlockTest
     constexpr uint64_t file_size = 12345;
     constexpr int level = 0;
     constexpr bool immortal_table = false;
-    table_.reset(new MockedBlockBasedTable(
+    auto rep =
         new BlockBasedTable::Rep(ioptions_, env_options_, table_options_,
                                  icomp_, skip_filters, file_size, level,
-                                 immortal_table),
-        pib));
+                                 immortal_table);
+    // Install the fence filter the way PrefetchIndexAndFilterBlocks would
+    std::unique_ptr<const char[]> fence_filter_data;
+    Slice fence_filter = builder->FinishFenceFilter(&fence_filter_data);
+    if (table_options_.fence_filter_bits_per_key == 0) {
+      EXPECT_TRUE(fence_filter.empty());
+    }
+    if (!fence_filter.empty()) {
+      rep->fence_filter_num_probes =
+          static_cast<uint8_t>(fence_filter[fence_filter.size() - 1]);
+      rep->fence_filter_data.assign(fence_filter.data(),
+                                    fence_filter.size() - 1);
+    }
+    table_.reset(new MockedBlockBasedTable(rep, pib));
     BlockContents contents(slice);
     CachableEntry<Block> block(
         new Block(std::move(contents), 0 /* read_amp_bytes_per_bit */, nullptr),
@@ -426,6 +442,19 @@ TEST_P(PartitionedFilterBlockTest, PartitionCount) {
   ASSERT_EQ(partitions, num_keys - 1 /* last two keys make one flush */);
 }
 
+TEST_P(PartitionedFilterBlockTest, FenceFilter) {
+  // With the fence filter in front of the partitions, added keys must still
+  // match (the fence has no false negatives) and missing keys must still be
+  // filtered, regardless of partition layout.
+  table_options_.fence_filter_bits_per_key = 10;
+  uint64_t max_index_size = MaxIndexSize();
+  for (uint64_t i = 1; i < max_index_size + 1; i++) {
+    table_options_.metadata_block_size = i;
+    TestBlockPerKey();
+    TestBlockPerAllKeys();
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -28,6 +28,7 @@ void PartitionedIndexIterator::SeekImpl(const Slice* target) {
   }
 
   InitPartitionedIndexBlock();
+  PrefetchNextPartitionBlock();
 
   if (target) {
     block_iter_.Seek(*target);
@@ -89,9 +90,12 @@ void PartitionedIndexIterator::InitPartitionedIndexBlock() {
     //   Enabled after 2 sequential IOs when ReadOptions.readahead_size == 0.
     // Explicit user requested readahead:
     //   Enabled from the very first IO when ReadOptions.readahead_size is set.
+    // In case of async_io with implicit readahead, block_prefetcher_ will
+    // always create the prefetch buffer by setting no_sequential_checking =
+    // true, so that PrefetchNextPartitionBlock() has a buffer to read into.
     block_prefetcher_.PrefetchIfNeeded(
         rep, partitioned_index_handle, read_options_.readahead_size,
-        is_for_compaction, /*no_sequential_checking=*/false,
+        is_for_compaction, /*no_sequential_checking=*/read_options_.async_io,
         read_options_.rate_limiter_priority);
     Status s;
     table_->NewDataBlockIterator<IndexBlockIter>(
@@ -139,10 +143,41 @@ void PartitionedIndexIterator::FindBlockForward() {
     }
 
     InitPartitionedIndexBlock();
+    PrefetchNextPartitionBlock();
     block_iter_.SeekToFirst();
   } while (!block_iter_.Valid());
 }
 
+void PartitionedIndexIterator::PrefetchNextPartitionBlock() {
+  if (!read_options_.async_io ||
+      block_prefetcher_.prefetch_buffer() == nullptr) {
+    return;
+  }
+  assert(index_iter_->Valid());
+  // The top-level index block is always resident in memory, so peeking at
+  // the next partition's handle is cheap.
+  index_iter_->Next();
+  if (index_iter_->Valid()) {
+    BlockHandle next_handle = index_iter_->value().handle;
+    auto* rep = table_->get_rep();
+    IOOptions opts;
+    IOStatus io_s = rep->file->PrepareIOOptions(read_options_, opts);
+    if (io_s.ok()) {
+      // Fire and forget: Status::TryAgain indicates the read has been
+      // submitted, and the partition will be picked up from the buffer once
+      // the scan reaches it. Any failure here simply falls back to the
+      // synchronous read in InitPartitionedIndexBlock().
+      Slice result;
+      Status s = block_prefetcher_.prefetch_buffer()->PrefetchAsync(
+          opts, rep->file.get(), next_handle.offset(),
+          BlockBasedTable::BlockSizeWithTrailer(next_handle), &result);
+      s.PermitUncheckedError();
+    }
+    io_s.PermitUncheckedError();
+  }
+  index_iter_->Prev();
+}
+
 void PartitionedIndexIterator::FindKeyBackward() {
   while (!block_iter_.Valid()) {
     if (!block_iter_.status().ok()) {
@@ -154,6 +154,10 @@ class PartitionedIndexIterator : public InternalIteratorBase<IndexValue> {
   void SeekImpl(const Slice* target);
 
   void InitPartitionedIndexBlock();
+  // If ReadOptions.async_io is set, issue an asynchronous read for the next
+  // index partition so that forward scans don't stall for a synchronous
+  // block read at every partition boundary.
+  void PrefetchNextPartitionBlock();
   void FindKeyForward();
   void FindBlockForward();
   void FindKeyBackward();
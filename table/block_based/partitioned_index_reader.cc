@@ -64,13 +64,16 @@ InternalIteratorBase<IndexValue>* PartitionIndexReader::NewIterator(
   InternalIteratorBase<IndexValue>* it = nullptr;
 
   Statistics* kNullStats = nullptr;
+  partition_accesses_.fetch_add(1, std::memory_order_relaxed);
+  std::shared_ptr<const PartitionMap> partition_map =
+      std::atomic_load_explicit(&partition_map_, std::memory_order_acquire);
   // Filters are already checked before seeking the index
-  if (!partition_map_.empty()) {
+  if (partition_map && !partition_map->empty()) {
     // We don't return pinned data from index blocks, so no need
     // to set `block_contents_pinned`.
     it = NewTwoLevelIterator(
-        new BlockBasedTable::PartitionedIndexIteratorState(table(),
-                                                           &partition_map_),
+        new BlockBasedTable::PartitionedIndexIteratorState(
+            table(), std::move(partition_map)),
         index_block.GetValue()->NewIndexIterator(
             internal_comparator()->user_comparator(),
             rep->get_global_seqno(BlockType::kIndex), nullptr, kNullStats, true,
@@ -173,7 +176,8 @@ Status PartitionIndexReader::CacheDependencies(const ReadOptions& ro,
   }
 
   // For saving "all or nothing" to partition_map_
-  UnorderedMap<uint64_t, CachableEntry<Block>> map_in_progress;
+  std::shared_ptr<PartitionMap> map_in_progress =
+      std::make_shared<PartitionMap>();
 
   // After prefetch, read the partitions one by one
   biter.SeekToFirst();
@@ -199,17 +203,43 @@ Status PartitionIndexReader::CacheDependencies(const ReadOptions& ro,
       // compressed (mmap eligible)
       if (block.IsCached() || block.GetOwnValue()) {
         if (pin) {
-          map_in_progress[handle.offset()] = std::move(block);
+          (*map_in_progress)[handle.offset()] = std::move(block);
         }
       }
     }
   }
   Status s = biter.status();
   // Save (pin) them only if everything checks out
-  if (map_in_progress.size() == partition_count && s.ok()) {
-    std::swap(partition_map_, map_in_progress);
+  if (map_in_progress->size() == partition_count && s.ok()) {
+    std::atomic_store_explicit(
+        &partition_map_,
+        std::shared_ptr<const PartitionMap>(std::move(map_in_progress)),
+        std::memory_order_release);
   }
   return s;
 }
 
+void PartitionIndexReader::MaintainAdaptivePinning(const ReadOptions& ro,
+                                                   bool under_pressure,
+                                                   uint32_t min_accesses) {
+  const uint64_t accesses = partition_accesses_.load(std::memory_order_relaxed);
+  const uint64_t delta = accesses - partition_accesses_snapshot_;
+  partition_accesses_snapshot_ = accesses;
+
+  const bool pinned =
+      std::atomic_load_explicit(&partition_map_, std::memory_order_acquire) !=
+      nullptr;
+  if (under_pressure) {
+    // Unpin cold partitions; in-flight iterators keep them alive through
+    // their own map reference.
+    if (pinned && delta < min_accesses) {
+      std::atomic_store_explicit(&partition_map_,
+                                 std::shared_ptr<const PartitionMap>(),
+                                 std::memory_order_release);
+    }
+  } else if (!pinned && delta >= min_accesses) {
+    CacheDependencies(ro, true /* pin */).PermitUncheckedError();
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -7,6 +7,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #pragma once
+#include <atomic>
+#include <memory>
+
 #include "table/block_based/index_reader_common.h"
 #include "util/hash_containers.h"
 
@@ -31,6 +34,10 @@ class PartitionIndexReader : public BlockBasedTable::IndexReaderCommon {
       BlockCacheLookupContext* lookup_context) override;
 
   Status CacheDependencies(const ReadOptions& ro, bool pin) override;
+
+  void MaintainAdaptivePinning(const ReadOptions& ro, bool under_pressure,
+                               uint32_t min_accesses) override;
+
   size_t ApproximateMemoryUsage() const override {
     size_t usage = ApproximateIndexBlockMemoryUsage();
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
@@ -47,9 +54,21 @@ class PartitionIndexReader : public BlockBasedTable::IndexReaderCommon {
                        CachableEntry<Block>&& index_block)
       : IndexReaderCommon(t, std::move(index_block)) {}
 
+  using PartitionMap = UnorderedMap<uint64_t, CachableEntry<Block>>;
+
   // For partition blocks pinned in cache. This is expected to be "all or
-  // none" so that !partition_map_.empty() can use an iterator expecting
-  // all partitions to be saved here.
-  UnorderedMap<uint64_t, CachableEntry<Block>> partition_map_;
+  // none" so that a non-null map can be used by an iterator expecting all
+  // partitions to be saved here. Accessed with
+  // std::atomic_load/std::atomic_store so the partitions can be unpinned by
+  // the adaptive pinning maintenance while iterators are in flight; each
+  // iterator shares ownership of the map it was created with.
+  std::shared_ptr<const PartitionMap> partition_map_;
+
+  // Number of index partition accesses (iterator creations), for adaptive
+  // pinning.
+  std::atomic<uint64_t> partition_accesses_{0};
+  // Value of partition_accesses_ at the previous maintenance pass. Only
+  // read and written by the single maintenance thread.
+  uint64_t partition_accesses_snapshot_ = 0;
 };
 }  // namespace ROCKSDB_NAMESPACE
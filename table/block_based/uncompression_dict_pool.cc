@@ -0,0 +1,68 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+
+#include "table/block_based/uncompression_dict_pool.h"
+
+#include "util/compression.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+std::shared_ptr<UncompressionDict> UncompressionDictPool::GetOrCreate(
+    const Slice& raw_dict, bool using_zstd) {
+  const uint64_t key = GetSliceNPHash64(raw_dict);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = pool_.find(key);
+  if (it != pool_.end()) {
+    std::shared_ptr<UncompressionDict> dict = it->second.lock();
+    if (dict) {
+      if (dict->GetRawDict() == raw_dict) {
+        return dict;
+      }
+      // Hash collision between two live dictionaries with different
+      // contents. Hand out an unshared copy rather than turning the slot
+      // into a collision chain; this should be vanishingly rare.
+      return std::make_shared<UncompressionDict>(raw_dict.ToString(),
+                                                 using_zstd);
+    }
+    // The last user of the previous dictionary with this hash is gone;
+    // fall through and repopulate the slot.
+  }
+
+  auto dict =
+      std::make_shared<UncompressionDict>(raw_dict.ToString(), using_zstd);
+  pool_[key] = dict;
+
+  // Lazily drop entries whose last user has gone away so the map does not
+  // grow without bound as table files are deleted.
+  if (pool_.size() >= sweep_watermark_) {
+    for (auto sweep_it = pool_.begin(); sweep_it != pool_.end();) {
+      if (sweep_it->second.expired()) {
+        sweep_it = pool_.erase(sweep_it);
+      } else {
+        ++sweep_it;
+      }
+    }
+    sweep_watermark_ = std::max<size_t>(16, pool_.size() * 2);
+  }
+
+  return dict;
+}
+
+size_t UncompressionDictPool::TEST_LiveEntryCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t live = 0;
+  for (const auto& entry : pool_) {
+    if (!entry.second.expired()) {
+      ++live;
+    }
+  }
+  return live;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,51 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct UncompressionDict;
+
+// A content-hash-deduplicated pool of digested uncompression dictionaries.
+// Table readers that pin their dictionary at open time share a single
+// (digested) copy per distinct dictionary content instead of each pinning
+// its own copy in the block cache. The pool itself only holds weak
+// references: a dictionary stays alive for as long as at least one table
+// reader uses it, and its slot is reclaimed lazily afterwards.
+//
+// One instance is owned by each BlockBasedTableFactory, so the pool is
+// shared by all table readers opened through the same factory (typically
+// one column family). Thread-safe.
+class UncompressionDictPool {
+ public:
+  // Returns a shared dictionary whose content equals `raw_dict`, creating
+  // (and digesting) one if no live pool entry matches. The returned
+  // dictionary is immutable and must not be modified by callers.
+  std::shared_ptr<UncompressionDict> GetOrCreate(const Slice& raw_dict,
+                                                 bool using_zstd);
+
+  // Number of live (not yet expired) dictionaries in the pool. Exposed for
+  // testing.
+  size_t TEST_LiveEntryCount() const;
+
+ private:
+  mutable std::mutex mutex_;
+  // Keyed by a hash of the dictionary content; a (rare) collision between
+  // two live dictionaries falls back to an unshared copy, see GetOrCreate().
+  std::unordered_map<uint64_t, std::weak_ptr<UncompressionDict>> pool_;
+  // Expired entries are swept whenever the map grows past this watermark.
+  size_t sweep_watermark_ = 16;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
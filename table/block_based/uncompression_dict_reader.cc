@@ -24,6 +24,7 @@ Status UncompressionDictReader::Create(
   assert(uncompression_dict_reader);
 
   CachableEntry<UncompressionDict> uncompression_dict;
+  std::shared_ptr<UncompressionDict> pooled_dict;
   if (prefetch || !use_cache) {
     const Status s = ReadUncompressionDictionary(
         table, prefetch_buffer, ro, use_cache, nullptr /* get_context */,
@@ -32,13 +33,23 @@ Status UncompressionDictReader::Create(
       return s;
     }
 
-    if (use_cache && !pin) {
+    const BlockBasedTable::Rep* const rep = table->get_rep();
+    if (rep->uncompression_dict_pool != nullptr && (pin || !use_cache) &&
+        uncompression_dict.GetValue() != nullptr) {
+      // Instead of holding this file's own (pinned or owned) copy of the
+      // dictionary, share a single digested copy per distinct dictionary
+      // content with the other readers opened through the same factory.
+      pooled_dict = rep->uncompression_dict_pool->GetOrCreate(
+          uncompression_dict.GetValue()->GetRawDict(),
+          rep->blocks_definitely_zstd_compressed);
+      uncompression_dict.Reset();
+    } else if (use_cache && !pin) {
       uncompression_dict.Reset();
     }
   }
 
-  uncompression_dict_reader->reset(
-      new UncompressionDictReader(table, std::move(uncompression_dict)));
+  uncompression_dict_reader->reset(new UncompressionDictReader(
+      table, std::move(uncompression_dict), std::move(pooled_dict)));
 
   return Status::OK();
 }
@@ -82,6 +93,11 @@ Status UncompressionDictReader::GetOrReadUncompressionDictionary(
     CachableEntry<UncompressionDict>* uncompression_dict) const {
   assert(uncompression_dict);
 
+  if (pooled_dict_) {
+    uncompression_dict->SetUnownedValue(pooled_dict_.get());
+    return Status::OK();
+  }
+
   if (!uncompression_dict_.IsEmpty()) {
     uncompression_dict->SetUnownedValue(uncompression_dict_.GetValue());
     return Status::OK();
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
+
 #include "table/block_based/cachable_entry.h"
 #include "table/format.h"
 
@@ -39,8 +41,11 @@ class UncompressionDictReader {
 
  private:
   UncompressionDictReader(const BlockBasedTable* t,
-                          CachableEntry<UncompressionDict>&& uncompression_dict)
-      : table_(t), uncompression_dict_(std::move(uncompression_dict)) {
+                          CachableEntry<UncompressionDict>&& uncompression_dict,
+                          std::shared_ptr<UncompressionDict>&& pooled_dict)
+      : table_(t),
+        uncompression_dict_(std::move(uncompression_dict)),
+        pooled_dict_(std::move(pooled_dict)) {
     assert(table_);
   }
 
@@ -54,6 +59,10 @@ class UncompressionDictReader {
 
   const BlockBasedTable* table_;
   CachableEntry<UncompressionDict> uncompression_dict_;
+  // Set instead of a pinned `uncompression_dict_` when the table was opened
+  // with an UncompressionDictPool; shared with other readers whose
+  // dictionary has the same content.
+  std::shared_ptr<UncompressionDict> pooled_dict_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,82 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#include "table/block_based/whole_key_hash_index.h"
+
+#include "util/coding.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+uint32_t WholeKeyHashIndex::KeyHash(const Slice& user_key) {
+  return Lower32of64(GetSliceHash64(user_key));
+}
+
+void WholeKeyHashIndex::SerializeIndex(
+    const std::vector<std::pair<uint32_t, uint32_t>>& records,
+    std::string* out) {
+  assert(!records.empty());
+  const uint32_t num_buckets =
+      static_cast<uint32_t>(records.size() / kUtilRatio) + 1;
+
+  std::vector<uint32_t> buckets(num_buckets, kNoEntry);
+  for (const auto& record : records) {
+    assert(record.second < kCollision);
+    uint32_t& bucket = buckets[record.first % num_buckets];
+    if (bucket == kNoEntry) {
+      bucket = record.second;
+    } else if (bucket != record.second) {
+      bucket = kCollision;
+    }
+  }
+
+  out->clear();
+  out->reserve((buckets.size() + 1) * sizeof(uint32_t));
+  for (uint32_t bucket : buckets) {
+    PutFixed32(out, bucket);
+  }
+  PutFixed32(out, num_buckets);
+}
+
+Status WholeKeyHashIndex::Create(const Slice& data,
+                                 std::unique_ptr<WholeKeyHashIndex>* index) {
+  assert(index != nullptr);
+  if (data.size() < 2 * sizeof(uint32_t) ||
+      data.size() % sizeof(uint32_t) != 0) {
+    return Status::Corruption("Invalid whole key hash index block");
+  }
+  const uint32_t num_buckets =
+      DecodeFixed32(data.data() + data.size() - sizeof(uint32_t));
+  if (num_buckets == 0 ||
+      data.size() != (static_cast<size_t>(num_buckets) + 1) *
+                         sizeof(uint32_t)) {
+    return Status::Corruption("Invalid whole key hash index block");
+  }
+  std::string buckets(data.data(), data.size() - sizeof(uint32_t));
+  index->reset(new WholeKeyHashIndex(std::move(buckets), num_buckets));
+  return Status::OK();
+}
+
+WholeKeyHashIndex::LookupResult WholeKeyHashIndex::Lookup(
+    const Slice& user_key, uint32_t* entry_ordinal) const {
+  assert(entry_ordinal != nullptr);
+  const uint32_t bucket = DecodeFixed32(
+      buckets_.data() +
+      static_cast<size_t>(KeyHash(user_key) % num_buckets_) *
+          sizeof(uint32_t));
+  if (bucket == kNoEntry) {
+    return LookupResult::kAbsent;
+  }
+  if (bucket == kCollision) {
+    return LookupResult::kAmbiguous;
+  }
+  *entry_ordinal = bucket;
+  return LookupResult::kFound;
+}
+
+size_t WholeKeyHashIndex::ApproximateMemoryUsage() const {
+  return sizeof(WholeKeyHashIndex) + buckets_.size();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,81 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A bucketed hash index over the whole user keys of a table, mapping a key
+// hash to the ordinal of the index entry (i.e. the data block) holding the
+// key, so a point lookup resolves to its data block without binary
+// searching the index block. Each bucket holds either one entry ordinal,
+// kAmbiguous when keys from different data blocks hash to it (the caller
+// must fall back to binary search), or kAbsent when no key in the table
+// hashes to it (the key is guaranteed absent).
+//
+// Unlike BlockPrefixIndex, which is reconstructed from prefix meta blocks
+// when the table is opened, the bucket array is serialized at build time
+// (see WholeKeyHashIndexBuilder in index_builder.h) and used as stored:
+//
+//     +-----------------------+
+//     | bucket 0: 4 bytes     |
+//     | ...                   |
+//     | bucket n-1: 4 bytes   |
+//     +-----------------------+
+//     | num_buckets: 4 bytes  |
+//     +-----------------------+
+class WholeKeyHashIndex {
+ public:
+  // The enumerators deliberately differ from the kNoEntry / kCollision
+  // bucket sentinels in data_block_hash_index.h, which live at namespace
+  // scope and would be shadowed under -Wshadow.
+  enum class LookupResult {
+    kAbsent,     // no key with this hash; guaranteed absent
+    kAmbiguous,  // collision; fall back to binary search
+    kFound,      // *entry_ordinal is the index entry to search
+  };
+
+  // The hash used for both building and querying the bucket array.
+  static uint32_t KeyHash(const Slice& user_key);
+
+  // Serializes the bucket array built from (key hash, index entry ordinal)
+  // records, one record per distinct user key, in the format above.
+  static void SerializeIndex(
+      const std::vector<std::pair<uint32_t, uint32_t>>& records,
+      std::string* out);
+
+  // Deserializes a bucket array written by SerializeIndex. The contents are
+  // copied, so `data` does not need to outlive the index.
+  static Status Create(const Slice& data,
+                       std::unique_ptr<WholeKeyHashIndex>* index);
+
+  LookupResult Lookup(const Slice& user_key, uint32_t* entry_ordinal) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  WholeKeyHashIndex(std::string buckets, uint32_t num_buckets)
+      : buckets_(std::move(buckets)), num_buckets_(num_buckets) {}
+
+  static constexpr uint32_t kNoEntry = 0xFFFFFFFFu;
+  static constexpr uint32_t kCollision = 0xFFFFFFFEu;
+  // Targeted fraction of buckets in use, trading some space for fewer
+  // collisions; same idea as the in-block DataBlockHashIndex.
+  static constexpr double kUtilRatio = 0.75;
+
+  // num_buckets_ little-endian 4-byte buckets.
+  std::string buckets_;
+  uint32_t num_buckets_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
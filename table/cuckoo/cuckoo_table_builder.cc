@@ -8,12 +8,14 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string>
 #include <vector>
 
 #include "db/dbformat.h"
 #include "file/writable_file_writer.h"
+#include "port/port.h"
 #include "rocksdb/env.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_builder.h"
@@ -21,6 +23,7 @@
 #include "table/format.h"
 #include "table/meta_blocks.h"
 #include "util/autovector.h"
+#include "util/crc32c.h"
 #include "util/random.h"
 #include "util/string_util.h"
 
@@ -43,6 +46,14 @@ const std::string CuckooTablePropertyNames::kUseModuleHash =
       "rocksdb.cuckoo.hash.usemodule";
 const std::string CuckooTablePropertyNames::kUserKeyLength =
       "rocksdb.cuckoo.hash.userkeylength";
+const std::string CuckooTablePropertyNames::kDataChecksum =
+      "rocksdb.cuckoo.data.checksum";
+
+namespace {
+// Precomputing hashes in parallel only pays off once there are enough keys
+// to amortize thread startup.
+const uint64_t kParallelHashMinEntries = 4096;
+}  // namespace
 
 // Obtained by running echo rocksdb.table.cuckoo | sha1sum
 extern const uint64_t kCuckooTableMagicNumber = 0x926789d0c5f17873ull;
@@ -55,7 +66,7 @@ CuckooTableBuilder::CuckooTableBuilder(
     uint64_t (*get_slice_hash)(const Slice&, uint32_t, uint64_t),
     uint32_t column_family_id, const std::string& column_family_name,
     const std::string& db_id, const std::string& db_session_id,
-    uint64_t file_number)
+    uint64_t file_number, uint32_t max_build_threads)
     : num_hash_func_(2),
       file_(file),
       max_hash_table_ratio_(max_hash_table_ratio),
@@ -74,6 +85,7 @@ CuckooTableBuilder::CuckooTableBuilder(
       use_module_hash_(use_module_hash),
       identity_as_first_hash_(identity_as_first_hash),
       get_slice_hash_(get_slice_hash),
+      max_build_threads_(std::max(1U, max_build_threads)),
       closed_(false) {
   // Data is in a huge block.
   properties_.num_data_blocks = 1;
@@ -193,8 +205,62 @@ Slice CuckooTableBuilder::GetValue(uint64_t idx) const {
   return Slice(&kvs_[static_cast<size_t>(idx * (key_size_ + value_size_) + key_size_)], static_cast<size_t>(value_size_));
 }
 
+void CuckooTableBuilder::PrecomputeHashes() {
+  if (max_build_threads_ <= 1 || num_entries_ < kParallelHashMinEntries) {
+    return;
+  }
+  // Only the hash functions known up front are precomputed. The rare extra
+  // functions added while resolving collisions are computed on demand in
+  // GetBucketHash().
+  num_precomputed_hash_func_ = num_hash_func_;
+  precomputed_hashes_.resize(
+      static_cast<size_t>(num_entries_ * num_precomputed_hash_func_));
+  const uint64_t kChunkSize = 1024;
+  std::atomic<uint64_t> next_chunk{0};
+  auto hash_keys = [&]() {
+    while (true) {
+      const uint64_t begin = next_chunk.fetch_add(kChunkSize);
+      if (begin >= num_entries_) {
+        break;
+      }
+      const uint64_t end = std::min(begin + kChunkSize, num_entries_);
+      for (uint64_t idx = begin; idx < end; ++idx) {
+        Slice user_key = GetUserKey(idx);
+        for (uint32_t hash_cnt = 0; hash_cnt < num_precomputed_hash_func_;
+             ++hash_cnt) {
+          precomputed_hashes_[static_cast<size_t>(
+              idx * num_precomputed_hash_func_ + hash_cnt)] =
+              CuckooHash(user_key, hash_cnt, use_module_hash_,
+                         hash_table_size_, identity_as_first_hash_,
+                         get_slice_hash_);
+        }
+      }
+    }
+  };
+  std::vector<port::Thread> threads;
+  for (uint32_t i = 1; i < max_build_threads_; ++i) {
+    threads.emplace_back(hash_keys);
+  }
+  hash_keys();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+uint64_t CuckooTableBuilder::GetBucketHash(const Slice& user_key,
+                                           uint32_t hash_cnt,
+                                           uint64_t vector_idx) const {
+  if (hash_cnt < num_precomputed_hash_func_) {
+    return precomputed_hashes_[static_cast<size_t>(
+        vector_idx * num_precomputed_hash_func_ + hash_cnt)];
+  }
+  return CuckooHash(user_key, hash_cnt, use_module_hash_, hash_table_size_,
+                    identity_as_first_hash_, get_slice_hash_);
+}
+
 Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
   buckets->resize(static_cast<size_t>(hash_table_size_ + cuckoo_block_size_ - 1));
+  PrecomputeHashes();
   uint32_t make_space_for_key_call_id = 0;
   for (uint32_t vector_idx = 0; vector_idx < num_entries_; vector_idx++) {
     uint64_t bucket_id = 0;
@@ -203,8 +269,7 @@ Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
     Slice user_key = GetUserKey(vector_idx);
     for (uint32_t hash_cnt = 0; hash_cnt < num_hash_func_ && !bucket_found;
         ++hash_cnt) {
-      uint64_t hash_val = CuckooHash(user_key, hash_cnt, use_module_hash_,
-          hash_table_size_, identity_as_first_hash_, get_slice_hash_);
+      uint64_t hash_val = GetBucketHash(user_key, hash_cnt, vector_idx);
       // If there is a collision, check next cuckoo_block_size_ locations for
       // empty locations. While checking, if we reach end of the hash table,
       // stop searching and proceed for next hash function.
@@ -231,8 +296,7 @@ Status CuckooTableBuilder::MakeHashTable(std::vector<CuckooBucket>* buckets) {
       }
       // We don't really need to rehash the entire table because old hashes are
       // still valid and we only increased the number of hash functions.
-      uint64_t hash_val = CuckooHash(user_key, num_hash_func_, use_module_hash_,
-          hash_table_size_, identity_as_first_hash_, get_slice_hash_);
+      uint64_t hash_val = GetBucketHash(user_key, num_hash_func_, vector_idx);
       ++num_hash_func_;
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
           ++block_idx, ++hash_val) {
@@ -306,17 +370,26 @@ Status CuckooTableBuilder::Finish() {
 
   uint64_t bucket_size = key_size_ + value_size_;
   unused_bucket.resize(static_cast<size_t>(bucket_size), 'a');
-  // Write the table.
+  // Write the table, accumulating a checksum over the written buckets as we
+  // go so readers can detect corruption of the hash table.
+  uint32_t data_checksum = 0;
   uint32_t num_added = 0;
   for (auto& bucket : buckets) {
     if (bucket.vector_idx == kMaxVectorIdx) {
       io_status_ = file_->Append(Slice(unused_bucket));
+      data_checksum = crc32c::Extend(data_checksum, unused_bucket.data(),
+                                     unused_bucket.size());
     } else {
       ++num_added;
-      io_status_ = file_->Append(GetKey(bucket.vector_idx));
+      Slice key = GetKey(bucket.vector_idx);
+      io_status_ = file_->Append(key);
+      data_checksum = crc32c::Extend(data_checksum, key.data(), key.size());
       if (io_status_.ok()) {
         if (value_size_ > 0) {
-          io_status_ = file_->Append(GetValue(bucket.vector_idx));
+          Slice value = GetValue(bucket.vector_idx);
+          io_status_ = file_->Append(value);
+          data_checksum =
+              crc32c::Extend(data_checksum, value.data(), value.size());
         }
       }
     }
@@ -363,6 +436,10 @@ Status CuckooTableBuilder::Finish() {
     CuckooTablePropertyNames::kUserKeyLength].assign(
         reinterpret_cast<const char*>(&user_key_len),
         sizeof(user_key_len));
+  properties_.user_collected_properties[
+    CuckooTablePropertyNames::kDataChecksum].assign(
+        reinterpret_cast<const char*>(&data_checksum),
+        sizeof(data_checksum));
 
   // Write meta blocks.
   MetaIndexBuilder meta_index_builder;
@@ -482,9 +559,9 @@ bool CuckooTableBuilder::MakeSpaceForKey(
     CuckooBucket& curr_bucket = (*buckets)[static_cast<size_t>(curr_node.bucket_id)];
     for (uint32_t hash_cnt = 0;
         hash_cnt < num_hash_func_ && !null_found; ++hash_cnt) {
-      uint64_t child_bucket_id = CuckooHash(GetUserKey(curr_bucket.vector_idx),
-          hash_cnt, use_module_hash_, hash_table_size_, identity_as_first_hash_,
-          get_slice_hash_);
+      uint64_t child_bucket_id = GetBucketHash(
+          GetUserKey(curr_bucket.vector_idx), hash_cnt,
+          curr_bucket.vector_idx);
       // Iterate inside Cuckoo Block.
       for (uint32_t block_idx = 0; block_idx < cuckoo_block_size_;
           ++block_idx, ++child_bucket_id) {
@@ -30,7 +30,7 @@ class CuckooTableBuilder: public TableBuilder {
       uint64_t (*get_slice_hash)(const Slice&, uint32_t, uint64_t),
       uint32_t column_family_id, const std::string& column_family_name,
       const std::string& db_id = "", const std::string& db_session_id = "",
-      uint64_t file_number = 0);
+      uint64_t file_number = 0, uint32_t max_build_threads = 1);
   // No copying allowed
   CuckooTableBuilder(const CuckooTableBuilder&) = delete;
   void operator=(const CuckooTableBuilder&) = delete;
@@ -92,6 +92,16 @@ class CuckooTableBuilder: public TableBuilder {
                        std::vector<CuckooBucket>* buckets, uint64_t* bucket_id);
   Status MakeHashTable(std::vector<CuckooBucket>* buckets);
 
+  // Computes the first num_hash_func_ bucket hashes of every key using
+  // max_build_threads_ threads, so that the (inherently sequential)
+  // placement loop does not hash keys from scratch every time it visits
+  // them. No-op for single threaded builds or small files.
+  void PrecomputeHashes();
+  // Returns the hash_cnt-th bucket hash of the key at vector_idx,
+  // served from precomputed_hashes_ when available.
+  uint64_t GetBucketHash(const Slice& user_key, uint32_t hash_cnt,
+                         uint64_t vector_idx) const;
+
   inline bool IsDeletedKey(uint64_t idx) const;
   inline Slice GetKey(uint64_t idx) const;
   inline Slice GetUserKey(uint64_t idx) const;
@@ -128,6 +138,11 @@ class CuckooTableBuilder: public TableBuilder {
     uint64_t max_num_buckets);
   std::string largest_user_key_ = "";
   std::string smallest_user_key_ = "";
+  const uint32_t max_build_threads_;
+  // Bucket hashes filled in by PrecomputeHashes(), laid out as
+  // num_precomputed_hash_func_ consecutive values per key.
+  std::vector<uint64_t> precomputed_hashes_;
+  uint32_t num_precomputed_hash_func_ = 0;
 
   bool closed_;  // Either Finish() or Abandon() has been called.
 };
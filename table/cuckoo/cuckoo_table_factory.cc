@@ -41,7 +41,8 @@ TableBuilder* CuckooTableFactory::NewTableBuilder(
       table_options_.identity_as_first_hash, nullptr /* get_slice_hash */,
       table_builder_options.column_family_id,
       table_builder_options.column_family_name, table_builder_options.db_id,
-      table_builder_options.db_session_id, table_builder_options.cur_file_num);
+      table_builder_options.db_session_id, table_builder_options.cur_file_num,
+      table_options_.max_build_threads);
 }
 
 std::string CuckooTableFactory::GetPrintableOptions() const {
@@ -62,6 +63,9 @@ std::string CuckooTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  identity_as_first_hash: %d\n",
            table_options_.identity_as_first_hash);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  max_build_threads: %u\n",
+           table_options_.max_build_threads);
+  ret.append(buffer);
   return ret;
 }
 
@@ -88,6 +92,10 @@ static std::unordered_map<std::string, OptionTypeInfo> cuckoo_table_type_info =
          {offsetof(struct CuckooTableOptions, use_module_hash),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_build_threads",
+         {offsetof(struct CuckooTableOptions, max_build_threads),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 #endif  // ROCKSDB_LITE
 };
 
@@ -25,6 +25,7 @@
 #include "table/internal_iterator.h"
 #include "table/meta_blocks.h"
 #include "util/coding.h"
+#include "util/crc32c.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace {
@@ -54,10 +55,6 @@ CuckooTableReader::CuckooTableReader(
       table_size_(0),
       ucomp_(comparator),
       get_slice_hash_(get_slice_hash) {
-  if (!ioptions.allow_mmap_reads) {
-    status_ = Status::InvalidArgument("File is not mmaped");
-    return;
-  }
   {
     std::unique_ptr<TableProperties> props;
     status_ = ReadTableProperties(file_.get(), file_size,
@@ -142,9 +139,48 @@ CuckooTableReader::CuckooTableReader(
       cuckoo_block_size->second.data());
   cuckoo_block_bytes_minus_one_ = cuckoo_block_size_ * bucket_length_ - 1;
   // TODO: rate limit reads of whole cuckoo tables.
-  status_ =
-      file_->Read(IOOptions(), 0, static_cast<size_t>(file_size), &file_data_,
-                  nullptr, nullptr, Env::IO_TOTAL /* rate_limiter_priority */);
+  if (ioptions.allow_mmap_reads && !file_->use_direct_io()) {
+    // Zero copy: file_data_ points directly into the mapping.
+    status_ = file_->Read(IOOptions(), 0, static_cast<size_t>(file_size),
+                          &file_data_, nullptr, nullptr,
+                          Env::IO_TOTAL /* rate_limiter_priority */);
+  } else if (file_->use_direct_io()) {
+    // Direct I/O: RandomAccessFileReader performs the aligned reads and
+    // hands back the aligned buffer, which we pin for the lifetime of the
+    // reader.
+    status_ = file_->Read(IOOptions(), 0, static_cast<size_t>(file_size),
+                          &file_data_, nullptr, &table_data_buf_,
+                          Env::IO_TOTAL /* rate_limiter_priority */);
+  } else {
+    // Buffered reads: load the whole table into an owned buffer.
+    table_data_buf_.reset(new char[static_cast<size_t>(file_size)]);
+    status_ = file_->Read(IOOptions(), 0, static_cast<size_t>(file_size),
+                          &file_data_, table_data_buf_.get(), nullptr,
+                          Env::IO_TOTAL /* rate_limiter_priority */);
+  }
+  if (!status_.ok()) {
+    return;
+  }
+
+  // Verify the hash table against the checksum stored by newer builders.
+  // Older files do not have the property and are not verified.
+  auto data_checksum = user_props.find(CuckooTablePropertyNames::kDataChecksum);
+  if (data_checksum != user_props.end() &&
+      data_checksum->second.size() == sizeof(uint32_t)) {
+    const uint32_t expected =
+        *reinterpret_cast<const uint32_t*>(data_checksum->second.data());
+    const uint64_t data_size = table_props_->data_size;
+    if (data_size > file_data_.size()) {
+      status_ = Status::Corruption("Cuckoo table data size out of range");
+      return;
+    }
+    const uint32_t actual =
+        crc32c::Value(file_data_.data(), static_cast<size_t>(data_size));
+    if (actual != expected) {
+      status_ = Status::Corruption("Cuckoo table data checksum mismatch");
+      return;
+    }
+  }
 }
 
 Status CuckooTableReader::Get(const ReadOptions& /*readOptions*/,
@@ -404,7 +440,11 @@ InternalIterator* CuckooTableReader::NewIterator(
   return iter;
 }
 
-size_t CuckooTableReader::ApproximateMemoryUsage() const { return 0; }
+size_t CuckooTableReader::ApproximateMemoryUsage() const {
+  // When the file is not mmaped, the reader holds a private copy of the
+  // whole table.
+  return table_data_buf_ ? file_data_.size() : 0;
+}
 
 }  // namespace ROCKSDB_NAMESPACE
 #endif
@@ -77,6 +77,10 @@ class CuckooTableReader: public TableReader {
   void LoadAllKeys(std::vector<std::pair<Slice, uint32_t>>* key_to_bucket_id);
   std::unique_ptr<RandomAccessFileReader> file_;
   Slice file_data_;
+  // Owns the table contents when the file is read through buffered or
+  // direct I/O instead of being mmaped; file_data_ then points into this
+  // buffer.
+  AlignedBuf table_data_buf_;
   bool is_last_level_;
   bool identity_as_first_hash_;
   bool use_module_hash_;
@@ -88,13 +88,16 @@ class CuckooReaderTest : public testing::Test {
   }
 
   void CreateCuckooFileAndCheckReader(
-      const Comparator* ucomp = BytewiseComparator()) {
+      const Comparator* ucomp = BytewiseComparator(),
+      uint32_t max_build_threads = 1) {
     std::unique_ptr<WritableFileWriter> file_writer;
     ASSERT_OK(WritableFileWriter::Create(env->GetFileSystem(), fname,
                                          file_options, &file_writer, nullptr));
     CuckooTableBuilder builder(
         file_writer.get(), 0.9, kNumHashFunc, 100, ucomp, 2, false, false,
-        GetSliceHash, 0 /* column_family_id */, kDefaultColumnFamilyName);
+        GetSliceHash, 0 /* column_family_id */, kDefaultColumnFamilyName,
+        "" /* db_id */, "" /* db_session_id */, 0 /* file_number */,
+        max_build_threads);
     ASSERT_OK(builder.status());
     for (uint32_t key_idx = 0; key_idx < num_items; ++key_idx) {
       builder.Add(Slice(keys[key_idx]), Slice(values[key_idx]));
@@ -208,12 +211,65 @@ class CuckooReaderTest : public testing::Test {
   FileOptions file_options;
 };
 
-TEST_F(CuckooReaderTest, FileNotMmaped) {
+TEST_F(CuckooReaderTest, ReadWithoutMmap) {
+  // The reader used to require mmap; it now loads the table into an owned
+  // buffer when mmap reads are disabled.
   options.allow_mmap_reads = false;
-  ImmutableOptions ioptions(options);
-  CuckooTableReader reader(ioptions, nullptr, 0, nullptr, nullptr);
-  ASSERT_TRUE(reader.status().IsInvalidArgument());
-  ASSERT_STREQ("File is not mmaped", reader.status().getState());
+  SetUp(kNumHashFunc);
+  fname = test::PerThreadDBPath("CuckooReader_ReadWithoutMmap");
+  for (uint64_t i = 0; i < num_items; i++) {
+    user_keys[i] = "key" + NumToStr(i);
+    ParsedInternalKey ikey(user_keys[i], i + 1000, kTypeValue);
+    AppendInternalKey(&keys[i], ikey);
+    values[i] = "value" + NumToStr(i);
+    AddHashLookups(user_keys[i], i, kNumHashFunc);
+  }
+  CreateCuckooFileAndCheckReader();
+}
+
+TEST_F(CuckooReaderTest, DataChecksumMismatch) {
+  options.allow_mmap_reads = false;
+  SetUp(kNumHashFunc);
+  fname = test::PerThreadDBPath("CuckooReader_DataChecksumMismatch");
+  for (uint64_t i = 0; i < num_items; i++) {
+    user_keys[i] = "key" + NumToStr(i);
+    ParsedInternalKey ikey(user_keys[i], i + 1000, kTypeValue);
+    AppendInternalKey(&keys[i], ikey);
+    values[i] = "value" + NumToStr(i);
+    AddHashLookups(user_keys[i], i, kNumHashFunc);
+  }
+  CreateCuckooFileAndCheckReader();
+
+  // Flip one bit in the hash table and expect the reader to reject the
+  // file at open.
+  std::string contents;
+  ASSERT_OK(ReadFileToString(env, fname, &contents));
+  contents[0] ^= 0x01;
+  ASSERT_OK(WriteStringToFile(env, contents, fname, false /* should_sync */));
+
+  std::unique_ptr<RandomAccessFileReader> file_reader;
+  ASSERT_OK(RandomAccessFileReader::Create(
+      env->GetFileSystem(), fname, file_options, &file_reader, nullptr));
+  const ImmutableOptions ioptions(options);
+  CuckooTableReader reader(ioptions, std::move(file_reader), file_size,
+                           BytewiseComparator(), GetSliceHash);
+  ASSERT_TRUE(reader.status().IsCorruption());
+}
+
+TEST_F(CuckooReaderTest, ParallelHashBuild) {
+  // Enough keys to trigger parallel hash precomputation in the builder;
+  // the resulting file must read back exactly like a serial build.
+  SetUp(8192);
+  fname = test::PerThreadDBPath("CuckooReader_ParallelHashBuild");
+  for (uint64_t i = 0; i < num_items; i++) {
+    user_keys[i] = "key" + NumToStr(i);
+    ParsedInternalKey ikey(user_keys[i], i + 1000, kTypeValue);
+    AppendInternalKey(&keys[i], ikey);
+    values[i] = "value" + NumToStr(i);
+    AddHashLookups(user_keys[i], i, kNumHashFunc);
+  }
+  CreateCuckooFileAndCheckReader(BytewiseComparator(),
+                                 4 /* max_build_threads */);
 }
 
 TEST_F(CuckooReaderTest, WhenKeyExists) {
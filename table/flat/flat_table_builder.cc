@@ -0,0 +1,385 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+#include "table/flat/flat_table_builder.h"
+
+#include <assert.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "file/writable_file_writer.h"
+#include "rocksdb/env.h"
+#include "rocksdb/table.h"
+#include "table/flat/flat_table_factory.h"
+#include "table/format.h"
+#include "table/meta_blocks.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+const std::string FlatTablePropertyNames::kValueLength =
+    "rocksdb.flat.value.length";
+const std::string FlatTablePropertyNames::kNumBuckets =
+    "rocksdb.flat.bucket.num";
+const std::string FlatTablePropertyNames::kNumSlots = "rocksdb.flat.slot.num";
+const std::string FlatTablePropertyNames::kIsLastLevel =
+    "rocksdb.flat.file.islastlevel";
+const std::string FlatTablePropertyNames::kUserKeyLength =
+    "rocksdb.flat.userkeylength";
+
+// Obtained by running echo rocksdb.table.flat | sha1sum
+extern const uint64_t kFlatTableMagicNumber = 0x41589e37189dbd62ull;
+
+FlatTableBuilder::FlatTableBuilder(
+    WritableFileWriter* file, uint32_t keys_per_bucket,
+    uint32_t max_displacement, const Comparator* user_comparator,
+    uint32_t column_family_id, const std::string& column_family_name,
+    const std::string& db_id, const std::string& db_session_id,
+    uint64_t file_number)
+    : file_(file),
+      keys_per_bucket_(std::max(1U, keys_per_bucket)),
+      max_displacement_(max_displacement),
+      is_last_level_file_(false),
+      has_seen_first_key_(false),
+      has_seen_first_value_(false),
+      key_size_(0),
+      value_size_(0),
+      num_entries_(0),
+      num_values_(0),
+      ucomp_(user_comparator),
+      closed_(false) {
+  // Data is in a huge block.
+  properties_.num_data_blocks = 1;
+  properties_.filter_size = 0;
+  properties_.column_family_id = column_family_id;
+  properties_.column_family_name = column_family_name;
+  properties_.db_id = db_id;
+  properties_.db_session_id = db_session_id;
+  properties_.orig_file_number = file_number;
+  status_.PermitUncheckedError();
+  io_status_.PermitUncheckedError();
+}
+
+void FlatTableBuilder::Add(const Slice& key, const Slice& value) {
+  if (num_entries_ >= kInvalidIdx - 1) {
+    status_ = Status::NotSupported("Number of keys in a file must be < 2^32-1");
+    return;
+  }
+  ParsedInternalKey ikey;
+  Status pik_status = ParseInternalKey(key, &ikey, false /* log_err_key */);
+  if (!pik_status.ok()) {
+    status_ = Status::Corruption("Unable to parse key into internal key. ",
+                                 pik_status.getState());
+    return;
+  }
+  if (ikey.type != kTypeDeletion && ikey.type != kTypeValue) {
+    status_ =
+        Status::NotSupported("Unsupported key type " +
+                             std::to_string(ikey.type));
+    return;
+  }
+
+  // Determine if we can ignore the sequence number and value type from
+  // internal keys by looking at sequence number from first key. We assume
+  // that if first key has a zero sequence number, then all the remaining
+  // keys will have zero seq. no.
+  if (!has_seen_first_key_) {
+    is_last_level_file_ = ikey.sequence == 0;
+    has_seen_first_key_ = true;
+    key_size_ = is_last_level_file_ ? ikey.user_key.size() : key.size();
+  } else if (ucomp_->Compare(ikey.user_key, Slice(prev_user_key_)) == 0) {
+    // The perfect hash function maps one user key to one slot, so a file
+    // can hold at most one entry per user key.
+    status_ = Status::NotSupported("Same key is being inserted again.");
+    return;
+  }
+  prev_user_key_.assign(ikey.user_key.data(), ikey.user_key.size());
+  if (key_size_ != (is_last_level_file_ ? ikey.user_key.size() : key.size())) {
+    status_ = Status::NotSupported("all keys have to be the same size");
+    return;
+  }
+
+  if (ikey.type == kTypeValue) {
+    if (!has_seen_first_value_) {
+      has_seen_first_value_ = true;
+      value_size_ = value.size();
+    }
+    if (value_size_ != value.size()) {
+      status_ = Status::NotSupported("all values have to be the same size");
+      return;
+    }
+
+    if (is_last_level_file_) {
+      kvs_.append(ikey.user_key.data(), ikey.user_key.size());
+    } else {
+      kvs_.append(key.data(), key.size());
+    }
+    kvs_.append(value.data(), value.size());
+    ++num_values_;
+  } else {
+    if (is_last_level_file_) {
+      deleted_keys_.append(ikey.user_key.data(), ikey.user_key.size());
+    } else {
+      deleted_keys_.append(key.data(), key.size());
+    }
+  }
+  ++num_entries_;
+}
+
+bool FlatTableBuilder::IsDeletedKey(uint64_t idx) const {
+  assert(closed_);
+  return idx >= num_values_;
+}
+
+Slice FlatTableBuilder::GetKey(uint64_t idx) const {
+  assert(closed_);
+  if (IsDeletedKey(idx)) {
+    return Slice(
+        &deleted_keys_[static_cast<size_t>((idx - num_values_) * key_size_)],
+        static_cast<size_t>(key_size_));
+  }
+  return Slice(&kvs_[static_cast<size_t>(idx * (key_size_ + value_size_))],
+               static_cast<size_t>(key_size_));
+}
+
+Slice FlatTableBuilder::GetUserKey(uint64_t idx) const {
+  assert(closed_);
+  return is_last_level_file_ ? GetKey(idx) : ExtractUserKey(GetKey(idx));
+}
+
+Slice FlatTableBuilder::GetValue(uint64_t idx) const {
+  assert(closed_);
+  if (IsDeletedKey(idx)) {
+    static std::string empty_value(static_cast<unsigned int>(value_size_),
+                                   'a');
+    return Slice(empty_value);
+  }
+  return Slice(
+      &kvs_[static_cast<size_t>(idx * (key_size_ + value_size_) + key_size_)],
+      static_cast<size_t>(value_size_));
+}
+
+// Classic hash-and-displace construction: keys are grouped into buckets by
+// a first hash function; buckets are processed from largest to smallest
+// and for each one we search for a displacement under which a second hash
+// function maps every key of the bucket to a distinct free slot. Since the
+// number of slots equals the number of keys, the resulting function is
+// minimal — no slot is left empty.
+Status FlatTableBuilder::MakePerfectHash(
+    std::vector<uint32_t>* slot_to_idx,
+    std::vector<uint32_t>* displacements) {
+  const uint64_t num_slots = num_entries_;
+  const uint64_t num_buckets =
+      std::max(uint64_t{1},
+               (num_entries_ + keys_per_bucket_ - 1) / keys_per_bucket_);
+  std::vector<std::vector<uint32_t>> buckets(
+      static_cast<size_t>(num_buckets));
+  for (uint32_t idx = 0; idx < num_entries_; idx++) {
+    uint64_t b = FlatTableBucket(GetUserKey(idx), num_buckets);
+    buckets[static_cast<size_t>(b)].push_back(idx);
+  }
+
+  // Largest buckets are the hardest to place, so handle them while the
+  // slot table is still mostly free.
+  std::vector<uint32_t> bucket_order(static_cast<size_t>(num_buckets));
+  for (uint32_t b = 0; b < num_buckets; b++) {
+    bucket_order[b] = b;
+  }
+  std::sort(bucket_order.begin(), bucket_order.end(),
+            [&buckets](uint32_t a, uint32_t b) {
+              return buckets[a].size() > buckets[b].size();
+            });
+
+  slot_to_idx->assign(static_cast<size_t>(num_slots), kInvalidIdx);
+  displacements->assign(static_cast<size_t>(num_buckets), 0);
+  std::vector<uint64_t> trial_slots;
+  for (uint32_t b : bucket_order) {
+    const std::vector<uint32_t>& bucket = buckets[b];
+    if (bucket.empty()) {
+      continue;
+    }
+    bool placed = false;
+    for (uint32_t d = 0; d < max_displacement_; d++) {
+      trial_slots.clear();
+      bool collision = false;
+      for (uint32_t idx : bucket) {
+        uint64_t slot = FlatTableSlot(GetUserKey(idx), d, num_slots);
+        if ((*slot_to_idx)[static_cast<size_t>(slot)] != kInvalidIdx) {
+          collision = true;
+          break;
+        }
+        for (uint64_t taken : trial_slots) {
+          if (taken == slot) {
+            collision = true;
+            break;
+          }
+        }
+        if (collision) {
+          break;
+        }
+        trial_slots.push_back(slot);
+      }
+      if (!collision) {
+        for (size_t i = 0; i < bucket.size(); i++) {
+          (*slot_to_idx)[static_cast<size_t>(trial_slots[i])] = bucket[i];
+        }
+        (*displacements)[b] = d;
+        placed = true;
+        break;
+      }
+    }
+    if (!placed) {
+      return Status::NotSupported(
+          "Too many collisions. Unable to build a perfect hash function.");
+    }
+  }
+  return Status::OK();
+}
+
+Status FlatTableBuilder::Finish() {
+  assert(!closed_);
+  closed_ = true;
+  std::vector<uint32_t> slot_to_idx;
+  std::vector<uint32_t> displacements;
+  if (num_entries_ > 0) {
+    status_ = MakePerfectHash(&slot_to_idx, &displacements);
+    if (!status_.ok()) {
+      return status_;
+    }
+  }
+  properties_.num_entries = num_entries_;
+  properties_.num_deletions = num_entries_ - num_values_;
+  properties_.fixed_key_len = key_size_;
+  properties_.user_collected_properties[FlatTablePropertyNames::kValueLength]
+      .assign(reinterpret_cast<const char*>(&value_size_),
+              sizeof(value_size_));
+
+  // Write the slots in slot order.
+  uint64_t bucket_size = key_size_ + value_size_;
+  for (uint32_t idx : slot_to_idx) {
+    assert(idx != kInvalidIdx);
+    io_status_ = file_->Append(GetKey(idx));
+    if (io_status_.ok() && value_size_ > 0) {
+      io_status_ = file_->Append(GetValue(idx));
+    }
+    if (!io_status_.ok()) {
+      status_ = io_status_;
+      return status_;
+    }
+  }
+  properties_.raw_key_size = num_entries_ * properties_.fixed_key_len;
+  properties_.raw_value_size = num_entries_ * value_size_;
+  uint64_t offset = num_entries_ * bucket_size;
+  properties_.data_size = offset;
+
+  // Write the displacement array right after the slots.
+  std::string displacement_block;
+  displacement_block.reserve(displacements.size() * sizeof(uint32_t));
+  for (uint32_t d : displacements) {
+    PutFixed32(&displacement_block, d);
+  }
+  io_status_ = file_->Append(Slice(displacement_block));
+  if (!io_status_.ok()) {
+    status_ = io_status_;
+    return status_;
+  }
+  properties_.index_size = displacement_block.size();
+  offset += displacement_block.size();
+
+  uint64_t num_buckets = displacements.size();
+  properties_.user_collected_properties[FlatTablePropertyNames::kNumBuckets]
+      .assign(reinterpret_cast<const char*>(&num_buckets),
+              sizeof(num_buckets));
+  properties_.user_collected_properties[FlatTablePropertyNames::kNumSlots]
+      .assign(reinterpret_cast<const char*>(&num_entries_),
+              sizeof(num_entries_));
+  properties_
+      .user_collected_properties[FlatTablePropertyNames::kIsLastLevel]
+      .assign(reinterpret_cast<const char*>(&is_last_level_file_),
+              sizeof(is_last_level_file_));
+  uint32_t user_key_len =
+      static_cast<uint32_t>(is_last_level_file_ ? key_size_ : key_size_ - 8);
+  properties_
+      .user_collected_properties[FlatTablePropertyNames::kUserKeyLength]
+      .assign(reinterpret_cast<const char*>(&user_key_len),
+              sizeof(user_key_len));
+
+  // Write meta blocks.
+  MetaIndexBuilder meta_index_builder;
+  PropertyBlockBuilder property_block_builder;
+
+  property_block_builder.AddTableProperty(properties_);
+  property_block_builder.Add(properties_.user_collected_properties);
+  Slice property_block = property_block_builder.Finish();
+  BlockHandle property_block_handle;
+  property_block_handle.set_offset(offset);
+  property_block_handle.set_size(property_block.size());
+  io_status_ = file_->Append(property_block);
+  offset += property_block.size();
+  if (!io_status_.ok()) {
+    status_ = io_status_;
+    return status_;
+  }
+
+  meta_index_builder.Add(kPropertiesBlockName, property_block_handle);
+  Slice meta_index_block = meta_index_builder.Finish();
+
+  BlockHandle meta_index_block_handle;
+  meta_index_block_handle.set_offset(offset);
+  meta_index_block_handle.set_size(meta_index_block.size());
+  io_status_ = file_->Append(meta_index_block);
+  if (!io_status_.ok()) {
+    status_ = io_status_;
+    return status_;
+  }
+
+  FooterBuilder footer;
+  footer.Build(kFlatTableMagicNumber, /* format_version */ 1, offset,
+               kNoChecksum, meta_index_block_handle);
+  io_status_ = file_->Append(footer.GetSlice());
+  status_ = io_status_;
+  return status_;
+}
+
+void FlatTableBuilder::Abandon() {
+  assert(!closed_);
+  closed_ = true;
+}
+
+uint64_t FlatTableBuilder::NumEntries() const { return num_entries_; }
+
+uint64_t FlatTableBuilder::FileSize() const {
+  if (closed_) {
+    return file_->GetFileSize();
+  } else if (num_entries_ == 0) {
+    return 0;
+  }
+  // Slots plus the displacement array; the function is minimal so there is
+  // no empty-bucket overhead.
+  return (key_size_ + value_size_) * num_entries_ +
+         (num_entries_ / keys_per_bucket_ + 1) * sizeof(uint32_t);
+}
+
+std::string FlatTableBuilder::GetFileChecksum() const {
+  if (file_ != nullptr) {
+    return file_->GetFileChecksum();
+  } else {
+    return kUnknownFileChecksum;
+  }
+}
+
+const char* FlatTableBuilder::GetFileChecksumFuncName() const {
+  if (file_ != nullptr) {
+    return file_->GetFileChecksumFuncName();
+  } else {
+    return kUnknownFileChecksumFuncName;
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
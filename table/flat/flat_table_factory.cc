@@ -0,0 +1,81 @@
+// Copyright (c) 2011-present, Facebook, Inc. All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+#include "table/flat/flat_table_factory.h"
+
+#include "db/dbformat.h"
+#include "options/configurable_helper.h"
+#include "rocksdb/utilities/options_type.h"
+#include "table/flat/flat_table_builder.h"
+#include "table/flat/flat_table_reader.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+Status FlatTableFactory::NewTableReader(
+    const ReadOptions& /*ro*/, const TableReaderOptions& table_reader_options,
+    std::unique_ptr<RandomAccessFileReader>&& file, uint64_t file_size,
+    std::unique_ptr<TableReader>* table,
+    bool /*prefetch_index_and_filter_in_cache*/) const {
+  std::unique_ptr<FlatTableReader> new_reader(new FlatTableReader(
+      table_reader_options.ioptions, std::move(file), file_size,
+      table_reader_options.internal_comparator.user_comparator()));
+  Status s = new_reader->status();
+  if (s.ok()) {
+    *table = std::move(new_reader);
+  }
+  return s;
+}
+
+TableBuilder* FlatTableFactory::NewTableBuilder(
+    const TableBuilderOptions& table_builder_options,
+    WritableFileWriter* file) const {
+  return new FlatTableBuilder(
+      file, table_options_.keys_per_bucket, table_options_.max_displacement,
+      table_builder_options.internal_comparator.user_comparator(),
+      table_builder_options.column_family_id,
+      table_builder_options.column_family_name, table_builder_options.db_id,
+      table_builder_options.db_session_id, table_builder_options.cur_file_num);
+}
+
+std::string FlatTableFactory::GetPrintableOptions() const {
+  std::string ret;
+  ret.reserve(2000);
+  const int kBufferSize = 200;
+  char buffer[kBufferSize];
+
+  snprintf(buffer, kBufferSize, "  keys_per_bucket: %u\n",
+           table_options_.keys_per_bucket);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  max_displacement: %u\n",
+           table_options_.max_displacement);
+  ret.append(buffer);
+  return ret;
+}
+
+static std::unordered_map<std::string, OptionTypeInfo> flat_table_type_info = {
+#ifndef ROCKSDB_LITE
+    {"keys_per_bucket",
+     {offsetof(struct FlatTableOptions, keys_per_bucket),
+      OptionType::kUInt32T, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+    {"max_displacement",
+     {offsetof(struct FlatTableOptions, max_displacement),
+      OptionType::kUInt32T, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+#endif  // ROCKSDB_LITE
+};
+
+FlatTableFactory::FlatTableFactory(const FlatTableOptions& table_options)
+    : table_options_(table_options) {
+  RegisterOptions(&table_options_, &flat_table_type_info);
+}
+
+TableFactory* NewFlatTableFactory(const FlatTableOptions& table_options) {
+  return new FlatTableFactory(table_options);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
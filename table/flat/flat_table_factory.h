@@ -0,0 +1,72 @@
+// Copyright (c) 2011-present, Facebook, Inc. All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#ifndef ROCKSDB_LITE
+
+#include <string>
+
+#include "rocksdb/options.h"
+#include "rocksdb/table.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Seeds for the two hash families of the perfect hash function. Both are
+// baked into the file format; changing them invalidates existing files.
+const uint64_t kFlatTableBucketHashSeed = 0x75bd0f2169cbc6d7ull;
+const uint64_t kFlatTableSlotHashSeed = 0x5c614cbc94c4a2d9ull;
+
+// Displacement bucket a user key belongs to.
+static inline uint64_t FlatTableBucket(const Slice& user_key,
+                                       uint64_t num_buckets) {
+  return GetSliceNPHash64(user_key, kFlatTableBucketHashSeed) % num_buckets;
+}
+
+// Slot a user key occupies given the displacement of its bucket.
+static inline uint64_t FlatTableSlot(const Slice& user_key,
+                                     uint32_t displacement,
+                                     uint64_t num_slots) {
+  return GetSliceNPHash64(user_key, kFlatTableSlotHashSeed + displacement) %
+         num_slots;
+}
+
+// Flat Table stores fixed-stride slots addressed by a minimal perfect hash
+// function over whole user keys, so point lookups cost one displacement
+// array probe in memory plus one slot read from the file.
+//
+// Some assumptions:
+// - Key length and Value length are fixed.
+// - Does not support Snapshot.
+// - Does not support Merge operations.
+class FlatTableFactory : public TableFactory {
+ public:
+  explicit FlatTableFactory(
+      const FlatTableOptions& table_options = FlatTableOptions());
+  ~FlatTableFactory() {}
+
+  // Method to allow CheckedCast to work for this class
+  static const char* kClassName() { return kFlatTableName(); }
+  const char* Name() const override { return kFlatTableName(); }
+
+  using TableFactory::NewTableReader;
+  Status NewTableReader(
+      const ReadOptions& ro, const TableReaderOptions& table_reader_options,
+      std::unique_ptr<RandomAccessFileReader>&& file, uint64_t file_size,
+      std::unique_ptr<TableReader>* table,
+      bool prefetch_index_and_filter_in_cache = true) const override;
+
+  TableBuilder* NewTableBuilder(
+      const TableBuilderOptions& table_builder_options,
+      WritableFileWriter* file) const override;
+
+  std::string GetPrintableOptions() const override;
+
+ private:
+  FlatTableOptions table_options_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,404 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+#include "table/flat/flat_table_reader.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "memory/arena.h"
+#include "options/cf_options.h"
+#include "rocksdb/iterator.h"
+#include "rocksdb/table.h"
+#include "table/flat/flat_table_factory.h"
+#include "table/get_context.h"
+#include "table/internal_iterator.h"
+#include "table/meta_blocks.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+const uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+}
+
+extern const uint64_t kFlatTableMagicNumber;
+
+FlatTableReader::FlatTableReader(
+    const ImmutableOptions& ioptions,
+    std::unique_ptr<RandomAccessFileReader>&& file, uint64_t file_size,
+    const Comparator* comparator)
+    : file_(std::move(file)),
+      is_last_level_(false),
+      key_length_(0),
+      user_key_length_(0),
+      value_length_(0),
+      bucket_length_(0),
+      num_slots_(0),
+      num_buckets_(0),
+      ucomp_(comparator) {
+  {
+    std::unique_ptr<TableProperties> props;
+    status_ = ReadTableProperties(file_.get(), file_size,
+                                  kFlatTableMagicNumber, ioptions, &props);
+    if (!status_.ok()) {
+      return;
+    }
+    table_props_ = std::move(props);
+  }
+  auto& user_props = table_props_->user_collected_properties;
+  key_length_ = static_cast<uint32_t>(table_props_->fixed_key_len);
+
+  auto user_key_len = user_props.find(FlatTablePropertyNames::kUserKeyLength);
+  if (user_key_len == user_props.end()) {
+    status_ = Status::Corruption("User key length not found");
+    return;
+  }
+  user_key_length_ =
+      *reinterpret_cast<const uint32_t*>(user_key_len->second.data());
+
+  auto value_length = user_props.find(FlatTablePropertyNames::kValueLength);
+  if (value_length == user_props.end()) {
+    status_ = Status::Corruption("Value length not found");
+    return;
+  }
+  value_length_ =
+      *reinterpret_cast<const uint32_t*>(value_length->second.data());
+  bucket_length_ = key_length_ + value_length_;
+
+  auto num_slots = user_props.find(FlatTablePropertyNames::kNumSlots);
+  if (num_slots == user_props.end()) {
+    status_ = Status::Corruption("Number of slots not found");
+    return;
+  }
+  num_slots_ = *reinterpret_cast<const uint64_t*>(num_slots->second.data());
+
+  auto num_buckets = user_props.find(FlatTablePropertyNames::kNumBuckets);
+  if (num_buckets == user_props.end()) {
+    status_ = Status::Corruption("Number of buckets not found");
+    return;
+  }
+  num_buckets_ =
+      *reinterpret_cast<const uint64_t*>(num_buckets->second.data());
+
+  auto is_last_level = user_props.find(FlatTablePropertyNames::kIsLastLevel);
+  if (is_last_level == user_props.end()) {
+    status_ = Status::Corruption("Is last level not found");
+    return;
+  }
+  is_last_level_ =
+      *reinterpret_cast<const bool*>(is_last_level->second.data());
+
+  // Load the displacement array. This is the only part of the file pinned
+  // in memory: 4 bytes per bucket, i.e. about one byte per key with the
+  // default keys_per_bucket.
+  size_t displacement_bytes =
+      static_cast<size_t>(num_buckets_) * sizeof(uint32_t);
+  std::unique_ptr<char[]> displacement_buf(new char[displacement_bytes]);
+  Slice displacement_slice;
+  status_ = file_->Read(IOOptions(), num_slots_ * bucket_length_,
+                        displacement_bytes, &displacement_slice,
+                        displacement_buf.get(), nullptr,
+                        Env::IO_TOTAL /* rate_limiter_priority */);
+  if (!status_.ok()) {
+    return;
+  }
+  if (displacement_slice.size() != displacement_bytes) {
+    status_ = Status::Corruption("Truncated displacement array");
+    return;
+  }
+  displacements_.resize(static_cast<size_t>(num_buckets_));
+  for (size_t i = 0; i < displacements_.size(); i++) {
+    displacements_[i] =
+        DecodeFixed32(displacement_slice.data() + i * sizeof(uint32_t));
+  }
+}
+
+Status FlatTableReader::Get(const ReadOptions& read_options, const Slice& key,
+                            GetContext* get_context,
+                            const SliceTransform* /* prefix_extractor */,
+                            bool /*skip_filters*/) {
+  assert(key.size() == key_length_ + (is_last_level_ ? 8 : 0));
+  if (num_slots_ == 0) {
+    return Status::OK();
+  }
+  Slice user_key = ExtractUserKey(key);
+  uint32_t displacement =
+      displacements_[static_cast<size_t>(FlatTableBucket(user_key,
+                                                         num_buckets_))];
+  uint64_t offset =
+      bucket_length_ * FlatTableSlot(user_key, displacement, num_slots_);
+
+  // One positioned read of exactly one slot.
+  Slice slot;
+  std::unique_ptr<char[]> heap_buf;
+  AlignedBuf aligned_buf;
+  IOStatus io_s;
+  if (file_->use_direct_io()) {
+    io_s = file_->Read(IOOptions(), offset, bucket_length_, &slot, nullptr,
+                       &aligned_buf, read_options.rate_limiter_priority);
+  } else {
+    heap_buf.reset(new char[bucket_length_]);
+    io_s = file_->Read(IOOptions(), offset, bucket_length_, &slot,
+                       heap_buf.get(), nullptr,
+                       read_options.rate_limiter_priority);
+  }
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  if (slot.size() != bucket_length_) {
+    return Status::Corruption("Truncated slot read");
+  }
+
+  // A key that is not in the file may hash to any slot; the key comparison
+  // rejects it. A key that is in the file is at this slot by construction.
+  if (!ucomp_->Equal(user_key, Slice(slot.data(), user_key.size()))) {
+    return Status::OK();
+  }
+  Slice value(slot.data() + key_length_, value_length_);
+  if (is_last_level_) {
+    // Sequence number is not stored at the last level, so we will use
+    // kMaxSequenceNumber since it is unknown.
+    get_context->SaveValue(value, kMaxSequenceNumber);
+  } else {
+    Slice full_key(slot.data(), key_length_);
+    ParsedInternalKey found_ikey;
+    Status s = ParseInternalKey(full_key, &found_ikey,
+                                false /* log_err_key */);
+    if (!s.ok()) {
+      return s;
+    }
+    bool dont_care __attribute__((__unused__));
+    get_context->SaveValue(found_ikey, value, &dont_care);
+  }
+  // We don't support merge operations. So, we return here.
+  return Status::OK();
+}
+
+// Iteration reads the whole slot area into memory and sorts the slots by
+// user key, like the cuckoo table iterator does. Flat table files are
+// written for point-lookup column families; iterators exist to serve
+// compaction and verification, not fast scans.
+class FlatTableIterator : public InternalIterator {
+ public:
+  explicit FlatTableIterator(FlatTableReader* reader);
+  // No copying allowed
+  FlatTableIterator(const FlatTableIterator&) = delete;
+  void operator=(const Iterator&) = delete;
+  ~FlatTableIterator() override {}
+  bool Valid() const override;
+  void SeekToFirst() override;
+  void SeekToLast() override;
+  void Seek(const Slice& target) override;
+  void SeekForPrev(const Slice& target) override;
+  void Next() override;
+  void Prev() override;
+  Slice key() const override;
+  Slice value() const override;
+  Status status() const override { return status_; }
+  void InitIfNeeded();
+
+ private:
+  struct SlotComparator {
+    SlotComparator(const FlatTableIterator* iter, const Comparator* ucomp,
+                   uint32_t bucket_len, uint32_t user_key_len,
+                   const Slice& target = Slice())
+        : iter_(iter),
+          ucomp_(ucomp),
+          bucket_len_(bucket_len),
+          user_key_len_(user_key_len),
+          target_(target) {}
+    bool operator()(const uint32_t first, const uint32_t second) const {
+      const char* first_slot =
+          (first == kInvalidIndex)
+              ? target_.data()
+              : &iter_->slots_data_[first * bucket_len_];
+      const char* second_slot =
+          (second == kInvalidIndex)
+              ? target_.data()
+              : &iter_->slots_data_[second * bucket_len_];
+      return ucomp_->Compare(Slice(first_slot, user_key_len_),
+                             Slice(second_slot, user_key_len_)) < 0;
+    }
+
+   private:
+    const FlatTableIterator* iter_;
+    const Comparator* ucomp_;
+    const uint32_t bucket_len_;
+    const uint32_t user_key_len_;
+    const Slice target_;
+  };
+
+  void PrepareKVAtCurrIdx();
+  FlatTableReader* reader_;
+  bool initialized_;
+  Status status_;
+  // In-memory copy of the slot area of the file.
+  std::unique_ptr<char[]> slots_buf_;
+  const char* slots_data_;
+  // Contains slot ids sorted in user key order.
+  std::vector<uint32_t> sorted_slot_ids_;
+  uint32_t curr_key_idx_;
+  Slice curr_value_;
+  IterKey curr_key_;
+};
+
+FlatTableIterator::FlatTableIterator(FlatTableReader* reader)
+    : reader_(reader),
+      initialized_(false),
+      slots_data_(nullptr),
+      curr_key_idx_(kInvalidIndex) {
+  sorted_slot_ids_.clear();
+  curr_value_.clear();
+  curr_key_.Clear();
+}
+
+void FlatTableIterator::InitIfNeeded() {
+  if (initialized_) {
+    return;
+  }
+  size_t slots_bytes =
+      static_cast<size_t>(reader_->num_slots_) * reader_->bucket_length_;
+  slots_buf_.reset(new char[slots_bytes]);
+  Slice result;
+  status_ = reader_->file_->Read(
+      IOOptions(), 0, slots_bytes, &result, slots_buf_.get(), nullptr,
+      Env::IO_TOTAL /* rate_limiter_priority */);
+  if (status_.ok() && result.size() != slots_bytes) {
+    status_ = Status::Corruption("Truncated slot area");
+  }
+  if (!status_.ok()) {
+    return;
+  }
+  slots_data_ = result.data();
+  sorted_slot_ids_.resize(static_cast<size_t>(reader_->num_slots_));
+  for (uint32_t slot_id = 0; slot_id < sorted_slot_ids_.size(); ++slot_id) {
+    sorted_slot_ids_[slot_id] = slot_id;
+  }
+  SlotComparator comparator(this, reader_->ucomp_, reader_->bucket_length_,
+                            reader_->user_key_length_);
+  std::sort(sorted_slot_ids_.begin(), sorted_slot_ids_.end(), comparator);
+  curr_key_idx_ = kInvalidIndex;
+  initialized_ = true;
+}
+
+void FlatTableIterator::SeekToFirst() {
+  InitIfNeeded();
+  curr_key_idx_ = 0;
+  PrepareKVAtCurrIdx();
+}
+
+void FlatTableIterator::SeekToLast() {
+  InitIfNeeded();
+  curr_key_idx_ = static_cast<uint32_t>(sorted_slot_ids_.size()) - 1;
+  PrepareKVAtCurrIdx();
+}
+
+void FlatTableIterator::Seek(const Slice& target) {
+  InitIfNeeded();
+  if (!status_.ok()) {
+    return;
+  }
+  const SlotComparator seek_comparator(this, reader_->ucomp_,
+                                       reader_->bucket_length_,
+                                       reader_->user_key_length_,
+                                       ExtractUserKey(target));
+  auto seek_it =
+      std::lower_bound(sorted_slot_ids_.begin(), sorted_slot_ids_.end(),
+                       kInvalidIndex, seek_comparator);
+  curr_key_idx_ =
+      static_cast<uint32_t>(std::distance(sorted_slot_ids_.begin(), seek_it));
+  PrepareKVAtCurrIdx();
+}
+
+void FlatTableIterator::SeekForPrev(const Slice& /*target*/) {
+  // Not supported
+  assert(false);
+}
+
+bool FlatTableIterator::Valid() const {
+  return status_.ok() && curr_key_idx_ < sorted_slot_ids_.size();
+}
+
+void FlatTableIterator::PrepareKVAtCurrIdx() {
+  if (!Valid()) {
+    curr_value_.clear();
+    curr_key_.Clear();
+    return;
+  }
+  uint32_t id = sorted_slot_ids_[curr_key_idx_];
+  const char* offset = slots_data_ + id * reader_->bucket_length_;
+  if (reader_->is_last_level_) {
+    // Always return internal key.
+    curr_key_.SetInternalKey(Slice(offset, reader_->user_key_length_), 0,
+                             kTypeValue);
+  } else {
+    curr_key_.SetInternalKey(Slice(offset, reader_->key_length_));
+  }
+  curr_value_ = Slice(offset + reader_->key_length_, reader_->value_length_);
+}
+
+void FlatTableIterator::Next() {
+  if (!Valid()) {
+    curr_value_.clear();
+    curr_key_.Clear();
+    return;
+  }
+  ++curr_key_idx_;
+  PrepareKVAtCurrIdx();
+}
+
+void FlatTableIterator::Prev() {
+  if (curr_key_idx_ == 0) {
+    curr_key_idx_ = static_cast<uint32_t>(sorted_slot_ids_.size());
+  }
+  if (!Valid()) {
+    curr_value_.clear();
+    curr_key_.Clear();
+    return;
+  }
+  --curr_key_idx_;
+  PrepareKVAtCurrIdx();
+}
+
+Slice FlatTableIterator::key() const {
+  assert(Valid());
+  return curr_key_.GetInternalKey();
+}
+
+Slice FlatTableIterator::value() const {
+  assert(Valid());
+  return curr_value_;
+}
+
+InternalIterator* FlatTableReader::NewIterator(
+    const ReadOptions& /*read_options*/,
+    const SliceTransform* /* prefix_extractor */, Arena* arena,
+    bool /*skip_filters*/, TableReaderCaller /*caller*/,
+    size_t /*compaction_readahead_size*/, bool /* allow_unprepared_value */) {
+  if (!status().ok()) {
+    return NewErrorInternalIterator<Slice>(
+        Status::Corruption("FlatTableReader status is not okay."), arena);
+  }
+  FlatTableIterator* iter;
+  if (arena == nullptr) {
+    iter = new FlatTableIterator(this);
+  } else {
+    auto iter_mem = arena->AllocateAligned(sizeof(FlatTableIterator));
+    iter = new (iter_mem) FlatTableIterator(this);
+  }
+  return iter;
+}
+
+size_t FlatTableReader::ApproximateMemoryUsage() const {
+  return displacements_.size() * sizeof(uint32_t);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "db/dbformat.h"
 #include "file/readahead_file_info.h"
@@ -32,6 +34,53 @@ struct IterateResult {
   bool value_prepared = true;
 };
 
+// A caller-owned, reusable buffer of decoded entries filled by NextBatch().
+// Value slices point into data pinned by the iterator (for block-based
+// tables, its current data block) and stay valid until the iterator is
+// advanced past the batch; key slices point into the buffer's own key store
+// because block keys are delta-decoded into a scratch buffer that is reused
+// between entries.
+struct IterateResultBuffer {
+  struct Entry {
+    Slice key;
+    Slice value;
+  };
+
+  // Filled entries. All containers keep their capacity across Clear(), so
+  // a reused buffer does not reallocate in steady state.
+  std::vector<Entry> entries;
+  // Maximum number of entries NextBatch() may produce per call.
+  size_t max_entries = 128;
+
+  void Clear() {
+    entries.clear();
+    key_buf_.clear();
+    key_ends_.clear();
+  }
+
+  bool Full() const { return entries.size() >= max_entries; }
+
+  // Copy `key` into the buffer-owned key store. Entry key slices are
+  // assigned by Finish(), once the store has stopped growing.
+  void Add(const Slice& key, const Slice& value) {
+    key_buf_.append(key.data(), key.size());
+    key_ends_.push_back(key_buf_.size());
+    entries.push_back({Slice(), value});
+  }
+
+  void Finish() {
+    size_t start = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      entries[i].key = Slice(key_buf_.data() + start, key_ends_[i] - start);
+      start = key_ends_[i];
+    }
+  }
+
+ private:
+  std::string key_buf_;
+  std::vector<size_t> key_ends_;
+};
+
 template <class TValue>
 class InternalIteratorBase : public Cleanable {
  public:
@@ -94,6 +143,28 @@ class InternalIteratorBase : public Cleanable {
     return is_valid;
   }
 
+  // Batched counterpart of NextAndGetResult(). Clears `buffer`, then fills
+  // it with the current entry followed by as many subsequent entries as the
+  // iterator can produce without invalidating already buffered data (for
+  // block-based tables, the remaining entries of the current data block),
+  // up to buffer->max_entries. On return the iterator is positioned at the
+  // last buffered entry; the caller consumes the buffer, then calls Next()
+  // to advance past it. Buffered slices stay valid until the iterator is
+  // advanced again. Only callers that apply no merging or tombstone logic
+  // on top of this iterator may use it. Implemented for iterators over
+  // Slice values; others produce an empty buffer.
+  // REQUIRES: Valid()
+  virtual void NextBatch(IterateResultBuffer* buffer) {
+    assert(Valid());
+    buffer->Clear();
+    if constexpr (std::is_same<TValue, Slice>::value) {
+      if (PrepareValue()) {
+        buffer->Add(key(), value());
+      }
+    }
+    buffer->Finish();
+  }
+
   // Moves to the previous entry in the source.  After this call, Valid() is
   // true iff the iterator was not positioned at the first entry in source.
   // REQUIRES: Valid()
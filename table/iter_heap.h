@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
 #include "db/dbformat.h"
 #include "table/iterator_wrapper.h"
+#include "util/autovector.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -39,4 +43,160 @@ class MinIteratorComparator {
   const InternalKeyComparator* comparator_;
 };
 
+// Compares two internal keys assuming the user portions order bytewise, the
+// same ordering InternalKeyComparator computes when the user comparator is
+// BytewiseComparator without timestamps. Inlined here so the merging
+// iterator's hot loop can avoid two virtual calls per comparison.
+inline int CompareInternalKeysBytewise(const Slice& a, const Slice& b) {
+  assert(a.size() >= kNumInternalBytes && b.size() >= kNumInternalBytes);
+  const size_t a_user_size = a.size() - kNumInternalBytes;
+  const size_t b_user_size = b.size() - kNumInternalBytes;
+  int r = memcmp(a.data(), b.data(), std::min(a_user_size, b_user_size));
+  if (r == 0) {
+    if (a_user_size < b_user_size) {
+      r = -1;
+    } else if (a_user_size > b_user_size) {
+      r = +1;
+    } else {
+      // Equal user keys: decreasing sequence number (and type) orders first.
+      const uint64_t a_footer = DecodeFixed64(a.data() + a_user_size);
+      const uint64_t b_footer = DecodeFixed64(b.data() + b_user_size);
+      if (a_footer > b_footer) {
+        r = -1;
+      } else if (a_footer < b_footer) {
+        r = +1;
+      }
+    }
+  }
+  return r;
+}
+
+// A tournament (loser) tree over child iterators that yields the one with the
+// min/smallest key, with the same interface the merging iterator uses on
+// BinaryHeap. Advancing the winner and replaying its path to the root costs
+// exactly ceil(log2(k)) comparisons, versus up to 2*log2(k) for a binary heap
+// sift-down, and each comparison is against a key Slice cached in a compact
+// array rather than re-fetched through IteratorWrapper. Building the tree is
+// O(k) per push, which only happens during seeks and direction switches.
+class MinIterLoserTree {
+ public:
+  explicit MinIterLoserTree(const InternalKeyComparator* comparator)
+      : comparator_(comparator),
+        bytewise_(comparator->user_comparator()->timestamp_size() == 0 &&
+                  strcmp(comparator->user_comparator()->Name(),
+                         "leveldb.BytewiseComparator") == 0) {}
+
+  bool empty() const { return alive_ == 0; }
+
+  void push(IteratorWrapper* iter) {
+    assert(iter->Valid());
+    players_.push_back({iter, iter->key(), false});
+    Build();
+  }
+
+  IteratorWrapper* top() const {
+    assert(!empty());
+    return players_[tree_[0]].iter;
+  }
+
+  // The top iterator has been advanced to a new key; re-cache it and replay
+  // its matches. `iter` must be the current top().
+  void replace_top(IteratorWrapper* iter) {
+    assert(!empty());
+    assert(players_[tree_[0]].iter == iter);
+    players_[tree_[0]].key = iter->key();
+    Replay(tree_[0]);
+  }
+
+  // Remove the top iterator. Its leaf stays in the tree as an exhausted
+  // player that loses every match.
+  void pop() {
+    assert(!empty());
+    players_[tree_[0]].exhausted = true;
+    --alive_;
+    if (alive_ > 0) {
+      Replay(tree_[0]);
+    }
+  }
+
+  void clear() {
+    players_.clear();
+    tree_.clear();
+    alive_ = 0;
+  }
+
+ private:
+  struct Player {
+    IteratorWrapper* iter;
+    Slice key;
+    bool exhausted;
+  };
+
+  // Returns the index of the player winning the match (ordering first).
+  size_t Match(size_t a, size_t b) const {
+    const Player& pa = players_[a];
+    const Player& pb = players_[b];
+    if (pa.exhausted) {
+      return b;
+    }
+    if (pb.exhausted) {
+      return a;
+    }
+    const int cmp = bytewise_ ? CompareInternalKeysBytewise(pa.key, pb.key)
+                              : comparator_->Compare(pa.key, pb.key);
+    if (cmp != 0) {
+      return cmp < 0 ? a : b;
+    }
+    return a < b ? a : b;
+  }
+
+  // Plays out the subtree rooted at `node`, recording losers along the way,
+  // and returns its winner. Player p's leaf is (virtual) node k + p.
+  size_t InitWinner(size_t node) {
+    const size_t k = players_.size();
+    if (node >= k) {
+      return node - k;
+    }
+    const size_t left = InitWinner(2 * node);
+    const size_t right = InitWinner(2 * node + 1);
+    const size_t winner = Match(left, right);
+    tree_[node] = winner == left ? right : left;
+    return winner;
+  }
+
+  void Build() {
+    const size_t k = players_.size();
+    alive_ = 0;
+    for (const Player& p : players_) {
+      alive_ += p.exhausted ? 0 : 1;
+    }
+    tree_.resize(k);
+    tree_[0] = InitWinner(1);
+  }
+
+  // Replays the matches on the path from player p's leaf to the root after
+  // p's key changed (or p was exhausted). tree_[0] holds the new winner.
+  void Replay(size_t p) {
+    const size_t k = players_.size();
+    size_t winner = p;
+    for (size_t node = (k + p) / 2; node > 0; node /= 2) {
+      const size_t challenger = tree_[node];
+      if (Match(winner, challenger) == challenger) {
+        tree_[node] = winner;
+        winner = challenger;
+      }
+    }
+    tree_[0] = winner;
+  }
+
+  const InternalKeyComparator* comparator_;
+  // True when comparisons can bypass the virtual user comparator.
+  const bool bytewise_;
+  size_t alive_ = 0;
+  autovector<Player, 8> players_;
+  // tree_[0] is the overall winner; tree_[1..k-1] hold the loser of the match
+  // played at each internal node.
+  autovector<size_t, 8> tree_;
+};
+
 }  // namespace ROCKSDB_NAMESPACE
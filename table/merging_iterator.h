@@ -35,6 +35,14 @@ extern InternalIterator* NewMergingIterator(
 
 class MergingIterator;
 
+// Add `iter` as a new child of `merging_iter`, which must be an iterator
+// previously reported through `MergeIteratorBuilder::Finish()`'s
+// `merging_iter_out` parameter. The merging iterator takes ownership of
+// `iter` and becomes invalid: a `Seek*()` call is required before it is
+// used again.
+extern void AddToMergingIterator(InternalIterator* merging_iter,
+                                 InternalIterator* iter);
+
 // A builder class to build a merging iterator by adding iterators one by one.
 class MergeIteratorBuilder {
  public:
@@ -51,8 +59,11 @@ class MergeIteratorBuilder {
   // iterator needs to be allocated.
   Arena* GetArena() { return arena; }
 
-  // Return the result merging iterator.
-  InternalIterator* Finish();
+  // Return the result merging iterator. If a merging iterator was actually
+  // built (more than one child iterator was added), `*merging_iter_out` is
+  // set to it; otherwise it is set to nullptr. The pointer can later be
+  // passed to AddToMergingIterator().
+  InternalIterator* Finish(InternalIterator** merging_iter_out = nullptr);
 
  private:
   MergingIterator* merge_iter;
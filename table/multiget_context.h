@@ -16,10 +16,12 @@
 #include "rocksdb/types.h"
 #include "util/async_file_reader.h"
 #include "util/autovector.h"
+#include "util/hash.h"
 #include "util/math.h"
 #include "util/single_thread_executor.h"
 
 namespace ROCKSDB_NAMESPACE {
+class AsyncFileReader;
 class GetContext;
 
 struct KeyContext {
@@ -27,6 +29,9 @@ struct KeyContext {
   LookupKey* lkey;
   Slice ukey_with_ts;
   Slice ukey_without_ts;
+  // GetSliceHash64 of ukey_without_ts, computed once when the batch is
+  // formed so filter probes across levels and files need not rehash the key.
+  uint64_t ukey_hash;
   Slice ikey;
   ColumnFamilyHandle* column_family;
   Status* s;
@@ -43,6 +48,7 @@ struct KeyContext {
              PinnableSlice* val, std::string* ts, Status* stat)
       : key(&user_key),
         lkey(nullptr),
+        ukey_hash(0),
         column_family(col_family),
         s(stat),
         max_covering_tombstone_seq(0),
@@ -93,33 +99,48 @@ struct KeyContext {
 //  }
 class MultiGetContext {
  public:
-  // Limit the number of keys in a batch to this number. Benchmarks show that
-  // there is negligible benefit for batches exceeding this. Keeping this < 32
-  // simplifies iteration, as well as reduces the amount of stack allocations
-  // that need to be performed
-  static const int MAX_BATCH_SIZE = 32;
-
-  // A bitmask of at least MAX_BATCH_SIZE - 1 bits, so that
-  // Mask{1} << MAX_BATCH_SIZE is well defined
+  // Limit the number of keys in a batch to this number. Larger user
+  // requests are chopped into batches of this size, each of which pays the
+  // full filter/index/seek overhead per table file, so the cap is set to the
+  // widest batch the Mask type can track. Growing it further would require
+  // a heap-allocated bit vector in place of Mask and measurably more stack
+  // in the per-level MultiGet machinery.
+  static const int MAX_BATCH_SIZE = 64;
+
+  // A bitmask with one bit per key in the batch. Shifts by a full
+  // MAX_BATCH_SIZE bits must go through BitsBelow() rather than operator<<.
   using Mask = uint64_t;
-  static_assert(MAX_BATCH_SIZE < sizeof(Mask) * 8);
+  static_assert(MAX_BATCH_SIZE <= static_cast<int>(sizeof(Mask) * 8));
 
+  // Returns a Mask with the low n bits set. Well defined for
+  // n == MAX_BATCH_SIZE == 64, unlike (Mask{1} << n) - 1.
+  static Mask BitsBelow(size_t n) {
+    return n >= sizeof(Mask) * 8 ? ~Mask{0} : (Mask{1} << n) - 1;
+  }
+
+  // If `shared_reader` is provided, async IO issued on behalf of this
+  // context is registered with it instead of the context's own reader.
+  // That lets several contexts taking part in one logical operation (e.g.
+  // the per-CF batches of a multi-CF MultiGet) be driven to completion by
+  // a single Wait() loop.
   MultiGetContext(autovector<KeyContext*, MAX_BATCH_SIZE>* sorted_keys,
                   size_t begin, size_t num_keys, SequenceNumber snapshot,
                   const ReadOptions& read_opts, FileSystem* fs,
-                  Statistics* stats)
+                  Statistics* stats, AsyncFileReader* shared_reader = nullptr)
       : num_keys_(num_keys),
         value_mask_(0),
         value_size_(0),
         lookup_key_ptr_(reinterpret_cast<LookupKey*>(lookup_key_stack_buf))
 #if USE_COROUTINES
         ,
-        reader_(fs, stats),
-        executor_(reader_)
+        owned_reader_(fs, stats),
+        reader_(shared_reader ? shared_reader : &owned_reader_),
+        executor_(*reader_)
 #endif  // USE_COROUTINES
   {
     (void)fs;
     (void)stats;
+    (void)shared_reader;
     assert(num_keys <= MAX_BATCH_SIZE);
     if (num_keys > MAX_LOOKUP_KEYS_ON_STACK) {
       lookup_key_heap_buf.reset(new char[sizeof(LookupKey) * num_keys]);
@@ -127,6 +148,8 @@ class MultiGetContext {
           lookup_key_heap_buf.get());
     }
 
+    std::array<const Slice*, MAX_BATCH_SIZE> ukeys;
+    std::array<uint64_t, MAX_BATCH_SIZE> ukey_hashes;
     for (size_t iter = 0; iter != num_keys_; ++iter) {
       // autovector may not be contiguous storage, so make a copy
       sorted_keys_[iter] = (*sorted_keys)[begin + iter];
@@ -136,11 +159,18 @@ class MultiGetContext {
       sorted_keys_[iter]->ukey_without_ts = StripTimestampFromUserKey(
           sorted_keys_[iter]->lkey->user_key(),
           read_opts.timestamp == nullptr ? 0 : read_opts.timestamp->size());
+      ukeys[iter] = &sorted_keys_[iter]->ukey_without_ts;
       sorted_keys_[iter]->ikey = sorted_keys_[iter]->lkey->internal_key();
       sorted_keys_[iter]->timestamp = (*sorted_keys)[begin + iter]->timestamp;
       sorted_keys_[iter]->get_context =
           (*sorted_keys)[begin + iter]->get_context;
     }
+    // Hash every key in the batch up front; whole key filter probes reuse
+    // the memoized hash for each file probed instead of rehashing.
+    GetSliceHashes64(ukeys.data(), num_keys_, ukey_hashes.data());
+    for (size_t iter = 0; iter != num_keys_; ++iter) {
+      sorted_keys_[iter]->ukey_hash = ukey_hashes[iter];
+    }
   }
 
   ~MultiGetContext() {
@@ -152,7 +182,7 @@ class MultiGetContext {
 #if USE_COROUTINES
   SingleThreadExecutor& executor() { return executor_; }
 
-  AsyncFileReader& reader() { return reader_; }
+  AsyncFileReader& reader() { return *reader_; }
 #endif  // USE_COROUTINES
 
  private:
@@ -166,7 +196,8 @@ class MultiGetContext {
   std::unique_ptr<char[]> lookup_key_heap_buf;
   LookupKey* lookup_key_ptr_;
 #if USE_COROUTINES
-  AsyncFileReader reader_;
+  AsyncFileReader owned_reader_;
+  AsyncFileReader* reader_;
   SingleThreadExecutor executor_;
 #endif  // USE_COROUTINES
 
@@ -314,11 +345,11 @@ class MultiGetContext {
 
     Range(MultiGetContext* ctx, size_t num_keys)
         : ctx_(ctx), start_(0), end_(num_keys), skip_mask_(0) {
-      assert(num_keys < 64);
+      assert(num_keys <= MAX_BATCH_SIZE);
     }
 
     Mask RemainingMask() const {
-      return (((Mask{1} << end_) - 1) & ~((Mask{1} << start_) - 1) &
+      return (BitsBelow(end_) & ~BitsBelow(start_) &
               ~(ctx_->value_mask_ | skip_mask_));
     }
 
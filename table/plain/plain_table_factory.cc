@@ -221,6 +221,20 @@ static int RegisterBuiltinMemTableRepFactory(ObjectLibrary& library,
         }
         return guard->get();
       });
+  library.AddFactory<MemTableRepFactory>(
+      AsPattern("ShardedSkipListRepFactory", "sharded_skiplist"),
+      [](const std::string& uri, std::unique_ptr<MemTableRepFactory>* guard,
+         std::string* /*errmsg*/) {
+        // Expecting format: sharded_skiplist:<num_shards>
+        auto colon = uri.find(":");
+        if (colon != std::string::npos) {
+          size_t num_shards = ParseSizeT(uri.substr(colon + 1));
+          guard->reset(NewShardedSkipListRepFactory(num_shards));
+        } else {
+          guard->reset(NewShardedSkipListRepFactory());
+        }
+        return guard->get();
+      });
   library.AddFactory<MemTableRepFactory>(
       "cuckoo",
       [](const std::string& /*uri*/,
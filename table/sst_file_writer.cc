@@ -5,16 +5,20 @@
 
 #include "rocksdb/sst_file_writer.h"
 
+#include <deque>
+#include <utility>
 #include <vector>
 
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
 #include "file/writable_file_writer.h"
+#include "port/port.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_builder.h"
 #include "table/sst_file_writer_collectors.h"
 #include "test_util/sync_point.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -27,11 +31,18 @@ const std::string ExternalSstFilePropertyNames::kGlobalSeqno =
 
 const size_t kFadviseTrigger = 1024 * 1024; // 1MB
 
+// Entries handed off to the background builder thread of a pipelined build
+// are batched to keep lock and condition variable traffic low, and the
+// queue of batches is bounded so a slow builder applies backpressure
+// instead of buffering an arbitrarily large part of the file.
+const size_t kPipelineBatchBytes = 256 * 1024;
+const size_t kPipelineMaxQueuedBatches = 32;
+
 struct SstFileWriter::Rep {
   Rep(const EnvOptions& _env_options, const Options& options,
       Env::IOPriority _io_priority, const Comparator* _user_comparator,
       ColumnFamilyHandle* _cfh, bool _invalidate_page_cache, bool _skip_filters,
-      std::string _db_session_id)
+      bool _pipelined_build, std::string _db_session_id)
       : env_options(_env_options),
         ioptions(options),
         mutable_cf_options(options),
@@ -40,7 +51,9 @@ struct SstFileWriter::Rep {
         cfh(_cfh),
         invalidate_page_cache(_invalidate_page_cache),
         skip_filters(_skip_filters),
-        db_session_id(_db_session_id) {}
+        pipelined_build(_pipelined_build),
+        db_session_id(_db_session_id),
+        queue_cv(&queue_mutex) {}
 
   std::unique_ptr<WritableFileWriter> file_writer;
   std::unique_ptr<TableBuilder> builder;
@@ -60,9 +73,27 @@ struct SstFileWriter::Rep {
   // cached pages from page cache.
   uint64_t last_fadvise_size = 0;
   bool skip_filters;
+  // If true, entries are handed off to a dedicated builder thread instead of
+  // being fed to the builder from the caller of Add()/Put()/etc.
+  bool pipelined_build;
   std::string db_session_id;
   uint64_t next_file_number = 1;
 
+  // State of the pipelined build. The caller thread accumulates entries in
+  // pending_batch and moves it into batch_queue under queue_mutex; the
+  // builder thread drains the queue and feeds the builder. Errors are left
+  // in the builder and surface on Finish(), same as a non-pipelined build.
+  struct EntryBatch {
+    std::vector<std::pair<std::string, std::string>> entries;
+    size_t bytes = 0;
+  };
+  port::Mutex queue_mutex;
+  port::CondVar queue_cv;
+  std::deque<EntryBatch> batch_queue;
+  bool no_more_batches = false;
+  EntryBatch pending_batch;
+  port::Thread builder_thread;
+
   Status AddImpl(const Slice& user_key, const Slice& value,
                  ValueType value_type) {
     if (!builder) {
@@ -88,14 +119,20 @@ struct SstFileWriter::Rep {
 
     ikey.Set(user_key, sequence_number, value_type);
 
-    builder->Add(ikey.Encode(), value);
+    if (pipelined_build) {
+      EnqueueEntry(ikey.Encode(), value);
+    } else {
+      builder->Add(ikey.Encode(), value);
+      InvalidatePageCache(false /* closing */).PermitUncheckedError();
+    }
 
     // update file info
     file_info.num_entries++;
     file_info.largest_key.assign(user_key.data(), user_key.size());
+    // With a pipelined build this lags behind the handed-off entries, but
+    // the builder's offset is an atomic so the read itself is safe.
     file_info.file_size = builder->FileSize();
 
-    InvalidatePageCache(false /* closing */).PermitUncheckedError();
     return Status::OK();
   }
 
@@ -160,16 +197,78 @@ struct SstFileWriter::Rep {
     }
 
     auto ikey_and_end_key = tombstone.Serialize();
-    builder->Add(ikey_and_end_key.first.Encode(), ikey_and_end_key.second);
+    if (pipelined_build) {
+      EnqueueEntry(ikey_and_end_key.first.Encode(), ikey_and_end_key.second);
+    } else {
+      builder->Add(ikey_and_end_key.first.Encode(), ikey_and_end_key.second);
+      InvalidatePageCache(false /* closing */).PermitUncheckedError();
+    }
 
     // update file info
     file_info.num_range_del_entries++;
     file_info.file_size = builder->FileSize();
 
-    InvalidatePageCache(false /* closing */).PermitUncheckedError();
     return Status::OK();
   }
 
+  void EnqueueEntry(const Slice& key, const Slice& value) {
+    pending_batch.entries.emplace_back(key.ToString(), value.ToString());
+    pending_batch.bytes += key.size() + value.size();
+    if (pending_batch.bytes >= kPipelineBatchBytes) {
+      FlushPendingBatch();
+    }
+  }
+
+  void FlushPendingBatch() {
+    if (pending_batch.entries.empty()) {
+      return;
+    }
+    MutexLock l(&queue_mutex);
+    while (batch_queue.size() >= kPipelineMaxQueuedBatches) {
+      queue_cv.Wait();
+    }
+    batch_queue.push_back(std::move(pending_batch));
+    pending_batch = EntryBatch();
+    queue_cv.SignalAll();
+  }
+
+  void BackgroundBuild() {
+    for (;;) {
+      EntryBatch batch;
+      {
+        MutexLock l(&queue_mutex);
+        while (batch_queue.empty() && !no_more_batches) {
+          queue_cv.Wait();
+        }
+        if (batch_queue.empty()) {
+          return;
+        }
+        batch = std::move(batch_queue.front());
+        batch_queue.pop_front();
+        queue_cv.SignalAll();
+      }
+      for (const auto& entry : batch.entries) {
+        builder->Add(entry.first, entry.second);
+      }
+      InvalidatePageCache(false /* closing */).PermitUncheckedError();
+    }
+  }
+
+  // Hand any buffered entries to the builder thread and wait for it to
+  // drain the queue. After this the builder is in the same state as after
+  // an equivalent sequence of synchronous Add() calls.
+  void JoinBuilderThread() {
+    if (builder_thread.joinable()) {
+      FlushPendingBatch();
+      {
+        MutexLock l(&queue_mutex);
+        no_more_batches = true;
+        queue_cv.SignalAll();
+      }
+      builder_thread.join();
+    }
+  }
+
   Status InvalidatePageCache(bool closing) {
     Status s = Status::OK();
     if (invalidate_page_cache == false) {
@@ -199,9 +298,11 @@ SstFileWriter::SstFileWriter(const EnvOptions& env_options,
                              const Comparator* user_comparator,
                              ColumnFamilyHandle* column_family,
                              bool invalidate_page_cache,
-                             Env::IOPriority io_priority, bool skip_filters)
+                             Env::IOPriority io_priority, bool skip_filters,
+                             bool pipelined_build)
     : rep_(new Rep(env_options, options, io_priority, user_comparator,
                    column_family, invalidate_page_cache, skip_filters,
+                   pipelined_build,
                    DBImpl::GenerateDbSessionId(options.env))) {
   // SstFileWriter is used to create sst files that can be added to database
   // later. Therefore, no real db_id and db_session_id are associated with it.
@@ -213,6 +314,7 @@ SstFileWriter::SstFileWriter(const EnvOptions& env_options,
 }
 
 SstFileWriter::~SstFileWriter() {
+  rep_->JoinBuilderThread();
   if (rep_->builder) {
     // User did not call Finish() or Finish() failed, we need to
     // abandon the builder.
@@ -312,6 +414,11 @@ Status SstFileWriter::Open(const std::string& file_path) {
   r->file_info = ExternalSstFileInfo();
   r->file_info.file_path = file_path;
   r->file_info.version = 2;
+
+  if (r->pipelined_build) {
+    r->no_more_batches = false;
+    r->builder_thread = port::Thread(&Rep::BackgroundBuild, r);
+  }
   return s;
 }
 
@@ -356,6 +463,8 @@ Status SstFileWriter::Finish(ExternalSstFileInfo* file_info) {
     return Status::InvalidArgument("Cannot create sst file with no entries");
   }
 
+  r->JoinBuilderThread();
+
   Status s = r->builder->Finish();
   r->file_info.file_size = r->builder->FileSize();
 
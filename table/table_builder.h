@@ -40,13 +40,14 @@ struct TableReaderOptions {
       bool _force_direct_prefetch = false, int _level = -1,
       BlockCacheTracer* const _block_cache_tracer = nullptr,
       size_t _max_file_size_for_l0_meta_pin = 0,
-      const std::string& _cur_db_session_id = "", uint64_t _cur_file_num = 0)
+      const std::string& _cur_db_session_id = "", uint64_t _cur_file_num = 0,
+      uint64_t _tail_size = 0)
       : TableReaderOptions(
             _ioptions, _prefix_extractor, _env_options, _internal_comparator,
             _skip_filters, _immortal, _force_direct_prefetch, _level,
             0 /* _largest_seqno */, _block_cache_tracer,
-            _max_file_size_for_l0_meta_pin, _cur_db_session_id, _cur_file_num) {
-  }
+            _max_file_size_for_l0_meta_pin, _cur_db_session_id, _cur_file_num,
+            _tail_size) {}
 
   // @param skip_filters Disables loading/accessing the filter block
   TableReaderOptions(
@@ -58,7 +59,8 @@ struct TableReaderOptions {
       SequenceNumber _largest_seqno,
       BlockCacheTracer* const _block_cache_tracer,
       size_t _max_file_size_for_l0_meta_pin,
-      const std::string& _cur_db_session_id, uint64_t _cur_file_num)
+      const std::string& _cur_db_session_id, uint64_t _cur_file_num,
+      uint64_t _tail_size = 0)
       : ioptions(_ioptions),
         prefix_extractor(_prefix_extractor),
         env_options(_env_options),
@@ -71,7 +73,8 @@ struct TableReaderOptions {
         block_cache_tracer(_block_cache_tracer),
         max_file_size_for_l0_meta_pin(_max_file_size_for_l0_meta_pin),
         cur_db_session_id(_cur_db_session_id),
-        cur_file_num(_cur_file_num) {}
+        cur_file_num(_cur_file_num),
+        tail_size(_tail_size) {}
 
   const ImmutableOptions& ioptions;
   const std::shared_ptr<const SliceTransform>& prefix_extractor;
@@ -98,6 +101,11 @@ struct TableReaderOptions {
   std::string cur_db_session_id;
 
   uint64_t cur_file_num;
+
+  // Size of the file tail (meta blocks + footer) as recorded in the MANIFEST
+  // at file creation time, or 0 when unknown. When non-zero, table open can
+  // prefetch exactly the tail instead of guessing a prefetch size.
+  uint64_t tail_size;
 };
 
 struct TableBuilderOptions {
@@ -155,6 +163,14 @@ struct TableBuilderOptions {
   // want to skip filters, that should be (for example) null filter_policy
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
+
+  // If non-null, a cache shared by the output files of one (sub)compaction
+  // for the raw compression dictionary. When the cached string is non-empty
+  // the builder uses it as the dictionary and skips buffering and training;
+  // when it is empty the builder trains a dictionary as usual and stores
+  // the result for the next file. See
+  // CompressionOptions::share_compaction_dict.
+  std::shared_ptr<std::string> compression_dict_cache = nullptr;
   const uint64_t cur_file_num;
 };
 
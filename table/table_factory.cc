@@ -11,6 +11,7 @@
 #include "rocksdb/utilities/object_registry.h"
 #include "table/block_based/block_based_table_factory.h"
 #include "table/cuckoo/cuckoo_table_factory.h"
+#include "table/flat/flat_table_factory.h"
 #include "table/plain/plain_table_factory.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -41,6 +42,13 @@ static void RegisterTableFactories(const std::string& /*arg*/) {
           guard->reset(new CuckooTableFactory());
           return guard->get();
         });
+    library->AddFactory<TableFactory>(
+        TableFactory::kFlatTableName(),
+        [](const std::string& /*uri*/, std::unique_ptr<TableFactory>* guard,
+           std::string* /* errmsg */) {
+          guard->reset(new FlatTableFactory());
+          return guard->get();
+        });
   });
 #endif  // ROCKSDB_LITE
 }
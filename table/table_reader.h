@@ -8,11 +8,12 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #pragma once
+#include <map>
 #include <memory>
+
 #include "db/range_tombstone_fragmenter.h"
 #if USE_COROUTINES
-#include "folly/experimental/coro/Coroutine.h"
-#include "folly/experimental/coro/Task.h"
+#include "util/coro_utils.h"
 #endif
 #include "rocksdb/slice_transform.h"
 #include "table/get_context.h"
@@ -100,6 +101,48 @@ class TableReader {
     return Status::NotSupported("ApproximateKeyAnchors() not supported.");
   }
 
+  struct CachedKeyRange {
+    CachedKeyRange(std::string _start_user_key, std::string _end_user_key)
+        : start_user_key(std::move(_start_user_key)),
+          end_user_key(std::move(_end_user_key)) {}
+    // A user key strictly below all keys in the cached blocks, or the empty
+    // string if the range starts at the beginning of the file.
+    std::string start_user_key;
+    // The last user key covered by the cached blocks (inclusive).
+    std::string end_user_key;
+  };
+
+  // Append to `ranges` the user-key ranges whose data blocks are currently
+  // resident in the block cache. Runs of consecutive resident blocks are
+  // coalesced into a single range. Returns OK and appends nothing if the
+  // table is not backed by a block cache.
+  virtual Status ApproximateCachedKeyRanges(
+      const ReadOptions& /*read_options*/,
+      std::vector<CachedKeyRange>& /*ranges*/) {
+    return Status::NotSupported("ApproximateCachedKeyRanges() not supported.");
+  }
+
+  // Cumulative block cache interaction counters for one category of blocks.
+  struct CacheHeatEntry {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+  };
+
+  // Accumulate this table's cumulative block cache hit/miss/insert counts
+  // into `heat`, keyed by block type name (e.g. "data", "index", "filter").
+  // The counters cover the lifetime of this reader. The default
+  // implementation is for readers that do not interact with the block cache
+  // and adds nothing.
+  virtual void GetBlockCacheHeat(
+      std::map<std::string, CacheHeatEntry>* /*heat*/) const {}
+
+  // Periodically invoked (outside the DB mutex) for readers that support
+  // adaptive pinning of metadata blocks; see
+  // MetadataCacheOptions::adaptive_pinning_min_accesses. The default
+  // implementation does nothing.
+  virtual void MaintainAdaptivePinning() {}
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
@@ -139,7 +182,7 @@ class TableReader {
   }
 
 #if USE_COROUTINES
-  virtual folly::coro::Task<void> MultiGetCoroutine(
+  virtual ROCKSDB_CORO_TASK<void> MultiGetCoroutine(
       const ReadOptions& readOptions, const MultiGetContext::Range* mget_range,
       const SliceTransform* prefix_extractor, bool skip_filters = false) {
     MultiGet(readOptions, mget_range, prefix_extractor, skip_filters);
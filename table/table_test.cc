@@ -56,6 +56,7 @@
 #include "table/block_based/block_builder.h"
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/flush_block_policy.h"
+#include "table/block_based/uncompression_dict_pool.h"
 #include "table/block_fetcher.h"
 #include "table/format.h"
 #include "table/get_context.h"
@@ -5012,6 +5013,245 @@ TEST_P(BlockBasedTableTest, SeekMetaBlocks) {
   c.ResetTableReader();
 }
 
+TEST_P(BlockBasedTableTest, FixedStrideIndexHandles) {
+  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  std::string value(64, 'v');
+  for (int i = 0; i < 300; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "key%04d", i);
+    c.Add(key, value);
+  }
+
+  Options options;
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 256;  // many data blocks -> many index entries
+  table_options.use_fixed_stride_index_handles = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  c.Finish(options, ioptions, moptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  // All entries must be found both by scanning and by seeking, which
+  // exercises handle decoding from the fixed-stride offset array.
+  std::unique_ptr<InternalIterator> iter(c.NewIterator(nullptr));
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(kv.first, iter->key().ToString());
+    ASSERT_EQ(kv.second, iter->value().ToString());
+    iter->Next();
+  }
+  ASSERT_TRUE(!iter->Valid());
+  ASSERT_OK(iter->status());
+  for (const auto& kv : kvmap) {
+    iter->Seek(kv.first);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(kv.first, iter->key().ToString());
+    ASSERT_EQ(kv.second, iter->value().ToString());
+  }
+
+  // The index entries carry no inline handles; the offsets live in the
+  // dedicated meta block instead.
+  test::StringSink* table_sink = c.TEST_GetSink();
+  std::unique_ptr<FSRandomAccessFile> source(new test::StringSource(
+      table_sink->contents(), 0 /* unique_id */, false /* allow_mmap_reads */));
+  std::unique_ptr<RandomAccessFileReader> table_reader(
+      new RandomAccessFileReader(std::move(source), "test"));
+  size_t table_size = table_sink->contents().size();
+
+  Footer footer;
+  IOOptions opts;
+  ASSERT_OK(ReadFooterFromFile(opts, table_reader.get(),
+                               nullptr /* prefetch_buffer */, table_size,
+                               &footer, kBlockBasedTableMagicNumber));
+
+  auto metaindex_handle = footer.metaindex_handle();
+  BlockContents metaindex_contents;
+  PersistentCacheOptions pcache_opts;
+  BlockFetcher block_fetcher(
+      table_reader.get(), nullptr /* prefetch_buffer */, footer, ReadOptions(),
+      metaindex_handle, &metaindex_contents, ioptions, false /* decompress */,
+      false /*maybe_compressed*/, BlockType::kMetaIndex,
+      UncompressionDict::GetEmptyDict(), pcache_opts,
+      nullptr /*memory_allocator*/);
+  ASSERT_OK(block_fetcher.ReadBlockContents());
+  Block metaindex_block(std::move(metaindex_contents));
+
+  std::unique_ptr<MetaBlockIter> metaindex_iter(
+      metaindex_block.NewMetaIterator());
+  metaindex_iter->Seek(kIndexHandleOffsetsBlock);
+  ASSERT_TRUE(metaindex_iter->Valid());
+  ASSERT_EQ(kIndexHandleOffsetsBlock, metaindex_iter->key().ToString());
+
+  c.ResetTableReader();
+}
+
+TEST_P(BlockBasedTableTest, WholeKeyHashIndex) {
+  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  std::string value(64, 'v');
+  for (int i = 0; i < 300; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "key%04d", i * 2);
+    c.Add(key, value);
+  }
+
+  Options options;
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 256;  // many data blocks -> many index entries
+  table_options.index_type = BlockBasedTableOptions::kWholeKeyHashSearch;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  c.Finish(options, ioptions, moptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  // Point lookups go through the hash index (and, on collision, through the
+  // binary search fallback); both present and absent keys must be resolved
+  // correctly.
+  for (int i = 0; i < 600; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "key%04d", i);
+    std::string user_key(key);
+    InternalKey internal_key(user_key, 0, kTypeValue);
+    PinnableSlice result;
+    GetContext get_context(options.comparator, nullptr, nullptr, nullptr,
+                           GetContext::kNotFound, user_key, &result, nullptr,
+                           nullptr, true, nullptr, nullptr);
+    ASSERT_OK(c.GetTableReader()->Get(ReadOptions(), internal_key.Encode(),
+                                      &get_context,
+                                      moptions.prefix_extractor.get()));
+    if (i % 2 == 0) {
+      ASSERT_EQ(get_context.State(), GetContext::kFound);
+      ASSERT_EQ(result.ToString(), value);
+    } else {
+      ASSERT_EQ(get_context.State(), GetContext::kNotFound);
+    }
+  }
+
+  // Ordinary iterators must bypass the hash index and honor total order.
+  std::unique_ptr<InternalIterator> iter(c.NewIterator(nullptr));
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(kv.first, iter->key().ToString());
+    ASSERT_EQ(kv.second, iter->value().ToString());
+    iter->Next();
+  }
+  ASSERT_TRUE(!iter->Valid());
+  ASSERT_OK(iter->status());
+  for (const auto& kv : kvmap) {
+    iter->Seek(kv.first);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(kv.first, iter->key().ToString());
+    ASSERT_EQ(kv.second, iter->value().ToString());
+  }
+
+  // The serialized bucket array must be present in the metaindex.
+  test::StringSink* table_sink = c.TEST_GetSink();
+  std::unique_ptr<FSRandomAccessFile> source(new test::StringSource(
+      table_sink->contents(), 0 /* unique_id */, false /* allow_mmap_reads */));
+  std::unique_ptr<RandomAccessFileReader> table_reader(
+      new RandomAccessFileReader(std::move(source), "test"));
+  size_t table_size = table_sink->contents().size();
+
+  Footer footer;
+  IOOptions opts;
+  ASSERT_OK(ReadFooterFromFile(opts, table_reader.get(),
+                               nullptr /* prefetch_buffer */, table_size,
+                               &footer, kBlockBasedTableMagicNumber));
+
+  auto metaindex_handle = footer.metaindex_handle();
+  BlockContents metaindex_contents;
+  PersistentCacheOptions pcache_opts;
+  BlockFetcher block_fetcher(
+      table_reader.get(), nullptr /* prefetch_buffer */, footer, ReadOptions(),
+      metaindex_handle, &metaindex_contents, ioptions, false /* decompress */,
+      false /*maybe_compressed*/, BlockType::kMetaIndex,
+      UncompressionDict::GetEmptyDict(), pcache_opts,
+      nullptr /*memory_allocator*/);
+  ASSERT_OK(block_fetcher.ReadBlockContents());
+  Block metaindex_block(std::move(metaindex_contents));
+
+  std::unique_ptr<MetaBlockIter> metaindex_iter2(
+      metaindex_block.NewMetaIterator());
+  metaindex_iter2->Seek(kWholeKeyHashIndexBlock);
+  ASSERT_TRUE(metaindex_iter2->Valid());
+  ASSERT_EQ(kWholeKeyHashIndexBlock, metaindex_iter2->key().ToString());
+
+  c.ResetTableReader();
+}
+
+TEST_P(BlockBasedTableTest, HotKeyHandleCache) {
+  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  for (int i = 0; i < 300; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "key%04d", i * 2);
+    c.Add(key, std::string("value-") + key);
+  }
+
+  Options options;
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 256;  // many data blocks -> many index seeks
+  table_options.hot_key_handle_cache_entries = 512;
+  table_options.block_cache = NewLRUCache(8 * 1024 * 1024);
+  table_options.cache_index_and_filter_blocks = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  c.Finish(options, ioptions, moptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  // One round of Gets for present and absent keys, verifying the results.
+  auto run_gets = [&]() {
+    for (int i = 0; i < 600; ++i) {
+      char key[32];
+      snprintf(key, sizeof(key), "key%04d", i);
+      std::string user_key(key);
+      InternalKey internal_key(user_key, 0, kTypeValue);
+      PinnableSlice result;
+      GetContext get_context(options.comparator, nullptr, nullptr, nullptr,
+                             GetContext::kNotFound, user_key, &result, nullptr,
+                             nullptr, true, nullptr, nullptr);
+      ASSERT_OK(c.GetTableReader()->Get(ReadOptions(), internal_key.Encode(),
+                                        &get_context,
+                                        moptions.prefix_extractor.get()));
+      if (i % 2 == 0) {
+        ASSERT_EQ(get_context.State(), GetContext::kFound);
+        ASSERT_EQ(result.ToString(), std::string("value-") + key);
+      } else {
+        ASSERT_EQ(get_context.State(), GetContext::kNotFound);
+      }
+    }
+  };
+  auto index_accesses = [&]() {
+    return get_perf_context()->block_cache_index_hit_count +
+           get_perf_context()->index_block_read_count;
+  };
+
+  // The first round runs every lookup through the index and populates the
+  // hot-key cache for the keys that were found.
+  get_perf_context()->Reset();
+  run_gets();
+  uint64_t cold_accesses = index_accesses();
+  ASSERT_GT(cold_accesses, 0);
+
+  // In the second round the cached present keys resolve without an index
+  // seek; absent keys and keys whose cached block fails validation (e.g.
+  // the first key of a block) still fall back to the index path.
+  get_perf_context()->Reset();
+  run_gets();
+  ASSERT_LT(index_accesses(), cold_accesses);
+
+  c.ResetTableReader();
+}
+
 TEST_P(BlockBasedTableTest, BadOptions) {
   ROCKSDB_NAMESPACE::Options options;
   options.compression = kNoCompression;
@@ -5032,6 +5272,38 @@ TEST_P(BlockBasedTableTest, BadOptions) {
   ASSERT_NOK(ROCKSDB_NAMESPACE::DB::Open(options, kDBPath, &db));
 }
 
+TEST_P(BlockBasedTableTest, UncompressionDictPoolDedupe) {
+  UncompressionDictPool pool;
+
+  const std::string dict_a(1024, 'a');
+  const std::string dict_b(1024, 'b');
+
+  std::shared_ptr<UncompressionDict> a1 =
+      pool.GetOrCreate(dict_a, false /* using_zstd */);
+  std::shared_ptr<UncompressionDict> a2 =
+      pool.GetOrCreate(dict_a, false /* using_zstd */);
+  std::shared_ptr<UncompressionDict> b1 =
+      pool.GetOrCreate(dict_b, false /* using_zstd */);
+
+  // Identical content shares one digested dictionary; different content
+  // does not.
+  ASSERT_EQ(a1.get(), a2.get());
+  ASSERT_NE(a1.get(), b1.get());
+  ASSERT_EQ(a1->GetRawDict(), Slice(dict_a));
+  ASSERT_EQ(2u, pool.TEST_LiveEntryCount());
+
+  // Entries only live as long as some user holds them.
+  a1.reset();
+  a2.reset();
+  ASSERT_EQ(1u, pool.TEST_LiveEntryCount());
+
+  // A dropped entry can be repopulated.
+  std::shared_ptr<UncompressionDict> a3 =
+      pool.GetOrCreate(dict_a, false /* using_zstd */);
+  ASSERT_EQ(a3->GetRawDict(), Slice(dict_a));
+  ASSERT_EQ(2u, pool.TEST_LiveEntryCount());
+}
+
 TEST_F(BBTTailPrefetchTest, TestTailPrefetchStats) {
   TailPrefetchStats tpstats;
   ASSERT_EQ(0, tpstats.GetSuggestedPrefetchSize());
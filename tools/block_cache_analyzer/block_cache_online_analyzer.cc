@@ -0,0 +1,94 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include "tools/block_cache_analyzer/block_cache_online_analyzer.h"
+
+#include <limits>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+BlockCacheOnlineAnalyzer::BlockCacheOnlineAnalyzer(
+    uint64_t warmup_seconds, uint32_t downsample_ratio,
+    const std::vector<CacheConfiguration>& cache_configurations,
+    const std::vector<uint64_t>& reuse_distance_bucket_bounds)
+    : cache_simulator_(new BlockCacheTraceSimulator(
+          warmup_seconds, downsample_ratio, cache_configurations)) {
+  for (uint64_t bound : reuse_distance_bucket_bounds) {
+    reuse_distance_histogram_[bound] = 0;
+  }
+  reuse_distance_histogram_[std::numeric_limits<uint64_t>::max()] = 0;
+}
+
+Status BlockCacheOnlineAnalyzer::InitializeCaches() {
+  return cache_simulator_->InitializeCaches();
+}
+
+void BlockCacheOnlineAnalyzer::OnBlockCacheAccess(
+    const BlockCacheTraceRecord& record) {
+  MutexLock lock(&mutex_);
+  num_accesses_++;
+  cache_simulator_->Access(record);
+
+  auto it = last_access_bytes_.find(record.block_key);
+  if (it != last_access_bytes_.end()) {
+    const uint64_t reuse_distance = cumulative_bytes_ - it->second;
+    // The first bucket whose upper bound covers the distance; the
+    // overflow bucket guarantees one exists.
+    reuse_distance_histogram_.lower_bound(reuse_distance)->second++;
+  }
+  cumulative_bytes_ += record.block_size;
+  if (it != last_access_bytes_.end()) {
+    it->second = cumulative_bytes_;
+  } else {
+    last_access_bytes_[record.block_key] = cumulative_bytes_;
+  }
+}
+
+std::map<CacheConfiguration, std::vector<double>>
+BlockCacheOnlineAnalyzer::GetMissRatioCurves() const {
+  MutexLock lock(&mutex_);
+  std::map<CacheConfiguration, std::vector<double>> curves;
+  for (const auto& config_caches : cache_simulator_->sim_caches()) {
+    std::vector<double>& miss_ratios = curves[config_caches.first];
+    miss_ratios.reserve(config_caches.second.size());
+    for (const auto& sim_cache : config_caches.second) {
+      miss_ratios.push_back(sim_cache->miss_ratio_stats().miss_ratio());
+    }
+  }
+  return curves;
+}
+
+std::map<uint64_t, uint64_t>
+BlockCacheOnlineAnalyzer::GetReuseDistanceHistogram() const {
+  MutexLock lock(&mutex_);
+  return reuse_distance_histogram_;
+}
+
+uint64_t BlockCacheOnlineAnalyzer::num_accesses() const {
+  MutexLock lock(&mutex_);
+  return num_accesses_;
+}
+
+void BlockCacheOnlineAnalyzer::ResetCounters() {
+  MutexLock lock(&mutex_);
+  for (const auto& config_caches : cache_simulator_->sim_caches()) {
+    for (const auto& sim_cache : config_caches.second) {
+      sim_cache->reset_counter();
+    }
+  }
+  for (auto& bucket : reuse_distance_histogram_) {
+    bucket.second = 0;
+  }
+  last_access_bytes_.clear();
+  cumulative_bytes_ = 0;
+  num_accesses_ = 0;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,91 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#ifndef ROCKSDB_LITE
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "trace_replay/block_cache_tracer.h"
+#include "utilities/simulator_cache/cache_simulator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Maintains rolling miss-ratio-vs-capacity curves and a reuse-distance
+// histogram over the block cache accesses of a live host, so questions
+// like "what would doubling the cache buy" can be answered online instead
+// of collecting a full trace file and running the offline
+// block_cache_trace_analyzer over it.
+//
+// Attach with BlockCacheTracer::StartOnlineAnalysis(). The miss ratio
+// curves are produced by the same cache simulators the offline analyzer
+// uses; for rolling results, periodically harvest the curves and call
+// ResetCounters() (the simulated caches stay warm across resets).
+//
+// The reuse distance of an access is approximated online as the total
+// bytes of blocks accessed since the previous access to the same block.
+// Unlike the offline analyzer's measure it counts repeated accesses to
+// other blocks multiple times, so it is an upper bound, but it is
+// maintainable in O(1) per access. The per-block bookkeeping grows with
+// the number of distinct blocks seen and is dropped on ResetCounters().
+class BlockCacheOnlineAnalyzer : public BlockCacheTraceListener {
+ public:
+  // warmup_seconds and downsample_ratio apply to the simulated caches,
+  // with the same meaning as in BlockCacheTraceSimulator.
+  // reuse_distance_bucket_bounds are the inclusive upper bounds (in
+  // bytes) of the reuse-distance histogram buckets, in increasing order;
+  // an overflow bucket is always appended.
+  BlockCacheOnlineAnalyzer(
+      uint64_t warmup_seconds, uint32_t downsample_ratio,
+      const std::vector<CacheConfiguration>& cache_configurations,
+      const std::vector<uint64_t>& reuse_distance_bucket_bounds);
+  ~BlockCacheOnlineAnalyzer() override = default;
+  // No copy and move.
+  BlockCacheOnlineAnalyzer(const BlockCacheOnlineAnalyzer&) = delete;
+  BlockCacheOnlineAnalyzer& operator=(const BlockCacheOnlineAnalyzer&) = delete;
+  BlockCacheOnlineAnalyzer(BlockCacheOnlineAnalyzer&&) = delete;
+  BlockCacheOnlineAnalyzer& operator=(BlockCacheOnlineAnalyzer&&) = delete;
+
+  // Create the simulated caches. Must be called (and succeed) before the
+  // analyzer is attached to a tracer.
+  Status InitializeCaches();
+
+  void OnBlockCacheAccess(const BlockCacheTraceRecord& record) override;
+
+  // Miss ratios (in %) per cache configuration, parallel to the
+  // configuration's cache_capacities. A miss ratio is -1 if the simulated
+  // cache has not observed any access since the last reset.
+  std::map<CacheConfiguration, std::vector<double>> GetMissRatioCurves() const;
+
+  // Reuse-distance histogram: bucket upper bound (in bytes) to the number
+  // of re-accesses whose reuse distance fell into the bucket. The last
+  // bucket's bound is the maximum uint64_t.
+  std::map<uint64_t, uint64_t> GetReuseDistanceHistogram() const;
+
+  uint64_t num_accesses() const;
+
+  // Reset the hit/miss counters, the reuse-distance histogram and the
+  // per-block bookkeeping. The simulated caches keep their contents, so
+  // the curves keep reflecting warmed caches.
+  void ResetCounters();
+
+ private:
+  mutable port::Mutex mutex_;
+  std::unique_ptr<BlockCacheTraceSimulator> cache_simulator_;
+  // Bucket upper bound -> count.
+  std::map<uint64_t, uint64_t> reuse_distance_histogram_;
+  // Block key -> value of cumulative_bytes_ right after the block's last
+  // access.
+  std::unordered_map<std::string, uint64_t> last_access_bytes_;
+  uint64_t cumulative_bytes_ = 0;
+  uint64_t num_accesses_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // ROCKSDB_LITE
@@ -25,6 +25,7 @@ int main() {
 #include "rocksdb/trace_record.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
+#include "tools/block_cache_analyzer/block_cache_online_analyzer.h"
 #include "tools/block_cache_analyzer/block_cache_trace_analyzer.h"
 #include "trace_replay/block_cache_tracer.h"
 
@@ -708,6 +709,91 @@ TEST_F(BlockCacheTracerTest, MixedBlocks) {
   }
 }
 
+TEST_F(BlockCacheTracerTest, OnlineAnalyzer) {
+  CacheConfiguration config;
+  config.cache_name = "lru";
+  config.num_shard_bits = 0;
+  config.ghost_cache_capacity = 0;
+  // A cache too small to retain both blocks, and one that keeps them.
+  config.cache_capacities = {kBlockSize, 1024 * 1024};
+  std::shared_ptr<BlockCacheOnlineAnalyzer> analyzer(
+      new BlockCacheOnlineAnalyzer(
+          /*warmup_seconds=*/0, /*downsample_ratio=*/1, {config},
+          /*reuse_distance_bucket_bounds=*/{4 * kBlockSize, 1 << 20}));
+  ASSERT_OK(analyzer->InitializeCaches());
+
+  BlockCacheTracer tracer;
+  ASSERT_FALSE(tracer.is_tracing_enabled());
+  ASSERT_OK(tracer.StartOnlineAnalysis(analyzer));
+  ASSERT_TRUE(tracer.is_tracing_enabled());
+  ASSERT_TRUE(tracer.StartOnlineAnalysis(analyzer).IsBusy());
+
+  auto make_record = [&](uint32_t key_id, uint64_t block_size,
+                         uint64_t timestamp) {
+    BlockCacheTraceRecord record;
+    record.block_type = TraceType::kBlockTraceDataBlock;
+    record.block_size = block_size;
+    record.block_key = kBlockKeyPrefix + std::to_string(key_id);
+    record.access_timestamp = timestamp;
+    record.cf_id = kCFId;
+    record.cf_name = kDefaultColumnFamilyName;
+    record.caller = TableReaderCaller::kUserIterator;
+    record.level = kLevel;
+    record.sst_fd_number = kSSTStoringEvenKeys;
+    record.is_cache_hit = Boolean::kFalse;
+    record.no_insert = Boolean::kFalse;
+    return record;
+  };
+
+  // Access block 0, block 1, then block 0 again. The reuse distance of
+  // the re-access is block 1's size.
+  BlockCacheTraceRecord record0 =
+      make_record(/*key_id=*/0, kBlockSize, kMicrosInSecond);
+  BlockCacheTraceRecord record1 =
+      make_record(/*key_id=*/1, 2 * kBlockSize, 2 * kMicrosInSecond);
+  ASSERT_OK(tracer.WriteBlockAccess(record0, record0.block_key,
+                                    record0.cf_name, record0.referenced_key));
+  ASSERT_OK(tracer.WriteBlockAccess(record1, record1.block_key,
+                                    record1.cf_name, record1.referenced_key));
+  record0.access_timestamp = 3 * kMicrosInSecond;
+  ASSERT_OK(tracer.WriteBlockAccess(record0, record0.block_key,
+                                    record0.cf_name, record0.referenced_key));
+  ASSERT_EQ(3, analyzer->num_accesses());
+
+  std::map<uint64_t, uint64_t> reuse_histogram =
+      analyzer->GetReuseDistanceHistogram();
+  // The configured buckets plus the overflow bucket.
+  ASSERT_EQ(3, reuse_histogram.size());
+  ASSERT_EQ(1, reuse_histogram[4 * kBlockSize]);
+  ASSERT_EQ(0, reuse_histogram[1 << 20]);
+
+  std::map<CacheConfiguration, std::vector<double>> curves =
+      analyzer->GetMissRatioCurves();
+  ASSERT_EQ(1, curves.size());
+  const std::vector<double>& miss_ratios = curves.begin()->second;
+  ASSERT_EQ(2, miss_ratios.size());
+  // The small cache cannot serve the re-access, the large cache can.
+  ASSERT_EQ(100.0, miss_ratios[0]);
+  ASSERT_LT(miss_ratios[1], 100.0);
+
+  // Counters reset, but the simulated caches stay warm: re-accessing
+  // block 0 is a hit in the large cache.
+  analyzer->ResetCounters();
+  ASSERT_EQ(0, analyzer->num_accesses());
+  record0.access_timestamp = 4 * kMicrosInSecond;
+  ASSERT_OK(tracer.WriteBlockAccess(record0, record0.block_key,
+                                    record0.cf_name, record0.referenced_key));
+  curves = analyzer->GetMissRatioCurves();
+  ASSERT_EQ(0.0, curves.begin()->second[1]);
+
+  // After detaching, accesses are no longer forwarded.
+  tracer.EndOnlineAnalysis();
+  ASSERT_FALSE(tracer.is_tracing_enabled());
+  ASSERT_OK(tracer.WriteBlockAccess(record0, record0.block_key,
+                                    record0.cf_name, record0.referenced_key));
+  ASSERT_EQ(1, analyzer->num_accesses());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
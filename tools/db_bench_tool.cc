@@ -28,12 +28,15 @@
 #endif
 #include <atomic>
 #include <cinttypes>
+#include <cmath>
 #include <condition_variable>
 #include <cstddef>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 
@@ -433,6 +436,21 @@ DEFINE_bool(enable_numa, false,
             "CPU and memory of same node. Use \"$numactl --hardware\" command "
             "to see NUMA memory architecture.");
 
+DEFINE_bool(numa_pin_multi_db, false,
+            "Requires --enable_numa and --num_multi_db. Pin each DB instance "
+            "to one NUMA node (round-robin) and pin every worker thread to "
+            "the node of the DB it drives, instead of letting each thread "
+            "pick a DB at random per operation. The merged report is "
+            "additionally broken down per node.");
+
+DEFINE_double(open_loop_rate, 0.0,
+              "If > 0, issue operations in an open loop: each thread draws "
+              "Poisson arrivals at this many ops/second and measures latency "
+              "from the operation's scheduled arrival time rather than its "
+              "actual start, so time spent queued behind a stall counts "
+              "against the stalled operations (no coordinated omission). "
+              "Use --histogram to see the resulting latency distribution.");
+
 DEFINE_int64(db_write_buffer_size,
              ROCKSDB_NAMESPACE::Options().db_write_buffer_size,
              "Number of bytes to buffer in all memtables before compacting");
@@ -1488,6 +1506,12 @@ DEFINE_uint64(
 DEFINE_int64(mix_accesses, -1,
              "The total query accesses of mix_graph workload");
 
+DEFINE_string(workload_model_file, "",
+              "The compact workload model exported by trace_analyzer with "
+              "-output_workload_model. The workloadmodel benchmark replays "
+              "its operation mix, key-space hotness buckets, value size "
+              "histogram and arrival rate.");
+
 DEFINE_uint64(
     benchmark_read_rate_limit, 0,
     "If non-zero, db_bench will rate-limit the reads from RocksDB. This "
@@ -2119,6 +2143,10 @@ class Stats {
   uint64_t bytes_;
   uint64_t last_op_finish_;
   uint64_t last_report_finish_;
+  // Open-loop mode (--open_loop_rate): scheduled arrival time of the next
+  // operation and the PRNG drawing the exponential inter-arrival gaps.
+  uint64_t next_arrival_;
+  Random64 arrival_rand_;
   std::unordered_map<OperationType, std::shared_ptr<HistogramImpl>,
                      std::hash<unsigned char>> hist_;
   std::string message_;
@@ -2127,7 +2155,9 @@ class Stats {
   friend class CombinedStats;
 
  public:
-  Stats() : clock_(FLAGS_env->GetSystemClock().get()) { Start(-1); }
+  Stats() : clock_(FLAGS_env->GetSystemClock().get()), arrival_rand_(0) {
+    Start(-1);
+  }
 
   void SetReporterAgent(ReporterAgent* reporter_agent) {
     reporter_agent_ = reporter_agent;
@@ -2143,6 +2173,8 @@ class Stats {
     bytes_ = 0;
     seconds_ = 0;
     start_ = clock_->NowMicros();
+    next_arrival_ = start_;
+    arrival_rand_ = Random64(seed_base + id + 1);
     sine_interval_ = clock_->NowMicros();
     finish_ = start_;
     last_report_finish_ = start_;
@@ -2236,7 +2268,38 @@ class Stats {
     if (reporter_agent_) {
       reporter_agent_->ReportFinishedOps(num_ops);
     }
-    if (FLAGS_histogram) {
+    if (FLAGS_open_loop_rate > 0) {
+      uint64_t now = clock_->NowMicros();
+      // Latency is measured from the operation's scheduled arrival rather
+      // than its actual start, so an operation that was queued behind a
+      // stall is charged for the time it spent waiting.
+      uint64_t micros = now - std::min(next_arrival_, now);
+
+      if (hist_.find(op_type) == hist_.end()) {
+        auto hist_temp = std::make_shared<HistogramImpl>();
+        hist_.insert({op_type, std::move(hist_temp)});
+      }
+      hist_[op_type]->Add(micros);
+
+      if (micros >= FLAGS_slow_usecs && !FLAGS_stats_interval) {
+        fprintf(stderr, "long op: %" PRIu64 " micros%30s\r", micros, "");
+        fflush(stderr);
+      }
+      last_op_finish_ = now;
+
+      // Draw the next arrival(s), and if we are running ahead of the
+      // schedule, wait for the next one.
+      for (int64_t i = 0; i < num_ops; i++) {
+        const double uniform =
+            (static_cast<double>(arrival_rand_.Next() % 1000000) + 1.0) /
+            1000000.0;
+        next_arrival_ += static_cast<uint64_t>(-std::log(uniform) * 1000000.0 /
+                                               FLAGS_open_loop_rate);
+      }
+      if (now < next_arrival_) {
+        FLAGS_env->SleepForMicroseconds(static_cast<int>(next_arrival_ - now));
+      }
+    } else if (FLAGS_histogram) {
       uint64_t now = clock_->NowMicros();
       uint64_t micros = now - last_op_finish_;
 
@@ -2603,6 +2666,9 @@ struct ThreadState {
   Random64 rand;         // Has different seeds for different threads
   Stats stats;
   SharedState* shared;
+  // NUMA node this thread (and the DB instance it drives) is pinned to
+  // when --numa_pin_multi_db is set; -1 otherwise.
+  int numa_node = -1;
 
   explicit ThreadState(int index, int my_seed)
       : tid(index), rand(seed_base + my_seed) {}
@@ -2800,6 +2866,13 @@ class Benchmark {
       }
 #endif
     }
+    if (FLAGS_numa_pin_multi_db &&
+        (!FLAGS_enable_numa || FLAGS_num_multi_db <= 1)) {
+      fprintf(stderr,
+              "--numa_pin_multi_db requires --enable_numa and "
+              "--num_multi_db > 1.\n");
+      exit(1);
+    }
 
     auto compression = CompressionTypeToString(FLAGS_compression_type_e);
     fprintf(stdout, "Compression: %s\n", compression.c_str());
@@ -3456,6 +3529,11 @@ class Benchmark {
         method = &Benchmark::ApproximateSizeRandom;
       } else if (name == "mixgraph") {
         method = &Benchmark::MixGraph;
+      } else if (name == "workloadmodel") {
+        if (!LoadWorkloadModel(FLAGS_workload_model_file)) {
+          ErrorExit();
+        }
+        method = &Benchmark::WorkloadModel;
       } else if (name == "readmissing") {
         ++key_size_;
         method = &Benchmark::ReadRandom;
@@ -3858,12 +3936,20 @@ class Benchmark {
     ThreadArg* arg = new ThreadArg[n];
 
     for (int i = 0; i < n; i++) {
+      int pinned_node = -1;
 #ifdef NUMA
       if (FLAGS_enable_numa) {
         // Performs a local allocation of memory to threads in numa node.
         int n_nodes = numa_num_task_nodes();  // Number of nodes in NUMA.
         numa_exit_on_error = 1;
         int numa_node = i % n_nodes;
+        if (FLAGS_numa_pin_multi_db && FLAGS_num_multi_db > 0) {
+          // Pin the thread to the node of the DB instance it drives (DB
+          // instances are distributed over the nodes round-robin), so each
+          // instance's memtables, block cache contents and worker threads
+          // stay on one socket.
+          numa_node = (i % FLAGS_num_multi_db) % n_nodes;
+        }
         bitmask* nodes = numa_allocate_nodemask();
         numa_bitmask_clearall(nodes);
         numa_bitmask_setbit(nodes, numa_node);
@@ -3873,6 +3959,7 @@ class Benchmark {
         numa_bind(nodes);
         numa_set_strict(1);
         numa_free_nodemask(nodes);
+        pinned_node = numa_node;
       }
 #endif
       arg[i].bm = this;
@@ -3882,6 +3969,7 @@ class Benchmark {
       arg[i].thread = new ThreadState(i, total_thread_count_);
       arg[i].thread->stats.SetReporterAgent(reporter_agent.get());
       arg[i].thread->shared = &shared;
+      arg[i].thread->numa_node = pinned_node;
       FLAGS_env->StartThread(ThreadBody, &arg[i]);
     }
 
@@ -3904,6 +3992,21 @@ class Benchmark {
     }
     merge_stats.Report(name);
 
+    if (FLAGS_numa_pin_multi_db) {
+      // Break the report down per NUMA node, so cross-socket differences
+      // (e.g. one node's instance stalling) are visible.
+      std::map<int, Stats> node_stats;
+      for (int i = 0; i < n; i++) {
+        if (arg[i].thread->numa_node >= 0) {
+          node_stats[arg[i].thread->numa_node].Merge(arg[i].thread->stats);
+        }
+      }
+      for (auto& ns : node_stats) {
+        ns.second.Report(name.ToString() + ".node" +
+                         std::to_string(ns.first));
+      }
+    }
+
     for (int i = 0; i < n; i++) {
       delete arg[i].thread;
     }
@@ -4950,6 +5053,11 @@ class Benchmark {
   }
 
   DBWithColumnFamilies* SelectDBWithCfh(ThreadState* thread) {
+    if (FLAGS_numa_pin_multi_db && !multi_dbs_.empty()) {
+      // Keep each thread on the instance pinned to its NUMA node instead
+      // of spreading its operations across all (and thus all sockets).
+      return &multi_dbs_[thread->tid % multi_dbs_.size()];
+    }
     return SelectDBWithCfh(thread->rand.Next());
   }
 
@@ -5113,7 +5221,12 @@ class Benchmark {
       }
 
       if (write_mode != SEQUENTIAL) {
-        id = thread->rand.Next() % num_key_gens;
+        if (FLAGS_numa_pin_multi_db && num_key_gens > 1) {
+          // Keep this thread's writes on the instance pinned to its node.
+          id = static_cast<size_t>(thread->tid) % num_key_gens;
+        } else {
+          id = thread->rand.Next() % num_key_gens;
+        }
       } else {
         // When doing a sequential load with multiple databases, load them in
         // order rather than all at the same time to avoid:
@@ -6592,6 +6705,226 @@ class Benchmark {
     thread->stats.AddMessage(msg);
   }
 
+  // Parsed form of the model file exported by trace_analyzer with
+  // -output_workload_model. See the workloadmodel benchmark.
+  struct WorkloadModelSpec {
+    // <operation name, access count> in file order
+    std::vector<std::pair<std::string, uint64_t>> op_mix;
+    uint64_t total_ops = 0;
+    // <fraction of key space, fraction of accesses>, hottest bucket first
+    std::vector<std::pair<double, double>> hot_buckets;
+    // <value size upper bound, count> in ascending order
+    std::vector<std::pair<uint64_t, uint64_t>> value_size_buckets;
+    uint64_t total_value_samples = 0;
+    double qps_ave = 0.0;
+  };
+  WorkloadModelSpec workload_model_;
+
+  bool LoadWorkloadModel(const std::string& file_name) {
+    if (file_name.empty()) {
+      fprintf(stderr,
+              "workloadmodel requires --workload_model_file to point to a "
+              "model exported by trace_analyzer -output_workload_model\n");
+      return false;
+    }
+    std::string data;
+    Status s = ReadFileToString(FLAGS_env, file_name, &data);
+    if (!s.ok()) {
+      fprintf(stderr, "Cannot read the workload model file: %s\n",
+              s.ToString().c_str());
+      return false;
+    }
+    workload_model_ = WorkloadModelSpec();
+    std::istringstream input(data);
+    std::string line;
+    while (std::getline(input, line)) {
+      std::istringstream tokens(line);
+      std::string tag;
+      tokens >> tag;
+      if (tag == "op") {
+        std::string op;
+        uint64_t count = 0;
+        tokens >> op >> count;
+        workload_model_.op_mix.emplace_back(op, count);
+        workload_model_.total_ops += count;
+      } else if (tag == "qps_ave") {
+        tokens >> workload_model_.qps_ave;
+      } else if (tag == "hot_bucket") {
+        double key_fraction = 0.0;
+        double access_fraction = 0.0;
+        tokens >> key_fraction >> access_fraction;
+        workload_model_.hot_buckets.emplace_back(key_fraction,
+                                                 access_fraction);
+      } else if (tag == "value_size_bucket") {
+        uint64_t upper_bound = 0;
+        uint64_t count = 0;
+        tokens >> upper_bound >> count;
+        workload_model_.value_size_buckets.emplace_back(upper_bound, count);
+        workload_model_.total_value_samples += count;
+      }
+      // unknown tags are ignored for forward compatibility
+    }
+    if (workload_model_.total_ops == 0) {
+      fprintf(stderr, "The workload model has no operations\n");
+      return false;
+    }
+    return true;
+  }
+
+  // Picks a key index following the hotness buckets of the model: a bucket
+  // is chosen by its access fraction and mapped to a contiguous region of
+  // the key space sized by its key fraction, uniform within the region.
+  int64_t WorkloadModelKey(ThreadState* thread) {
+    if (workload_model_.hot_buckets.empty()) {
+      return thread->rand.Next() % FLAGS_num;
+    }
+    double p = (thread->rand.Next() % 1000000) / 1000000.0;
+    double region_start = 0.0;
+    for (const auto& bucket : workload_model_.hot_buckets) {
+      if (p < bucket.second ||
+          &bucket == &workload_model_.hot_buckets.back()) {
+        int64_t start = static_cast<int64_t>(region_start * FLAGS_num);
+        int64_t len = std::max(static_cast<int64_t>(bucket.first * FLAGS_num),
+                               static_cast<int64_t>(1));
+        return (start + static_cast<int64_t>(thread->rand.Next()) % len) %
+               FLAGS_num;
+      }
+      p -= bucket.second;
+      region_start += bucket.first;
+    }
+    return thread->rand.Next() % FLAGS_num;
+  }
+
+  // Samples a value size from the model histogram, uniform within the
+  // chosen bucket.
+  uint64_t WorkloadModelValueSize(ThreadState* thread) {
+    const uint64_t max_supported = 1048576;  // RandomGenerator buffer size
+    if (workload_model_.total_value_samples == 0) {
+      return value_size;
+    }
+    uint64_t r = thread->rand.Next() % workload_model_.total_value_samples;
+    uint64_t lower_bound = 0;
+    for (const auto& bucket : workload_model_.value_size_buckets) {
+      if (r < bucket.second) {
+        uint64_t width = bucket.first > lower_bound
+                             ? bucket.first - lower_bound
+                             : uint64_t{1};
+        uint64_t size = lower_bound + thread->rand.Next() % width;
+        return std::min(std::max(size, uint64_t{1}), max_supported);
+      }
+      r -= bucket.second;
+      lower_bound = bucket.first;
+    }
+    return std::min(std::max(lower_bound, uint64_t{1}), max_supported);
+  }
+
+  // Synthesizes load from the compact model exported by trace_analyzer
+  // -output_workload_model: operations are drawn from the traced mix, keys
+  // from the traced hotness buckets, value sizes from the traced histogram,
+  // and the aggregate rate is paced at the traced average QPS.
+  void WorkloadModel(ThreadState* thread) {
+    ReadOptions options = read_options_;
+    RandomGenerator gen;
+    std::string value;
+    int64_t reads_done = 0;
+    int64_t writes_done = 0;
+    int64_t deletes_done = 0;
+    int64_t seeks_done = 0;
+    int64_t found = 0;
+    Duration duration(FLAGS_duration, readwrites_);
+
+    std::unique_ptr<const char[]> key_guard;
+    Slice key = AllocateKey(&key_guard);
+
+    double thread_qps = 0.0;
+    if (workload_model_.qps_ave > 0) {
+      thread_qps = workload_model_.qps_ave / FLAGS_threads;
+    }
+    uint64_t ops = 0;
+    const uint64_t start_micros = FLAGS_env->NowMicros();
+
+    while (!duration.Done(1)) {
+      DB* db = SelectDB(thread);
+      if (thread_qps > 0) {
+        uint64_t target_micros =
+            start_micros + static_cast<uint64_t>(ops * 1000000.0 / thread_qps);
+        uint64_t now = FLAGS_env->NowMicros();
+        if (now < target_micros) {
+          FLAGS_env->SleepForMicroseconds(
+              static_cast<int>(target_micros - now));
+        }
+      }
+      ops++;
+      GenerateKeyFromInt(WorkloadModelKey(thread), FLAGS_num, &key);
+
+      uint64_t r = thread->rand.Next() % workload_model_.total_ops;
+      std::string op = "get";
+      for (const auto& mix : workload_model_.op_mix) {
+        if (r < mix.second) {
+          op = mix.first;
+          break;
+        }
+        r -= mix.second;
+      }
+
+      if (op == "put" || op == "merge") {
+        Slice val = gen.Generate(
+            static_cast<unsigned int>(WorkloadModelValueSize(thread)));
+        Status s;
+        if (op == "merge" && !FLAGS_merge_operator.empty()) {
+          s = db->Merge(write_options_, key, val);
+        } else {
+          s = db->Put(write_options_, key, val);
+        }
+        if (!s.ok()) {
+          fprintf(stderr, "put error: %s\n", s.ToString().c_str());
+          ErrorExit();
+        }
+        writes_done++;
+        thread->stats.FinishedOps(nullptr, db, 1, kWrite);
+      } else if (op == "delete" || op == "single_delete" ||
+                 op == "range_delete") {
+        Status s = op == "single_delete"
+                       ? db->SingleDelete(write_options_, key)
+                       : db->Delete(write_options_, key);
+        if (!s.ok()) {
+          fprintf(stderr, "delete error: %s\n", s.ToString().c_str());
+          ErrorExit();
+        }
+        deletes_done++;
+        thread->stats.FinishedOps(nullptr, db, 1, kDelete);
+      } else if (op == "iterator_Seek" || op == "iterator_SeekForPrev") {
+        std::unique_ptr<Iterator> iter(db->NewIterator(options));
+        if (op == "iterator_SeekForPrev") {
+          iter->SeekForPrev(key);
+        } else {
+          iter->Seek(key);
+        }
+        if (iter->Valid()) {
+          found++;
+        }
+        seeks_done++;
+        thread->stats.FinishedOps(nullptr, db, 1, kSeek);
+      } else {
+        // get, multiget and anything a newer model may add
+        Status s = db->Get(options, key, &value);
+        if (!s.ok() && !s.IsNotFound()) {
+          fprintf(stderr, "get error: %s\n", s.ToString().c_str());
+        } else if (!s.IsNotFound()) {
+          found++;
+        }
+        reads_done++;
+        thread->stats.FinishedOps(nullptr, db, 1, kRead);
+      }
+    }
+    char msg[120];
+    snprintf(msg, sizeof(msg),
+             "( reads:%" PRIu64 " writes:%" PRIu64 " deletes:%" PRIu64
+             " seeks:%" PRIu64 " found:%" PRIu64 ")",
+             reads_done, writes_done, deletes_done, seeks_done, found);
+    thread->stats.AddMessage(msg);
+  }
+
   void IteratorCreation(ThreadState* thread) {
     Duration duration(FLAGS_duration, reads_);
     ReadOptions options = read_options_;
@@ -7,6 +7,7 @@
 #ifndef ROCKSDB_LITE
 #include "rocksdb/utilities/ldb_cmd.h"
 
+#include <atomic>
 #include <cinttypes>
 #include <cstdlib>
 #include <ctime>
@@ -25,6 +26,7 @@
 #include "db/version_util.h"
 #include "db/write_batch_internal.h"
 #include "file/filename.h"
+#include "port/port.h"
 #include "rocksdb/cache.h"
 #include "rocksdb/experimental.h"
 #include "rocksdb/file_checksum.h"
@@ -43,6 +45,7 @@
 #include "util/cast_util.h"
 #include "util/coding.h"
 #include "util/file_checksum_helper.h"
+#include "util/mutexlock.h"
 #include "util/stderr_logger.h"
 #include "util/string_util.h"
 #include "utilities/blob_db/blob_dump_tool.h"
@@ -107,6 +110,7 @@ const std::string LDBCommand::ARG_PREPOPULATE_BLOB_CACHE =
 const std::string LDBCommand::ARG_DECODE_BLOB_INDEX = "decode_blob_index";
 const std::string LDBCommand::ARG_DUMP_UNCOMPRESSED_BLOBS =
     "dump_uncompressed_blobs";
+const std::string LDBCommand::ARG_THREADS = "threads";
 
 const char* LDBCommand::DELIM = " ==> ";
 
@@ -1766,10 +1770,11 @@ InternalDumpCommand::InternalDumpCommand(
                  BuildCmdLineOptions(
                      {ARG_HEX, ARG_KEY_HEX, ARG_VALUE_HEX, ARG_FROM, ARG_TO,
                       ARG_MAX_KEYS, ARG_COUNT_ONLY, ARG_COUNT_DELIM, ARG_STATS,
-                      ARG_INPUT_KEY_HEX, ARG_DECODE_BLOB_INDEX})),
+                      ARG_INPUT_KEY_HEX, ARG_DECODE_BLOB_INDEX, ARG_THREADS})),
       has_from_(false),
       has_to_(false),
       max_keys_(-1),
+      num_threads_(1),
       delim_("."),
       count_only_(false),
       count_delim_(false),
@@ -1780,6 +1785,7 @@ InternalDumpCommand::InternalDumpCommand(
   has_to_ = ParseStringOption(options, ARG_TO, &to_);
 
   ParseIntOption(options, ARG_MAX_KEYS, max_keys_, exec_state_);
+  ParseIntOption(options, ARG_THREADS, num_threads_, exec_state_);
   auto itr = options.find(ARG_COUNT_DELIM);
   if (itr != options.end()) {
     delim_ = itr->second;
@@ -1815,9 +1821,93 @@ void InternalDumpCommand::Help(std::string& ret) {
   ret.append(" [--" + ARG_COUNT_DELIM + "=<char>]");
   ret.append(" [--" + ARG_STATS + "]");
   ret.append(" [--" + ARG_DECODE_BLOB_INDEX + "]");
+  ret.append(" [--" + ARG_THREADS + "=<N>]");
   ret.append("\n");
 }
 
+Status InternalDumpCommand::CollectKeyVersionsParallel(
+    std::vector<KeyVersion>* key_versions, bool* done) {
+  *done = false;
+  Slice from_slice(from_);
+  Slice to_slice(to_);
+  std::vector<std::string> boundaries;
+  Status s = db_->GetScanPartitionBoundaries(
+      GetCfHandle(), has_from_ ? &from_slice : nullptr,
+      has_to_ ? &to_slice : nullptr, 4 * static_cast<size_t>(num_threads_),
+      &boundaries);
+  if (s.IsNotSupported() || (s.ok() && boundaries.empty())) {
+    // Nothing to partition on; let the caller take the single-threaded path.
+    return Status::OK();
+  }
+  if (!s.ok()) {
+    return s;
+  }
+
+  // Contiguous partitions [from_, b0], [b0, b1], ..., [b_last, to_], each
+  // read by its own GetAllKeyVersions() call.
+  std::vector<std::pair<std::string, std::string>> ranges;
+  std::string begin = from_;
+  for (const std::string& boundary : boundaries) {
+    ranges.emplace_back(begin, boundary);
+    begin = boundary;
+  }
+  ranges.emplace_back(begin, to_);
+
+  std::vector<std::vector<KeyVersion>> partition_versions(ranges.size());
+  std::atomic<size_t> next_partition(0);
+  port::Mutex error_mutex;
+  Status first_error;
+  auto worker = [&]() {
+    for (size_t i = next_partition.fetch_add(1); i < ranges.size();
+         i = next_partition.fetch_add(1)) {
+      Status ps = GetAllKeyVersions(db_, GetCfHandle(), ranges[i].first,
+                                    ranges[i].second, max_keys_,
+                                    &partition_versions[i]);
+      if (!ps.ok()) {
+        MutexLock l(&error_mutex);
+        if (first_error.ok()) {
+          first_error = ps;
+        }
+        return;
+      }
+    }
+  };
+  size_t num_workers =
+      std::min(static_cast<size_t>(num_threads_), ranges.size());
+  std::vector<port::Thread> threads;
+  threads.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  if (!first_error.ok()) {
+    return first_error;
+  }
+
+  // GetAllKeyVersions() also returns entries whose user key equals the end
+  // key, so every partition except the last drops those entries before
+  // stitching; the next partition starts at the same boundary and reads
+  // them again.
+  for (size_t i = 0; i + 1 < ranges.size(); ++i) {
+    std::vector<KeyVersion>& versions = partition_versions[i];
+    while (!versions.empty() && versions.back().user_key == ranges[i].second) {
+      versions.pop_back();
+    }
+  }
+  for (auto& versions : partition_versions) {
+    key_versions->insert(key_versions->end(),
+                         std::make_move_iterator(versions.begin()),
+                         std::make_move_iterator(versions.end()));
+  }
+  if (max_keys_ >= 0 && key_versions->size() > static_cast<size_t>(max_keys_)) {
+    key_versions->resize(max_keys_);
+  }
+  *done = true;
+  return Status::OK();
+}
+
 void InternalDumpCommand::DoCommand() {
   if (!db_) {
     assert(GetExecuteState().IsFailed());
@@ -1833,11 +1923,22 @@ void InternalDumpCommand::DoCommand() {
 
   // Cast as DBImpl to get internal iterator
   std::vector<KeyVersion> key_versions;
-  Status st = GetAllKeyVersions(db_, GetCfHandle(), from_, to_, max_keys_,
-                                &key_versions);
-  if (!st.ok()) {
-    exec_state_ = LDBCommandExecuteResult::Failed(st.ToString());
-    return;
+  Status st;
+  bool parallel_done = false;
+  if (num_threads_ > 1) {
+    st = CollectKeyVersionsParallel(&key_versions, &parallel_done);
+    if (!st.ok()) {
+      exec_state_ = LDBCommandExecuteResult::Failed(st.ToString());
+      return;
+    }
+  }
+  if (!parallel_done) {
+    st = GetAllKeyVersions(db_, GetCfHandle(), from_, to_, max_keys_,
+                           &key_versions);
+    if (!st.ok()) {
+      exec_state_ = LDBCommandExecuteResult::Failed(st.ToString());
+      return;
+    }
   }
   std::string rtype1, rtype2, row, val;
   rtype2 = "";
@@ -1924,14 +2025,17 @@ DBDumperCommand::DBDumperCommand(
               {ARG_TTL, ARG_HEX, ARG_KEY_HEX, ARG_VALUE_HEX, ARG_FROM, ARG_TO,
                ARG_MAX_KEYS, ARG_COUNT_ONLY, ARG_COUNT_DELIM, ARG_STATS,
                ARG_TTL_START, ARG_TTL_END, ARG_TTL_BUCKET, ARG_TIMESTAMP,
-               ARG_PATH, ARG_DECODE_BLOB_INDEX, ARG_DUMP_UNCOMPRESSED_BLOBS})),
+               ARG_PATH, ARG_DECODE_BLOB_INDEX, ARG_DUMP_UNCOMPRESSED_BLOBS,
+               ARG_THREADS})),
       null_from_(true),
       null_to_(true),
       max_keys_(-1),
       count_only_(false),
       count_delim_(false),
       print_stats_(false),
-      decode_blob_index_(false) {
+      decode_blob_index_(false),
+      num_threads_(1) {
+  ParseIntOption(options, ARG_THREADS, num_threads_, exec_state_);
   auto itr = options.find(ARG_FROM);
   if (itr != options.end()) {
     null_from_ = false;
@@ -2008,6 +2112,7 @@ void DBDumperCommand::Help(std::string& ret) {
   ret.append(" [--" + ARG_PATH + "=<path_to_a_file>]");
   ret.append(" [--" + ARG_DECODE_BLOB_INDEX + "]");
   ret.append(" [--" + ARG_DUMP_UNCOMPRESSED_BLOBS + "]");
+  ret.append(" [--" + ARG_THREADS + "=<N>]");
   ret.append("\n");
 }
 
@@ -2083,17 +2188,37 @@ void DBDumperCommand::DoDumpCommand() {
   // Setup key iterator
   ReadOptions scan_read_opts;
   scan_read_opts.total_order_seek = true;
-  Iterator* iter = db_->NewIterator(scan_read_opts, GetCfHandle());
-  Status st = iter->status();
-  if (!st.ok()) {
-    exec_state_ =
-        LDBCommandExecuteResult::Failed("Iterator error." + st.ToString());
-  }
-
-  if (!null_from_) {
-    iter->Seek(from_);
-  } else {
+  Iterator* iter = nullptr;
+  if (num_threads_ > 1) {
+    if (is_db_ttl_) {
+      exec_state_ = LDBCommandExecuteResult::Failed(
+          "--" + ARG_THREADS + " is not supported with TTL databases");
+      return;
+    }
+    // Scan the range with a pool of threads partitioned along SST
+    // boundaries; the parallel iterator merges the partitions back into
+    // key order, so the output is identical to a single-threaded dump.
+    experimental::ParallelScanOptions parallel_opts;
+    parallel_opts.parallelism = static_cast<size_t>(num_threads_);
+    Slice from_slice(from_);
+    Slice to_slice(to_);
+    iter = experimental::NewParallelIterator(
+        db_, scan_read_opts, GetCfHandle(), null_from_ ? nullptr : &from_slice,
+        null_to_ ? nullptr : &to_slice, parallel_opts);
     iter->SeekToFirst();
+  } else {
+    iter = db_->NewIterator(scan_read_opts, GetCfHandle());
+    Status st = iter->status();
+    if (!st.ok()) {
+      exec_state_ =
+          LDBCommandExecuteResult::Failed("Iterator error." + st.ToString());
+    }
+
+    if (!null_from_) {
+      iter->Seek(from_);
+    } else {
+      iter->SeekToFirst();
+    }
   }
 
   int max_keys = max_keys_;
@@ -3339,11 +3464,15 @@ CheckConsistencyCommand::CheckConsistencyCommand(
     const std::vector<std::string>& /*params*/,
     const std::map<std::string, std::string>& options,
     const std::vector<std::string>& flags)
-    : LDBCommand(options, flags, true, BuildCmdLineOptions({})) {}
+    : LDBCommand(options, flags, true, BuildCmdLineOptions({ARG_THREADS})),
+      num_threads_(1) {
+  ParseIntOption(options, ARG_THREADS, num_threads_, exec_state_);
+}
 
 void CheckConsistencyCommand::Help(std::string& ret) {
   ret.append("  ");
   ret.append(CheckConsistencyCommand::Name());
+  ret.append(" [--" + ARG_THREADS + "=<N>]");
   ret.append("\n");
 }
 
@@ -3351,6 +3480,28 @@ void CheckConsistencyCommand::DoCommand() {
   options_.paranoid_checks = true;
   options_.num_levels = 64;
   OpenDB();
+  if (num_threads_ > 1 && db_ != nullptr &&
+      (exec_state_.IsSucceed() || exec_state_.IsNotStarted())) {
+    // Read back every key with checksum verification, scanning partitions
+    // of the key space in parallel.
+    ReadOptions verify_read_opts;
+    verify_read_opts.total_order_seek = true;
+    verify_read_opts.verify_checksums = true;
+    experimental::ParallelScanOptions parallel_opts;
+    parallel_opts.parallelism = static_cast<size_t>(num_threads_);
+    std::unique_ptr<Iterator> iter(experimental::NewParallelIterator(
+        db_, verify_read_opts, GetCfHandle(), nullptr, nullptr,
+        parallel_opts));
+    uint64_t count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++count;
+    }
+    if (!iter->status().ok()) {
+      exec_state_ = LDBCommandExecuteResult::Failed(
+          "Scan failed after " + std::to_string(count) +
+          " keys: " + iter->status().ToString());
+    }
+  }
   if (exec_state_.IsSucceed() || exec_state_.IsNotStarted()) {
     fprintf(stdout, "OK\n");
   }
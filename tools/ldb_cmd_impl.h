@@ -12,6 +12,8 @@
 #include <utility>
 #include <vector>
 
+#include "rocksdb/utilities/debug.h"
+
 namespace ROCKSDB_NAMESPACE {
 
 class CompactorCommand : public LDBCommand {
@@ -110,6 +112,7 @@ class DBDumperCommand : public LDBCommand {
   std::string path_;
   bool decode_blob_index_;
   bool dump_uncompressed_blobs_;
+  int num_threads_;
 
   static const std::string ARG_COUNT_ONLY;
   static const std::string ARG_COUNT_DELIM;
@@ -130,11 +133,19 @@ class InternalDumpCommand : public LDBCommand {
   void DoCommand() override;
 
  private:
+  // Collects key versions using multiple threads, one partition of the key
+  // range per worker. Sets *done to false (and returns OK) when the DB does
+  // not support partitioning, in which case the caller should fall back to
+  // the single-threaded path.
+  Status CollectKeyVersionsParallel(std::vector<KeyVersion>* key_versions,
+                                    bool* done);
+
   bool has_from_;
   std::string from_;
   bool has_to_;
   std::string to_;
   int max_keys_;
+  int num_threads_;
   std::string delim_;
   bool count_only_;
   bool count_delim_;
@@ -566,6 +577,9 @@ class CheckConsistencyCommand : public LDBCommand {
   bool NoDBOpen() override { return true; }
 
   static void Help(std::string& ret);
+
+ private:
+  int num_threads_;
 };
 
 class CheckPointCommand : public LDBCommand {
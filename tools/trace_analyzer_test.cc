@@ -871,6 +871,62 @@ TEST_F(TraceAnalyzerTest, MultiGet) {
   */
 }
 
+TEST_F(TraceAnalyzerTest, StreamingSketches) {
+  CountMinSketch cms(4, 1 << 10);
+  for (int i = 0; i < 100; i++) {
+    cms.Add("hot_key");
+  }
+  cms.Add("cold_key");
+  ASSERT_EQ(101u, cms.total_count());
+  ASSERT_GE(cms.Estimate("hot_key"), 100u);
+  ASSERT_LE(cms.Estimate("hot_key"), 100u + cms.MaxOverCount());
+  ASSERT_GE(cms.Estimate("cold_key"), 1u);
+
+  HyperLogLog hll(14);
+  for (int i = 0; i < 10000; i++) {
+    hll.Add(std::to_string(i));
+  }
+  uint64_t cardinality = hll.EstimateCardinality();
+  ASSERT_GT(cardinality, 9500u);
+  ASSERT_LT(cardinality, 10500u);
+
+  ReservoirSample sample(100);
+  for (uint64_t v = 1; v <= 1000; v++) {
+    sample.Add(v);
+  }
+  ASSERT_EQ(1000u, sample.num_observed());
+  ASSERT_EQ(100u, sample.sample_size());
+  uint64_t p50 = sample.Percentile(50.0);
+  ASSERT_GT(p50, 250u);
+  ASSERT_LT(p50, 750u);
+  ASSERT_LE(sample.Percentile(50.0), sample.Percentile(99.0));
+}
+
+// Run the analyzer in the one-pass streaming mode. Kept last because the
+// -streaming flag sticks for the rest of the process.
+TEST_F(TraceAnalyzerTest, Streaming) {
+  std::string trace_path = test_path_ + "/trace";
+  std::string output_path = test_path_ + "/streaming";
+  std::vector<std::string> paras = {
+      "-analyze_get=true",          "-analyze_put=true",
+      "-analyze_delete=true",       "-analyze_single_delete=true",
+      "-analyze_range_delete=true", "-analyze_iterator=true",
+      "-analyze_multiget=true",     "-streaming=true"};
+  paras.push_back("-output_dir=" + output_path);
+  paras.push_back("-trace_path=" + trace_path);
+  AnalyzeTrace(paras, output_path, trace_path);
+
+  // The per-key output files are disabled in streaming mode even though
+  // AnalyzeTrace() requests them.
+  ASSERT_TRUE(
+      env_->FileExists(output_path + "/test-get-0-accessed_key_stats.txt")
+          .IsNotFound());
+
+  // The human readable trace conversion does not need per-key state and
+  // still runs.
+  ASSERT_OK(env_->FileExists(output_path + "/test-human_readable_trace.txt"));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -13,6 +13,7 @@
 #ifndef OS_WIN
 #include <unistd.h>
 #endif
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
 #include <cstdio>
@@ -44,6 +45,7 @@
 #include "util/coding.h"
 #include "util/compression.h"
 #include "util/gflags_compat.h"
+#include "util/hash.h"
 #include "util/random.h"
 #include "util/string_util.h"
 
@@ -165,6 +167,33 @@ DEFINE_int32(value_interval, 8,
 DEFINE_double(sample_ratio, 1.0,
               "If the trace size is extremely huge or user want to sample "
               "the trace when analyzing, sample ratio can be set (0, 1.0]");
+DEFINE_bool(streaming, false,
+            "Analyze the trace in one pass using fixed-memory sketches "
+            "instead of the per-key maps, so traces of any size fit in a "
+            "constant memory budget. Distinct keys are counted with "
+            "HyperLogLog, per-key access frequencies with a count-min "
+            "sketch, and key/value size distributions with reservoir "
+            "samples. Outputs that need exact per-key state (key stats "
+            "files, prefix cut, access count distribution, key "
+            "distribution, correlations, time series, and the whole key "
+            "space analysis) are disabled, and the printed estimates "
+            "include their accuracy bounds.");
+DEFINE_int32(streaming_cms_width_bits, 20,
+             "Log2 of the count-min sketch width used by -streaming. Each "
+             "enabled query type and column family allocates 4 * 2^bits "
+             "8-byte counters.");
+DEFINE_int32(streaming_reservoir_size, 10000,
+             "The number of entries kept by each reservoir sample used by "
+             "-streaming.");
+DEFINE_bool(output_workload_model, false,
+            "Export a compact workload model (operation mix, key-space "
+            "hotness buckets, value size histogram, and arrival rate) to "
+            "<output_prefix>-workload_model.txt in the output directory. "
+            "db_bench consumes the file with -benchmarks=workloadmodel "
+            "-workload_model_file=<path> to synthesize a statistically "
+            "similar load without shipping the raw trace. Not supported "
+            "together with -streaming because the hotness buckets need the "
+            "exact per-key access counts.");
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -196,8 +225,112 @@ uint64_t MultiplyCheckOverflow(uint64_t op1, uint64_t op2) {
   return (op1 * op2);
 }
 
+// Sizing of the streaming sketches that is not worth a command line flag.
+const size_t kStreamingCmsDepth = 4;
+const uint8_t kStreamingHllPrecision = 14;  // 16KB of registers
+
 }  // namespace
 
+CountMinSketch::CountMinSketch(size_t depth, size_t width)
+    : depth_(depth),
+      width_(width),
+      total_count_(0),
+      counters_(depth * width, 0) {}
+
+void CountMinSketch::Add(const Slice& key) {
+  total_count_++;
+  for (size_t row = 0; row < depth_; row++) {
+    uint64_t h = GetSliceNPHash64(key, row);
+    counters_[row * width_ + (h % width_)]++;
+  }
+}
+
+uint64_t CountMinSketch::Estimate(const Slice& key) const {
+  uint64_t estimate = std::numeric_limits<uint64_t>::max();
+  for (size_t row = 0; row < depth_; row++) {
+    uint64_t h = GetSliceNPHash64(key, row);
+    estimate = std::min(estimate, counters_[row * width_ + (h % width_)]);
+  }
+  return estimate;
+}
+
+uint64_t CountMinSketch::MaxOverCount() const {
+  // Each row over-counts by total_count_ / width_ in expectation, so by
+  // Markov's inequality a single row exceeds twice that with probability
+  // less than 1/2 and the minimum over depth_ rows with (1/2)^depth_.
+  return 2 * total_count_ / width_;
+}
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+    : precision_(precision), registers_(size_t{1} << precision, 0) {}
+
+void HyperLogLog::Add(const Slice& key) {
+  uint64_t h = GetSliceNPHash64(key);
+  size_t index = static_cast<size_t>(h >> (64 - precision_));
+  uint64_t rest = h << precision_;
+  // The rank is the position of the leftmost 1-bit in the remaining bits.
+  uint8_t rank = 1;
+  while (rest != 0 && (rest & (uint64_t{1} << 63)) == 0) {
+    rank++;
+    rest <<= 1;
+  }
+  if (rest == 0) {
+    rank = static_cast<uint8_t>(64 - precision_ + 1);
+  }
+  registers_[index] = std::max(registers_[index], rank);
+}
+
+uint64_t HyperLogLog::EstimateCardinality() const {
+  const double m = static_cast<double>(registers_.size());
+  double inverse_sum = 0.0;
+  size_t zero_registers = 0;
+  for (uint8_t reg : registers_) {
+    inverse_sum += std::ldexp(1.0, -reg);
+    if (reg == 0) {
+      zero_registers++;
+    }
+  }
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double estimate = alpha * m * m / inverse_sum;
+  if (estimate <= 2.5 * m && zero_registers > 0) {
+    // Small-range correction: fall back to linear counting.
+    estimate = m * std::log(m / zero_registers);
+  }
+  return static_cast<uint64_t>(estimate);
+}
+
+double HyperLogLog::RelativeError() const {
+  return 1.04 / std::sqrt(static_cast<double>(registers_.size()));
+}
+
+ReservoirSample::ReservoirSample(size_t capacity)
+    : capacity_(capacity), num_observed_(0), rand_(0xdeadbeef) {
+  sample_.reserve(capacity);
+}
+
+void ReservoirSample::Add(uint64_t value) {
+  num_observed_++;
+  if (sample_.size() < capacity_) {
+    sample_.push_back(value);
+  } else {
+    uint64_t pos = rand_.Uniform(num_observed_);
+    if (pos < capacity_) {
+      sample_[static_cast<size_t>(pos)] = value;
+    }
+  }
+}
+
+uint64_t ReservoirSample::Percentile(double percentile) const {
+  if (sample_.empty()) {
+    return 0;
+  }
+  std::vector<uint64_t> sorted(sample_);
+  std::sort(sorted.begin(), sorted.end());
+  size_t index =
+      static_cast<size_t>((percentile / 100.0) * (sorted.size() - 1));
+  return sorted[index];
+}
+
 // The default constructor of AnalyzerOptions
 AnalyzerOptions::AnalyzerOptions()
     : correlation_map(kTaTypeNum, std::vector<int>(kTaTypeNum, -1)) {}
@@ -254,6 +387,7 @@ TraceStats::TraceStats() {
   cf_id = 0;
   cf_name = "0";
   a_count = 0;
+  a_succ_count = 0;
   a_key_id = 0;
   a_key_size_sqsum = 0;
   a_key_size_sum = 0;
@@ -643,9 +777,148 @@ Status TraceAnalyzer::MakeStatistics() {
     }
   }
 
+  // Export the compact workload model for db_bench
+  if (FLAGS_output_workload_model) {
+    s = WriteWorkloadModel();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
   return Status::OK();
 }
 
+// Export a compact model of the analyzed workload that the db_bench
+// workloadmodel benchmark can replay: the operation mix, the key-space
+// hotness buckets, the value size histogram of the write queries, and the
+// arrival rate.
+Status TraceAnalyzer::WriteWorkloadModel() {
+  if (FLAGS_streaming) {
+    return Status::NotSupported(
+        "-output_workload_model needs the exact per-key access counts and "
+        "cannot be combined with -streaming");
+  }
+  std::unique_ptr<ROCKSDB_NAMESPACE::WritableFile> model_f;
+  std::string file_path =
+      output_path_ + "/" + FLAGS_output_prefix + "-workload_model.txt";
+  Status s = env_->NewWritableFile(file_path, &model_f, env_options_);
+  if (!s.ok()) {
+    fprintf(stderr, "Cannot open workload model file: %s\n",
+            file_path.c_str());
+    return s;
+  }
+  int ret;
+  auto append_line = [&](const std::string& line) {
+    return model_f->Append(line);
+  };
+  s = append_line("rocksdb_workload_model 1\n");
+  if (!s.ok()) {
+    return s;
+  }
+
+  // The operation mix
+  for (int type = 0; type < kTaTypeNum; type++) {
+    if (!ta_[type].enabled) {
+      continue;
+    }
+    uint64_t access = 0;
+    for (auto& stat : ta_[type].stats) {
+      access += stat.second.a_count;
+    }
+    if (access == 0) {
+      continue;
+    }
+    ret = snprintf(buffer_, sizeof(buffer_), "op %s %" PRIu64 "\n",
+                   ta_[type].type_name.c_str(), access);
+    if (ret < 0) {
+      return Status::IOError("Format the output failed");
+    }
+    s = append_line(std::string(buffer_));
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  // The arrival pattern. The QPS vectors are only filled when
+  // -output_qps_stats collected them.
+  if (qps_ave_.size() == static_cast<size_t>(kTaTypeNum + 1)) {
+    ret = snprintf(buffer_, sizeof(buffer_), "qps_ave %f\nqps_peak %u\n",
+                   qps_ave_[kTaTypeNum], qps_peak_[kTaTypeNum]);
+    if (ret < 0) {
+      return Status::IOError("Format the output failed");
+    }
+    s = append_line(std::string(buffer_));
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  // The key-space hotness: sort the per-key access counts over all types
+  // and column families and cut them into ten buckets of equal key count,
+  // hottest first. Each line carries the fraction of the key space and the
+  // fraction of all accesses that the bucket received.
+  std::vector<uint64_t> access_counts;
+  uint64_t total_accesses = 0;
+  for (int type = 0; type < kTaTypeNum; type++) {
+    for (auto& stat : ta_[type].stats) {
+      for (auto& record : stat.second.a_key_stats) {
+        access_counts.push_back(record.second.access_count);
+        total_accesses += record.second.access_count;
+      }
+    }
+  }
+  if (!access_counts.empty() && total_accesses > 0) {
+    std::sort(access_counts.begin(), access_counts.end(),
+              std::greater<uint64_t>());
+    const size_t num_buckets = std::min<size_t>(10, access_counts.size());
+    size_t index = 0;
+    for (size_t bucket = 0; bucket < num_buckets; bucket++) {
+      size_t end = (bucket + 1) * access_counts.size() / num_buckets;
+      uint64_t bucket_accesses = 0;
+      size_t bucket_keys = 0;
+      for (; index < end; index++) {
+        bucket_accesses += access_counts[index];
+        bucket_keys++;
+      }
+      ret = snprintf(buffer_, sizeof(buffer_), "hot_bucket %f %f\n",
+                     (static_cast<double>(bucket_keys)) / access_counts.size(),
+                     (static_cast<double>(bucket_accesses)) / total_accesses);
+      if (ret < 0) {
+        return Status::IOError("Format the output failed");
+      }
+      s = append_line(std::string(buffer_));
+      if (!s.ok()) {
+        return s;
+      }
+    }
+  }
+
+  // The value size histogram of the write queries
+  std::map<uint64_t, uint64_t> value_dist;
+  for (int type : {static_cast<int>(TraceOperationType::kPut),
+                   static_cast<int>(TraceOperationType::kMerge)}) {
+    for (auto& stat : ta_[type].stats) {
+      for (auto& record : stat.second.a_value_size_stats) {
+        value_dist[record.first] += record.second;
+      }
+    }
+  }
+  for (auto& record : value_dist) {
+    ret = snprintf(buffer_, sizeof(buffer_),
+                   "value_size_bucket %" PRIu64 " %" PRIu64 "\n",
+                   (record.first + 1) * FLAGS_value_interval, record.second);
+    if (ret < 0) {
+      return Status::IOError("Format the output failed");
+    }
+    s = append_line(std::string(buffer_));
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  return model_f->Close();
+}
+
 // Process the statistics of the key access and
 // prefix of the accessed keys if required
 Status TraceAnalyzer::MakeStatisticKeyStatsOrPrefix(TraceStats& stats) {
@@ -1223,7 +1496,18 @@ Status TraceAnalyzer::KeyStatsInsertion(const uint32_t& type,
     if (!FLAGS_print_correlation.empty()) {
       s = StatsUnitCorrelationUpdate(unit, type, ts, key);
     }
-    ta_[type].stats[cf_id].a_key_stats[key] = unit;
+    if (FLAGS_streaming) {
+      TraceStats& stats = ta_[type].stats[cf_id];
+      stats.a_key_cms.reset(new CountMinSketch(
+          kStreamingCmsDepth, size_t{1} << FLAGS_streaming_cms_width_bits));
+      stats.a_key_hll.reset(new HyperLogLog(kStreamingHllPrecision));
+      stats.a_key_size_reservoir.reset(
+          new ReservoirSample(FLAGS_streaming_reservoir_size));
+      stats.a_value_size_reservoir.reset(
+          new ReservoirSample(FLAGS_streaming_reservoir_size));
+    } else {
+      ta_[type].stats[cf_id].a_key_stats[key] = unit;
+    }
     ta_[type].stats[cf_id].a_value_size_stats[dist_value_size] = 1;
     ta_[type].stats[cf_id].a_qps_stats[time_in_sec] = 1;
     ta_[type].stats[cf_id].correlation_output.resize(
@@ -1235,7 +1519,10 @@ Status TraceAnalyzer::KeyStatsInsertion(const uint32_t& type,
     }
     if (time_in_sec != cur_time_sec_) {
       ta_[type].stats[cf_id].uni_key_num[cur_time_sec_] =
-          static_cast<uint64_t>(ta_[type].stats[cf_id].a_key_stats.size());
+          FLAGS_streaming
+              ? ta_[type].stats[cf_id].a_key_hll->EstimateCardinality()
+              : static_cast<uint64_t>(
+                    ta_[type].stats[cf_id].a_key_stats.size());
       cur_time_sec_ = time_in_sec;
     }
   } else {
@@ -1246,21 +1533,25 @@ Status TraceAnalyzer::KeyStatsInsertion(const uint32_t& type,
     found_stats->second.a_value_size_sqsum += MultiplyCheckOverflow(
         static_cast<uint64_t>(value_size), static_cast<uint64_t>(value_size));
     found_stats->second.a_value_size_sum += value_size;
-    auto found_key = found_stats->second.a_key_stats.find(key);
-    if (found_key == found_stats->second.a_key_stats.end()) {
-      found_stats->second.a_key_stats[key] = unit;
-    } else {
-      found_key->second.access_count++;
-      if (type != TraceOperationType::kGet || value_size > 0) {
-        found_key->second.succ_count++;
-      }
-      if (!FLAGS_print_correlation.empty()) {
-        s = StatsUnitCorrelationUpdate(found_key->second, type, ts, key);
+    if (!FLAGS_streaming) {
+      auto found_key = found_stats->second.a_key_stats.find(key);
+      if (found_key == found_stats->second.a_key_stats.end()) {
+        found_stats->second.a_key_stats[key] = unit;
+      } else {
+        found_key->second.access_count++;
+        if (type != TraceOperationType::kGet || value_size > 0) {
+          found_key->second.succ_count++;
+        }
+        if (!FLAGS_print_correlation.empty()) {
+          s = StatsUnitCorrelationUpdate(found_key->second, type, ts, key);
+        }
       }
     }
     if (time_in_sec != cur_time_sec_) {
       found_stats->second.uni_key_num[cur_time_sec_] =
-          static_cast<uint64_t>(found_stats->second.a_key_stats.size());
+          FLAGS_streaming
+              ? found_stats->second.a_key_hll->EstimateCardinality()
+              : static_cast<uint64_t>(found_stats->second.a_key_stats.size());
       cur_time_sec_ = time_in_sec;
     }
 
@@ -1295,6 +1586,16 @@ Status TraceAnalyzer::KeyStatsInsertion(const uint32_t& type,
     }
   }
 
+  if (FLAGS_streaming) {
+    TraceStats& stats = ta_[type].stats[cf_id];
+    Slice key_slice(key);
+    stats.a_key_cms->Add(key_slice);
+    stats.a_key_hll->Add(key_slice);
+    stats.a_key_size_reservoir->Add(static_cast<uint64_t>(key.size()));
+    stats.a_value_size_reservoir->Add(static_cast<uint64_t>(value_size));
+    stats.a_succ_count += unit.succ_count;
+  }
+
   if (cfs_.find(cf_id) == cfs_.end()) {
     CfUnit cf_unit;
     cf_unit.cf_id = cf_id;
@@ -1696,7 +1997,14 @@ void TraceAnalyzer::PrintStatistics() {
         continue;
       }
       TraceStats& stat = stat_it.second;
-      uint64_t total_a_keys = static_cast<uint64_t>(stat.a_key_stats.size());
+      uint64_t total_a_keys;
+      if (FLAGS_streaming && stat.a_key_hll) {
+        total_a_keys = stat.a_key_hll->EstimateCardinality();
+        stat.a_key_mid = stat.a_key_size_reservoir->Percentile(50.0);
+        stat.a_value_mid = stat.a_value_size_reservoir->Percentile(50.0);
+      } else {
+        total_a_keys = static_cast<uint64_t>(stat.a_key_stats.size());
+      }
       double key_size_ave = 0.0;
       double value_size_ave = 0.0;
       double key_size_vari = 0.0;
@@ -1736,8 +2044,36 @@ void TraceAnalyzer::PrintStatistics() {
       printf("Peak QPS is: %u Average QPS is: %f\n", stat.a_peak_qps,
              stat.a_ave_qps);
 
+      // print the accuracy bounds of the sketch based estimates
+      if (FLAGS_streaming && stat.a_key_hll) {
+        printf("Streaming estimate accuracy bounds:\n");
+        printf("  Unique key count: +/- %.2f%% (standard error)\n",
+               stat.a_key_hll->RelativeError() * 100);
+        printf("  Per-key access counts over-counted by at most %" PRIu64
+               " with probability %.2f%%\n",
+               stat.a_key_cms->MaxOverCount(),
+               (1.0 - std::pow(0.5, static_cast<double>(kStreamingCmsDepth))) *
+                   100);
+        printf("  Key size p50/p95/p99: %" PRIu64 "/%" PRIu64 "/%" PRIu64
+               " from a %zu-entry sample of %" PRIu64 " observations\n",
+               stat.a_key_size_reservoir->Percentile(50.0),
+               stat.a_key_size_reservoir->Percentile(95.0),
+               stat.a_key_size_reservoir->Percentile(99.0),
+               stat.a_key_size_reservoir->sample_size(),
+               stat.a_key_size_reservoir->num_observed());
+        if (type == kPut || type == kMerge) {
+          printf("  Value size p50/p95/p99: %" PRIu64 "/%" PRIu64 "/%" PRIu64
+                 " from a %zu-entry sample of %" PRIu64 " observations\n",
+                 stat.a_value_size_reservoir->Percentile(50.0),
+                 stat.a_value_size_reservoir->Percentile(95.0),
+                 stat.a_value_size_reservoir->Percentile(99.0),
+                 stat.a_value_size_reservoir->sample_size(),
+                 stat.a_value_size_reservoir->num_observed());
+        }
+      }
+
       // print the top k accessed key and its access count
-      if (FLAGS_print_top_k_access > 0) {
+      if (FLAGS_print_top_k_access > 0 && !FLAGS_streaming) {
         printf("The Top %d keys that are accessed:\n",
                FLAGS_print_top_k_access);
         while (!stat.top_k_queue.empty()) {
@@ -1867,6 +2203,18 @@ int trace_analyzer_tool(int argc, char** argv) {
 
   ParseCommandLineFlags(&argc, &argv, true);
 
+  if (FLAGS_streaming) {
+    // The sketches replace the per-key state, so outputs that need exact
+    // per-key bookkeeping cannot be produced in this mode.
+    FLAGS_output_key_stats = false;
+    FLAGS_output_access_count_stats = false;
+    FLAGS_output_key_distribution = false;
+    FLAGS_output_time_series = false;
+    FLAGS_output_prefix_cut = 0;
+    FLAGS_print_correlation = "";
+    FLAGS_key_space_dir = "";
+  }
+
   if (!FLAGS_print_correlation.empty()) {
     analyzer_opts.SparseCorrelationInput(FLAGS_print_correlation);
   }
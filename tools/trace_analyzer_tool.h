@@ -8,6 +8,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <utility>
@@ -18,6 +19,7 @@
 #include "rocksdb/trace_record.h"
 #include "rocksdb/write_batch.h"
 #include "trace_replay/trace_replay.h"
+#include "util/random.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -61,6 +63,72 @@ struct StatsUnit {
   std::vector<TypeCorrelation> v_correlation;
 };
 
+// The following three sketches back the -streaming mode. They replace the
+// per-key maps so that a trace of any size can be analyzed in a single pass
+// within a constant memory budget, trading exact answers for estimates with
+// known accuracy bounds (see the accessors below).
+
+// Estimates per-key access frequencies with depth * width counters.
+class CountMinSketch {
+ public:
+  CountMinSketch(size_t depth, size_t width);
+
+  void Add(const Slice& key);
+
+  // Never under-estimates the true count.
+  uint64_t Estimate(const Slice& key) const;
+
+  uint64_t total_count() const { return total_count_; }
+
+  // An estimate exceeds the true count by at most this many accesses with
+  // probability at least 1 - (1/2)^depth.
+  uint64_t MaxOverCount() const;
+
+ private:
+  size_t depth_;
+  size_t width_;
+  uint64_t total_count_;
+  std::vector<uint64_t> counters_;  // depth_ rows of width_ counters each
+};
+
+// Estimates the number of distinct keys with 2^precision 1-byte registers.
+class HyperLogLog {
+ public:
+  explicit HyperLogLog(uint8_t precision);
+
+  void Add(const Slice& key);
+
+  uint64_t EstimateCardinality() const;
+
+  // Standard error of the estimate: 1.04 / sqrt(2^precision).
+  double RelativeError() const;
+
+ private:
+  uint8_t precision_;
+  std::vector<uint8_t> registers_;
+};
+
+// Keeps a uniform random sample of a stream of values so percentiles of
+// the full distribution can be approximated from the sample.
+class ReservoirSample {
+ public:
+  explicit ReservoirSample(size_t capacity);
+
+  void Add(uint64_t value);
+
+  // Returns the given percentile (0.0 to 100.0) over the sampled values.
+  uint64_t Percentile(double percentile) const;
+
+  uint64_t num_observed() const { return num_observed_; }
+  size_t sample_size() const { return sample_.size(); }
+
+ private:
+  size_t capacity_;
+  uint64_t num_observed_;
+  Random64 rand_;
+  std::vector<uint64_t> sample_;
+};
+
 class AnalyzerOptions {
  public:
   std::vector<std::vector<int>> correlation_map;
@@ -120,6 +188,13 @@ struct TraceStats {
   std::vector<std::pair<uint64_t, uint64_t>> correlation_output;
   std::map<uint32_t, uint64_t> uni_key_num;
 
+  // Fixed-memory sketches that take the place of a_key_stats when the
+  // -streaming mode is enabled.
+  std::unique_ptr<CountMinSketch> a_key_cms;
+  std::unique_ptr<HyperLogLog> a_key_hll;
+  std::unique_ptr<ReservoirSample> a_key_size_reservoir;
+  std::unique_ptr<ReservoirSample> a_value_size_reservoir;
+
   std::unique_ptr<ROCKSDB_NAMESPACE::WritableFile> time_series_f;
   std::unique_ptr<ROCKSDB_NAMESPACE::WritableFile> a_key_f;
   std::unique_ptr<ROCKSDB_NAMESPACE::WritableFile> a_count_dist_f;
@@ -314,6 +389,7 @@ class TraceAnalyzer : private TraceRecord::Handler,
                             const Slice& key, const size_t value_size,
                             const uint64_t ts);
   Status MakeStatisticKeyStatsOrPrefix(TraceStats& stats);
+  Status WriteWorkloadModel();
   Status MakeStatisticCorrelation(TraceStats& stats, StatsUnit& unit);
   Status MakeStatisticQPS();
   int db_version_;
@@ -64,13 +64,16 @@ int main() {
 #include <thread>
 
 #include "file/filename.h"
+#include "monitoring/histogram.h"
 #include "port/port.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/listener.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/system_clock.h"
 #include "util/gflags_compat.h"
+#include "util/mutexlock.h"
 
 using GFLAGS_NAMESPACE::ParseCommandLineFlags;
 using GFLAGS_NAMESPACE::RegisterFlagValidator;
@@ -105,10 +108,59 @@ DEFINE_bool(low_open_files_mode, false,
             "If true, we set max_open_files to 20, so that every file access "
             "needs to reopen it");
 
+DEFINE_int32(read_threads, 0,
+             "Number of reader threads issuing point lookups and range scans "
+             "while the writers run. Setting this above zero also starts the "
+             "SLO reporter, which prints a per-interval time series of "
+             "read/write latency percentiles aligned with compaction debt "
+             "and flush/compaction events");
+DEFINE_double(range_read_ratio, 0.1,
+              "Fraction of reads that are short range scans instead of point "
+              "lookups");
+DEFINE_int32(range_read_len, 100,
+             "Number of entries each range scan iterates over");
+DEFINE_int32(slo_report_interval_sec, 1,
+             "How often the SLO reporter emits a time series line");
+DEFINE_string(slo_report_file, "",
+              "Where to write the SLO time series. Empty means stdout");
+
 namespace ROCKSDB_NAMESPACE {
 
 static const int kPrefixSize = 3;
 
+#ifndef ROCKSDB_LITE
+// Counts flush, compaction and stall events so that the SLO reporter can
+// align its latency time series with background activity.
+class StallEventListener : public EventListener {
+ public:
+  const char* Name() const override { return "StallEventListener"; }
+
+  void OnFlushCompleted(DB* /*db*/, const FlushJobInfo& /*info*/) override {
+    flushes_completed_++;
+  }
+
+  void OnCompactionCompleted(DB* /*db*/,
+                             const CompactionJobInfo& /*info*/) override {
+    compactions_completed_++;
+  }
+
+  void OnStallConditionsChanged(const WriteStallInfo& info) override {
+    if (info.condition.cur != WriteStallCondition::kNormal) {
+      stall_changes_++;
+    }
+  }
+
+  uint64_t flushes_completed() { return flushes_completed_.load(); }
+  uint64_t compactions_completed() { return compactions_completed_.load(); }
+  uint64_t stall_changes() { return stall_changes_.load(); }
+
+ private:
+  std::atomic<uint64_t> flushes_completed_{0};
+  std::atomic<uint64_t> compactions_completed_{0};
+  std::atomic<uint64_t> stall_changes_{0};
+};
+#endif  // !ROCKSDB_LITE
+
 class WriteStress {
  public:
   WriteStress() : stop_(false) {
@@ -144,6 +196,13 @@ class WriteStress {
       options.delete_obsolete_files_period_micros = 0;
     }
 
+#ifndef ROCKSDB_LITE
+    if (FLAGS_read_threads > 0) {
+      stall_listener_ = std::make_shared<StallEventListener>();
+      options.listeners.push_back(stall_listener_);
+    }
+#endif  // !ROCKSDB_LITE
+
     // open DB
     DB* db;
     Status s = DB::Open(options, FLAGS_db, &db);
@@ -177,13 +236,132 @@ class WriteStress {
       auto value = random_string(rng, FLAGS_value_size);
       WriteOptions woptions;
       woptions.sync = dist(rng) < FLAGS_sync_probability;
+      uint64_t start_micros = SystemClock::Default()->NowMicros();
       auto s = db_->Put(woptions, key, value);
       if (!s.ok()) {
         fprintf(stderr, "Write to DB failed: %s\n", s.ToString().c_str());
         std::abort();
       }
+      if (FLAGS_read_threads > 0) {
+        uint64_t micros = SystemClock::Default()->NowMicros() - start_micros;
+        MutexLock l(&latency_mutex_);
+        write_latency_us_.Add(micros);
+      }
+    }
+  }
+
+#ifndef ROCKSDB_LITE
+  void ReadThread(int id) {
+    std::mt19937 rng(static_cast<unsigned int>(FLAGS_seed + 100 + id));
+    std::uniform_real_distribution<double> dist(0, 1);
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    while (!stop_.load(std::memory_order_relaxed)) {
+      // Read under the current key prefix, so a share of the point lookups
+      // finds recently written keys.
+      std::string key;
+      key.resize(kPrefixSize);
+      for (int i = 0; i < kPrefixSize; ++i) {
+        key[i] = key_prefix_[i].load(std::memory_order_relaxed);
+      }
+      for (int i = kPrefixSize; i < FLAGS_key_size; ++i) {
+        key += static_cast<char>(char_dist(rng));
+      }
+      uint64_t start_micros = SystemClock::Default()->NowMicros();
+      if (dist(rng) < FLAGS_range_read_ratio) {
+        std::unique_ptr<Iterator> iterator(db_->NewIterator(ReadOptions()));
+        int num_entries = 0;
+        for (iterator->Seek(key);
+             iterator->Valid() && num_entries < FLAGS_range_read_len;
+             iterator->Next()) {
+          ++num_entries;
+        }
+        if (!iterator->status().ok()) {
+          fprintf(stderr, "Iterator status not OK: %s\n",
+                  iterator->status().ToString().c_str());
+          std::abort();
+        }
+      } else {
+        std::string value;
+        Status s = db_->Get(ReadOptions(), key, &value);
+        if (!s.ok() && !s.IsNotFound()) {
+          fprintf(stderr, "Read from DB failed: %s\n", s.ToString().c_str());
+          std::abort();
+        }
+      }
+      uint64_t micros = SystemClock::Default()->NowMicros() - start_micros;
+      MutexLock l(&latency_mutex_);
+      read_latency_us_.Add(micros);
+    }
+  }
+
+  void SLOReporterThread() {
+    FILE* out = stdout;
+    if (!FLAGS_slo_report_file.empty()) {
+      out = fopen(FLAGS_slo_report_file.c_str(), "w");
+      if (out == nullptr) {
+        fprintf(stderr, "Can't open SLO report file: %s\n",
+                FLAGS_slo_report_file.c_str());
+        std::abort();
+      }
+    }
+    fprintf(out,
+            "sec read_p50_us read_p99_us write_p50_us write_p99_us "
+            "pending_compaction_bytes running_flushes running_compactions "
+            "flushes compactions stall_changes delayed_write_rate "
+            "write_stopped\n");
+    uint64_t start_micros = SystemClock::Default()->NowMicros();
+    uint64_t last_flushes = 0;
+    uint64_t last_compactions = 0;
+    uint64_t last_stalls = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+      SystemClock::Default()->SleepForMicroseconds(
+          FLAGS_slo_report_interval_sec * 1000 * 1000LL);
+      double read_p50, read_p99, write_p50, write_p99;
+      {
+        MutexLock l(&latency_mutex_);
+        read_p50 = read_latency_us_.Percentile(50.0);
+        read_p99 = read_latency_us_.Percentile(99.0);
+        write_p50 = write_latency_us_.Percentile(50.0);
+        write_p99 = write_latency_us_.Percentile(99.0);
+        read_latency_us_.Clear();
+        write_latency_us_.Clear();
+      }
+      uint64_t pending_bytes = 0;
+      uint64_t running_flushes = 0;
+      uint64_t running_compactions = 0;
+      uint64_t delayed_rate = 0;
+      uint64_t write_stopped = 0;
+      db_->GetIntProperty(DB::Properties::kEstimatePendingCompactionBytes,
+                          &pending_bytes);
+      db_->GetIntProperty(DB::Properties::kNumRunningFlushes,
+                          &running_flushes);
+      db_->GetIntProperty(DB::Properties::kNumRunningCompactions,
+                          &running_compactions);
+      db_->GetIntProperty(DB::Properties::kActualDelayedWriteRate,
+                          &delayed_rate);
+      db_->GetIntProperty(DB::Properties::kIsWriteStopped, &write_stopped);
+      uint64_t flushes = stall_listener_->flushes_completed();
+      uint64_t compactions = stall_listener_->compactions_completed();
+      uint64_t stalls = stall_listener_->stall_changes();
+      fprintf(out,
+              "%" PRIu64 " %.0f %.0f %.0f %.0f %" PRIu64 " %" PRIu64
+              " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64
+              " %" PRIu64 "\n",
+              (SystemClock::Default()->NowMicros() - start_micros) / 1000000,
+              read_p50, read_p99, write_p50, write_p99, pending_bytes,
+              running_flushes, running_compactions, flushes - last_flushes,
+              compactions - last_compactions, stalls - last_stalls,
+              delayed_rate, write_stopped);
+      fflush(out);
+      last_flushes = flushes;
+      last_compactions = compactions;
+      last_stalls = stalls;
+    }
+    if (out != stdout) {
+      fclose(out);
     }
   }
+#endif  // !ROCKSDB_LITE
 
   void IteratorHoldThread() {
     while (!stop_.load(std::memory_order_relaxed)) {
@@ -223,6 +401,18 @@ class WriteStress {
     threads_.emplace_back([&]() { WriteThread(); });
     threads_.emplace_back([&]() { PrefixMutatorThread(); });
     threads_.emplace_back([&]() { IteratorHoldThread(); });
+#ifndef ROCKSDB_LITE
+    for (int i = 0; i < FLAGS_read_threads; ++i) {
+      threads_.emplace_back([&, i]() { ReadThread(i); });
+    }
+    if (FLAGS_read_threads > 0) {
+      threads_.emplace_back([&]() { SLOReporterThread(); });
+    }
+#else
+    if (FLAGS_read_threads > 0) {
+      fprintf(stderr, "read_threads is not supported in ROCKSDB_LITE\n");
+    }
+#endif  // !ROCKSDB_LITE
 
     if (FLAGS_runtime_sec == -1) {
       // infinite runtime, until we get killed
@@ -291,6 +481,12 @@ class WriteStress {
   std::atomic<bool> stop_;
   std::vector<port::Thread> threads_;
   std::unique_ptr<DB> db_;
+#ifndef ROCKSDB_LITE
+  std::shared_ptr<StallEventListener> stall_listener_;
+#endif  // !ROCKSDB_LITE
+  port::Mutex latency_mutex_;
+  HistogramImpl read_latency_us_;
+  HistogramImpl write_latency_us_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
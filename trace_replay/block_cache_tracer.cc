@@ -440,7 +440,10 @@ Status BlockCacheHumanReadableTraceReader::ReadAccess(
   return Status::OK();
 }
 
-BlockCacheTracer::BlockCacheTracer() { writer_.store(nullptr); }
+BlockCacheTracer::BlockCacheTracer() {
+  writer_.store(nullptr);
+  online_listener_.store(nullptr);
+}
 
 BlockCacheTracer::~BlockCacheTracer() { EndTrace(); }
 
@@ -467,10 +470,43 @@ void BlockCacheTracer::EndTrace() {
   writer_.store(nullptr);
 }
 
+Status BlockCacheTracer::StartOnlineAnalysis(
+    const std::shared_ptr<BlockCacheTraceListener>& listener) {
+  if (listener == nullptr) {
+    return Status::InvalidArgument("Listener must not be null.");
+  }
+  InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
+  if (online_listener_.load()) {
+    return Status::Busy();
+  }
+  online_listener_owner_ = listener;
+  online_listener_.store(listener.get());
+  return Status::OK();
+}
+
+void BlockCacheTracer::EndOnlineAnalysis() {
+  InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
+  // Keep online_listener_owner_ so that WriteBlockAccess() calls that
+  // already loaded the listener pointer stay on a valid object.
+  online_listener_.store(nullptr);
+}
+
 Status BlockCacheTracer::WriteBlockAccess(const BlockCacheTraceRecord& record,
                                           const Slice& block_key,
                                           const Slice& cf_name,
                                           const Slice& referenced_key) {
+  BlockCacheTraceListener* listener =
+      online_listener_.load(std::memory_order_relaxed);
+  if (listener != nullptr) {
+    // The record's string fields are passed alongside it as slices; fill
+    // them in so the listener sees a complete record. Sampling is left to
+    // the listener, which may downsample differently than the trace file.
+    BlockCacheTraceRecord full_record = record;
+    full_record.block_key = block_key.ToString();
+    full_record.cf_name = cf_name.ToString();
+    full_record.referenced_key = referenced_key.ToString();
+    listener->OnBlockCacheAccess(full_record);
+  }
   if (!writer_.load() || !ShouldTrace(block_key, trace_options_)) {
     return Status::OK();
   }
@@ -483,7 +519,7 @@ Status BlockCacheTracer::WriteBlockAccess(const BlockCacheTraceRecord& record,
 }
 
 uint64_t BlockCacheTracer::NextGetId() {
-  if (!writer_.load(std::memory_order_relaxed)) {
+  if (!is_tracing_enabled()) {
     return BlockCacheTraceHelper::kReservedGetId;
   }
   uint64_t prev_value = get_id_counter_.fetch_add(1);
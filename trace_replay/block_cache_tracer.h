@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <fstream>
+#include <memory>
 
 #include "monitoring/instrumented_mutex.h"
 #include "rocksdb/options.h"
@@ -256,6 +257,18 @@ class BlockCacheHumanReadableTraceReader : public BlockCacheTraceReader {
 // A block cache tracer. It downsamples the accesses according to
 // trace_options and uses BlockCacheTraceWriter to write the access record to
 // the trace file.
+// An in-process consumer of block cache access records, so that a live
+// host can be analyzed online without writing a trace file (see
+// BlockCacheOnlineAnalyzer in tools/block_cache_analyzer).
+// OnBlockCacheAccess() is called from many threads concurrently and
+// implementations must synchronize internally.
+class BlockCacheTraceListener {
+ public:
+  virtual ~BlockCacheTraceListener() = default;
+
+  virtual void OnBlockCacheAccess(const BlockCacheTraceRecord& record) = 0;
+};
+
 class BlockCacheTracer {
  public:
   BlockCacheTracer();
@@ -273,8 +286,21 @@ class BlockCacheTracer {
   // Stop writing block cache accesses to the trace_writer.
   void EndTrace();
 
+  // Start forwarding block cache accesses to the listener, in addition to
+  // any file-backed trace. Returns Status::Busy() if a listener is
+  // already attached.
+  Status StartOnlineAnalysis(
+      const std::shared_ptr<BlockCacheTraceListener>& listener);
+
+  // Stop forwarding block cache accesses to the listener. The listener is
+  // kept alive (so straggler WriteBlockAccess() calls that observed it as
+  // attached stay on a valid object) until the tracer is destroyed or a
+  // new listener is attached.
+  void EndOnlineAnalysis();
+
   bool is_tracing_enabled() const {
-    return writer_.load(std::memory_order_relaxed);
+    return writer_.load(std::memory_order_relaxed) ||
+           online_listener_.load(std::memory_order_relaxed);
   }
 
   Status WriteBlockAccess(const BlockCacheTraceRecord& record,
@@ -290,6 +316,11 @@ class BlockCacheTracer {
   InstrumentedMutex trace_writer_mutex_;
   std::atomic<BlockCacheTraceWriter*> writer_;
   std::atomic<uint64_t> get_id_counter_;
+  // Owns the listener; modified only under trace_writer_mutex_.
+  std::shared_ptr<BlockCacheTraceListener> online_listener_owner_;
+  // Equals online_listener_owner_.get() while online analysis is active
+  // and nullptr otherwise; read lock-free by WriteBlockAccess().
+  std::atomic<BlockCacheTraceListener*> online_listener_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
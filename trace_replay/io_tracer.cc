@@ -5,9 +5,11 @@
 
 #include "trace_replay/io_tracer.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
@@ -19,6 +21,91 @@
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
+namespace {
+// Copy `src` into the fixed-size buffer `dst`, truncating if needed and
+// always NUL-terminating.
+template <size_t N>
+void CopyTruncated(const std::string& src, char (&dst)[N]) {
+  const size_t len = std::min(src.size(), N - 1);
+  memcpy(dst, src.data(), len);
+  dst[len] = '\0';
+}
+}  // namespace
+
+IOFlightRecorder::IOFlightRecorder(size_t records_per_core)
+    : records_per_core_(records_per_core) {
+  assert(records_per_core_ > 0);
+  for (size_t i = 0; i < rings_.Size(); ++i) {
+    rings_.AccessAtCore(i)->slots.reset(new Slot[records_per_core_]);
+  }
+}
+
+void IOFlightRecorder::Record(const IOTraceRecord& record) {
+  Ring* ring = rings_.Access();
+  const uint64_t ticket = ring->next.fetch_add(1, std::memory_order_relaxed);
+  Slot* slot = &ring->slots[ticket % records_per_core_];
+
+  // Seqlock-style slot protocol: the odd value marks the slot as being
+  // overwritten so that a concurrent Dump() skips it instead of copying a
+  // half-written record. Two threads racing for the same slot would require
+  // the ring to wrap around during a single write and is not worth guarding
+  // against; at worst one record of the ring is lost or stale.
+  slot->seq.store(2 * ticket + 1, std::memory_order_release);
+
+  IOFlightRecord& dst = slot->record;
+  dst.access_timestamp = record.access_timestamp;
+  dst.trace_type = record.trace_type;
+  dst.io_op_data = record.io_op_data;
+  dst.latency = record.latency;
+  dst.len = record.len;
+  dst.offset = record.offset;
+  dst.file_size = record.file_size;
+  CopyTruncated(record.file_operation, dst.file_operation);
+  CopyTruncated(record.io_status, dst.io_status);
+  CopyTruncated(record.file_name, dst.file_name);
+
+  slot->seq.store(2 * ticket + 2, std::memory_order_release);
+}
+
+void IOFlightRecorder::Dump(std::vector<IOFlightRecord>* records) const {
+  assert(records != nullptr);
+  records->clear();
+  for (size_t i = 0; i < rings_.Size(); ++i) {
+    Ring* ring = rings_.AccessAtCore(i);
+    for (size_t pos = 0; pos < records_per_core_; ++pos) {
+      const Slot* slot = &ring->slots[pos];
+      const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+      if (seq == 0 || (seq & 1) != 0) {
+        // Never written, or currently being written.
+        continue;
+      }
+      IOFlightRecord copy = slot->record;
+      // Keep the copy above from being reordered past the sequence
+      // re-check below.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot->seq.load(std::memory_order_relaxed) != seq) {
+        // Overwritten while we were copying it.
+        continue;
+      }
+      records->push_back(copy);
+    }
+  }
+  std::sort(records->begin(), records->end(),
+            [](const IOFlightRecord& a, const IOFlightRecord& b) {
+              return a.access_timestamp < b.access_timestamp;
+            });
+}
+
+void IOFlightRecorder::Clear() {
+  for (size_t i = 0; i < rings_.Size(); ++i) {
+    Ring* ring = rings_.AccessAtCore(i);
+    ring->next.store(0, std::memory_order_relaxed);
+    for (size_t pos = 0; pos < records_per_core_; ++pos) {
+      ring->slots[pos].seq.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
 IOTraceWriter::IOTraceWriter(SystemClock* clock,
                              const TraceOptions& trace_options,
                              std::unique_ptr<TraceWriter>&& trace_writer)
@@ -262,7 +349,10 @@ Status IOTraceReader::ReadIOOp(IOTraceRecord* record) {
   return Status::OK();
 }
 
-IOTracer::IOTracer() : tracing_enabled(false) { writer_.store(nullptr); }
+IOTracer::IOTracer() : tracing_enabled(false) {
+  writer_.store(nullptr);
+  active_flight_recorder_.store(nullptr);
+}
 
 IOTracer::~IOTracer() { EndIOTrace(); }
 
@@ -287,10 +377,52 @@ void IOTracer::EndIOTrace() {
   }
   delete writer_.load();
   writer_.store(nullptr);
-  tracing_enabled = false;
+  tracing_enabled = (active_flight_recorder_.load() != nullptr);
+}
+
+Status IOTracer::StartFlightRecorder(size_t records_per_core) {
+  InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
+  if (records_per_core == 0) {
+    return Status::InvalidArgument("records_per_core must be non-zero.");
+  }
+  if (active_flight_recorder_.load()) {
+    return Status::Busy();
+  }
+  if (flight_recorder_ &&
+      flight_recorder_->records_per_core() == records_per_core) {
+    // Recycle the existing buffers; straggler WriteIOOp() calls that still
+    // reference the old recorder then keep operating on valid memory.
+    flight_recorder_->Clear();
+  } else {
+    flight_recorder_.reset(new IOFlightRecorder(records_per_core));
+  }
+  active_flight_recorder_.store(flight_recorder_.get());
+  tracing_enabled = true;
+  return Status::OK();
+}
+
+void IOTracer::EndFlightRecorder() {
+  InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
+  // Only stop recording; the buffers are kept so the records leading up to
+  // an incident can still be dumped, and freed with the tracer.
+  active_flight_recorder_.store(nullptr);
+  tracing_enabled = (writer_.load() != nullptr);
+}
+
+Status IOTracer::DumpFlightRecorder(std::vector<IOFlightRecord>* records) {
+  InstrumentedMutexLock lock_guard(&trace_writer_mutex_);
+  if (!flight_recorder_) {
+    return Status::NotFound("The IO flight recorder was never started.");
+  }
+  flight_recorder_->Dump(records);
+  return Status::OK();
 }
 
 void IOTracer::WriteIOOp(const IOTraceRecord& record, IODebugContext* dbg) {
+  IOFlightRecorder* flight_recorder = active_flight_recorder_.load();
+  if (flight_recorder) {
+    flight_recorder->Record(record);
+  }
   if (!writer_.load()) {
     return;
   }
@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <fstream>
+#include <vector>
 
 #include "monitoring/instrumented_mutex.h"
 #include "port/lang.h"
@@ -14,6 +15,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/trace_record.h"
 #include "trace_replay/trace_replay.h"
+#include "util/core_local.h"
 
 namespace ROCKSDB_NAMESPACE {
 class SystemClock;
@@ -91,6 +93,75 @@ struct IOTraceRecord {
         offset(_offset) {}
 };
 
+// A fixed-size binary snapshot of an IOTraceRecord, suitable for storing in
+// the flight recorder's preallocated ring buffers. The variable-length
+// strings of IOTraceRecord are truncated to fit.
+struct IOFlightRecord {
+  uint64_t access_timestamp = 0;
+  TraceType trace_type = TraceType::kTraceMax;
+  uint64_t io_op_data = 0;
+  uint64_t latency = 0;
+  uint64_t len = 0;
+  uint64_t offset = 0;
+  uint64_t file_size = 0;
+  // NUL-terminated, possibly truncated copies of the corresponding
+  // IOTraceRecord strings.
+  char file_operation[24] = {0};
+  char io_status[24] = {0};
+  char file_name[48] = {0};
+};
+
+// IOFlightRecorder keeps the most recent IO operations in preallocated
+// core-local ring buffers of fixed-size records. Record() is lock-free
+// (one relaxed fetch_add plus a bounded memcpy-sized copy), so unlike a
+// file-backed trace it is cheap enough to leave enabled on production
+// hosts permanently and dump after an incident.
+class IOFlightRecorder {
+ public:
+  explicit IOFlightRecorder(size_t records_per_core);
+  ~IOFlightRecorder() = default;
+  // No copy and move.
+  IOFlightRecorder(const IOFlightRecorder&) = delete;
+  IOFlightRecorder& operator=(const IOFlightRecorder&) = delete;
+  IOFlightRecorder(IOFlightRecorder&&) = delete;
+  IOFlightRecorder& operator=(IOFlightRecorder&&) = delete;
+
+  size_t records_per_core() const { return records_per_core_; }
+
+  // Store `record` in the ring buffer of the calling thread's core,
+  // overwriting the oldest record there. Lock-free; safe to call
+  // concurrently with Dump().
+  void Record(const IOTraceRecord& record);
+
+  // Copy the currently buffered records into `records`, oldest first.
+  // Records that are concurrently being overwritten are skipped rather
+  // than returned half-written.
+  void Dump(std::vector<IOFlightRecord>* records) const;
+
+  // Discard all buffered records. Only meant to be called while no thread
+  // is concurrently calling Record(); records written during a Clear() may
+  // or may not survive it.
+  void Clear();
+
+ private:
+  struct Slot {
+    // Seqlock-style generation counter: 0 means never written, an odd
+    // value means a writer is currently filling the slot in, and Dump()
+    // re-checks it after copying to detect a concurrent overwrite.
+    std::atomic<uint64_t> seq{0};
+    IOFlightRecord record;
+  };
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) Ring {
+    // Next ticket; slot index is ticket % records_per_core_.
+    std::atomic<uint64_t> next{0};
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  const size_t records_per_core_;
+  CoreLocalArray<Ring> rings_;
+};
+
 struct IOTraceHeader {
   uint64_t start_time;
   uint32_t rocksdb_major_version;
@@ -171,6 +242,26 @@ class IOTracer {
 
   void WriteIOOp(const IOTraceRecord& record, IODebugContext* dbg);
 
+  // Start the flight-recorder mode: in addition to any file-backed trace,
+  // WriteIOOp() copies every record into core-local ring buffers holding
+  // the most recent `records_per_core` operations each (see
+  // IOFlightRecorder). Returns Status::Busy() if the flight recorder is
+  // already running. Restarting after EndFlightRecorder() discards the
+  // previously buffered records.
+  TSAN_SUPPRESSION Status StartFlightRecorder(size_t records_per_core);
+
+  // Stop recording into the flight recorder. The buffers are kept (so that
+  // the records leading up to an incident can still be dumped, and so that
+  // straggler WriteIOOp() calls that observed the recorder as active stay
+  // on valid memory); they are freed when the tracer is destroyed or
+  // recycled when the recorder is restarted.
+  TSAN_SUPPRESSION void EndFlightRecorder();
+
+  // Copy the currently buffered flight records into `records`, oldest
+  // first. May be called while recording is active. Returns
+  // Status::NotFound() if the flight recorder was never started.
+  Status DumpFlightRecorder(std::vector<IOFlightRecord>* records);
+
  private:
   TraceOptions trace_options_;
   // A mutex protects the writer_.
@@ -180,6 +271,11 @@ class IOTracer {
   // variable 'writer_' is nullptr or not in is_tracing_enabled().
   // is_tracing_enabled() is invoked multiple times by FileSystem classes.
   bool tracing_enabled;
+  // Owns the flight recorder; modified only under trace_writer_mutex_.
+  std::unique_ptr<IOFlightRecorder> flight_recorder_;
+  // Equals flight_recorder_.get() while flight recording is active and
+  // nullptr otherwise; read lock-free by WriteIOOp().
+  std::atomic<IOFlightRecorder*> active_flight_recorder_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -344,6 +344,81 @@ TEST_F(IOTracerTest, AtomicMultipleWrites) {
     ASSERT_NOK(reader.ReadIOOp(&record));
   }
 }
+TEST_F(IOTracerTest, FlightRecorder) {
+  // The fixture unconditionally removes the trace file; this test does not
+  // write one, so create it empty.
+  ASSERT_OK(WriteStringToFile(env_, "", trace_file_path_));
+
+  IOTracer tracer;
+  std::vector<IOFlightRecord> records;
+  // Dumping before the recorder was ever started reports NotFound.
+  ASSERT_TRUE(tracer.DumpFlightRecorder(&records).IsNotFound());
+
+  ASSERT_TRUE(tracer.StartFlightRecorder(0).IsInvalidArgument());
+  ASSERT_OK(tracer.StartFlightRecorder(16 /* records_per_core */));
+  ASSERT_TRUE(tracer.is_tracing_enabled());
+  ASSERT_TRUE(tracer.StartFlightRecorder(16).IsBusy());
+
+  for (uint64_t i = 0; i < 10; i++) {
+    uint64_t io_op_data = 0;
+    io_op_data |= (1 << IOTraceOp::kIOLen);
+    io_op_data |= (1 << IOTraceOp::kIOOffset);
+    IOTraceRecord record(i /*access_timestamp*/, TraceType::kIOTracer,
+                         io_op_data, GetFileOperation(i), i /*latency*/,
+                         IOStatus::OK().ToString(),
+                         kDummyFile + std::to_string(i), i /*len*/,
+                         i + 20 /*offset*/);
+    tracer.WriteIOOp(record, nullptr);
+  }
+
+  ASSERT_OK(tracer.DumpFlightRecorder(&records));
+  ASSERT_EQ(records.size(), 10u);
+  // Records are returned oldest first.
+  for (uint64_t i = 0; i < records.size(); i++) {
+    ASSERT_EQ(records[i].access_timestamp, i);
+    ASSERT_EQ(records[i].trace_type, TraceType::kIOTracer);
+    ASSERT_EQ(records[i].latency, i);
+    ASSERT_EQ(records[i].len, i);
+    ASSERT_EQ(records[i].offset, i + 20);
+    ASSERT_EQ(std::string(records[i].file_operation), GetFileOperation(i));
+    ASSERT_EQ(std::string(records[i].io_status), IOStatus::OK().ToString());
+    ASSERT_EQ(std::string(records[i].file_name),
+              kDummyFile + std::to_string(i));
+  }
+
+  // Overlong strings are truncated, not dropped.
+  {
+    IOTraceRecord record(100 /*access_timestamp*/, TraceType::kIOTracer,
+                         0 /*io_op_data*/, GetFileOperation(0), 0 /*latency*/,
+                         IOStatus::OK().ToString(),
+                         std::string(1000, 'x') /*file_name*/);
+    tracer.WriteIOOp(record, nullptr);
+    ASSERT_OK(tracer.DumpFlightRecorder(&records));
+    ASSERT_EQ(records.size(), 11u);
+    const std::string file_name(records.back().file_name);
+    ASSERT_EQ(file_name, std::string(file_name.size(), 'x'));
+    ASSERT_LT(file_name.size(), 1000u);
+  }
+
+  // The records survive stopping the recorder, but no new ones are added.
+  tracer.EndFlightRecorder();
+  ASSERT_FALSE(tracer.is_tracing_enabled());
+  {
+    IOTraceRecord record(200 /*access_timestamp*/, TraceType::kIOTracer,
+                         0 /*io_op_data*/, GetFileOperation(0), 0 /*latency*/,
+                         IOStatus::OK().ToString(), kDummyFile);
+    tracer.WriteIOOp(record, nullptr);
+  }
+  ASSERT_OK(tracer.DumpFlightRecorder(&records));
+  ASSERT_EQ(records.size(), 11u);
+
+  // Restarting discards the previously buffered records.
+  ASSERT_OK(tracer.StartFlightRecorder(16));
+  ASSERT_OK(tracer.DumpFlightRecorder(&records));
+  ASSERT_TRUE(records.empty());
+  tracer.EndFlightRecorder();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
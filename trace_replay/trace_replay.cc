@@ -369,7 +369,9 @@ Status Tracer::Write(WriteBatch* write_batch) {
 
 Status Tracer::Get(ColumnFamilyHandle* column_family, const Slice& key) {
   TraceType trace_type = kTraceGet;
-  if (ShouldSkipTrace(trace_type)) {
+  // Key scoping happens before sampling, so out-of-scope operations do not
+  // consume sampling slots.
+  if (!IsKeyInTraceRange(key) || ShouldSkipTrace(trace_type)) {
     return Status::OK();
   }
   Trace trace;
@@ -389,7 +391,7 @@ Status Tracer::Get(ColumnFamilyHandle* column_family, const Slice& key) {
 Status Tracer::IteratorSeek(const uint32_t& cf_id, const Slice& key,
                             const Slice& lower_bound, const Slice upper_bound) {
   TraceType trace_type = kTraceIteratorSeek;
-  if (ShouldSkipTrace(trace_type)) {
+  if (!IsKeyInTraceRange(key) || ShouldSkipTrace(trace_type)) {
     return Status::OK();
   }
   Trace trace;
@@ -425,7 +427,7 @@ Status Tracer::IteratorSeekForPrev(const uint32_t& cf_id, const Slice& key,
                                    const Slice& lower_bound,
                                    const Slice upper_bound) {
   TraceType trace_type = kTraceIteratorSeekForPrev;
-  if (ShouldSkipTrace(trace_type)) {
+  if (!IsKeyInTraceRange(key) || ShouldSkipTrace(trace_type)) {
     return Status::OK();
   }
   Trace trace;
@@ -496,7 +498,15 @@ Status Tracer::MultiGet(const std::vector<ColumnFamilyHandle*>& column_families,
     return Status::Corruption("the CFs size and keys size does not match!");
   }
   TraceType trace_type = kTraceMultiGet;
-  if (ShouldSkipTrace(trace_type)) {
+  // A MultiGet is in scope if any of its keys is.
+  bool any_key_in_range = false;
+  for (const Slice& key : keys) {
+    if (IsKeyInTraceRange(key)) {
+      any_key_in_range = true;
+      break;
+    }
+  }
+  if (!any_key_in_range || ShouldSkipTrace(trace_type)) {
     return Status::OK();
   }
   uint32_t multiget_size = static_cast<uint32_t>(keys.size());
@@ -572,6 +582,22 @@ bool Tracer::ShouldSkipTrace(const TraceType& trace_type) {
     return true;
   }
 
+  if (filter_mask != kTraceFilterNone) {
+    auto it = trace_options_.type_sampling_frequency.find(filter_mask);
+    if (it != trace_options_.type_sampling_frequency.end()) {
+      // This type is sampled on its own counter, independently of the
+      // other operations, so its rate does not depend on how often the
+      // rest of the workload runs.
+      uint64_t& count = type_request_count_[trace_type];
+      ++count;
+      if (count < it->second) {
+        return true;
+      }
+      count = 0;
+      return false;
+    }
+  }
+
   ++trace_request_count_;
   if (trace_request_count_ < trace_options_.sampling_frequency) {
     return true;
@@ -580,6 +606,18 @@ bool Tracer::ShouldSkipTrace(const TraceType& trace_type) {
   return false;
 }
 
+bool Tracer::IsKeyInTraceRange(const Slice& key) const {
+  if (!trace_options_.trace_key_lower_bound.empty() &&
+      key.compare(Slice(trace_options_.trace_key_lower_bound)) < 0) {
+    return false;
+  }
+  if (!trace_options_.trace_key_upper_bound.empty() &&
+      key.compare(Slice(trace_options_.trace_key_upper_bound)) >= 0) {
+    return false;
+  }
+  return true;
+}
+
 bool Tracer::IsTraceFileOverMax() {
   uint64_t trace_file_size = trace_writer_->GetFileSize();
   return (trace_file_size > trace_options_.max_trace_file_size);
@@ -174,10 +174,18 @@ class Tracer {
   // Returns true if a trace should be skipped, false otherwise.
   bool ShouldSkipTrace(const TraceType& type);
 
+  // Returns true if the key falls in the configured
+  // [trace_key_lower_bound, trace_key_upper_bound) scope (bytewise). An
+  // empty bound is unlimited on that side.
+  bool IsKeyInTraceRange(const Slice& key) const;
+
   SystemClock* clock_;
   TraceOptions trace_options_;
   std::unique_ptr<TraceWriter> trace_writer_;
   uint64_t trace_request_count_;
+  // Separate request counters for the types listed in
+  // type_sampling_frequency, so each such type is sampled independently.
+  uint64_t type_request_count_[kTraceMax] = {};
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -53,9 +53,20 @@ void AsyncFileReader::Wait() {
     StopWatch sw(SystemClock::Default().get(), stats_, POLL_WAIT_MICROS);
     fs_->Poll(io_handles, io_handles.size()).PermitUncheckedError();
   }
-  do {
-    waiter = head_;
-    head_ = waiter->next_;
+  // Detach the completed awaiters before resuming any of them. With the
+  // standard coroutine backend, resume() runs the awaiting coroutine
+  // inline and it may issue new reads; those must start a fresh queue
+  // rather than be mistaken for completed ones.
+  waiter = head_;
+  ReadAwaiter* const last = tail_;
+  head_ = tail_ = nullptr;
+  RecordInHistogram(stats_, MULTIGET_IO_BATCH_SIZE, num_reqs_);
+  num_reqs_ = 0;
+  for (;;) {
+    // The awaiter lives in the suspended coroutine's frame, which may be
+    // freed by resume(), so read the links before resuming
+    ReadAwaiter* next = waiter->next_;
+    bool is_last = (waiter == last);
 
     for (size_t i = 0; i < waiter->num_reqs_; ++i) {
       if (waiter->io_handle_[i] && waiter->del_fn_[i]) {
@@ -63,10 +74,11 @@ void AsyncFileReader::Wait() {
       }
     }
     waiter->awaiting_coro_.resume();
-  } while (waiter != tail_);
-  head_ = tail_ = nullptr;
-  RecordInHistogram(stats_, MULTIGET_IO_BATCH_SIZE, num_reqs_);
-  num_reqs_ = 0;
+    if (is_last) {
+      break;
+    }
+    waiter = next;
+  }
 }
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // USE_COROUTINES
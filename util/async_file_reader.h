@@ -7,7 +7,11 @@
 
 #if USE_COROUTINES
 #include "file/random_access_file_reader.h"
+#if defined(USE_STD_COROUTINES)
+#include <coroutine>
+#else
 #include "folly/experimental/coro/ViaIfAsync.h"
+#endif
 #include "port/port.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/statistics.h"
@@ -17,6 +21,12 @@
 namespace ROCKSDB_NAMESPACE {
 class SingleThreadExecutor;
 
+#if defined(USE_STD_COROUTINES)
+using CoroutineHandle = std::coroutine_handle<>;
+#else
+using CoroutineHandle = folly::coro::impl::coroutine_handle<>;
+#endif
+
 // AsyncFileReader implements the Awaitable concept, which allows calling
 // coroutines to co_await it. When the AsyncFileReader Awaitable is
 // resumed, it initiates the fie reads requested by the awaiting caller
@@ -62,8 +72,7 @@ class AsyncFileReader {
     // A return value of true means suspend the awaiter (calling coroutine). The
     // awaiting_coro parameter is the handle of the awaiter. The handle can be
     // resumed later, so we cache it here.
-    bool await_suspend(
-        folly::coro::impl::coroutine_handle<> awaiting_coro) noexcept {
+    bool await_suspend(CoroutineHandle awaiting_coro) noexcept {
       awaiting_coro_ = awaiting_coro;
       // MultiReadAsyncImpl always returns true, so caller will be suspended
       return reader_.MultiReadAsyncImpl(this);
@@ -84,7 +93,7 @@ class AsyncFileReader {
     size_t num_reqs_;
     autovector<void*, 32> io_handle_;
     autovector<IOHandleDeleter, 32> del_fn_;
-    folly::coro::impl::coroutine_handle<> awaiting_coro_;
+    CoroutineHandle awaiting_coro_;
     // Use this to link to the next ReadAwaiter in the suspended coroutine
     // list. The head and tail of the list are tracked by AsyncFileReader.
     // We use this approach rather than an STL container in order to avoid
@@ -109,11 +118,21 @@ class AsyncFileReader {
           num_reqs_(num_reqs),
           aligned_buf_(aligned_buf) {}
 
+#if defined(USE_STD_COROUTINES)
+    // With the standard coroutine backend the operation is directly
+    // awaitable. The awaiter registers with AsyncFileReader and is
+    // resumed inline by Wait() once the IO completes.
+    auto operator co_await() const noexcept {
+      return Awaiter(reader_, file_, opts_, read_reqs_, num_reqs_,
+                     aligned_buf_);
+    }
+#else
     auto viaIfAsync(folly::Executor::KeepAlive<> executor) const {
       return folly::coro::co_viaIfAsync(
           std::move(executor),
           Awaiter{reader_, file_, opts_, read_reqs_, num_reqs_, aligned_buf_});
     }
+#endif
 
    private:
     AsyncFileReader& reader_;
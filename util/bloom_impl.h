@@ -228,6 +228,36 @@ class FastLocalBloomImpl {
     return HashMayMatchPrepared(h2, num_probes, data + bytes_to_cache_line);
   }
 
+  // Software-pipelined batch query: issues the cache line prefetch for key
+  // i + kPrefetchAhead while testing key i, so the probe loads of each key
+  // overlap the memory latency of later keys' prefetches instead of the
+  // caller stalling on one line at a time. A distance of two is enough to
+  // cover a memory round trip at typical per-key test cost without
+  // keeping many prefetches in flight. h1s/h2s hold the lower/upper
+  // halves of each key's 64-bit hash, as in HashMayMatch.
+  static inline void HashMayMatchPipelined(const uint32_t *h1s,
+                                           const uint32_t *h2s, int num_keys,
+                                           uint32_t len_bytes, int num_probes,
+                                           const char *data,
+                                           bool *out_may_match) {
+    constexpr int kPrefetchAhead = 2;
+    uint32_t byte_offsets[kPrefetchAhead];
+    const int num_ahead = num_keys < kPrefetchAhead ? num_keys : kPrefetchAhead;
+    for (int i = 0; i < num_ahead; ++i) {
+      PrepareHash(h1s[i], len_bytes, data, &byte_offsets[i]);
+    }
+    for (int i = 0; i < num_keys; ++i) {
+      // Copy out before the slot is reused for key i + kPrefetchAhead
+      uint32_t byte_offset = byte_offsets[i % kPrefetchAhead];
+      if (i + kPrefetchAhead < num_keys) {
+        PrepareHash(h1s[i + kPrefetchAhead], len_bytes, data,
+                    &byte_offsets[(i + kPrefetchAhead) % kPrefetchAhead]);
+      }
+      out_may_match[i] =
+          HashMayMatchPrepared(h2s[i], num_probes, data + byte_offset);
+    }
+  }
+
   static inline bool HashMayMatchPrepared(uint32_t h2, int num_probes,
                                           const char *data_at_cache_line) {
     uint32_t h = h2;
@@ -24,6 +24,7 @@ int main() {
 #include "memory/arena.h"
 #include "port/jemalloc_helper.h"
 #include "rocksdb/filter_policy.h"
+#include "rocksdb/statistics.h"
 #include "table/block_based/filter_policy_internal.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -1166,6 +1167,113 @@ TEST(RibbonTest, RibbonTestLevelThreshold) {
   }
 }
 
+TEST(AdaptiveBloomTest, AdaptiveBloomSizing) {
+  BlockBasedTableOptions opts;
+  FilterBuildingContext ctx(opts);
+  std::unique_ptr<const FilterPolicy> policy(NewAdaptiveBloomFilterPolicy(10));
+  ctx.compaction_style = kCompactionStyleLevel;
+  ctx.num_levels = 7;
+
+  // Upper levels get leaner filters than the bottommost level.
+  SetTestingLevel(0, &ctx);
+  std::unique_ptr<FilterBitsBuilder> builder{
+      policy->GetBuilderWithContext(ctx)};
+  double l0_bpk = GetEffectiveBitsPerKey(builder.get());
+  ASSERT_GT(l0_bpk, 6.5);
+  ASSERT_LT(l0_bpk, 9.0);
+
+  SetTestingLevel(6, &ctx);
+  ctx.is_bottommost = true;
+  builder.reset(policy->GetBuilderWithContext(ctx));
+  double bottom_bpk = GetEffectiveBitsPerKey(builder.get());
+  ASSERT_GT(bottom_bpk, 11.0);
+  ASSERT_LT(bottom_bpk, 14.0);
+  ASSERT_LT(l0_bpk, bottom_bpk);
+
+  // With enough observed lookups, mostly-negative workloads get richer
+  // filters and mostly-positive workloads leaner ones.
+  std::shared_ptr<Statistics> stats = CreateDBStatistics();
+  stats->recordTick(BLOOM_FILTER_USEFUL, 20000);
+  ctx.statistics = stats.get();
+  builder.reset(policy->GetBuilderWithContext(ctx));
+  double negative_bpk = GetEffectiveBitsPerKey(builder.get());
+  ASSERT_GT(negative_bpk, bottom_bpk);
+
+  stats = CreateDBStatistics();
+  stats->recordTick(BLOOM_FILTER_FULL_POSITIVE, 20000);
+  ctx.statistics = stats.get();
+  builder.reset(policy->GetBuilderWithContext(ctx));
+  double positive_bpk = GetEffectiveBitsPerKey(builder.get());
+  ASSERT_LT(positive_bpk, bottom_bpk);
+  // Clamped to no less than half the baseline
+  ASSERT_GT(positive_bpk, 5.0);
+
+  // External SST file (unknown placement) keeps the baseline.
+  ctx.statistics = nullptr;
+  ctx.level_at_creation = -1;
+  ctx.num_levels = -1;
+  ctx.reason = TableFileCreationReason::kMisc;
+  builder.reset(policy->GetBuilderWithContext(ctx));
+  double base_bpk = GetEffectiveBitsPerKey(builder.get());
+  ASSERT_GT(base_bpk, 9.5);
+  ASSERT_LT(base_bpk, 11.0);
+}
+
+TEST(RibbonTest, RibbonTestShardedConstruction) {
+  BlockBasedTableOptions opts;
+  opts.filter_policy.reset(NewRibbonFilterPolicy(
+      10, /*bloom_before_level=*/-1, /*construction_threads=*/4));
+  FilterBuildingContext ctx(opts);
+
+  union {
+    uint64_t key_value = 0;
+    char key_bytes[8];
+  };
+  Slice key_slice{key_bytes, 8};
+
+  // Small filters must keep using the standard (unsharded) format,
+  // regardless of construction_threads.
+  std::unique_ptr<FilterBitsBuilder> builder{
+      opts.filter_policy->GetBuilderWithContext(ctx)};
+  for (key_value = 0; key_value < 1000; ++key_value) {
+    builder->AddKey(key_slice);
+  }
+  std::unique_ptr<const char[]> buf;
+  Slice filter = builder->Finish(&buf);
+  ASSERT_GE(filter.size(), 5U);
+  ASSERT_EQ(static_cast<int>(filter.data()[filter.size() - 5]), -2);
+
+  // Large enough for more than one shard (see kMinShardEntries)
+  const uint64_t kNumKeys = 2100000;
+
+  builder.reset(opts.filter_policy->GetBuilderWithContext(ctx));
+  for (key_value = 0; key_value < kNumKeys; ++key_value) {
+    builder->AddKey(key_slice);
+  }
+  buf.reset();
+  filter = builder->Finish(&buf);
+  ASSERT_GE(filter.size(), 5U);
+  // Sharded Ribbon metadata marker
+  ASSERT_EQ(static_cast<int>(filter.data()[filter.size() - 5]), -3);
+  // Roughly 7 bits per key, plus shard directory and rounding slop
+  ASSERT_LT(filter.size(), kNumKeys);
+
+  std::unique_ptr<FilterBitsReader> reader{
+      opts.filter_policy->GetFilterBitsReader(filter)};
+
+  // No false negatives
+  for (key_value = 0; key_value < kNumKeys; ++key_value) {
+    ASSERT_TRUE(reader->MayMatch(key_slice));
+  }
+
+  // FP rate close to the ~1% configured (10 bloom-equivalent bits)
+  uint64_t fps = 0;
+  for (key_value = kNumKeys; key_value < kNumKeys + 100000; ++key_value) {
+    fps += reader->MayMatch(key_slice) ? 1 : 0;
+  }
+  EXPECT_LT(fps, 3000U);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
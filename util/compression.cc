@@ -79,10 +79,31 @@ int ZSTDStreamingCompress::Compress(const char* input, size_t input_size,
 void ZSTDStreamingCompress::Reset() {
 #ifdef ZSTD_STREAMING
   ZSTD_CCtx_reset(cctx_, ZSTD_ResetDirective::ZSTD_reset_session_only);
+  if (cdict_ != nullptr) {
+    // Re-referencing a digested dictionary is cheap (no table rebuild).
+    ZSTD_CCtx_refCDict(cctx_, cdict_);
+  }
   input_buffer_ = {/*src=*/nullptr, /*size=*/0, /*pos=*/0};
 #endif
 }
 
+void ZSTDStreamingCompress::LoadDictionary(const Slice& dict) {
+#ifdef ZSTD_STREAMING
+  if (cdict_ != nullptr) {
+    ZSTD_freeCDict(cdict_);
+    cdict_ = nullptr;
+  }
+  if (dict.size() > 0) {
+    cdict_ = ZSTD_createCDict(dict.data(), dict.size(), ZSTD_CLEVEL_DEFAULT);
+    if (cdict_ != nullptr) {
+      ZSTD_CCtx_refCDict(cctx_, cdict_);
+    }
+  }
+#else
+  (void)dict;
+#endif
+}
+
 int ZSTDStreamingUncompress::Uncompress(const char* input, size_t input_size,
                                         char* output, size_t* output_pos) {
   assert(input != nullptr && output != nullptr && output_pos != nullptr);
@@ -115,8 +136,28 @@ int ZSTDStreamingUncompress::Uncompress(const char* input, size_t input_size,
 void ZSTDStreamingUncompress::Reset() {
 #ifdef ZSTD_STREAMING
   ZSTD_DCtx_reset(dctx_, ZSTD_ResetDirective::ZSTD_reset_session_only);
+  if (ddict_ != nullptr) {
+    ZSTD_DCtx_refDDict(dctx_, ddict_);
+  }
   input_buffer_ = {/*src=*/nullptr, /*size=*/0, /*pos=*/0};
 #endif
 }
 
+void ZSTDStreamingUncompress::LoadDictionary(const Slice& dict) {
+#ifdef ZSTD_STREAMING
+  if (ddict_ != nullptr) {
+    ZSTD_freeDDict(ddict_);
+    ddict_ = nullptr;
+  }
+  if (dict.size() > 0) {
+    ddict_ = ZSTD_createDDict(dict.data(), dict.size());
+    if (ddict_ != nullptr) {
+      ZSTD_DCtx_refDDict(dctx_, ddict_);
+    }
+  }
+#else
+  (void)dict;
+#endif
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -1680,6 +1680,10 @@ class StreamingCompress {
                                    uint32_t compress_format_version,
                                    size_t max_output_len);
   virtual void Reset() = 0;
+  // Use a pre-trained dictionary for all subsequent frames. The compressed
+  // stream can then only be read by a StreamingUncompress loaded with the
+  // same dictionary. No-op for implementations without dictionary support.
+  virtual void LoadDictionary(const Slice& /*dict*/) {}
 
  protected:
   const CompressionType compression_type_;
@@ -1717,6 +1721,9 @@ class StreamingUncompress {
                                      uint32_t compress_format_version,
                                      size_t max_output_len);
   virtual void Reset() = 0;
+  // Counterpart of StreamingCompress::LoadDictionary(); must be loaded with
+  // the same dictionary the stream was compressed with.
+  virtual void LoadDictionary(const Slice& /*dict*/) {}
 
  protected:
   CompressionType compression_type_;
@@ -1742,14 +1749,21 @@ class ZSTDStreamingCompress final : public StreamingCompress {
   ~ZSTDStreamingCompress() override {
 #ifdef ZSTD_STREAMING
     ZSTD_freeCCtx(cctx_);
+    if (cdict_ != nullptr) {
+      ZSTD_freeCDict(cdict_);
+    }
 #endif
   }
   int Compress(const char* input, size_t input_size, char* output,
                size_t* output_pos) override;
   void Reset() override;
+  void LoadDictionary(const Slice& dict) override;
 #ifdef ZSTD_STREAMING
   ZSTD_CCtx* cctx_;
   ZSTD_inBuffer input_buffer_;
+  // Digested dictionary referenced by cctx_ for every frame; created once in
+  // LoadDictionary() so per-frame Reset() only has to re-reference it.
+  ZSTD_CDict* cdict_ = nullptr;
 #endif
 };
 
@@ -1767,16 +1781,22 @@ class ZSTDStreamingUncompress final : public StreamingUncompress {
   ~ZSTDStreamingUncompress() override {
 #ifdef ZSTD_STREAMING
     ZSTD_freeDCtx(dctx_);
+    if (ddict_ != nullptr) {
+      ZSTD_freeDDict(ddict_);
+    }
 #endif
   }
   int Uncompress(const char* input, size_t input_size, char* output,
                  size_t* output_size) override;
   void Reset() override;
+  void LoadDictionary(const Slice& dict) override;
 
  private:
 #ifdef ZSTD_STREAMING
   ZSTD_DCtx* dctx_;
   ZSTD_inBuffer input_buffer_;
+  // See ZSTDStreamingCompress::cdict_.
+  ZSTD_DDict* ddict_ = nullptr;
 #endif
 };
 
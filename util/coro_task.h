@@ -0,0 +1,177 @@
+//  Copyright (c) Meta Platforms, Inc. and its affiliates. All Rights Reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#pragma once
+
+#if defined(USE_COROUTINES) && defined(USE_STD_COROUTINES)
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace coro {
+
+// A minimal lazily-started coroutine task built on standard C++20
+// coroutines, standing in for folly::coro::Task in builds that cannot
+// take a folly dependency (USE_STD_COROUTINES). It supports exactly what
+// the async MultiGet path needs: a coroutine can co_await a child task
+// (a lazy child runs on the awaiting thread and control transfers back
+// symmetrically when it finishes, while a child already started with
+// Start() just resumes the awaiter once it completes), and
+// SingleThreadExecutor can start a batch of tasks detached, poll for
+// completion, and collect the results.
+template <typename T>
+class Task;
+
+namespace detail {
+
+// Result storage for the promise; specialized so Task<void> coroutines
+// get return_void while value-returning ones get return_value.
+template <typename T>
+class TaskPromiseStorage {
+ public:
+  void return_value(T value) noexcept { value_ = std::move(value); }
+
+ protected:
+  T value_{};
+};
+
+template <>
+class TaskPromiseStorage<void> {
+ public:
+  void return_void() noexcept {}
+};
+
+}  // namespace detail
+
+template <typename T>
+class TaskPromise : public detail::TaskPromiseStorage<T> {
+ public:
+  Task<T> get_return_object() noexcept;
+
+  // Lazy: the coroutine body does not run until the task is started or
+  // awaited
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  // On completion, transfer control back to the awaiting coroutine, if
+  // any. Detached tasks (started by SingleThreadExecutor) have no
+  // continuation; their completion is observed through Task::Done()
+  auto final_suspend() noexcept {
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<TaskPromise> h) noexcept {
+        auto continuation = h.promise().continuation_;
+        return continuation ? continuation : std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+    };
+    return FinalAwaiter{};
+  }
+
+  void unhandled_exception() { exception_ = std::current_exception(); }
+
+  void SetContinuation(std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+  }
+
+  T Result() && {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(this->value_);
+    }
+  }
+
+ private:
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+class Task {
+ public:
+  using promise_type = TaskPromise<T>;
+
+  Task(Task&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)),
+        started_(std::exchange(other.started_, false)) {}
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+      started_ = std::exchange(other.started_, false);
+    }
+    return *this;
+  }
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  // Start a detached task. It runs on the calling thread until it
+  // completes or suspends waiting on async IO; the caller polls Done()
+  // and fetches the final value with Result()
+  void Start() {
+    started_ = true;
+    handle_.resume();
+  }
+
+  bool Done() const { return handle_.done(); }
+
+  T Result() && { return std::move(handle_.promise()).Result(); }
+
+  // Awaiting a lazy task starts it immediately on the awaiting thread and
+  // resumes the awaiter when the task finishes. Awaiting a task that was
+  // already launched with Start() does not resume it again; the awaiter is
+  // suspended until the (possibly IO-suspended) task runs to completion
+  auto operator co_await() && noexcept {
+    struct TaskAwaiter {
+      std::coroutine_handle<promise_type> handle;
+      bool started;
+      bool await_ready() noexcept { return started && handle.done(); }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().SetContinuation(awaiting);
+        if (started) {
+          // The task is suspended waiting on async IO; it resumes the
+          // awaiter through the continuation when it finishes
+          return std::noop_coroutine();
+        }
+        return handle;
+      }
+      T await_resume() { return std::move(handle.promise()).Result(); }
+    };
+    return TaskAwaiter{handle_, started_};
+  }
+
+ private:
+  friend class TaskPromise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+  bool started_ = false;
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+}  // namespace coro
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // defined(USE_COROUTINES) && defined(USE_STD_COROUTINES)
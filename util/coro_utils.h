@@ -4,9 +4,13 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #if defined(USE_COROUTINES)
+#if defined(USE_STD_COROUTINES)
+#include "util/coro_task.h"
+#else
 #include "folly/experimental/coro/Coroutine.h"
 #include "folly/experimental/coro/Task.h"
 #endif
+#endif
 #include "rocksdb/rocksdb_namespace.h"
 
 // This file has two sctions. The first section applies to all instances of
@@ -19,20 +23,29 @@ namespace ROCKSDB_NAMESPACE {
 
 #if defined(USE_COROUTINES)
 
+// The coroutine task type underlying the async functions declared below.
+// Either folly::coro::Task or the folly-free standard C++20 coroutine
+// backend in util/coro_task.h, depending on the build.
+#if defined(USE_STD_COROUTINES)
+#define ROCKSDB_CORO_TASK ROCKSDB_NAMESPACE::coro::Task
+#else
+#define ROCKSDB_CORO_TASK folly::coro::Task
+#endif
+
 // The follwoing macros expand to regular and coroutine function
 // declarations for a given function
 #define DECLARE_SYNC_AND_ASYNC(__ret_type__, __func_name__, ...) \
   __ret_type__ __func_name__(__VA_ARGS__);                       \
-  folly::coro::Task<__ret_type__> __func_name__##Coroutine(__VA_ARGS__);
+  ROCKSDB_CORO_TASK<__ret_type__> __func_name__##Coroutine(__VA_ARGS__);
 
 #define DECLARE_SYNC_AND_ASYNC_OVERRIDE(__ret_type__, __func_name__, ...) \
   __ret_type__ __func_name__(__VA_ARGS__) override;                       \
-  folly::coro::Task<__ret_type__> __func_name__##Coroutine(__VA_ARGS__)   \
+  ROCKSDB_CORO_TASK<__ret_type__> __func_name__##Coroutine(__VA_ARGS__)   \
       override;
 
 #define DECLARE_SYNC_AND_ASYNC_CONST(__ret_type__, __func_name__, ...) \
   __ret_type__ __func_name__(__VA_ARGS__) const;                       \
-  folly::coro::Task<__ret_type__> __func_name__##Coroutine(__VA_ARGS__) const;
+  ROCKSDB_CORO_TASK<__ret_type__> __func_name__##Coroutine(__VA_ARGS__) const;
 
 constexpr bool using_coroutines() { return true; }
 #else  // !USE_COROUTINES
@@ -69,7 +82,7 @@ constexpr bool using_coroutines() { return false; }
 // would expand to -
 // folly::coro::Task<int> fooCoroutine(bool bar) {}
 #define DEFINE_SYNC_AND_ASYNC(__ret_type__, __func_name__) \
-  folly::coro::Task<__ret_type__> __func_name__##Coroutine
+  ROCKSDB_CORO_TASK<__ret_type__> __func_name__##Coroutine
 
 // This macro should be used to call a function that might be a
 // coroutine. It expands to the correct function name and prefixes
@@ -20,6 +20,20 @@
 #include <wmmintrin.h>
 #endif
 
+// An AVX-512 + VPCLMULQDQ implementation of Extend is compiled in when the
+// compiler supports per-function target attributes and the 512-bit carry-less
+// multiply intrinsics (gcc 8+ / clang 8+ on x86-64). No extra build flags are
+// needed; whether it actually runs is decided at load time by cpuid, like the
+// isSSE42() probe below.
+#if defined(HAVE_SSE42) && defined(HAVE_PCLMUL) && defined(__GNUC__) && \
+    defined(__x86_64__) && !defined(IOS_CROSS_COMPILE) &&               \
+    !defined(NO_AVX512_CRC32C) &&                                       \
+    ((defined(__clang__) && __clang_major__ >= 8) ||                    \
+     (!defined(__clang__) && __GNUC__ >= 8))
+#include <immintrin.h>
+#define HAVE_AVX512_CRC32C 1
+#endif
+
 #include "port/lang.h"
 #include "util/coding.h"
 #include "util/crc32c_arm64.h"
@@ -456,6 +470,26 @@ static bool isPCLMULQDQ() {
 #endif
 }
 
+#ifdef HAVE_AVX512_CRC32C
+static bool isAVX512VPCLMULQDQ() {
+  uint32_t c1_;
+  __asm__("cpuid" : "=c"(c1_) : "a"(1) : "ebx", "edx");
+  if ((c1_ & (1U << 27)) == 0) {  // OSXSAVE, required for XGETBV
+    return false;
+  }
+  uint32_t xcr0_lo_, xcr0_hi_;
+  __asm__("xgetbv" : "=a"(xcr0_lo_), "=d"(xcr0_hi_) : "c"(0U));
+  if ((xcr0_lo_ & 0xe6U) != 0xe6U) {  // OS saves XMM/YMM/ZMM/opmask state
+    return false;
+  }
+  uint32_t b7_, c7_;
+  __asm__("cpuid" : "=b"(b7_), "=c"(c7_) : "a"(7), "c"(0U) : "edx");
+  // AVX512F (EBX bit 16), AVX512VL (EBX bit 31), VPCLMULQDQ (ECX bit 10)
+  return (b7_ & (1U << 16)) != 0 && (b7_ & (1U << 31)) != 0 &&
+         (c7_ & (1U << 10)) != 0;
+}
+#endif  // HAVE_AVX512_CRC32C
+
 #endif  // HAVE_POWER8
 #endif  // HAVE_ARM64_CRC
 
@@ -1249,6 +1283,107 @@ uint32_t crc32c_3way(uint32_t crc, const char* buf, size_t len) {
 
 #endif //HAVE_SSE42 && HAVE_PCLMUL
 
+#ifdef HAVE_AVX512_CRC32C
+
+// Compute CRC-32C by folding four 64-byte vectors at a time with VPCLMULQDQ
+// and reducing the final 128 bits through the crc32 instruction. The folding
+// constants are x^(8*D+32) mod P and x^(8*D-32) mod P (bit-reflected and
+// shifted left by one) for fold distances D of 256, 64 and 16 bytes; the
+// D=16 pair is also the first entry of clmul_constants above.
+#ifdef ROCKSDB_UBSAN_RUN
+#if defined(__clang__)
+__attribute__((__no_sanitize__("alignment")))
+#elif defined(__GNUC__)
+__attribute__((__no_sanitize_undefined__))
+#endif
+#endif
+__attribute__((target("sse4.2,pclmul,avx512f,avx512vl,vpclmulqdq")))
+uint32_t crc32c_avx512(uint32_t crc, const char* buf, size_t len) {
+  if (len < 256) {
+    // Not enough data to fill the folding registers even once.
+    return crc32c_3way(crc, buf, len);
+  }
+  const unsigned char* next = (const unsigned char*)buf;
+  uint64_t crc64 = crc ^ 0xffffffffu;
+
+  const __m512i fold256 =
+      _mm512_broadcast_i32x4(_mm_set_epi64x(0x0b9e02b86, 0x0dcb17aa4));
+  const __m512i fold64 =
+      _mm512_broadcast_i32x4(_mm_set_epi64x(0x09e4addf8, 0x0740eef02));
+  const __m128i fold16 = _mm_set_epi64x(0x14cd00bd6, 0x0f20c0dfe);
+
+  __m512i x0 = _mm512_loadu_si512((const void*)(next + 0));
+  __m512i x1 = _mm512_loadu_si512((const void*)(next + 64));
+  __m512i x2 = _mm512_loadu_si512((const void*)(next + 128));
+  __m512i x3 = _mm512_loadu_si512((const void*)(next + 192));
+  // The starting crc is xor-ed onto the first four message bytes.
+  x0 = _mm512_xor_si512(
+      x0, _mm512_castsi128_si512(_mm_cvtsi32_si128((uint32_t)crc64)));
+  next += 256;
+  len -= 256;
+
+  // Each 128-bit lane is folded forward by 256 bytes onto the incoming
+  // data; vpternlogd computes the three-way xor in one instruction.
+  while (len >= 256) {
+    x0 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(x0, fold256, 0x00),
+        _mm512_clmulepi64_epi128(x0, fold256, 0x11),
+        _mm512_loadu_si512((const void*)(next + 0)), 0x96);
+    x1 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(x1, fold256, 0x00),
+        _mm512_clmulepi64_epi128(x1, fold256, 0x11),
+        _mm512_loadu_si512((const void*)(next + 64)), 0x96);
+    x2 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(x2, fold256, 0x00),
+        _mm512_clmulepi64_epi128(x2, fold256, 0x11),
+        _mm512_loadu_si512((const void*)(next + 128)), 0x96);
+    x3 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(x3, fold256, 0x00),
+        _mm512_clmulepi64_epi128(x3, fold256, 0x11),
+        _mm512_loadu_si512((const void*)(next + 192)), 0x96);
+    next += 256;
+    len -= 256;
+  }
+
+  // Fold the four vectors into one; each step shifts by 64 bytes.
+  x1 = _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x0, fold64, 0x00),
+                                 _mm512_clmulepi64_epi128(x0, fold64, 0x11),
+                                 x1, 0x96);
+  x2 = _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x1, fold64, 0x00),
+                                 _mm512_clmulepi64_epi128(x1, fold64, 0x11),
+                                 x2, 0x96);
+  x3 = _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x2, fold64, 0x00),
+                                 _mm512_clmulepi64_epi128(x2, fold64, 0x11),
+                                 x3, 0x96);
+
+  // Fold the four 128-bit lanes into one.
+  __m128i a = _mm512_castsi512_si128(x3);
+  a = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, fold16, 0x00),
+                                  _mm_clmulepi64_si128(a, fold16, 0x11)),
+                    _mm512_extracti32x4_epi32(x3, 1));
+  a = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, fold16, 0x00),
+                                  _mm_clmulepi64_si128(a, fold16, 0x11)),
+                    _mm512_extracti32x4_epi32(x3, 2));
+  a = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, fold16, 0x00),
+                                  _mm_clmulepi64_si128(a, fold16, 0x11)),
+                    _mm512_extracti32x4_epi32(x3, 3));
+
+  // The remaining 128 bits stand in for the corresponding message bytes,
+  // so the crc32 instruction performs the final reduction for free.
+  crc64 = _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(a));
+  crc64 = _mm_crc32_u64(crc64, (uint64_t)_mm_extract_epi64(a, 1));
+
+  while (len >= 8) {
+    crc64 = _mm_crc32_u64(crc64, *(uint64_t*)next);
+    next += 8;
+    len -= 8;
+  }
+  align_to_8(len, crc64, next);
+  return (uint32_t)crc64 ^ 0xffffffffu;
+}
+
+#endif  // HAVE_AVX512_CRC32C
+
 static inline Function Choose_Extend() {
 #ifdef HAVE_POWER8
   return isAltiVec() ? ExtendPPCImpl : ExtendImpl<Slow_CRC32>;
@@ -1263,6 +1398,11 @@ static inline Function Choose_Extend() {
   if (isSSE42()) {
     if (isPCLMULQDQ()) {
 #if defined HAVE_SSE42  && defined HAVE_PCLMUL && !defined NO_THREEWAY_CRC32C
+#ifdef HAVE_AVX512_CRC32C
+      if (isAVX512VPCLMULQDQ()) {
+        return crc32c_avx512;
+      }
+#endif
       return crc32c_3way;
 #else
     return ExtendImpl<Fast_CRC32>; // Fast_CRC32 will check HAVE_SSE42 itself
@@ -67,4 +67,34 @@ DynamicBloom::DynamicBloom(Allocator* allocator, uint32_t total_bits,
   data_ = reinterpret_cast<std::atomic<uint64_t>*>(raw);
 }
 
+DynamicBloom::DynamicBloom(Allocator* allocator, const DynamicBloom& shape)
+    : kLen(shape.kLen), kNumDoubleProbes(shape.kNumDoubleProbes) {
+  uint32_t block_bytes = /*bytes/u64*/ 8 *
+                         /*u64s*/ std::max(1U, roundUpToPow2(kNumDoubleProbes));
+  uint32_t sz = kLen * /*bytes/u64*/ 8;
+
+  // Padding to correct for allocation not originally aligned on block_bytes
+  // boundary
+  sz += block_bytes - 1;
+  assert(allocator);
+
+  char* raw = allocator->AllocateAligned(sz);
+  memset(raw, 0, sz);
+  auto block_offset = reinterpret_cast<uintptr_t>(raw) % block_bytes;
+  if (block_offset > 0) {
+    // Align on block_bytes boundary
+    raw += block_bytes - block_offset;
+  }
+  data_ = reinterpret_cast<std::atomic<uint64_t>*>(raw);
+}
+
+void DynamicBloom::MergeFrom(const DynamicBloom& other) {
+  assert(IsCompatible(other));
+  for (uint32_t i = 0; i < kLen; ++i) {
+    data_[i].store(data_[i].load(std::memory_order_relaxed) |
+                       other.data_[i].load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
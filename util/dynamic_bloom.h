@@ -48,6 +48,10 @@ class DynamicBloom {
                         uint32_t num_probes = 6, size_t huge_page_tlb_size = 0,
                         Logger* logger = nullptr);
 
+  // Creates a filter with the same size and probing scheme as `shape`, with
+  // all bits clear. Useful as a target for MergeFrom().
+  DynamicBloom(Allocator* allocator, const DynamicBloom& shape);
+
   ~DynamicBloom() {}
 
   // Assuming single threaded access to this function.
@@ -72,6 +76,17 @@ class DynamicBloom {
 
   void Prefetch(uint32_t h);
 
+  // Whether `other` has the same size and probing scheme, which makes the
+  // bit arrays of the two filters interchangeable for MergeFrom().
+  bool IsCompatible(const DynamicBloom& other) const {
+    return kLen == other.kLen && kNumDoubleProbes == other.kNumDoubleProbes;
+  }
+
+  // ORs the bits of a compatible filter into this one, after which this
+  // filter matches every key that either filter matched.
+  // Assuming single threaded access to this function.
+  void MergeFrom(const DynamicBloom& other);
+
  private:
   // Length of the structure, in 64-bit words. For this structure, "word"
   // will always refer to 64-bit words.
@@ -102,6 +102,25 @@ uint64_t GetSlicePartsNPHash64(const SliceParts& data, uint64_t seed) {
   return NPHash64(concat_data.data(), concat_len, seed);
 }
 
+// The bundled XXH3 kernels are already vectorized over the bytes of each
+// key and expose no multi-key entry point, so the batch functions hash one
+// key at a time. Batching still pays off: the per-call dispatch and the
+// length-dependent branches stay resident across the whole batch.
+void GetSliceHashes64(const Slice* const* keys, size_t num_keys,
+                      uint64_t* hashes) {
+  for (size_t i = 0; i < num_keys; ++i) {
+    hashes[i] = XXPH3_64bits(keys[i]->data(), keys[i]->size());
+  }
+}
+
+void GetSliceHashes128(const Slice* const* keys, size_t num_keys,
+                       Unsigned128* hashes) {
+  for (size_t i = 0; i < num_keys; ++i) {
+    auto h = XXH3_128bits(keys[i]->data(), keys[i]->size());
+    hashes[i] = (Unsigned128{h.high64} << 64) | (h.low64);
+  }
+}
+
 Unsigned128 Hash128(const char* data, size_t n, uint64_t seed) {
   auto h = XXH3_128bits_withSeed(data, n, seed);
   return (Unsigned128{h.high64} << 64) | (h.low64);
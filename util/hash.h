@@ -97,6 +97,13 @@ inline uint32_t BloomHash(const Slice& key) {
 inline uint64_t GetSliceHash64(const Slice& key) {
   return Hash64(key.data(), key.size());
 }
+
+// Hashes a batch of keys in one call, writing the GetSliceHash64 value of
+// *keys[i] to hashes[i]. Intended for callers like MultiGet that have many
+// keys in hand at once; hashing them together keeps the hash state and
+// tables hot instead of interleaving hashing with unrelated work.
+extern void GetSliceHashes64(const Slice* const* keys, size_t num_keys,
+                             uint64_t* hashes);
 // Provided for convenience for use with template argument deduction, where a
 // specific overload needs to be used.
 extern uint64_t (*kGetSliceNPHash64UnseededFnPtr)(const Slice&);
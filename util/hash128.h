@@ -23,4 +23,8 @@ inline Unsigned128 GetSliceHash128(const Slice& key) {
   return Hash128(key.data(), key.size());
 }
 
+// Batch version of GetSliceHash128; see GetSliceHashes64 in hash.h.
+extern void GetSliceHashes128(const Slice* const* keys, size_t num_keys,
+                              Unsigned128* hashes);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -438,6 +438,40 @@ TEST(HashTest, Hash128ValueSchema) {
       "GHSUNJ6OxsMHhf8EhXfHtKyUzRmPtjYyeckQcGmrQfFFLidc6cjMDKCdBG6c6HVBrS7H2R");
 }
 
+TEST(HashTest, BatchHashes) {
+  using ROCKSDB_NAMESPACE::GetSliceHash128;
+  using ROCKSDB_NAMESPACE::GetSliceHash64;
+  using ROCKSDB_NAMESPACE::GetSliceHashes128;
+  using ROCKSDB_NAMESPACE::GetSliceHashes64;
+  using ROCKSDB_NAMESPACE::Unsigned128;
+
+  // Batch results must match the single-key functions for keys of a
+  // variety of lengths, crossing the XXH3 small/medium/large kernels.
+  constexpr size_t kNumKeys = 70;
+  std::vector<std::string> key_strs;
+  std::vector<const Slice*> keys;
+  std::vector<Slice> slices;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    key_strs.emplace_back(i * 5, static_cast<char>('a' + (i % 26)));
+  }
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    slices.emplace_back(key_strs[i]);
+  }
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    keys.push_back(&slices[i]);
+  }
+
+  std::vector<uint64_t> hashes64(kNumKeys);
+  GetSliceHashes64(keys.data(), kNumKeys, hashes64.data());
+  std::vector<Unsigned128> hashes128(kNumKeys);
+  GetSliceHashes128(keys.data(), kNumKeys, hashes128.data());
+
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    EXPECT_EQ(hashes64[i], GetSliceHash64(slices[i]));
+    EXPECT_EQ(hashes128[i], GetSliceHash128(slices[i]));
+  }
+}
+
 TEST(FastRange32Test, Values) {
   using ROCKSDB_NAMESPACE::FastRange32;
   // Zero range
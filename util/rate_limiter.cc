@@ -48,7 +48,7 @@ struct GenericRateLimiter::Req {
 GenericRateLimiter::GenericRateLimiter(
     int64_t rate_bytes_per_sec, int64_t refill_period_us, int32_t fairness,
     RateLimiter::Mode mode, const std::shared_ptr<SystemClock>& clock,
-    bool auto_tuned)
+    bool auto_tuned, const std::vector<int32_t>& priority_reservation_pcts)
     : RateLimiter(mode),
       refill_period_us_(refill_period_us),
       rate_bytes_per_sec_(auto_tuned ? rate_bytes_per_sec / 2
@@ -64,13 +64,17 @@ GenericRateLimiter::GenericRateLimiter(
       fairness_(fairness > 100 ? 100 : fairness),
       rnd_((uint32_t)time(nullptr)),
       wait_until_refill_pending_(false),
+      pri_reservation_pcts_(priority_reservation_pcts),
       auto_tuned_(auto_tuned),
       num_drains_(0),
       max_bytes_per_sec_(rate_bytes_per_sec),
       tuned_time_(NowMicrosMonotonicLocked()) {
+  assert(pri_reservation_pcts_.empty() ||
+         pri_reservation_pcts_.size() == static_cast<size_t>(Env::IO_TOTAL));
   for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
     total_requests_[i] = 0;
     total_bytes_through_[i] = 0;
+    pri_deficit_bytes_[i] = 0;
   }
 }
 
@@ -258,6 +262,46 @@ GenericRateLimiter::GeneratePriorityIterationOrderLocked() {
   return pri_iteration_order;
 }
 
+// Deficit-round-robin pass over the priority queues: every refill, each
+// priority is credited its reserved share of the period (its quantum) and
+// may grant queued requests against the banked deficit before the
+// fairness-based pass runs. This keeps e.g. flush writes (Env::IO_HIGH)
+// flowing at their reserved rate while a compaction backlog occupies the
+// rest of the budget. A backlogged priority banks at most
+// kReservationBurstPeriods quanta so a short burst clears in one period,
+// and an idle priority forfeits its deficit so reservations cannot be
+// hoarded. Only whole requests are granted here; partial grants are left
+// to the fairness pass.
+void GenericRateLimiter::GrantReservedBytesLocked(
+    int64_t refill_bytes_per_period) {
+  for (int i = Env::IO_TOTAL - 1; i >= Env::IO_LOW; --i) {
+    auto* queue = &queue_[i];
+    if (queue->empty()) {
+      pri_deficit_bytes_[i] = 0;
+      continue;
+    }
+    int64_t quantum = refill_bytes_per_period * pri_reservation_pcts_[i] / 100;
+    pri_deficit_bytes_[i] = std::min(pri_deficit_bytes_[i] + quantum,
+                                     kReservationBurstPeriods * quantum);
+    while (!queue->empty()) {
+      auto* next_req = queue->front();
+      if (next_req->request_bytes > pri_deficit_bytes_[i] ||
+          next_req->request_bytes > available_bytes_) {
+        break;
+      }
+      pri_deficit_bytes_[i] -= next_req->request_bytes;
+      available_bytes_ -= next_req->request_bytes;
+      next_req->request_bytes = 0;
+      total_bytes_through_[i] += next_req->bytes;
+      queue->pop_front();
+
+      next_req->granted = true;
+      // Quota granted, signal the thread to exit
+      next_req->cv.Signal();
+    }
+  }
+}
+
 void GenericRateLimiter::RefillBytesAndGrantRequestsLocked() {
   TEST_SYNC_POINT_CALLBACK(
       "GenericRateLimiter::RefillBytesAndGrantRequestsLocked", &request_mutex_);
@@ -269,6 +313,10 @@ void GenericRateLimiter::RefillBytesAndGrantRequestsLocked() {
     available_bytes_ += refill_bytes_per_period;
   }
 
+  if (!pri_reservation_pcts_.empty()) {
+    GrantReservedBytesLocked(refill_bytes_per_period);
+  }
+
   std::vector<Env::IOPriority> pri_iteration_order =
       GeneratePriorityIterationOrderLocked();
 
@@ -365,13 +413,26 @@ RateLimiter* NewGenericRateLimiter(
     int64_t rate_bytes_per_sec, int64_t refill_period_us /* = 100 * 1000 */,
     int32_t fairness /* = 10 */,
     RateLimiter::Mode mode /* = RateLimiter::Mode::kWritesOnly */,
-    bool auto_tuned /* = false */) {
+    bool auto_tuned /* = false */,
+    const std::vector<int32_t>& priority_reservation_pcts /* = {} */) {
   assert(rate_bytes_per_sec > 0);
   assert(refill_period_us > 0);
   assert(fairness > 0);
-  std::unique_ptr<RateLimiter> limiter(
-      new GenericRateLimiter(rate_bytes_per_sec, refill_period_us, fairness,
-                             mode, SystemClock::Default(), auto_tuned));
+#ifndef NDEBUG
+  if (!priority_reservation_pcts.empty()) {
+    assert(priority_reservation_pcts.size() ==
+           static_cast<size_t>(Env::IO_TOTAL));
+    int32_t pct_sum = 0;
+    for (int32_t pct : priority_reservation_pcts) {
+      assert(pct >= 0 && pct <= 100);
+      pct_sum += pct;
+    }
+    assert(pct_sum <= 100);
+  }
+#endif  // NDEBUG
+  std::unique_ptr<RateLimiter> limiter(new GenericRateLimiter(
+      rate_bytes_per_sec, refill_period_us, fairness, mode,
+      SystemClock::Default(), auto_tuned, priority_reservation_pcts));
   return limiter.release();
 }
 
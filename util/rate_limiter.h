@@ -13,6 +13,7 @@
 #include <atomic>
 #include <chrono>
 #include <deque>
+#include <vector>
 
 #include "port/port.h"
 #include "rocksdb/env.h"
@@ -29,7 +30,9 @@ class GenericRateLimiter : public RateLimiter {
   GenericRateLimiter(int64_t refill_bytes, int64_t refill_period_us,
                      int32_t fairness, RateLimiter::Mode mode,
                      const std::shared_ptr<SystemClock>& clock,
-                     bool auto_tuned);
+                     bool auto_tuned,
+                     const std::vector<int32_t>& priority_reservation_pcts =
+                         {});
 
   virtual ~GenericRateLimiter();
 
@@ -102,6 +105,7 @@ class GenericRateLimiter : public RateLimiter {
   }
 
  private:
+  void GrantReservedBytesLocked(int64_t refill_bytes_per_period);
   void RefillBytesAndGrantRequestsLocked();
   std::vector<Env::IOPriority> GeneratePriorityIterationOrderLocked();
   int64_t CalculateRefillBytesPerPeriodLocked(int64_t rate_bytes_per_sec);
@@ -137,6 +141,15 @@ class GenericRateLimiter : public RateLimiter {
   std::deque<Req*> queue_[Env::IO_TOTAL];
   bool wait_until_refill_pending_;
 
+  // Deficit-round-robin reservations (see NewGenericRateLimiter). Empty
+  // pri_reservation_pcts_ disables the reservation pass. The deficits are
+  // the per-priority bytes banked from reserved but not yet consumed refill
+  // shares; a backlogged priority may bank up to kReservationBurstPeriods
+  // refills worth, an idle one forfeits its deficit.
+  static constexpr int64_t kReservationBurstPeriods = 2;
+  const std::vector<int32_t> pri_reservation_pcts_;
+  int64_t pri_deficit_bytes_[Env::IO_TOTAL];
+
   bool auto_tuned_;
   int64_t num_drains_;
   const int64_t max_bytes_per_sec_;
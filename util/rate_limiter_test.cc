@@ -260,6 +260,49 @@ TEST_F(RateLimiterTest, GeneratePriorityIterationOrder) {
   }
 }
 
+TEST_F(RateLimiterTest, PriorityReservations) {
+  // Reserve half of every refill for low-pri (deep-compaction-like) work,
+  // then flood the limiter with high-pri requests. The fairness mechanism
+  // alone lets high-pri go first in all but ~1/fairness of the periods, so
+  // the low-pri stream would see only a trickle (~10% here); with the
+  // deficit-round-robin reservation it must keep roughly its reserved
+  // share of the budget.
+  std::unique_ptr<RateLimiter> limiter(NewGenericRateLimiter(
+      400 << 10 /* rate_bytes_per_sec */, 10 * 1000 /* refill_period_us */,
+      10 /* fairness */, RateLimiter::Mode::kWritesOnly,
+      false /* auto_tuned */,
+      {50 /* IO_LOW */, 0 /* IO_MID */, 0 /* IO_HIGH */, 0 /* IO_USER */}));
+
+  std::atomic<bool> stop{false};
+  auto requester = [&](Env::IOPriority pri) {
+    while (!stop.load(std::memory_order_relaxed)) {
+      limiter->Request(1 << 10, pri, nullptr /* stats */,
+                       RateLimiter::OpType::kWrite);
+    }
+  };
+  std::vector<port::Thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(requester, Env::IO_HIGH);
+  }
+  // Two low-pri requesters so the low-pri queue stays backlogged enough to
+  // consume its whole reservation.
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back(requester, Env::IO_LOW);
+  }
+  Env::Default()->SleepForMicroseconds(2 * 1000 * 1000);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  int64_t low_pri_bytes = limiter->GetTotalBytesThrough(Env::IO_LOW);
+  int64_t total_bytes = limiter->GetTotalBytesThrough();
+  ASSERT_GT(total_bytes, 0);
+  // Expected ~50%; use a wide margin to tolerate scheduling noise while
+  // staying clearly above the no-reservation trickle.
+  ASSERT_GE(low_pri_bytes, total_bytes / 5);
+}
+
 TEST_F(RateLimiterTest, Rate) {
   auto* env = Env::Default();
   struct Arg {
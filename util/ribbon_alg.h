@@ -1216,6 +1216,68 @@ inline bool InterleavedFilterQuery(
   return true;
 }
 
+// Filter query a key from InterleavedPrepareQuery, like
+// InterleavedFilterQuery, but branch-free: the parities of all columns are
+// accumulated into a computed result row that is compared against the
+// expected row once, instead of early-exiting on the first non-matching
+// column. For an isolated query the early exit usually wins, but when
+// several prepared queries are processed back-to-back (as over a MultiGet
+// batch), the data-dependent exit branches mispredict at unpredictable
+// columns and stall the pipeline, while this form is straight-line code
+// that the compiler can unroll and vectorize and the CPU can overlap
+// across neighboring keys.
+template <typename InterleavedSolutionStorage, typename FilterQueryHasher>
+inline bool InterleavedFilterQueryBranchless(
+    typename FilterQueryHasher::Hash hash,
+    typename InterleavedSolutionStorage::Index segment_num,
+    typename InterleavedSolutionStorage::Index num_columns,
+    typename InterleavedSolutionStorage::Index start_bit,
+    const FilterQueryHasher &hasher, const InterleavedSolutionStorage &iss) {
+  using CoeffRow = typename InterleavedSolutionStorage::CoeffRow;
+  using Index = typename InterleavedSolutionStorage::Index;
+  using ResultRow = typename InterleavedSolutionStorage::ResultRow;
+
+  static_assert(sizeof(Index) == sizeof(typename FilterQueryHasher::Index),
+                "must be same");
+  static_assert(
+      sizeof(CoeffRow) == sizeof(typename FilterQueryHasher::CoeffRow),
+      "must be same");
+  static_assert(
+      sizeof(ResultRow) == sizeof(typename FilterQueryHasher::ResultRow),
+      "must be same");
+
+  constexpr auto kCoeffBits = static_cast<Index>(sizeof(CoeffRow) * 8U);
+
+  const CoeffRow cr = hasher.GetCoeffRow(hash);
+  const ResultRow expected = hasher.GetResultRowFromHash(hash);
+
+  ResultRow found = 0;
+  if (start_bit == 0) {
+    for (Index i = 0; i < num_columns; ++i) {
+      found ^= static_cast<ResultRow>(
+          BitParity(iss.LoadSegment(segment_num + i) & cr) << i);
+    }
+  } else {
+    const CoeffRow cr_left = cr << static_cast<unsigned>(start_bit);
+    const CoeffRow cr_right =
+        cr >> static_cast<unsigned>(kCoeffBits - start_bit);
+
+    for (Index i = 0; i < num_columns; ++i) {
+      CoeffRow soln_data =
+          (iss.LoadSegment(segment_num + i) & cr_left) ^
+          (iss.LoadSegment(segment_num + num_columns + i) & cr_right);
+      found ^= static_cast<ResultRow>(BitParity(soln_data) << i);
+    }
+  }
+  // Only the columns actually stored can be expected to match. (The
+  // expected row may have bits set above num_columns.)
+  const ResultRow match_mask =
+      num_columns >= static_cast<Index>(8U * sizeof(ResultRow))
+          ? static_cast<ResultRow>(~ResultRow{0})
+          : static_cast<ResultRow>((ResultRow{1} << num_columns) - 1);
+  return ((found ^ expected) & match_mask) == 0;
+}
+
 // TODO: refactor Interleaved*Query so that queries can be "prepared" by
 // prefetching memory, to hide memory latency for multiple queries in a
 // single thread.
@@ -938,6 +938,28 @@ class SerializableInterleavedSolution {
     }
   }
 
+  // Same result as FilterQuery, using the branch-free kernel preferred for
+  // batched queries. See InterleavedFilterQueryBranchless.
+  template <typename FilterQueryHasher>
+  bool FilterQueryBranchless(const Key& input,
+                             const FilterQueryHasher& hasher) const {
+    assert(TypesAndSettings::kIsFilter);
+    if (TypesAndSettings::kAllowZeroStarts && num_starts_ == 0) {
+      // Unusual. Zero starts presumes no keys added -> always false
+      return false;
+    } else {
+      // NOTE: not using a struct to encourage compiler optimization
+      Hash hash;
+      Index segment_num;
+      Index num_columns;
+      Index start_bit;
+      InterleavedPrepareQuery(input, hasher, *this, &hash, &segment_num,
+                              &num_columns, &start_bit);
+      return InterleavedFilterQueryBranchless(hash, segment_num, num_columns,
+                                              start_bit, hasher, *this);
+    }
+  }
+
   double ExpectedFpRate() const {
     assert(TypesAndSettings::kIsFilter);
     if (TypesAndSettings::kAllowZeroStarts && num_starts_ == 0) {
@@ -679,6 +679,8 @@ TYPED_TEST(RibbonTypeParamTest, CompactnessAndBacktrackAndFpRate) {
       while (cur != keys_end) {
         ASSERT_TRUE(soln.FilterQuery(*cur, hasher));
         ASSERT_TRUE(!test_interleaved || isoln.FilterQuery(*cur, hasher));
+        ASSERT_TRUE(!test_interleaved ||
+                    isoln.FilterQueryBranchless(*cur, hasher));
         ++cur;
       }
       // We (maybe) snuck these in!
@@ -761,6 +763,15 @@ TYPED_TEST(RibbonTypeParamTest, CompactnessAndBacktrackAndFpRate) {
         // Since the bits used in isoln are a subset of the bits used in soln,
         // it cannot have fewer FPs
         EXPECT_GE(ifp_count, fp_count);
+
+        // The branch-free batched query kernel must agree exactly with the
+        // early-exit kernel, on non-added keys as well as added ones.
+        cur = other_keys_begin;
+        while (cur != other_keys_end) {
+          ASSERT_EQ(isoln.FilterQuery(*cur, hasher),
+                    isoln.FilterQueryBranchless(*cur, hasher));
+          ++cur;
+        }
       }
 
       // And compare to Bloom time, for fun
@@ -8,12 +8,55 @@
 #if USE_COROUTINES
 #include <atomic>
 
+#if defined(USE_STD_COROUTINES)
+#include <vector>
+
+#include "util/async_file_reader.h"
+#include "util/coro_task.h"
+#else
 #include "folly/CPortability.h"
 #include "folly/CppAttributes.h"
 #include "folly/Executor.h"
 #include "util/async_file_reader.h"
+#endif
 
 namespace ROCKSDB_NAMESPACE {
+#if defined(USE_STD_COROUTINES)
+// Runs a batch of coroutine tasks to completion on the calling thread,
+// playing the role folly's executor plus blockingWait/collectAllRange
+// play in the folly build. Every task is started and runs inline until
+// it completes or suspends waiting on async IO; the driver then polls
+// for IO completions, which resume the suspended tasks (again inline),
+// until all tasks are done.
+// Any possibility of deadlock is precluded because a task only ever
+// suspends on an AsyncFileReader awaitable, which registers it to be
+// resumed by the next Wait().
+class SingleThreadExecutor {
+ public:
+  explicit SingleThreadExecutor(AsyncFileReader& reader) : reader_(reader) {}
+
+  template <typename T>
+  std::vector<T> BlockingCollectAll(std::vector<coro::Task<T>>&& tasks) {
+    for (auto& task : tasks) {
+      task.Start();
+    }
+    for (auto& task : tasks) {
+      while (!task.Done()) {
+        reader_.Wait();
+      }
+    }
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (auto& task : tasks) {
+      results.push_back(std::move(task).Result());
+    }
+    return results;
+  }
+
+ private:
+  AsyncFileReader& reader_;
+};
+#else
 // Implements a simple executor that runs callback functions in the same
 // thread, unlike CPUThreadExecutor which may schedule the callback on
 // another thread. Runs in a tight loop calling the queued callbacks,
@@ -51,5 +94,6 @@ class SingleThreadExecutor : public folly::Executor {
   AsyncFileReader& reader_;
   bool busy_;
 };
+#endif  // USE_STD_COROUTINES
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // USE_COROUTINES
@@ -24,6 +24,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -61,6 +62,8 @@ struct ThreadPoolImpl::Impl {
 
   void LowerCPUPriority(CpuPriority pri);
 
+  void EnableWorkStealing();
+
   void WakeUpAllThreads() {
     bgsignal_.notify_all();
   }
@@ -111,6 +114,7 @@ struct ThreadPoolImpl::Impl {
         std::min(std::max(num_waiting_threads_ - reserved_threads_, 0),
                  threads_to_be_reserved);
     reserved_threads_ += reserved_threads_in_success;
+    UpdateFastPathOk();
     return reserved_threads_in_success;
   }
 
@@ -120,6 +124,7 @@ struct ThreadPoolImpl::Impl {
     int released_threads_in_success =
         std::min(reserved_threads_, threads_to_be_released);
     reserved_threads_ -= released_threads_in_success;
+    UpdateFastPathOk();
     WakeUpAllThreads();
     return released_threads_in_success;
   }
@@ -127,8 +132,35 @@ struct ThreadPoolImpl::Impl {
 private:
  static void BGThreadWrapper(void* arg);
 
- bool low_io_priority_;
- CpuPriority cpu_priority_;
+ // True iff there is queued work anywhere: in the shared queue or, in
+ // work-stealing mode, in one of the shards. The seq_cst load pairs with
+ // the seq_cst increments of pending_jobs_ and waiting_threads_ so that a
+ // submitter and a thread about to sleep cannot miss each other.
+ bool HasWork() const {
+   return !queue_.empty() ||
+          pending_jobs_.load(std::memory_order_seq_cst) > 0;
+ }
+
+ // Lower the calling thread's kernel IO/CPU priority to the pool-wide
+ // setting if it has not been lowered yet. Called before running each
+ // job, with no locks held.
+ void ApplyThreadPriority(bool* low_io_priority,
+                          CpuPriority* current_cpu_priority);
+
+ // Recompute fast_path_ok_. The lock-free paths must stand down whenever
+ // the pool needs mutex-based coordination: shutdown, excessive threads
+ // to terminate, or an active thread reservation.
+ // REQUIRES: mu_ held
+ void UpdateFastPathOk() {
+   bool ok = work_stealing_.load(std::memory_order_relaxed) &&
+             !exit_all_threads_ && reserved_threads_ == 0 &&
+             total_threads_limit_ > 0 && !HasExcessiveThread() &&
+             bgthreads_.size() >= static_cast<size_t>(total_threads_limit_);
+   fast_path_ok_.store(ok, std::memory_order_release);
+ }
+
+ std::atomic<bool> low_io_priority_;
+ std::atomic<CpuPriority> cpu_priority_;
  Env::Priority priority_;
  Env* env_;
 
@@ -160,6 +192,39 @@ private:
   std::mutex               mu_;
   std::condition_variable  bgsignal_;
   std::vector<port::Thread> bgthreads_;
+
+  // Work-stealing mode (see EnableWorkStealing()). Thread i pushes to and
+  // pops from shards_[i % shards_.size()] under that shard's mutex alone,
+  // and scans the other shards when its own runs dry, so threads only meet
+  // on mu_ when they have nothing to do. shards_ is sized once when the
+  // mode is enabled and never resized, so the lock-free paths may index it
+  // without mu_.
+  struct Shard {
+    std::mutex mu;
+    BGQueue queue;
+  };
+
+  // Pop a job from the caller's own shard, or failing that steal one from
+  // the other shards. Only takes the per-shard mutexes; safe to call with
+  // or without mu_ held (shard mutexes always nest inside mu_). Returns
+  // false if every shard is empty. Work-stealing mode only.
+  bool TryTakeJob(size_t thread_id, BGItem* item);
+
+  // Set once under mu_, read lock-free afterwards.
+  std::atomic<bool> work_stealing_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // Round-robin cursor for spreading submissions over the shards.
+  std::atomic<uint64_t> next_shard_;
+  // Number of jobs sitting in the shards. Stands in for queue_.empty() in
+  // the sleep/exit conditions, which cannot cheaply inspect every shard.
+  std::atomic<int> pending_jobs_;
+  // Mirror of num_waiting_threads_ maintained at the two points where a
+  // thread actually starts and stops waiting on bgsignal_. Lets a
+  // fast-path submitter skip mu_ and the notify syscall entirely while
+  // every thread is busy.
+  std::atomic<int> waiting_threads_;
+  // True while the lock-free submit/take paths are allowed to run.
+  std::atomic<bool> fast_path_ok_;
 };
 
 inline ThreadPoolImpl::Impl::Impl()
@@ -176,7 +241,13 @@ inline ThreadPoolImpl::Impl::Impl()
       queue_(),
       mu_(),
       bgsignal_(),
-      bgthreads_() {}
+      bgthreads_(),
+      work_stealing_(false),
+      shards_(),
+      next_shard_(0),
+      pending_jobs_(0),
+      waiting_threads_(0),
+      fast_path_ok_(false) {}
 
 inline
 ThreadPoolImpl::Impl::~Impl() { assert(bgthreads_.size() == 0U); }
@@ -193,6 +264,7 @@ void ThreadPoolImpl::Impl::JoinThreads(bool wait_for_jobs_to_complete) {
   total_threads_limit_ = 0;
   reserved_threads_ = 0;
   num_waiting_threads_ = 0;
+  UpdateFastPathOk();
 
   lock.unlock();
 
@@ -219,16 +291,73 @@ inline void ThreadPoolImpl::Impl::LowerCPUPriority(CpuPriority pri) {
   cpu_priority_ = pri;
 }
 
+void ThreadPoolImpl::Impl::EnableWorkStealing() {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (work_stealing_.load(std::memory_order_relaxed) || exit_all_threads_) {
+    return;
+  }
+  // One shard per thread at the current size. Threads added later share
+  // shards via thread_id % shards_.size(), which keeps stealing correct
+  // at a small loss of locality, so the shard count is fixed for good.
+  size_t num_shards = static_cast<size_t>(std::max(total_threads_limit_, 1));
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.emplace_back(new Shard());
+  }
+  // Hand any jobs queued before the switch over to the shards so that
+  // there is a single source of work from here on.
+  while (!queue_.empty()) {
+    size_t idx = next_shard_.fetch_add(1, std::memory_order_relaxed) %
+                 shards_.size();
+    shards_[idx]->queue.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+    pending_jobs_.fetch_add(1, std::memory_order_seq_cst);
+  }
+  work_stealing_.store(true, std::memory_order_release);
+  UpdateFastPathOk();
+}
+
+bool ThreadPoolImpl::Impl::TryTakeJob(size_t thread_id, BGItem* item) {
+  const size_t num_shards = shards_.size();
+  for (size_t i = 0; i < num_shards; ++i) {
+    Shard& shard = *shards_[(thread_id + i) % num_shards];
+    std::lock_guard<std::mutex> shard_lock(shard.mu);
+    if (!shard.queue.empty()) {
+      *item = std::move(shard.queue.front());
+      shard.queue.pop_front();
+      pending_jobs_.fetch_sub(1, std::memory_order_seq_cst);
+      queue_len_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
 void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
   bool low_io_priority = false;
   CpuPriority current_cpu_priority = CpuPriority::kNormal;
 
   while (true) {
+    // Work-stealing fast path: while nothing needs pool-wide coordination
+    // (shutdown, excessive threads, reservations), take jobs straight from
+    // the shards without touching mu_ or the condition variable.
+    if (fast_path_ok_.load(std::memory_order_acquire)) {
+      BGItem item;
+      if (TryTakeJob(thread_id, &item)) {
+        ApplyThreadPriority(&low_io_priority, &current_cpu_priority);
+        TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::Impl::BGThread:BeforeRun",
+                                 &priority_);
+        item.function();
+        continue;
+      }
+    }
+
     // Wait until there is an item that is ready to run
     std::unique_lock<std::mutex> lock(mu_);
     // Stop waiting if the thread needs to do work or needs to terminate.
     // Increase num_waiting_threads_ once this task has started waiting
     num_waiting_threads_++;
+    waiting_threads_.fetch_add(1, std::memory_order_seq_cst);
 
     TEST_SYNC_POINT("ThreadPoolImpl::BGThread::WaitingThreadsInc");
     TEST_IDX_SYNC_POINT("ThreadPoolImpl::BGThread::Start:th", thread_id);
@@ -238,17 +367,18 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
     // 3) the number of waiting threads is not greater than reserved threads
     // (i.e, no available threads due to full reservation")
     while (!exit_all_threads_ && !IsLastExcessiveThread(thread_id) &&
-           (queue_.empty() || IsExcessiveThread(thread_id) ||
+           (!HasWork() || IsExcessiveThread(thread_id) ||
             num_waiting_threads_ <= reserved_threads_)) {
       bgsignal_.wait(lock);
     }
     // Decrease num_waiting_threads_ once the thread is not waiting
     num_waiting_threads_--;
+    waiting_threads_.fetch_sub(1, std::memory_order_seq_cst);
 
     if (exit_all_threads_) {  // mechanism to let BG threads exit safely
 
       if (!wait_for_jobs_to_complete_ ||
-          queue_.empty()) {
+          !HasWork()) {
         break;
        }
     } else if (IsLastExcessiveThread(thread_id)) {
@@ -260,6 +390,7 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
       auto& terminating_thread = bgthreads_.back();
       terminating_thread.detach();
       bgthreads_.pop_back();
+      UpdateFastPathOk();
       if (HasExcessiveThread()) {
         // There is still at least more excessive thread to terminate.
         WakeUpAllThreads();
@@ -270,54 +401,68 @@ void ThreadPoolImpl::Impl::BGThread(size_t thread_id) {
       break;
     }
 
-    auto func = std::move(queue_.front().function);
-    queue_.pop_front();
+    BGItem item;
+    if (!queue_.empty()) {
+      item = std::move(queue_.front());
+      queue_.pop_front();
+
+      queue_len_.store(static_cast<unsigned int>(queue_.size()),
+                       std::memory_order_relaxed);
+    } else if (!TryTakeJob(thread_id, &item)) {
+      // HasWork() held inside the wait loop, but a fast-path thread may
+      // have raced us to the last sharded job. Go back to waiting.
+      continue;
+    }
+    auto func = std::move(item.function);
+    lock.unlock();
 
-    queue_len_.store(static_cast<unsigned int>(queue_.size()),
-                     std::memory_order_relaxed);
+    ApplyThreadPriority(&low_io_priority, &current_cpu_priority);
 
-    bool decrease_io_priority = (low_io_priority != low_io_priority_);
-    CpuPriority cpu_priority = cpu_priority_;
-    lock.unlock();
+    TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::Impl::BGThread:BeforeRun",
+                             &priority_);
 
-    if (cpu_priority < current_cpu_priority) {
-      TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::BGThread::BeforeSetCpuPriority",
-                               &current_cpu_priority);
-      // 0 means current thread.
-      port::SetCpuPriority(0, cpu_priority);
-      current_cpu_priority = cpu_priority;
-      TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::BGThread::AfterSetCpuPriority",
-                               &current_cpu_priority);
-    }
+    func();
+  }
+}
+
+void ThreadPoolImpl::Impl::ApplyThreadPriority(
+    bool* low_io_priority, CpuPriority* current_cpu_priority) {
+  bool decrease_io_priority =
+      (*low_io_priority != low_io_priority_.load(std::memory_order_relaxed));
+  CpuPriority cpu_priority = cpu_priority_.load(std::memory_order_relaxed);
+
+  if (cpu_priority < *current_cpu_priority) {
+    TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::BGThread::BeforeSetCpuPriority",
+                             current_cpu_priority);
+    // 0 means current thread.
+    port::SetCpuPriority(0, cpu_priority);
+    *current_cpu_priority = cpu_priority;
+    TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::BGThread::AfterSetCpuPriority",
+                             current_cpu_priority);
+  }
 
 #ifdef OS_LINUX
-    if (decrease_io_priority) {
+  if (decrease_io_priority) {
 #define IOPRIO_CLASS_SHIFT (13)
 #define IOPRIO_PRIO_VALUE(class, data) (((class) << IOPRIO_CLASS_SHIFT) | data)
-      // Put schedule into IOPRIO_CLASS_IDLE class (lowest)
-      // These system calls only have an effect when used in conjunction
-      // with an I/O scheduler that supports I/O priorities. As at
-      // kernel 2.6.17 the only such scheduler is the Completely
-      // Fair Queuing (CFQ) I/O scheduler.
-      // To change scheduler:
-      //  echo cfq > /sys/block/<device_name>/queue/schedule
-      // Tunables to consider:
-      //  /sys/block/<device_name>/queue/slice_idle
-      //  /sys/block/<device_name>/queue/slice_sync
-      syscall(SYS_ioprio_set, 1,  // IOPRIO_WHO_PROCESS
-              0,                  // current thread
-              IOPRIO_PRIO_VALUE(3, 0));
-      low_io_priority = true;
-    }
+    // Put schedule into IOPRIO_CLASS_IDLE class (lowest)
+    // These system calls only have an effect when used in conjunction
+    // with an I/O scheduler that supports I/O priorities. As at
+    // kernel 2.6.17 the only such scheduler is the Completely
+    // Fair Queuing (CFQ) I/O scheduler.
+    // To change scheduler:
+    //  echo cfq > /sys/block/<device_name>/queue/schedule
+    // Tunables to consider:
+    //  /sys/block/<device_name>/queue/slice_idle
+    //  /sys/block/<device_name>/queue/slice_sync
+    syscall(SYS_ioprio_set, 1,  // IOPRIO_WHO_PROCESS
+            0,                  // current thread
+            IOPRIO_PRIO_VALUE(3, 0));
+    *low_io_priority = true;
+  }
 #else
-    (void)decrease_io_priority;  // avoid 'unused variable' error
+  (void)decrease_io_priority;  // avoid 'unused variable' error
 #endif
-
-    TEST_SYNC_POINT_CALLBACK("ThreadPoolImpl::Impl::BGThread:BeforeRun",
-                             &priority_);
-
-    func();
-  }
 }
 
 // Helper struct for passing arguments when creating threads.
@@ -404,11 +549,45 @@ void ThreadPoolImpl::Impl::StartBGThreads() {
 #endif
     bgthreads_.push_back(std::move(p_t));
   }
+  UpdateFastPathOk();
 }
 
 void ThreadPoolImpl::Impl::Submit(std::function<void()>&& schedule,
   std::function<void()>&& unschedule, void* tag) {
 
+  // Work-stealing fast path: push to a shard under its own mutex and only
+  // take mu_ to signal when some thread is actually asleep, so submission
+  // storms on a busy pool touch neither the pool mutex nor the kernel.
+  if (fast_path_ok_.load(std::memory_order_acquire)) {
+    BGItem item;
+    item.tag = tag;
+    item.function = std::move(schedule);
+    item.unschedFunction = std::move(unschedule);
+
+    size_t idx = next_shard_.fetch_add(1, std::memory_order_relaxed) %
+                 shards_.size();
+    {
+      std::lock_guard<std::mutex> shard_lock(shards_[idx]->mu);
+      TEST_SYNC_POINT("ThreadPoolImpl::Submit::Enqueue");
+      shards_[idx]->queue.push_back(std::move(item));
+    }
+    queue_len_.fetch_add(1, std::memory_order_relaxed);
+    pending_jobs_.fetch_add(1, std::memory_order_seq_cst);
+
+    // A thread announces itself in waiting_threads_ before re-checking
+    // HasWork() under mu_, so either it sees the job counted above or we
+    // see it here and wake it. If the pool raced into shutdown the job is
+    // simply discarded with the shards, as the locked path would have
+    // dropped it too.
+    if (waiting_threads_.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock(mu_);
+      if (!exit_all_threads_) {
+        bgsignal_.notify_one();
+      }
+    }
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(mu_);
 
   if (exit_all_threads_) {
@@ -417,16 +596,35 @@ void ThreadPoolImpl::Impl::Submit(std::function<void()>&& schedule,
 
   StartBGThreads();
 
-  // Add to priority queue
-  queue_.push_back(BGItem());
-  TEST_SYNC_POINT("ThreadPoolImpl::Submit::Enqueue");
-  auto& item = queue_.back();
-  item.tag = tag;
-  item.function = std::move(schedule);
-  item.unschedFunction = std::move(unschedule);
+  if (work_stealing_.load(std::memory_order_relaxed)) {
+    // Reservations or pending thread-count changes forced us off the fast
+    // path, but sharded jobs must still go to the shards.
+    BGItem item;
+    item.tag = tag;
+    item.function = std::move(schedule);
+    item.unschedFunction = std::move(unschedule);
+
+    size_t idx = next_shard_.fetch_add(1, std::memory_order_relaxed) %
+                 shards_.size();
+    {
+      std::lock_guard<std::mutex> shard_lock(shards_[idx]->mu);
+      TEST_SYNC_POINT("ThreadPoolImpl::Submit::Enqueue");
+      shards_[idx]->queue.push_back(std::move(item));
+    }
+    queue_len_.fetch_add(1, std::memory_order_relaxed);
+    pending_jobs_.fetch_add(1, std::memory_order_seq_cst);
+  } else {
+    // Add to priority queue
+    queue_.push_back(BGItem());
+    TEST_SYNC_POINT("ThreadPoolImpl::Submit::Enqueue");
+    auto& item = queue_.back();
+    item.tag = tag;
+    item.function = std::move(schedule);
+    item.unschedFunction = std::move(unschedule);
 
-  queue_len_.store(static_cast<unsigned int>(queue_.size()),
-    std::memory_order_relaxed);
+    queue_len_.store(static_cast<unsigned int>(queue_.size()),
+      std::memory_order_relaxed);
+  }
 
   if (!HasExcessiveThread()) {
     // Wake up at least one waiting thread.
@@ -442,26 +640,48 @@ int ThreadPoolImpl::Impl::UnSchedule(void* arg) {
   int count = 0;
 
   std::vector<std::function<void()>> candidates;
-  {
-    std::lock_guard<std::mutex> lock(mu_);
-
-    // Remove from priority queue
-    BGQueue::iterator it = queue_.begin();
-    while (it != queue_.end()) {
+  auto filter = [arg, &candidates](BGQueue* queue) {
+    int removed = 0;
+    BGQueue::iterator it = queue->begin();
+    while (it != queue->end()) {
       if (arg == (*it).tag) {
         if (it->unschedFunction) {
           candidates.push_back(std::move(it->unschedFunction));
         }
-        it = queue_.erase(it);
-        count++;
+        it = queue->erase(it);
+        removed++;
       } else {
         ++it;
       }
     }
-    queue_len_.store(static_cast<unsigned int>(queue_.size()),
-      std::memory_order_relaxed);
+    return removed;
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+
+    // Remove from priority queue
+    count += filter(&queue_);
+    if (!work_stealing_.load(std::memory_order_relaxed)) {
+      queue_len_.store(static_cast<unsigned int>(queue_.size()),
+        std::memory_order_relaxed);
+    }
   }
 
+  if (work_stealing_.load(std::memory_order_acquire)) {
+    // Matching jobs may sit in any shard. Each removal races benignly with
+    // consumers: under the shard mutex a job is either taken or removed,
+    // never both.
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> shard_lock(shard->mu);
+      int removed = filter(&shard->queue);
+      if (removed > 0) {
+        pending_jobs_.fetch_sub(removed, std::memory_order_seq_cst);
+        queue_len_.fetch_sub(removed, std::memory_order_relaxed);
+        count += removed;
+      }
+    }
+  }
 
  // Run unschedule functions outside the mutex
   for (auto& f : candidates) {
@@ -511,6 +731,10 @@ void ThreadPoolImpl::IncBackgroundThreadsIfNeeded(int num) {
   impl_->SetBackgroundThreadsInternal(num, false);
 }
 
+void ThreadPoolImpl::EnableWorkStealing() {
+  impl_->EnableWorkStealing();
+}
+
 void ThreadPoolImpl::SubmitJob(const std::function<void()>& job) {
   auto copy(job);
   impl_->Submit(std::move(copy), std::function<void()>(), nullptr);
@@ -57,6 +57,15 @@ class ThreadPoolImpl : public ThreadPool {
   // but do not kill threads if there are more
   void IncBackgroundThreadsIfNeeded(int num);
 
+  // Switch the pool into work-stealing mode: jobs are spread round-robin
+  // over per-thread queues and idle threads steal from their neighbours
+  // instead of contending on one pool-wide mutex, and SubmitJob() only
+  // signals the condition variable when a thread is actually sleeping.
+  // Best called after SetBackgroundThreads(); the mode is sticky and
+  // survives JoinAllThreads(). Behavior of Schedule()/UnSchedule() and
+  // thread reservations is unchanged.
+  void EnableWorkStealing();
+
   // Submit a fire and forget job
   // These jobs can not be unscheduled
 
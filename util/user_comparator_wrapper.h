@@ -22,7 +22,10 @@ class UserComparatorWrapper final : public Comparator {
   UserComparatorWrapper() : user_comparator_(nullptr) {}
 
   explicit UserComparatorWrapper(const Comparator* const user_cmp)
-      : Comparator(user_cmp->timestamp_size()), user_comparator_(user_cmp) {}
+      : Comparator(user_cmp->timestamp_size()),
+        user_comparator_(user_cmp),
+        is_forward_bytewise_(user_cmp == BytewiseComparator()),
+        is_reverse_bytewise_(user_cmp == ReverseBytewiseComparator()) {}
 
   ~UserComparatorWrapper() = default;
 
@@ -30,11 +33,23 @@ class UserComparatorWrapper final : public Comparator {
 
   int Compare(const Slice& a, const Slice& b) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    // Compare inline for the built-in bytewise comparators, which dominate
+    // in practice, instead of paying a virtual dispatch per comparison in
+    // the hottest iterator loops.
+    if (is_forward_bytewise_) {
+      return a.compare(b);
+    }
+    if (is_reverse_bytewise_) {
+      return b.compare(a);
+    }
     return user_comparator_->Compare(a, b);
   }
 
   bool Equal(const Slice& a, const Slice& b) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_forward_bytewise_ || is_reverse_bytewise_) {
+      return a == b;
+    }
     return user_comparator_->Equal(a, b);
   }
 
@@ -70,15 +85,31 @@ class UserComparatorWrapper final : public Comparator {
   int CompareWithoutTimestamp(const Slice& a, bool a_has_ts, const Slice& b,
                               bool b_has_ts) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    // The built-in bytewise comparators have no timestamp, so comparing
+    // without one is a plain comparison.
+    if (is_forward_bytewise_) {
+      return a.compare(b);
+    }
+    if (is_reverse_bytewise_) {
+      return b.compare(a);
+    }
     return user_comparator_->CompareWithoutTimestamp(a, a_has_ts, b, b_has_ts);
   }
 
   bool EqualWithoutTimestamp(const Slice& a, const Slice& b) const override {
+    if (is_forward_bytewise_ || is_reverse_bytewise_) {
+      return a == b;
+    }
     return user_comparator_->EqualWithoutTimestamp(a, b);
   }
 
  private:
   const Comparator* user_comparator_;
+  // Set when user_comparator_ is the BytewiseComparator() /
+  // ReverseBytewiseComparator() singleton, detected by pointer identity so
+  // a lookalike custom comparator never takes the inline path.
+  bool is_forward_bytewise_ = false;
+  bool is_reverse_bytewise_ = false;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,6 +9,13 @@
 
 #ifndef ROCKSDB_LITE
 
+#ifdef OS_LINUX
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <atomic>
 #include <cinttypes>
@@ -125,6 +132,8 @@ void BackupEngineOptions::Dump(Logger* logger) const {
                  restore_rate_limit);
   ROCKS_LOG_INFO(logger, "Options.max_background_operations: %d",
                  max_background_operations);
+  ROCKS_LOG_INFO(logger, "   Options.zero_copy_local_backup: %d",
+                 static_cast<int>(zero_copy_local_backup));
 }
 
 namespace {
@@ -584,6 +593,18 @@ class BackupEngineImpl {
                             uint64_t* bytes_toward_next_callback,
                             uint64_t* size, std::string* checksum_hex);
 
+  // Copy src to dst entirely in the kernel with copy_file_range(), falling
+  // back to sendfile() where the former is unsupported. Both files must be
+  // on the default POSIX file system. If the very first chunk cannot be
+  // copied this way (e.g. unsupported syscall or file system), sets
+  // *fallback to true and returns OK so the caller can use the buffered
+  // copy instead; errors after the first chunk are returned as-is.
+  IOStatus ZeroCopyLocalFile(const std::string& src, const std::string& dst,
+                             bool sync, RateLimiter* rate_limiter,
+                             const std::function<void()>& progress_callback,
+                             uint64_t* bytes_toward_next_callback,
+                             uint64_t* size, bool* fallback);
+
   IOStatus ReadFileAndComputeChecksum(const std::string& src,
                                       const std::shared_ptr<FileSystem>& src_fs,
                                       const EnvOptions& src_env_options,
@@ -1246,12 +1267,23 @@ IOStatus BackupEngineImpl::Initialize() {
 
         CopyOrCreateResult result;
         Temperature temp = work_item.src_temperature;
+        // With zero_copy_local_backup, a file whose crc32c is already known
+        // (from the shared_checksum naming pass or a previous backup) is not
+        // re-read for verification during the copy, which both skips the
+        // checksum pass and unlocks the kernel-side copy in
+        // CopyOrCreateFile().
+        const bool use_known_checksum = options_.zero_copy_local_backup &&
+                                        !work_item.src_checksum_hex.empty();
         result.io_status = CopyOrCreateFile(
             work_item.src_path, work_item.dst_path, work_item.contents,
             work_item.size_limit, work_item.src_env, work_item.dst_env,
             work_item.src_env_options, work_item.sync, work_item.rate_limiter,
             work_item.progress_callback, &temp, work_item.dst_temperature,
-            &bytes_toward_next_callback, &result.size, &result.checksum_hex);
+            &bytes_toward_next_callback, &result.size,
+            use_known_checksum ? nullptr : &result.checksum_hex);
+        if (use_known_checksum) {
+          result.checksum_hex = work_item.src_checksum_hex;
+        }
 
         RecordTick(work_item.stats, BACKUP_READ_BYTES,
                    IOSTATS(bytes_read) - prev_bytes_read);
@@ -1839,7 +1871,44 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
   std::unique_ptr<FSDirectory> db_dir_for_fsync;
   std::unique_ptr<FSDirectory> wal_dir_for_fsync;
 
+  // Restore in DB-opening priority order: metadata files (CURRENT,
+  // MANIFEST, OPTIONS) and WALs first, table and blob files after. With
+  // copies running on max_background_operations threads, this makes the
+  // files the DB needs to start recovery land earliest instead of being
+  // interleaved behind terabytes of table data.
+  std::vector<FileInfo*> restore_files;
+  restore_files.reserve(backup->GetFiles().size());
   for (const auto& file_info : backup->GetFiles()) {
+    restore_files.push_back(file_info.get());
+  }
+  auto restore_priority = [](FileInfo* file_info) -> int {
+    uint64_t number;
+    FileType type;
+    if (!ParseFileName(file_info->GetDbFileName(), &number, &type)) {
+      // Keep unparsable names early so the copy loop reports the
+      // corruption before spending time on data files.
+      return 0;
+    }
+    switch (type) {
+      case kCurrentFile:
+      case kDescriptorFile:
+      case kOptionsFile:
+        return 0;
+      case kWalFile:
+        return 1;
+      default:
+        return 2;
+    }
+  };
+  std::stable_sort(restore_files.begin(), restore_files.end(),
+                   [&restore_priority](FileInfo* lhs, FileInfo* rhs) {
+                     return restore_priority(lhs) < restore_priority(rhs);
+                   });
+
+  EnvOptions src_env_options;
+  src_env_options.use_direct_reads = options.use_direct_reads;
+
+  for (FileInfo* file_info : restore_files) {
     const std::string& file = file_info->filename;
     // 1. get DB filename
     std::string dst = file_info->GetDbFileName();
@@ -1886,9 +1955,8 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
     CopyOrCreateWorkItem copy_or_create_work_item(
         GetAbsolutePath(file), dst, Temperature::kUnknown /* src_temp */,
         file_info->temp, "" /* contents */, backup_env_, db_env_,
-        EnvOptions() /* src_env_options */, options_.sync,
-        options_.restore_rate_limiter.get(), file_info->size,
-        nullptr /* stats */);
+        src_env_options, options_.sync, options_.restore_rate_limiter.get(),
+        file_info->size, nullptr /* stats */);
     RestoreAfterCopyOrCreateWorkItem after_copy_or_create_work_item(
         copy_or_create_work_item.result.get_future(), file, dst,
         file_info->checksum_hex);
@@ -2040,6 +2108,26 @@ IOStatus BackupEngineImpl::CopyOrCreateFile(
   }
   uint32_t checksum_value = 0;
 
+  // Kernel-side zero-copy fast path for whole-file local copies whose
+  // checksum the caller already knows (checksum_hex == nullptr). Falls
+  // through to the buffered copy whenever the OS or file system declines.
+  if (options_.zero_copy_local_backup && !src.empty() &&
+      checksum_hex == nullptr && size_limit == 0 &&
+      dst_temperature == Temperature::kUnknown &&
+      src_env->GetFileSystem().get() == FileSystem::Default().get() &&
+      dst_env->GetFileSystem().get() == FileSystem::Default().get()) {
+    bool fallback = false;
+    io_s = ZeroCopyLocalFile(src, dst, sync, rate_limiter, progress_callback,
+                             bytes_toward_next_callback, size, &fallback);
+    if (!fallback) {
+      return io_s;
+    }
+    io_s = IOStatus::OK();
+    if (size != nullptr) {
+      *size = 0;
+    }
+  }
+
   // Check if size limit is set. if not, set it to very big number
   if (size_limit == 0) {
     size_limit = std::numeric_limits<uint64_t>::max();
@@ -2138,6 +2226,107 @@ IOStatus BackupEngineImpl::CopyOrCreateFile(
   return io_s;
 }
 
+IOStatus BackupEngineImpl::ZeroCopyLocalFile(
+    const std::string& src, const std::string& dst, bool sync,
+    RateLimiter* rate_limiter,
+    const std::function<void()>& progress_callback,
+    uint64_t* bytes_toward_next_callback, uint64_t* size, bool* fallback) {
+  *fallback = false;
+#ifdef OS_LINUX
+  int src_fd = open(src.c_str(), O_RDONLY | O_CLOEXEC);
+  if (src_fd < 0) {
+    *fallback = true;
+    return IOStatus::OK();
+  }
+  int dst_fd =
+      open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (dst_fd < 0) {
+    close(src_fd);
+    *fallback = true;
+    return IOStatus::OK();
+  }
+
+  const size_t chunk_size =
+      rate_limiter ? static_cast<size_t>(rate_limiter->GetSingleBurstBytes())
+                   : kDefaultCopyFileBufferSize;
+  IOStatus io_s;
+  bool use_sendfile = false;
+  bool first_chunk = true;
+  while (true) {
+    if (stop_backup_.load(std::memory_order_acquire)) {
+      io_s = status_to_io_status(Status::Incomplete("Backup stopped"));
+      break;
+    }
+    ssize_t copied;
+#ifdef __NR_copy_file_range
+    if (!use_sendfile) {
+      copied = syscall(__NR_copy_file_range, src_fd, nullptr, dst_fd, nullptr,
+                       chunk_size, 0u);
+    } else
+#else
+    use_sendfile = true;
+#endif
+    {
+      copied = sendfile(dst_fd, src_fd, nullptr, chunk_size);
+    }
+    if (copied < 0) {
+      if (first_chunk && !use_sendfile &&
+          (errno == ENOSYS || errno == EXDEV || errno == EINVAL ||
+           errno == EOPNOTSUPP || errno == EBADF)) {
+        // copy_file_range() unavailable; retry this chunk with sendfile().
+        use_sendfile = true;
+        continue;
+      }
+      if (first_chunk) {
+        // Nothing written yet; let the buffered copy recreate the file.
+        *fallback = true;
+        break;
+      }
+      io_s = IOStatus::IOError(dst, errnoStr(errno).c_str());
+      break;
+    }
+    first_chunk = false;
+    if (copied == 0) {
+      break;  // EOF
+    }
+    if (size != nullptr) {
+      *size += copied;
+    }
+    *bytes_toward_next_callback += copied;
+    if (rate_limiter != nullptr) {
+      LoopRateLimitRequestHelper(copied, rate_limiter, Env::IO_LOW,
+                                 nullptr /* stats */,
+                                 RateLimiter::OpType::kWrite);
+    }
+    while (*bytes_toward_next_callback >=
+           options_.callback_trigger_interval_size) {
+      *bytes_toward_next_callback -= options_.callback_trigger_interval_size;
+      std::lock_guard<std::mutex> lock(byte_report_mutex_);
+      progress_callback();
+    }
+  }
+
+  if (io_s.ok() && !*fallback && sync && fdatasync(dst_fd) != 0) {
+    io_s = IOStatus::IOError(dst, errnoStr(errno).c_str());
+  }
+  close(src_fd);
+  if (close(dst_fd) != 0 && io_s.ok() && !*fallback) {
+    io_s = IOStatus::IOError(dst, errnoStr(errno).c_str());
+  }
+  return io_s;
+#else
+  (void)src;
+  (void)dst;
+  (void)sync;
+  (void)rate_limiter;
+  (void)progress_callback;
+  (void)bytes_toward_next_callback;
+  (void)size;
+  *fallback = true;
+  return IOStatus::OK();
+#endif
+}
+
 // fname will always start with "/"
 IOStatus BackupEngineImpl::AddBackupFileWorkItem(
     std::unordered_set<std::string>& live_dst_paths,
@@ -1977,6 +1977,26 @@ TEST_F(BackupEngineTest, ShareTableFilesWithChecksums) {
   }
 }
 
+// Verify that you can backup and restore with zero_copy_local_backup set.
+// Where the kernel-side copy is unavailable (as with the wrapped test file
+// systems used here), the option must transparently fall back to the
+// buffered copy while still reusing already-known file checksums.
+TEST_F(BackupEngineTest, ZeroCopyLocalBackup) {
+  const int keys_iteration = 5000;
+  engine_options_->zero_copy_local_backup = true;
+  OpenDBAndBackupEngine(true, false, kShareWithChecksum);
+  for (int i = 0; i < 3; ++i) {
+    FillDB(db_.get(), keys_iteration * i, keys_iteration * (i + 1));
+    ASSERT_OK(backup_engine_->CreateNewBackup(db_.get(), !!(i % 2)));
+  }
+  CloseDBAndBackupEngine();
+
+  for (int i = 0; i < 3; ++i) {
+    AssertBackupConsistency(i + 1, 0, keys_iteration * (i + 1),
+                            keys_iteration * 4);
+  }
+}
+
 // Verify that you can backup and restore using share_files_with_checksum set to
 // false and then transition this option to true
 TEST_F(BackupEngineTest, ShareTableFilesWithChecksumsTransition) {
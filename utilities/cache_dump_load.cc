@@ -65,5 +65,50 @@ Status NewDefaultCacheDumpedLoader(
   return Status::OK();
 }
 
+namespace {
+Status SanitizeWarmthShippingOptions(CacheWarmthShippingOptions* options) {
+  if (options->warmth_file.empty()) {
+    return Status::InvalidArgument("warmth_file must be specified");
+  }
+  if (options->env == nullptr) {
+    options->env = Env::Default();
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status NewCacheWarmthExporter(const CacheWarmthShippingOptions& options,
+                              DB* db, const std::shared_ptr<Cache>& cache,
+                              std::unique_ptr<CacheWarmthExporter>* exporter) {
+  if (db == nullptr || cache == nullptr) {
+    return Status::InvalidArgument("db and cache must be specified");
+  }
+  CacheWarmthShippingOptions sanitized = options;
+  Status s = SanitizeWarmthShippingOptions(&sanitized);
+  if (!s.ok()) {
+    return s;
+  }
+  exporter->reset(new CacheWarmthExporterImpl(sanitized, db, cache));
+  return Status::OK();
+}
+
+Status NewCacheWarmthImporter(
+    const CacheWarmthShippingOptions& options,
+    const BlockBasedTableOptions& toptions,
+    const std::shared_ptr<SecondaryCache>& secondary_cache,
+    std::unique_ptr<CacheWarmthImporter>* importer) {
+  if (secondary_cache == nullptr) {
+    return Status::InvalidArgument("secondary_cache must be specified");
+  }
+  CacheWarmthShippingOptions sanitized = options;
+  Status s = SanitizeWarmthShippingOptions(&sanitized);
+  if (!s.ok()) {
+    return s;
+  }
+  importer->reset(
+      new CacheWarmthImporterImpl(sanitized, toptions, secondary_cache));
+  return Status::OK();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // ROCKSDB_LITE
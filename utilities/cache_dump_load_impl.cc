@@ -55,6 +55,17 @@ Status CacheDumperImpl::SetDumpFilter(std::vector<DB*> db_list) {
   return s;
 }
 
+// Record the keys a previous dump already wrote out, so the next dump only
+// contains the entries added to the cache since then.
+Status CacheDumperImpl::SetAlreadyDumpedKeys(std::set<std::string> keys) {
+  already_dumped_keys_ = std::move(keys);
+  return Status::OK();
+}
+
+std::set<std::string> CacheDumperImpl::GetDumpedKeys() const {
+  return dumped_keys_;
+}
+
 // This is the main function to dump out the cache block entries to the writer.
 // The writer may create a file or write to other systems. Currently, we will
 // iterate the whole block cache, get the blocks, and write them to the writer
@@ -75,6 +86,7 @@ IOStatus CacheDumperImpl::DumpCacheEntriesToWriter() {
   role_map_ = CopyCacheDeleterRoleMap();
   // Set the sequence number
   sequence_num_ = 0;
+  dumped_keys_.clear();
 
   // Dump stage, first, we write the hader
   IOStatus io_s = WriteHeader();
@@ -83,8 +95,31 @@ IOStatus CacheDumperImpl::DumpCacheEntriesToWriter() {
   }
 
   // Then, we iterate the block cache and dump out the blocks that are not
-  // filtered out.
-  cache_->ApplyToAllEntries(DumpOneBlockCallBack(), {});
+  // filtered out. With more than one worker thread, the cache walk only
+  // copies the blocks out; the workers encode and checksum them in
+  // parallel, and WriteRawBlock keeps the stream to the writer ordered.
+  if (options_.worker_threads > 1) {
+    WorkQueue<CopiedBlock*> work_queue(options_.worker_threads * 2);
+    std::vector<port::Thread> workers;
+    for (uint32_t i = 0; i < options_.worker_threads; i++) {
+      workers.emplace_back([&]() {
+        CopiedBlock* block = nullptr;
+        while (work_queue.pop(block)) {
+          WriteCacheBlock(block->type, Slice(block->key),
+                          (void*)block->value.data(), block->value.size())
+              .PermitUncheckedError();
+          delete block;
+        }
+      });
+    }
+    cache_->ApplyToAllEntries(DumpOneBlockCallBack(&work_queue), {});
+    work_queue.finish();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  } else {
+    cache_->ApplyToAllEntries(DumpOneBlockCallBack(nullptr), {});
+  }
 
   // Finally, write the footer
   io_s = WriteFooter();
@@ -103,7 +138,14 @@ bool CacheDumperImpl::ShouldFilterOut(const Slice& key) {
   Slice key_prefix(key.data(), OffsetableCacheKey::kCommonPrefixSize);
   std::string prefix = key_prefix.ToString();
   // Filter out if not found
-  return prefix_filter_.find(prefix) == prefix_filter_.end();
+  if (prefix_filter_.find(prefix) == prefix_filter_.end()) {
+    return /*filter out*/ true;
+  }
+  // Filter out the blocks a previous dump already contains, so the dump is
+  // incremental to it.
+  return !already_dumped_keys_.empty() &&
+         already_dumped_keys_.find(key.ToString()) !=
+             already_dumped_keys_.end();
 }
 
 // This is the callback function which will be applied to
@@ -111,9 +153,9 @@ bool CacheDumperImpl::ShouldFilterOut(const Slice& key) {
 // type, decide if the block needs to be dumped based on the filter, and write
 // the block through the provided writer.
 std::function<void(const Slice&, void*, size_t, Cache::DeleterFn)>
-CacheDumperImpl::DumpOneBlockCallBack() {
-  return [&](const Slice& key, void* value, size_t /*charge*/,
-             Cache::DeleterFn deleter) {
+CacheDumperImpl::DumpOneBlockCallBack(WorkQueue<CopiedBlock*>* work_queue) {
+  return [this, work_queue](const Slice& key, void* value, size_t /*charge*/,
+                            Cache::DeleterFn deleter) {
     // Step 1: get the type of the block from role_map_
     auto e = role_map_.find(deleter);
     CacheEntryRole role;
@@ -176,13 +218,25 @@ CacheDumperImpl::DumpOneBlockCallBack() {
     }
 
     // Step 4: if the block should not be filter out, write the block to the
-    // CacheDumpWriter
+    // CacheDumpWriter, or hand it to a dump worker thread when dumping in
+    // parallel.
     if (!filter_out && block_start != nullptr) {
-      char* buffer = new char[block_len];
-      memcpy(buffer, block_start, block_len);
-      WriteCacheBlock(type, key, (void*)buffer, block_len)
-          .PermitUncheckedError();
-      delete[] buffer;
+      dumped_keys_.insert(key.ToString());
+      if (work_queue != nullptr) {
+        CopiedBlock* block = new CopiedBlock;
+        block->type = type;
+        block->key = key.ToString();
+        block->value.assign(block_start, block_len);
+        if (!work_queue->push(block)) {
+          delete block;
+        }
+      } else {
+        char* buffer = new char[block_len];
+        memcpy(buffer, block_start, block_len);
+        WriteCacheBlock(type, key, (void*)buffer, block_len)
+            .PermitUncheckedError();
+        delete[] buffer;
+      }
     }
   };
 }
@@ -212,11 +266,16 @@ IOStatus CacheDumperImpl::WriteRawBlock(uint64_t timestamp,
   // unit string checksum and the string size. The sequence number monotonically
   // increases from 0.
   DumpUnitMeta unit_meta;
-  unit_meta.sequence_num = sequence_num_;
-  sequence_num_++;
   unit_meta.dump_unit_checksum =
       crc32c::Value(encoded_data.c_str(), encoded_data.size());
   unit_meta.dump_unit_size = static_cast<uint64_t>(encoded_data.size());
+
+  // The sequence number is assigned and the (metadata, dump unit) pair is
+  // written under the writer mutex, so dump worker threads emit their units
+  // interleaved but each unit intact and numbered in write order.
+  MutexLock l(&writer_mutex_);
+  unit_meta.sequence_num = sequence_num_;
+  sequence_num_++;
   std::string encoded_meta;
   CacheDumperHelper::EncodeDumpUnitMeta(unit_meta, &encoded_meta);
 
@@ -279,8 +338,6 @@ IOStatus CacheDumperImpl::WriteFooter() {
 // First, we check if all the arguments are valid. Then, we read the block
 // sequentially from the reader and insert them to the secondary cache.
 IOStatus CacheDumpedLoaderImpl::RestoreCacheEntriesToSecondaryCache() {
-  // TODO: remove this line when options are used in the loader
-  (void)options_;
   // Step 1: we check if all the arguments are valid
   if (secondary_cache_ == nullptr) {
     return IOStatus::InvalidArgument("Secondary Cache is null");
@@ -302,6 +359,12 @@ IOStatus CacheDumpedLoaderImpl::RestoreCacheEntriesToSecondaryCache() {
     return io_s;
   }
 
+  // With more than one worker thread, reading stays sequential but the
+  // checksum verification, block creation, and inserts are parallelized.
+  if (options_.worker_threads > 1) {
+    return RestoreWithWorkers();
+  }
+
   // Step 3: read out the rest of the blocks from the reader. The loop will stop
   // either I/O status is not ok or we reach to the the end.
   while (io_s.ok() && dump_unit.type != CacheDumpUnitType::kFooter) {
@@ -312,82 +375,168 @@ IOStatus CacheDumpedLoaderImpl::RestoreCacheEntriesToSecondaryCache() {
     if (!io_s.ok()) {
       break;
     }
-    // create the raw_block_content based on the information in the dump_unit
-    BlockContents raw_block_contents(
-        Slice((char*)dump_unit.value, dump_unit.value_len));
-    Cache::CacheItemHelper* helper = nullptr;
-    Statistics* statistics = nullptr;
-    Status s = Status::OK();
-    // according to the block type, get the helper callback function and create
-    // the corresponding block
-    switch (dump_unit.type) {
-      case CacheDumpUnitType::kFilter: {
-        helper = BlocklikeTraits<ParsedFullFilterBlock>::GetCacheItemHelper(
-            BlockType::kFilter);
-        std::unique_ptr<ParsedFullFilterBlock> block_holder;
-        block_holder.reset(BlocklikeTraits<ParsedFullFilterBlock>::Create(
-            std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
-            statistics, false, toptions_.filter_policy.get()));
-        if (helper != nullptr) {
-          s = secondary_cache_->Insert(dump_unit.key,
-                                       (void*)(block_holder.get()), helper);
-        }
-        break;
+    Status s = InsertDumpUnit(dump_unit);
+    if (!s.ok()) {
+      io_s = status_to_io_status(std::move(s));
+    }
+  }
+  if (dump_unit.type == CacheDumpUnitType::kFooter) {
+    return IOStatus::OK();
+  } else {
+    return io_s;
+  }
+}
+
+// According to the block type, get the helper callback function, create the
+// corresponding block, and insert it to the secondary cache.
+Status CacheDumpedLoaderImpl::InsertDumpUnit(const DumpUnit& dump_unit) {
+  // create the raw_block_content based on the information in the dump_unit
+  BlockContents raw_block_contents(
+      Slice((char*)dump_unit.value, dump_unit.value_len));
+  Cache::CacheItemHelper* helper = nullptr;
+  Statistics* statistics = nullptr;
+  Status s = Status::OK();
+  switch (dump_unit.type) {
+    case CacheDumpUnitType::kFilter: {
+      helper = BlocklikeTraits<ParsedFullFilterBlock>::GetCacheItemHelper(
+          BlockType::kFilter);
+      std::unique_ptr<ParsedFullFilterBlock> block_holder;
+      block_holder.reset(BlocklikeTraits<ParsedFullFilterBlock>::Create(
+          std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
+          statistics, false, toptions_.filter_policy.get()));
+      if (helper != nullptr) {
+        s = secondary_cache_->Insert(dump_unit.key,
+                                     (void*)(block_holder.get()), helper);
       }
-      case CacheDumpUnitType::kData: {
-        helper = BlocklikeTraits<Block>::GetCacheItemHelper(BlockType::kData);
-        std::unique_ptr<Block> block_holder;
-        block_holder.reset(BlocklikeTraits<Block>::Create(
-            std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
-            statistics, false, toptions_.filter_policy.get()));
-        if (helper != nullptr) {
-          s = secondary_cache_->Insert(dump_unit.key,
-                                       (void*)(block_holder.get()), helper);
-        }
-        break;
+      break;
+    }
+    case CacheDumpUnitType::kData: {
+      helper = BlocklikeTraits<Block>::GetCacheItemHelper(BlockType::kData);
+      std::unique_ptr<Block> block_holder;
+      block_holder.reset(BlocklikeTraits<Block>::Create(
+          std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
+          statistics, false, toptions_.filter_policy.get()));
+      if (helper != nullptr) {
+        s = secondary_cache_->Insert(dump_unit.key,
+                                     (void*)(block_holder.get()), helper);
       }
-      case CacheDumpUnitType::kIndex: {
-        helper = BlocklikeTraits<Block>::GetCacheItemHelper(BlockType::kIndex);
-        std::unique_ptr<Block> block_holder;
-        block_holder.reset(BlocklikeTraits<Block>::Create(
-            std::move(raw_block_contents), 0, statistics, false,
-            toptions_.filter_policy.get()));
-        if (helper != nullptr) {
-          s = secondary_cache_->Insert(dump_unit.key,
-                                       (void*)(block_holder.get()), helper);
-        }
-        break;
+      break;
+    }
+    case CacheDumpUnitType::kIndex: {
+      helper = BlocklikeTraits<Block>::GetCacheItemHelper(BlockType::kIndex);
+      std::unique_ptr<Block> block_holder;
+      block_holder.reset(BlocklikeTraits<Block>::Create(
+          std::move(raw_block_contents), 0, statistics, false,
+          toptions_.filter_policy.get()));
+      if (helper != nullptr) {
+        s = secondary_cache_->Insert(dump_unit.key,
+                                     (void*)(block_holder.get()), helper);
       }
-      case CacheDumpUnitType::kFilterMetaBlock: {
-        helper = BlocklikeTraits<Block>::GetCacheItemHelper(
-            BlockType::kFilterPartitionIndex);
-        std::unique_ptr<Block> block_holder;
-        block_holder.reset(BlocklikeTraits<Block>::Create(
-            std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
-            statistics, false, toptions_.filter_policy.get()));
-        if (helper != nullptr) {
-          s = secondary_cache_->Insert(dump_unit.key,
-                                       (void*)(block_holder.get()), helper);
+      break;
+    }
+    case CacheDumpUnitType::kFilterMetaBlock: {
+      helper = BlocklikeTraits<Block>::GetCacheItemHelper(
+          BlockType::kFilterPartitionIndex);
+      std::unique_ptr<Block> block_holder;
+      block_holder.reset(BlocklikeTraits<Block>::Create(
+          std::move(raw_block_contents), toptions_.read_amp_bytes_per_bit,
+          statistics, false, toptions_.filter_policy.get()));
+      if (helper != nullptr) {
+        s = secondary_cache_->Insert(dump_unit.key,
+                                     (void*)(block_holder.get()), helper);
+      }
+      break;
+    }
+    case CacheDumpUnitType::kFooter:
+      break;
+    case CacheDumpUnitType::kDeprecatedFilterBlock:
+      // Obsolete
+      break;
+    default:
+      break;
+  }
+  return s;
+}
+
+// The reader thread reads the (metadata, dump unit) pairs in order and
+// hands each raw unit to a worker thread, which verifies its checksum,
+// decodes it, and inserts the block to the secondary cache. The first
+// failure of any worker fails the restore, like in the serial path.
+IOStatus CacheDumpedLoaderImpl::RestoreWithWorkers() {
+  WorkQueue<LoadedPacket*> work_queue(options_.worker_threads * 2);
+  port::Mutex error_mutex;
+  IOStatus worker_io_s;
+  std::vector<port::Thread> workers;
+  for (uint32_t i = 0; i < options_.worker_threads; i++) {
+    workers.emplace_back([&]() {
+      LoadedPacket* packet = nullptr;
+      while (work_queue.pop(packet)) {
+        IOStatus unit_io_s;
+        uint32_t unit_checksum =
+            crc32c::Value(packet->data.c_str(), packet->data.size());
+        if (unit_checksum != packet->expected_checksum) {
+          unit_io_s = IOStatus::Corruption(
+              "Checksum does not match! Read dumped unit corrupted!");
+        } else {
+          DumpUnit dump_unit;
+          Status s = CacheDumperHelper::DecodeDumpUnit(packet->data,
+                                                       &dump_unit);
+          if (s.ok()) {
+            s = InsertDumpUnit(dump_unit);
+          }
+          if (!s.ok()) {
+            unit_io_s = status_to_io_status(std::move(s));
+          }
         }
-        break;
+        if (!unit_io_s.ok()) {
+          MutexLock l(&error_mutex);
+          if (worker_io_s.ok()) {
+            worker_io_s = unit_io_s;
+          }
+        }
+        delete packet;
       }
-      case CacheDumpUnitType::kFooter:
-        break;
-      case CacheDumpUnitType::kDeprecatedFilterBlock:
-        // Obsolete
-        break;
-      default:
-        continue;
+    });
+  }
+
+  IOStatus io_s;
+  bool reached_footer = false;
+  while (io_s.ok() && !reached_footer) {
+    DumpUnitMeta unit_meta;
+    unit_meta.reset();
+    std::string meta_string;
+    io_s = ReadDumpUnitMeta(&meta_string, &unit_meta);
+    if (!io_s.ok()) {
+      break;
     }
-    if (!s.ok()) {
-      io_s = status_to_io_status(std::move(s));
+    LoadedPacket* packet = new LoadedPacket;
+    packet->expected_checksum = unit_meta.dump_unit_checksum;
+    // The decode here is only to spot the footer; the worker re-decodes
+    // after it has verified the checksum.
+    DumpUnit dump_unit;
+    io_s = ReadDumpUnit(unit_meta.dump_unit_size, &packet->data, &dump_unit);
+    if (!io_s.ok() || dump_unit.type == CacheDumpUnitType::kFooter) {
+      reached_footer = io_s.ok();
+      delete packet;
+      break;
+    }
+    if (!work_queue.push(packet)) {
+      delete packet;
+      break;
     }
   }
-  if (dump_unit.type == CacheDumpUnitType::kFooter) {
+  work_queue.finish();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (!worker_io_s.ok()) {
+    return worker_io_s;
+  }
+  if (reached_footer) {
     return IOStatus::OK();
-  } else {
-    return io_s;
   }
+  return io_s;
 }
 
 // Read and copy the dump unit metadata to std::string data, decode and create
@@ -446,6 +595,134 @@ IOStatus CacheDumpedLoaderImpl::ReadHeader(std::string* data,
   return io_s;
 }
 
+Status CacheWarmthExporterImpl::Start() {
+  MutexLock l(&mutex_);
+  if (started_) {
+    return Status::OK();
+  }
+  timer_.Start();
+  if (!timer_.Add([this]() { ShipOnce(); }, "cache_warmth_export",
+                  0 /* start_after_us */,
+                  options_.shipping_interval_seconds * 1000U * 1000U)) {
+    return Status::Aborted("Failed to schedule cache warmth export");
+  }
+  started_ = true;
+  return Status::OK();
+}
+
+Status CacheWarmthExporterImpl::Stop() {
+  {
+    MutexLock l(&mutex_);
+    if (!started_) {
+      return Status::OK();
+    }
+    started_ = false;
+  }
+  // Shutdown waits for an in-flight ShipOnce, which takes mutex_ to
+  // record its status, so mutex_ must not be held here.
+  timer_.Shutdown();
+  return Status::OK();
+}
+
+// Dump the blocks of db_ currently in cache_ to a temporary file and
+// publish it by renaming it over warmth_file, so importers never read a
+// dump that is still being written. A failed cycle is recorded in
+// last_status_ and retried at the next interval.
+void CacheWarmthExporterImpl::ShipOnce() {
+  const std::string tmp_file = options_.warmth_file + ".tmp";
+  const std::shared_ptr<FileSystem>& fs = options_.env->GetFileSystem();
+
+  std::unique_ptr<CacheDumpWriter> writer;
+  Status s = NewToFileCacheDumpWriter(fs, FileOptions(), tmp_file, &writer);
+  if (s.ok()) {
+    CacheDumpOptions dump_options;
+    dump_options.clock = options_.env->GetSystemClock().get();
+    dump_options.worker_threads = options_.worker_threads;
+    std::unique_ptr<CacheDumper> dumper;
+    s = NewDefaultCacheDumper(dump_options, cache_, std::move(writer),
+                              &dumper);
+    if (s.ok()) {
+      s = dumper->SetDumpFilter({db_});
+    }
+    if (s.ok()) {
+      s = dumper->DumpCacheEntriesToWriter();
+    }
+  }
+  if (s.ok()) {
+    s = fs->RenameFile(tmp_file, options_.warmth_file, IOOptions(), nullptr);
+  }
+
+  MutexLock l(&mutex_);
+  last_status_ = s;
+}
+
+Status CacheWarmthImporterImpl::Start() {
+  MutexLock l(&mutex_);
+  if (started_) {
+    return Status::OK();
+  }
+  timer_.Start();
+  if (!timer_.Add([this]() { PollOnce(); }, "cache_warmth_import",
+                  0 /* start_after_us */,
+                  options_.shipping_interval_seconds * 1000U * 1000U)) {
+    return Status::Aborted("Failed to schedule cache warmth import");
+  }
+  started_ = true;
+  return Status::OK();
+}
+
+Status CacheWarmthImporterImpl::Stop() {
+  {
+    MutexLock l(&mutex_);
+    if (!started_) {
+      return Status::OK();
+    }
+    started_ = false;
+  }
+  // Shutdown waits for an in-flight PollOnce, which takes mutex_ to
+  // record its status, so mutex_ must not be held here.
+  timer_.Shutdown();
+  return Status::OK();
+}
+
+// Check whether the primary has published a new dump and, if so, load
+// its blocks into the secondary cache. A dump is "new" when the file's
+// modification time differs from the last successfully loaded one;
+// re-inserting blocks the cache already holds is harmless, so the coarse
+// mtime comparison errs on the side of loading.
+void CacheWarmthImporterImpl::PollOnce() {
+  uint64_t mtime = 0;
+  Status s = options_.env->GetFileModificationTime(options_.warmth_file,
+                                                   &mtime);
+  if (s.ok() && mtime == last_loaded_mtime_) {
+    return;  // Nothing new; keep the previous status.
+  }
+  if (s.ok()) {
+    std::unique_ptr<CacheDumpReader> reader;
+    s = NewFromFileCacheDumpReader(options_.env->GetFileSystem(),
+                                   FileOptions(), options_.warmth_file,
+                                   &reader);
+    if (s.ok()) {
+      CacheDumpOptions dump_options;
+      dump_options.clock = options_.env->GetSystemClock().get();
+      dump_options.worker_threads = options_.worker_threads;
+      std::unique_ptr<CacheDumpedLoader> loader;
+      s = NewDefaultCacheDumpedLoader(dump_options, toptions_,
+                                      secondary_cache_, std::move(reader),
+                                      &loader);
+      if (s.ok()) {
+        s = loader->RestoreCacheEntriesToSecondaryCache();
+      }
+    }
+    if (s.ok()) {
+      last_loaded_mtime_ = mtime;
+    }
+  }
+
+  MutexLock l(&mutex_);
+  last_status_ = s;
+}
+
 // Read the blocks after header is read out
 IOStatus CacheDumpedLoaderImpl::ReadCacheBlock(std::string* data,
                                                DumpUnit* dump_unit) {
@@ -10,7 +10,11 @@
 
 #include "file/random_access_file_reader.h"
 #include "file/writable_file_writer.h"
+#include "rocksdb/system_clock.h"
 #include "rocksdb/utilities/cache_dump_load.h"
+#include "util/mutexlock.h"
+#include "util/timer.h"
+#include "util/work_queue.h"
 #include "table/block_based/block.h"
 #include "table/block_based/block_like_traits.h"
 #include "table/block_based/block_type.h"
@@ -21,7 +25,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 // the read buffer size of for the default CacheDumpReader
-const unsigned int kDumpReaderBufferSize = 1024;  // 1KB
+const unsigned int kDumpReaderBufferSize = 1024 * 1024;  // 1MB
 static const unsigned int kSizePrefixLen = 4;
 
 enum CacheDumpUnitType : unsigned char {
@@ -91,6 +95,21 @@ struct DumpUnit {
   }
 };
 
+// A block copied out of the block cache, waiting to be encoded,
+// checksummed, and written by a dump worker thread.
+struct CopiedBlock {
+  CacheDumpUnitType type;
+  std::string key;
+  std::string value;
+};
+
+// A dump unit read out by the reader thread, waiting for checksum
+// verification, decoding, and insertion by a load worker thread.
+struct LoadedPacket {
+  uint32_t expected_checksum;
+  std::string data;
+};
+
 // The default implementation of the Cache Dumper
 class CacheDumperImpl : public CacheDumper {
  public:
@@ -100,6 +119,8 @@ class CacheDumperImpl : public CacheDumper {
       : options_(dump_options), cache_(cache), writer_(std::move(writer)) {}
   ~CacheDumperImpl() { writer_.reset(); }
   Status SetDumpFilter(std::vector<DB*> db_list) override;
+  Status SetAlreadyDumpedKeys(std::set<std::string> keys) override;
+  std::set<std::string> GetDumpedKeys() const override;
   IOStatus DumpCacheEntriesToWriter() override;
 
  private:
@@ -113,20 +134,31 @@ class CacheDumperImpl : public CacheDumper {
                            void* value, size_t len);
   IOStatus WriteFooter();
   bool ShouldFilterOut(const Slice& key);
+  // If work_queue is not nullptr, the callback enqueues the copied blocks
+  // for the dump worker threads instead of writing them inline.
   std::function<void(const Slice&, void*, size_t, Cache::DeleterFn)>
-  DumpOneBlockCallBack();
+  DumpOneBlockCallBack(WorkQueue<CopiedBlock*>* work_queue);
 
   CacheDumpOptions options_;
   std::shared_ptr<Cache> cache_;
   std::unique_ptr<CacheDumpWriter> writer_;
   UnorderedMap<Cache::DeleterFn, CacheEntryRole> role_map_;
   SystemClock* clock_;
+  // Serializes the (metadata, packet) pairs emitted to writer_ and guards
+  // sequence_num_ when worker threads dump in parallel.
+  port::Mutex writer_mutex_;
   uint32_t sequence_num_;
   // The cache key prefix filter. Currently, we use db_session_id as the prefix,
   // so using std::set to store the prefixes as filter is enough. Further
   // improvement can be applied like BloomFilter or others to speedup the
   // filtering.
   std::set<std::string> prefix_filter_;
+  // Keys to skip because a previous dump already contains them; see
+  // CacheDumper::SetAlreadyDumpedKeys.
+  std::set<std::string> already_dumped_keys_;
+  // Keys written by the last DumpCacheEntriesToWriter call. Only touched
+  // by the thread walking the cache.
+  std::set<std::string> dumped_keys_;
 };
 
 // The default implementation of CacheDumpedLoader
@@ -148,6 +180,13 @@ class CacheDumpedLoaderImpl : public CacheDumpedLoader {
   IOStatus ReadDumpUnit(size_t len, std::string* data, DumpUnit* unit);
   IOStatus ReadHeader(std::string* data, DumpUnit* dump_unit);
   IOStatus ReadCacheBlock(std::string* data, DumpUnit* dump_unit);
+  // Reconstruct the block held in dump_unit and insert it to the secondary
+  // cache. Units that do not carry a block (footer etc.) are a no-op.
+  Status InsertDumpUnit(const DumpUnit& dump_unit);
+  // The multi-threaded restore path: one thread keeps reading the dump
+  // units in order while options_.worker_threads workers verify, decode,
+  // and insert them.
+  IOStatus RestoreWithWorkers();
 
   CacheDumpOptions options_;
   const BlockBasedTableOptions& toptions_;
@@ -362,5 +401,79 @@ class CacheDumperHelper {
   }
 };
 
+// The default implementation of CacheWarmthExporter. A Timer task dumps
+// the primary's block cache to "<warmth_file>.tmp" every interval and
+// renames it over warmth_file, so importers only ever see complete dumps.
+class CacheWarmthExporterImpl : public CacheWarmthExporter {
+ public:
+  // REQUIRES: options.env != nullptr and options.warmth_file non-empty
+  // (sanitized/validated by NewCacheWarmthExporter).
+  CacheWarmthExporterImpl(const CacheWarmthShippingOptions& options, DB* db,
+                          const std::shared_ptr<Cache>& cache)
+      : options_(options),
+        db_(db),
+        cache_(cache),
+        timer_(options_.env->GetSystemClock().get()) {}
+  ~CacheWarmthExporterImpl() override { Stop().PermitUncheckedError(); }
+  Status Start() override;
+  Status Stop() override;
+  Status LastStatus() override {
+    MutexLock l(&mutex_);
+    return last_status_;
+  }
+
+ private:
+  // The periodic task: one full dump-and-publish cycle.
+  void ShipOnce();
+
+  CacheWarmthShippingOptions options_;
+  DB* db_;
+  std::shared_ptr<Cache> cache_;
+  Timer timer_;
+  port::Mutex mutex_;
+  bool started_ = false;        // guarded by mutex_
+  Status last_status_;          // guarded by mutex_
+};
+
+// The default implementation of CacheWarmthImporter. A Timer task polls
+// warmth_file's modification time and loads each newly published dump
+// into the secondary cache.
+class CacheWarmthImporterImpl : public CacheWarmthImporter {
+ public:
+  // REQUIRES: options.env != nullptr and options.warmth_file non-empty
+  // (sanitized/validated by NewCacheWarmthImporter).
+  CacheWarmthImporterImpl(
+      const CacheWarmthShippingOptions& options,
+      const BlockBasedTableOptions& toptions,
+      const std::shared_ptr<SecondaryCache>& secondary_cache)
+      : options_(options),
+        toptions_(toptions),
+        secondary_cache_(secondary_cache),
+        timer_(options_.env->GetSystemClock().get()) {}
+  ~CacheWarmthImporterImpl() override { Stop().PermitUncheckedError(); }
+  Status Start() override;
+  Status Stop() override;
+  Status LastStatus() override {
+    MutexLock l(&mutex_);
+    return last_status_;
+  }
+
+ private:
+  // The periodic task: check for a new dump and load it if present.
+  void PollOnce();
+
+  CacheWarmthShippingOptions options_;
+  // Owned copy; CacheDumpedLoaderImpl keeps a reference to it.
+  BlockBasedTableOptions toptions_;
+  std::shared_ptr<SecondaryCache> secondary_cache_;
+  Timer timer_;
+  // Modification time of the last successfully loaded dump. Only touched
+  // by the timer task.
+  uint64_t last_loaded_mtime_ = 0;
+  port::Mutex mutex_;
+  bool started_ = false;        // guarded by mutex_
+  Status last_status_;          // guarded by mutex_
+};
+
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // ROCKSDB_LITE
@@ -12,6 +12,7 @@
 #include "utilities/checkpoint/checkpoint_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <string>
 #include <tuple>
@@ -47,6 +48,12 @@ Status Checkpoint::CreateCheckpoint(const std::string& /*checkpoint_dir*/,
   return Status::NotSupported("");
 }
 
+Status Checkpoint::RefreshCheckpoint(const std::string& /*checkpoint_dir*/,
+                                     uint64_t /*log_size_for_flush*/,
+                                     uint64_t* /*sequence_number_ptr*/) {
+  return Status::NotSupported("");
+}
+
 void CheckpointImpl::CleanStagingDirectory(const std::string& full_private_path,
                                            Logger* info_log) {
   std::vector<std::string> subchildren;
@@ -77,6 +84,13 @@ Status Checkpoint::ExportColumnFamily(
   return Status::NotSupported("");
 }
 
+Status Checkpoint::ExportColumnFamily(
+    ColumnFamilyHandle* /*handle*/, const std::string& /*export_dir*/,
+    ExportImportFilesMetaData** /*metadata*/,
+    const ExportColumnFamilyOptions& /*options*/) {
+  return Status::NotSupported("");
+}
+
 // Builds an openable snapshot of RocksDB
 Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
                                         uint64_t log_size_for_flush,
@@ -188,6 +202,167 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
   return s;
 }
 
+// Brings an existing checkpoint directory up to date with the current DB
+// state; see Checkpoint::RefreshCheckpoint().
+Status CheckpointImpl::RefreshCheckpoint(const std::string& checkpoint_dir,
+                                         uint64_t log_size_for_flush,
+                                         uint64_t* sequence_number_ptr) {
+  DBOptions db_options = db_->GetDBOptions();
+
+  Status s = db_->GetEnv()->FileExists(checkpoint_dir + "/CURRENT");
+  if (s.IsNotFound()) {
+    return Status::InvalidArgument(
+        "Directory does not contain a checkpoint to refresh");
+  } else if (!s.ok()) {
+    return s;
+  }
+
+  ROCKS_LOG_INFO(db_options.info_log,
+                 "Started refreshing checkpoint in directory %s",
+                 checkpoint_dir.c_str());
+
+  std::vector<std::string> previous_files;
+  s = db_->GetEnv()->GetChildren(checkpoint_dir, &previous_files);
+  if (!s.ok()) {
+    return s;
+  }
+  std::unordered_set<std::string> previous_data_files;
+  for (const auto& fname : previous_files) {
+    uint64_t number;
+    FileType type;
+    if (ParseFileName(fname, &number, &type) &&
+        (type == kTableFile || type == kBlobFile)) {
+      previous_data_files.insert(fname);
+    }
+  }
+
+  // Every file the refreshed checkpoint consists of; everything else in the
+  // directory is removed once the new CURRENT file is durable.
+  std::unordered_set<std::string> current_files;
+  uint64_t sequence_number = 0;
+  uint64_t num_linked = 0;
+  s = db_->DisableFileDeletions();
+  const bool disabled_file_deletions = s.ok();
+  if (s.ok() || s.IsNotSupported()) {
+    s = CreateCustomCheckpoint(
+        [&](const std::string& src_dirname, const std::string& fname,
+            FileType type) -> Status {
+          current_files.insert(fname);
+          if ((type == kTableFile || type == kBlobFile) &&
+              previous_data_files.find(fname) != previous_data_files.end()) {
+            // Table and blob files are immutable, so a file that is already
+            // in the checkpoint does not need to be linked again.
+            return Status::OK();
+          }
+          ROCKS_LOG_INFO(db_options.info_log, "Hard Linking %s",
+                         fname.c_str());
+          ++num_linked;
+          return db_->GetFileSystem()->LinkFile(src_dirname + "/" + fname,
+                                                checkpoint_dir + "/" + fname,
+                                                IOOptions(), nullptr);
+        } /* link_file_cb */,
+        [&](const std::string& src_dirname, const std::string& fname,
+            uint64_t size_limit_bytes, FileType,
+            const std::string& /* checksum_func_name */,
+            const std::string& /* checksum_val */,
+            const Temperature temperature) -> Status {
+          // Copied files (MANIFEST, WALs) change between refreshes and can
+          // collide with names kept from the previous checkpoint, so stage
+          // the copy and rename it into place.
+          current_files.insert(fname);
+          ROCKS_LOG_INFO(db_options.info_log, "Copying %s", fname.c_str());
+          const std::string staged = checkpoint_dir + "/" + fname + ".tmp";
+          Status copy_s = CopyFile(db_->GetFileSystem(),
+                                   src_dirname + "/" + fname, staged,
+                                   size_limit_bytes, db_options.use_fsync,
+                                   nullptr, temperature);
+          if (copy_s.ok()) {
+            copy_s = db_->GetEnv()->RenameFile(staged,
+                                               checkpoint_dir + "/" + fname);
+          }
+          return copy_s;
+        } /* copy_file_cb */,
+        [&](const std::string& fname, const std::string& contents,
+            FileType) -> Status {
+          current_files.insert(fname);
+          ROCKS_LOG_INFO(db_options.info_log, "Creating %s", fname.c_str());
+          const std::string staged = checkpoint_dir + "/" + fname + ".tmp";
+          Status create_s = CreateFile(db_->GetFileSystem(), staged, contents,
+                                       db_options.use_fsync);
+          if (create_s.ok()) {
+            create_s = db_->GetEnv()->RenameFile(
+                staged, checkpoint_dir + "/" + fname);
+          }
+          return create_s;
+        } /* create_file_cb */,
+        &sequence_number, log_size_for_flush);
+
+    if (disabled_file_deletions) {
+      Status ss = db_->EnableFileDeletions(false);
+      assert(ss.ok());
+      ss.PermitUncheckedError();
+    }
+  }
+
+  std::unique_ptr<FSDirectory> checkpoint_directory;
+  if (s.ok()) {
+    s = db_->GetFileSystem()->NewDirectory(checkpoint_dir, IOOptions(),
+                                           &checkpoint_directory, nullptr);
+  }
+  if (s.ok() && checkpoint_directory != nullptr) {
+    // A single directory sync covers all the links and renames above,
+    // including the new CURRENT file.
+    s = checkpoint_directory->FsyncWithDirOptions(IOOptions(), nullptr,
+                                                  DirFsyncOptions());
+  }
+
+  if (s.ok()) {
+    // The refreshed checkpoint is durable; drop whatever it does not
+    // reference: data files that fell out of the live set, the previous
+    // MANIFEST/OPTIONS/WAL files, and staging leftovers from an interrupted
+    // refresh.
+    for (const auto& fname : previous_files) {
+      if (current_files.find(fname) != current_files.end()) {
+        continue;
+      }
+      uint64_t number;
+      FileType type;
+      const bool parseable = ParseFileName(fname, &number, &type);
+      const bool stale_staging =
+          fname.size() > 4 && fname.compare(fname.size() - 4, 4, ".tmp") == 0;
+      if (!parseable && !stale_staging) {
+        continue;
+      }
+      ROCKS_LOG_INFO(db_options.info_log, "Deleting stale %s", fname.c_str());
+      Status del_s = db_->GetEnv()->DeleteFile(checkpoint_dir + "/" + fname);
+      if (!del_s.ok()) {
+        // Not fatal: the checkpoint is complete, and leftovers are removed
+        // by the next refresh.
+        ROCKS_LOG_WARN(db_options.info_log, "Failed to delete %s -- %s",
+                       fname.c_str(), del_s.ToString().c_str());
+      }
+    }
+  }
+
+  if (s.ok()) {
+    if (sequence_number_ptr != nullptr) {
+      *sequence_number_ptr = sequence_number;
+    }
+    ROCKS_LOG_INFO(db_options.info_log,
+                   "Checkpoint refresh DONE. Linked %" PRIu64 " new files",
+                   num_linked);
+    ROCKS_LOG_INFO(db_options.info_log, "Snapshot sequence number: %" PRIu64,
+                   sequence_number);
+  } else {
+    // Unlike CreateCheckpoint() there is no staging directory to clean up:
+    // the directory still holds the previous checkpoint plus possibly some
+    // extra files, and stays usable as a refresh base.
+    ROCKS_LOG_INFO(db_options.info_log, "Checkpoint refresh failed -- %s",
+                   s.ToString().c_str());
+  }
+  return s;
+}
+
 Status CheckpointImpl::CreateCustomCheckpoint(
     std::function<Status(const std::string& src_dirname,
                          const std::string& src_fname, FileType type)>
@@ -284,6 +459,14 @@ Status CheckpointImpl::CreateCustomCheckpoint(
 Status CheckpointImpl::ExportColumnFamily(
     ColumnFamilyHandle* handle, const std::string& export_dir,
     ExportImportFilesMetaData** metadata) {
+  return ExportColumnFamily(handle, export_dir, metadata,
+                            ExportColumnFamilyOptions());
+}
+
+Status CheckpointImpl::ExportColumnFamily(
+    ColumnFamilyHandle* handle, const std::string& export_dir,
+    ExportImportFilesMetaData** metadata,
+    const ExportColumnFamilyOptions& options) {
   auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(handle);
   const auto cf_name = cfh->GetName();
   const auto db_options = db_->GetDBOptions();
@@ -323,7 +506,7 @@ Status CheckpointImpl::ExportColumnFamily(
       db_->GetColumnFamilyMetaData(handle, &db_metadata);
 
       s = ExportFilesInMetaData(
-          db_options, db_metadata,
+          db_options, db_metadata, options.max_copy_threads,
           [&](const std::string& src_dirname, const std::string& fname) {
             ROCKS_LOG_INFO(db_options.info_log, "[%s] HardLinking %s",
                            cf_name.c_str(), fname.c_str());
@@ -335,7 +518,8 @@ Status CheckpointImpl::ExportColumnFamily(
                            cf_name.c_str(), fname.c_str());
             return CopyFile(db_->GetFileSystem(), src_dirname + fname,
                             tmp_export_dir + fname, 0, db_options.use_fsync,
-                            nullptr, Temperature::kUnknown);
+                            nullptr, Temperature::kUnknown,
+                            options.rate_limiter.get());
           } /*copy_file_cb*/);
 
       const auto enable_status = db_->EnableFileDeletions(false /*force*/);
@@ -416,6 +600,7 @@ Status CheckpointImpl::ExportColumnFamily(
 
 Status CheckpointImpl::ExportFilesInMetaData(
     const DBOptions& db_options, const ColumnFamilyMetaData& metadata,
+    uint32_t max_copy_threads,
     std::function<Status(const std::string& src_dirname,
                          const std::string& src_fname)>
         link_file_cb,
@@ -425,8 +610,12 @@ Status CheckpointImpl::ExportFilesInMetaData(
   Status s;
   auto hardlink_file = true;
 
-  // Copy/hard link files in metadata.
+  // Hard link files in metadata. Hard links are cheap metadata operations,
+  // so they stay sequential; when the first link fails because the export
+  // directory is on another filesystem, the remaining files are queued up
+  // and copied, possibly by multiple threads.
   size_t num_files = 0;
+  std::vector<std::string> files_to_copy;
   for (const auto& level_metadata : metadata.levels) {
     for (const auto& file_metadata : level_metadata.files) {
       uint64_t number;
@@ -452,13 +641,55 @@ Status CheckpointImpl::ExportFilesInMetaData(
         }
       }
       if (!hardlink_file) {
-        s = copy_file_cb(db_->GetName(), src_fname);
+        files_to_copy.push_back(src_fname);
       }
       if (!s.ok()) {
         break;
       }
     }
   }
+
+  if (s.ok() && !files_to_copy.empty()) {
+    const size_t num_threads = std::max(
+        size_t{1}, std::min(static_cast<size_t>(max_copy_threads),
+                            files_to_copy.size()));
+    if (num_threads == 1) {
+      for (const auto& src_fname : files_to_copy) {
+        s = copy_file_cb(db_->GetName(), src_fname);
+        if (!s.ok()) {
+          break;
+        }
+      }
+    } else {
+      // The threads pull the next file off a shared index; the first
+      // failure stops the worker that saw it and is reported once all the
+      // workers have drained.
+      std::atomic<size_t> next_file{0};
+      std::vector<Status> thread_statuses(num_threads);
+      std::vector<port::Thread> workers;
+      for (size_t t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t]() {
+          size_t i;
+          while ((i = next_file.fetch_add(1)) < files_to_copy.size()) {
+            Status copy_s = copy_file_cb(db_->GetName(), files_to_copy[i]);
+            if (!copy_s.ok()) {
+              thread_statuses[t] = copy_s;
+              break;
+            }
+          }
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+      for (auto& thread_s : thread_statuses) {
+        if (!thread_s.ok()) {
+          s = thread_s;
+          break;
+        }
+      }
+    }
+  }
   ROCKS_LOG_INFO(db_options.info_log, "Number of table files %" ROCKSDB_PRIszt,
                  num_files);
 
@@ -22,10 +22,19 @@ class CheckpointImpl : public Checkpoint {
                           uint64_t log_size_for_flush,
                           uint64_t* sequence_number_ptr) override;
 
+  Status RefreshCheckpoint(const std::string& checkpoint_dir,
+                           uint64_t log_size_for_flush,
+                           uint64_t* sequence_number_ptr) override;
+
   Status ExportColumnFamily(ColumnFamilyHandle* handle,
                             const std::string& export_dir,
                             ExportImportFilesMetaData** metadata) override;
 
+  Status ExportColumnFamily(ColumnFamilyHandle* handle,
+                            const std::string& export_dir,
+                            ExportImportFilesMetaData** metadata,
+                            const ExportColumnFamilyOptions& options) override;
+
   // Checkpoint logic can be customized by providing callbacks for link, copy,
   // or create.
   Status CreateCustomCheckpoint(
@@ -48,8 +57,11 @@ class CheckpointImpl : public Checkpoint {
   void CleanStagingDirectory(const std::string& path, Logger* info_log);
 
   // Export logic customization by providing callbacks for link or copy.
+  // When the export falls back to copying, up to max_copy_threads files
+  // are copied concurrently; copy_file_cb must be thread-safe.
   Status ExportFilesInMetaData(
       const DBOptions& db_options, const ColumnFamilyMetaData& metadata,
+      uint32_t max_copy_threads,
       std::function<Status(const std::string& src_dirname,
                            const std::string& fname)>
           link_file_cb,
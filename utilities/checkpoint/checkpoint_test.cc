@@ -24,6 +24,7 @@
 #include "port/stack_trace.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/rate_limiter.h"
 #include "rocksdb/utilities/transaction_db.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
@@ -314,6 +315,59 @@ TEST_F(CheckpointTest, GetSnapshotLink) {
   }
 }
 
+TEST_F(CheckpointTest, RefreshCheckpoint) {
+  Options options = CurrentOptions();
+  Checkpoint* checkpoint;
+  ASSERT_OK(Checkpoint::Create(db_, &checkpoint));
+  std::unique_ptr<Checkpoint> checkpoint_guard(checkpoint);
+
+  // Refreshing requires an existing checkpoint.
+  ASSERT_TRUE(
+      checkpoint->RefreshCheckpoint(snapshot_name_).IsInvalidArgument());
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(checkpoint->CreateCheckpoint(snapshot_name_));
+
+  // Churn the live file set: add a file and make the old ones obsolete.
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_OK(Put("bar", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  uint64_t refresh_seqno = 0;
+  ASSERT_OK(checkpoint->RefreshCheckpoint(snapshot_name_, 0, &refresh_seqno));
+  ASSERT_EQ(db_->GetLatestSequenceNumber(), refresh_seqno);
+
+  // The refreshed checkpoint holds exactly the live table files, and no
+  // staging leftovers.
+  std::vector<std::string> files;
+  ASSERT_OK(env_->GetChildren(snapshot_name_, &files));
+  size_t num_table_files = 0;
+  for (const auto& file : files) {
+    uint64_t number = 0;
+    FileType type = kWalFile;
+    ASSERT_EQ(file.find(".tmp"), std::string::npos);
+    if (ParseFileName(file, &number, &type) && type == kTableFile) {
+      num_table_files++;
+    }
+  }
+  std::vector<LiveFileMetaData> live_files;
+  db_->GetLiveFilesMetaData(&live_files);
+  ASSERT_EQ(live_files.size(), num_table_files);
+
+  // The refreshed checkpoint is openable and up to date.
+  options.create_if_missing = false;
+  DB* snapshot_db = nullptr;
+  ASSERT_OK(DB::Open(options, snapshot_name_, &snapshot_db));
+  std::unique_ptr<DB> snapshot_db_guard(snapshot_db);
+  std::string result;
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "foo", &result));
+  ASSERT_EQ("v2", result);
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "bar", &result));
+  ASSERT_EQ("v1", result);
+}
+
 TEST_F(CheckpointTest, CheckpointWithBlob) {
   // Create a database with a blob file
   Options options = CurrentOptions();
@@ -435,6 +489,54 @@ TEST_F(CheckpointTest, ExportColumnFamilyWithLinks) {
   }
 }
 
+namespace {
+// Refuses hard links so that ExportColumnFamily takes its copy fallback,
+// as if the export directory were on a different filesystem than the DB.
+class LinkUnsupportedEnv : public EnvWrapper {
+ public:
+  explicit LinkUnsupportedEnv(Env* base) : EnvWrapper(base) {}
+  static const char* kClassName() { return "LinkUnsupportedEnv"; }
+  const char* Name() const override { return kClassName(); }
+  Status LinkFile(const std::string& /*src*/,
+                  const std::string& /*target*/) override {
+    return Status::NotSupported("Hard links disabled for test");
+  }
+};
+}  // anonymous namespace
+
+TEST_F(CheckpointTest, ExportColumnFamilyParallelCopy) {
+  LinkUnsupportedEnv copy_env(env_);
+  auto options = CurrentOptions();
+  options.env = &copy_env;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  const int kNumFiles = 8;
+  for (int i = 0; i < kNumFiles; i++) {
+    ASSERT_OK(Put("key" + std::to_string(i), "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+
+  Checkpoint* checkpoint;
+  ASSERT_OK(Checkpoint::Create(db_, &checkpoint));
+
+  ExportColumnFamilyOptions export_options;
+  export_options.max_copy_threads = 4;
+  export_options.rate_limiter.reset(
+      NewGenericRateLimiter(100 << 20 /* rate_bytes_per_sec */));
+  ASSERT_OK(checkpoint->ExportColumnFamily(db_->DefaultColumnFamily(),
+                                           export_path_, &metadata_,
+                                           export_options));
+  ASSERT_EQ(metadata_->files.size(), kNumFiles);
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(export_path_, &children));
+  ASSERT_EQ(children.size(), kNumFiles);
+  delete checkpoint;
+
+  // The DB must be closed before copy_env goes out of scope.
+  Close();
+}
+
 TEST_F(CheckpointTest, ExportColumnFamilyNegativeTest) {
   // Create a database
   auto options = CurrentOptions();
@@ -141,6 +141,59 @@ TEST_F(MemoryTest, SharedBlockCacheTotal) {
   }
 }
 
+TEST_F(MemoryTest, MemoryMonitorWatermark) {
+  Options opt;
+  opt.create_if_missing = true;
+  ASSERT_OK(DestroyDB(GetDBName(0), opt));
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(opt, GetDBName(0), &db));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(db->Put(WriteOptions(), rnd_.RandomString(100),
+                      rnd_.RandomString(500)));
+  }
+  std::vector<DB*> dbs = {db};
+  std::unordered_set<const Cache*> cache_set;
+  GetCachePointers(dbs, &cache_set);
+
+  // Invalid options are rejected by the factory.
+  std::unique_ptr<MemoryMonitor> monitor;
+  MemoryMonitorOptions bad_options;
+  bad_options.poll_interval_seconds = 0;
+  ASSERT_NOK(NewMemoryMonitor(bad_options, dbs, cache_set, &monitor));
+  bad_options = MemoryMonitorOptions();
+  bad_options.high_watermark_bytes = 1;
+  ASSERT_NOK(NewMemoryMonitor(bad_options, dbs, cache_set, &monitor));
+
+  // A 1-byte watermark fires on the first poll; the callback sees the same
+  // breakdown the snapshot caches.
+  std::atomic<bool> fired{false};
+  std::atomic<uint64_t> reported_total{0};
+  MemoryMonitorOptions options;
+  options.poll_interval_seconds = 1;
+  options.high_watermark_bytes = 1;
+  options.on_high_watermark =
+      [&](const std::map<MemoryUtil::UsageType, uint64_t>& usage_by_type,
+          uint64_t total_usage) {
+        ASSERT_GT(usage_by_type.at(MemoryUtil::kMemTableTotal), 0u);
+        reported_total = total_usage;
+        fired = true;
+      };
+  ASSERT_OK(NewMemoryMonitor(options, dbs, cache_set, &monitor));
+  ASSERT_OK(monitor->Start());
+  for (int i = 0; i < 100 && !fired; ++i) {
+    Env::Default()->SleepForMicroseconds(100 * 1000);
+  }
+  ASSERT_TRUE(fired);
+  ASSERT_GT(reported_total, 0u);
+
+  std::map<MemoryUtil::UsageType, uint64_t> snapshot;
+  ASSERT_OK(monitor->GetUsageSnapshot(&snapshot));
+  ASSERT_GT(snapshot[MemoryUtil::kMemTableTotal], 0u);
+  ASSERT_OK(monitor->Stop());
+  monitor.reset();
+  delete db;
+}
+
 TEST_F(MemoryTest, MemTableAndTableReadersTotal) {
   std::vector<DB*> dbs;
   std::vector<uint64_t> usage_by_type;
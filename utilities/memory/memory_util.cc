@@ -8,6 +8,8 @@
 #include "rocksdb/utilities/memory_util.h"
 
 #include "db/db_impl/db_impl.h"
+#include "util/mutexlock.h"
+#include "util/timer.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -48,5 +50,135 @@ Status MemoryUtil::GetApproximateMemoryUsageByType(
 
   return Status::OK();
 }
+
+namespace {
+
+// The default implementation of MemoryMonitor. A Timer task re-runs the
+// usage aggregation every poll_interval_seconds and caches the result, so
+// GetUsageSnapshot is a map copy under a mutex.
+class MemoryMonitorImpl : public MemoryMonitor {
+ public:
+  // REQUIRES: options.env != nullptr and options.poll_interval_seconds > 0
+  // (sanitized/validated by NewMemoryMonitor).
+  MemoryMonitorImpl(const MemoryMonitorOptions& options,
+                    const std::vector<DB*>& dbs,
+                    const std::unordered_set<const Cache*>& cache_set)
+      : options_(options),
+        dbs_(dbs),
+        cache_set_(cache_set),
+        timer_(options_.env->GetSystemClock().get()) {}
+  ~MemoryMonitorImpl() override { Stop().PermitUncheckedError(); }
+
+  Status Start() override {
+    MutexLock l(&mutex_);
+    if (started_) {
+      return Status::OK();
+    }
+    timer_.Start();
+    if (!timer_.Add([this]() { PollOnce(); }, "memory_monitor",
+                    0 /* start_after_us */,
+                    options_.poll_interval_seconds * 1000U * 1000U)) {
+      return Status::Aborted("Failed to schedule memory monitor poll");
+    }
+    started_ = true;
+    return Status::OK();
+  }
+
+  Status Stop() override {
+    {
+      MutexLock l(&mutex_);
+      if (!started_) {
+        return Status::OK();
+      }
+      started_ = false;
+    }
+    // Shutdown waits for an in-flight PollOnce, which takes mutex_ to
+    // record its result, so mutex_ must not be held here.
+    timer_.Shutdown();
+    return Status::OK();
+  }
+
+  Status GetUsageSnapshot(
+      std::map<MemoryUtil::UsageType, uint64_t>* usage_by_type) override {
+    assert(usage_by_type != nullptr);
+    MutexLock l(&mutex_);
+    *usage_by_type = snapshot_;
+    return last_status_;
+  }
+
+ private:
+  // The periodic task: one aggregation, snapshot update, and watermark
+  // check.
+  void PollOnce() {
+    std::map<MemoryUtil::UsageType, uint64_t> usage_by_type;
+    Status s = MemoryUtil::GetApproximateMemoryUsageByType(dbs_, cache_set_,
+                                                           &usage_by_type);
+    // kMemTableUnFlushed is a subset of kMemTableTotal, so it is not
+    // counted again in the aggregate.
+    uint64_t total = usage_by_type[MemoryUtil::kMemTableTotal] +
+                     usage_by_type[MemoryUtil::kTableReadersTotal] +
+                     usage_by_type[MemoryUtil::kCacheTotal];
+    bool fire = false;
+    {
+      MutexLock l(&mutex_);
+      last_status_ = s;
+      if (s.ok()) {
+        snapshot_ = usage_by_type;
+        if (options_.high_watermark_bytes > 0) {
+          if (total >= options_.high_watermark_bytes) {
+            fire = !above_watermark_;
+            above_watermark_ = true;
+          } else {
+            above_watermark_ = false;
+          }
+        }
+      }
+    }
+    if (fire && options_.on_high_watermark) {
+      options_.on_high_watermark(usage_by_type, total);
+    }
+  }
+
+  MemoryMonitorOptions options_;
+  std::vector<DB*> dbs_;
+  std::unordered_set<const Cache*> cache_set_;
+  Timer timer_;
+  port::Mutex mutex_;
+  bool started_ = false;                               // guarded by mutex_
+  bool above_watermark_ = false;                       // guarded by mutex_
+  Status last_status_;                                 // guarded by mutex_
+  std::map<MemoryUtil::UsageType, uint64_t> snapshot_; // guarded by mutex_
+};
+
+Status SanitizeMemoryMonitorOptions(MemoryMonitorOptions* options) {
+  if (options->poll_interval_seconds == 0) {
+    return Status::InvalidArgument("poll_interval_seconds must be positive");
+  }
+  if (options->high_watermark_bytes > 0 && !options->on_high_watermark) {
+    return Status::InvalidArgument(
+        "high_watermark_bytes is set but on_high_watermark is not");
+  }
+  if (options->env == nullptr) {
+    options->env = Env::Default();
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status NewMemoryMonitor(const MemoryMonitorOptions& options,
+                        const std::vector<DB*>& dbs,
+                        const std::unordered_set<const Cache*>& cache_set,
+                        std::unique_ptr<MemoryMonitor>* monitor) {
+  assert(monitor != nullptr);
+  MemoryMonitorOptions sanitized = options;
+  Status s = SanitizeMemoryMonitorOptions(&sanitized);
+  if (!s.ok()) {
+    return s;
+  }
+  monitor->reset(new MemoryMonitorImpl(sanitized, dbs, cache_set));
+  return Status::OK();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // !ROCKSDB_LITE
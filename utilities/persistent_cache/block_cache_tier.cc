@@ -301,8 +301,17 @@ Status BlockCacheTier::Lookup(const Slice& key, std::unique_ptr<char[]>* val,
 
   assert(blk_key == key);
 
-  val->reset(new char[blk_val.size()]);
-  memcpy(val->get(), blk_val.data(), blk_val.size());
+  // The value lies inside the scratch buffer, after the record header and
+  // key. Hand the buffer itself to the caller instead of allocating a second
+  // buffer and copying: the callers (e.g. PersistentCacheHelper) move the
+  // returned buffer straight into BlockContents, so this completes the read
+  // path without a copy.
+  assert(blk_val.data() >= scratch.get() &&
+         blk_val.data() + blk_val.size() <= scratch.get() + lba.size_);
+  if (blk_val.data() != scratch.get()) {
+    memmove(scratch.get(), blk_val.data(), blk_val.size());
+  }
+  *val = std::move(scratch);
   *size = blk_val.size();
 
   stats_.bytes_read_.Add(*size);
@@ -52,9 +52,14 @@ Status CompactOnDeletionCollector::AddUserKey(const Slice& /*key*/,
     return Status::OK();
   }
 
+  // A range tombstone is at least as damaging to scans as a point
+  // tombstone, so it counts as a deletion entry for both triggers.
+  const bool is_deletion =
+      (type == kEntryDelete || type == kEntryRangeDeletion);
+
   if (deletion_ratio_enabled_) {
     total_entries_++;
-    if (type == kEntryDelete) {
+    if (is_deletion) {
       deletion_entries_++;
     }
   }
@@ -77,7 +82,7 @@ Status CompactOnDeletionCollector::AddUserKey(const Slice& /*key*/,
     }
 
     num_keys_in_current_bucket_++;
-    if (type == kEntryDelete) {
+    if (is_deletion) {
       num_deletions_in_observation_window_++;
       num_deletions_in_buckets_[current_bucket_]++;
       if (num_deletions_in_observation_window_ >= deletion_trigger_) {
@@ -79,6 +79,41 @@ TEST(CompactOnDeletionCollector, DeletionRatio) {
   }
 }
 
+TEST(CompactOnDeletionCollector, RangeDeletions) {
+  TablePropertiesCollectorFactory::Context context;
+  context.column_family_id =
+      TablePropertiesCollectorFactory::Context::kUnknownColumnFamily;
+
+  {
+    // Range tombstones count toward the deletion ratio.
+    auto factory = NewCompactOnDeletionCollectorFactory(0, 0, 0.5);
+    std::unique_ptr<TablePropertiesCollector> collector(
+        factory->CreateTablePropertiesCollector(context));
+    for (int i = 0; i < 50; i++) {
+      ASSERT_OK(collector->AddUserKey("hello", "rocksdb", kEntryPut, 0, 0));
+    }
+    for (int i = 0; i < 50; i++) {
+      ASSERT_OK(
+          collector->AddUserKey("begin", "end", kEntryRangeDeletion, 0, 0));
+    }
+    ASSERT_OK(collector->Finish(nullptr));
+    ASSERT_TRUE(collector->NeedCompact());
+  }
+
+  {
+    // Range tombstones count toward the sliding-window trigger.
+    auto factory = NewCompactOnDeletionCollectorFactory(100, 20, 0);
+    std::unique_ptr<TablePropertiesCollector> collector(
+        factory->CreateTablePropertiesCollector(context));
+    for (int i = 0; i < 20; i++) {
+      ASSERT_OK(
+          collector->AddUserKey("begin", "end", kEntryRangeDeletion, 0, 0));
+    }
+    ASSERT_TRUE(collector->NeedCompact());
+    ASSERT_OK(collector->Finish(nullptr));
+  }
+}
+
 TEST(CompactOnDeletionCollector, SlidingWindow) {
   const int kWindowSizes[] =
       {1000, 10000, 10000, 127, 128, 129, 255, 256, 257, 2, 10000};
@@ -8,15 +8,148 @@
 #include "utilities/trace/replayer_impl.h"
 
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <set>
 #include <thread>
 
+#include "port/port.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/system_clock.h"
+#include "rocksdb/write_batch.h"
+#include "util/hash.h"
 #include "util/threadpool_imp.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+
+// Determines which key-hash lanes a TraceRecord's keys fall into, for
+// dependency-preserving parallel replay. Iterator seeks are ordered by
+// their seek key only (the subsequent range read cannot be captured by
+// key hashing); a record whose keys cannot be enumerated (e.g. a
+// WriteBatch with a range deletion) conservatively orders against every
+// lane.
+class LaneCollectorHandler : public TraceRecord::Handler {
+ public:
+  explicit LaneCollectorHandler(size_t num_lanes) : num_lanes_(num_lanes) {}
+
+  Status Handle(const WriteQueryTraceRecord& record,
+                std::unique_ptr<TraceRecordResult>* /*result*/) override {
+    WriteBatch batch(record.GetWriteBatchRep().ToString());
+    BatchKeyHandler key_handler(this);
+    Status s = batch.Iterate(&key_handler);
+    if (!s.ok()) {
+      all_lanes_ = true;
+    }
+    return Status::OK();
+  }
+
+  Status Handle(const GetQueryTraceRecord& record,
+                std::unique_ptr<TraceRecordResult>* /*result*/) override {
+    AddKey(record.GetKey());
+    return Status::OK();
+  }
+
+  Status Handle(const IteratorSeekQueryTraceRecord& record,
+                std::unique_ptr<TraceRecordResult>* /*result*/) override {
+    AddKey(record.GetKey());
+    return Status::OK();
+  }
+
+  Status Handle(const MultiGetQueryTraceRecord& record,
+                std::unique_ptr<TraceRecordResult>* /*result*/) override {
+    for (const Slice& key : record.GetKeys()) {
+      AddKey(key);
+    }
+    return Status::OK();
+  }
+
+  // Lanes the inspected record must be ordered against. Invalid when
+  // all_lanes() is true.
+  const std::set<size_t>& lanes() const { return lanes_; }
+
+  bool all_lanes() const { return all_lanes_; }
+
+ private:
+  class BatchKeyHandler : public WriteBatch::Handler {
+   public:
+    explicit BatchKeyHandler(LaneCollectorHandler* parent)
+        : parent_(parent) {}
+
+    Status PutCF(uint32_t /*cf_id*/, const Slice& key,
+                 const Slice& /*value*/) override {
+      parent_->AddKey(key);
+      return Status::OK();
+    }
+
+    Status DeleteCF(uint32_t /*cf_id*/, const Slice& key) override {
+      parent_->AddKey(key);
+      return Status::OK();
+    }
+
+    Status SingleDeleteCF(uint32_t /*cf_id*/, const Slice& key) override {
+      parent_->AddKey(key);
+      return Status::OK();
+    }
+
+    Status MergeCF(uint32_t /*cf_id*/, const Slice& key,
+                   const Slice& /*value*/) override {
+      parent_->AddKey(key);
+      return Status::OK();
+    }
+
+    Status DeleteRangeCF(uint32_t /*cf_id*/, const Slice& /*begin_key*/,
+                         const Slice& /*end_key*/) override {
+      // A range deletion affects an unbounded set of keys, which key
+      // hashing cannot enumerate.
+      parent_->all_lanes_ = true;
+      return Status::OK();
+    }
+
+   private:
+    LaneCollectorHandler* parent_;
+  };
+
+  void AddKey(const Slice& key) {
+    lanes_.insert(GetSliceNPHash64(key) % num_lanes_);
+  }
+
+  size_t num_lanes_;
+  bool all_lanes_ = false;
+  std::set<size_t> lanes_;
+};
+
+// Synchronization point for a record whose keys span multiple lanes: the
+// record may only execute once every involved lane has drained the
+// records preceding it, and the involved lanes may only proceed once the
+// record has executed.
+struct LaneSyncPoint {
+  std::mutex mu;
+  std::condition_variable cv;
+  // Number of involved lanes that have not reached this point yet.
+  size_t remaining = 0;
+  bool executed = false;
+};
+
+struct LaneTask {
+  // Set on exactly one of the involved lanes, which executes the record.
+  std::unique_ptr<TraceRecord> record;
+  uint64_t trace_ts = 0;
+  // Null for records confined to a single lane.
+  std::shared_ptr<LaneSyncPoint> sync;
+};
+
+struct ReplayLane {
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<LaneTask> tasks;
+  bool closed = false;
+};
+
+}  // namespace
+
 ReplayerImpl::ReplayerImpl(DB* db,
                            const std::vector<ColumnFamilyHandle*>& handles,
                            std::unique_ptr<TraceReader>&& reader)
@@ -147,6 +280,9 @@ Status ReplayerImpl::Replay(
         result_callback(s, std::move(res));
       }
     }
+  } else if (options.preserve_key_order) {
+    // Multi-threaded replay with per-key ordering preserved.
+    s = ReplayLanes(options, result_callback);
   } else {
     // Multi-threaded replay.
     ThreadPoolImpl thread_pool;
@@ -248,6 +384,192 @@ Status ReplayerImpl::Replay(
   return s;
 }
 
+Status ReplayerImpl::ReplayLanes(
+    const ReplayOptions& options,
+    const std::function<void(Status, std::unique_ptr<TraceRecordResult>&&)>&
+        result_callback) {
+  const size_t num_lanes = options.num_threads;
+
+  std::mutex mtx;
+  // Background execution status, same first-by-trace-timestamp semantics
+  // as in the unordered multi-threaded replay.
+  Status bg_s = Status::OK();
+  uint64_t last_err_ts = static_cast<uint64_t>(-1);
+  auto error_cb = [&mtx, &bg_s, &last_err_ts](Status err, uint64_t err_ts) {
+    std::lock_guard<std::mutex> gd(mtx);
+    // Only record the first error.
+    if (!err.ok() && !err.IsNotSupported() && err_ts < last_err_ts) {
+      bg_s = err;
+      last_err_ts = err_ts;
+    }
+  };
+
+  auto execute_task = [this, &error_cb, &result_callback](TraceRecord* record,
+                                                          uint64_t trace_ts) {
+    Status es;
+    if (result_callback == nullptr) {
+      es = record->Accept(exec_handler_.get(), nullptr);
+    } else {
+      std::unique_ptr<TraceRecordResult> res;
+      es = record->Accept(exec_handler_.get(), &res);
+      result_callback(es, std::move(res));
+    }
+    error_cb(es, trace_ts);
+  };
+
+  std::vector<ReplayLane> lanes(num_lanes);
+  std::vector<port::Thread> workers;
+  workers.reserve(num_lanes);
+  for (size_t i = 0; i < num_lanes; i++) {
+    workers.emplace_back([&execute_task, lane = &lanes[i]]() {
+      while (true) {
+        LaneTask task;
+        {
+          std::unique_lock<std::mutex> lk(lane->mu);
+          lane->cv.wait(
+              lk, [lane] { return lane->closed || !lane->tasks.empty(); });
+          if (lane->tasks.empty()) {
+            break;
+          }
+          task = std::move(lane->tasks.front());
+          lane->tasks.pop_front();
+        }
+        if (task.sync == nullptr) {
+          execute_task(task.record.get(), task.trace_ts);
+          continue;
+        }
+        std::unique_lock<std::mutex> sl(task.sync->mu);
+        task.sync->remaining--;
+        if (task.record != nullptr) {
+          // Executing lane: wait for all involved lanes to drain the
+          // records that precede this one.
+          LaneSyncPoint* sync = task.sync.get();
+          sync->cv.wait(sl, [sync] { return sync->remaining == 0; });
+          sl.unlock();
+          execute_task(task.record.get(), task.trace_ts);
+          sl.lock();
+          sync->executed = true;
+          sync->cv.notify_all();
+        } else {
+          task.sync->cv.notify_all();
+          LaneSyncPoint* sync = task.sync.get();
+          sync->cv.wait(sl, [sync] { return sync->executed; });
+        }
+      }
+    });
+  }
+
+  std::chrono::system_clock::time_point replay_epoch =
+      std::chrono::system_clock::now();
+
+  Status s = Status::OK();
+  while (bg_s.ok() && s.ok()) {
+    Trace trace;
+    s = ReadTrace(&trace);
+    // If already at trace end, ReadTrace should return Status::Incomplete().
+    if (!s.ok()) {
+      break;
+    }
+
+    // No need to sleep before breaking the loop if at the trace end.
+    if (trace.type == kTraceEnd) {
+      trace_end_ = true;
+      s = Status::Incomplete("Trace end.");
+      break;
+    }
+
+    // Sleep first, then decode and dispatch, like the unordered
+    // multi-threaded replay does.
+    std::chrono::system_clock::time_point sleep_to =
+        replay_epoch +
+        std::chrono::microseconds(static_cast<uint64_t>(std::llround(
+            1.0 * (trace.ts - header_ts_) / options.fast_forward)));
+    if (sleep_to > std::chrono::system_clock::now()) {
+      std::this_thread::sleep_until(sleep_to);
+    }
+
+    // Decoding happens in the dispatcher so that the record's keys can be
+    // inspected to pick its lane(s).
+    std::unique_ptr<TraceRecord> record;
+    Status ds =
+        TracerHelper::DecodeTraceRecord(&trace, trace_file_version_, &record);
+    if (!ds.ok()) {
+      if (ds.IsNotSupported()) {
+        // Skip unsupported traces.
+        if (result_callback != nullptr) {
+          result_callback(ds, nullptr);
+        }
+        continue;
+      }
+      error_cb(ds, trace.ts);
+      if (result_callback != nullptr) {
+        result_callback(ds, nullptr);
+      }
+      break;
+    }
+
+    LaneCollectorHandler collector(num_lanes);
+    record->Accept(&collector, nullptr).PermitUncheckedError();
+
+    LaneTask task;
+    task.record = std::move(record);
+    task.trace_ts = trace.ts;
+    if (!collector.all_lanes() && collector.lanes().size() <= 1) {
+      // Confined to a single lane; an empty set (e.g. an empty
+      // WriteBatch) can go to any lane.
+      size_t lane_idx =
+          collector.lanes().empty() ? 0 : *collector.lanes().begin();
+      ReplayLane& lane = lanes[lane_idx];
+      std::lock_guard<std::mutex> lk(lane.mu);
+      lane.tasks.push_back(std::move(task));
+      lane.cv.notify_one();
+    } else {
+      std::set<size_t> involved;
+      if (collector.all_lanes()) {
+        for (size_t i = 0; i < num_lanes; i++) {
+          involved.insert(i);
+        }
+      } else {
+        involved = collector.lanes();
+      }
+      auto sync = std::make_shared<LaneSyncPoint>();
+      sync->remaining = involved.size();
+      // The lowest involved lane executes the record; the others just
+      // rendezvous at the sync point. Since every lane receives its tasks
+      // in trace order, all involved lanes eventually reach this sync
+      // point and cross-lane sync points cannot form a cycle.
+      bool first = true;
+      for (size_t lane_idx : involved) {
+        LaneTask lane_task;
+        if (first) {
+          lane_task.record = std::move(task.record);
+          first = false;
+        }
+        lane_task.trace_ts = task.trace_ts;
+        lane_task.sync = sync;
+        ReplayLane& lane = lanes[lane_idx];
+        std::lock_guard<std::mutex> lk(lane.mu);
+        lane.tasks.push_back(std::move(lane_task));
+        lane.cv.notify_one();
+      }
+    }
+  }
+
+  for (ReplayLane& lane : lanes) {
+    std::lock_guard<std::mutex> lk(lane.mu);
+    lane.closed = true;
+    lane.cv.notify_one();
+  }
+  for (port::Thread& worker : workers) {
+    worker.join();
+  }
+
+  if (!bg_s.ok()) {
+    s = bg_s;
+  }
+  return s;
+}
+
 uint64_t ReplayerImpl::GetHeaderTimestamp() const { return header_ts_; }
 
 Status ReplayerImpl::ReadHeader(Trace* header) {
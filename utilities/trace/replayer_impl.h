@@ -52,6 +52,16 @@ class ReplayerImpl : public Replayer {
   Status ReadHeader(Trace* header);
   Status ReadTrace(Trace* trace);
 
+  // Dependency-preserving multi-threaded replay, used by Replay() when
+  // ReplayOptions::preserve_key_order is set. Records are partitioned
+  // into per-thread lanes by key hash; each lane executes its records in
+  // trace order, and records touching multiple lanes are synchronized
+  // across the involved lanes.
+  Status ReplayLanes(
+      const ReplayOptions& options,
+      const std::function<void(Status, std::unique_ptr<TraceRecordResult>&&)>&
+          result_callback);
+
   // Generic function to execute a Trace in a thread pool.
   static void BackgroundWork(void* arg);
 
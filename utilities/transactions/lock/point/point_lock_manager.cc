@@ -113,7 +113,25 @@ PointLockManager::PointLockManager(PessimisticTransactionDB* txn_db,
       dlock_buffer_(opt.max_num_deadlocks),
       mutex_factory_(opt.custom_mutex_factory
                          ? opt.custom_mutex_factory
-                         : std::make_shared<TransactionDBMutexFactoryImpl>()) {}
+                         : std::make_shared<TransactionDBMutexFactoryImpl>()),
+      async_deadlock_detect_(opt.async_deadlock_detect),
+      detector_shutdown_(false) {
+  if (async_deadlock_detect_) {
+    deadlock_detector_ =
+        port::Thread(&PointLockManager::BackgroundDeadlockDetection, this);
+  }
+}
+
+PointLockManager::~PointLockManager() {
+  if (deadlock_detector_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(detector_mutex_);
+      detector_shutdown_ = true;
+    }
+    detector_cv_.notify_one();
+    deadlock_detector_.join();
+  }
+}
 
 size_t LockMap::GetStripe(const std::string& key) const {
   assert(num_stripes_ > 0);
@@ -330,6 +348,13 @@ Status PointLockManager::AcquireWithTimeout(
         txn->ClearWaitingTxn();
         if (txn->IsDeadlockDetect()) {
           DecrementWaiters(txn, wait_ids);
+          // In async mode the background detector may have picked us as the
+          // victim of a deadlock while we were waiting.
+          if (async_deadlock_detect_ && TakeDeadlockVictim(txn->GetID())) {
+            result = Status::Busy(Status::SubCode::kDeadlock);
+            stripe->stripe_mutex->UnLock();
+            return result;
+          }
         }
       }
 
@@ -384,7 +409,8 @@ bool PointLockManager::IncrementWaiters(
   std::lock_guard<std::mutex> lock(wait_txn_map_mutex_);
   assert(!wait_txn_map_.Contains(id));
 
-  wait_txn_map_.Insert(id, {wait_ids, cf_id, exclusive, key});
+  wait_txn_map_.Insert(
+      id, {wait_ids, cf_id, exclusive, key, txn->GetDeadlockDetectDepth()});
 
   for (auto wait_id : wait_ids) {
     if (rev_wait_txn_map_.Contains(wait_id)) {
@@ -394,6 +420,18 @@ bool PointLockManager::IncrementWaiters(
     }
   }
 
+  if (async_deadlock_detect_) {
+    // Leave cycle detection to the background detector: it walks the graph
+    // from this waiter and marks it as the victim if the new edges closed a
+    // cycle. The waiter notices the mark when it wakes up.
+    {
+      std::lock_guard<std::mutex> detector_lock(detector_mutex_);
+      detector_queue_.push_back(id);
+    }
+    detector_cv_.notify_one();
+    return false;
+  }
+
   // No deadlock if nobody is waiting on self.
   if (!rev_wait_txn_map_.Contains(id)) {
     return false;
@@ -467,6 +505,138 @@ bool PointLockManager::IncrementWaiters(
   return true;
 }
 
+void PointLockManager::BackgroundDeadlockDetection() {
+  Env* env = txn_db_impl_->GetEnv();
+  while (true) {
+    autovector<TransactionID> pending;
+    {
+      std::unique_lock<std::mutex> lock(detector_mutex_);
+      detector_cv_.wait(lock, [this] {
+        return detector_shutdown_ || !detector_queue_.empty();
+      });
+      if (detector_shutdown_) {
+        return;
+      }
+      while (!detector_queue_.empty()) {
+        pending.push_back(detector_queue_.front());
+        detector_queue_.pop_front();
+      }
+    }
+    for (TransactionID id : pending) {
+      uint32_t victim_cf_id = 0;
+      std::string victim_key;
+      bool found_deadlock = false;
+      {
+        std::lock_guard<std::mutex> lock(wait_txn_map_mutex_);
+        if (!wait_txn_map_.Contains(id)) {
+          // The wait was resolved before we got to it.
+          continue;
+        }
+        if (DetectDeadlockCycle(id, env)) {
+          // Abort the transaction whose edges closed the cycle, matching
+          // the victim choice of synchronous detection. Remember where it
+          // is waiting so it can be woken up; its edges stay in the graph
+          // until it removes them itself on wake-up.
+          deadlock_victims_.insert(id);
+          const TrackedTrxInfo& info = wait_txn_map_.Get(id);
+          victim_cf_id = info.m_cf_id;
+          victim_key = info.m_waiting_key;
+          found_deadlock = true;
+        }
+      }
+      if (found_deadlock) {
+        // Outside of wait_txn_map_mutex_, which ranks below the lock map
+        // mutex and the stripe mutexes.
+        WakeUpDeadlockVictim(victim_cf_id, victim_key);
+      }
+    }
+  }
+}
+
+bool PointLockManager::DetectDeadlockCycle(TransactionID id, Env* env) {
+  assert(wait_txn_map_.Contains(id));
+  if (!rev_wait_txn_map_.Contains(id)) {
+    // No deadlock if nobody is waiting on self.
+    return false;
+  }
+
+  const TrackedTrxInfo& waiter = wait_txn_map_.Get(id);
+  const int detect_depth = static_cast<int>(waiter.m_detect_depth);
+  std::vector<int> queue_parents(static_cast<size_t>(detect_depth));
+  std::vector<TransactionID> queue_values(static_cast<size_t>(detect_depth));
+  const auto* next_ids = &waiter.m_neighbors;
+  int parent = -1;
+  int64_t deadlock_time = 0;
+  for (int tail = 0, head = 0; head < detect_depth; head++) {
+    int i = 0;
+    if (next_ids) {
+      for (; i < static_cast<int>(next_ids->size()) &&
+             tail + i < detect_depth;
+           i++) {
+        queue_values[tail + i] = (*next_ids)[i];
+        queue_parents[tail + i] = parent;
+      }
+      tail += i;
+    }
+
+    // No more items in the list, meaning no deadlock.
+    if (tail == head) {
+      return false;
+    }
+
+    auto next = queue_values[head];
+    if (next == id) {
+      std::vector<DeadlockInfo> path;
+      while (head != -1) {
+        assert(wait_txn_map_.Contains(queue_values[head]));
+
+        auto extracted_info = wait_txn_map_.Get(queue_values[head]);
+        path.push_back({queue_values[head], extracted_info.m_cf_id,
+                        extracted_info.m_exclusive,
+                        extracted_info.m_waiting_key});
+        head = queue_parents[head];
+      }
+      if (!env->GetCurrentTime(&deadlock_time).ok()) {
+        deadlock_time = 0;
+      }
+      std::reverse(path.begin(), path.end());
+      dlock_buffer_.AddNewPath(DeadlockPath(path, deadlock_time));
+      return true;
+    } else if (!wait_txn_map_.Contains(next)) {
+      next_ids = nullptr;
+      continue;
+    } else {
+      parent = head;
+      next_ids = &(wait_txn_map_.Get(next).m_neighbors);
+    }
+  }
+
+  // Wait cycle too big, just assume deadlock.
+  if (!env->GetCurrentTime(&deadlock_time).ok()) {
+    deadlock_time = 0;
+  }
+  dlock_buffer_.AddNewPath(DeadlockPath(deadlock_time, true));
+  return true;
+}
+
+bool PointLockManager::TakeDeadlockVictim(TransactionID id) {
+  std::lock_guard<std::mutex> lock(wait_txn_map_mutex_);
+  return deadlock_victims_.erase(id) > 0;
+}
+
+void PointLockManager::WakeUpDeadlockVictim(uint32_t cf_id,
+                                            const std::string& key) {
+  std::shared_ptr<LockMap> lock_map_ptr = GetLockMap(cf_id);
+  LockMap* lock_map = lock_map_ptr.get();
+  if (lock_map == nullptr) {
+    // Column family was dropped; the victim wakes up on its own timeout.
+    return;
+  }
+  size_t stripe_num = lock_map->GetStripe(key);
+  assert(lock_map->lock_map_stripes_.size() > stripe_num);
+  lock_map->lock_map_stripes_.at(stripe_num)->stripe_cv->NotifyAll();
+}
+
 // Try to lock this key after we have acquired the mutex.
 // Sets *expire_time to the expiration time in microseconds
 //  or 0 if no expiration.
@@ -6,6 +6,8 @@
 #pragma once
 #ifndef ROCKSDB_LITE
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -13,6 +15,7 @@
 #include <vector>
 
 #include "monitoring/instrumented_mutex.h"
+#include "port/port.h"
 #include "rocksdb/utilities/transaction.h"
 #include "util/autovector.h"
 #include "util/hash_containers.h"
@@ -106,6 +109,9 @@ struct TrackedTrxInfo {
   uint32_t m_cf_id;
   bool m_exclusive;
   std::string m_waiting_key;
+  // Deadlock detection depth the waiter registered with; used by the
+  // asynchronous detector, which has no transaction handle to query.
+  int64_t m_detect_depth;
 };
 
 class PointLockManager : public LockManager {
@@ -116,7 +122,7 @@ class PointLockManager : public LockManager {
   PointLockManager(const PointLockManager&) = delete;
   PointLockManager& operator=(const PointLockManager&) = delete;
 
-  ~PointLockManager() override {}
+  ~PointLockManager() override;
 
   bool IsPointLockSupported() const override { return true; }
 
@@ -192,6 +198,26 @@ class PointLockManager : public LockManager {
   // Used to allocate mutexes/condvars to use when locking keys
   std::shared_ptr<TransactionDBMutexFactory> mutex_factory_;
 
+  // Whether deadlock detection runs on the background detector thread
+  // instead of on the lock-acquire path. See
+  // TransactionDBOptions::async_deadlock_detect.
+  const bool async_deadlock_detect_;
+
+  // The background detector thread; only started in async mode.
+  port::Thread deadlock_detector_;
+
+  // Guard the detector's work queue and shutdown flag. Waiters that publish
+  // a wait-for edge enqueue their id here and wake the detector.
+  std::mutex detector_mutex_;
+  std::condition_variable detector_cv_;
+  std::deque<TransactionID> detector_queue_;
+  bool detector_shutdown_;
+
+  // Transactions the detector picked as deadlock victims; protected by
+  // wait_txn_map_mutex_. A victim consumes its mark and aborts with
+  // Status::Busy(kDeadlock) when it wakes up in AcquireWithTimeout.
+  UnorderedSet<TransactionID> deadlock_victims_;
+
   bool IsLockExpired(TransactionID txn_id, const LockInfo& lock_info, Env* env,
                      uint64_t* wait_time);
 
@@ -218,6 +244,23 @@ class PointLockManager : public LockManager {
                         const autovector<TransactionID>& wait_ids);
   void DecrementWaitersImpl(const PessimisticTransaction* txn,
                             const autovector<TransactionID>& wait_ids);
+
+  // Body of the background detector thread: drains detector_queue_ and
+  // walks the wait-for graph from each published waiter.
+  void BackgroundDeadlockDetection();
+
+  // Walk the wait-for graph from the given registered waiter, the same way
+  // IncrementWaiters does synchronously, and record the deadlock path if
+  // the waiter transitively waits on itself.
+  // REQUIRES: wait_txn_map_mutex_ is held and wait_txn_map_ contains id.
+  bool DetectDeadlockCycle(TransactionID id, Env* env);
+
+  // Consume a pending deadlock victim mark for this transaction. Returns
+  // true if the transaction was marked by the detector.
+  bool TakeDeadlockVictim(TransactionID id);
+
+  // Signal the stripe a victim is waiting on so it notices its mark.
+  void WakeUpDeadlockVictim(uint32_t cf_id, const std::string& key);
 };
 
 }  // namespace ROCKSDB_NAMESPACE
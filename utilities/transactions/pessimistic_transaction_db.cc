@@ -7,8 +7,10 @@
 
 #include "utilities/transactions/pessimistic_transaction_db.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <sstream>
+#include <thread>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -192,7 +194,11 @@ TransactionDBOptions PessimisticTransactionDB::ValidateTxnDBOptions(
   TransactionDBOptions validated = txn_db_options;
 
   if (txn_db_options.num_stripes == 0) {
-    validated.num_stripes = 1;
+    // Auto-size the lock table striping to the hardware. Stripes are
+    // oversubscribed relative to cores so that threads taking locks
+    // concurrently rarely contend on the same stripe mutex.
+    validated.num_stripes = std::max<size_t>(
+        16, 4 * static_cast<size_t>(std::thread::hardware_concurrency()));
   }
 
   return validated;
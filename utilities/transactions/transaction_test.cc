@@ -758,6 +758,59 @@ TEST_P(TransactionTest, DeadlockCycleShared) {
   }
 }
 
+TEST_P(TransactionTest, AsyncDeadlockDetect) {
+  txn_db_options.async_deadlock_detect = true;
+  ASSERT_OK(ReOpen());
+
+  WriteOptions write_options;
+  ReadOptions read_options;
+  TransactionOptions txn_options;
+  txn_options.lock_timeout = 1000000;
+  txn_options.deadlock_detect = true;
+
+  Transaction* txn1 = db->BeginTransaction(write_options, txn_options);
+  Transaction* txn2 = db->BeginTransaction(write_options, txn_options);
+  ASSERT_TRUE(txn1);
+  ASSERT_TRUE(txn2);
+
+  ASSERT_OK(txn1->GetForUpdate(read_options, "0", nullptr));
+  ASSERT_OK(txn2->GetForUpdate(read_options, "1", nullptr));
+
+  std::atomic<uint32_t> checkpoints(0);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "PointLockManager::AcquireWithTimeout:WaitingTxn",
+      [&](void* /*arg*/) { checkpoints.fetch_add(1); });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  port::Thread blocking_thread([&] {
+    auto s = txn1->GetForUpdate(read_options, "1", nullptr);
+    ASSERT_OK(s);
+    ASSERT_OK(txn1->Rollback());
+    delete txn1;
+  });
+
+  // Wait until txn1 is waiting on txn2.
+  while (checkpoints.load() != 1) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Complete the cycle T2 -> T1. The background detector should pick this
+  // transaction as the victim and wake it with a deadlock status.
+  auto s = txn2->GetForUpdate(read_options, "0", nullptr);
+  ASSERT_TRUE(s.IsDeadlock());
+
+  auto dlock_buffer = db->GetDeadlockInfoBuffer();
+  ASSERT_EQ(dlock_buffer.size(), 1U);
+  ASSERT_EQ(dlock_buffer[0].path.size(), 2U);
+
+  ASSERT_OK(txn2->Rollback());
+  delete txn2;
+  blocking_thread.join();
+}
+
 #if !defined(ROCKSDB_VALGRIND_RUN) || defined(ROCKSDB_FULL_VALGRIND_RUN)
 TEST_P(TransactionStressTest, DeadlockCycle) {
   WriteOptions write_options;
@@ -170,6 +170,14 @@ void DBWithTTLImpl::SanitizeOptions(int32_t ttl, ColumnFamilyOptions* options,
     options->merge_operator.reset(
         new TtlMergeOperator(options->merge_operator, clock));
   }
+
+  if (ttl > 0 && options->compaction_style == kCompactionStyleLevel) {
+    // Let leveled compaction drop bottommost files whose entries have all
+    // expired without rewriting them. The compaction filter above still
+    // strips stale entries from files that are only partially expired.
+    options->ttl = static_cast<uint64_t>(ttl);
+    options->ttl_delete_expired_files = true;
+  }
 }
 
 static std::unordered_map<std::string, OptionTypeInfo> ttl_type_info = {
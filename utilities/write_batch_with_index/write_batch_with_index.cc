@@ -26,7 +26,8 @@ namespace ROCKSDB_NAMESPACE {
 struct WriteBatchWithIndex::Rep {
   explicit Rep(const Comparator* index_comparator, size_t reserved_bytes = 0,
                size_t max_bytes = 0, bool _overwrite_key = false,
-               size_t protection_bytes_per_key = 0)
+               size_t protection_bytes_per_key = 0,
+               bool _use_hash_index = false)
       : write_batch(reserved_bytes, max_bytes, protection_bytes_per_key,
                     index_comparator ? index_comparator->timestamp_size() : 0),
         comparator(index_comparator, &write_batch),
@@ -34,11 +35,20 @@ struct WriteBatchWithIndex::Rep {
         overwrite_key(_overwrite_key),
         last_entry_offset(0),
         last_sub_batch_offset(0),
-        sub_batch_cnt(1) {}
+        sub_batch_cnt(1) {
+    if (_use_hash_index) {
+      hash_index.reset(new WriteBatchKeyHashMap(
+          /*bucket_count=*/16, WriteBatchEntryHash(&write_batch),
+          WriteBatchEntryEqual(&write_batch)));
+    }
+  }
   ReadableWriteBatch write_batch;
   WriteBatchEntryComparator comparator;
   Arena arena;
   WriteBatchEntrySkipList skip_list;
+  // If non-nullptr, maps each key to the index entry of its latest update,
+  // for O(1) point lookups alongside the ordered skip list.
+  std::unique_ptr<WriteBatchKeyHashMap> hash_index;
   bool overwrite_key;
   size_t last_entry_offset;
   // The starting offset of the last sub-batch. A sub-batch starts right before
@@ -77,6 +87,17 @@ struct WriteBatchWithIndex::Rep {
   // Rebuild index by reading all records from the batch.
   // Returns non-ok status on corruption.
   Status ReBuildIndex();
+
+  // Whether hash index lookups are authoritative for this column family:
+  // byte equality has to coincide with the comparator's equality, and keys
+  // indexed with a user-defined timestamp would not match the plain user
+  // keys used for lookups.
+  bool HashIndexUsable(uint32_t column_family_id) const {
+    const Comparator* ucmp = comparator.GetComparator(column_family_id);
+    return ucmp != nullptr &&
+           !ucmp->CanKeysWithDifferentByteContentsBeEqual() &&
+           ucmp->timestamp_size() == 0;
+  }
 };
 
 bool WriteBatchWithIndex::Rep::UpdateExistingEntry(
@@ -91,24 +112,37 @@ bool WriteBatchWithIndex::Rep::UpdateExistingEntryWithCfId(
     return false;
   }
 
-  WBWIIteratorImpl iter(column_family_id, &skip_list, &write_batch,
-                        &comparator);
-  iter.Seek(key);
-  if (!iter.Valid()) {
-    return false;
-  } else if (!iter.MatchesKey(column_family_id, key)) {
-    return false;
+  WriteBatchIndexEntry* non_const_entry = nullptr;
+  if (hash_index && HashIndexUsable(column_family_id)) {
+    // The hash index tracks the latest entry for each key, which is exactly
+    // the one the ordered search below would find.
+    WriteBatchIndexEntry search_entry(&key, column_family_id,
+                                      true /* is_forward_direction */,
+                                      false /* is_seek_to_first */);
+    auto hash_iter = hash_index->find(&search_entry);
+    if (hash_iter == hash_index->end()) {
+      return false;
+    }
+    non_const_entry = hash_iter->second;
   } else {
-    // Move to the end of this key (NextKey-Prev)
-    iter.NextKey();  // Move to the next key
-    if (iter.Valid()) {
-      iter.Prev();  // Move back one entry
+    WBWIIteratorImpl iter(column_family_id, &skip_list, &write_batch,
+                          &comparator);
+    iter.Seek(key);
+    if (!iter.Valid()) {
+      return false;
+    } else if (!iter.MatchesKey(column_family_id, key)) {
+      return false;
     } else {
-      iter.SeekToLast();
+      // Move to the end of this key (NextKey-Prev)
+      iter.NextKey();  // Move to the next key
+      if (iter.Valid()) {
+        iter.Prev();  // Move back one entry
+      } else {
+        iter.SeekToLast();
+      }
     }
+    non_const_entry = const_cast<WriteBatchIndexEntry*>(iter.GetRawEntry());
   }
-  WriteBatchIndexEntry* non_const_entry =
-      const_cast<WriteBatchIndexEntry*>(iter.GetRawEntry());
   if (LIKELY(last_sub_batch_offset <= non_const_entry->offset)) {
     last_sub_batch_offset = last_entry_offset;
     sub_batch_cnt++;
@@ -158,6 +192,10 @@ void WriteBatchWithIndex::Rep::AddNewEntry(uint32_t column_family_id) {
       new (mem) WriteBatchIndexEntry(last_entry_offset, column_family_id,
                                       key.data() - wb_data.data(), key.size());
   skip_list.Insert(index_entry);
+  if (hash_index && HashIndexUsable(column_family_id)) {
+    // Newer entries win: the map always points at the latest update.
+    (*hash_index)[index_entry] = index_entry;
+  }
 }
 
 void WriteBatchWithIndex::Rep::Clear() {
@@ -166,6 +204,9 @@ void WriteBatchWithIndex::Rep::Clear() {
 }
 
 void WriteBatchWithIndex::Rep::ClearIndex() {
+  if (hash_index) {
+    hash_index->clear();
+  }
   skip_list.~WriteBatchEntrySkipList();
   arena.~Arena();
   new (&arena) Arena();
@@ -263,9 +304,10 @@ Status WriteBatchWithIndex::Rep::ReBuildIndex() {
 
 WriteBatchWithIndex::WriteBatchWithIndex(
     const Comparator* default_index_comparator, size_t reserved_bytes,
-    bool overwrite_key, size_t max_bytes, size_t protection_bytes_per_key)
+    bool overwrite_key, size_t max_bytes, size_t protection_bytes_per_key,
+    bool use_hash_index)
     : rep(new Rep(default_index_comparator, reserved_bytes, max_bytes,
-                  overwrite_key, protection_bytes_per_key)) {}
+                  overwrite_key, protection_bytes_per_key, use_hash_index)) {}
 
 WriteBatchWithIndex::~WriteBatchWithIndex() {}
 
@@ -678,6 +720,39 @@ size_t WriteBatchWithIndex::GetDataSize() const {
   return rep->write_batch.GetDataSize();
 }
 
+bool WriteBatchWithIndex::GetEntryFromHashIndex(
+    ColumnFamilyHandle* column_family, const Slice& key, WriteEntry* entry,
+    bool* exists) {
+  if (!rep->hash_index) {
+    return false;
+  }
+  uint32_t cf_id = GetColumnFamilyID(column_family);
+  if (!rep->HashIndexUsable(cf_id)) {
+    return false;
+  }
+  WriteBatchIndexEntry search_entry(&key, cf_id,
+                                    true /* is_forward_direction */,
+                                    false /* is_seek_to_first */);
+  auto hash_iter = rep->hash_index->find(&search_entry);
+  if (hash_iter == rep->hash_index->end()) {
+    *exists = false;
+    return true;
+  }
+  Slice blob, xid;
+  Status s = rep->write_batch.GetEntryFromDataOffset(
+      hash_iter->second->offset, &entry->type, &entry->key, &entry->value,
+      &blob, &xid);
+  assert(s.ok());
+  if (!s.ok() || (entry->type != kPutRecord && entry->type != kDeleteRecord &&
+                  entry->type != kSingleDeleteRecord)) {
+    // Merges need the ordered scan to collect the older operands, and
+    // anything unreadable is surfaced as corruption by the ordered search.
+    return false;
+  }
+  *exists = true;
+  return true;
+}
+
 const Comparator* WriteBatchWithIndexInternal::GetUserComparator(
     const WriteBatchWithIndex& wbwi, uint32_t cf_id) {
   const WriteBatchEntryComparator& ucmps = wbwi.rep->comparator;
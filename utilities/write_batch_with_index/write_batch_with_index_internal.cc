@@ -16,6 +16,7 @@
 #include "rocksdb/utilities/write_batch_with_index.h"
 #include "util/cast_util.h"
 #include "util/coding.h"
+#include "util/hash.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -601,6 +602,36 @@ const Comparator* WriteBatchEntryComparator::GetComparator(
   return default_comparator_;
 }
 
+namespace {
+// Materialize the key of an index entry the same way
+// WriteBatchEntryComparator::operator() does.
+Slice GetIndexEntryKey(const ReadableWriteBatch* write_batch,
+                       const WriteBatchIndexEntry* entry) {
+  if (entry->search_key != nullptr) {
+    return *(entry->search_key);
+  }
+  return Slice(write_batch->Data().data() + entry->key_offset,
+               entry->key_size);
+}
+}  // anonymous namespace
+
+size_t WriteBatchEntryHash::operator()(
+    const WriteBatchIndexEntry* entry) const {
+  Slice key = GetIndexEntryKey(write_batch_, entry);
+  return static_cast<size_t>(
+      NPHash64(key.data(), key.size(), entry->column_family));
+}
+
+bool WriteBatchEntryEqual::operator()(
+    const WriteBatchIndexEntry* entry1,
+    const WriteBatchIndexEntry* entry2) const {
+  if (entry1->column_family != entry2->column_family) {
+    return false;
+  }
+  return GetIndexEntryKey(write_batch_, entry1) ==
+         GetIndexEntryKey(write_batch_, entry2);
+}
+
 WriteEntry WBWIIteratorImpl::Entry() const {
   WriteEntry ret;
   Slice blob, xid;
@@ -691,6 +722,26 @@ WBWIIteratorImpl::Result WriteBatchWithIndexInternal::GetFromBatch(
     std::string* value, Status* s) {
   *s = Status::OK();
 
+  // With a hash index, point lookups can skip the ordered search unless the
+  // latest update is a merge, which needs the backward scan below to collect
+  // the older operands.
+  WriteEntry hash_entry;
+  bool exists = false;
+  if (batch->GetEntryFromHashIndex(column_family_, key, &hash_entry,
+                                   &exists)) {
+    context->Clear();
+    if (!exists) {
+      return WBWIIteratorImpl::kNotFound;
+    } else if (hash_entry.type == kPutRecord) {
+      value->assign(hash_entry.value.data(), hash_entry.value.size());
+      return WBWIIteratorImpl::kFound;
+    } else {
+      assert(hash_entry.type == kDeleteRecord ||
+             hash_entry.type == kSingleDeleteRecord);
+      return WBWIIteratorImpl::kDeleted;
+    }
+  }
+
   std::unique_ptr<WBWIIteratorImpl> iter(
       static_cast_with_check<WBWIIteratorImpl>(
           batch->NewIterator(column_family_)));
@@ -8,6 +8,7 @@
 
 #include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "db/merge_context.h"
@@ -185,6 +186,39 @@ class WriteBatchEntryComparator {
 using WriteBatchEntrySkipList =
     SkipList<WriteBatchIndexEntry*, const WriteBatchEntryComparator&>;
 
+// Hash over the (column family, key) of an index entry, reading the key from
+// the write batch the same way WriteBatchEntryComparator does. A dummy entry
+// with search_key set can be used for lookups. Only meaningful for column
+// families where byte equality coincides with the comparator's equality.
+class WriteBatchEntryHash {
+ public:
+  explicit WriteBatchEntryHash(const ReadableWriteBatch* write_batch)
+      : write_batch_(write_batch) {}
+  size_t operator()(const WriteBatchIndexEntry* entry) const;
+
+ private:
+  const ReadableWriteBatch* write_batch_;
+};
+
+// Byte-wise equality counterpart of WriteBatchEntryHash.
+class WriteBatchEntryEqual {
+ public:
+  explicit WriteBatchEntryEqual(const ReadableWriteBatch* write_batch)
+      : write_batch_(write_batch) {}
+  bool operator()(const WriteBatchIndexEntry* entry1,
+                  const WriteBatchIndexEntry* entry2) const;
+
+ private:
+  const ReadableWriteBatch* write_batch_;
+};
+
+// Maps each key to the index entry of its latest update. The map key is the
+// first entry ever added for the key; its key bytes live in the write
+// batch's buffer, so they remain valid as the batch grows.
+using WriteBatchKeyHashMap =
+    std::unordered_map<WriteBatchIndexEntry*, WriteBatchIndexEntry*,
+                       WriteBatchEntryHash, WriteBatchEntryEqual>;
+
 class WBWIIteratorImpl : public WBWIIterator {
  public:
   enum Result : uint8_t {
@@ -1178,6 +1178,64 @@ TEST_P(WriteBatchWithIndexTest, TestGetFromBatch) {
   ASSERT_EQ("b", value);
 }
 
+TEST_P(WriteBatchWithIndexTest, TestGetFromBatchHashIndex) {
+  batch_.reset(new WriteBatchWithIndex(BytewiseComparator(), 20, GetParam(),
+                                       0 /* max_bytes */,
+                                       0 /* protection_bytes_per_key */,
+                                       true /* use_hash_index */));
+  std::string value;
+  Status s = batch_->GetFromBatch(options_, "a", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  ASSERT_OK(batch_->Put("a", "a"));
+  ASSERT_OK(batch_->Put("b", "b"));
+  ASSERT_OK(batch_->Put("a", "z"));
+  ASSERT_OK(batch_->Delete("b"));
+  ASSERT_OK(batch_->Delete("c"));
+  ASSERT_OK(batch_->Put("c", "c"));
+
+  ASSERT_OK(batch_->GetFromBatch(options_, "a", &value));
+  ASSERT_EQ("z", value);
+  s = batch_->GetFromBatch(options_, "b", &value);
+  ASSERT_TRUE(s.IsNotFound());
+  ASSERT_OK(batch_->GetFromBatch(options_, "c", &value));
+  ASSERT_EQ("c", value);
+  s = batch_->GetFromBatch(options_, "x", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  // Merges fall back to the ordered search and still see older operands.
+  ASSERT_OK(batch_->Merge("a", "m"));
+  ASSERT_OK(batch_->GetFromBatch(options_, "a", &value));
+  ASSERT_EQ("z,m", value);
+  // A Put on top of the merges is served from the hash index again.
+  ASSERT_OK(batch_->Put("a", "p"));
+  ASSERT_OK(batch_->GetFromBatch(options_, "a", &value));
+  ASSERT_EQ("p", value);
+
+  // Rolling back to a save point rebuilds the index; the hash index must
+  // follow.
+  batch_->SetSavePoint();
+  ASSERT_OK(batch_->Put("d", "d"));
+  ASSERT_OK(batch_->Delete("a"));
+  s = batch_->GetFromBatch(options_, "a", &value);
+  ASSERT_TRUE(s.IsNotFound());
+  ASSERT_OK(batch_->RollbackToSavePoint());
+  ASSERT_OK(batch_->GetFromBatch(options_, "a", &value));
+  ASSERT_EQ("p", value);
+  s = batch_->GetFromBatch(options_, "d", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  // The ordered index is maintained alongside the hash index.
+  std::unique_ptr<WBWIIterator> iter(batch_->NewIterator());
+  iter->SeekToFirst();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("a", iter->Entry().key.ToString());
+
+  batch_->Clear();
+  s = batch_->GetFromBatch(options_, "a", &value);
+  ASSERT_TRUE(s.IsNotFound());
+}
+
 TEST_P(WriteBatchWithIndexTest, TestGetFromBatchMerge) {
   Status s = OpenDB();
   ASSERT_OK(s);